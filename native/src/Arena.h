@@ -0,0 +1,80 @@
+#ifndef LAMGAMMA_ARENA_H_
+#define LAMGAMMA_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lamgamma {
+
+// Bump allocator for trees that live and die together (syntax trees, the
+// types of one type-check run). Objects are never destroyed individually, so
+// only trivially destructible types may be allocated here.
+class Arena {
+  public:
+    explicit Arena(size_t chunkSize = 16 * 1024) : chunkSize_(chunkSize) {}
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+    Arena(Arena &&) = default;
+    Arena &operator=(Arena &&) = default;
+
+    void *allocate(size_t size, size_t align) {
+        uintptr_t base = chunks_.empty() ? 0 : reinterpret_cast<uintptr_t>(chunks_.back().get());
+        uintptr_t p = (base + used_ + align - 1) & ~static_cast<uintptr_t>(align - 1);
+        if (chunks_.empty() || p + size > base + capacity_) {
+            capacity_ = size + align > chunkSize_ ? size + align : chunkSize_;
+            chunks_.push_back(std::make_unique<unsigned char[]>(capacity_));
+            base = reinterpret_cast<uintptr_t>(chunks_.back().get());
+            p = (base + align - 1) & ~static_cast<uintptr_t>(align - 1);
+        }
+        used_ = p + size - base;
+        bytes_ += size;
+        return reinterpret_cast<void *>(p);
+    }
+
+    template <class T, class... Args>
+    T *make(Args &&...args) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Arena objects are never destroyed");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template <class T>
+    T *makeArray(size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Arena objects are never destroyed");
+        T *p = static_cast<T *>(allocate(sizeof(T) * (n == 0 ? 1 : n), alignof(T)));
+        for (size_t i = 0; i < n; ++i) new (p + i) T();
+        return p;
+    }
+
+    // Total bytes handed out, for statistics.
+    size_t bytesAllocated() const { return bytes_; }
+
+  private:
+    size_t chunkSize_;
+    std::vector<std::unique_ptr<unsigned char[]>> chunks_;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    size_t bytes_ = 0;
+};
+
+// A fixed-size array living in an Arena.
+template <class T>
+struct Span {
+    const T *data = nullptr;
+    size_t size = 0;
+
+    const T *begin() const { return data; }
+    const T *end() const { return data + size; }
+    const T &operator[](size_t i) const { return data[i]; }
+    bool empty() const { return size == 0; }
+};
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_ARENA_H_
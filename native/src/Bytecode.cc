@@ -0,0 +1,1146 @@
+#include "Bytecode.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace lamgamma {
+
+namespace {
+
+BytecodeError unsupported(std::string what) { return BytecodeError{std::move(what)}; }
+
+// The type of a value, Unknown while it depends on the result of a
+// function still being compiled. Code is typed by the value it computes
+// where that is known.
+enum class Type : uint8_t { Int, Bool, Array, Unknown, CodeInt, CodeBool, CodeArray, Code, Tuple };
+
+Type join(Type a, Type b) { return a == Type::Unknown ? b : a; }
+
+Type codeOf(Type t) {
+    return t == Type::Int     ? Type::CodeInt
+           : t == Type::Bool  ? Type::CodeBool
+           : t == Type::Array ? Type::CodeArray
+                              : Type::Code;
+}
+
+Type valueOf(Type code) {
+    return code == Type::CodeInt     ? Type::Int
+           : code == Type::CodeBool  ? Type::Bool
+           : code == Type::CodeArray ? Type::Array
+                                     : Type::Unknown;
+}
+
+// The layout of a value: one slot, or for a tuple, the slots of its
+// elements one after another.
+struct Shape {
+    Type type;
+    std::vector<Shape> elements; // of a Tuple
+
+    Shape(Type type = Type::Unknown) : type(type) {}
+
+    int32_t size() const { return type == Type::Tuple ? offset(elements.size()) : 1; }
+
+    // The first slot of element index, counted from the first of the tuple.
+    int32_t offset(size_t index) const {
+        int32_t n = 0;
+        for (size_t i = 0; i < index; ++i) {
+            n += elements[i].size();
+        }
+        return n;
+    }
+};
+
+ValueType valueType(Type t) {
+    switch (t) {
+    case Type::Bool:
+        return ValueType::Bool;
+    case Type::Tuple:
+        return ValueType::Tuple;
+    case Type::Array:
+        return ValueType::Array;
+    case Type::CodeInt:
+    case Type::CodeBool:
+    case Type::CodeArray:
+    case Type::Code:
+        return ValueType::Code;
+    case Type::Int:
+    case Type::Unknown:
+        break;
+    }
+    return ValueType::Int;
+}
+
+// What a variable in scope stands for: a slot of the current frame, a
+// function of the program, or a variable of a quote being compiled, whose
+// name is in a slot of the current frame.
+struct Binding {
+    enum class Kind : uint8_t { Slot, Function, Name };
+
+    lamgamma::Var var;
+    Kind kind;
+    int32_t index;
+    Shape shape;
+};
+
+// Compiles a function, or the body of a quote into a template. The
+// template's compiler has the compiler of the code around the quote as
+// outer_, which computes the template's operands: its splices are level-0
+// code of the same function.
+class FunctionCompiler {
+  public:
+    FunctionCompiler(Program &program, uint32_t index, std::vector<Binding> scope)
+        : program_(program), index_(index), scope_(std::move(scope)) {}
+
+    FunctionCompiler(Program &program, uint32_t index, FunctionCompiler &outer)
+        : program_(program), index_(index), outer_(&outer) {}
+
+    // Compiles body into the function reserved at index_, whose parameters
+    // are params.
+    Result<Shape, BytecodeError> compileFunction(Span<lamgamma::Var> params, const RawExpr *body) {
+        auto shape = compileBody(params, body);
+        if (!shape) {
+            return shape;
+        }
+        Function &f = program_.functions[index_];
+        f.arity = static_cast<uint32_t>(params.size);
+        f.frameSize = static_cast<uint32_t>(std::max(frameSize_, 1));
+        f.resultType = valueType(shape.value().type);
+        f.resultSize = static_cast<uint32_t>(shape.value().size());
+        f.code = std::move(code_);
+        return shape;
+    }
+
+    // Compiles the body of a quote into the template reserved at index_.
+    // Its operands are left in consecutive slots of outer_ from the top of
+    // its frame on.
+    Result<Type, BytecodeError> compileTemplate(const RawExpr *body) {
+        Span<lamgamma::Var> params{};
+        if (body->kind == RawExpr::Kind::Func) {
+            params = body->as<RawExpr::Func>().params;
+            body = body->as<RawExpr::Func>().body;
+        }
+        auto shape = compileBody(params, body);
+        outer_->scope_.resize(outer_->scope_.size() - params.size);
+        if (!shape) {
+            return fail(shape.error());
+        }
+        Template &t = program_.templates[index_];
+        t.arity = static_cast<uint32_t>(params.size);
+        t.frameSize = static_cast<uint32_t>(std::max(frameSize_, 1));
+        t.code = std::move(code_);
+        t.operands = std::move(operands_);
+        return shape.value().type;
+    }
+
+  private:
+    Result<Shape, BytecodeError> compileBody(Span<lamgamma::Var> params, const RawExpr *body) {
+        for (const lamgamma::Var &param : params) {
+            scope_.push_back(Binding{param, Binding::Kind::Slot, top_, Type::Int});
+            if (outer_ != nullptr) {
+                bindName(param, top_, Type::Int);
+            }
+            reserve(1);
+        }
+        // Return moves the result to slot 0, which may hold a parameter
+        // still needed until then. The components of a tuple are moved to
+        // the slots from 0 on first, upwards, as each comes from above.
+        int32_t result = top_;
+        auto shape = push(body);
+        if (!shape) {
+            return shape;
+        }
+        int32_t size = shape.value().size();
+        if (size > 1 && result != 0) {
+            for (int32_t i = 0; i < size; ++i) {
+                emit(Op::Move, i, result + i);
+            }
+            result = 0;
+        }
+        emit(Op::Return, result);
+        return shape;
+    }
+
+    // Compiles e so that its value ends up in slot dst. Slots from top_ on
+    // are free for temporaries.
+    Result<Type, BytecodeError> compile(const RawExpr *e, int32_t dst) {
+        using Kind = RawExpr::Kind;
+
+        switch (e->kind) {
+        case Kind::IntLit:
+            emit(Op::LoadInt, dst, e->as<RawExpr::IntLit>().value);
+            return Type::Int;
+        case Kind::BoolLit:
+            emit(Op::LoadInt, dst, e->as<RawExpr::BoolLit>().value ? 1 : 0);
+            return Type::Bool;
+        case Kind::Var: {
+            auto binding = lookup(e->as<RawExpr::Var>().var);
+            if (!binding && outer_ != nullptr) {
+                return free(e->as<RawExpr::Var>().var, dst);
+            }
+            if (!binding) {
+                return fail(binding.error());
+            }
+            if (binding.value().kind == Binding::Kind::Function) {
+                return fail(unsupported("function " + binding.value().var.toString() +
+                                        " used as a value"));
+            }
+            if (binding.value().kind == Binding::Kind::Name) {
+                return fail(unsupported("variable " + binding.value().var.toString() +
+                                        " of a quote used outside it"));
+            }
+            if (binding.value().shape.size() > 1) {
+                return fail(unsupported("tuple as an argument or operand"));
+            }
+            if (binding.value().index != dst) {
+                emit(Op::Move, dst, binding.value().index);
+            }
+            return binding.value().shape.type;
+        }
+        case Kind::Let:
+        case Kind::LetRec: {
+            auto slots = bind(e->as<RawExpr::Let>(), e->kind == Kind::LetRec);
+            if (!slots) {
+                return fail(slots.error());
+            }
+            auto body = compile(e->as<RawExpr::Let>().body, dst);
+            unbind(slots.value());
+            return body;
+        }
+        case Kind::BinOp: {
+            const auto &b = e->as<RawExpr::BinOp>();
+            int32_t saved = top_;
+            auto left = operand(b.left);
+            if (!left) {
+                return fail(left.error());
+            }
+            auto right = operand(b.right);
+            if (!right) {
+                return fail(right.error());
+            }
+            top_ = saved;
+            emit(binOp(b.op), dst, left.value(), right.value());
+            return b.op <= BinOp::Mod ? Type::Int : Type::Bool;
+        }
+        case Kind::ShortCircuitOp: {
+            const auto &s = e->as<RawExpr::ShortCircuitOp>();
+            auto left = compile(s.left, dst);
+            if (!left) {
+                return left;
+            }
+            size_t jump = emit(s.op == ShortCircuitOp::And ? Op::JumpIfFalse : Op::JumpIfTrue, dst);
+            auto right = compile(s.right, dst);
+            if (!right) {
+                return right;
+            }
+            code_[jump].b = here();
+            return Type::Bool;
+        }
+        case Kind::UniOp: {
+            const auto &u = e->as<RawExpr::UniOp>();
+            int32_t saved = top_;
+            auto expr = operand(u.expr);
+            if (!expr) {
+                return fail(expr.error());
+            }
+            top_ = saved;
+            emit(Op::Not, dst, expr.value());
+            return Type::Bool;
+        }
+        case Kind::If: {
+            const auto &i = e->as<RawExpr::If>();
+            int32_t saved = top_;
+            auto cond = operand(i.cond);
+            if (!cond) {
+                return fail(cond.error());
+            }
+            top_ = saved;
+            size_t toElse = emit(Op::JumpIfFalse, cond.value());
+            auto thenBranch = compile(i.thenBranch, dst);
+            if (!thenBranch) {
+                return thenBranch;
+            }
+            size_t toEnd = emit(Op::Jump);
+            code_[toElse].b = here();
+            auto elseBranch = compile(i.elseBranch, dst);
+            if (!elseBranch) {
+                return elseBranch;
+            }
+            code_[toEnd].a = here();
+            return join(thenBranch.value(), elseBranch.value());
+        }
+        case Kind::App: {
+            auto shape = call(e->as<RawExpr::App>(), dst);
+            if (!shape) {
+                return fail(shape.error());
+            }
+            if (shape.value().size() > 1) {
+                return fail(unsupported("tuple as an argument or operand"));
+            }
+            return shape.value().type;
+        }
+        case Kind::Tuple:
+            return fail(unsupported(outer_ != nullptr ? "tuple in generated code"
+                                                      : "tuple as an argument or operand"));
+        case Kind::Proj: {
+            int32_t saved = top_;
+            auto component = project(e->as<RawExpr::Proj>());
+            top_ = saved;
+            if (!component) {
+                return fail(component.error());
+            }
+            auto &[slot, shape] = component.value();
+            if (shape.size() > 1) {
+                return fail(unsupported("tuple as an argument or operand"));
+            }
+            emit(Op::Move, dst, slot);
+            return shape.type;
+        }
+        case Kind::Func:
+            return fail(unsupported("function value"));
+        case Kind::LetCs:
+            return fail(unsupported("let cs"));
+        case Kind::ArrayOp:
+            return array(e->as<RawExpr::ArrayOp>(), dst);
+        case Kind::Quote:
+            if (outer_ != nullptr) {
+                return fail(unsupported("quote in generated code"));
+            }
+            return quote(e->as<RawExpr::Quote>().expr, dst);
+        case Kind::Splice:
+            return splice(e->as<RawExpr::Splice>(), dst);
+        case Kind::GenLet:
+            return fail(unsupported("genlet"));
+        }
+        return fail(unsupported("unknown form"));
+    }
+
+    // The slot holding the value of e: the variable's own slot, or a new
+    // temporary.
+    Result<int32_t, BytecodeError> operand(const RawExpr *e) {
+        if (e->kind == RawExpr::Kind::Var) {
+            auto binding = lookup(e->as<RawExpr::Var>().var);
+            if (binding && binding.value().kind == Binding::Kind::Slot) {
+                return binding.value().index;
+            }
+        }
+        int32_t slot = top_;
+        reserve(1);
+        auto type = compile(e, slot);
+        if (!type) {
+            return fail(type.error());
+        }
+        return slot;
+    }
+
+    // Compiles e like compile, but e may be a tuple, which is never boxed:
+    // its components end up side by side in the slots from dst on, and
+    // top_ goes past them. Slots between dst and top_ hold nothing still
+    // needed once e has its value, such as the variables of the lets e is
+    // the body of, which the components may overwrite.
+    Result<Shape, BytecodeError> compileWide(const RawExpr *e, int32_t dst) {
+        using Kind = RawExpr::Kind;
+        int32_t saved = top_;
+
+        switch (e->kind) {
+        case Kind::Tuple: {
+            if (outer_ != nullptr) {
+                return fail(unsupported("tuple in generated code"));
+            }
+            // Built in place when dst is the last slot in use, and else
+            // above it and then moved.
+            int32_t start = dst;
+            if (dst != top_ - 1) {
+                start = top_;
+                reserve(1);
+            }
+            Shape shape(Type::Tuple);
+            for (const RawExpr *element : e->as<RawExpr::Tuple>().elements) {
+                int32_t slot = shape.elements.empty() ? start : top_;
+                if (!shape.elements.empty()) {
+                    reserve(1);
+                }
+                auto elementShape = compileWide(element, slot);
+                if (!elementShape) {
+                    return elementShape;
+                }
+                shape.elements.push_back(std::move(elementShape.value()));
+            }
+            moveTo(dst, start, shape.size(), saved);
+            return shape;
+        }
+        case Kind::Var: {
+            auto binding = lookup(e->as<RawExpr::Var>().var);
+            if (binding && binding.value().kind == Binding::Kind::Slot &&
+                binding.value().shape.size() > 1) {
+                moveTo(dst, binding.value().index, binding.value().shape.size(), saved);
+                return binding.value().shape;
+            }
+            break;
+        }
+        case Kind::Proj: {
+            auto component = project(e->as<RawExpr::Proj>());
+            if (!component) {
+                return fail(component.error());
+            }
+            auto &[slot, shape] = component.value();
+            top_ = saved;
+            moveTo(dst, slot, shape.size(), saved);
+            return shape;
+        }
+        case Kind::Let:
+        case Kind::LetRec: {
+            auto slots = bind(e->as<RawExpr::Let>(), e->kind == Kind::LetRec);
+            if (!slots) {
+                return fail(slots.error());
+            }
+            auto shape = compileWide(e->as<RawExpr::Let>().body, dst);
+            top_ = saved + slots.value();
+            unbind(slots.value());
+            if (!shape) {
+                return shape;
+            }
+            top_ = std::max(saved, dst + shape.value().size());
+            return shape;
+        }
+        case Kind::If: {
+            const auto &i = e->as<RawExpr::If>();
+            auto cond = operand(i.cond);
+            top_ = saved;
+            if (!cond) {
+                return fail(cond.error());
+            }
+            size_t toElse = emit(Op::JumpIfFalse, cond.value());
+            auto thenBranch = compileWide(i.thenBranch, dst);
+            top_ = saved;
+            if (!thenBranch) {
+                return thenBranch;
+            }
+            size_t toEnd = emit(Op::Jump);
+            code_[toElse].b = here();
+            auto elseBranch = compileWide(i.elseBranch, dst);
+            top_ = saved;
+            if (!elseBranch) {
+                return elseBranch;
+            }
+            code_[toEnd].a = here();
+            Shape shape = thenBranch.value().type == Type::Unknown ? std::move(elseBranch.value())
+                                                                   : std::move(thenBranch.value());
+            top_ = std::max(saved, dst + shape.size());
+            return shape;
+        }
+        case Kind::App: {
+            auto shape = call(e->as<RawExpr::App>(), dst);
+            if (!shape) {
+                return shape;
+            }
+            top_ = std::max(saved, dst + shape.value().size());
+            return shape;
+        }
+        default:
+            break;
+        }
+        auto type = compile(e, dst);
+        if (!type) {
+            return fail(type.error());
+        }
+        return Shape(type.value());
+    }
+
+    // Moves the size slots from from on to the slots from dst on, upwards,
+    // and sets top_ past them, and at least to saved. The slots moved
+    // either all lie below dst or start above it, so none is overwritten
+    // before it is read.
+    void moveTo(int32_t dst, int32_t from, int32_t size, int32_t saved) {
+        if (from != dst) {
+            for (int32_t i = 0; i < size; ++i) {
+                emit(Op::Move, dst + i, from + i);
+            }
+        }
+        top_ = saved;
+        reserve(std::max(0, dst + size - saved));
+    }
+
+    // Compiles e into the slots from top_ on, and reserves them.
+    Result<Shape, BytecodeError> push(const RawExpr *e) {
+        int32_t slot = top_;
+        reserve(1);
+        return compileWide(e, slot);
+    }
+
+    // The first slot of component p.index of a tuple, and its shape. A
+    // tuple variable is read where it is; any other tuple is computed into
+    // temporaries from top_ on.
+    Result<std::pair<int32_t, Shape>, BytecodeError> project(const RawExpr::Proj &p) {
+        if (outer_ != nullptr) {
+            return fail(unsupported("tuple in generated code"));
+        }
+        if (p.tuple->kind == RawExpr::Kind::Var) {
+            auto binding = lookup(p.tuple->as<RawExpr::Var>().var);
+            if (binding && binding.value().kind == Binding::Kind::Slot) {
+                return component(binding.value().index, binding.value().shape, p.index);
+            }
+        }
+        int32_t slot = top_;
+        auto shape = push(p.tuple);
+        if (!shape) {
+            return fail(shape.error());
+        }
+        return component(slot, shape.value(), p.index);
+    }
+
+    static Result<std::pair<int32_t, Shape>, BytecodeError> component(int32_t slot,
+                                                                      const Shape &tuple,
+                                                                      uint32_t index) {
+        // Calls of a recursive function have no known result until it has
+        // been compiled once.
+        if (tuple.type == Type::Unknown) {
+            return std::make_pair(slot, Shape());
+        }
+        if (tuple.type != Type::Tuple || index >= tuple.elements.size()) {
+            return fail(unsupported("projection of a value that is not a tuple"));
+        }
+        return std::make_pair(slot + tuple.offset(index), tuple.elements[index]);
+    }
+
+    // Binds the variable of l for its body: to a function of the program,
+    // or to the slots of its value from top_ on. Returns the number of
+    // slots to release after the body.
+    Result<int32_t, BytecodeError> bind(const RawExpr::Let &l, bool rec) {
+        if (l.expr->kind == RawExpr::Kind::Func) {
+            auto defined = define(l.param, l.expr->as<RawExpr::Func>(), rec, l.memo);
+            if (!defined) {
+                return fail(defined.error());
+            }
+            return 0;
+        }
+        if (rec) {
+            return fail(unsupported("let rec of a value that is not a function"));
+        }
+        int32_t slot = top_;
+        auto shape = push(l.expr);
+        if (!shape) {
+            return fail(shape.error());
+        }
+        int32_t size = shape.value().size();
+        scope_.push_back(Binding{l.param, Binding::Kind::Slot, slot, std::move(shape.value())});
+        if (outer_ != nullptr) {
+            bindName(l.param, slot, scope_.back().shape.type);
+        }
+        return size;
+    }
+
+    void unbind(int32_t slots) {
+        scope_.pop_back();
+        if (slots > 0) {
+            release(slots);
+            if (outer_ != nullptr) {
+                outer_->scope_.pop_back();
+            }
+        }
+    }
+
+    // A saturated application of a known function. The arguments are
+    // evaluated into consecutive slots, which become the start of the
+    // callee's frame.
+    Result<Shape, BytecodeError> call(const RawExpr::App &app, int32_t dst) {
+        std::vector<const RawExpr *> args;
+        const RawExpr *head = &app;
+        while (head->kind == RawExpr::Kind::App) {
+            args.push_back(head->as<RawExpr::App>().arg);
+            head = head->as<RawExpr::App>().func;
+        }
+        std::reverse(args.begin(), args.end());
+        if (outer_ != nullptr) {
+            return fail(unsupported("application in generated code"));
+        }
+        if (head->kind == RawExpr::Kind::Splice && head->as<RawExpr::Splice>().shift == 0) {
+            auto type = run(head->as<RawExpr::Splice>().expr, args, dst);
+            if (!type) {
+                return fail(type.error());
+            }
+            return Shape(type.value());
+        }
+        if (head->kind != RawExpr::Kind::Var) {
+            return fail(unsupported("application of a computed function"));
+        }
+        auto binding = lookup(head->as<RawExpr::Var>().var);
+        if (!binding) {
+            return fail(binding.error());
+        }
+        if (binding.value().kind != Binding::Kind::Function) {
+            return fail(unsupported("application of a parameter"));
+        }
+        int32_t callee = binding.value().index;
+        uint32_t arity = program_.functions[callee].arity;
+        if (args.size() != arity) {
+            return fail(unsupported("partial application of " + binding.value().var.toString()));
+        }
+
+        // A tuple comes back in the slots from the start of the callee's
+        // frame, which is dst when nothing above it is in use, and is else
+        // moved to dst, past the first component the call itself moves.
+        const Shape &shape = binding.value().shape;
+        int32_t saved = top_;
+        int32_t base = shape.size() > 1 && dst == top_ - 1 ? dst : top_;
+        top_ = base;
+        reserve(static_cast<int32_t>(args.size()));
+        for (size_t i = 0; i < args.size(); ++i) {
+            auto arg = compile(args[i], base + static_cast<int32_t>(i));
+            if (!arg) {
+                return fail(arg.error());
+            }
+        }
+        top_ = saved;
+        emit(Op::Call, dst, callee, base);
+        if (base != dst) {
+            for (int32_t i = 1; i < shape.size(); ++i) {
+                emit(Op::Move, dst + i, base + i);
+            }
+        }
+        return shape;
+    }
+
+    // Compiles func as a function of the program and binds param to it.
+    // Its body sees only the functions in scope, and itself when rec.
+    Result<Type, BytecodeError> define(lamgamma::Var param, const RawExpr::Func &func, bool rec,
+                                       bool memo) {
+        auto binding = function(param.toString(), func, rec ? &param : nullptr, memo);
+        if (!binding) {
+            return fail(binding.error());
+        }
+        scope_.push_back(binding.value());
+        return binding.value().shape.type;
+    }
+
+    // Compiles func as a function of the program named name, which sees
+    // itself under self unless that is null, and returns its binding.
+    Result<Binding, BytecodeError> function(std::string name, const RawExpr::Func &func,
+                                            const lamgamma::Var *self, bool memo) {
+        if (outer_ != nullptr) {
+            return fail(unsupported("function in generated code"));
+        }
+        if (func.params.empty()) {
+            return fail(unsupported("function without parameters"));
+        }
+        auto index = static_cast<int32_t>(program_.functions.size());
+        program_.functions.emplace_back();
+        program_.functions.back().name = std::move(name);
+        program_.functions.back().arity = static_cast<uint32_t>(func.params.size);
+        program_.functions.back().memo = memo;
+
+        std::vector<Binding> scope;
+        for (const Binding &binding : scope_) {
+            if (binding.kind == Binding::Kind::Function) {
+                scope.push_back(binding);
+            }
+        }
+        if (self != nullptr) {
+            scope.push_back(Binding{*self, Binding::Kind::Function, index, Type::Unknown});
+        }
+        size_t functions = program_.functions.size();
+        size_t templates = program_.templates.size();
+        auto shape = FunctionCompiler(program_, static_cast<uint32_t>(index), scope)
+                         .compileFunction(func.params, func.body);
+        // Where the calls of a recursive function put the components of a
+        // tuple it returns is only known once it has been compiled, so it
+        // is compiled again, in place of the code and the functions and
+        // templates inside it the first time made.
+        if (shape && self != nullptr && shape.value().type == Type::Tuple) {
+            program_.functions.resize(functions);
+            program_.templates.resize(templates);
+            scope.back().shape = shape.value();
+            shape = FunctionCompiler(program_, static_cast<uint32_t>(index), std::move(scope))
+                        .compileFunction(func.params, func.body);
+        }
+        if (!shape) {
+            return fail(shape.error());
+        }
+        lamgamma::Var var =
+            self != nullptr ? *self : lamgamma::Var::raw(program_.functions[index].name);
+        return Binding{var, Binding::Kind::Function, index, std::move(shape.value())};
+    }
+
+    // The operands of a, but for the function of Init, Map and Fold, go in
+    // consecutive slots from top_ on, where the Vm's calls of the function
+    // then put their frames.
+    Result<Type, BytecodeError> array(const RawExpr::ArrayOp &a, int32_t dst) {
+        std::vector<const RawExpr *> operands(a.args.begin(), a.args.end());
+        int32_t function = 0;
+        if (a.op == ArrayOp::Init || a.op == ArrayOp::Map || a.op == ArrayOp::Fold) {
+            // Init takes its size first.
+            auto at = operands.begin() + (a.op == ArrayOp::Init ? 1 : 0);
+            auto index = arrayFunction(a.op, *at);
+            if (!index) {
+                return fail(index.error());
+            }
+            function = index.value();
+            operands.erase(at);
+        }
+        int32_t base = top_;
+        auto size = static_cast<int32_t>(operands.size());
+        reserve(size);
+        for (int32_t i = 0; i < size; ++i) {
+            auto operand = compile(operands[i], base + i);
+            if (!operand) {
+                return operand;
+            }
+        }
+        release(size);
+        switch (a.op) {
+        case ArrayOp::Make:
+            emit(Op::NewArray, dst, base, size);
+            return Type::Array;
+        case ArrayOp::Length:
+            emit(Op::ArrayLength, dst, base);
+            return Type::Int;
+        case ArrayOp::Get:
+            emit(Op::ArrayGet, dst, base, base + 1);
+            return Type::Int;
+        case ArrayOp::Init:
+            emit(Op::ArrayInit, dst, base, function);
+            return Type::Array;
+        case ArrayOp::Map:
+            emit(Op::ArrayMap, dst, base, function);
+            return Type::Array;
+        case ArrayOp::Fold:
+            emit(Op::ArrayFold, dst, base, function);
+            return Type::Int;
+        }
+        return fail(unsupported("unknown array operation"));
+    }
+
+    // The function the bulk operation op applies: a function in scope, or
+    // a lambda, compiled as a function of the program. It must take all of
+    // its arguments at once: one, or for Fold, two.
+    Result<int32_t, BytecodeError> arrayFunction(ArrayOp op, const RawExpr *e) {
+        std::string name = toString(op);
+        uint32_t arity = op == ArrayOp::Fold ? 2 : 1;
+        Result<Binding, BytecodeError> binding =
+            e->kind == RawExpr::Kind::Func ? function(name, e->as<RawExpr::Func>(), nullptr, false)
+            : e->kind == RawExpr::Kind::Var && outer_ == nullptr
+                ? lookup(e->as<RawExpr::Var>().var)
+                : fail(unsupported("computed function given to " + name));
+        if (!binding) {
+            return fail(binding.error());
+        }
+        if (binding.value().kind != Binding::Kind::Function ||
+            program_.functions[binding.value().index].arity != arity) {
+            return fail(unsupported(name + " of a function not of " + std::to_string(arity) +
+                                    " arguments"));
+        }
+        return binding.value().index;
+    }
+
+    // Compiles the body of a quote into a template of the program and
+    // computes its operands into consecutive slots from top_ on.
+    Result<Type, BytecodeError> quote(const RawExpr *body, int32_t dst) {
+        auto index = static_cast<int32_t>(program_.templates.size());
+        program_.templates.emplace_back();
+        int32_t base = top_;
+        FunctionCompiler compiler(program_, static_cast<uint32_t>(index), *this);
+        auto type = compiler.compileTemplate(body);
+        if (!type) {
+            return type;
+        }
+        top_ = base;
+        emit(Op::Quote, dst, index, base);
+        return codeOf(type.value());
+    }
+
+    // In a template, a hole whose operand outer_ computes; in other code,
+    // running the code (~0) of an expression.
+    Result<Type, BytecodeError> splice(const RawExpr::Splice &s, int32_t dst) {
+        if (outer_ == nullptr) {
+            if (s.shift != 0) {
+                return fail(unsupported("splice outside a quote"));
+            }
+            return run(s.expr, {}, dst);
+        }
+        if (s.shift != 1) {
+            return fail(unsupported("splice of shift " + std::to_string(s.shift)));
+        }
+        int32_t operand = outer_->top_;
+        outer_->reserve(1);
+        auto code = outer_->compile(s.expr, operand);
+        if (!code) {
+            return code;
+        }
+        // The fragment's temporaries go above the slots in use here.
+        emit(Op::Hole, dst, static_cast<int32_t>(operands_.size()), top_);
+        operands_.push_back(Template::Operand{Template::Operand::Kind::Hole});
+        return valueOf(code.value());
+    }
+
+    // Runs the code code evaluates to on args. The handle goes in the
+    // first of consecutive slots and the arguments in the ones after it,
+    // which become the start of the generated function's frame.
+    Result<Type, BytecodeError> run(const RawExpr *code, const std::vector<const RawExpr *> &args,
+                                    int32_t dst) {
+        int32_t base = top_;
+        auto size = static_cast<int32_t>(args.size());
+        reserve(1 + size);
+        auto type = compile(code, base);
+        if (!type) {
+            return type;
+        }
+        for (int32_t i = 0; i < size; ++i) {
+            auto arg = compile(args[i], base + 1 + i);
+            if (!arg) {
+                return arg;
+            }
+        }
+        release(1 + size);
+        emit(Op::Run, dst, base, size);
+        return valueOf(type.value());
+    }
+
+    // Gives a variable the body of a quote binds a fresh name in a new
+    // operand, under which the splices in its scope see it.
+    void bindName(lamgamma::Var var, int32_t slot, Type type) {
+        int32_t operand = outer_->top_;
+        outer_->reserve(1);
+        outer_->emit(Op::Fresh, operand);
+        operands_.push_back(Template::Operand{Template::Operand::Kind::Name, slot});
+        outer_->scope_.push_back(Binding{var, Binding::Kind::Name, operand, type});
+    }
+
+    // A variable bound by an enclosing quote, passed by name in an operand.
+    // Level-0 values are not carried into generated code.
+    Result<Type, BytecodeError> free(lamgamma::Var var, int32_t dst) {
+        auto binding = outer_->lookup(var);
+        if (!binding) {
+            return fail(binding.error());
+        }
+        if (binding.value().kind != Binding::Kind::Name) {
+            return fail(unsupported("variable " + var.toString() + " of an earlier stage"));
+        }
+        int32_t operand = -1;
+        for (const auto &[slot, index] : frees_) {
+            if (slot == binding.value().index) {
+                operand = index;
+            }
+        }
+        if (operand < 0) {
+            operand = static_cast<int32_t>(operands_.size());
+            operands_.push_back(Template::Operand{Template::Operand::Kind::Free});
+            frees_.emplace_back(binding.value().index, operand);
+            int32_t slot = outer_->top_;
+            outer_->reserve(1);
+            outer_->emit(Op::Move, slot, binding.value().index);
+        }
+        emit(Op::Free, dst, operand);
+        return binding.value().shape.type;
+    }
+
+    Result<Binding, BytecodeError> lookup(lamgamma::Var var) const {
+        for (auto it = scope_.rbegin(); it != scope_.rend(); ++it) {
+            if (it->var == var) {
+                return *it;
+            }
+        }
+        return fail(unsupported("free variable " + var.toString()));
+    }
+
+    static Op binOp(BinOp op) {
+        switch (op) {
+        case BinOp::Add:
+            return Op::Add;
+        case BinOp::Sub:
+            return Op::Sub;
+        case BinOp::Mul:
+            return Op::Mul;
+        case BinOp::Div:
+            return Op::Div;
+        case BinOp::Mod:
+            return Op::Mod;
+        case BinOp::Eq:
+            return Op::Eq;
+        case BinOp::Ne:
+            return Op::Ne;
+        case BinOp::Lt:
+            return Op::Lt;
+        case BinOp::Le:
+            return Op::Le;
+        case BinOp::Gt:
+            return Op::Gt;
+        case BinOp::Ge:
+            return Op::Ge;
+        }
+        return Op::Add;
+    }
+
+    size_t emit(Op op, int32_t a = 0, int32_t b = 0, int32_t c = 0) {
+        code_.push_back(Instr{op, a, b, c});
+        return code_.size() - 1;
+    }
+
+    int32_t here() const { return static_cast<int32_t>(code_.size()); }
+
+    void reserve(int32_t n) {
+        top_ += n;
+        frameSize_ = std::max(frameSize_, top_);
+    }
+
+    void release(int32_t n) { top_ -= n; }
+
+    Program &program_;
+    uint32_t index_;
+    FunctionCompiler *outer_ = nullptr;
+    std::vector<Binding> scope_;
+    std::vector<Instr> code_;
+    int32_t top_ = 0;
+    int32_t frameSize_ = 0;
+    // Of a template: its operands so far, and for each variable of an
+    // enclosing quote, the slot of outer_ naming it and its operand.
+    std::vector<Template::Operand> operands_;
+    std::vector<std::pair<int32_t, int32_t>> frees_;
+};
+
+// Copies the code of f into out for a hole whose value goes to slot dst and
+// whose temporaries start at slot base. The name of a variable of t
+// becomes its slot.
+void fillHole(const Template &t, const int32_t *operands, const Fragment &f, int32_t dst,
+              int32_t base, Fragment &out) {
+    auto offset = static_cast<int32_t>(out.code.size());
+    auto slot = [dst, base](int32_t s) { return s == 0 ? dst : base + s - 1; };
+    // The last instruction returns the value.
+    for (size_t j = 0; j + 1 < f.code.size(); ++j) {
+        Instr i = f.code[j];
+        switch (i.op) {
+        case Op::Jump:
+            i.a += offset;
+            break;
+        case Op::JumpIfFalse:
+        case Op::JumpIfTrue:
+            i.a = slot(i.a);
+            i.b += offset;
+            break;
+        case Op::LoadInt:
+            i.a = slot(i.a);
+            break;
+        case Op::Free:
+            i.a = slot(i.a);
+            for (size_t k = 0; k < t.operands.size(); ++k) {
+                if (t.operands[k].kind == Template::Operand::Kind::Name && operands[k] == i.b) {
+                    i = Instr{Op::Move, i.a, t.operands[k].slot};
+                    break;
+                }
+            }
+            break;
+        case Op::Move:
+        case Op::Not:
+        case Op::ArrayLength:
+        // c is a count or a function.
+        case Op::NewArray:
+        case Op::ArrayInit:
+        case Op::ArrayMap:
+        case Op::ArrayFold:
+            i.a = slot(i.a);
+            i.b = slot(i.b);
+            break;
+        default:
+            i.a = slot(i.a);
+            i.b = slot(i.b);
+            i.c = slot(i.c);
+            break;
+        }
+        out.code.push_back(i);
+    }
+    out.code.push_back(Instr{Op::Move, dst, slot(f.code.back().a)});
+    out.frameSize = std::max(out.frameSize, static_cast<uint32_t>(base) + f.frameSize - 1);
+}
+
+} // namespace
+
+const char *toString(Op op) {
+    switch (op) {
+    case Op::LoadInt:
+        return "loadint";
+    case Op::Move:
+        return "move";
+    case Op::Add:
+        return "add";
+    case Op::Sub:
+        return "sub";
+    case Op::Mul:
+        return "mul";
+    case Op::Div:
+        return "div";
+    case Op::Mod:
+        return "mod";
+    case Op::Eq:
+        return "eq";
+    case Op::Ne:
+        return "ne";
+    case Op::Lt:
+        return "lt";
+    case Op::Le:
+        return "le";
+    case Op::Gt:
+        return "gt";
+    case Op::Ge:
+        return "ge";
+    case Op::Not:
+        return "not";
+    case Op::Jump:
+        return "jump";
+    case Op::JumpIfFalse:
+        return "jumpiffalse";
+    case Op::JumpIfTrue:
+        return "jumpiftrue";
+    case Op::Call:
+        return "call";
+    case Op::Return:
+        return "return";
+    case Op::Fresh:
+        return "fresh";
+    case Op::Quote:
+        return "quote";
+    case Op::Run:
+        return "run";
+    case Op::Hole:
+        return "hole";
+    case Op::Free:
+        return "free";
+    case Op::NewArray:
+        return "newarray";
+    case Op::ArrayLength:
+        return "arraylength";
+    case Op::ArrayGet:
+        return "arrayget";
+    case Op::ArrayInit:
+        return "arrayinit";
+    case Op::ArrayMap:
+        return "arraymap";
+    case Op::ArrayFold:
+        return "arrayfold";
+    }
+    return "?";
+}
+
+Result<Fragment, BytecodeError> instantiate(const Template &t, const int32_t *operands,
+                                            const std::vector<Fragment> &fragments) {
+    std::vector<const Fragment *> holes(t.operands.size(), nullptr);
+    for (size_t k = 0; k < t.operands.size(); ++k) {
+        if (t.operands[k].kind != Template::Operand::Kind::Hole) {
+            continue;
+        }
+        if (operands[k] < 0 || static_cast<size_t>(operands[k]) >= fragments.size()) {
+            return fail(unsupported("splice of a value that is not code"));
+        }
+        holes[k] = &fragments[operands[k]];
+        if (holes[k]->arity != 0) {
+            return fail(unsupported("splice of a generated function"));
+        }
+    }
+
+    // Where each instruction of t goes once the holes are filled.
+    std::vector<int32_t> position(t.code.size() + 1);
+    int32_t at = 0;
+    for (size_t i = 0; i < t.code.size(); ++i) {
+        position[i] = at;
+        at += t.code[i].op == Op::Hole ? static_cast<int32_t>(holes[t.code[i].b]->code.size()) : 1;
+    }
+    position[t.code.size()] = at;
+
+    Fragment out;
+    out.arity = t.arity;
+    out.frameSize = t.frameSize;
+    out.code.reserve(static_cast<size_t>(at));
+    for (const Instr &instr : t.code) {
+        switch (instr.op) {
+        case Op::Jump:
+            out.code.push_back(Instr{Op::Jump, position[instr.a]});
+            break;
+        case Op::JumpIfFalse:
+        case Op::JumpIfTrue:
+            out.code.push_back(Instr{instr.op, instr.a, position[instr.b]});
+            break;
+        case Op::Free:
+            out.code.push_back(Instr{Op::Free, instr.a, operands[instr.b]});
+            break;
+        case Op::Hole:
+            fillHole(t, operands, *holes[instr.b], instr.a, instr.c, out);
+            break;
+        default:
+            out.code.push_back(instr);
+            break;
+        }
+    }
+    return out;
+}
+
+Result<Program, BytecodeError> compileBytecode(const RawExpr *expr) {
+    Program program;
+    program.functions.emplace_back();
+    program.functions.back().name = "main";
+    program.entry = 0;
+
+    FunctionCompiler compiler(program, 0, {});
+    Result<Shape, BytecodeError> shape =
+        expr->kind == RawExpr::Kind::Func
+            ? compiler.compileFunction(expr->as<RawExpr::Func>().params,
+                                       expr->as<RawExpr::Func>().body)
+            : compiler.compileFunction(Span<lamgamma::Var>{}, expr);
+    if (!shape) {
+        return fail(shape.error());
+    }
+    return program;
+}
+
+namespace {
+
+void disassemble(const std::vector<Instr> &code, std::string &out) {
+    for (size_t i = 0; i < code.size(); ++i) {
+        const Instr &instr = code[i];
+        out += "  " + std::to_string(i) + ": " + toString(instr.op);
+        switch (instr.op) {
+        case Op::Jump:
+        case Op::Return:
+        case Op::Fresh:
+            out += " " + std::to_string(instr.a);
+            break;
+        case Op::LoadInt:
+        case Op::Move:
+        case Op::Not:
+        case Op::JumpIfFalse:
+        case Op::JumpIfTrue:
+        case Op::Free:
+        case Op::ArrayLength:
+            out += " " + std::to_string(instr.a) + " " + std::to_string(instr.b);
+            break;
+        default:
+            out += " " + std::to_string(instr.a) + " " + std::to_string(instr.b) + " " +
+                   std::to_string(instr.c);
+            break;
+        }
+        out += "\n";
+    }
+}
+
+} // namespace
+
+std::string disassemble(const Program &program) {
+    std::string out;
+    for (const Function &f : program.functions) {
+        out += f.name + "/" + std::to_string(f.arity) + " (frame " + std::to_string(f.frameSize) +
+               "):\n";
+        disassemble(f.code, out);
+    }
+    for (size_t i = 0; i < program.templates.size(); ++i) {
+        const Template &t = program.templates[i];
+        out += "template " + std::to_string(i) + "/" + std::to_string(t.arity) + " (frame " +
+               std::to_string(t.frameSize) + ", operands";
+        for (const Template::Operand &operand : t.operands) {
+            out += operand.kind == Template::Operand::Kind::Name
+                       ? " name@" + std::to_string(operand.slot)
+                   : operand.kind == Template::Operand::Kind::Hole ? " hole"
+                                                                   : " free";
+        }
+        out += "):\n";
+        disassemble(t.code, out);
+    }
+    return out;
+}
+
+} // namespace lamgamma
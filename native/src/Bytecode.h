@@ -0,0 +1,148 @@
+#ifndef LAMGAMMA_BYTECODE_H_
+#define LAMGAMMA_BYTECODE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "RawExpr.h"
+#include "Result.h"
+
+namespace lamgamma {
+
+// Register bytecode for first-order integer and boolean programs: the
+// fragment of Offshore.h, extended with functions bound by let and let rec
+// and applied to all of their arguments, so that recursive programs such
+// as fib run as well as the code spower generates.
+//
+// Every function works on a frame of 32-bit slots. Its parameters come
+// first, then its local variables and temporaries. The result of a
+// function is left in slot 0. Booleans are 0 and 1. Tuples are not boxed:
+// a tuple takes as many consecutive slots as its components, nested ones
+// flattened, and a function returning one leaves it in the slots from 0 on.
+//
+// Quotes are compiled ahead of time into templates: the bytecode of the
+// generated code with a hole for each splice. Generating code fills the
+// holes with fragments, code already generated, so that neither building
+// nor running a code value goes through RawExpr. Code values are handles
+// to the fragments of the Vm running the program, and the variables a
+// quote binds are named by fresh ints, which splices see in slots.
+//
+// Arrays of ints live in the Vm as well, and slots hold their handles.
+// Array.init, Array.map and Array.fold take a function of the program,
+// named or a lambda, which the Vm applies to whole batches of elements.
+enum class Op : uint8_t {
+    LoadInt, // a := imm b
+    Move,    // a := b
+    Add,     // a := b op c, and likewise for the arithmetic
+    Sub,
+    Mul,
+    Div,
+    Mod,
+    Eq, // a := b op c as 0 or 1, and likewise for the comparisons
+    Ne,
+    Lt,
+    Le,
+    Gt,
+    Ge,
+    Not,         // a := !b
+    Jump,        // go to a
+    JumpIfFalse, // go to b unless a
+    JumpIfTrue,  // go to b if a
+    Call,        // a := function b applied to the slots from c on
+    Return,      // return a
+    Fresh,       // a := a fresh name
+    Quote,       // a := template b filled with the operands in the slots from c on
+    Run,         // a := the code in slot b applied to the c slots after it
+    // Arrays are handles to the arrays of the Vm. Init, Map and Fold call
+    // function c on a frame from slot b on, after their operands.
+    NewArray,    // a := the array of the c slots from b on
+    ArrayLength, // a := the length of array b
+    ArrayGet,    // a := element c of array b
+    ArrayInit,   // a := function c applied to each index below b
+    ArrayMap,    // a := function c applied to each element of array b
+    ArrayFold,   // a := function c folded from b over the elements of array b + 1
+    // Only in templates and fragments
+    Hole, // a := the code of operand b, with temporaries from slot c on
+    Free, // a := the variable of operand b, or in a fragment, named b
+};
+
+const char *toString(Op op);
+
+struct Instr {
+    Op op;
+    int32_t a = 0;
+    int32_t b = 0;
+    int32_t c = 0;
+};
+
+enum class ValueType : uint8_t { Int, Bool, Code, Array, Tuple };
+
+struct Function {
+    std::string name;
+    uint32_t arity = 0;
+    uint32_t frameSize = 1;
+    ValueType resultType = ValueType::Int;
+    uint32_t resultSize = 1; // slots, more than one for a tuple
+    std::vector<Instr> code;
+    // Bound by let rec memo: the Vm caches its results by arguments.
+    bool memo = false;
+};
+
+// The body of a quote, laid out as a function taking the parameters of
+// the generated function, if it is one. Quote passes one operand for each
+// entry of operands: a fresh name for each variable the body binds, whose
+// slot is given, a fragment for each hole, and the name of each variable
+// of an enclosing quote the body uses.
+struct Template {
+    struct Operand {
+        enum class Kind : uint8_t { Name, Hole, Free };
+
+        Kind kind;
+        int32_t slot = 0; // of the variable, for a Name
+    };
+
+    uint32_t arity = 0;
+    uint32_t frameSize = 1;
+    std::vector<Instr> code;
+    std::vector<Operand> operands;
+};
+
+// Generated code: a template with its holes filled. Free instructions
+// remain for the variables of quotes still being filled; the code of a
+// whole program has none and runs as a Function.
+struct Fragment {
+    uint32_t arity = 0;
+    uint32_t frameSize = 1;
+    std::vector<Instr> code;
+};
+
+struct Program {
+    std::vector<Function> functions;
+    std::vector<Template> templates;
+    uint32_t entry = 0;
+};
+
+struct BytecodeError {
+    std::string message; // the form outside the fragment
+};
+
+// Compiles expr, or, when expr is a Func, a function taking its
+// parameters. Types are not checked: the program is assumed to be well
+// typed, and parameters are taken to be ints when a result type is needed.
+Result<Program, BytecodeError> compileBytecode(const RawExpr *expr);
+
+// Fills t with operands, the slots a Quote instruction points at, taking
+// the fragments for its holes from fragments. The names of t's variables
+// are resolved in the fragments, which are copied in with their slots and
+// jumps moved. Fails for a hole whose operand is not the handle of an
+// expression, such as a generated function.
+Result<Fragment, BytecodeError> instantiate(const Template &t, const int32_t *operands,
+                                            const std::vector<Fragment> &fragments);
+
+// One instruction per line, for tests and debugging.
+std::string disassemble(const Program &program);
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_BYTECODE_H_
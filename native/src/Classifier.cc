@@ -0,0 +1,32 @@
+#include "Classifier.h"
+
+namespace lamgamma {
+
+bool Classifier::operator<(Classifier other) const {
+    if (kind != other.kind) {
+        return kind < other.kind;
+    }
+    switch (kind) {
+    case Kind::Initial:
+        return false;
+    case Kind::Named:
+        return name < other.name;
+    case Kind::Generated:
+        return id < other.id;
+    }
+    return false;
+}
+
+std::string Classifier::toString() const {
+    switch (kind) {
+    case Kind::Initial:
+        return "!";
+    case Kind::Named:
+        return name.name();
+    case Kind::Generated:
+        return "#" + std::to_string(id);
+    }
+    return "";
+}
+
+} // namespace lamgamma
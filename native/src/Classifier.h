@@ -0,0 +1,51 @@
+#ifndef LAMGAMMA_CLASSIFIER_H_
+#define LAMGAMMA_CLASSIFIER_H_
+
+#include <cstdint>
+#include <string>
+
+#include "Hash.h"
+#include "Symbol.h"
+
+namespace lamgamma {
+
+// Native counterpart of Classifier.res.
+struct Classifier {
+    enum class Kind : uint8_t { Initial, Named, Generated };
+
+    Kind kind = Kind::Initial;
+    Symbol name;     // Named
+    uint32_t id = 0; // Generated
+
+    static Classifier initial() { return Classifier{}; }
+    static Classifier named(Symbol name) { return Classifier{Kind::Named, name, 0}; }
+    static Classifier generated(uint32_t id) { return Classifier{Kind::Generated, Symbol(), id}; }
+
+    bool operator==(Classifier other) const {
+        return kind == other.kind && name == other.name && id == other.id;
+    }
+    bool operator!=(Classifier other) const { return !(*this == other); }
+    bool operator<(Classifier other) const;
+
+    uint64_t hash() const {
+        return hashMix(hashMix(static_cast<uint64_t>(kind), name.id()), id);
+    }
+
+    std::string toString() const;
+
+    // Hands out Generated classifiers. Unlike Classifier.Source in the
+    // playground this is not global: each parse owns one, so numbering is
+    // deterministic per program.
+    class Source {
+      public:
+        void reset() { counter_ = 0; }
+        Classifier fresh() { return Classifier::generated(++counter_); }
+
+      private:
+        uint32_t counter_ = 0;
+    };
+};
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_CLASSIFIER_H_
@@ -0,0 +1,201 @@
+#ifndef LAMGAMMA_EXPR_H_
+#define LAMGAMMA_EXPR_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "Arena.h"
+#include "Classifier.h"
+#include "Operator.h"
+#include "Typ.h"
+#include "Var.h"
+
+namespace lamgamma {
+
+// Native counterpart of Expr.MetaData: the source span of a node.
+struct MetaData {
+    struct Position {
+        uint32_t row = 0;
+        uint32_t col = 0;
+
+        bool operator==(const Position &other) const {
+            return row == other.row && col == other.col;
+        }
+    };
+
+    Position start;
+    Position end;
+    // Identity of the syntax node this was read from (TSNode::id). A subtree
+    // that an incremental reparse reuses keeps its identity, so results
+    // about it can be carried over and its current position looked up
+    // again; null when there is no such node.
+    const void *syntaxId = nullptr;
+
+    bool operator==(const MetaData &other) const {
+        return start == other.start && end == other.end;
+    }
+};
+
+struct Param {
+    Var var;
+    const Typ *typ = nullptr; // None when unannotated
+    Classifier cls;
+};
+
+// Native counterpart of Expr.t, the typed syntax tree. Nodes are allocated in
+// an Arena owned by whoever parsed the program; the concrete node structs
+// below are reached through as<>() after switching on kind.
+struct Expr {
+    enum class Kind : uint8_t {
+        // basic syntax
+        Var,
+        Func,
+        App,
+        Let,
+        LetRec,
+        LetCs,
+        // primitive operations
+        IntLit,
+        BoolLit,
+        BinOp,
+        ShortCircuitOp,
+        UniOp,
+        If,
+        ArrayOp,
+        Tuple,
+        Proj,
+        // staging constructs
+        Quote,
+        Splice,
+        GenLet,
+        ClsAbs,
+        ClsApp,
+    };
+
+    struct Var;
+    struct Func;
+    struct App;
+    struct Let; // Let, LetRec and LetCs
+    struct IntLit;
+    struct BoolLit;
+    struct BinOp;
+    struct ShortCircuitOp;
+    struct UniOp;
+    struct If;
+    struct ArrayOp;
+    struct Tuple;
+    struct Proj;
+    struct Quote;
+    struct Splice;
+    struct GenLet;
+    struct ClsAbs;
+    struct ClsApp;
+
+    Kind kind;
+    MetaData metaData;
+
+    template <class T>
+    const T &as() const {
+        return static_cast<const T &>(*this);
+    }
+};
+
+struct Expr::Var : Expr {
+    lamgamma::Var var;
+};
+
+struct Expr::Func : Expr {
+    Span<Param> params;
+    const Typ *returnType; // None when unannotated
+    const Expr *body;
+};
+
+struct Expr::App : Expr {
+    const Expr *func;
+    const Expr *arg;
+};
+
+struct Expr::Let : Expr {
+    Param param;
+    const Expr *expr;
+    const Expr *body;
+    bool memo = false; // let rec memo: results are cached by argument
+};
+
+struct Expr::IntLit : Expr {
+    int32_t value;
+};
+
+struct Expr::BoolLit : Expr {
+    bool value;
+};
+
+struct Expr::BinOp : Expr {
+    lamgamma::BinOp op;
+    const Expr *left;
+    const Expr *right;
+};
+
+struct Expr::ShortCircuitOp : Expr {
+    lamgamma::ShortCircuitOp op;
+    const Expr *left;
+    const Expr *right;
+};
+
+struct Expr::UniOp : Expr {
+    lamgamma::UniOp op;
+    const Expr *expr;
+};
+
+struct Expr::If : Expr {
+    const Expr *cond;
+    const Expr *thenBranch;
+    const Expr *elseBranch;
+};
+
+// Operands in the order of lamgamma::ArrayOp.
+struct Expr::ArrayOp : Expr {
+    lamgamma::ArrayOp op;
+    Span<const Expr *> args;
+};
+
+// An unboxed tuple of two or more elements.
+struct Expr::Tuple : Expr {
+    Span<const Expr *> elements;
+};
+
+// Component index of tuple, from 0.
+struct Expr::Proj : Expr {
+    const Expr *tuple;
+    uint32_t index;
+};
+
+struct Expr::Quote : Expr {
+    std::optional<Classifier> cls;
+    const Expr *expr;
+};
+
+struct Expr::Splice : Expr {
+    int shift;
+    const Expr *expr;
+};
+
+struct Expr::GenLet : Expr {
+    const Expr *expr;
+};
+
+struct Expr::ClsAbs : Expr {
+    Classifier cls;
+    Classifier base;
+    const Expr *body;
+};
+
+struct Expr::ClsApp : Expr {
+    const Expr *func;
+    Classifier arg;
+};
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_EXPR_H_
@@ -0,0 +1,518 @@
+#include "Frontend.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <exception>
+#include <memory>
+#include <optional>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lamgamma {
+
+namespace Frontend {
+
+namespace {
+
+std::string locString(uint32_t sr, uint32_t sc, uint32_t er, uint32_t ec) {
+    return "(" + std::to_string(sr + 1) + "," + std::to_string(sc) + ")-(" +
+           std::to_string(er + 1) + "," + std::to_string(ec) + ")";
+}
+
+std::string locString(const MetaData &metaData) {
+    return locString(metaData.start.row, metaData.start.col, metaData.end.row, metaData.end.col);
+}
+
+struct TreeDeleter {
+    void operator()(TSTree *tree) const { ts_tree_delete(tree); }
+};
+
+// The steps of the front end an entry point takes input through.
+struct FrontEndOptions {
+    // Type-check the program. print and stripTypeInfo do not, as the
+    // playground's stripTypeInfo does not; nor do save and offshore, which
+    // take programs without type annotations.
+    bool check = true;
+    // Unwrap a quoted function, as run applies the function it quotes.
+    bool unwrapQuote = true;
+};
+
+// A program through the front end. error is empty when every step
+// succeeded; otherwise it is the message, and typeError tells whether the
+// checker rather than the parser gave it.
+struct FrontEndResult {
+    std::string error;
+    bool typeError = false;
+    // The type of the program as typeCheck prints it, when it was checked.
+    std::string type;
+    // The program with its types erased.
+    const RawExpr *code = nullptr;
+};
+
+// Parses input, type-checks it and erases the types into arena, as options
+// say. Every entry point that takes source goes through here.
+FrontEndResult frontEnd(std::string_view input, TSParser *parser, Arena &arena,
+                        const FrontEndOptions &options) {
+    FrontEndResult result;
+    std::unique_ptr<TSTree, TreeDeleter> tree(
+        ts_parser_parse_string(parser, nullptr, input.data(), input.size()));
+    SyntaxNodeParser syntaxNodeParser(arena, input);
+    auto expr = syntaxNodeParser.parseSourceFileNode(ts_tree_root_node(tree.get()));
+    if (!expr) {
+        result.error = parseError2string(expr.error());
+        return result;
+    }
+    if (options.check) {
+        TypeChecker checker;
+        auto typ = checker.typeCheck(expr.value());
+        if (!typ) {
+            result.error = typeError2string(typ.error());
+            result.typeError = true;
+            return result;
+        }
+        result.type = Typ::toString(typ.value());
+    }
+    result.code = lamgamma::stripTypeInfo(expr.value(), arena);
+    if (options.unwrapQuote && result.code->kind == RawExpr::Kind::Quote) {
+        result.code = result.code->as<RawExpr::Quote>().expr;
+    }
+    return result;
+}
+
+// Checks input and compiles it to bytecode. Returns an error message, or
+// an empty string with the program in *program.
+std::string compileProgram(std::string_view input, TSParser *parser,
+                           std::optional<Program> *program) {
+    Arena arena;
+    FrontEndResult checked = frontEnd(input, parser, arena, {});
+    if (!checked.error.empty()) {
+        return checked.error;
+    }
+    auto compiled = compileBytecode(checked.code);
+    if (!compiled) {
+        return "cannot compile to bytecode: " + compiled.error().message;
+    }
+    program->emplace(std::move(compiled.value()));
+    return "";
+}
+
+// A file mapped read-only for its whole length.
+class MappedFile {
+  public:
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            munmap(data_, size_);
+        }
+    }
+
+    // Null when path cannot be opened or mapped.
+    static std::unique_ptr<MappedFile> open(const char *path) {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return nullptr;
+        }
+        struct stat st;
+        std::unique_ptr<MappedFile> file;
+        if (fstat(fd, &st) == 0) {
+            auto size = static_cast<size_t>(st.st_size);
+            void *data = nullptr;
+            if (size > 0) {
+                data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            if (data != MAP_FAILED) {
+                file.reset(new MappedFile(data, size, st.st_dev, st.st_ino));
+                if (data != nullptr) {
+                    madvise(data, size, MADV_SEQUENTIAL);
+                }
+            }
+        }
+        close(fd);
+        return file;
+    }
+
+    const void *data() const { return data_; }
+    size_t size() const { return size_; }
+
+    // Whether path names this file, under any name.
+    bool isAt(const char *path) const {
+        struct stat st;
+        return ::stat(path, &st) == 0 && st.st_dev == dev_ && st.st_ino == ino_;
+    }
+
+  private:
+    MappedFile(void *data, size_t size, dev_t dev, ino_t ino)
+        : data_(data), size_(size), dev_(dev), ino_(ino) {}
+
+    void *data_;
+    size_t size_;
+    dev_t dev_;
+    ino_t ino_;
+};
+
+struct FileDescriptor {
+    int fd;
+    ~FileDescriptor() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+};
+
+bool writeAll(int fd, const void *data, size_t size) {
+    const char *p = static_cast<const char *>(data);
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// A result of vm, of type type, as the interpreter prints it.
+std::string show(const Vm &vm, ValueType type, int32_t value) {
+    switch (type) {
+    case ValueType::Bool:
+        return value != 0 ? "true" : "false";
+    case ValueType::Array: {
+        std::string out = "[|";
+        const std::vector<int32_t> &elements = vm.array(value);
+        for (size_t i = 0; i < elements.size(); ++i) {
+            out += (i == 0 ? " " : ", ") + std::to_string(elements[i]);
+        }
+        return out + " |]";
+    }
+    case ValueType::Int:
+    case ValueType::Code:
+    // Refused by the callers, as only the first slot of a tuple is at hand.
+    case ValueType::Tuple:
+        break;
+    }
+    return std::to_string(value);
+}
+
+// Compiles code to bytecode and applies it to args, as run does once the
+// program is parsed. Returns an error message, or an empty string with the
+// result in *output.
+std::string runCode(const RawExpr *code, const std::vector<int32_t> &args, std::string *output,
+                    const VmOptions &options) {
+    auto program = compileBytecode(code);
+    if (!program) {
+        return "cannot compile to bytecode: " + program.error().message;
+    }
+    const Function &entry = program.value().functions[program.value().entry];
+    if (entry.resultType == ValueType::Code) {
+        return "cannot print generated code";
+    }
+    if (entry.resultType == ValueType::Tuple) {
+        return "cannot print a tuple";
+    }
+    if (args.size() != entry.arity) {
+        return "expected " + std::to_string(entry.arity) + " arguments, got " +
+               std::to_string(args.size());
+    }
+    ValueType resultType = entry.resultType;
+    Vm vm(std::move(program.value()), options);
+    auto result = vm.run(args);
+    if (!result) {
+        return toString(result.error());
+    }
+    *output = show(vm, resultType, result.value());
+    return "";
+}
+
+} // namespace
+
+std::string parseError2string(const ParseError &e) {
+    std::string loc = locString(e.start.row, e.start.column, e.end.row, e.end.column);
+    switch (e.kind) {
+    case ParseError::Kind::SyntaxError:
+        return loc + " Syntax error";
+    case ParseError::Kind::MissingNodeError:
+        return loc + " Missing node: " + e.missing;
+    }
+    return loc;
+}
+
+std::string typeError2string(const TypeError &e) {
+    std::string loc = locString(e.metaData);
+    switch (e.kind) {
+    case TypeError::Kind::TypeMismatch:
+        return loc + " Type error: expected " + Typ::toString(e.expected) + ", but got " +
+               Typ::toString(e.actual);
+    case TypeError::Kind::ClassifierMismatch:
+        return loc + " Type error: spliced classifier " + e.spliced.toString() +
+               " is inconsistent classifier with " + e.current.toString();
+    case TypeError::Kind::ClassifierEscape:
+        return loc + " Type error: classifier escape detected";
+    case TypeError::Kind::UndefinedVariable:
+        return loc + " Undefined variable: " + e.var.toString();
+    case TypeError::Kind::InsufficientTypeAnnotation:
+        return loc + " Insufficient type annotation";
+    case TypeError::Kind::UnsupportedFormat:
+        return loc + " Unsupported format: " + e.message;
+    case TypeError::Kind::UndefinedClassifier:
+        return loc + " Undefined classifier: " + e.cls.toString();
+    case TypeError::Kind::MalformedSplice:
+        return loc + " Shift in splice is too large: " + std::to_string(e.shift);
+    }
+    return loc;
+}
+
+std::string typeCheck(std::string_view input, TSParser *parser) {
+    try {
+        Arena arena;
+        FrontEndResult checked = frontEnd(input, parser, arena, {true, false});
+        return checked.error.empty() ? checked.type : checked.error;
+    } catch (const std::exception &) {
+        return "error";
+    }
+}
+
+std::string stripTypeInfo(std::string_view input, TSParser *parser) {
+    try {
+        Arena arena;
+        FrontEndResult parsed = frontEnd(input, parser, arena, {false, false});
+        return parsed.error.empty() ? toString(parsed.code) : parsed.error;
+    } catch (const std::exception &) {
+        return "error";
+    }
+}
+
+std::string print(std::string_view input, TSParser *parser, int fd,
+                  const PrintOptions &options) {
+    try {
+        Arena arena;
+        FrontEndResult parsed = frontEnd(input, parser, arena, {false, false});
+        if (!parsed.error.empty()) {
+            return parsed.error;
+        }
+        if (!printToFd(parsed.code, fd, options)) {
+            return "cannot write output";
+        }
+        return "";
+    } catch (const std::exception &) {
+        return "error";
+    }
+}
+
+std::string offshore(std::string_view input, TSParser *parser, const std::vector<int32_t> &args,
+                     std::string *output, const OffshoreOptions &options) {
+    try {
+        Arena arena;
+        FrontEndResult parsed = frontEnd(input, parser, arena, {false, true});
+        if (!parsed.error.empty()) {
+            return parsed.error;
+        }
+        auto function = lamgamma::offshore(parsed.code, options);
+        if (!function) {
+            return toString(function.error());
+        }
+        if (args.size() != function.value().arity()) {
+            return "expected " + std::to_string(function.value().arity()) + " arguments, got " +
+                   std::to_string(args.size());
+        }
+        int32_t result;
+        if (function.value().call(args.data(), &result) == NativeFunction::Status::ZeroDivision) {
+            return "division by zero";
+        }
+        *output = function.value().resultType() == OffshoreType::Int ? std::to_string(result)
+                  : result != 0                                       ? "true"
+                                                                      : "false";
+        return "";
+    } catch (const std::exception &) {
+        return "error";
+    }
+}
+
+std::string run(std::string_view input, TSParser *parser, const std::vector<int32_t> &args,
+                std::string *output, const VmOptions &options) {
+    try {
+        Arena arena;
+        FrontEndResult checked = frontEnd(input, parser, arena, {});
+        if (!checked.error.empty()) {
+            return checked.error;
+        }
+        return runCode(checked.code, args, output, options);
+    } catch (const std::exception &) {
+        return "error";
+    }
+}
+
+std::string save(std::string_view input, TSParser *parser, const char *outputPath) {
+    try {
+        Arena arena;
+        FrontEndResult parsed = frontEnd(input, parser, arena, {false, true});
+        if (!parsed.error.empty()) {
+            return parsed.error;
+        }
+        std::vector<uint8_t> bytes = encode(parsed.code);
+        FileDescriptor out{::open(outputPath, O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+        if (out.fd < 0 || !writeAll(out.fd, bytes.data(), bytes.size())) {
+            return std::string("cannot write ") + outputPath;
+        }
+        return "";
+    } catch (const std::exception &) {
+        return "error";
+    }
+}
+
+std::string load(const char *path, const std::vector<int32_t> &args, std::string *output,
+                 const VmOptions &options) {
+    try {
+        auto file = MappedFile::open(path);
+        if (file == nullptr) {
+            return std::string("cannot read ") + path;
+        }
+        Arena arena;
+        auto code = decode(static_cast<const uint8_t *>(file->data()), file->size(), arena);
+        if (!code) {
+            return std::string(path) + ": " + toString(code.error());
+        }
+        return runCode(code.value(), args, output, options);
+    } catch (const std::exception &) {
+        return "error";
+    }
+}
+
+std::string runBatch(std::string_view input, TSParser *parser, const std::vector<int32_t> &column,
+                     std::vector<int32_t> *results, const VmOptions &options) {
+    try {
+        std::optional<Program> program;
+        std::string error = compileProgram(input, parser, &program);
+        if (!error.empty()) {
+            return error;
+        }
+        Vm vm(std::move(*program), options);
+        auto batch = vm.runBatch(column);
+        if (!batch) {
+            return toString(batch.error());
+        }
+        *results = std::move(batch.value());
+        return "";
+    } catch (const std::exception &) {
+        return "error";
+    }
+}
+
+std::string stream(std::string_view input, TSParser *parser, const char *inputPath,
+                   const char *outputPath, ColumnWidth width, const StreamOptions &options) {
+    try {
+        std::optional<Program> program;
+        std::string error = compileProgram(input, parser, &program);
+        if (!error.empty()) {
+            return error;
+        }
+        Vm vm(std::move(*program), options.vm);
+        // An empty batch generates the function, so that a program that is
+        // none fails before any file is touched.
+        auto ready = vm.runBatch(nullptr, 0, nullptr);
+        if (!ready) {
+            return toString(ready.error());
+        }
+        auto column = MappedFile::open(inputPath);
+        if (column == nullptr) {
+            return std::string("cannot read ") + inputPath;
+        }
+        size_t valueSize = width == ColumnWidth::Int32 ? sizeof(int32_t) : sizeof(int64_t);
+        if (column->size() % valueSize != 0) {
+            return std::string(inputPath) + " is not a whole number of " +
+                   (width == ColumnWidth::Int32 ? "int32" : "int64") + " values";
+        }
+        // Truncating the input would empty the mapping under the loop.
+        if (column->isAt(outputPath)) {
+            return std::string("cannot write ") + outputPath + ": it is the input";
+        }
+        FileDescriptor out{::open(outputPath, O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+        if (out.fd < 0) {
+            return std::string("cannot write ") + outputPath;
+        }
+
+        size_t count = column->size() / valueSize;
+        size_t chunk = std::max<size_t>(options.chunkValues, 1);
+        std::vector<int32_t> values(width == ColumnWidth::Int64 ? std::min(chunk, count) : 0);
+        std::vector<int32_t> results(std::min(chunk, count));
+        std::vector<int64_t> wide(width == ColumnWidth::Int64 ? std::min(chunk, count) : 0);
+        for (size_t start = 0; start < count; start += chunk) {
+            size_t n = std::min(chunk, count - start);
+            const int32_t *in;
+            if (width == ColumnWidth::Int32) {
+                // The mapping is page-aligned, so the values are aligned.
+                in = static_cast<const int32_t *>(column->data()) + start;
+            } else {
+                const int64_t *in64 = static_cast<const int64_t *>(column->data()) + start;
+                for (size_t k = 0; k < n; ++k) {
+                    if (in64[k] < INT32_MIN || in64[k] > INT32_MAX) {
+                        return "value " + std::to_string(start + k) + " does not fit in 32 bits";
+                    }
+                    values[k] = static_cast<int32_t>(in64[k]);
+                }
+                in = values.data();
+            }
+            auto batch = vm.runBatch(in, n, results.data());
+            if (!batch) {
+                return toString(batch.error()) + " in values " + std::to_string(start) + " to " +
+                       std::to_string(start + n - 1);
+            }
+            bool written;
+            if (width == ColumnWidth::Int32) {
+                written = writeAll(out.fd, results.data(), n * sizeof(int32_t));
+            } else {
+                std::copy(results.begin(), results.begin() + n, wide.begin());
+                written = writeAll(out.fd, wide.data(), n * sizeof(int64_t));
+            }
+            if (!written) {
+                return std::string("cannot write ") + outputPath;
+            }
+        }
+        return "";
+    } catch (const std::exception &) {
+        return "error";
+    }
+}
+
+bool evaluate(std::string_view input, TSParser *parser, std::string *output,
+              const VmOptions &options) {
+    try {
+        Arena arena;
+        FrontEndResult checked = frontEnd(input, parser, arena, {true, false});
+        // The interpreter reports type errors.
+        if (checked.typeError) {
+            return false;
+        }
+        if (!checked.error.empty()) {
+            *output = "error";
+            return true;
+        }
+        auto program = compileBytecode(checked.code);
+        // A function program evaluates to a closure; code and tuples are
+        // printed by the interpreter.
+        if (!program || program.value().functions[program.value().entry].arity != 0 ||
+            program.value().functions[program.value().entry].resultType == ValueType::Code ||
+            program.value().functions[program.value().entry].resultType == ValueType::Tuple) {
+            return false;
+        }
+        ValueType resultType = program.value().functions[program.value().entry].resultType;
+        Vm vm(std::move(program.value()), options);
+        auto result = vm.run({});
+        *output = result ? show(vm, resultType, result.value()) : "error";
+        return true;
+    } catch (const std::exception &) {
+        *output = "error";
+        return true;
+    }
+}
+
+} // namespace Frontend
+
+} // namespace lamgamma
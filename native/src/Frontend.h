@@ -0,0 +1,103 @@
+#ifndef LAMGAMMA_FRONTEND_H_
+#define LAMGAMMA_FRONTEND_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tree_sitter/api.h>
+
+#include "Offshore.h"
+#include "Printer.h"
+#include "Serialize.h"
+#include "SyntaxNodeParser.h"
+#include "TypeChecker.h"
+#include "Vm.h"
+
+namespace lamgamma {
+
+// Native counterpart of Frontend.res: string-in, string-out entry points
+// that produce the same messages as the playground.
+namespace Frontend {
+
+std::string parseError2string(const ParseError &e);
+std::string typeError2string(const TypeError &e);
+
+// The parser must already have the lamgamma language set.
+std::string typeCheck(std::string_view input, TSParser *parser);
+
+// The program with its type information erased, on a single line, as
+// Frontend.stripTypeInfo returns it.
+std::string stripTypeInfo(std::string_view input, TSParser *parser);
+
+// Prints the program with its type information erased to fd. Returns an
+// error message, or an empty string when the program was printed.
+std::string print(std::string_view input, TSParser *parser, int fd,
+                  const PrintOptions &options = {});
+
+// Offshores the function in input, generated code as the playground prints
+// it (a quote is unwrapped), and applies it to args. Returns an error
+// message, or an empty string with the result in *output.
+std::string offshore(std::string_view input, TSParser *parser, const std::vector<int32_t> &args,
+                     std::string *output, const OffshoreOptions &options = {});
+
+// Type-checks the program in input, compiles it to bytecode and runs it on
+// the VM. As with offshore, a quoted function is unwrapped and applied to
+// args; any other program takes no arguments. Returns an error message (the
+// type checker's, for an ill-typed program), or an empty string with the
+// result in *output.
+std::string run(std::string_view input, TSParser *parser, const std::vector<int32_t> &args,
+                std::string *output, const VmOptions &options = {});
+
+// Encodes the program in input, with its type information erased and a
+// quote unwrapped as run does, in the format of Serialize.res and writes it
+// to outputPath. Returns an error message, or an empty string.
+std::string save(std::string_view input, TSParser *parser, const char *outputPath);
+
+// run for encoded code: maps the file at path into memory, decodes the
+// program from it without copying and runs it on the VM. Returns an error
+// message, or an empty string with the result in *output.
+std::string load(const char *path, const std::vector<int32_t> &args, std::string *output,
+                 const VmOptions &options = {});
+
+// Compiles the program in input as run does and applies the function it
+// is, or whose code it generates, to every value of column in batches
+// (Vm::runBatch). Returns an error message, or an empty string with the
+// results in *results.
+std::string runBatch(std::string_view input, TSParser *parser, const std::vector<int32_t> &column,
+                     std::vector<int32_t> *results, const VmOptions &options = {});
+
+// The layout of a column file: native-endian ints of 32 or 64 bits, one
+// after another.
+enum class ColumnWidth : uint8_t { Int32, Int64 };
+
+struct StreamOptions {
+    VmOptions vm;
+    // Values per batch call, and per write of the results.
+    size_t chunkValues = size_t{1} << 16;
+};
+
+// The columnar counterpart of runBatch: maps the file at inputPath into
+// memory, streams its values through the function chunk by chunk, and
+// writes the results to outputPath in the same layout. int64 values must
+// fit in 32 bits, and results are sign-extended. outputPath must not name
+// the input file. Returns an error message, or an empty string.
+std::string stream(std::string_view input, TSParser *parser, const char *inputPath,
+                   const char *outputPath, ColumnWidth width, const StreamOptions &options = {});
+
+// Frontend.evaluate for the programs the VM runs: sets *output to the
+// printed value, or to "error" when the program does not parse or fails at
+// run time, and returns true. Returns false, leaving *output alone, for
+// programs outside the bytecode fragment, whose values (closures, code)
+// only the interpreter has, and for ill-typed programs, which the
+// interpreter runs untyped and the VM cannot.
+bool evaluate(std::string_view input, TSParser *parser, std::string *output,
+              const VmOptions &options = {});
+
+} // namespace Frontend
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_FRONTEND_H_
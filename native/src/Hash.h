@@ -0,0 +1,20 @@
+#ifndef LAMGAMMA_HASH_H_
+#define LAMGAMMA_HASH_H_
+
+#include <cstdint>
+
+namespace lamgamma {
+
+// Folds v into seed. Used for structural fingerprints, where a good spread
+// matters more than speed of a single step.
+inline uint64_t hashMix(uint64_t seed, uint64_t v) {
+    uint64_t x = seed ^ (v + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+    x ^= x >> 31;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    return x;
+}
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_HASH_H_
@@ -0,0 +1,218 @@
+#include "IncrementalTypeChecker.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <utility>
+
+#include "Frontend.h"
+#include "SyntaxNodeParser.h"
+
+namespace lamgamma {
+
+namespace {
+
+TSPoint advance(TSPoint point, std::string_view text) {
+    for (char c : text) {
+        if (c == '\n') {
+            ++point.row;
+            point.column = 0;
+        } else {
+            ++point.column;
+        }
+    }
+    return point;
+}
+
+// Ranges that merely touch count as overlapping: typing at the end of a
+// token changes the token.
+bool overlaps(TSNode node, const TSRange &range) {
+    return ts_node_start_byte(node) <= range.end_byte && range.start_byte <= ts_node_end_byte(node);
+}
+
+void retainSubtree(TypingMemo &memo, ExprCache &exprs, TSNode node) {
+    memo.retain(node.id);
+    exprs.retain(node.id);
+    uint32_t count = ts_node_child_count(node);
+    for (uint32_t i = 0; i < count; ++i) {
+        retainSubtree(memo, exprs, ts_node_child(node, i));
+    }
+}
+
+bool findNode(TSNode node, const void *id, TSNode *found) {
+    if (node.id == id) {
+        *found = node;
+        return true;
+    }
+    uint32_t count = ts_node_child_count(node);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (findNode(ts_node_child(node, i), id, found)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+IncrementalTypeChecker::~IncrementalTypeChecker() {
+    forgetHistory();
+    if (tree_ != nullptr) {
+        ts_tree_delete(tree_);
+    }
+}
+
+void IncrementalTypeChecker::setSource(std::string source) {
+    source_ = std::move(source);
+    memo_.clear();
+    exprs_.clear();
+    forgetHistory();
+    compactedSize_ = 0;
+    replaced_ = 0;
+    if (tree_ != nullptr) {
+        ts_tree_delete(tree_);
+    }
+    tree_ = ts_parser_parse_string(parser_, nullptr, source_.data(), source_.size());
+}
+
+void IncrementalTypeChecker::edit(const TSInputEdit &edit, std::string source) {
+    if (tree_ == nullptr) {
+        setSource(std::move(source));
+        return;
+    }
+    history_.push_back(ts_tree_copy(tree_));
+    ts_tree_edit(tree_, &edit);
+    source_ = std::move(source);
+    TSTree *tree = ts_parser_parse_string(parser_, tree_, source_.data(), source_.size());
+
+    uint32_t count = 0;
+    TSRange *changed = ts_tree_get_changed_ranges(tree_, tree, &count);
+    std::vector<TSRange> dirty(changed, changed + count);
+    std::free(changed);
+    // Ancestors of the edit may keep their identity even though their text
+    // changed.
+    dirty.push_back(TSRange{edit.start_point, edit.new_end_point, edit.start_byte,
+                            edit.new_end_byte});
+
+    ts_tree_delete(tree_);
+    tree_ = tree;
+    invalidateDirty(ts_tree_root_node(tree_), dirty);
+    // Each edit leaves the nodes it replaced behind, in the history and
+    // with their results. Sweep them once they could outnumber the live
+    // ones, so that the whole tree is walked only every so many edits.
+    if (replaced_ > compactedSize_ + 1024) {
+        compact();
+    }
+}
+
+void IncrementalTypeChecker::replace(uint32_t start, uint32_t oldLength, std::string_view text) {
+    std::string_view before(source_);
+    TSInputEdit e;
+    e.start_byte = start;
+    e.old_end_byte = start + oldLength;
+    e.new_end_byte = start + static_cast<uint32_t>(text.size());
+    e.start_point = advance(TSPoint{0, 0}, before.substr(0, start));
+    e.old_end_point = advance(e.start_point, before.substr(start, oldLength));
+    e.new_end_point = advance(e.start_point, text);
+
+    std::string source = source_;
+    source.replace(start, oldLength, text);
+    edit(e, std::move(source));
+}
+
+void IncrementalTypeChecker::update(std::string_view source) {
+    if (tree_ == nullptr) {
+        setSource(std::string(source));
+        return;
+    }
+    size_t limit = std::min(source_.size(), source.size());
+    size_t prefix = 0;
+    while (prefix < limit && source_[prefix] == source[prefix]) {
+        ++prefix;
+    }
+    if (prefix == source_.size() && prefix == source.size()) {
+        return;
+    }
+    size_t suffix = 0;
+    while (suffix < limit - prefix &&
+           source_[source_.size() - 1 - suffix] == source[source.size() - 1 - suffix]) {
+        ++suffix;
+    }
+    replace(static_cast<uint32_t>(prefix), static_cast<uint32_t>(source_.size() - prefix - suffix),
+            source.substr(prefix, source.size() - prefix - suffix));
+}
+
+void IncrementalTypeChecker::invalidateDirty(TSNode node, const std::vector<TSRange> &dirty) {
+    bool clean = true;
+    for (const TSRange &range : dirty) {
+        if (overlaps(node, range)) {
+            clean = false;
+            break;
+        }
+    }
+    if (clean) {
+        return;
+    }
+    memo_.invalidate(node.id);
+    exprs_.invalidate(node.id);
+    ++replaced_;
+    uint32_t count = ts_node_child_count(node);
+    for (uint32_t i = 0; i < count; ++i) {
+        invalidateDirty(ts_node_child(node, i), dirty);
+    }
+}
+
+void IncrementalTypeChecker::compact() {
+    retainSubtree(memo_, exprs_, ts_tree_root_node(tree_));
+    memo_.sweep();
+    exprs_.sweep();
+    forgetHistory();
+    compactedSize_ = exprs_.size();
+    replaced_ = 0;
+}
+
+void IncrementalTypeChecker::forgetHistory() {
+    for (TSTree *tree : history_) {
+        ts_tree_delete(tree);
+    }
+    history_.clear();
+}
+
+MetaData IncrementalTypeChecker::relocate(const MetaData &metaData) const {
+    TSNode node;
+    if (metaData.syntaxId != nullptr &&
+        findNode(ts_tree_root_node(tree_), metaData.syntaxId, &node)) {
+        return SyntaxNodeParser::extractMetadata(node);
+    }
+    return metaData;
+}
+
+std::string IncrementalTypeChecker::typeCheck() {
+    if (tree_ == nullptr) {
+        setSource(source_);
+    }
+    memo_.resetStats();
+    exprs_.resetStats();
+    try {
+        SyntaxNodeParser syntaxNodeParser(exprs_.arena(), source_);
+        syntaxNodeParser.setCache(&exprs_);
+        auto expr = syntaxNodeParser.parseSourceFileNode(ts_tree_root_node(tree_));
+        if (!expr) {
+            return Frontend::parseError2string(expr.error());
+        }
+        TypeChecker checker;
+        checker.setMemo(&memo_);
+        auto typ = checker.typeCheck(expr.value());
+        if (!typ) {
+            // The Expr may have been built before an edit above it moved it.
+            TypeError error = typ.error();
+            error.metaData = relocate(error.metaData);
+            return Frontend::typeError2string(error);
+        }
+        return Typ::toString(typ.value());
+    } catch (const std::exception &) {
+        return "error";
+    }
+}
+
+} // namespace lamgamma
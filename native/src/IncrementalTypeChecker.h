@@ -0,0 +1,77 @@
+#ifndef LAMGAMMA_INCREMENTALTYPECHECKER_H_
+#define LAMGAMMA_INCREMENTALTYPECHECKER_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tree_sitter/api.h>
+
+#include "SyntaxNodeParser.h"
+#include "TypeChecker.h"
+
+namespace lamgamma {
+
+// Type checker for a document that is edited in place, as in the playground
+// editor. The syntax tree is reparsed incrementally. Exprs are kept per
+// syntax node (see ExprCache) and typing results are memoized per node (see
+// TypingMemo); an edit invalidates only the nodes that overlap it or the
+// ranges tree-sitter reports as changed, so a recheck after a local edit
+// only rebuilds and revisits the spine from the edit to the root.
+class IncrementalTypeChecker {
+  public:
+    // The parser must already have the lamgamma language set.
+    explicit IncrementalTypeChecker(TSParser *parser) : parser_(parser) {}
+    ~IncrementalTypeChecker();
+    IncrementalTypeChecker(const IncrementalTypeChecker &) = delete;
+    IncrementalTypeChecker &operator=(const IncrementalTypeChecker &) = delete;
+
+    // Replaces the whole document, forgetting every memoized result.
+    void setSource(std::string source);
+
+    // Applies an edit; source is the whole document after it.
+    void edit(const TSInputEdit &edit, std::string source);
+
+    // Replaces oldLength bytes at start with text, computing the edit.
+    void replace(uint32_t start, uint32_t oldLength, std::string_view text);
+
+    // Replaces the document with source, as a single edit of the bytes
+    // between their common prefix and suffix. For editors that hand over
+    // the whole text rather than their edits.
+    void update(std::string_view source);
+
+    // Same messages as Frontend::typeCheck, except that generated
+    // classifiers may be numbered differently.
+    std::string typeCheck();
+
+    const std::string &source() const { return source_; }
+    const TypingMemo &memo() const { return memo_; }
+    const ExprCache &exprs() const { return exprs_; }
+
+  private:
+    // Drops the results of every node under node that overlaps one of the
+    // dirty ranges.
+    void invalidateDirty(TSNode node, const std::vector<TSRange> &dirty);
+    // Drops the results of nodes that are no longer in the tree, and the
+    // trees kept for them; the arenas they were allocated in are rebuilt
+    // once they are mostly garbage.
+    void compact();
+    void forgetHistory();
+    MetaData relocate(const MetaData &metaData) const;
+
+    TSParser *parser_;
+    std::string source_;
+    TSTree *tree_ = nullptr;
+    // Earlier trees. They keep the nodes that have results here alive until
+    // the next compaction, so no node of a later tree can take over their
+    // identity, and edits never have to look at the clean part of a tree.
+    std::vector<TSTree *> history_;
+    size_t compactedSize_ = 0; // Exprs kept by the last compaction
+    size_t replaced_ = 0;      // dirty nodes since then
+    TypingMemo memo_;
+    ExprCache exprs_;
+};
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_INCREMENTALTYPECHECKER_H_
@@ -0,0 +1,227 @@
+// Incremental checks must agree with checking the edited program from
+// scratch, while rechecking only the part of it an edit touched.
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+#include <tree_sitter/api.h>
+
+#include "Frontend.h"
+#include "IncrementalTypeChecker.h"
+#include "tree-sitter-lamgamma_parser.h"
+
+namespace lamgamma {
+namespace {
+
+class IncrementalTypeCheckerSpec : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        parser_ = ts_parser_new();
+        ts_parser_set_language(parser_, tree_sitter_lamgamma_parser());
+        fresh_ = ts_parser_new();
+        ts_parser_set_language(fresh_, tree_sitter_lamgamma_parser());
+    }
+
+    void TearDown() override {
+        ts_parser_delete(parser_);
+        ts_parser_delete(fresh_);
+    }
+
+    // Replaces the first occurrence of from with to, checks incrementally and
+    // compares with a check from scratch.
+    std::string replace(IncrementalTypeChecker &checker, const std::string &from,
+                        const std::string &to) {
+        size_t pos = checker.source().find(from);
+        EXPECT_NE(pos, std::string::npos) << from;
+        checker.replace(static_cast<uint32_t>(pos), static_cast<uint32_t>(from.size()), to);
+        std::string result = checker.typeCheck();
+        EXPECT_EQ(result, Frontend::typeCheck(checker.source(), fresh_)) << checker.source();
+        return result;
+    }
+
+    // A chain of n function definitions, each used by the final expression.
+    static std::string program(int n) {
+        std::string source;
+        for (int i = 0; i < n; ++i) {
+            std::string k = std::to_string(i);
+            source += "let f" + k + " = (x: int) => { x + " + k + "00 } in\n";
+        }
+        source += "f0 1";
+        for (int i = 1; i < n; ++i) {
+            source += " + f" + std::to_string(i) + " 1";
+        }
+        return source;
+    }
+
+    TSParser *parser_ = nullptr;
+    TSParser *fresh_ = nullptr;
+};
+
+TEST_F(IncrementalTypeCheckerSpec, AgreesWithFullCheckOnFirstRun) {
+    IncrementalTypeChecker checker(parser_);
+    checker.setSource("let y = (x: int) => { x + 1 } in y 2");
+    EXPECT_EQ(checker.typeCheck(), "Int");
+    checker.setSource("1 + true");
+    EXPECT_EQ(checker.typeCheck(), "(1,4)-(1,8) Type error: expected Int, but got Bool");
+    checker.setSource("1 +");
+    EXPECT_EQ(checker.typeCheck(), Frontend::typeCheck("1 +", fresh_));
+}
+
+TEST_F(IncrementalTypeCheckerSpec, RechecksOnlyTheSpineOfALocalEdit) {
+    const int n = 200;
+    IncrementalTypeChecker checker(parser_);
+    checker.setSource(program(n));
+    EXPECT_EQ(checker.typeCheck(), "Int");
+    size_t fullCheck = checker.memo().misses();
+    EXPECT_EQ(checker.memo().hits(), 0u);
+
+    EXPECT_EQ(replace(checker, "x + 4200", "x + 42"), "Int");
+    // The spine is the let chain down to f42 plus its body; the other
+    // definitions and their uses come from the memo.
+    EXPECT_LT(checker.memo().misses(), fullCheck / 2);
+    EXPECT_GT(checker.memo().hits(), 0u);
+
+    // Checking again without an edit revisits nothing.
+    EXPECT_EQ(checker.typeCheck(), "Int");
+    EXPECT_EQ(checker.memo().misses(), 0u);
+    EXPECT_EQ(checker.memo().hits(), 1u);
+}
+
+TEST_F(IncrementalTypeCheckerSpec, RebuildsOnlyTheExprsOfTheSpine) {
+    const int n = 200;
+    IncrementalTypeChecker checker(parser_);
+    checker.setSource(program(n));
+    EXPECT_EQ(checker.typeCheck(), "Int");
+    size_t fullBuild = checker.exprs().built();
+    EXPECT_EQ(checker.exprs().reused(), 0u);
+
+    EXPECT_EQ(replace(checker, "x + 4200", "x + 42"), "Int");
+    EXPECT_LT(checker.exprs().built(), fullBuild / 2);
+    EXPECT_GT(checker.exprs().reused(), 0u);
+
+    EXPECT_EQ(checker.typeCheck(), "Int");
+    EXPECT_EQ(checker.exprs().built(), 0u);
+    EXPECT_EQ(checker.exprs().reused(), 1u);
+}
+
+TEST_F(IncrementalTypeCheckerSpec, KeepsTheClassifiersOfTheRestOfTheDocument) {
+    const int n = 200;
+    IncrementalTypeChecker checker(parser_);
+    checker.setSource(program(n));
+    EXPECT_EQ(checker.typeCheck(), "Int");
+    size_t fullCheck = checker.memo().misses();
+
+    // A new unannotated binder early in the document. The parameters of the
+    // functions after it keep their classifiers, so their bodies are not
+    // checked again.
+    EXPECT_EQ(replace(checker, "x + 500", "((y: int) => { y }) 500"), "Int");
+    EXPECT_LT(checker.memo().misses(), fullCheck / 10);
+}
+
+TEST_F(IncrementalTypeCheckerSpec, TakesWholeDocumentsFromEditors) {
+    IncrementalTypeChecker checker(parser_);
+    checker.update(program(50));
+    EXPECT_EQ(checker.typeCheck(), "Int");
+    size_t fullCheck = checker.memo().misses();
+
+    std::string source = program(50);
+    source.replace(source.find("x + 4000"), 8, "x + 40 * 2");
+    checker.update(source);
+    EXPECT_EQ(checker.source(), source);
+    EXPECT_EQ(checker.typeCheck(), "Int");
+    EXPECT_LT(checker.memo().misses(), fullCheck / 2);
+
+    checker.update(source);
+    EXPECT_EQ(checker.typeCheck(), "Int");
+    EXPECT_EQ(checker.memo().misses(), 0u);
+
+    checker.update("1 + true");
+    EXPECT_EQ(checker.typeCheck(), "(1,4)-(1,8) Type error: expected Int, but got Bool");
+}
+
+TEST_F(IncrementalTypeCheckerSpec, StaysCorrectOverManyEdits) {
+    IncrementalTypeChecker checker(parser_);
+    checker.setSource(program(20));
+    EXPECT_EQ(checker.typeCheck(), "Int");
+    // Enough edits for the results of replaced nodes to be swept a few times.
+    for (int i = 0; i < 300; ++i) {
+        replace(checker, i % 2 == 0 ? "x + 1000" : "x + true", i % 2 == 0 ? "x + true" : "x + 1000");
+    }
+    EXPECT_EQ(checker.typeCheck(), "Int");
+}
+
+TEST_F(IncrementalTypeCheckerSpec, KeepsMemoryBoundedOverALongSession) {
+    IncrementalTypeChecker checker(parser_);
+    checker.setSource(program(50));
+    EXPECT_EQ(checker.typeCheck(), "Int");
+    // Every edit builds a new spine. The arena is rebuilt before the old
+    // ones pile up, so a second stretch of editing needs no more of it than
+    // the first.
+    size_t pos = checker.source().find("x + 4000");
+    size_t peak[2] = {0, 0};
+    for (int i = 0; i < 600; ++i) {
+        checker.replace(static_cast<uint32_t>(pos), i % 2 == 0 ? 8 : 6,
+                        i % 2 == 0 ? "x + 41" : "x + 4000");
+        EXPECT_EQ(checker.typeCheck(), "Int");
+        peak[i / 300] = std::max(peak[i / 300], checker.exprs().bytes());
+    }
+    EXPECT_LE(peak[1], peak[0]);
+}
+
+TEST_F(IncrementalTypeCheckerSpec, ReportsErrorsAtTheirCurrentPosition) {
+    IncrementalTypeChecker checker(parser_);
+    checker.setSource(program(20));
+    EXPECT_EQ(checker.typeCheck(), "Int");
+
+    EXPECT_EQ(replace(checker, "x + 700", "x + true"),
+              "(8,27)-(8,31) Type error: expected Int, but got Bool");
+    // Shift everything down a line; the error moves with it.
+    replace(checker, "let f0", "\nlet f0");
+    EXPECT_EQ(checker.typeCheck(), "(9,27)-(9,31) Type error: expected Int, but got Bool");
+    EXPECT_EQ(replace(checker, "x + true", "x + 7"), "Int");
+}
+
+TEST_F(IncrementalTypeCheckerSpec, FollowsChangesToTheEnvironment) {
+    IncrementalTypeChecker checker(parser_);
+    checker.setSource("let a:int = 1 in\nlet g = (x: int) => { x + a } in\ng 1");
+    EXPECT_EQ(checker.typeCheck(), "Int");
+
+    // g's body is untouched, but a now has a different type.
+    replace(checker, "let a:int = 1", "let a:bool = true");
+    replace(checker, "let a:bool = true", "let a:int = 2");
+    replace(checker, "(x: int)", "(x: bool)");
+    replace(checker, "(x: bool)", "(x: int)");
+    replace(checker, "let a", "let b");
+    replace(checker, "g 1", "g");
+}
+
+TEST_F(IncrementalTypeCheckerSpec, SurvivesSyntaxErrorsInTheMiddleOfAnEdit) {
+    IncrementalTypeChecker checker(parser_);
+    checker.setSource(program(10));
+    EXPECT_EQ(checker.typeCheck(), "Int");
+
+    replace(checker, "x + 300 }", "x +  }");
+    replace(checker, "x +  }", "x + ( }");
+    replace(checker, "x + ( }", "x + (3 }");
+    EXPECT_EQ(replace(checker, "x + (3 }", "x + (3) }"), "Int");
+}
+
+TEST_F(IncrementalTypeCheckerSpec, StagedPrograms) {
+    IncrementalTypeChecker checker(parser_);
+    checker.setSource(R"lg(
+                let rec f = [g1:>!](x: <int@g1>):<int@g1> =>
+                              { `{@g1 ~{ x } + 1 } } in
+                `{@! (y:int@g2) => { ~{ f^g2 `{@g2 y } } } }
+                )lg");
+    EXPECT_EQ(checker.typeCheck(), "<(Int->Int)@!>");
+
+    replace(checker, "~{ x } + 1", "~{ x } + 2");
+    replace(checker, "f^g2", "f^g3");
+    replace(checker, "f^g3", "f^g2");
+    replace(checker, "(y:int@g2)", "(y:bool@g2)");
+    EXPECT_EQ(replace(checker, "(y:bool@g2)", "(y:int@g2)"), "<(Int->Int)@!>");
+}
+
+} // namespace
+} // namespace lamgamma
@@ -0,0 +1,345 @@
+#include "Jit.h"
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__linux__)
+#define LAMGAMMA_JIT_X86_64 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace lamgamma {
+
+JitCode::~JitCode() {
+#ifdef LAMGAMMA_JIT_X86_64
+    munmap(memory_, size_);
+#endif
+}
+
+#ifdef LAMGAMMA_JIT_X86_64
+
+namespace {
+
+// The fields compiled code addresses as [r12 + disp8].
+static_assert(offsetof(JitContext, stackEnd) == 0, "layout of JitContext");
+constexpr uint8_t kDepth = offsetof(JitContext, depth);
+constexpr uint8_t kMaxDepth = offsetof(JitContext, maxDepth);
+constexpr uint8_t kDirectCalls = offsetof(JitContext, directCalls);
+
+// Machine code for one function. The frame pointer stays in rbx and the
+// context in r12, both callee-saved, for the whole function; values pass
+// through eax, ecx and edx.
+class Assembler {
+  public:
+    Assembler(const Function &f, uint32_t self, JitCode::CallHelper helper)
+        : f_(f), self_(self), helper_(helper), offsets_(f.code.size()),
+          targets_(f.code.size() + 1) {
+        for (const Instr &instr : f.code) {
+            if (instr.op == Op::Jump) {
+                targets_[instr.a] = true;
+            } else if (instr.op == Op::JumpIfFalse || instr.op == Op::JumpIfTrue) {
+                targets_[instr.b] = true;
+            }
+        }
+    }
+
+    std::vector<uint8_t> assemble() {
+        // push rbx; push r12; sub rsp, 8 (to keep calls 16-byte aligned);
+        // mov rbx, rsi; mov r12, rdi
+        bytes({0x53, 0x41, 0x54, 0x48, 0x83, 0xEC, 0x08, 0x48, 0x89, 0xF3, 0x49, 0x89, 0xFC});
+
+        for (size_t i = 0; i < f_.code.size(); ++i) {
+            offsets_[i] = out_.size();
+            if (targets_[i]) {
+                cached_ = -1;
+            }
+            instruction(f_.code[i]);
+        }
+
+        size_t stackOverflow = out_.size();
+        byte(0xB8); // mov eax, StackOverflow
+        u32(static_cast<uint32_t>(ExitStatus::StackOverflow));
+        bytes({0xEB, 0x05}); // jmp exit
+        size_t zeroDivision = out_.size();
+        byte(0xB8); // mov eax, ZeroDivision
+        u32(static_cast<uint32_t>(ExitStatus::ZeroDivision));
+        size_t exit = out_.size();
+        epilogue();
+
+        for (const Fixup &fixup : fixups_) {
+            size_t target = fixup.target == kStackOverflow ? stackOverflow
+                            : fixup.target == kZeroDivision ? zeroDivision
+                            : fixup.target == kExit         ? exit
+                            : fixup.target == kStart        ? 0
+                                                            : offsets_[fixup.target];
+            auto rel = static_cast<int32_t>(target - (fixup.at + 4));
+            std::memcpy(&out_[fixup.at], &rel, 4);
+        }
+        return std::move(out_);
+    }
+
+  private:
+    static constexpr int32_t kZeroDivision = -1;
+    static constexpr int32_t kExit = -2;
+    static constexpr int32_t kStackOverflow = -3;
+    static constexpr int32_t kStart = -4;
+
+    struct Fixup {
+        size_t at; // of the rel32 field
+        int32_t target;
+    };
+
+    void instruction(const Instr &instr) {
+        switch (instr.op) {
+        case Op::LoadInt:
+            byte(0xB8); // mov eax, imm32
+            u32(static_cast<uint32_t>(instr.b));
+            store(instr.a);
+            break;
+        case Op::Move:
+            load(instr.b);
+            store(instr.a);
+            break;
+        case Op::Add:
+            load(instr.b);
+            slotOp({0x03}, 0, instr.c); // add eax, [slot]
+            store(instr.a);
+            break;
+        case Op::Sub:
+            load(instr.b);
+            slotOp({0x2B}, 0, instr.c); // sub eax, [slot]
+            store(instr.a);
+            break;
+        case Op::Mul:
+            load(instr.b);
+            slotOp({0x0F, 0xAF}, 0, instr.c); // imul eax, [slot]
+            store(instr.a);
+            break;
+        case Op::Div:
+        case Op::Mod:
+            division(instr);
+            break;
+        case Op::Eq:
+            comparison(instr, 0x94); // sete
+            break;
+        case Op::Ne:
+            comparison(instr, 0x95); // setne
+            break;
+        case Op::Lt:
+            comparison(instr, 0x9C); // setl
+            break;
+        case Op::Le:
+            comparison(instr, 0x9E); // setle
+            break;
+        case Op::Gt:
+            comparison(instr, 0x9F); // setg
+            break;
+        case Op::Ge:
+            comparison(instr, 0x9D); // setge
+            break;
+        case Op::Not:
+            load(instr.b);
+            bytes({0x83, 0xF0, 0x01}); // xor eax, 1
+            store(instr.a);
+            break;
+        case Op::Jump:
+            byte(0xE9); // jmp rel32
+            jumpTo(instr.a);
+            break;
+        case Op::JumpIfFalse:
+        case Op::JumpIfTrue:
+            slotOp({0x83}, 7, instr.a); // cmp dword [slot], 0
+            byte(0x00);
+            // je or jne rel32
+            bytes({0x0F, static_cast<uint8_t>(instr.op == Op::JumpIfFalse ? 0x84 : 0x85)});
+            jumpTo(instr.b);
+            break;
+        case Op::Call:
+            // A let rec memo function calls itself through the Vm, which
+            // looks in its cache.
+            if (static_cast<uint32_t>(instr.b) == self_ && !f_.memo) {
+                selfCall(instr);
+                break;
+            }
+            bytes({0x4C, 0x89, 0xE7}); // mov rdi, r12
+            byte(0xBE);                // mov esi, imm32
+            u32(static_cast<uint32_t>(instr.b));
+            slotOp({0x48, 0x8D}, 2, instr.c); // lea rdx, [slot]
+            bytes({0x48, 0xB8});              // mov rax, imm64
+            u64(reinterpret_cast<uint64_t>(helper_));
+            bytes({0xFF, 0xD0}); // call rax
+            bytes({0x85, 0xC0}); // test eax, eax
+            bytes({0x0F, 0x85}); // jne exit
+            jumpTo(kExit);
+            cached_ = -1;
+            load(instr.c);
+            store(instr.a);
+            break;
+        case Op::Return:
+            load(instr.a);
+            slotOp({0x89}, 0, 0);      // mov [frame], eax
+            bytes({0x31, 0xC0});       // xor eax, eax
+            epilogue();
+            break;
+        // Refused by jitCompile.
+        case Op::Fresh:
+        case Op::Quote:
+        case Op::Run:
+        case Op::Hole:
+        case Op::Free:
+        case Op::NewArray:
+        case Op::ArrayLength:
+        case Op::ArrayGet:
+        case Op::ArrayInit:
+        case Op::ArrayMap:
+        case Op::ArrayFold:
+            break;
+        }
+    }
+
+    // What Vm::call does before and after a call, inlined: the callee's
+    // frame must fit in the stack and the depth stay below the maximum.
+    void selfCall(const Instr &instr) {
+        slotOp({0x48, 0x8D}, 6, instr.c + static_cast<int32_t>(f_.frameSize)); // lea rsi, [end]
+        bytes({0x49, 0x3B, 0x34, 0x24}); // cmp rsi, [r12]
+        bytes({0x0F, 0x87});             // ja stackOverflow
+        jumpTo(kStackOverflow);
+        bytes({0x41, 0x8B, 0x44, 0x24, kDepth});    // mov eax, [r12 + depth]
+        bytes({0x41, 0x3B, 0x44, 0x24, kMaxDepth}); // cmp eax, [r12 + maxDepth]
+        bytes({0x0F, 0x83});                        // jae stackOverflow
+        jumpTo(kStackOverflow);
+        bytes({0x41, 0xFF, 0x44, 0x24, kDepth});       // inc dword [r12 + depth]
+        bytes({0x49, 0xFF, 0x44, 0x24, kDirectCalls}); // inc qword [r12 + directCalls]
+        bytes({0x4C, 0x89, 0xE7});                     // mov rdi, r12
+        slotOp({0x48, 0x8D}, 6, instr.c);              // lea rsi, [slot]
+        byte(0xE8);                                    // call start
+        jumpTo(kStart);
+        bytes({0x41, 0xFF, 0x4C, 0x24, kDepth}); // dec dword [r12 + depth]
+        bytes({0x85, 0xC0});                     // test eax, eax
+        bytes({0x0F, 0x85});                     // jne exit
+        jumpTo(kExit);
+        cached_ = -1;
+        load(instr.c);
+        store(instr.a);
+    }
+
+    // Wraps like the interpreter: the minimum divided by -1 is itself and
+    // leaves 0, where idiv would trap.
+    void division(const Instr &instr) {
+        slotOp({0x8B}, 1, instr.c); // mov ecx, [slot]
+        bytes({0x85, 0xC9});        // test ecx, ecx
+        bytes({0x0F, 0x84});        // je zeroDivision
+        jumpTo(kZeroDivision);
+        load(instr.b);
+        bool div = instr.op == Op::Div;
+        bytes({0x83, 0xF9, 0xFF}); // cmp ecx, -1
+        bytes({0x75, 0x04});       // jne idiv
+        // neg eax, or xor eax, eax; then jmp past the idiv
+        bytes({static_cast<uint8_t>(div ? 0xF7 : 0x31), static_cast<uint8_t>(div ? 0xD8 : 0xC0)});
+        bytes({0xEB, static_cast<uint8_t>(div ? 0x03 : 0x05)});
+        bytes({0x99, 0xF7, 0xF9}); // cdq; idiv ecx
+        if (!div) {
+            bytes({0x89, 0xD0}); // mov eax, edx
+        }
+        store(instr.a);
+    }
+
+    void comparison(const Instr &instr, uint8_t setcc) {
+        load(instr.b);
+        slotOp({0x3B}, 0, instr.c);        // cmp eax, [slot]
+        bytes({0x0F, setcc, 0xC0});        // setcc al
+        bytes({0x0F, 0xB6, 0xC0});         // movzx eax, al
+        store(instr.a);
+    }
+
+    // mov eax, [slot], unless eax already holds it.
+    void load(int32_t slot) {
+        if (cached_ != slot) {
+            slotOp({0x8B}, 0, slot);
+            cached_ = slot;
+        }
+    }
+
+    // mov [slot], eax. Slots are written through, so a value kept in eax
+    // is never the only copy.
+    void store(int32_t slot) {
+        slotOp({0x89}, 0, slot);
+        cached_ = slot;
+    }
+
+    // opcode with a ModRM operand [rbx + 4 * slot] and reg in the reg field.
+    void slotOp(std::initializer_list<uint8_t> opcode, uint8_t reg, int32_t slot) {
+        bytes(opcode);
+        byte(static_cast<uint8_t>(0x80 | (reg << 3) | 0x03));
+        u32(static_cast<uint32_t>(slot * 4));
+    }
+
+    void epilogue() {
+        // add rsp, 8; pop r12; pop rbx; ret
+        bytes({0x48, 0x83, 0xC4, 0x08, 0x41, 0x5C, 0x5B, 0xC3});
+    }
+
+    void jumpTo(int32_t target) {
+        fixups_.push_back(Fixup{out_.size(), target});
+        u32(0);
+    }
+
+    void byte(uint8_t b) { out_.push_back(b); }
+    void bytes(std::initializer_list<uint8_t> bs) { out_.insert(out_.end(), bs); }
+    void u32(uint32_t v) {
+        for (int i = 0; i < 4; ++i) byte(static_cast<uint8_t>(v >> (8 * i)));
+    }
+    void u64(uint64_t v) {
+        for (int i = 0; i < 8; ++i) byte(static_cast<uint8_t>(v >> (8 * i)));
+    }
+
+    const Function &f_;
+    uint32_t self_;
+    JitCode::CallHelper helper_;
+    std::vector<uint8_t> out_;
+    std::vector<size_t> offsets_;
+    std::vector<bool> targets_;
+    std::vector<Fixup> fixups_;
+    int32_t cached_ = -1;
+};
+
+} // namespace
+
+bool jitAvailable() { return true; }
+
+std::unique_ptr<JitCode> jitCompile(const Function &f, uint32_t self, JitCode::CallHelper helper) {
+    for (const Instr &instr : f.code) {
+        if (instr.op >= Op::Fresh) {
+            return nullptr;
+        }
+    }
+    std::vector<uint8_t> code = Assembler(f, self, helper).assemble();
+
+    auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t size = (code.size() + page - 1) / page * page;
+    void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+    std::memcpy(memory, code.data(), code.size());
+    // Never writable and executable at once.
+    if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, size);
+        return nullptr;
+    }
+    return std::unique_ptr<JitCode>(new JitCode(memory, size));
+}
+
+#else
+
+bool jitAvailable() { return false; }
+
+std::unique_ptr<JitCode> jitCompile(const Function &, uint32_t, JitCode::CallHelper) {
+    return nullptr;
+}
+
+#endif
+
+} // namespace lamgamma
@@ -0,0 +1,80 @@
+#ifndef LAMGAMMA_JIT_H_
+#define LAMGAMMA_JIT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "Bytecode.h"
+
+namespace lamgamma {
+
+// Baseline compiler from bytecode to x86-64 machine code. Every
+// instruction is copied from a fixed template with its slots and
+// constants filled in, and jumps are patched once all are placed; there
+// is no register allocation beyond keeping the last value stored in a
+// register for the instruction that reads it next.
+//
+// Compiled code lives in pages mapped with mmap and made executable with
+// mprotect, so it needs nothing beyond Linux on x86-64. Elsewhere nothing
+// is compiled and the interpreter runs every function.
+
+// How a function, interpreted or compiled, finishes. Only the interpreter
+// generates code and works on arrays, so only it reports the last four.
+enum class ExitStatus : int32_t {
+    Ok,
+    ZeroDivision,
+    StackOverflow,
+    UnsupportedCode,
+    IndexOutOfBounds,
+    NotAnArray,
+    ArrayTooLong,
+};
+
+// What compiled code shares with the VM running it. A function calls
+// itself without leaving machine code, so it checks the limits and counts
+// the call here itself.
+struct JitContext {
+    const int32_t *stackEnd;
+    uint32_t depth;
+    uint32_t maxDepth;
+    uint64_t directCalls;
+    void *vm;
+};
+
+class JitCode {
+  public:
+    // Runs the function on frame and leaves its result in frame[0].
+    using Entry = ExitStatus (*)(JitContext *context, int32_t *frame);
+    // Called by compiled code for every Call instruction but those of the
+    // function itself, with the callee's frame starting at its first
+    // argument.
+    using CallHelper = ExitStatus (*)(JitContext *context, uint32_t function, int32_t *frame);
+
+    JitCode(const JitCode &) = delete;
+    JitCode &operator=(const JitCode &) = delete;
+    ~JitCode();
+
+    Entry entry() const { return reinterpret_cast<Entry>(memory_); }
+    size_t size() const { return size_; }
+
+  private:
+    friend std::unique_ptr<JitCode> jitCompile(const Function &, uint32_t, JitCode::CallHelper);
+
+    JitCode(void *memory, size_t size) : memory_(memory), size_(size) {}
+
+    void *memory_;
+    size_t size_;
+};
+
+// Whether this build can compile to machine code at all.
+bool jitAvailable();
+
+// Compiles f, the function numbered self in its program. Null when the
+// host is not supported, f generates or runs code or works on arrays, or
+// the executable mapping fails.
+std::unique_ptr<JitCode> jitCompile(const Function &f, uint32_t self, JitCode::CallHelper helper);
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_JIT_H_
@@ -0,0 +1,460 @@
+#include "Offshore.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+namespace lamgamma {
+
+namespace {
+
+constexpr const char *kEntrySymbol = "lamgamma_code";
+
+OffshoreError unsupported(std::string what) {
+    return OffshoreError{OffshoreError::Kind::Unsupported, std::move(what)};
+}
+
+const char *typeName(OffshoreType t) { return t == OffshoreType::Int ? "int" : "bool"; }
+
+// A C expression without effects standing for a value: a literal or a
+// variable.
+struct Value {
+    std::string atom;
+    OffshoreType type;
+};
+
+// Emits the body of the entry function in A-normal form: every
+// intermediate value gets its own variable, so that division can return
+// early on a zero divisor and conditionals become plain if statements.
+class Translator {
+  public:
+    Result<Value, OffshoreError> translate(const RawExpr *e) {
+        using Kind = RawExpr::Kind;
+
+        switch (e->kind) {
+        case Kind::IntLit:
+            return Value{literal(e->as<RawExpr::IntLit>().value), OffshoreType::Int};
+        case Kind::BoolLit:
+            return Value{e->as<RawExpr::BoolLit>().value ? "1" : "0", OffshoreType::Bool};
+        case Kind::Var: {
+            lamgamma::Var var = e->as<RawExpr::Var>().var;
+            for (auto it = scope_.rbegin(); it != scope_.rend(); ++it) {
+                if (it->first == var) {
+                    return it->second;
+                }
+            }
+            return fail(unsupported("free variable " + var.toString()));
+        }
+        case Kind::Let: {
+            const auto &l = e->as<RawExpr::Let>();
+            auto expr = translate(l.expr);
+            if (!expr) {
+                return expr;
+            }
+            std::string name = bind(l.param, expr.value().type);
+            line("int32_t " + name + " = " + expr.value().atom + ";");
+            auto body = translate(l.body);
+            scope_.pop_back();
+            return body;
+        }
+        case Kind::BinOp: {
+            const auto &b = e->as<RawExpr::BinOp>();
+            auto left = translate(b.left);
+            if (!left) {
+                return left;
+            }
+            auto right = translate(b.right);
+            if (!right) {
+                return right;
+            }
+            return binOp(b.op, left.value(), right.value());
+        }
+        case Kind::ShortCircuitOp: {
+            const auto &s = e->as<RawExpr::ShortCircuitOp>();
+            auto left = translate(s.left);
+            if (!left) {
+                return left;
+            }
+            if (left.value().type != OffshoreType::Bool) {
+                return fail(mismatch(toString(s.op), left.value().type));
+            }
+            std::string t = temp();
+            line("int32_t " + t + " = " + left.value().atom + ";");
+            line(std::string(s.op == ShortCircuitOp::And ? "if (" : "if (!") + t + ") {");
+            auto right = branch(s.right, t);
+            if (!right) {
+                return right;
+            }
+            line("}");
+            if (right.value().type != OffshoreType::Bool) {
+                return fail(mismatch(toString(s.op), right.value().type));
+            }
+            return Value{t, OffshoreType::Bool};
+        }
+        case Kind::UniOp: {
+            const auto &u = e->as<RawExpr::UniOp>();
+            auto expr = translate(u.expr);
+            if (!expr) {
+                return expr;
+            }
+            if (expr.value().type != OffshoreType::Bool) {
+                return fail(mismatch(toString(u.op), expr.value().type));
+            }
+            std::string t = temp();
+            line("int32_t " + t + " = !" + expr.value().atom + ";");
+            return Value{t, OffshoreType::Bool};
+        }
+        case Kind::If: {
+            const auto &i = e->as<RawExpr::If>();
+            auto cond = translate(i.cond);
+            if (!cond) {
+                return cond;
+            }
+            if (cond.value().type != OffshoreType::Bool) {
+                return fail(mismatch("if", cond.value().type));
+            }
+            std::string t = temp();
+            line("int32_t " + t + " = 0;");
+            line("if (" + cond.value().atom + ") {");
+            auto thenBranch = branch(i.thenBranch, t);
+            if (!thenBranch) {
+                return thenBranch;
+            }
+            line("} else {");
+            auto elseBranch = branch(i.elseBranch, t);
+            if (!elseBranch) {
+                return elseBranch;
+            }
+            line("}");
+            if (thenBranch.value().type != elseBranch.value().type) {
+                return fail(mismatch("if", elseBranch.value().type));
+            }
+            return Value{t, thenBranch.value().type};
+        }
+        case Kind::Func:
+            return fail(unsupported("nested function"));
+        case Kind::App:
+            return fail(unsupported("application"));
+        case Kind::LetRec:
+            return fail(unsupported("let rec"));
+        case Kind::LetCs:
+            return fail(unsupported("let cs"));
+        case Kind::ArrayOp:
+            return fail(unsupported("array"));
+        case Kind::Tuple:
+        case Kind::Proj:
+            return fail(unsupported("tuple"));
+        case Kind::Quote:
+        case Kind::Splice:
+        case Kind::GenLet:
+            return fail(unsupported("staging construct"));
+        }
+        return fail(unsupported("unknown form"));
+    }
+
+    std::string bind(lamgamma::Var var, OffshoreType type) {
+        std::string name = "v" + std::to_string(counter_++) + "_";
+        for (char c : var.toString()) {
+            bool word = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+            name += word ? c : '_';
+        }
+        scope_.emplace_back(var, Value{name, type});
+        return name;
+    }
+
+    void line(const std::string &text) {
+        if (text.front() == '}') {
+            --depth_;
+        }
+        body_.append(4 * depth_, ' ');
+        body_ += text;
+        body_ += '\n';
+        if (text.back() == '{') {
+            ++depth_;
+        }
+    }
+
+    const std::string &body() const { return body_; }
+
+  private:
+    static std::string literal(int32_t v) {
+        // -2147483648 would be the negation of an out-of-range constant.
+        return v == std::numeric_limits<int32_t>::min() ? "(-2147483647 - 1)" : std::to_string(v);
+    }
+
+    static OffshoreError mismatch(const std::string &what, OffshoreType got) {
+        return unsupported(std::string("operand of type ") + typeName(got) + " to " + what);
+    }
+
+    std::string temp() { return "t" + std::to_string(counter_++); }
+
+    // Translates e into the block just opened and assigns its value to t.
+    Result<Value, OffshoreError> branch(const RawExpr *e, const std::string &t) {
+        auto value = translate(e);
+        if (value) {
+            line(t + " = " + value.value().atom + ";");
+        }
+        return value;
+    }
+
+    Result<Value, OffshoreError> binOp(BinOp op, const Value &left, const Value &right) {
+        const std::string &l = left.atom;
+        const std::string &r = right.atom;
+        bool comparison = op == BinOp::Eq || op == BinOp::Ne;
+        if (comparison ? left.type != right.type
+                       : left.type != OffshoreType::Int || right.type != OffshoreType::Int) {
+            return fail(mismatch(toString(op),
+                                 left.type == OffshoreType::Int ? right.type : left.type));
+        }
+
+        // Arithmetic goes through uint32_t, where overflow wraps instead of
+        // being undefined.
+        auto wrap = [&](const char *o) {
+            return "(int32_t)((uint32_t)" + l + " " + o + " (uint32_t)" + r + ")";
+        };
+        std::string value;
+        OffshoreType type = OffshoreType::Bool;
+        switch (op) {
+        case BinOp::Add:
+            value = wrap("+");
+            type = OffshoreType::Int;
+            break;
+        case BinOp::Sub:
+            value = wrap("-");
+            type = OffshoreType::Int;
+            break;
+        case BinOp::Mul:
+            value = wrap("*");
+            type = OffshoreType::Int;
+            break;
+        // The minimum divided by -1 overflows; it wraps to itself.
+        case BinOp::Div:
+            line("if (" + r + " == 0) return 1;");
+            value = "(" + r + " == -1 ? (int32_t)(0u - (uint32_t)" + l + ") : " + l + " / " + r +
+                    ")";
+            type = OffshoreType::Int;
+            break;
+        case BinOp::Mod:
+            line("if (" + r + " == 0) return 1;");
+            value = "(" + r + " == -1 ? 0 : " + l + " % " + r + ")";
+            type = OffshoreType::Int;
+            break;
+        case BinOp::Eq:
+        case BinOp::Ne:
+        case BinOp::Lt:
+        case BinOp::Le:
+        case BinOp::Gt:
+        case BinOp::Ge:
+            value = l + " " + toString(op) + " " + r;
+            break;
+        }
+        std::string t = temp();
+        line("int32_t " + t + " = " + value + ";");
+        return Value{t, type};
+    }
+
+    std::vector<std::pair<lamgamma::Var, Value>> scope_;
+    std::string body_;
+    int counter_ = 0;
+    int depth_ = 1;
+};
+
+// Runs argv, with its output and diagnostics going to the file log.
+// Returns the exit status, or -1 when it could not be started.
+int run(const std::vector<std::string> &argv, const std::string &log) {
+    std::vector<char *> args;
+    for (const std::string &arg : argv) {
+        args.push_back(const_cast<char *>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, log.c_str(),
+                                     O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+
+    pid_t pid;
+    int err = posix_spawnp(&pid, args[0], &actions, nullptr, args.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (err != 0) {
+        return -1;
+    }
+    int status;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            return -1;
+        }
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+std::string readFile(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// A directory only this process writes to, removed with what it holds.
+class TemporaryDirectory {
+  public:
+    TemporaryDirectory() {
+        const char *tmp = std::getenv("TMPDIR");
+        std::string pattern = std::string(tmp && *tmp ? tmp : "/tmp") + "/lamgamma-XXXXXX";
+        if (mkdtemp(pattern.data()) != nullptr) {
+            path_ = pattern;
+        }
+    }
+    ~TemporaryDirectory() {
+        for (const std::string &file : files_) {
+            unlink(file.c_str());
+        }
+        if (!path_.empty()) {
+            rmdir(path_.c_str());
+        }
+    }
+    TemporaryDirectory(const TemporaryDirectory &) = delete;
+    TemporaryDirectory &operator=(const TemporaryDirectory &) = delete;
+
+    bool ok() const { return !path_.empty(); }
+
+    std::string file(const std::string &name) {
+        files_.push_back(path_ + "/" + name);
+        return files_.back();
+    }
+
+  private:
+    std::string path_;
+    std::vector<std::string> files_;
+};
+
+} // namespace
+
+std::string toString(const OffshoreError &e) {
+    switch (e.kind) {
+    case OffshoreError::Kind::Unsupported:
+        return "cannot offshore: " + e.message;
+    case OffshoreError::Kind::CompilerFailed:
+        return "C compiler failed: " + e.message;
+    case OffshoreError::Kind::LoadFailed:
+        return "cannot load compiled code: " + e.message;
+    }
+    return e.message;
+}
+
+Result<std::string, OffshoreError> offshoreSource(const RawExpr *func, OffshoreType *resultType) {
+    if (func->kind != RawExpr::Kind::Func) {
+        return fail(unsupported("code that is not a function"));
+    }
+    const auto &f = func->as<RawExpr::Func>();
+
+    Translator translator;
+    for (size_t i = 0; i < f.params.size; ++i) {
+        std::string name = translator.bind(f.params[i], OffshoreType::Int);
+        translator.line("int32_t " + name + " = args[" + std::to_string(i) + "];");
+    }
+    auto result = translator.translate(f.body);
+    if (!result) {
+        return fail(result.error());
+    }
+    translator.line("*result = " + result.value().atom + ";");
+    translator.line("return 0;");
+    *resultType = result.value().type;
+
+    return "/* Generated by lamgamma. */\n"
+           "#include <stdint.h>\n"
+           "\n"
+           "int " +
+           std::string(kEntrySymbol) +
+           "(const int32_t *args, int32_t *result) {\n"
+           "    (void)args;\n" +
+           translator.body() + "}\n";
+}
+
+NativeFunction::NativeFunction(NativeFunction &&other) noexcept
+    : handle_(std::exchange(other.handle_, nullptr)), entry_(other.entry_), arity_(other.arity_),
+      resultType_(other.resultType_) {}
+
+NativeFunction &NativeFunction::operator=(NativeFunction &&other) noexcept {
+    if (this != &other) {
+        if (handle_ != nullptr) {
+            dlclose(handle_);
+        }
+        handle_ = std::exchange(other.handle_, nullptr);
+        entry_ = other.entry_;
+        arity_ = other.arity_;
+        resultType_ = other.resultType_;
+    }
+    return *this;
+}
+
+NativeFunction::~NativeFunction() {
+    if (handle_ != nullptr) {
+        dlclose(handle_);
+    }
+}
+
+Result<NativeFunction, OffshoreError> offshore(const RawExpr *func,
+                                               const OffshoreOptions &options) {
+    OffshoreType resultType;
+    auto source = offshoreSource(func, &resultType);
+    if (!source) {
+        return fail(source.error());
+    }
+
+    TemporaryDirectory dir;
+    if (!dir.ok()) {
+        return fail(OffshoreError{OffshoreError::Kind::CompilerFailed,
+                                  "cannot create a temporary directory"});
+    }
+    std::string c = dir.file("code.c");
+    std::string so = dir.file("code.so");
+    std::string log = dir.file("cc.log");
+    {
+        std::ofstream out(c, std::ios::binary);
+        out << source.value();
+        if (!out.flush()) {
+            return fail(OffshoreError{OffshoreError::Kind::CompilerFailed, "cannot write " + c});
+        }
+    }
+
+    std::string compiler = options.compiler;
+    if (compiler.empty()) {
+        const char *cc = std::getenv("CC");
+        compiler = cc && *cc ? cc : "cc";
+    }
+    std::vector<std::string> argv = {compiler, "-std=c99", "-shared", "-fPIC"};
+    argv.insert(argv.end(), options.flags.begin(), options.flags.end());
+    argv.insert(argv.end(), {"-o", so, c});
+    int status = run(argv, log);
+    if (status != 0) {
+        std::string diagnostics = readFile(log);
+        return fail(OffshoreError{OffshoreError::Kind::CompilerFailed,
+                                  status < 0 ? "cannot run " + compiler : diagnostics});
+    }
+
+    // The mapping outlives the file, which the directory removes.
+    void *handle = dlopen(so.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+        return fail(OffshoreError{OffshoreError::Kind::LoadFailed, dlerror()});
+    }
+    auto entry = reinterpret_cast<NativeFunction::Entry>(dlsym(handle, kEntrySymbol));
+    if (entry == nullptr) {
+        std::string error = dlerror();
+        dlclose(handle);
+        return fail(OffshoreError{OffshoreError::Kind::LoadFailed, error});
+    }
+    return NativeFunction(handle, entry, func->as<RawExpr::Func>().params.size, resultType);
+}
+
+} // namespace lamgamma
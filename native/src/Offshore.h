@@ -0,0 +1,92 @@
+#ifndef LAMGAMMA_OFFSHORE_H_
+#define LAMGAMMA_OFFSHORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "RawExpr.h"
+#include "Result.h"
+
+namespace lamgamma {
+
+// Offshoring: first-order integer and boolean code, such as the functions
+// spower generates, is translated to C, compiled by the system C compiler
+// into a shared object and loaded, so that it runs at machine speed.
+//
+// The fragment covers functions whose parameters are ints, built from
+// literals, variables, let, if and the arithmetic, comparison and logical
+// operators. Ints are 32 bits and wrap around, as in the playground's
+// evaluator; booleans are 0 and 1.
+
+enum class OffshoreType : uint8_t { Int, Bool };
+
+struct OffshoreError {
+    enum class Kind : uint8_t {
+        Unsupported,    // outside the fragment; message names the form
+        CompilerFailed, // message holds the compiler's diagnostics
+        LoadFailed,     // message holds the dynamic loader's error
+    };
+
+    Kind kind;
+    std::string message;
+};
+
+std::string toString(const OffshoreError &e);
+
+struct OffshoreOptions {
+    // Empty for $CC, or cc when that is unset.
+    std::string compiler;
+    std::vector<std::string> flags = {"-O2"};
+};
+
+// The C translation unit for func, defining
+//
+//   int lamgamma_code(const int32_t *args, int32_t *result);
+//
+// which stores the result and returns 0, or returns 1 on division by zero.
+Result<std::string, OffshoreError> offshoreSource(const RawExpr *func, OffshoreType *resultType);
+
+// A compiled function, loaded for as long as the object lives.
+class NativeFunction {
+  public:
+    enum class Status : uint8_t { Ok, ZeroDivision };
+
+    using Entry = int (*)(const int32_t *args, int32_t *result);
+
+    NativeFunction(NativeFunction &&other) noexcept;
+    NativeFunction &operator=(NativeFunction &&other) noexcept;
+    NativeFunction(const NativeFunction &) = delete;
+    NativeFunction &operator=(const NativeFunction &) = delete;
+    ~NativeFunction();
+
+    size_t arity() const { return arity_; }
+    OffshoreType resultType() const { return resultType_; }
+
+    // args holds arity() values.
+    Status call(const int32_t *args, int32_t *result) const {
+        return entry_(args, result) == 0 ? Status::Ok : Status::ZeroDivision;
+    }
+
+  private:
+    friend Result<NativeFunction, OffshoreError> offshore(const RawExpr *,
+                                                          const OffshoreOptions &);
+
+    NativeFunction(void *handle, Entry entry, size_t arity, OffshoreType resultType)
+        : handle_(handle), entry_(entry), arity_(arity), resultType_(resultType) {}
+
+    void *handle_;
+    Entry entry_;
+    size_t arity_;
+    OffshoreType resultType_;
+};
+
+// Translates, compiles and loads func, a Func node. The files the compiler
+// needs live in a private temporary directory, removed before returning.
+Result<NativeFunction, OffshoreError> offshore(const RawExpr *func,
+                                               const OffshoreOptions &options = {});
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_OFFSHORE_H_
@@ -0,0 +1,122 @@
+// Cases for offshoring generated code to C. They need a C compiler on the
+// PATH, as the backend itself does.
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <tree_sitter/api.h>
+
+#include "Arena.h"
+#include "Offshore.h"
+#include "RawExpr.h"
+#include "SyntaxNodeParser.h"
+#include "tree-sitter-lamgamma_parser.h"
+
+namespace lamgamma {
+namespace {
+
+class OffshoreSpec : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        parser_ = ts_parser_new();
+        ts_parser_set_language(parser_, tree_sitter_lamgamma_parser());
+    }
+
+    void TearDown() override {
+        for (TSTree *tree : trees_) {
+            ts_tree_delete(tree);
+        }
+        ts_parser_delete(parser_);
+    }
+
+    // Assume that parse always succeeds
+    const RawExpr *parse(const std::string &input) {
+        sources_.push_back(input);
+        const std::string &source = sources_.back();
+        TSTree *tree = ts_parser_parse_string(parser_, nullptr, source.data(), source.size());
+        trees_.push_back(tree);
+        SyntaxNodeParser syntaxNodeParser(arena_, source);
+        return stripTypeInfo(syntaxNodeParser.parseSourceFileNode(ts_tree_root_node(tree)).value(),
+                             arena_);
+    }
+
+    // Assume that offshoring succeeds
+    NativeFunction compile(const std::string &input) {
+        auto function = offshore(parse(input));
+        EXPECT_TRUE(function.isOk()) << (function.isOk() ? "" : toString(function.error()));
+        return std::move(function.value());
+    }
+
+  private:
+    TSParser *parser_ = nullptr;
+    Arena arena_;
+    std::vector<std::string> sources_;
+    std::vector<TSTree *> trees_;
+};
+
+int32_t apply(const NativeFunction &f, std::vector<int32_t> args) {
+    int32_t result = 0;
+    EXPECT_EQ(f.call(args.data(), &result), NativeFunction::Status::Ok);
+    return result;
+}
+
+TEST_F(OffshoreSpec, StagedPower) {
+    // spower 5, as the playground prints it
+    NativeFunction pow5 =
+        compile("(x_1) => { (let genlet_2 = (x_1 * x_1) in (let genlet_3 = (genlet_2 * genlet_2) "
+                "in (x_1 * genlet_3))) }");
+    EXPECT_EQ(pow5.arity(), 1u);
+    EXPECT_EQ(pow5.resultType(), OffshoreType::Int);
+    EXPECT_EQ(apply(pow5, {2}), 32);
+    EXPECT_EQ(apply(pow5, {-3}), -243);
+}
+
+TEST_F(OffshoreSpec, ConditionalsAndBooleans) {
+    NativeFunction f = compile("(x, y) => { if x < y && !(x == 0) then x - y else y mod 7 }");
+    EXPECT_EQ(apply(f, {1, 5}), -4);
+    EXPECT_EQ(apply(f, {0, 5}), 5);
+    EXPECT_EQ(apply(f, {9, -10}), -3);
+
+    NativeFunction g = compile("(x) => { x > 0 || x == 0 - 1 }");
+    EXPECT_EQ(g.resultType(), OffshoreType::Bool);
+    EXPECT_EQ(apply(g, {-1}), 1);
+    EXPECT_EQ(apply(g, {-2}), 0);
+}
+
+TEST_F(OffshoreSpec, WrapsLikeThePlayground) {
+    constexpr int32_t min = std::numeric_limits<int32_t>::min();
+    EXPECT_EQ(apply(compile("(x) => { x * x }"), {65536}), 0);
+    EXPECT_EQ(apply(compile("(x) => { x + 1 }"), {std::numeric_limits<int32_t>::max()}), min);
+    EXPECT_EQ(apply(compile("(x, y) => { x / y }"), {min, -1}), min);
+    EXPECT_EQ(apply(compile("(x, y) => { x mod y }"), {min, -1}), 0);
+}
+
+TEST_F(OffshoreSpec, ReportsDivisionByZero) {
+    NativeFunction f = compile("(x, y) => { let q = x / y in if true then 1 else q }");
+    std::vector<int32_t> args = {1, 0};
+    int32_t result;
+    EXPECT_EQ(f.call(args.data(), &result), NativeFunction::Status::ZeroDivision);
+}
+
+TEST_F(OffshoreSpec, RejectsCodeOutsideTheFragment) {
+    for (const char *code : {"(f) => { f 1 }", "(x) => { (y) => { x } }", "(x) => { y }",
+                             "(x) => { x + true }", "(x) => { if x then 1 else 2 }", "1 + 2"}) {
+        auto function = offshore(parse(code));
+        ASSERT_FALSE(function.isOk()) << code;
+        EXPECT_EQ(function.error().kind, OffshoreError::Kind::Unsupported) << code;
+    }
+}
+
+TEST_F(OffshoreSpec, ReportsCompilerFailures) {
+    OffshoreOptions options;
+    options.flags = {"-Werror=this-flag-does-not-exist"};
+    auto function = offshore(parse("(x) => { x }"), options);
+    ASSERT_FALSE(function.isOk());
+    EXPECT_EQ(function.error().kind, OffshoreError::Kind::CompilerFailed);
+}
+
+} // namespace
+} // namespace lamgamma
@@ -0,0 +1,69 @@
+#include "Operator.h"
+
+namespace lamgamma {
+
+const char *toString(BinOp op) {
+    switch (op) {
+    case BinOp::Add:
+        return "+";
+    case BinOp::Sub:
+        return "-";
+    case BinOp::Mul:
+        return "*";
+    case BinOp::Div:
+        return "/";
+    case BinOp::Mod:
+        return "%";
+    case BinOp::Eq:
+        return "==";
+    case BinOp::Ne:
+        return "!=";
+    case BinOp::Lt:
+        return "<";
+    case BinOp::Le:
+        return "<=";
+    case BinOp::Gt:
+        return ">";
+    case BinOp::Ge:
+        return ">=";
+    }
+    return "";
+}
+
+const char *toString(ShortCircuitOp op) {
+    switch (op) {
+    case ShortCircuitOp::And:
+        return "&&";
+    case ShortCircuitOp::Or:
+        return "||";
+    }
+    return "";
+}
+
+const char *toString(UniOp op) {
+    switch (op) {
+    case UniOp::Not:
+        return "!";
+    }
+    return "";
+}
+
+const char *toString(ArrayOp op) {
+    switch (op) {
+    case ArrayOp::Make:
+        return "[| |]";
+    case ArrayOp::Length:
+        return "Array.length";
+    case ArrayOp::Get:
+        return ".()";
+    case ArrayOp::Init:
+        return "Array.init";
+    case ArrayOp::Map:
+        return "Array.map";
+    case ArrayOp::Fold:
+        return "Array.fold";
+    }
+    return "";
+}
+
+} // namespace lamgamma
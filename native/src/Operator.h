@@ -0,0 +1,52 @@
+#ifndef LAMGAMMA_OPERATOR_H_
+#define LAMGAMMA_OPERATOR_H_
+
+#include <cstdint>
+
+namespace lamgamma {
+
+// Native counterpart of Operator.res.
+enum class BinOp : uint8_t {
+    // Arithmetic
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Mod,
+    // Comparison
+    Eq,
+    Ne,
+    Lt,
+    Le,
+    Gt,
+    Ge,
+};
+
+enum class ShortCircuitOp : uint8_t {
+    And,
+    Or,
+};
+
+enum class UniOp : uint8_t {
+    Not, // boolean negation
+};
+
+// Operations on arrays of ints, with their operands in the order of
+// Operator.ArrayOp.
+enum class ArrayOp : uint8_t {
+    Make,   // elements...
+    Length, // array
+    Get,    // array, index
+    Init,   // size, function
+    Map,    // function, array
+    Fold,   // function, initial accumulator, array
+};
+
+const char *toString(BinOp op);
+const char *toString(ShortCircuitOp op);
+const char *toString(UniOp op);
+const char *toString(ArrayOp op);
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_OPERATOR_H_
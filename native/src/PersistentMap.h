@@ -0,0 +1,132 @@
+#ifndef LAMGAMMA_PERSISTENTMAP_H_
+#define LAMGAMMA_PERSISTENTMAP_H_
+
+#include <cstdint>
+#include <functional>
+
+#include "Arena.h"
+
+namespace lamgamma {
+
+// Immutable ordered map, the native stand-in for Belt.Map. It is an AVL
+// tree whose nodes live in an Arena: an insertion copies the O(log n) path
+// to the changed node and shares everything else, so older versions stay
+// valid and cost nothing to keep.
+//
+// Every node also carries the sum of the hashes of the entries below it.
+// The sum does not depend on the order of insertions, so maps with the same
+// entries hash alike, and hash() is O(1).
+template <class K, class V, class Less = std::less<K>>
+class PersistentMap {
+  public:
+    PersistentMap() = default;
+
+    const V *find(const K &key) const {
+        const Node *n = root_;
+        while (n != nullptr) {
+            if (Less()(key, n->key)) {
+                n = n->left;
+            } else if (Less()(n->key, key)) {
+                n = n->right;
+            } else {
+                return &n->value;
+            }
+        }
+        return nullptr;
+    }
+
+    // Adds key or replaces its value. entryHash stands for the pair.
+    PersistentMap insert(Arena &arena, const K &key, const V &value, uint64_t entryHash) const {
+        return PersistentMap(insert(arena, root_, key, value, entryHash));
+    }
+
+    // Replaces every value with f(key, value), which returns the new value
+    // and its entry hash, keeping the shape of the tree.
+    template <class F>
+    PersistentMap mapValues(Arena &arena, F &&f) const {
+        return PersistentMap(mapValues(arena, root_, f));
+    }
+
+    bool empty() const { return root_ == nullptr; }
+    uint64_t hash() const { return hash(root_); }
+
+  private:
+    struct Node {
+        K key;
+        V value;
+        const Node *left;
+        const Node *right;
+        uint64_t entryHash;
+        uint64_t hash;
+        int height;
+    };
+
+    explicit PersistentMap(const Node *root) : root_(root) {}
+
+    static int height(const Node *n) { return n == nullptr ? 0 : n->height; }
+    static uint64_t hash(const Node *n) { return n == nullptr ? 0 : n->hash; }
+
+    static const Node *make(Arena &arena, const K &key, const V &value, uint64_t entryHash,
+                            const Node *left, const Node *right) {
+        int h = height(left) > height(right) ? height(left) : height(right);
+        return arena.make<Node>(
+            Node{key, value, left, right, entryHash, entryHash + hash(left) + hash(right), h + 1});
+    }
+
+    static const Node *remake(Arena &arena, const Node *n, const Node *left, const Node *right) {
+        return make(arena, n->key, n->value, n->entryHash, left, right);
+    }
+
+    // Like remake, restoring the AVL invariant when one side has grown by
+    // one level too many.
+    static const Node *balance(Arena &arena, const Node *n, const Node *left, const Node *right) {
+        if (height(left) > height(right) + 1) {
+            if (height(left->left) >= height(left->right)) {
+                return remake(arena, left, left->left, remake(arena, n, left->right, right));
+            }
+            const Node *lr = left->right;
+            return remake(arena, lr, remake(arena, left, left->left, lr->left),
+                          remake(arena, n, lr->right, right));
+        }
+        if (height(right) > height(left) + 1) {
+            if (height(right->right) >= height(right->left)) {
+                return remake(arena, right, remake(arena, n, left, right->left), right->right);
+            }
+            const Node *rl = right->left;
+            return remake(arena, rl, remake(arena, n, left, rl->left),
+                          remake(arena, right, rl->right, right->right));
+        }
+        return remake(arena, n, left, right);
+    }
+
+    static const Node *insert(Arena &arena, const Node *n, const K &key, const V &value,
+                              uint64_t entryHash) {
+        if (n == nullptr) {
+            return make(arena, key, value, entryHash, nullptr, nullptr);
+        }
+        if (Less()(key, n->key)) {
+            return balance(arena, n, insert(arena, n->left, key, value, entryHash), n->right);
+        }
+        if (Less()(n->key, key)) {
+            return balance(arena, n, n->left, insert(arena, n->right, key, value, entryHash));
+        }
+        return make(arena, key, value, entryHash, n->left, n->right);
+    }
+
+    template <class F>
+    static const Node *mapValues(Arena &arena, const Node *n, F &f) {
+        if (n == nullptr) {
+            return nullptr;
+        }
+        const Node *left = mapValues(arena, n->left, f);
+        const Node *right = mapValues(arena, n->right, f);
+        auto mapped = f(n->key, n->value);
+        return make(arena, n->key, mapped.first, mapped.second, left, right);
+    }
+
+    const Node *root_ = nullptr;
+};
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_PERSISTENTMAP_H_
@@ -0,0 +1,364 @@
+#include "Printer.h"
+
+#include <cerrno>
+#include <limits>
+
+#include <unistd.h>
+
+namespace lamgamma {
+
+namespace {
+
+// Writes the single-line text of e through put, stopping as soon as put
+// returns false. Returns whether it got to the end.
+template <class Put>
+bool writeFlat(const RawExpr *e, Put &put) {
+    using Kind = RawExpr::Kind;
+
+    auto infix = [&](const RawExpr *left, const char *op, const RawExpr *right) {
+        return put("(") && writeFlat(left, put) && put(" ") && put(op) && put(" ") &&
+               writeFlat(right, put) && put(")");
+    };
+
+    switch (e->kind) {
+    case Kind::Var:
+        return put(e->as<RawExpr::Var>().var.toString());
+    case Kind::Func: {
+        const auto &f = e->as<RawExpr::Func>();
+        if (!put("(")) {
+            return false;
+        }
+        for (size_t i = 0; i < f.params.size; ++i) {
+            if ((i > 0 && !put(", ")) || !put(f.params[i].toString())) {
+                return false;
+            }
+        }
+        return put(") => { ") && writeFlat(f.body, put) && put(" }");
+    }
+    case Kind::App: {
+        const auto &a = e->as<RawExpr::App>();
+        return put("( ") && writeFlat(a.func, put) && put(" ") && writeFlat(a.arg, put) &&
+               put(" )");
+    }
+    case Kind::Let:
+    case Kind::LetRec:
+    case Kind::LetCs: {
+        const auto &l = e->as<RawExpr::Let>();
+        const char *keyword = e->kind == Kind::Let      ? "(let "
+                              : e->kind == Kind::LetCs  ? "(let cs "
+                              : l.memo                  ? "(let rec memo "
+                                                        : "(let rec ";
+        return put(keyword) && put(l.param.toString()) && put(" = ") &&
+               writeFlat(l.expr, put) && put(" in ") && writeFlat(l.body, put) && put(")");
+    }
+    case Kind::IntLit:
+        return put(std::to_string(e->as<RawExpr::IntLit>().value));
+    case Kind::BoolLit:
+        return put(e->as<RawExpr::BoolLit>().value ? "true" : "false");
+    case Kind::BinOp: {
+        const auto &b = e->as<RawExpr::BinOp>();
+        return infix(b.left, toString(b.op), b.right);
+    }
+    case Kind::ShortCircuitOp: {
+        const auto &b = e->as<RawExpr::ShortCircuitOp>();
+        return infix(b.left, toString(b.op), b.right);
+    }
+    case Kind::UniOp: {
+        const auto &u = e->as<RawExpr::UniOp>();
+        return put("(") && put(toString(u.op)) && put(" ") && writeFlat(u.expr, put) && put(")");
+    }
+    case Kind::If: {
+        const auto &i = e->as<RawExpr::If>();
+        return put("(if ") && writeFlat(i.cond, put) && put(" then ") &&
+               writeFlat(i.thenBranch, put) && put(" else ") && writeFlat(i.elseBranch, put) &&
+               put(")");
+    }
+    case Kind::ArrayOp: {
+        const auto &a = e->as<RawExpr::ArrayOp>();
+        if (a.op == ArrayOp::Make) {
+            if (!put("[|")) {
+                return false;
+            }
+            for (size_t i = 0; i < a.args.size; ++i) {
+                if (!put(i > 0 ? ", " : " ") || !writeFlat(a.args[i], put)) {
+                    return false;
+                }
+            }
+            return put(" |]");
+        }
+        if (a.op == ArrayOp::Get && a.args.size == 2) {
+            return put("(") && writeFlat(a.args[0], put) && put(".(") &&
+                   writeFlat(a.args[1], put) && put("))");
+        }
+        if (!put("(") || !put(toString(a.op))) {
+            return false;
+        }
+        for (const RawExpr *arg : a.args) {
+            if (!put(" ") || !writeFlat(arg, put)) {
+                return false;
+            }
+        }
+        return put(")");
+    }
+    case Kind::Tuple: {
+        const auto &t = e->as<RawExpr::Tuple>();
+        for (size_t i = 0; i < t.elements.size; ++i) {
+            if (!put(i > 0 ? ", " : "(") || !writeFlat(t.elements[i], put)) {
+                return false;
+            }
+        }
+        return put(")");
+    }
+    case Kind::Proj: {
+        const auto &p = e->as<RawExpr::Proj>();
+        return put("(") && writeFlat(p.tuple, put) && put(".") && put(std::to_string(p.index)) &&
+               put(")");
+    }
+    case Kind::Quote:
+        return put("`{ ") && writeFlat(e->as<RawExpr::Quote>().expr, put) && put(" }");
+    case Kind::Splice: {
+        const auto &s = e->as<RawExpr::Splice>();
+        return put("~") && put(std::to_string(s.shift)) && put("{ ") && writeFlat(s.expr, put) &&
+               put(" }");
+    }
+    case Kind::GenLet:
+        return put("(genlet ") && writeFlat(e->as<RawExpr::Quote>().expr, put) && put(")");
+    }
+    return true;
+}
+
+// The layout of Printer.res. Every step returns false once the limit has
+// been reached, which unwinds the walk.
+class Layout {
+  public:
+    Layout(Sink &sink, const PrintOptions &options)
+        : sink_(sink), width_(options.width),
+          limit_(options.limit.value_or(std::numeric_limits<size_t>::max())) {}
+
+    bool layout(const RawExpr *e, size_t indent) {
+        using Kind = RawExpr::Kind;
+
+        if (fits(e)) {
+            auto put = [this](std::string_view s) { return emit(s); };
+            return writeFlat(e, put);
+        }
+
+        switch (e->kind) {
+        case Kind::Var:
+        case Kind::IntLit:
+        case Kind::BoolLit: {
+            auto put = [this](std::string_view s) { return emit(s); };
+            return writeFlat(e, put);
+        }
+        case Kind::Func: {
+            const auto &f = e->as<RawExpr::Func>();
+            std::string opening = "(";
+            for (size_t i = 0; i < f.params.size; ++i) {
+                if (i > 0) {
+                    opening += ", ";
+                }
+                opening += f.params[i].toString();
+            }
+            opening += ") => {";
+            return block(opening, f.body, indent);
+        }
+        case Kind::App: {
+            const auto &a = e->as<RawExpr::App>();
+            return emit("( ") && layout(a.func, indent + 2) && newline(indent + 2) &&
+                   layout(a.arg, indent + 2) && emit(" )");
+        }
+        case Kind::Let:
+        case Kind::LetRec:
+        case Kind::LetCs: {
+            const auto &l = e->as<RawExpr::Let>();
+            const char *keyword = e->kind == Kind::Let      ? "(let "
+                                  : e->kind == Kind::LetCs  ? "(let cs "
+                                  : l.memo                  ? "(let rec memo "
+                                                            : "(let rec ";
+            return emit(keyword) && emit(l.param.toString()) && emit(" = ") &&
+                   layout(l.expr, indent + 2) && emit(" in") && newline(indent + 1) &&
+                   layout(l.body, indent + 1) && emit(")");
+        }
+        case Kind::BinOp: {
+            const auto &b = e->as<RawExpr::BinOp>();
+            return infix(b.left, toString(b.op), b.right, indent);
+        }
+        case Kind::ShortCircuitOp: {
+            const auto &b = e->as<RawExpr::ShortCircuitOp>();
+            return infix(b.left, toString(b.op), b.right, indent);
+        }
+        case Kind::UniOp: {
+            const auto &u = e->as<RawExpr::UniOp>();
+            return emit("(") && emit(toString(u.op)) && emit(" ") && layout(u.expr, indent + 2) &&
+                   emit(")");
+        }
+        case Kind::ArrayOp: {
+            const auto &a = e->as<RawExpr::ArrayOp>();
+            if (a.op == ArrayOp::Make) {
+                if (!emit("[|")) {
+                    return false;
+                }
+                for (size_t i = 0; i < a.args.size; ++i) {
+                    if ((i > 0 && !emit(",")) || !newline(indent + 2) ||
+                        !layout(a.args[i], indent + 2)) {
+                        return false;
+                    }
+                }
+                return newline(indent) && emit("|]");
+            }
+            if (a.op == ArrayOp::Get && a.args.size == 2) {
+                return emit("(") && layout(a.args[0], indent + 1) && emit(".(") &&
+                       layout(a.args[1], indent + 3) && emit("))");
+            }
+            if (!emit("(") || !emit(toString(a.op))) {
+                return false;
+            }
+            for (const RawExpr *arg : a.args) {
+                if (!newline(indent + 2) || !layout(arg, indent + 2)) {
+                    return false;
+                }
+            }
+            return emit(")");
+        }
+        case Kind::Tuple: {
+            const auto &t = e->as<RawExpr::Tuple>();
+            for (size_t i = 0; i < t.elements.size; ++i) {
+                if ((i > 0 ? !emit(",") || !newline(indent + 1) : !emit("(")) ||
+                    !layout(t.elements[i], indent + 1)) {
+                    return false;
+                }
+            }
+            return emit(")");
+        }
+        case Kind::Proj: {
+            const auto &p = e->as<RawExpr::Proj>();
+            return emit("(") && layout(p.tuple, indent + 1) && emit(".") &&
+                   emit(std::to_string(p.index)) && emit(")");
+        }
+        case Kind::GenLet:
+            return emit("(genlet ") && layout(e->as<RawExpr::Quote>().expr, indent + 2) &&
+                   emit(")");
+        case Kind::If: {
+            const auto &i = e->as<RawExpr::If>();
+            return emit("(if ") && layout(i.cond, indent + 4) && newline(indent + 1) &&
+                   emit("then ") && layout(i.thenBranch, indent + 6) && newline(indent + 1) &&
+                   emit("else ") && layout(i.elseBranch, indent + 6) && emit(")");
+        }
+        case Kind::Quote:
+            return block("`{", e->as<RawExpr::Quote>().expr, indent);
+        case Kind::Splice: {
+            const auto &s = e->as<RawExpr::Splice>();
+            return block("~" + std::to_string(s.shift) + "{", s.expr, indent);
+        }
+        }
+        return true;
+    }
+
+  private:
+    bool emit(std::string_view s) {
+        if (s.size() > limit_ - written_) {
+            sink_.write(s.substr(0, limit_ - written_));
+            sink_.write(kTruncationMarker);
+            written_ = limit_;
+            return false;
+        }
+        sink_.write(s);
+        written_ += s.size();
+        column_ += s.size();
+        return true;
+    }
+
+    bool newline(size_t indent) {
+        std::string s = "\n";
+        s.append(indent, ' ');
+        if (!emit(s)) {
+            return false;
+        }
+        column_ = indent;
+        return true;
+    }
+
+    // Looks at no more of e than fits in the rest of the line.
+    bool fits(const RawExpr *e) const {
+        size_t room = width_ > column_ ? width_ - column_ : 0;
+        size_t used = 0;
+        auto put = [&](std::string_view s) {
+            used += s.size();
+            return used <= room;
+        };
+        return writeFlat(e, put);
+    }
+
+    bool infix(const RawExpr *left, const char *op, const RawExpr *right, size_t indent) {
+        return emit("(") && layout(left, indent + 1) && emit(" ") && emit(op) &&
+               newline(indent + 1) && layout(right, indent + 1) && emit(")");
+    }
+
+    bool block(std::string_view opening, const RawExpr *body, size_t indent) {
+        return emit(opening) && newline(indent + 2) && layout(body, indent + 2) &&
+               newline(indent) && emit("}");
+    }
+
+    Sink &sink_;
+    size_t width_;
+    size_t limit_;
+    size_t column_ = 0;
+    size_t written_ = 0;
+};
+
+} // namespace
+
+FdSink::FdSink(int fd) : fd_(fd) { buffer_.reserve(kBufferSize); }
+
+void FdSink::write(std::string_view piece) {
+    if (buffer_.size() + piece.size() > kBufferSize) {
+        flush();
+    }
+    if (piece.size() > kBufferSize) {
+        buffer_.assign(piece);
+        flush();
+        return;
+    }
+    buffer_.append(piece);
+}
+
+bool FdSink::flush() {
+    const char *p = buffer_.data();
+    size_t n = buffer_.size();
+    while (ok_ && n > 0) {
+        ssize_t w = ::write(fd_, p, n);
+        if (w < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ok_ = false;
+            break;
+        }
+        p += w;
+        n -= static_cast<size_t>(w);
+    }
+    buffer_.clear();
+    return ok_;
+}
+
+void print(const RawExpr *expr, Sink &sink, const PrintOptions &options) {
+    Layout(sink, options).layout(expr, 0);
+}
+
+bool printToFd(const RawExpr *expr, int fd, const PrintOptions &options) {
+    FdSink sink(fd);
+    print(expr, sink, options);
+    return sink.flush();
+}
+
+std::string toString(const RawExpr *expr) {
+    std::string out;
+    auto put = [&](std::string_view s) {
+        out.append(s);
+        return true;
+    };
+    writeFlat(expr, put);
+    return out;
+}
+
+} // namespace lamgamma
@@ -0,0 +1,72 @@
+#ifndef LAMGAMMA_PRINTER_H_
+#define LAMGAMMA_PRINTER_H_
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "RawExpr.h"
+
+namespace lamgamma {
+
+// Native counterpart of Printer.res. Code is laid out within a line width
+// and streamed to a sink piece by piece: a subtree that fits in the rest of
+// the line is written as toString writes it, one that does not is broken
+// into lines with its children indented.
+struct PrintOptions {
+    size_t width = 80;
+    // Bytes to write before giving up with kTruncationMarker.
+    std::optional<size_t> limit;
+};
+
+inline constexpr std::string_view kTruncationMarker = " …";
+
+// Where printed text goes. The pieces carry no meaning of their own.
+class Sink {
+  public:
+    virtual ~Sink() = default;
+    virtual void write(std::string_view piece) = 0;
+};
+
+class StringSink : public Sink {
+  public:
+    void write(std::string_view piece) override { out_.append(piece); }
+    const std::string &str() const { return out_; }
+
+  private:
+    std::string out_;
+};
+
+// Buffers output for a file descriptor it does not own. After a failed
+// write nothing more is written and ok() is false.
+class FdSink : public Sink {
+  public:
+    explicit FdSink(int fd);
+    ~FdSink() override { flush(); }
+    FdSink(const FdSink &) = delete;
+    FdSink &operator=(const FdSink &) = delete;
+
+    void write(std::string_view piece) override;
+    bool flush();
+    bool ok() const { return ok_; }
+
+  private:
+    static constexpr size_t kBufferSize = 64 * 1024;
+
+    int fd_;
+    std::string buffer_;
+    bool ok_ = true;
+};
+
+void print(const RawExpr *expr, Sink &sink, const PrintOptions &options = {});
+
+// Prints expr to fd; false when writing fails.
+bool printToFd(const RawExpr *expr, int fd, const PrintOptions &options = {});
+
+// The text of expr on a single line, as RawExpr.toString writes it.
+std::string toString(const RawExpr *expr);
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_PRINTER_H_
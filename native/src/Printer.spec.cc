@@ -0,0 +1,107 @@
+// Cases for the native printer, mirroring
+// playground/src/interpreter/Printer.res.spec.ts where the two overlap.
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include <tree_sitter/api.h>
+
+#include "Arena.h"
+#include "Printer.h"
+#include "RawExpr.h"
+#include "SyntaxNodeParser.h"
+#include "tree-sitter-lamgamma_parser.h"
+
+namespace lamgamma {
+namespace {
+
+class PrinterSpec : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        parser_ = ts_parser_new();
+        ts_parser_set_language(parser_, tree_sitter_lamgamma_parser());
+    }
+
+    void TearDown() override {
+        for (TSTree *tree : trees_) {
+            ts_tree_delete(tree);
+        }
+        ts_parser_delete(parser_);
+    }
+
+    // Assume that parse always succeeds
+    const RawExpr *parse(const std::string &input) {
+        sources_.push_back(input);
+        const std::string &source = sources_.back();
+        TSTree *tree = ts_parser_parse_string(parser_, nullptr, source.data(), source.size());
+        trees_.push_back(tree);
+        SyntaxNodeParser syntaxNodeParser(arena_, source);
+        return stripTypeInfo(syntaxNodeParser.parseSourceFileNode(ts_tree_root_node(tree)).value(),
+                             arena_);
+    }
+
+    std::string print(const RawExpr *expr, const PrintOptions &options) {
+        StringSink sink;
+        lamgamma::print(expr, sink, options);
+        return sink.str();
+    }
+
+  private:
+    TSParser *parser_ = nullptr;
+    Arena arena_;
+    std::vector<std::string> sources_;
+    std::vector<TSTree *> trees_;
+};
+
+TEST_F(PrinterSpec, FlatText) {
+    EXPECT_EQ(toString(parse("let x:int = 1 in (y) => { if y then x + 1 else !y }")),
+              "(let x = 1 in (y) => { (if y then (x + 1) else (! y)) })");
+    EXPECT_EQ(toString(parse("`{@! ~{ `{@! 1 } } }")), "`{ ~1{ `{ 1 } } }");
+    EXPECT_EQ(toString(parse("let cs f = [g:>!](x:<int@g>) => { x } in f^h 2")),
+              "(let cs f = (x) => { x } in ( f 2 ))");
+}
+
+TEST_F(PrinterSpec, FitsOnALine) {
+    const RawExpr *expr = parse("let x = 1 in x + 2");
+    EXPECT_EQ(print(expr, PrintOptions{}), toString(expr));
+}
+
+TEST_F(PrinterSpec, BreaksWithinTheWidth) {
+    const RawExpr *expr = parse("`{ (x) => { if x == 0 then 1 else x * x * x * x * x } }");
+    EXPECT_EQ(print(expr, PrintOptions{20, std::nullopt}),
+              "`{\n"
+              "  (x) => {\n"
+              "    (if (x == 0)\n"
+              "     then 1\n"
+              "     else ((((x * x) *\n"
+              "             x) *\n"
+              "            x) *\n"
+              "           x))\n"
+              "  }\n"
+              "}");
+}
+
+TEST_F(PrinterSpec, TruncatesBeyondTheLimit) {
+    const RawExpr *expr = parse("1 + 2 + 3 + 4 + 5 + 6");
+    EXPECT_EQ(print(expr, PrintOptions{80, 10}), "(((((1 + 2 …");
+}
+
+TEST_F(PrinterSpec, WritesToAFileDescriptor) {
+    const RawExpr *expr = parse("let x = 1 in x + 2");
+    FILE *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    EXPECT_TRUE(printToFd(expr, fileno(file), PrintOptions{}));
+    std::rewind(file);
+    char buffer[64] = {};
+    size_t n = std::fread(buffer, 1, sizeof(buffer) - 1, file);
+    std::fclose(file);
+    EXPECT_EQ(std::string(buffer, n), "(let x = 1 in (x + 2))");
+}
+
+TEST_F(PrinterSpec, ReportsWriteFailures) {
+    EXPECT_FALSE(printToFd(parse("1"), -1, PrintOptions{}));
+}
+
+} // namespace
+} // namespace lamgamma
@@ -0,0 +1,151 @@
+#include "RawExpr.h"
+
+namespace lamgamma {
+
+namespace {
+
+template <class T>
+T *make(Arena &arena, RawExpr::Kind kind) {
+    T *e = arena.make<T>();
+    e->kind = kind;
+    return e;
+}
+
+} // namespace
+
+const RawExpr *stripTypeInfo(const Expr *expr, Arena &arena) {
+    using Kind = RawExpr::Kind;
+
+    switch (expr->kind) {
+    case Expr::Kind::Var: {
+        auto *e = make<RawExpr::Var>(arena, Kind::Var);
+        e->var = expr->as<Expr::Var>().var;
+        return e;
+    }
+    case Expr::Kind::Func: {
+        const auto &f = expr->as<Expr::Func>();
+        auto *params = arena.makeArray<Var>(f.params.size);
+        for (size_t i = 0; i < f.params.size; ++i) {
+            params[i] = f.params[i].var;
+        }
+        auto *e = make<RawExpr::Func>(arena, Kind::Func);
+        e->params = Span<Var>{params, f.params.size};
+        e->body = stripTypeInfo(f.body, arena);
+        return e;
+    }
+    case Expr::Kind::App: {
+        const auto &a = expr->as<Expr::App>();
+        auto *e = make<RawExpr::App>(arena, Kind::App);
+        e->func = stripTypeInfo(a.func, arena);
+        e->arg = stripTypeInfo(a.arg, arena);
+        return e;
+    }
+    case Expr::Kind::Let:
+    case Expr::Kind::LetRec:
+    case Expr::Kind::LetCs: {
+        const auto &l = expr->as<Expr::Let>();
+        Kind kind = expr->kind == Expr::Kind::Let      ? Kind::Let
+                    : expr->kind == Expr::Kind::LetRec ? Kind::LetRec
+                                                       : Kind::LetCs;
+        auto *e = make<RawExpr::Let>(arena, kind);
+        e->param = l.param.var;
+        e->expr = stripTypeInfo(l.expr, arena);
+        e->body = stripTypeInfo(l.body, arena);
+        e->memo = l.memo;
+        return e;
+    }
+    case Expr::Kind::IntLit: {
+        auto *e = make<RawExpr::IntLit>(arena, Kind::IntLit);
+        e->value = expr->as<Expr::IntLit>().value;
+        return e;
+    }
+    case Expr::Kind::BoolLit: {
+        auto *e = make<RawExpr::BoolLit>(arena, Kind::BoolLit);
+        e->value = expr->as<Expr::BoolLit>().value;
+        return e;
+    }
+    case Expr::Kind::BinOp: {
+        const auto &b = expr->as<Expr::BinOp>();
+        auto *e = make<RawExpr::BinOp>(arena, Kind::BinOp);
+        e->op = b.op;
+        e->left = stripTypeInfo(b.left, arena);
+        e->right = stripTypeInfo(b.right, arena);
+        return e;
+    }
+    case Expr::Kind::ShortCircuitOp: {
+        const auto &b = expr->as<Expr::ShortCircuitOp>();
+        auto *e = make<RawExpr::ShortCircuitOp>(arena, Kind::ShortCircuitOp);
+        e->op = b.op;
+        e->left = stripTypeInfo(b.left, arena);
+        e->right = stripTypeInfo(b.right, arena);
+        return e;
+    }
+    case Expr::Kind::UniOp: {
+        const auto &u = expr->as<Expr::UniOp>();
+        auto *e = make<RawExpr::UniOp>(arena, Kind::UniOp);
+        e->op = u.op;
+        e->expr = stripTypeInfo(u.expr, arena);
+        return e;
+    }
+    case Expr::Kind::If: {
+        const auto &i = expr->as<Expr::If>();
+        auto *e = make<RawExpr::If>(arena, Kind::If);
+        e->cond = stripTypeInfo(i.cond, arena);
+        e->thenBranch = stripTypeInfo(i.thenBranch, arena);
+        e->elseBranch = stripTypeInfo(i.elseBranch, arena);
+        return e;
+    }
+    case Expr::Kind::ArrayOp: {
+        const auto &a = expr->as<Expr::ArrayOp>();
+        auto **args = arena.makeArray<const RawExpr *>(a.args.size);
+        for (size_t i = 0; i < a.args.size; ++i) {
+            args[i] = stripTypeInfo(a.args[i], arena);
+        }
+        auto *e = make<RawExpr::ArrayOp>(arena, Kind::ArrayOp);
+        e->op = a.op;
+        e->args = Span<const RawExpr *>{args, a.args.size};
+        return e;
+    }
+    case Expr::Kind::Tuple: {
+        const auto &t = expr->as<Expr::Tuple>();
+        auto **elements = arena.makeArray<const RawExpr *>(t.elements.size);
+        for (size_t i = 0; i < t.elements.size; ++i) {
+            elements[i] = stripTypeInfo(t.elements[i], arena);
+        }
+        auto *e = make<RawExpr::Tuple>(arena, Kind::Tuple);
+        e->elements = Span<const RawExpr *>{elements, t.elements.size};
+        return e;
+    }
+    case Expr::Kind::Proj: {
+        const auto &p = expr->as<Expr::Proj>();
+        auto *e = make<RawExpr::Proj>(arena, Kind::Proj);
+        e->tuple = stripTypeInfo(p.tuple, arena);
+        e->index = p.index;
+        return e;
+    }
+    case Expr::Kind::Quote: {
+        auto *e = make<RawExpr::Quote>(arena, Kind::Quote);
+        e->expr = stripTypeInfo(expr->as<Expr::Quote>().expr, arena);
+        return e;
+    }
+    case Expr::Kind::Splice: {
+        const auto &s = expr->as<Expr::Splice>();
+        auto *e = make<RawExpr::Splice>(arena, Kind::Splice);
+        e->shift = s.shift;
+        e->expr = stripTypeInfo(s.expr, arena);
+        return e;
+    }
+    case Expr::Kind::GenLet: {
+        auto *e = make<RawExpr::Quote>(arena, Kind::GenLet);
+        e->expr = stripTypeInfo(expr->as<Expr::GenLet>().expr, arena);
+        return e;
+    }
+    case Expr::Kind::ClsAbs:
+        return stripTypeInfo(expr->as<Expr::ClsAbs>().body, arena);
+    case Expr::Kind::ClsApp:
+        return stripTypeInfo(expr->as<Expr::ClsApp>().func, arena);
+    }
+    return nullptr;
+}
+
+} // namespace lamgamma
@@ -0,0 +1,152 @@
+#ifndef LAMGAMMA_RAWEXPR_H_
+#define LAMGAMMA_RAWEXPR_H_
+
+#include <cstdint>
+
+#include "Arena.h"
+#include "Expr.h"
+#include "Operator.h"
+#include "Var.h"
+
+namespace lamgamma {
+
+// Native counterpart of RawExpr.t, the untyped tree the evaluator runs and
+// generated code is made of. Only the forms stripTypeInfo produces are
+// here; the type-specialized operations and persisted values of the
+// playground's evaluator have no native counterpart yet.
+struct RawExpr {
+    enum class Kind : uint8_t {
+        // basic syntax
+        Var,
+        Func,
+        App,
+        Let,
+        LetRec,
+        // primitive operations
+        IntLit,
+        BoolLit,
+        BinOp,
+        ShortCircuitOp,
+        UniOp,
+        If,
+        ArrayOp,
+        Tuple,
+        Proj,
+        // staging constructs
+        Quote,
+        Splice,
+        GenLet,
+        // cross-stage persistence
+        LetCs,
+    };
+
+    struct Var;
+    struct Func;
+    struct App;
+    struct Let; // Let, LetRec and LetCs
+    struct IntLit;
+    struct BoolLit;
+    struct BinOp;
+    struct ShortCircuitOp;
+    struct UniOp;
+    struct If;
+    struct ArrayOp;
+    struct Tuple;
+    struct Proj;
+    struct Quote; // Quote and GenLet
+    struct Splice;
+
+    Kind kind;
+
+    template <class T>
+    const T &as() const {
+        return static_cast<const T &>(*this);
+    }
+};
+
+struct RawExpr::Var : RawExpr {
+    lamgamma::Var var;
+};
+
+struct RawExpr::Func : RawExpr {
+    Span<lamgamma::Var> params;
+    const RawExpr *body;
+};
+
+struct RawExpr::App : RawExpr {
+    const RawExpr *func;
+    const RawExpr *arg;
+};
+
+struct RawExpr::Let : RawExpr {
+    lamgamma::Var param;
+    const RawExpr *expr;
+    const RawExpr *body;
+    bool memo = false; // let rec memo: results are cached by argument
+};
+
+struct RawExpr::IntLit : RawExpr {
+    int32_t value;
+};
+
+struct RawExpr::BoolLit : RawExpr {
+    bool value;
+};
+
+struct RawExpr::BinOp : RawExpr {
+    lamgamma::BinOp op;
+    const RawExpr *left;
+    const RawExpr *right;
+};
+
+struct RawExpr::ShortCircuitOp : RawExpr {
+    lamgamma::ShortCircuitOp op;
+    const RawExpr *left;
+    const RawExpr *right;
+};
+
+struct RawExpr::UniOp : RawExpr {
+    lamgamma::UniOp op;
+    const RawExpr *expr;
+};
+
+struct RawExpr::If : RawExpr {
+    const RawExpr *cond;
+    const RawExpr *thenBranch;
+    const RawExpr *elseBranch;
+};
+
+// Operands in the order of lamgamma::ArrayOp.
+struct RawExpr::ArrayOp : RawExpr {
+    lamgamma::ArrayOp op;
+    Span<const RawExpr *> args;
+};
+
+// An unboxed tuple of two or more elements.
+struct RawExpr::Tuple : RawExpr {
+    Span<const RawExpr *> elements;
+};
+
+// Component index of tuple, from 0.
+struct RawExpr::Proj : RawExpr {
+    const RawExpr *tuple;
+    uint32_t index;
+};
+
+struct RawExpr::Quote : RawExpr {
+    const RawExpr *expr;
+};
+
+struct RawExpr::Splice : RawExpr {
+    int shift;
+    const RawExpr *expr;
+};
+
+// Counterpart of Expr.stripTypeInfo: erases type annotations, classifiers
+// and classifier abstraction and application. The result is allocated in
+// arena.
+const RawExpr *stripTypeInfo(const Expr *expr, Arena &arena);
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_RAWEXPR_H_
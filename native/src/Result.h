@@ -0,0 +1,44 @@
+#ifndef LAMGAMMA_RESULT_H_
+#define LAMGAMMA_RESULT_H_
+
+#include <utility>
+#include <variant>
+
+namespace lamgamma {
+
+template <class E>
+struct Failure {
+    E error;
+};
+
+// Wraps an error so it converts to any Result<T, E>, like `fail` in the
+// ReScript modules.
+template <class E>
+Failure<E> fail(E error) {
+    return Failure<E>{std::move(error)};
+}
+
+// Counterpart of ReScript's result<'a, 'e>. The engine reports expected
+// failures (ill-typed programs, syntax errors) through Result and reserves
+// exceptions for broken invariants.
+template <class T, class E>
+class Result {
+  public:
+    Result(T value) : v_(std::in_place_index<0>, std::move(value)) {}
+    Result(Failure<E> failure) : v_(std::in_place_index<1>, std::move(failure.error)) {}
+
+    bool isOk() const { return v_.index() == 0; }
+    explicit operator bool() const { return isOk(); }
+
+    T &value() { return std::get<0>(v_); }
+    const T &value() const { return std::get<0>(v_); }
+    E &error() { return std::get<1>(v_); }
+    const E &error() const { return std::get<1>(v_); }
+
+  private:
+    std::variant<T, E> v_;
+};
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_RESULT_H_
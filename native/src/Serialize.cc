@@ -0,0 +1,588 @@
+#include "Serialize.h"
+
+#include <string_view>
+#include <unordered_map>
+
+namespace lamgamma {
+
+namespace {
+
+// Tags, as in Serialize.res.
+enum Tag : uint8_t {
+    kVar = 0,
+    kFunc = 1,
+    kApp = 2,
+    kLet = 3,
+    kLetRec = 4,
+    kIntLit = 5,
+    kFalse = 6,
+    kTrue = 7,
+    kBinOp = 8,
+    kShortCircuitOp = 9,
+    kUniOp = 10,
+    kIf = 11,
+    kPrimOp = 12,
+    kPrimNot = 13,
+    kQuote = 14,
+    kSplice = 15,
+    kGenLet = 16,
+    kLetCs = 17,
+    kShared = 18,
+    kReference = 19,
+    kLetRecMemo = 20,
+    kArrayOp = 21,
+    kTuple = 22,
+    kProj = 23,
+};
+
+// The operators are encoded by their position in the tables of
+// Serialize.res, which list them in the order of the native enums.
+constexpr uint32_t kBinOps = 11;
+constexpr uint32_t kShortCircuitOps = 2;
+constexpr uint32_t kUniOps = 1;
+constexpr uint32_t kArrayOps = 6;
+// Serialize.primOps: the int operations in the order of BinOp, then
+// BoolEq, BoolNe, BoolAnd and BoolOr.
+constexpr uint32_t kPrimOps = 15;
+
+uint32_t zigzag(int32_t n) {
+    return (static_cast<uint32_t>(n) << 1) ^ static_cast<uint32_t>(n >> 31);
+}
+
+int32_t unzigzag(uint32_t n) {
+    return static_cast<int32_t>((n >> 1) ^ (~(n & 1) + 1));
+}
+
+bool isTrivial(const RawExpr *e) {
+    return e->kind == RawExpr::Kind::Var || e->kind == RawExpr::Kind::IntLit ||
+           e->kind == RawExpr::Kind::BoolLit;
+}
+
+template <class F>
+void forEachChild(const RawExpr *e, F &&f) {
+    using Kind = RawExpr::Kind;
+    switch (e->kind) {
+    case Kind::Var:
+    case Kind::IntLit:
+    case Kind::BoolLit:
+        return;
+    case Kind::Func:
+        f(e->as<RawExpr::Func>().body);
+        return;
+    case Kind::App:
+        f(e->as<RawExpr::App>().func);
+        f(e->as<RawExpr::App>().arg);
+        return;
+    case Kind::Let:
+    case Kind::LetRec:
+    case Kind::LetCs:
+        f(e->as<RawExpr::Let>().expr);
+        f(e->as<RawExpr::Let>().body);
+        return;
+    case Kind::BinOp:
+        f(e->as<RawExpr::BinOp>().left);
+        f(e->as<RawExpr::BinOp>().right);
+        return;
+    case Kind::ShortCircuitOp:
+        f(e->as<RawExpr::ShortCircuitOp>().left);
+        f(e->as<RawExpr::ShortCircuitOp>().right);
+        return;
+    case Kind::UniOp:
+        f(e->as<RawExpr::UniOp>().expr);
+        return;
+    case Kind::If:
+        f(e->as<RawExpr::If>().cond);
+        f(e->as<RawExpr::If>().thenBranch);
+        f(e->as<RawExpr::If>().elseBranch);
+        return;
+    case Kind::ArrayOp:
+        for (const RawExpr *arg : e->as<RawExpr::ArrayOp>().args) {
+            f(arg);
+        }
+        return;
+    case Kind::Tuple:
+        for (const RawExpr *element : e->as<RawExpr::Tuple>().elements) {
+            f(element);
+        }
+        return;
+    case Kind::Proj:
+        f(e->as<RawExpr::Proj>().tuple);
+        return;
+    case Kind::Quote:
+    case Kind::GenLet:
+        f(e->as<RawExpr::Quote>().expr);
+        return;
+    case Kind::Splice:
+        f(e->as<RawExpr::Splice>().expr);
+        return;
+    }
+}
+
+class Encoder {
+  public:
+    explicit Encoder(const RawExpr *root) { countParents(root); }
+
+    std::vector<uint8_t> run(const RawExpr *root) {
+        node(root);
+        std::vector<uint8_t> out = {0x4c, 0x47, kSerializeVersion}; // "LG"
+        uint(out, static_cast<uint32_t>(names_.size()));
+        for (Symbol name : names_) {
+            const std::string &text = name.name();
+            uint(out, static_cast<uint32_t>(text.size()));
+            out.insert(out.end(), text.begin(), text.end());
+        }
+        out.insert(out.end(), body_.begin(), body_.end());
+        return out;
+    }
+
+  private:
+    static void uint(std::vector<uint8_t> &out, uint32_t n) {
+        while (n >= 0x80) {
+            out.push_back(static_cast<uint8_t>((n & 0x7f) | 0x80));
+            n >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(n));
+    }
+
+    void byte(uint8_t b) { body_.push_back(b); }
+    void uint(uint32_t n) { uint(body_, n); }
+
+    // Like Sharing.parents: a node's children are counted once, however
+    // many parents it has.
+    void countParents(const RawExpr *e) {
+        if (++parents_[e] == 1) {
+            forEachChild(e, [&](const RawExpr *child) { countParents(child); });
+        }
+    }
+
+    void var(Var v) {
+        auto inserted = nameIndex_.emplace(v.name.id(), static_cast<uint32_t>(names_.size()));
+        if (inserted.second) {
+            names_.push_back(v.name);
+        }
+        uint32_t index = inserted.first->second;
+        if (v.isRaw()) {
+            uint(index * 2);
+        } else {
+            uint(index * 2 + 1);
+            uint(v.id);
+        }
+    }
+
+    void node(const RawExpr *e) {
+        if (isTrivial(e) || parents_[e] < 2) {
+            fields(e);
+            return;
+        }
+        auto it = shared_.find(e);
+        if (it != shared_.end()) {
+            byte(kReference);
+            uint(it->second);
+            return;
+        }
+        shared_.emplace(e, static_cast<uint32_t>(shared_.size()));
+        byte(kShared);
+        fields(e);
+    }
+
+    void fields(const RawExpr *e) {
+        using Kind = RawExpr::Kind;
+        switch (e->kind) {
+        case Kind::Var:
+            byte(kVar);
+            var(e->as<RawExpr::Var>().var);
+            return;
+        case Kind::Func: {
+            const auto &f = e->as<RawExpr::Func>();
+            byte(kFunc);
+            uint(static_cast<uint32_t>(f.params.size));
+            for (Var param : f.params) {
+                var(param);
+            }
+            node(f.body);
+            return;
+        }
+        case Kind::App:
+            byte(kApp);
+            node(e->as<RawExpr::App>().func);
+            node(e->as<RawExpr::App>().arg);
+            return;
+        case Kind::Let:
+        case Kind::LetRec:
+        case Kind::LetCs: {
+            const auto &l = e->as<RawExpr::Let>();
+            byte(e->kind == Kind::Let      ? kLet
+                 : e->kind == Kind::LetCs ? kLetCs
+                 : l.memo                 ? kLetRecMemo
+                                          : kLetRec);
+            var(l.param);
+            node(l.expr);
+            node(l.body);
+            return;
+        }
+        case Kind::IntLit:
+            byte(kIntLit);
+            uint(zigzag(e->as<RawExpr::IntLit>().value));
+            return;
+        case Kind::BoolLit:
+            byte(e->as<RawExpr::BoolLit>().value ? kTrue : kFalse);
+            return;
+        case Kind::BinOp:
+            byte(kBinOp);
+            uint(static_cast<uint32_t>(e->as<RawExpr::BinOp>().op));
+            node(e->as<RawExpr::BinOp>().left);
+            node(e->as<RawExpr::BinOp>().right);
+            return;
+        case Kind::ShortCircuitOp:
+            byte(kShortCircuitOp);
+            uint(static_cast<uint32_t>(e->as<RawExpr::ShortCircuitOp>().op));
+            node(e->as<RawExpr::ShortCircuitOp>().left);
+            node(e->as<RawExpr::ShortCircuitOp>().right);
+            return;
+        case Kind::UniOp:
+            byte(kUniOp);
+            uint(static_cast<uint32_t>(e->as<RawExpr::UniOp>().op));
+            node(e->as<RawExpr::UniOp>().expr);
+            return;
+        case Kind::If:
+            byte(kIf);
+            node(e->as<RawExpr::If>().cond);
+            node(e->as<RawExpr::If>().thenBranch);
+            node(e->as<RawExpr::If>().elseBranch);
+            return;
+        case Kind::ArrayOp: {
+            const auto &a = e->as<RawExpr::ArrayOp>();
+            byte(kArrayOp);
+            uint(static_cast<uint32_t>(a.op));
+            uint(static_cast<uint32_t>(a.args.size));
+            for (const RawExpr *arg : a.args) {
+                node(arg);
+            }
+            return;
+        }
+        case Kind::Tuple: {
+            const auto &t = e->as<RawExpr::Tuple>();
+            byte(kTuple);
+            uint(static_cast<uint32_t>(t.elements.size));
+            for (const RawExpr *element : t.elements) {
+                node(element);
+            }
+            return;
+        }
+        case Kind::Proj:
+            byte(kProj);
+            uint(e->as<RawExpr::Proj>().index);
+            node(e->as<RawExpr::Proj>().tuple);
+            return;
+        case Kind::Quote:
+            byte(kQuote);
+            node(e->as<RawExpr::Quote>().expr);
+            return;
+        case Kind::GenLet:
+            byte(kGenLet);
+            node(e->as<RawExpr::Quote>().expr);
+            return;
+        case Kind::Splice:
+            byte(kSplice);
+            uint(static_cast<uint32_t>(e->as<RawExpr::Splice>().shift));
+            node(e->as<RawExpr::Splice>().expr);
+            return;
+        }
+    }
+
+    std::vector<uint8_t> body_;
+    std::vector<Symbol> names_;
+    std::unordered_map<uint32_t, uint32_t> nameIndex_;
+    std::unordered_map<const RawExpr *, int> parents_;
+    std::unordered_map<const RawExpr *, uint32_t> shared_;
+};
+
+// Malformed input is reported by throwing, and caught at the top of decode.
+struct Malformed {
+    SerializeError error;
+};
+
+class Decoder {
+  public:
+    Decoder(const uint8_t *data, size_t size, Arena &arena)
+        : data_(data), limit_(size), arena_(arena) {}
+
+    const RawExpr *run() {
+        uint8_t b0 = byte();
+        uint8_t b1 = byte();
+        uint8_t version = byte();
+        if (b0 != 0x4c || b1 != 0x47 || version < 1 || version > kSerializeVersion) {
+            fail(SerializeError::Kind::BadHeader);
+        }
+        size_t n = count();
+        names_.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            size_t length = count();
+            names_.push_back(Symbol::intern(
+                std::string_view(reinterpret_cast<const char *>(data_ + pos_), length)));
+            pos_ += length;
+        }
+        const RawExpr *e = node();
+        if (pos_ != limit_) {
+            fail(SerializeError::Kind::TrailingBytes);
+        }
+        return e;
+    }
+
+  private:
+    [[noreturn]] static void fail(SerializeError::Kind kind, uint32_t value = 0) {
+        throw Malformed{SerializeError{kind, value}};
+    }
+
+    uint8_t byte() {
+        if (pos_ >= limit_) {
+            fail(SerializeError::Kind::Truncated);
+        }
+        return data_[pos_++];
+    }
+
+    uint32_t uint() {
+        uint32_t acc = 0;
+        for (int shift = 0;; shift += 7) {
+            uint8_t b = byte();
+            acc |= static_cast<uint32_t>(b & 0x7f) << shift;
+            if ((b & 0x80) == 0) {
+                return acc;
+            }
+            if (shift >= 28) {
+                fail(SerializeError::Kind::BadNumber);
+            }
+        }
+    }
+
+    // A number of items to follow, each taking at least a byte.
+    size_t count() {
+        uint32_t n = uint();
+        if (n > limit_ - pos_) {
+            fail(SerializeError::Kind::Truncated);
+        }
+        return n;
+    }
+
+    uint32_t op(uint32_t size) {
+        uint32_t i = uint();
+        if (i >= size) {
+            fail(SerializeError::Kind::BadTag, i);
+        }
+        return i;
+    }
+
+    Var var() {
+        uint32_t k = uint();
+        uint32_t index = k >> 1;
+        if (index >= names_.size()) {
+            fail(SerializeError::Kind::BadName, index);
+        }
+        return (k & 1) == 0 ? Var::raw(names_[index]) : Var::colored(names_[index], uint());
+    }
+
+    template <class T>
+    T *make(RawExpr::Kind kind) {
+        T *e = arena_.make<T>();
+        e->kind = kind;
+        return e;
+    }
+
+    template <class T>
+    T *binary(RawExpr::Kind kind, decltype(T::op) o) {
+        auto *e = make<T>(kind);
+        e->op = o;
+        e->left = node();
+        e->right = node();
+        return e;
+    }
+
+    Span<const RawExpr *> nodes() {
+        size_t n = count();
+        auto *items = arena_.makeArray<const RawExpr *>(n);
+        for (size_t i = 0; i < n; ++i) {
+            items[i] = node();
+        }
+        return Span<const RawExpr *>{items, n};
+    }
+
+    const RawExpr *node() {
+        using Kind = RawExpr::Kind;
+        uint8_t tag = byte();
+        switch (tag) {
+        case kVar: {
+            auto *e = make<RawExpr::Var>(Kind::Var);
+            e->var = var();
+            return e;
+        }
+        case kFunc: {
+            size_t n = count();
+            auto *params = arena_.makeArray<Var>(n);
+            for (size_t i = 0; i < n; ++i) {
+                params[i] = var();
+            }
+            auto *e = make<RawExpr::Func>(Kind::Func);
+            e->params = Span<Var>{params, n};
+            e->body = node();
+            return e;
+        }
+        case kApp: {
+            auto *e = make<RawExpr::App>(Kind::App);
+            e->func = node();
+            e->arg = node();
+            return e;
+        }
+        case kLet:
+        case kLetRec:
+        case kLetCs:
+        case kLetRecMemo: {
+            auto *e = make<RawExpr::Let>(tag == kLet     ? Kind::Let
+                                         : tag == kLetCs ? Kind::LetCs
+                                                         : Kind::LetRec);
+            e->memo = tag == kLetRecMemo;
+            e->param = var();
+            e->expr = node();
+            e->body = node();
+            return e;
+        }
+        case kIntLit: {
+            auto *e = make<RawExpr::IntLit>(Kind::IntLit);
+            e->value = unzigzag(uint());
+            return e;
+        }
+        case kFalse:
+        case kTrue: {
+            auto *e = make<RawExpr::BoolLit>(Kind::BoolLit);
+            e->value = tag == kTrue;
+            return e;
+        }
+        case kBinOp:
+            return binary<RawExpr::BinOp>(Kind::BinOp, static_cast<BinOp>(op(kBinOps)));
+        case kShortCircuitOp:
+            return binary<RawExpr::ShortCircuitOp>(
+                Kind::ShortCircuitOp, static_cast<ShortCircuitOp>(op(kShortCircuitOps)));
+        case kUniOp: {
+            auto *e = make<RawExpr::UniOp>(Kind::UniOp);
+            e->op = static_cast<UniOp>(op(kUniOps));
+            e->expr = node();
+            return e;
+        }
+        case kIf: {
+            auto *e = make<RawExpr::If>(Kind::If);
+            e->cond = node();
+            e->thenBranch = node();
+            e->elseBranch = node();
+            return e;
+        }
+        case kPrimOp: {
+            uint32_t i = op(kPrimOps);
+            if (i < kBinOps) {
+                return binary<RawExpr::BinOp>(Kind::BinOp, static_cast<BinOp>(i));
+            }
+            switch (i) {
+            case kBinOps:
+                return binary<RawExpr::BinOp>(Kind::BinOp, BinOp::Eq);
+            case kBinOps + 1:
+                return binary<RawExpr::BinOp>(Kind::BinOp, BinOp::Ne);
+            case kBinOps + 2:
+                return binary<RawExpr::ShortCircuitOp>(Kind::ShortCircuitOp, ShortCircuitOp::And);
+            default:
+                return binary<RawExpr::ShortCircuitOp>(Kind::ShortCircuitOp, ShortCircuitOp::Or);
+            }
+        }
+        case kPrimNot: {
+            auto *e = make<RawExpr::UniOp>(Kind::UniOp);
+            e->op = UniOp::Not;
+            e->expr = node();
+            return e;
+        }
+        case kQuote:
+        case kGenLet: {
+            auto *e = make<RawExpr::Quote>(tag == kQuote ? Kind::Quote : Kind::GenLet);
+            e->expr = node();
+            return e;
+        }
+        case kSplice: {
+            auto *e = make<RawExpr::Splice>(Kind::Splice);
+            e->shift = static_cast<int>(uint());
+            e->expr = node();
+            return e;
+        }
+        case kArrayOp: {
+            auto *e = make<RawExpr::ArrayOp>(Kind::ArrayOp);
+            e->op = static_cast<ArrayOp>(op(kArrayOps));
+            e->args = nodes();
+            return e;
+        }
+        case kTuple: {
+            auto *e = make<RawExpr::Tuple>(Kind::Tuple);
+            e->elements = nodes();
+            return e;
+        }
+        case kProj: {
+            auto *e = make<RawExpr::Proj>(Kind::Proj);
+            e->index = uint();
+            e->tuple = node();
+            return e;
+        }
+        case kShared: {
+            size_t i = shared_.size();
+            shared_.push_back(nullptr);
+            const RawExpr *e = node();
+            shared_[i] = e;
+            return e;
+        }
+        // A node cannot refer to itself or to one that comes later.
+        case kReference: {
+            uint32_t i = uint();
+            if (i >= shared_.size() || shared_[i] == nullptr) {
+                fail(SerializeError::Kind::BadReference, i);
+            }
+            return shared_[i];
+        }
+        default:
+            fail(SerializeError::Kind::BadTag, tag);
+        }
+    }
+
+    const uint8_t *data_;
+    size_t pos_ = 0;
+    size_t limit_;
+    Arena &arena_;
+    std::vector<Symbol> names_;
+    std::vector<const RawExpr *> shared_;
+};
+
+} // namespace
+
+std::string toString(const SerializeError &e) {
+    switch (e.kind) {
+    case SerializeError::Kind::BadHeader:
+        return "not lamgamma code, or of a newer version";
+    case SerializeError::Kind::Truncated:
+        return "truncated code";
+    case SerializeError::Kind::BadNumber:
+        return "malformed number in code";
+    case SerializeError::Kind::BadTag:
+        return "unknown tag " + std::to_string(e.value) + " in code";
+    case SerializeError::Kind::BadName:
+        return "unknown name " + std::to_string(e.value) + " in code";
+    case SerializeError::Kind::BadReference:
+        return "unknown shared node " + std::to_string(e.value) + " in code";
+    case SerializeError::Kind::TrailingBytes:
+        return "trailing bytes after code";
+    }
+    return "malformed code";
+}
+
+std::vector<uint8_t> encode(const RawExpr *code) { return Encoder(code).run(code); }
+
+Result<const RawExpr *, SerializeError> decode(const uint8_t *data, size_t size, Arena &arena) {
+    try {
+        return Decoder(data, size, arena).run();
+    } catch (const Malformed &m) {
+        return fail(m.error);
+    }
+}
+
+} // namespace lamgamma
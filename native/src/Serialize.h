@@ -0,0 +1,53 @@
+#ifndef LAMGAMMA_SERIALIZE_H_
+#define LAMGAMMA_SERIALIZE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Arena.h"
+#include "RawExpr.h"
+#include "Result.h"
+
+namespace lamgamma {
+
+// Native counterpart of Serialize.res: the binary encoding of code values,
+// so that code generated by the playground can be stored, mapped into
+// memory and run by the native engine without printing and reparsing it.
+// The format is described in Serialize.res.
+//
+// The typed operations of the playground's evaluator (tags 12 and 13) are
+// read as their untyped counterparts, which the VM specializes by itself.
+
+constexpr uint8_t kSerializeVersion = 3;
+
+struct SerializeError {
+    enum class Kind : uint8_t {
+        BadHeader,
+        Truncated,
+        BadNumber,
+        BadTag,       // value is the tag, or the operator index
+        BadName,      // value is the name index
+        BadReference, // value is the shared node number
+        TrailingBytes,
+    };
+
+    Kind kind;
+    uint32_t value = 0;
+};
+
+std::string toString(const SerializeError &e);
+
+// Every native RawExpr has an encoding, so unlike Serialize.encode this
+// cannot fail.
+std::vector<uint8_t> encode(const RawExpr *code);
+
+// Decodes the size bytes at data, which may be a view into a larger buffer
+// such as a mapped file. Nodes are allocated in arena; names are interned
+// straight from the bytes, each once.
+Result<const RawExpr *, SerializeError> decode(const uint8_t *data, size_t size, Arena &arena);
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_SERIALIZE_H_
@@ -0,0 +1,150 @@
+// Cases for the native encoding, mirroring
+// playground/src/interpreter/Serialize.res.spec.ts where the two overlap.
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <tree_sitter/api.h>
+
+#include "Arena.h"
+#include "Frontend.h"
+#include "Printer.h"
+#include "RawExpr.h"
+#include "Serialize.h"
+#include "SyntaxNodeParser.h"
+#include "tree-sitter-lamgamma_parser.h"
+
+namespace lamgamma {
+namespace {
+
+class SerializeSpec : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        parser_ = ts_parser_new();
+        ts_parser_set_language(parser_, tree_sitter_lamgamma_parser());
+    }
+
+    void TearDown() override {
+        for (TSTree *tree : trees_) {
+            ts_tree_delete(tree);
+        }
+        ts_parser_delete(parser_);
+    }
+
+    // Assume that parse always succeeds
+    const RawExpr *parse(const std::string &input) {
+        sources_.push_back(input);
+        const std::string &source = sources_.back();
+        TSTree *tree = ts_parser_parse_string(parser_, nullptr, source.data(), source.size());
+        trees_.push_back(tree);
+        SyntaxNodeParser syntaxNodeParser(arena_, source);
+        return stripTypeInfo(syntaxNodeParser.parseSourceFileNode(ts_tree_root_node(tree)).value(),
+                             arena_);
+    }
+
+    Result<const RawExpr *, SerializeError> decode(const std::vector<uint8_t> &bytes) {
+        return lamgamma::decode(bytes.data(), bytes.size(), arena_);
+    }
+
+    TSParser *parser_ = nullptr;
+    Arena arena_;
+
+  private:
+    std::vector<std::string> sources_;
+    std::vector<TSTree *> trees_;
+};
+
+TEST_F(SerializeSpec, RoundTripsEveryKindOfNode) {
+    for (const char *code : {
+             "(x, y) => { if x < y && !false then x - 7 else y mod 2 }",
+             "let rec f = (n) => { f (n - 1) } in f 2147483647",
+             "let rec memo f = (n) => { f (n - 1) } in f 2",
+             "let x = true || false in `{ ~{ `{ 1 } } + ~1{ y } }",
+             "let cs z = 1 in genlet `{ z }",
+             "Array.fold f 0 (Array.map g (Array.init (Array.length [| |]) ((i) => { [| 1, i "
+             "|].(i) })))",
+             "let p = (1, (true, x)) in p.1.0 || (p, 2).0.0 == 1",
+         }) {
+        const RawExpr *expr = parse(code);
+        auto decoded = decode(encode(expr));
+        ASSERT_TRUE(decoded.isOk()) << code;
+        EXPECT_EQ(toString(decoded.value()), toString(expr)) << code;
+    }
+}
+
+TEST_F(SerializeSpec, RoundTripsNegativeLiterals) {
+    for (int32_t i : {-1, -64, INT32_MIN, INT32_MAX}) {
+        auto *lit = arena_.make<RawExpr::IntLit>();
+        lit->kind = RawExpr::Kind::IntLit;
+        lit->value = i;
+        auto decoded = decode(encode(lit));
+        ASSERT_TRUE(decoded.isOk()) << i;
+        EXPECT_EQ(decoded.value()->as<RawExpr::IntLit>().value, i);
+    }
+}
+
+TEST_F(SerializeSpec, RestoresSharing) {
+    const RawExpr *shared = parse("x * y + 1");
+    auto *app = arena_.make<RawExpr::App>();
+    app->kind = RawExpr::Kind::App;
+    app->func = shared;
+    app->arg = shared;
+    std::vector<uint8_t> bytes = encode(app);
+    EXPECT_LT(bytes.size(), encode(parse("(x * y + 1) (x * y + 1)")).size());
+    auto decoded = decode(bytes);
+    ASSERT_TRUE(decoded.isOk());
+    const auto &decodedApp = decoded.value()->as<RawExpr::App>();
+    EXPECT_EQ(decodedApp.func, decodedApp.arg);
+    EXPECT_EQ(toString(decoded.value()), toString(app));
+}
+
+TEST_F(SerializeSpec, ReadsTheTypedOperationsOfThePlayground) {
+    // IntSub, BoolEq and BoolAnd, and PrimNot, in a version 2 encoding.
+    EXPECT_EQ(toString(decode({0x4c, 0x47, 0x02, 0x00, 12, 1, 5, 4, 5, 1}).value()), "(2 - -1)");
+    EXPECT_EQ(toString(decode({0x4c, 0x47, 0x02, 0x00, 12, 11, 7, 6}).value()),
+              "(true == false)");
+    EXPECT_EQ(toString(decode({0x4c, 0x47, 0x02, 0x00, 12, 13, 7, 13, 6}).value()),
+              "(true && (! false))");
+}
+
+TEST_F(SerializeSpec, RejectsMalformedInput) {
+    std::vector<uint8_t> bytes = encode(parse("let x = 1 in x + 2"));
+    EXPECT_EQ(lamgamma::decode(bytes.data(), bytes.size() - 1, arena_).error().kind,
+              SerializeError::Kind::Truncated);
+    EXPECT_EQ(decode({0x4c, 0x47, 0x09, 0x00, 0x05, 0x00}).error().kind,
+              SerializeError::Kind::BadHeader);
+    EXPECT_EQ(decode({0x4c, 0x47, 0x01, 0x00, 0x63}).error().kind, SerializeError::Kind::BadTag);
+    EXPECT_EQ(decode({0x4c, 0x47, 0x01, 0x00, 0x00, 0x00}).error().kind,
+              SerializeError::Kind::BadName);
+    EXPECT_EQ(decode({0x4c, 0x47, 0x02, 0x00, 0x13, 0x00}).error().kind,
+              SerializeError::Kind::BadReference);
+    EXPECT_EQ(decode({0x4c, 0x47, 0x01, 0x00, 0x06, 0x06}).error().kind,
+              SerializeError::Kind::TrailingBytes);
+    EXPECT_EQ(decode({0x4c, 0x47, 0x01, 0x00, 0x05, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01})
+                  .error()
+                  .kind,
+              SerializeError::Kind::BadNumber);
+}
+
+TEST_F(SerializeSpec, RunsSavedPrograms) {
+    std::string path = ::testing::TempDir() + "lamgamma-serialize-spec.lg";
+    const char *genpow = R"(
+      let rec pow1 = (n, xq) => {
+        if n == 0 then `{ 1 } else `{ ~{ xq } * ~{ pow1 (n-1) xq } }
+      } in
+      `{ (x) => { ~{ pow1 5 `{ x } } } }
+    )";
+    ASSERT_EQ(Frontend::save("`{ (x) => { x * x + 1 } }", parser_, path.c_str()), "");
+    std::string output;
+    EXPECT_EQ(Frontend::load(path.c_str(), {7}, &output), "");
+    EXPECT_EQ(output, "50");
+    ASSERT_EQ(Frontend::save(genpow, parser_, path.c_str()), "");
+    EXPECT_EQ(Frontend::load(path.c_str(), {}, &output), "cannot print generated code");
+    std::remove(path.c_str());
+    EXPECT_EQ(Frontend::load(path.c_str(), {}, &output), "cannot read " + path);
+}
+
+} // namespace
+} // namespace lamgamma
@@ -0,0 +1,37 @@
+#include "Symbol.h"
+
+#include <deque>
+#include <unordered_map>
+
+namespace lamgamma {
+
+namespace {
+
+struct SymbolTable {
+    // Id 0 is the empty name, so a default-constructed Symbol is valid.
+    std::deque<std::string> names{""};
+    std::unordered_map<std::string_view, uint32_t> ids{{names.front(), 0}};
+};
+
+SymbolTable &table() {
+    static SymbolTable t;
+    return t;
+}
+
+} // namespace
+
+Symbol Symbol::intern(std::string_view name) {
+    SymbolTable &t = table();
+    auto it = t.ids.find(name);
+    if (it != t.ids.end()) {
+        return Symbol(it->second);
+    }
+    uint32_t id = static_cast<uint32_t>(t.names.size());
+    t.names.emplace_back(name);
+    t.ids.emplace(t.names.back(), id);
+    return Symbol(id);
+}
+
+const std::string &Symbol::name() const { return table().names[id_]; }
+
+} // namespace lamgamma
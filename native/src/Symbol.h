@@ -0,0 +1,34 @@
+#ifndef LAMGAMMA_SYMBOL_H_
+#define LAMGAMMA_SYMBOL_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace lamgamma {
+
+// An interned name. Symbols compare by id, so variables and classifiers can
+// be looked up without string comparisons.
+class Symbol {
+  public:
+    Symbol() = default;
+
+    static Symbol intern(std::string_view name);
+
+    const std::string &name() const;
+    uint32_t id() const { return id_; }
+
+    bool operator==(Symbol other) const { return id_ == other.id_; }
+    bool operator!=(Symbol other) const { return id_ != other.id_; }
+    // Orders by name, like Pervasives.compare on the underlying strings.
+    bool operator<(Symbol other) const { return name() < other.name(); }
+
+  private:
+    explicit Symbol(uint32_t id) : id_(id) {}
+
+    uint32_t id_ = 0;
+};
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_SYMBOL_H_
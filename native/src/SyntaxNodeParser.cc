@@ -0,0 +1,770 @@
+#include "SyntaxNodeParser.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace lamgamma {
+
+namespace {
+
+bool isType(TSNode node, const char *type) { return std::strcmp(ts_node_type(node), type) == 0; }
+
+std::optional<TSNode> getNamedChildForFieldName(TSNode node, const char *fieldName) {
+    // A field on a hidden rule such as `seq('(', $._expression, ')')` is set
+    // on every child the rule produced, so only the named one counts.
+    std::optional<TSNode> found;
+    uint32_t count = ts_node_child_count(node);
+    for (uint32_t i = 0; i < count; ++i) {
+        const char *name = ts_node_field_name_for_child(node, i);
+        if (name == nullptr || std::strcmp(name, fieldName) != 0) {
+            continue;
+        }
+        TSNode child = ts_node_child(node, i);
+        if (!ts_node_is_named(child)) {
+            continue;
+        }
+        if (found) {
+            throw MalformedNode(std::string("More than one named child with field name ") +
+                                fieldName);
+        }
+        found = child;
+    }
+    return found;
+}
+
+TSNode getNamedChildForFieldNameUnsafe(TSNode node, const char *fieldName) {
+    auto child = getNamedChildForFieldName(node, fieldName);
+    if (!child) {
+        throw MalformedNode(std::string("No named child with field name ") + fieldName);
+    }
+    return *child;
+}
+
+// The named children with field name fieldName, in order, for fields that
+// repeat such as the elements of an array or a tuple.
+std::vector<TSNode> getNamedChildrenForFieldName(TSNode node, const char *fieldName) {
+    std::vector<TSNode> children;
+    uint32_t count = ts_node_child_count(node);
+    for (uint32_t i = 0; i < count; ++i) {
+        const char *name = ts_node_field_name_for_child(node, i);
+        TSNode child = ts_node_child(node, i);
+        if (name != nullptr && std::strcmp(name, fieldName) == 0 && ts_node_is_named(child)) {
+            children.push_back(child);
+        }
+    }
+    return children;
+}
+
+TSNode namedChildUnsafe(TSNode node, uint32_t idx) {
+    TSNode child = ts_node_named_child(node, idx);
+    if (ts_node_is_null(child)) {
+        throw MalformedNode("namedChild does not exist");
+    }
+    return child;
+}
+
+int32_t parseInt(std::string_view text) {
+    std::string s(text);
+    char *end = nullptr;
+    long long value = std::strtoll(s.c_str(), &end, 10);
+    if (s.empty() || *end != '\0') {
+        throw MalformedNode("Failed to parse int from string");
+    }
+    return static_cast<int32_t>(value);
+}
+
+const std::unordered_map<std::string_view, BinOp> &binOpMapping() {
+    static const std::unordered_map<std::string_view, BinOp> mapping = {
+        {"add", BinOp::Add}, {"sub", BinOp::Sub}, {"mult", BinOp::Mul}, {"div", BinOp::Div},
+        {"mod", BinOp::Mod}, {"eq", BinOp::Eq},   {"ne", BinOp::Ne},    {"lt", BinOp::Lt},
+        {"le", BinOp::Le},   {"gt", BinOp::Gt},   {"ge", BinOp::Ge},
+    };
+    return mapping;
+}
+
+// The array operation of each node type and the fields of its operands, in
+// order. The elements of an array literal are all "element" fields.
+struct ArrayForm {
+    ArrayOp op;
+    std::vector<const char *> fields;
+};
+
+const std::unordered_map<std::string_view, ArrayForm> &arrayOpMapping() {
+    static const std::unordered_map<std::string_view, ArrayForm> mapping = {
+        {"array", {ArrayOp::Make, {}}},
+        {"array_length", {ArrayOp::Length, {"array"}}},
+        {"array_get", {ArrayOp::Get, {"array", "index"}}},
+        {"array_init", {ArrayOp::Init, {"size", "func"}}},
+        {"array_map", {ArrayOp::Map, {"func", "array"}}},
+        {"array_fold", {ArrayOp::Fold, {"func", "init", "array"}}},
+    };
+    return mapping;
+}
+
+// Deep copy of Exprs into another arena, for rebuilding ExprCache's. An Expr
+// reached twice, as a cached node and as the child of another, is copied
+// once, so the copies share like the originals.
+class ExprCopier {
+  public:
+    explicit ExprCopier(Arena &arena) : arena_(arena) {}
+
+    const Expr *copy(const Expr *expr) {
+        auto it = copies_.find(expr);
+        if (it != copies_.end()) {
+            return it->second;
+        }
+        const Expr *copied = copyNode(expr);
+        copies_.emplace(expr, copied);
+        return copied;
+    }
+
+  private:
+    template <class T>
+    T *clone(const Expr *expr) {
+        return arena_.make<T>(expr->as<T>());
+    }
+
+    const Typ *copyTyp(const Typ *typ) {
+        return typ != nullptr ? Typ::copy(arena_, typ) : nullptr;
+    }
+
+    Param copyParam(Param param) {
+        param.typ = copyTyp(param.typ);
+        return param;
+    }
+
+    Span<const Expr *> copyExprs(Span<const Expr *> exprs) {
+        auto *data = arena_.makeArray<const Expr *>(exprs.size);
+        for (size_t i = 0; i < exprs.size; ++i) {
+            data[i] = copy(exprs[i]);
+        }
+        return Span<const Expr *>{data, exprs.size};
+    }
+
+    const Expr *copyNode(const Expr *expr) {
+        switch (expr->kind) {
+        case Expr::Kind::Var:
+            return clone<Expr::Var>(expr);
+        case Expr::Kind::IntLit:
+            return clone<Expr::IntLit>(expr);
+        case Expr::Kind::BoolLit:
+            return clone<Expr::BoolLit>(expr);
+        case Expr::Kind::Func: {
+            auto *e = clone<Expr::Func>(expr);
+            auto *params = arena_.makeArray<Param>(e->params.size);
+            for (size_t i = 0; i < e->params.size; ++i) {
+                params[i] = copyParam(e->params[i]);
+            }
+            e->params = Span<Param>{params, e->params.size};
+            e->returnType = copyTyp(e->returnType);
+            e->body = copy(e->body);
+            return e;
+        }
+        case Expr::Kind::App: {
+            auto *e = clone<Expr::App>(expr);
+            e->func = copy(e->func);
+            e->arg = copy(e->arg);
+            return e;
+        }
+        case Expr::Kind::Let:
+        case Expr::Kind::LetRec:
+        case Expr::Kind::LetCs: {
+            auto *e = clone<Expr::Let>(expr);
+            e->param = copyParam(e->param);
+            e->expr = copy(e->expr);
+            e->body = copy(e->body);
+            return e;
+        }
+        case Expr::Kind::BinOp: {
+            auto *e = clone<Expr::BinOp>(expr);
+            e->left = copy(e->left);
+            e->right = copy(e->right);
+            return e;
+        }
+        case Expr::Kind::ShortCircuitOp: {
+            auto *e = clone<Expr::ShortCircuitOp>(expr);
+            e->left = copy(e->left);
+            e->right = copy(e->right);
+            return e;
+        }
+        case Expr::Kind::UniOp: {
+            auto *e = clone<Expr::UniOp>(expr);
+            e->expr = copy(e->expr);
+            return e;
+        }
+        case Expr::Kind::If: {
+            auto *e = clone<Expr::If>(expr);
+            e->cond = copy(e->cond);
+            e->thenBranch = copy(e->thenBranch);
+            e->elseBranch = copy(e->elseBranch);
+            return e;
+        }
+        case Expr::Kind::ArrayOp: {
+            auto *e = clone<Expr::ArrayOp>(expr);
+            e->args = copyExprs(e->args);
+            return e;
+        }
+        case Expr::Kind::Tuple: {
+            auto *e = clone<Expr::Tuple>(expr);
+            e->elements = copyExprs(e->elements);
+            return e;
+        }
+        case Expr::Kind::Proj: {
+            auto *e = clone<Expr::Proj>(expr);
+            e->tuple = copy(e->tuple);
+            return e;
+        }
+        case Expr::Kind::Quote: {
+            auto *e = clone<Expr::Quote>(expr);
+            e->expr = copy(e->expr);
+            return e;
+        }
+        case Expr::Kind::Splice: {
+            auto *e = clone<Expr::Splice>(expr);
+            e->expr = copy(e->expr);
+            return e;
+        }
+        case Expr::Kind::GenLet: {
+            auto *e = clone<Expr::GenLet>(expr);
+            e->expr = copy(e->expr);
+            return e;
+        }
+        case Expr::Kind::ClsAbs: {
+            auto *e = clone<Expr::ClsAbs>(expr);
+            e->body = copy(e->body);
+            return e;
+        }
+        case Expr::Kind::ClsApp: {
+            auto *e = clone<Expr::ClsApp>(expr);
+            e->func = copy(e->func);
+            return e;
+        }
+        }
+        throw MalformedNode("unknown Expr kind");
+    }
+
+    Arena &arena_;
+    std::unordered_map<const Expr *, const Expr *> copies_;
+};
+
+} // namespace
+
+// ---- ExprCache ----
+
+const Expr *ExprCache::find(const void *syntaxId) {
+    auto it = exprs_.find(syntaxId);
+    if (it == exprs_.end()) {
+        return nullptr;
+    }
+    ++reused_;
+    return it->second;
+}
+
+void ExprCache::store(const void *syntaxId, const Expr *expr) {
+    exprs_[syntaxId] = expr;
+    ++allocated_;
+    ++built_;
+}
+
+Classifier ExprCache::classifier(const void *syntaxId) {
+    auto it = classifiers_.find(syntaxId);
+    if (it != classifiers_.end()) {
+        return it->second;
+    }
+    Classifier cls = source_.fresh();
+    classifiers_.emplace(syntaxId, cls);
+    return cls;
+}
+
+void ExprCache::invalidate(const void *syntaxId) { exprs_.erase(syntaxId); }
+
+void ExprCache::retain(const void *syntaxId) {
+    auto expr = exprs_.find(syntaxId);
+    if (expr != exprs_.end()) {
+        retainedExprs_.emplace(*expr);
+    }
+    auto cls = classifiers_.find(syntaxId);
+    if (cls != classifiers_.end()) {
+        retainedClassifiers_.emplace(*cls);
+    }
+}
+
+void ExprCache::sweep() {
+    exprs_.swap(retainedExprs_);
+    retainedExprs_.clear();
+    classifiers_.swap(retainedClassifiers_);
+    retainedClassifiers_.clear();
+    // Exprs of dropped nodes stay in the arena until it is rebuilt; as in
+    // TypingMemo, do so once they are the majority.
+    if (allocated_ > 2 * exprs_.size() + 1024) {
+        Arena arena;
+        ExprCopier copier(arena);
+        for (auto &expr : exprs_) {
+            expr.second = copier.copy(expr.second);
+        }
+        arena_ = std::move(arena);
+        allocated_ = exprs_.size();
+    }
+}
+
+void ExprCache::clear() {
+    exprs_.clear();
+    retainedExprs_.clear();
+    classifiers_.clear();
+    retainedClassifiers_.clear();
+    arena_ = Arena();
+    allocated_ = 0;
+}
+
+// ---- SyntaxNodeParser ----
+
+bool SyntaxNodeParser::findParseError(TSNode node, ParseError *error) {
+    if (ts_node_is_error(node)) {
+        *error = ParseError{ParseError::Kind::SyntaxError, ts_node_start_point(node),
+                            ts_node_end_point(node), ""};
+        return true;
+    }
+    if (ts_node_is_missing(node)) {
+        *error = ParseError{ParseError::Kind::MissingNodeError, ts_node_start_point(node),
+                            ts_node_end_point(node), ts_node_type(node)};
+        return true;
+    }
+    if (!ts_node_has_error(node)) {
+        return false;
+    }
+    uint32_t count = ts_node_child_count(node);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (findParseError(ts_node_child(node, i), error)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+MetaData SyntaxNodeParser::extractMetadata(TSNode node) {
+    TSPoint start = ts_node_start_point(node);
+    TSPoint end = ts_node_end_point(node);
+    return MetaData{{start.row, start.column}, {end.row, end.column}, node.id};
+}
+
+std::string_view SyntaxNodeParser::text(TSNode node) const {
+    uint32_t start = ts_node_start_byte(node);
+    uint32_t end = ts_node_end_byte(node);
+    return source_.substr(start, end - start);
+}
+
+Var SyntaxNodeParser::parseVar(TSNode node) const {
+    if (!isType(node, "identifier")) {
+        throw MalformedNode(std::string("Expected identifier node, got ") + ts_node_type(node));
+    }
+    return Var::raw(text(node));
+}
+
+Classifier SyntaxNodeParser::parseClassifier(TSNode node) const {
+    if (!isType(node, "classifier")) {
+        throw MalformedNode(std::string("Expected classifier node, got ") + ts_node_type(node));
+    }
+    std::string_view name = text(node);
+    if (name == "!") {
+        return Classifier::initial();
+    }
+    return Classifier::named(Symbol::intern(name));
+}
+
+Result<const Typ *, ParseError> SyntaxNodeParser::parseTypeNode(TSNode node) {
+    if (isType(node, "int_type")) {
+        return Typ::intType();
+    }
+    if (isType(node, "bool_type")) {
+        return Typ::boolType();
+    }
+    if (isType(node, "array_type")) {
+        return Typ::intArrayType();
+    }
+    if (isType(node, "func_type")) {
+        auto paramType = parseTypeNode(getNamedChildForFieldNameUnsafe(node, "param"));
+        if (!paramType) {
+            return paramType;
+        }
+        auto returnType = parseTypeNode(getNamedChildForFieldNameUnsafe(node, "return"));
+        if (!returnType) {
+            return returnType;
+        }
+        return Typ::func(arena_, paramType.value(), returnType.value());
+    }
+    if (isType(node, "tuple_type")) {
+        std::vector<const Typ *> elements;
+        for (TSNode child : getNamedChildrenForFieldName(node, "element")) {
+            auto element = parseTypeNode(child);
+            if (!element) {
+                return element;
+            }
+            elements.push_back(element.value());
+        }
+        return Typ::tuple(arena_, elements);
+    }
+    if (isType(node, "code_type")) {
+        auto typ = parseTypeNode(getNamedChildForFieldNameUnsafe(node, "type"));
+        Classifier cls = parseClassifier(getNamedChildForFieldNameUnsafe(node, "classifier"));
+        if (!typ) {
+            return typ;
+        }
+        return Typ::code(arena_, cls, typ.value());
+    }
+    if (isType(node, "clsabs_type")) {
+        TSNode param = getNamedChildForFieldNameUnsafe(node, "param");
+        Classifier cls = parseClassifier(getNamedChildForFieldNameUnsafe(param, "cls"));
+        Classifier base = parseClassifier(getNamedChildForFieldNameUnsafe(param, "base"));
+        auto body = parseTypeNode(getNamedChildForFieldNameUnsafe(node, "type"));
+        if (!body) {
+            return body;
+        }
+        return Typ::clsAbs(arena_, cls, base, body.value());
+    }
+    throw MalformedNode(std::string("Unknown node type for type node: ") + ts_node_type(node));
+}
+
+Result<Param, ParseError> SyntaxNodeParser::parseParamNode(TSNode node) {
+    if (!isType(node, "param")) {
+        throw MalformedNode(std::string("Expected param node, got ") + ts_node_type(node));
+    }
+    Param param;
+    param.var = parseVar(getNamedChildForFieldNameUnsafe(node, "var"));
+    if (auto typeNode = getNamedChildForFieldName(node, "type")) {
+        auto typ = parseTypeNode(*typeNode);
+        if (!typ) {
+            return fail(typ.error());
+        }
+        param.typ = typ.value();
+    }
+    if (auto clsNode = getNamedChildForFieldName(node, "classifier")) {
+        param.cls = parseClassifier(*clsNode);
+    } else {
+        param.cls = cache_ != nullptr ? cache_->classifier(node.id) : classifiers_.fresh();
+    }
+    return param;
+}
+
+Result<Span<Param>, ParseError> SyntaxNodeParser::parseParamsNode(TSNode node) {
+    if (!isType(node, "params")) {
+        throw MalformedNode(std::string("Expected params node, got ") + ts_node_type(node));
+    }
+    uint32_t count = ts_node_named_child_count(node);
+    Param *params = arena_.makeArray<Param>(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto param = parseParamNode(namedChildUnsafe(node, i));
+        if (!param) {
+            return fail(param.error());
+        }
+        params[i] = param.value();
+    }
+    return Span<Param>{params, count};
+}
+
+Result<const Expr *, ParseError> SyntaxNodeParser::parseExprNode(TSNode node) {
+    if (cache_ == nullptr) {
+        return buildExprNode(node);
+    }
+    if (const Expr *e = cache_->find(node.id)) {
+        return e;
+    }
+    auto e = buildExprNode(node);
+    if (e) {
+        cache_->store(node.id, e.value());
+    }
+    return e;
+}
+
+Result<const Expr *, ParseError> SyntaxNodeParser::buildExprNode(TSNode node) {
+    using Kind = Expr::Kind;
+    std::string_view type = ts_node_type(node);
+
+    if (type == "number") {
+        auto *e = make<Expr::IntLit>(Kind::IntLit, node);
+        e->value = parseInt(text(node));
+        return e;
+    }
+
+    if (type == "boolean") {
+        std::string_view t = text(node);
+        if (t != "true" && t != "false") {
+            throw MalformedNode("Boolean node has invalid text: " + std::string(t));
+        }
+        auto *e = make<Expr::BoolLit>(Kind::BoolLit, node);
+        e->value = t == "true";
+        return e;
+    }
+
+    auto binOp = binOpMapping().find(type);
+    if (binOp != binOpMapping().end()) {
+        auto left = parseExprNode(getNamedChildForFieldNameUnsafe(node, "left"));
+        if (!left) {
+            return left;
+        }
+        auto right = parseExprNode(getNamedChildForFieldNameUnsafe(node, "right"));
+        if (!right) {
+            return right;
+        }
+        auto *e = make<Expr::BinOp>(Kind::BinOp, node);
+        e->op = binOp->second;
+        e->left = left.value();
+        e->right = right.value();
+        return e;
+    }
+
+    auto arrayOp = arrayOpMapping().find(type);
+    if (arrayOp != arrayOpMapping().end()) {
+        std::vector<TSNode> children;
+        if (arrayOp->second.op == ArrayOp::Make) {
+            children = getNamedChildrenForFieldName(node, "element");
+        } else {
+            for (const char *field : arrayOp->second.fields) {
+                children.push_back(getNamedChildForFieldNameUnsafe(node, field));
+            }
+        }
+        auto **args = arena_.makeArray<const Expr *>(children.size());
+        for (size_t i = 0; i < children.size(); ++i) {
+            auto arg = parseExprNode(children[i]);
+            if (!arg) {
+                return arg;
+            }
+            args[i] = arg.value();
+        }
+        auto *e = make<Expr::ArrayOp>(Kind::ArrayOp, node);
+        e->op = arrayOp->second.op;
+        e->args = Span<const Expr *>{args, children.size()};
+        return e;
+    }
+
+    if (type == "tuple") {
+        std::vector<TSNode> children = getNamedChildrenForFieldName(node, "element");
+        auto **elements = arena_.makeArray<const Expr *>(children.size());
+        for (size_t i = 0; i < children.size(); ++i) {
+            auto element = parseExprNode(children[i]);
+            if (!element) {
+                return element;
+            }
+            elements[i] = element.value();
+        }
+        auto *e = make<Expr::Tuple>(Kind::Tuple, node);
+        e->elements = Span<const Expr *>{elements, children.size()};
+        return e;
+    }
+
+    if (type == "tuple_get") {
+        auto tuple = parseExprNode(getNamedChildForFieldNameUnsafe(node, "tuple"));
+        if (!tuple) {
+            return tuple;
+        }
+        auto *e = make<Expr::Proj>(Kind::Proj, node);
+        e->tuple = tuple.value();
+        e->index = static_cast<uint32_t>(parseInt(text(getNamedChildForFieldNameUnsafe(node, "index"))));
+        return e;
+    }
+
+    if (type == "and" || type == "or") {
+        auto left = parseExprNode(getNamedChildForFieldNameUnsafe(node, "left"));
+        if (!left) {
+            return left;
+        }
+        auto right = parseExprNode(getNamedChildForFieldNameUnsafe(node, "right"));
+        if (!right) {
+            return right;
+        }
+        auto *e = make<Expr::ShortCircuitOp>(Kind::ShortCircuitOp, node);
+        e->op = type == "and" ? ShortCircuitOp::And : ShortCircuitOp::Or;
+        e->left = left.value();
+        e->right = right.value();
+        return e;
+    }
+
+    if (type == "not") {
+        if (ts_node_named_child_count(node) != 1) {
+            throw MalformedNode("not node must have exactly one named child");
+        }
+        auto expr = parseExprNode(namedChildUnsafe(node, 0));
+        if (!expr) {
+            return expr;
+        }
+        auto *e = make<Expr::UniOp>(Kind::UniOp, node);
+        e->op = UniOp::Not;
+        e->expr = expr.value();
+        return e;
+    }
+
+    if (type == "ctrl_if") {
+        auto cond = parseExprNode(getNamedChildForFieldNameUnsafe(node, "cond"));
+        if (!cond) {
+            return cond;
+        }
+        auto thenBranch = parseExprNode(getNamedChildForFieldNameUnsafe(node, "then"));
+        if (!thenBranch) {
+            return thenBranch;
+        }
+        auto elseBranch = parseExprNode(getNamedChildForFieldNameUnsafe(node, "else"));
+        if (!elseBranch) {
+            return elseBranch;
+        }
+        auto *e = make<Expr::If>(Kind::If, node);
+        e->cond = cond.value();
+        e->thenBranch = thenBranch.value();
+        e->elseBranch = elseBranch.value();
+        return e;
+    }
+
+    if (type == "identifier") {
+        auto *e = make<Expr::Var>(Kind::Var, node);
+        e->var = parseVar(node);
+        return e;
+    }
+
+    if (type == "let" || type == "letrec" || type == "letcs") {
+        auto param = parseParamNode(getNamedChildForFieldNameUnsafe(node, "param"));
+        if (!param) {
+            return fail(param.error());
+        }
+        auto value = parseExprNode(getNamedChildForFieldNameUnsafe(node, "value"));
+        if (!value) {
+            return value;
+        }
+        auto body = parseExprNode(getNamedChildForFieldNameUnsafe(node, "body"));
+        if (!body) {
+            return body;
+        }
+        auto kind = type == "let" ? Kind::Let : type == "letrec" ? Kind::LetRec : Kind::LetCs;
+        auto *e = make<Expr::Let>(kind, node);
+        e->param = param.value();
+        e->expr = value.value();
+        e->body = body.value();
+        e->memo = getNamedChildForFieldName(node, "memo").has_value();
+        return e;
+    }
+
+    if (type == "lambda") {
+        auto params = parseParamsNode(getNamedChildForFieldNameUnsafe(node, "params"));
+        if (!params) {
+            return fail(params.error());
+        }
+        const Typ *returnType = nullptr;
+        if (auto returnNode = getNamedChildForFieldName(node, "return_type")) {
+            auto typ = parseTypeNode(*returnNode);
+            if (!typ) {
+                return fail(typ.error());
+            }
+            returnType = typ.value();
+        }
+        auto body = parseExprNode(getNamedChildForFieldNameUnsafe(node, "body"));
+        if (!body) {
+            return body;
+        }
+        auto *e = make<Expr::Func>(Kind::Func, node);
+        e->params = params.value();
+        e->returnType = returnType;
+        e->body = body.value();
+        return e;
+    }
+
+    if (type == "application") {
+        auto func = parseExprNode(getNamedChildForFieldNameUnsafe(node, "func"));
+        if (!func) {
+            return func;
+        }
+        auto arg = parseExprNode(getNamedChildForFieldNameUnsafe(node, "arg"));
+        if (!arg) {
+            return arg;
+        }
+        auto *e = make<Expr::App>(Kind::App, node);
+        e->func = func.value();
+        e->arg = arg.value();
+        return e;
+    }
+
+    if (type == "quote") {
+        std::optional<Classifier> cls;
+        if (auto clsNode = getNamedChildForFieldName(node, "classifier")) {
+            cls = parseClassifier(*clsNode);
+        }
+        auto expr = parseExprNode(getNamedChildForFieldNameUnsafe(node, "expr"));
+        if (!expr) {
+            return expr;
+        }
+        auto *e = make<Expr::Quote>(Kind::Quote, node);
+        e->cls = cls;
+        e->expr = expr.value();
+        return e;
+    }
+
+    if (type == "splice") {
+        const int defaultShift = 1;
+        int shift = defaultShift;
+        if (auto shiftNode = getNamedChildForFieldName(node, "shift")) {
+            shift = parseInt(text(*shiftNode));
+        }
+        auto expr = parseExprNode(getNamedChildForFieldNameUnsafe(node, "expr"));
+        if (!expr) {
+            return expr;
+        }
+        auto *e = make<Expr::Splice>(Kind::Splice, node);
+        e->shift = shift;
+        e->expr = expr.value();
+        return e;
+    }
+
+    if (type == "genlet") {
+        auto expr = parseExprNode(getNamedChildForFieldNameUnsafe(node, "expr"));
+        if (!expr) {
+            return expr;
+        }
+        auto *e = make<Expr::GenLet>(Kind::GenLet, node);
+        e->expr = expr.value();
+        return e;
+    }
+
+    if (type == "clsabs") {
+        TSNode param = getNamedChildForFieldNameUnsafe(node, "param");
+        Classifier cls = parseClassifier(getNamedChildForFieldNameUnsafe(param, "cls"));
+        Classifier base = parseClassifier(getNamedChildForFieldNameUnsafe(param, "base"));
+        auto body = parseExprNode(getNamedChildForFieldNameUnsafe(node, "body"));
+        if (!body) {
+            return body;
+        }
+        auto *e = make<Expr::ClsAbs>(Kind::ClsAbs, node);
+        e->cls = cls;
+        e->base = base;
+        e->body = body.value();
+        return e;
+    }
+
+    if (type == "clsapp") {
+        auto func = parseExprNode(getNamedChildForFieldNameUnsafe(node, "func"));
+        if (!func) {
+            return func;
+        }
+        Classifier arg = parseClassifier(getNamedChildForFieldNameUnsafe(node, "arg"));
+        auto *e = make<Expr::ClsApp>(Kind::ClsApp, node);
+        e->func = func.value();
+        e->arg = arg;
+        return e;
+    }
+
+    throw NotImplemented(std::string(type));
+}
+
+Result<const Expr *, ParseError> SyntaxNodeParser::parseSourceFileNode(TSNode node) {
+    ParseError error;
+    if (findParseError(node, &error)) {
+        return fail(error);
+    }
+    if (ts_node_named_child_count(node) != 1) {
+        throw MalformedNode("source_file must have exactly one named child");
+    }
+    if (!isType(node, "source_file")) {
+        throw MalformedNode(std::string("Expected source_file node, got ") + ts_node_type(node));
+    }
+    return parseExprNode(namedChildUnsafe(node, 0));
+}
+
+} // namespace lamgamma
@@ -0,0 +1,134 @@
+#ifndef LAMGAMMA_SYNTAXNODEPARSER_H_
+#define LAMGAMMA_SYNTAXNODEPARSER_H_
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <tree_sitter/api.h>
+
+#include "Arena.h"
+#include "Classifier.h"
+#include "Expr.h"
+#include "Result.h"
+#include "Typ.h"
+
+namespace lamgamma {
+
+// Native counterpart of SyntaxNodeParser.ParseError.t.
+struct ParseError {
+    enum class Kind : uint8_t { SyntaxError, MissingNodeError };
+
+    Kind kind;
+    TSPoint start;
+    TSPoint end;
+    std::string missing; // MissingNodeError
+};
+
+struct MalformedNode : std::runtime_error {
+    explicit MalformedNode(const std::string &msg) : std::runtime_error(msg) {}
+};
+
+struct NotImplemented : std::runtime_error {
+    explicit NotImplemented(const std::string &type)
+        : std::runtime_error("not implemented: " + type) {}
+};
+
+// Expressions built from the syntax tree of a document that is being edited,
+// kept across parses and keyed by syntax node. A node that an edit did not
+// touch is not rebuilt: its Expr is reused, and with it the classifiers of
+// its unannotated parameters, so typing results memoized for it stay valid.
+// Those classifiers are also kept per parameter node when the Expr around
+// them is rebuilt, and new ones never repeat old ones, so an edit does not
+// renumber the classifiers of the rest of the document.
+//
+// A reused Expr keeps the positions of the parse that built it. They are
+// stale once an edit above it moves it; MetaData::syntaxId finds the node
+// to read the current ones from.
+class ExprCache {
+  public:
+    const Expr *find(const void *syntaxId);
+    void store(const void *syntaxId, const Expr *expr);
+    // The classifier of the unannotated parameter node syntaxId.
+    Classifier classifier(const void *syntaxId);
+
+    // Drops the Expr of a node whose subtree has changed.
+    void invalidate(const void *syntaxId);
+
+    // Like TypingMemo::retain and sweep.
+    void retain(const void *syntaxId);
+    void sweep();
+
+    void clear();
+
+    // Where Exprs to be stored are allocated.
+    Arena &arena() { return arena_; }
+    size_t size() const { return exprs_.size(); }
+    // Bytes held by the arena, for statistics.
+    size_t bytes() const { return arena_.bytesAllocated(); }
+
+    size_t reused() const { return reused_; }
+    size_t built() const { return built_; }
+    void resetStats() { reused_ = built_ = 0; }
+
+  private:
+    std::unordered_map<const void *, const Expr *> exprs_;
+    std::unordered_map<const void *, const Expr *> retainedExprs_;
+    std::unordered_map<const void *, Classifier> classifiers_;
+    std::unordered_map<const void *, Classifier> retainedClassifiers_;
+    Classifier::Source source_;
+    Arena arena_;
+    size_t allocated_ = 0; // Exprs stored since the arena was created
+    size_t reused_ = 0;
+    size_t built_ = 0;
+};
+
+// Builds an Expr tree from a tree-sitter syntax tree, following
+// SyntaxNodeParser.res. Syntax errors come back as ParseError; nodes that do
+// not match the grammar raise MalformedNode. All nodes are allocated in the
+// given arena.
+class SyntaxNodeParser {
+  public:
+    SyntaxNodeParser(Arena &arena, std::string_view source) : arena_(arena), source_(source) {}
+
+    Result<const Expr *, ParseError> parseSourceFileNode(TSNode node);
+    Result<const Expr *, ParseError> parseExprNode(TSNode node);
+    Result<const Typ *, ParseError> parseTypeNode(TSNode node);
+
+    // Source of classifiers for parameters without an explicit one.
+    Classifier::Source &classifierSource() { return classifiers_; }
+
+    // Reuses the Exprs in cache and stores the ones built, along with the
+    // classifiers of parameters. The arena given to the constructor must be
+    // the cache's.
+    void setCache(ExprCache *cache) { cache_ = cache; }
+
+    static bool findParseError(TSNode node, ParseError *error);
+    static MetaData extractMetadata(TSNode node);
+
+  private:
+    std::string_view text(TSNode node) const;
+    Var parseVar(TSNode node) const;
+    Classifier parseClassifier(TSNode node) const;
+    Result<Param, ParseError> parseParamNode(TSNode node);
+    Result<Span<Param>, ParseError> parseParamsNode(TSNode node);
+    Result<const Expr *, ParseError> buildExprNode(TSNode node);
+
+    template <class T>
+    T *make(Expr::Kind kind, TSNode node) {
+        T *e = arena_.make<T>();
+        e->kind = kind;
+        e->metaData = extractMetadata(node);
+        return e;
+    }
+
+    Arena &arena_;
+    std::string_view source_;
+    Classifier::Source classifiers_;
+    ExprCache *cache_ = nullptr;
+};
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_SYNTAXNODEPARSER_H_
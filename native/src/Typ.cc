@@ -0,0 +1,212 @@
+#include "Typ.h"
+
+namespace lamgamma {
+
+const Typ *Typ::intType() {
+    static const Typ t{Kind::Int, {}, {}};
+    return &t;
+}
+
+const Typ *Typ::boolType() {
+    static const Typ t{Kind::Bool, {}, {}};
+    return &t;
+}
+
+const Typ *Typ::intArrayType() {
+    static const Typ t{Kind::IntArray, {}, {}};
+    return &t;
+}
+
+const Typ *Typ::func(Arena &arena, const Typ *param, const Typ *ret) {
+    Typ *t = arena.make<Typ>(Typ{Kind::Func, {}, {}});
+    t->param = param;
+    t->ret = ret;
+    return t;
+}
+
+const Typ *Typ::code(Arena &arena, Classifier cls, const Typ *typ) {
+    Typ *t = arena.make<Typ>(Typ{Kind::Code, cls, {}});
+    t->body = typ;
+    return t;
+}
+
+const Typ *Typ::clsAbs(Arena &arena, Classifier cls, Classifier base, const Typ *body) {
+    Typ *t = arena.make<Typ>(Typ{Kind::ClsAbs, cls, base});
+    t->body = body;
+    return t;
+}
+
+const Typ *Typ::tuple(Arena &arena, const std::vector<const Typ *> &elements) {
+    auto **data = arena.makeArray<const Typ *>(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i) data[i] = elements[i];
+    Typ *t = arena.make<Typ>(Typ{Kind::Tuple, {}, {}});
+    t->elements = {data, elements.size()};
+    return t;
+}
+
+std::string Typ::toString(const Typ *typ) {
+    switch (typ->kind) {
+    case Kind::Int:
+        return "Int";
+    case Kind::Bool:
+        return "Bool";
+    case Kind::IntArray:
+        return "Array<Int>";
+    case Kind::Tuple: {
+        std::string s = "(";
+        for (size_t i = 0; i < typ->elements.size; ++i) {
+            s += (i > 0 ? "*" : "") + toString(typ->elements[i]);
+        }
+        return s + ")";
+    }
+    case Kind::Func:
+        return "(" + toString(typ->param) + "->" + toString(typ->ret) + ")";
+    case Kind::Code:
+        return "<" + toString(typ->body) + "@" + typ->cls.toString() + ">";
+    case Kind::ClsAbs:
+        return "[" + typ->cls.toString() + ":>" + typ->base.toString() + "](" +
+               toString(typ->body) + ")";
+    }
+    return "";
+}
+
+bool Typ::hasFreeClassifier(const Typ *typ, Classifier cls) {
+    switch (typ->kind) {
+    case Kind::Int:
+    case Kind::Bool:
+    case Kind::IntArray:
+        return false;
+    case Kind::Func:
+        return hasFreeClassifier(typ->param, cls) || hasFreeClassifier(typ->ret, cls);
+    case Kind::Tuple:
+        for (const Typ *element : typ->elements) {
+            if (hasFreeClassifier(element, cls)) {
+                return true;
+            }
+        }
+        return false;
+    case Kind::Code:
+        return typ->cls == cls || hasFreeClassifier(typ->body, cls);
+    case Kind::ClsAbs:
+        return typ->base == cls || (typ->cls != cls && hasFreeClassifier(typ->body, cls));
+    }
+    return false;
+}
+
+namespace {
+
+// Classifiers bound by enclosing ClsAbs, innermost last. Two classifiers
+// agree when both are bound by the same pair of binders, or both are free
+// and equal; this is what Typ.eq gets by renaming both sides to a fresh
+// classifier.
+using Binders = std::vector<Classifier>;
+
+int binderIndex(const Binders &binders, Classifier cls) {
+    for (size_t i = binders.size(); i > 0; --i) {
+        if (binders[i - 1] == cls) {
+            return static_cast<int>(i - 1);
+        }
+    }
+    return -1;
+}
+
+bool clsEq(Classifier a, Classifier b, const Binders &bm1, const Binders &bm2) {
+    int ia = binderIndex(bm1, a);
+    int ib = binderIndex(bm2, b);
+    if (ia >= 0 || ib >= 0) {
+        return ia == ib;
+    }
+    return a == b;
+}
+
+bool eqAux(const Typ *a, const Typ *b, Binders &bm1, Binders &bm2) {
+    if (a == b && bm1.empty()) {
+        return true;
+    }
+    if (a->kind != b->kind) {
+        return false;
+    }
+    switch (a->kind) {
+    case Typ::Kind::Int:
+    case Typ::Kind::Bool:
+    case Typ::Kind::IntArray:
+        return true;
+    case Typ::Kind::Func:
+        return eqAux(a->param, b->param, bm1, bm2) && eqAux(a->ret, b->ret, bm1, bm2);
+    case Typ::Kind::Tuple:
+        if (a->elements.size != b->elements.size) {
+            return false;
+        }
+        for (size_t i = 0; i < a->elements.size; ++i) {
+            if (!eqAux(a->elements[i], b->elements[i], bm1, bm2)) {
+                return false;
+            }
+        }
+        return true;
+    case Typ::Kind::Code:
+        return clsEq(a->cls, b->cls, bm1, bm2) && eqAux(a->body, b->body, bm1, bm2);
+    case Typ::Kind::ClsAbs: {
+        if (!clsEq(a->base, b->base, bm1, bm2)) {
+            return false;
+        }
+        bm1.push_back(a->cls);
+        bm2.push_back(b->cls);
+        bool result = eqAux(a->body, b->body, bm1, bm2);
+        bm1.pop_back();
+        bm2.pop_back();
+        return result;
+    }
+    }
+    return false;
+}
+
+} // namespace
+
+bool Typ::eq(const Typ *a, const Typ *b) {
+    Binders bm1;
+    Binders bm2;
+    return eqAux(a, b, bm1, bm2);
+}
+
+uint64_t Typ::hash(const Typ *typ) {
+    uint64_t h = static_cast<uint64_t>(typ->kind);
+    switch (typ->kind) {
+    case Kind::Int:
+    case Kind::Bool:
+    case Kind::IntArray:
+        return h;
+    case Kind::Func:
+        return hashMix(hashMix(h, hash(typ->param)), hash(typ->ret));
+    case Kind::Tuple:
+        for (const Typ *element : typ->elements) h = hashMix(h, hash(element));
+        return h;
+    case Kind::Code:
+        return hashMix(hashMix(h, typ->cls.hash()), hash(typ->body));
+    case Kind::ClsAbs:
+        return hashMix(hashMix(hashMix(h, typ->cls.hash()), typ->base.hash()), hash(typ->body));
+    }
+    return h;
+}
+
+const Typ *Typ::copy(Arena &arena, const Typ *typ) {
+    switch (typ->kind) {
+    case Kind::Int:
+    case Kind::Bool:
+    case Kind::IntArray:
+        return typ;
+    case Kind::Func:
+        return func(arena, copy(arena, typ->param), copy(arena, typ->ret));
+    case Kind::Tuple: {
+        std::vector<const Typ *> elements;
+        for (const Typ *element : typ->elements) elements.push_back(copy(arena, element));
+        return tuple(arena, elements);
+    }
+    case Kind::Code:
+        return code(arena, typ->cls, copy(arena, typ->body));
+    case Kind::ClsAbs:
+        return clsAbs(arena, typ->cls, typ->base, copy(arena, typ->body));
+    }
+    return typ;
+}
+
+} // namespace lamgamma
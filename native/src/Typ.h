@@ -0,0 +1,51 @@
+#ifndef LAMGAMMA_TYP_H_
+#define LAMGAMMA_TYP_H_
+
+#include <string>
+#include <vector>
+
+#include "Arena.h"
+#include "Classifier.h"
+
+namespace lamgamma {
+
+// Native counterpart of Typ.res. Types are immutable and arena-allocated;
+// Int, Bool and IntArray are shared singletons.
+struct Typ {
+    enum class Kind : uint8_t { Int, Bool, Func, Code, ClsAbs, IntArray, Tuple };
+
+    Kind kind;
+    Classifier cls;            // Code, ClsAbs
+    Classifier base;           // ClsAbs
+    const Typ *param = nullptr; // Func
+    const Typ *ret = nullptr;   // Func
+    const Typ *body = nullptr;  // Code (the quoted type), ClsAbs
+    Span<const Typ *> elements = {}; // Tuple, two or more
+
+    static const Typ *intType();
+    static const Typ *boolType();
+    static const Typ *intArrayType();
+    static const Typ *func(Arena &arena, const Typ *param, const Typ *ret);
+    static const Typ *code(Arena &arena, Classifier cls, const Typ *typ);
+    static const Typ *clsAbs(Arena &arena, Classifier cls, Classifier base, const Typ *body);
+    static const Typ *tuple(Arena &arena, const std::vector<const Typ *> &elements);
+
+    static std::string toString(const Typ *typ);
+
+    // Whether cls is in Typ.freeClassifiers(typ).
+    static bool hasFreeClassifier(const Typ *typ, Classifier cls);
+
+    // Equality up to renaming of classifiers bound by ClsAbs.
+    static bool eq(const Typ *a, const Typ *b);
+
+    // Structural hash: types that print the same hash the same. Binders are
+    // hashed by name, so it is finer than eq.
+    static uint64_t hash(const Typ *typ);
+
+    // Deep copy into arena, sharing the singletons.
+    static const Typ *copy(Arena &arena, const Typ *typ);
+};
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_TYP_H_
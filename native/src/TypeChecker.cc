@@ -0,0 +1,736 @@
+#include "TypeChecker.h"
+
+#include <utility>
+
+namespace lamgamma {
+
+// ---- TypeError ----
+
+TypeError TypeError::typeMismatch(MetaData metaData, const Typ *expected, const Typ *actual) {
+    TypeError e(Kind::TypeMismatch, metaData);
+    e.expected = expected;
+    e.actual = actual;
+    return e;
+}
+
+TypeError TypeError::classifierMismatch(MetaData metaData, Classifier current, Classifier spliced) {
+    TypeError e(Kind::ClassifierMismatch, metaData);
+    e.current = current;
+    e.spliced = spliced;
+    return e;
+}
+
+TypeError TypeError::classifierEscape(MetaData metaData) {
+    return TypeError(Kind::ClassifierEscape, metaData);
+}
+
+TypeError TypeError::undefinedVariable(MetaData metaData, lamgamma::Var var) {
+    TypeError e(Kind::UndefinedVariable, metaData);
+    e.var = var;
+    return e;
+}
+
+TypeError TypeError::undefinedClassifier(MetaData metaData, Classifier cls) {
+    TypeError e(Kind::UndefinedClassifier, metaData);
+    e.cls = cls;
+    return e;
+}
+
+TypeError TypeError::malformedSplice(MetaData metaData, int shift) {
+    TypeError e(Kind::MalformedSplice, metaData);
+    e.shift = shift;
+    return e;
+}
+
+TypeError TypeError::insufficientTypeAnnotation(MetaData metaData) {
+    return TypeError(Kind::InsufficientTypeAnnotation, metaData);
+}
+
+TypeError TypeError::unsupportedFormat(MetaData metaData, std::string message) {
+    TypeError e(Kind::UnsupportedFormat, metaData);
+    e.message = std::move(message);
+    return e;
+}
+
+// ---- GlobalEnv ----
+
+GlobalEnv GlobalEnv::make(Arena &arena) {
+    GlobalEnv env(&arena, nullptr, ClsMap());
+    env.stack_ = env.consCls(Classifier::initial(), nullptr);
+    env.clsmap_ = env.setEntry(ClsMap(), Classifier::initial(), LocalEnv(),
+                               env.addCls(ClsSet(), Classifier::initial()));
+    return env;
+}
+
+const GlobalEnv::ClsList *GlobalEnv::consCls(Classifier cls, const ClsList *next) const {
+    uint64_t hash = hashMix(cls.hash(), next ? next->hash : 0);
+    return arena_->make<ClsList>(ClsList{cls, next, hash, next ? next->stage + 1 : 1});
+}
+
+GlobalEnv::LocalEnv GlobalEnv::bindVar(const LocalEnv &lenv, lamgamma::Var var, const Typ *typ,
+                                       int stage) const {
+    uint64_t hash = hashMix(hashMix(var.hash(), Typ::hash(typ)), static_cast<uint64_t>(stage));
+    return lenv.insert(*arena_, var, Binding{typ, stage}, hash);
+}
+
+GlobalEnv::ClsSet GlobalEnv::addCls(const ClsSet &subcls, Classifier cls) const {
+    return subcls.insert(*arena_, cls, true, cls.hash());
+}
+
+std::pair<const GlobalEnv::Entry *, uint64_t> GlobalEnv::makeEntry(Classifier cls, LocalEnv lenv,
+                                                                   ClsSet subcls) const {
+    uint64_t hash = hashMix(hashMix(cls.hash(), lenv.hash()), subcls.hash());
+    return {arena_->make<Entry>(Entry{lenv, subcls}), hash};
+}
+
+GlobalEnv::ClsMap GlobalEnv::setEntry(const ClsMap &clsmap, Classifier cls, LocalEnv lenv,
+                                      ClsSet subcls) const {
+    auto entry = makeEntry(cls, lenv, subcls);
+    return clsmap.insert(*arena_, cls, entry.first, entry.second);
+}
+
+const GlobalEnv::Entry *GlobalEnv::find(Classifier cls) const {
+    const Entry *const *entry = clsmap_.find(cls);
+    return entry == nullptr ? nullptr : *entry;
+}
+
+std::optional<GlobalEnv> GlobalEnv::pushStage(Classifier cls) const {
+    if (find(cls) == nullptr) {
+        return std::nullopt;
+    }
+    return GlobalEnv(arena_, consCls(cls, stack_), clsmap_);
+}
+
+std::optional<GlobalEnv> GlobalEnv::popStage(int shift) const {
+    const ClsList *stack = stack_;
+    for (int i = 0; i < shift && stack != nullptr; ++i) {
+        stack = stack->next;
+    }
+    if (stack == nullptr) {
+        return std::nullopt;
+    }
+    return GlobalEnv(arena_, stack, clsmap_);
+}
+
+Classifier GlobalEnv::currentCls() const { return stack_->cls; }
+
+bool GlobalEnv::isDefined(Classifier cls) const { return find(cls) != nullptr; }
+
+bool GlobalEnv::isConsistent(Classifier cls, Classifier base) const {
+    const Entry *entry = find(cls);
+    if (entry == nullptr) {
+        throw MalformedGlobalEnv();
+    }
+    return entry->subcls.find(base) != nullptr;
+}
+
+GlobalEnv GlobalEnv::extendVar(lamgamma::Var param, const Typ *typ, Classifier cls) const {
+    if (stack_ == nullptr) {
+        throw MalformedGlobalEnv();
+    }
+    const Entry *current = find(stack_->cls);
+    if (current == nullptr) {
+        throw MalformedGlobalEnv();
+    }
+    LocalEnv lenv1 = bindVar(current->lenv, param, typ);
+    ClsSet subcls1 = addCls(current->subcls, cls);
+    const ClsList *stack1 = consCls(cls, stack_->next);
+    return GlobalEnv(arena_, stack1, setEntry(clsmap_, cls, lenv1, subcls1));
+}
+
+GlobalEnv GlobalEnv::extendPersistentVar(lamgamma::Var param, const Typ *typ,
+                                         Classifier cls) const {
+    GlobalEnv env1 = extendVar(param, typ, cls);
+    int stage = stack_->stage;
+    ClsMap clsmap1 = env1.clsmap_.mapValues(*arena_, [&](Classifier c, const Entry *e) {
+        return makeEntry(c, bindVar(e->lenv, param, typ, stage), e->subcls);
+    });
+    return GlobalEnv(arena_, env1.stack_, clsmap1);
+}
+
+GlobalEnv GlobalEnv::extendPolyCls(Classifier cls, Classifier base) const {
+    const Entry *baseEntry = find(base);
+    if (baseEntry == nullptr) {
+        throw MalformedGlobalEnv();
+    }
+    ClsSet subcls1 = addCls(baseEntry->subcls, cls);
+    return GlobalEnv(arena_, stack_, setEntry(clsmap_, cls, baseEntry->lenv, subcls1));
+}
+
+const Typ *GlobalEnv::lookupVar(lamgamma::Var var) const {
+    const Binding *binding = find(currentCls())->lenv.find(var);
+    if (binding == nullptr || binding->stage > stack_->stage) {
+        return nullptr;
+    }
+    return binding->typ;
+}
+
+uint64_t GlobalEnv::fingerprint() const { return hashMix(stack_->hash, clsmap_.hash()); }
+
+// ---- TypingMemo ----
+
+const Typ *TypingMemo::lookup(const void *syntaxId, uint64_t envFingerprint) {
+    auto it = nodes_.find(syntaxId);
+    if (it != nodes_.end()) {
+        for (const auto &result : it->second) {
+            if (result.envFingerprint == envFingerprint) {
+                ++hits_;
+                return result.typ;
+            }
+        }
+    }
+    ++misses_;
+    return nullptr;
+}
+
+void TypingMemo::store(const void *syntaxId, uint64_t envFingerprint, const Typ *typ) {
+    nodes_[syntaxId].push_back(Entry{envFingerprint, Typ::copy(arena_, typ)});
+    ++stored_;
+}
+
+void TypingMemo::invalidate(const void *syntaxId) { nodes_.erase(syntaxId); }
+
+void TypingMemo::retain(const void *syntaxId) {
+    auto it = nodes_.find(syntaxId);
+    if (it != nodes_.end()) {
+        retained_.emplace(it->first, std::move(it->second));
+    }
+}
+
+void TypingMemo::sweep() {
+    nodes_.swap(retained_);
+    retained_.clear();
+    // Results of dropped nodes stay in the arena until it is rebuilt; do so
+    // once they are the majority.
+    size_t live = 0;
+    for (const auto &node : nodes_) {
+        live += node.second.size();
+    }
+    if (stored_ > 2 * live + 1024) {
+        Arena arena;
+        for (auto &node : nodes_) {
+            for (auto &result : node.second) {
+                result.typ = Typ::copy(arena, result.typ);
+            }
+        }
+        arena_ = std::move(arena);
+        stored_ = live;
+    }
+}
+
+void TypingMemo::clear() {
+    nodes_.clear();
+    retained_.clear();
+    arena_ = Arena();
+    stored_ = 0;
+}
+
+// ---- TypeChecker ----
+
+Result<const Typ *, TypeError> TypeChecker::extractFuncType(Span<Param> params,
+                                                            const Typ *returnType,
+                                                            const MetaData &metaData) {
+    const Typ *typ = returnType;
+    for (size_t i = params.size; i > 0; --i) {
+        const Param &param = params[i - 1];
+        if (param.typ == nullptr) {
+            return fail(TypeError::insufficientTypeAnnotation(metaData));
+        }
+        if (Typ::hasFreeClassifier(typ, param.cls)) {
+            return fail(TypeError::classifierEscape(metaData));
+        }
+        typ = Typ::func(arena_, param.typ, typ);
+    }
+    return typ;
+}
+
+namespace {
+
+// The arguments of a let rec memo function key its cache, which only ints,
+// booleans and code can.
+bool memoizable(const Expr *expr) {
+    switch (expr->kind) {
+    case Expr::Kind::ClsAbs:
+        return memoizable(expr->as<Expr::ClsAbs>().body);
+    case Expr::Kind::Func:
+        for (const Param &param : expr->as<Expr::Func>().params) {
+            if (param.typ == nullptr || param.typ->kind == Typ::Kind::Func ||
+                param.typ->kind == Typ::Kind::ClsAbs || param.typ->kind == Typ::Kind::IntArray ||
+                param.typ->kind == Typ::Kind::Tuple) {
+                return false;
+            }
+        }
+        return true;
+    default:
+        return true;
+    }
+}
+
+} // namespace
+
+// The types of the arguments of op, applied to arity of them, and of its
+// result. Make takes any number of ints.
+const Typ *TypeChecker::arraySignature(ArrayOp op, size_t arity, std::vector<const Typ *> &params) {
+    const Typ *Int = Typ::intType();
+    const Typ *IntArray = Typ::intArrayType();
+    const Typ *IntToInt = Typ::func(arena_, Int, Int);
+    switch (op) {
+    case ArrayOp::Make:
+        params.assign(arity, Int);
+        return IntArray;
+    case ArrayOp::Length:
+        params = {IntArray};
+        return Int;
+    case ArrayOp::Get:
+        params = {IntArray, Int};
+        return Int;
+    case ArrayOp::Init:
+        params = {Int, IntToInt};
+        return IntArray;
+    case ArrayOp::Map:
+        params = {IntToInt, IntArray};
+        return IntArray;
+    case ArrayOp::Fold:
+        params = {Typ::func(arena_, Int, IntToInt), Int, IntArray};
+        return Int;
+    }
+    return Int;
+}
+
+Result<const Typ *, TypeError> TypeChecker::guessFuncType(const Expr *expr) {
+    switch (expr->kind) {
+    case Expr::Kind::ClsAbs: {
+        const auto &e = expr->as<Expr::ClsAbs>();
+        auto bodyType = guessFuncType(e.body);
+        if (!bodyType) {
+            return bodyType;
+        }
+        return Typ::clsAbs(arena_, e.cls, e.base, bodyType.value());
+    }
+    case Expr::Kind::Func: {
+        const auto &e = expr->as<Expr::Func>();
+        if (e.returnType == nullptr) {
+            return fail(TypeError::insufficientTypeAnnotation(expr->metaData));
+        }
+        return extractFuncType(e.params, e.returnType, expr->metaData);
+    }
+    default:
+        return fail(TypeError::unsupportedFormat(expr->metaData,
+                                                 "Let rec can only be used with function values"));
+    }
+}
+
+const Typ *TypeChecker::substitute(const Typ *typ, Classifier from, Classifier to) {
+    switch (typ->kind) {
+    case Typ::Kind::Int:
+    case Typ::Kind::Bool:
+    case Typ::Kind::IntArray:
+        return typ;
+    case Typ::Kind::Func:
+        return Typ::func(arena_, substitute(typ->param, from, to), substitute(typ->ret, from, to));
+    case Typ::Kind::Tuple: {
+        std::vector<const Typ *> elements;
+        for (const Typ *element : typ->elements) elements.push_back(substitute(element, from, to));
+        return Typ::tuple(arena_, elements);
+    }
+    case Typ::Kind::Code:
+        return Typ::code(arena_, typ->cls == from ? to : typ->cls, substitute(typ->body, from, to));
+    case Typ::Kind::ClsAbs: {
+        Classifier base1 = typ->base == from ? to : typ->base;
+        if (typ->cls == from) {
+            return Typ::clsAbs(arena_, typ->cls, base1, typ->body);
+        }
+        return Typ::clsAbs(arena_, typ->cls, base1, substitute(typ->body, from, to));
+    }
+    }
+    return typ;
+}
+
+Result<const Typ *, TypeError> TypeChecker::typeCheck(const Expr *expr) {
+    return typeCheck(expr, GlobalEnv::make(arena_));
+}
+
+Result<const Typ *, TypeError> TypeChecker::typeCheck(const Expr *expr, const GlobalEnv &env) {
+    if (memo_ == nullptr || expr->metaData.syntaxId == nullptr) {
+        return check(expr, env);
+    }
+    uint64_t fingerprint = env.fingerprint();
+    if (const Typ *typ = memo_->lookup(expr->metaData.syntaxId, fingerprint)) {
+        return typ;
+    }
+    auto result = check(expr, env);
+    // Errors carry positions, which move with edits elsewhere, so only
+    // successful results are kept.
+    if (result) {
+        memo_->store(expr->metaData.syntaxId, fingerprint, result.value());
+    }
+    return result;
+}
+
+Result<const Typ *, TypeError> TypeChecker::check(const Expr *expr, const GlobalEnv &env) {
+    const Typ *Int = Typ::intType();
+    const Typ *Bool = Typ::boolType();
+
+    switch (expr->kind) {
+    case Expr::Kind::IntLit:
+        return Int;
+
+    case Expr::Kind::BoolLit:
+        return Bool;
+
+    case Expr::Kind::BinOp: {
+        const auto &e = expr->as<Expr::BinOp>();
+        auto leftR = typeCheck(e.left, env);
+        if (!leftR) {
+            return leftR;
+        }
+        auto rightR = typeCheck(e.right, env);
+        if (!rightR) {
+            return rightR;
+        }
+        const Typ *leftType = leftR.value();
+        const Typ *rightType = rightR.value();
+        switch (e.op) {
+        // Arithmetic operations require both operands to be integers and return an integer.
+        case BinOp::Add:
+        case BinOp::Sub:
+        case BinOp::Mul:
+        case BinOp::Div:
+        case BinOp::Mod:
+            if (!Typ::eq(leftType, Int)) {
+                return fail(TypeError::typeMismatch(e.left->metaData, Int, leftType));
+            }
+            if (!Typ::eq(rightType, Int)) {
+                return fail(TypeError::typeMismatch(e.right->metaData, Int, rightType));
+            }
+            return Int;
+
+        // For equality and inequality, both operands must be of the same type.
+        case BinOp::Eq:
+        case BinOp::Ne:
+            if (!Typ::eq(leftType, rightType)) {
+                return fail(TypeError::typeMismatch(e.right->metaData, leftType, rightType));
+            }
+            return Bool;
+
+        // Relational comparisons require both operands to be integers.
+        case BinOp::Lt:
+        case BinOp::Le:
+        case BinOp::Gt:
+        case BinOp::Ge:
+            if (!Typ::eq(leftType, Int)) {
+                return fail(TypeError::typeMismatch(e.left->metaData, Int, leftType));
+            }
+            if (!Typ::eq(rightType, Int)) {
+                return fail(TypeError::typeMismatch(e.right->metaData, Int, rightType));
+            }
+            return Bool;
+        }
+        break;
+    }
+
+    case Expr::Kind::ShortCircuitOp: {
+        const auto &e = expr->as<Expr::ShortCircuitOp>();
+        auto leftR = typeCheck(e.left, env);
+        if (!leftR) {
+            return leftR;
+        }
+        auto rightR = typeCheck(e.right, env);
+        if (!rightR) {
+            return rightR;
+        }
+        if (!Typ::eq(leftR.value(), Bool)) {
+            return fail(TypeError::typeMismatch(e.left->metaData, Bool, leftR.value()));
+        }
+        if (!Typ::eq(rightR.value(), Bool)) {
+            return fail(TypeError::typeMismatch(e.right->metaData, Bool, rightR.value()));
+        }
+        return Bool;
+    }
+
+    case Expr::Kind::UniOp: {
+        const auto &e = expr->as<Expr::UniOp>();
+        auto exprR = typeCheck(e.expr, env);
+        if (!exprR) {
+            return exprR;
+        }
+        switch (e.op) {
+        case UniOp::Not:
+            if (!Typ::eq(exprR.value(), Bool)) {
+                return fail(TypeError::typeMismatch(e.expr->metaData, Bool, exprR.value()));
+            }
+            return Bool;
+        }
+        break;
+    }
+
+    case Expr::Kind::If: {
+        const auto &e = expr->as<Expr::If>();
+        auto condR = typeCheck(e.cond, env);
+        if (!condR) {
+            return condR;
+        }
+        if (!Typ::eq(condR.value(), Bool)) {
+            return fail(TypeError::typeMismatch(e.cond->metaData, Bool, condR.value()));
+        }
+        auto thenR = typeCheck(e.thenBranch, env);
+        if (!thenR) {
+            return thenR;
+        }
+        auto elseR = typeCheck(e.elseBranch, env);
+        if (!elseR) {
+            return elseR;
+        }
+        if (!Typ::eq(thenR.value(), elseR.value())) {
+            return fail(
+                TypeError::typeMismatch(e.elseBranch->metaData, thenR.value(), elseR.value()));
+        }
+        return thenR;
+    }
+
+    case Expr::Kind::ArrayOp: {
+        const auto &e = expr->as<Expr::ArrayOp>();
+        std::vector<const Typ *> paramTypes;
+        const Typ *resultType = arraySignature(e.op, e.args.size, paramTypes);
+        for (size_t i = 0; i < e.args.size; ++i) {
+            auto argR = typeCheck(e.args[i], env);
+            if (!argR) {
+                return argR;
+            }
+            if (!Typ::eq(argR.value(), paramTypes[i])) {
+                return fail(
+                    TypeError::typeMismatch(e.args[i]->metaData, paramTypes[i], argR.value()));
+            }
+        }
+        return resultType;
+    }
+
+    case Expr::Kind::Tuple: {
+        const auto &e = expr->as<Expr::Tuple>();
+        std::vector<const Typ *> elementTypes;
+        for (const Expr *element : e.elements) {
+            auto elementR = typeCheck(element, env);
+            if (!elementR) {
+                return elementR;
+            }
+            elementTypes.push_back(elementR.value());
+        }
+        return Typ::tuple(arena_, elementTypes);
+    }
+
+    case Expr::Kind::Proj: {
+        const auto &e = expr->as<Expr::Proj>();
+        auto tupleR = typeCheck(e.tuple, env);
+        if (!tupleR) {
+            return tupleR;
+        }
+        const Typ *tupleType = tupleR.value();
+        if (tupleType->kind != Typ::Kind::Tuple || e.index >= tupleType->elements.size) {
+            return fail(TypeError::unsupportedFormat(
+                expr->metaData, "Cannot take component " + std::to_string(e.index) + " of " +
+                                    Typ::toString(tupleType)));
+        }
+        return tupleType->elements[e.index];
+    }
+
+    case Expr::Kind::Var: {
+        const auto &e = expr->as<Expr::Var>();
+        const Typ *typ = env.lookupVar(e.var);
+        if (typ == nullptr) {
+            return fail(TypeError::undefinedVariable(expr->metaData, e.var));
+        }
+        return typ;
+    }
+
+    case Expr::Kind::Let:
+    case Expr::Kind::LetCs: {
+        const auto &e = expr->as<Expr::Let>();
+        auto exprR = typeCheck(e.expr, env);
+        if (!exprR) {
+            return exprR;
+        }
+        if (e.param.typ != nullptr && !Typ::eq(e.param.typ, exprR.value())) {
+            return fail(TypeError::typeMismatch(e.expr->metaData, e.param.typ, exprR.value()));
+        }
+        GlobalEnv env1 = expr->kind == Expr::Kind::LetCs
+                             ? env.extendPersistentVar(e.param.var, exprR.value(), e.param.cls)
+                             : env.extendVar(e.param.var, exprR.value(), e.param.cls);
+        auto bodyR = typeCheck(e.body, env1);
+        if (!bodyR) {
+            return bodyR;
+        }
+        if (Typ::hasFreeClassifier(bodyR.value(), e.param.cls)) {
+            return fail(TypeError::classifierEscape(e.body->metaData));
+        }
+        return bodyR;
+    }
+
+    case Expr::Kind::LetRec: {
+        const auto &e = expr->as<Expr::Let>();
+        auto paramTypeR = e.param.typ != nullptr ? Result<const Typ *, TypeError>(e.param.typ)
+                                                 : guessFuncType(e.expr);
+        if (!paramTypeR) {
+            return paramTypeR;
+        }
+        // Check if the param type escapes the scope of the param
+        if (Typ::hasFreeClassifier(paramTypeR.value(), e.param.cls)) {
+            return fail(TypeError::classifierEscape(e.expr->metaData));
+        }
+        if (e.memo && !memoizable(e.expr)) {
+            return fail(TypeError::unsupportedFormat(
+                e.expr->metaData,
+                "Let rec memo can only be used with functions of ints, booleans and code"));
+        }
+        const Typ *paramType = paramTypeR.value();
+        GlobalEnv env1 = env.extendVar(e.param.var, paramType, e.param.cls);
+
+        auto exprR = typeCheck(e.expr, env1);
+        if (!exprR) {
+            return exprR;
+        }
+        if (!Typ::eq(exprR.value(), paramType)) {
+            return fail(TypeError::typeMismatch(e.expr->metaData, paramType, exprR.value()));
+        }
+        auto bodyR = typeCheck(e.body, env1);
+        if (!bodyR) {
+            return bodyR;
+        }
+        if (Typ::hasFreeClassifier(bodyR.value(), e.param.cls)) {
+            return fail(TypeError::classifierEscape(e.body->metaData));
+        }
+        return bodyR;
+    }
+
+    case Expr::Kind::Func: {
+        const auto &e = expr->as<Expr::Func>();
+        GlobalEnv env1 = env;
+        for (const Param &param : e.params) {
+            if (param.typ == nullptr) {
+                return fail(TypeError::insufficientTypeAnnotation(expr->metaData));
+            }
+            env1 = env1.extendVar(param.var, param.typ, param.cls);
+        }
+        auto bodyR = typeCheck(e.body, env1);
+        if (!bodyR) {
+            return bodyR;
+        }
+        if (e.returnType != nullptr && !Typ::eq(e.returnType, bodyR.value())) {
+            return fail(TypeError::typeMismatch(e.body->metaData, e.returnType, bodyR.value()));
+        }
+        return extractFuncType(e.params, bodyR.value(), expr->metaData);
+    }
+
+    case Expr::Kind::App: {
+        const auto &e = expr->as<Expr::App>();
+        auto funcR = typeCheck(e.func, env);
+        if (!funcR) {
+            return funcR;
+        }
+        auto argR = typeCheck(e.arg, env);
+        if (!argR) {
+            return argR;
+        }
+        const Typ *funcType = funcR.value();
+        const Typ *argType = argR.value();
+        if (funcType->kind != Typ::Kind::Func) {
+            return fail(TypeError::typeMismatch(e.func->metaData, Typ::func(arena_, argType, Int),
+                                                funcType));
+        }
+        if (!Typ::eq(funcType->param, argType)) {
+            return fail(TypeError::typeMismatch(e.arg->metaData, funcType->param, argType));
+        }
+        return funcType->ret;
+    }
+
+    case Expr::Kind::Quote: {
+        const auto &e = expr->as<Expr::Quote>();
+        if (!e.cls) {
+            return fail(TypeError::insufficientTypeAnnotation(expr->metaData));
+        }
+        auto env1 = env.pushStage(*e.cls);
+        if (!env1) {
+            return fail(TypeError::undefinedClassifier(expr->metaData, *e.cls));
+        }
+        auto quotedR = typeCheck(e.expr, *env1);
+        if (!quotedR) {
+            return quotedR;
+        }
+        return Typ::code(arena_, *e.cls, quotedR.value());
+    }
+
+    case Expr::Kind::Splice: {
+        const auto &e = expr->as<Expr::Splice>();
+        auto env1 = env.popStage(e.shift);
+        if (!env1) {
+            return fail(TypeError::malformedSplice(expr->metaData, e.shift));
+        }
+        auto splicedR = typeCheck(e.expr, *env1);
+        if (!splicedR) {
+            return splicedR;
+        }
+        const Typ *typSpliced = splicedR.value();
+        if (typSpliced->kind != Typ::Kind::Code) {
+            return fail(TypeError::typeMismatch(
+                expr->metaData, Typ::code(arena_, Classifier::initial(), Int), typSpliced));
+        }
+        if (!env.isConsistent(env.currentCls(), typSpliced->cls)) {
+            return fail(
+                TypeError::classifierMismatch(expr->metaData, env.currentCls(), typSpliced->cls));
+        }
+        return typSpliced->body;
+    }
+
+    case Expr::Kind::GenLet: {
+        const auto &e = expr->as<Expr::GenLet>();
+        auto boundR = typeCheck(e.expr, env);
+        if (!boundR) {
+            return boundR;
+        }
+        const Typ *typBound = boundR.value();
+        if (typBound->kind != Typ::Kind::Code) {
+            return fail(TypeError::typeMismatch(
+                e.expr->metaData, Typ::code(arena_, Classifier::initial(), Int), typBound));
+        }
+        return typBound;
+    }
+
+    case Expr::Kind::ClsAbs: {
+        const auto &e = expr->as<Expr::ClsAbs>();
+        if (!env.isDefined(e.base)) {
+            return fail(TypeError::undefinedClassifier(expr->metaData, e.base));
+        }
+        GlobalEnv env1 = env.extendPolyCls(e.cls, e.base);
+        auto bodyR = typeCheck(e.body, env1);
+        if (!bodyR) {
+            return bodyR;
+        }
+        return Typ::clsAbs(arena_, e.cls, e.base, bodyR.value());
+    }
+
+    case Expr::Kind::ClsApp: {
+        const auto &e = expr->as<Expr::ClsApp>();
+        auto funcR = typeCheck(e.func, env);
+        if (!funcR) {
+            return funcR;
+        }
+        const Typ *funcType = funcR.value();
+        if (funcType->kind != Typ::Kind::ClsAbs) {
+            return fail(TypeError::typeMismatch(
+                e.func->metaData,
+                Typ::clsAbs(arena_, Classifier::initial(), Classifier::initial(), Int), funcType));
+        }
+        // The playground raises on an unknown classifier here; report it
+        // instead.
+        if (!env.isDefined(e.arg)) {
+            return fail(TypeError::undefinedClassifier(expr->metaData, e.arg));
+        }
+        if (!env.isConsistent(e.arg, funcType->base)) {
+            return fail(TypeError::classifierMismatch(e.func->metaData, e.arg, funcType->base));
+        }
+        return substitute(funcType->body, funcType->cls, e.arg);
+    }
+    }
+    throw std::logic_error("unknown expression kind");
+}
+
+} // namespace lamgamma
@@ -0,0 +1,221 @@
+#ifndef LAMGAMMA_TYPECHECKER_H_
+#define LAMGAMMA_TYPECHECKER_H_
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Arena.h"
+#include "Classifier.h"
+#include "Expr.h"
+#include "PersistentMap.h"
+#include "Result.h"
+#include "Typ.h"
+#include "Var.h"
+
+namespace lamgamma {
+
+// Native counterpart of TypeChecker.TypeError.t. Only the fields of the
+// given kind are meaningful.
+struct TypeError {
+    enum class Kind : uint8_t {
+        TypeMismatch,
+        ClassifierMismatch,
+        ClassifierEscape,
+        UndefinedVariable,
+        UndefinedClassifier,
+        MalformedSplice,
+        InsufficientTypeAnnotation,
+        UnsupportedFormat,
+    };
+
+    TypeError(Kind kind, MetaData metaData) : kind(kind), metaData(metaData) {}
+
+    Kind kind;
+    MetaData metaData;
+    const Typ *expected = nullptr; // TypeMismatch
+    const Typ *actual = nullptr;   // TypeMismatch
+    Classifier current;            // ClassifierMismatch
+    Classifier spliced;            // ClassifierMismatch
+    lamgamma::Var var;             // UndefinedVariable
+    Classifier cls;                // UndefinedClassifier
+    int shift = 0;                 // MalformedSplice
+    std::string message;           // UnsupportedFormat
+
+    static TypeError typeMismatch(MetaData metaData, const Typ *expected, const Typ *actual);
+    static TypeError classifierMismatch(MetaData metaData, Classifier current, Classifier spliced);
+    static TypeError classifierEscape(MetaData metaData);
+    static TypeError undefinedVariable(MetaData metaData, lamgamma::Var var);
+    static TypeError undefinedClassifier(MetaData metaData, Classifier cls);
+    static TypeError malformedSplice(MetaData metaData, int shift);
+    static TypeError insufficientTypeAnnotation(MetaData metaData);
+    static TypeError unsupportedFormat(MetaData metaData, std::string message);
+};
+
+struct MalformedGlobalEnv : std::logic_error {
+    MalformedGlobalEnv() : std::logic_error("malformed global environment") {}
+};
+
+// The typing environment: a stack of classifiers (the current stage on top)
+// and, per classifier, the local variables visible at it and the classifiers
+// below it. It is persistent, with every extension allocated in the arena of
+// the check that created it: the maps are balanced trees like the Belt.Maps
+// of TypeChecker.res, so lookups and extensions are O(log n) and never copy
+// more than a path.
+class GlobalEnv {
+  public:
+    static GlobalEnv make(Arena &arena);
+
+    // Returns nullopt when cls is not defined in the environment.
+    std::optional<GlobalEnv> pushStage(Classifier cls) const;
+    std::optional<GlobalEnv> popStage(int shift) const;
+    Classifier currentCls() const;
+    bool isDefined(Classifier cls) const;
+    bool isConsistent(Classifier cls, Classifier base) const;
+    GlobalEnv extendVar(lamgamma::Var param, const Typ *typ, Classifier cls) const;
+    // Like extendVar, but the variable is also visible at every later stage,
+    // under any classifier. It is never visible at earlier stages.
+    GlobalEnv extendPersistentVar(lamgamma::Var param, const Typ *typ, Classifier cls) const;
+    GlobalEnv extendPolyCls(Classifier cls, Classifier base) const;
+
+    // Looks var up in the local environment of the current classifier.
+    const Typ *lookupVar(lamgamma::Var var) const;
+
+    // Structural hash of the whole environment. Two environments with the
+    // same fingerprint type every expression the same way.
+    uint64_t fingerprint() const;
+
+  private:
+    // Orders by ids rather than by names; any total order will do.
+    struct VarOrder {
+        bool operator()(lamgamma::Var a, lamgamma::Var b) const {
+            return a.name.id() != b.name.id() ? a.name.id() < b.name.id() : a.id < b.id;
+        }
+    };
+    struct ClsOrder {
+        bool operator()(Classifier a, Classifier b) const {
+            if (a.kind != b.kind) {
+                return a.kind < b.kind;
+            }
+            return a.name.id() != b.name.id() ? a.name.id() < b.name.id() : a.id < b.id;
+        }
+    };
+
+    // A variable bound by let cs is visible from the stage it was bound at
+    // on, counting the bottom of the stack as stage 1; other bindings have
+    // stage 0 and are visible wherever their local environment is.
+    struct Binding {
+        const Typ *typ;
+        int stage;
+    };
+    using LocalEnv = PersistentMap<lamgamma::Var, Binding, VarOrder>;
+    using ClsSet = PersistentMap<Classifier, bool, ClsOrder>;
+
+    struct Entry {
+        // The local environment that corresponds to the classifier
+        LocalEnv lenv;
+        // The classifiers below it (including itself)
+        ClsSet subcls;
+    };
+    using ClsMap = PersistentMap<Classifier, const Entry *, ClsOrder>;
+
+    // The stack is a list whose cells carry the hash and the length of the
+    // list they head, so fingerprints cost O(1) and the length of the stack
+    // is the current stage.
+    struct ClsList {
+        Classifier cls;
+        const ClsList *next;
+        uint64_t hash;
+        int stage;
+    };
+
+    const ClsList *consCls(Classifier cls, const ClsList *next) const;
+    LocalEnv bindVar(const LocalEnv &lenv, lamgamma::Var var, const Typ *typ, int stage = 0) const;
+    ClsSet addCls(const ClsSet &subcls, Classifier cls) const;
+    std::pair<const Entry *, uint64_t> makeEntry(Classifier cls, LocalEnv lenv, ClsSet subcls) const;
+    ClsMap setEntry(const ClsMap &clsmap, Classifier cls, LocalEnv lenv, ClsSet subcls) const;
+
+    GlobalEnv(Arena *arena, const ClsList *stack, ClsMap clsmap)
+        : arena_(arena), stack_(stack), clsmap_(clsmap) {}
+
+    const Entry *find(Classifier cls) const;
+
+    Arena *arena_;
+    const ClsList *stack_;
+    ClsMap clsmap_;
+};
+
+// Successful typing results from earlier checks, keyed by the syntax node an
+// expression was built from and the fingerprint of the environment it was
+// checked in. Types are copied into the memo's own arena, so they outlive
+// the syntax tree and the checker that produced them.
+class TypingMemo {
+  public:
+    const Typ *lookup(const void *syntaxId, uint64_t envFingerprint);
+    void store(const void *syntaxId, uint64_t envFingerprint, const Typ *typ);
+
+    // Drops the results for a node whose subtree has changed.
+    void invalidate(const void *syntaxId);
+
+    // Keeps the results for a node that is still in the current tree. The
+    // next sweep drops every node not retained since the previous one, so
+    // stale identities can never alias nodes of a later tree.
+    void retain(const void *syntaxId);
+    void sweep();
+
+    void clear();
+
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+    void resetStats() { hits_ = misses_ = 0; }
+
+  private:
+    struct Entry {
+        uint64_t envFingerprint;
+        const Typ *typ;
+    };
+    using Table = std::unordered_map<const void *, std::vector<Entry>>;
+
+    Table nodes_;
+    Table retained_;
+    Arena arena_;
+    size_t stored_ = 0;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+};
+
+// Checks programs against the rules of TypeChecker.res. Every type it
+// produces, including those inside a returned TypeError, lives in the
+// checker's arena and stays valid until the checker is destroyed.
+class TypeChecker {
+  public:
+    TypeChecker() = default;
+    TypeChecker(const TypeChecker &) = delete;
+    TypeChecker &operator=(const TypeChecker &) = delete;
+
+    Result<const Typ *, TypeError> typeCheck(const Expr *expr);
+    Result<const Typ *, TypeError> typeCheck(const Expr *expr, const GlobalEnv &env);
+
+    // Consults and fills memo for every expression that has a syntaxId.
+    void setMemo(TypingMemo *memo) { memo_ = memo; }
+
+    Arena &arena() { return arena_; }
+
+  private:
+    Result<const Typ *, TypeError> check(const Expr *expr, const GlobalEnv &env);
+    Result<const Typ *, TypeError> extractFuncType(Span<Param> params, const Typ *returnType,
+                                                    const MetaData &metaData);
+    Result<const Typ *, TypeError> guessFuncType(const Expr *expr);
+    const Typ *substitute(const Typ *typ, Classifier from, Classifier to);
+    const Typ *arraySignature(ArrayOp op, size_t arity, std::vector<const Typ *> &params);
+
+    Arena arena_;
+    TypingMemo *memo_ = nullptr;
+};
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_TYPECHECKER_H_
@@ -0,0 +1,356 @@
+// Conformance suite for the native type checker. The cases mirror
+// playground/src/interpreter/TypeChecker.res.spec.ts; results are compared
+// through the messages Frontend produces.
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <tree_sitter/api.h>
+
+#include "Frontend.h"
+#include "tree-sitter-lamgamma_parser.h"
+
+namespace lamgamma {
+namespace {
+
+class TypeCheckerSpec : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        parser_ = ts_parser_new();
+        ts_parser_set_language(parser_, tree_sitter_lamgamma_parser());
+    }
+
+    void TearDown() override { ts_parser_delete(parser_); }
+
+    std::string typeCheck(const std::string &input) { return Frontend::typeCheck(input, parser_); }
+
+  private:
+    TSParser *parser_ = nullptr;
+};
+
+// for literals
+
+TEST_F(TypeCheckerSpec, LiteralInt) { EXPECT_EQ(typeCheck("123"), "Int"); }
+
+TEST_F(TypeCheckerSpec, LiteralTrue) { EXPECT_EQ(typeCheck("true"), "Bool"); }
+
+TEST_F(TypeCheckerSpec, LiteralFalse) { EXPECT_EQ(typeCheck("false"), "Bool"); }
+
+// for arithmetic
+
+TEST_F(TypeCheckerSpec, ArithmeticSucceeds) {
+    EXPECT_EQ(typeCheck("1 + 2"), "Int");
+    EXPECT_EQ(typeCheck("5 - 2"), "Int");
+    EXPECT_EQ(typeCheck("3 * 4"), "Int");
+    EXPECT_EQ(typeCheck("8 / 2"), "Int");
+    EXPECT_EQ(typeCheck("7 mod 3"), "Int");
+}
+
+TEST_F(TypeCheckerSpec, ArithmeticFails) {
+    EXPECT_EQ(typeCheck("1 + true"), "(1,4)-(1,8) Type error: expected Int, but got Bool");
+    EXPECT_EQ(typeCheck("false - 2"), "(1,0)-(1,5) Type error: expected Int, but got Bool");
+}
+
+TEST_F(TypeCheckerSpec, ArithmeticComplexExpression) {
+    EXPECT_EQ(typeCheck("(1 + 2) * (3 - 4) / (5 + 6 mod 2)"), "Int");
+}
+
+// for comparison
+
+TEST_F(TypeCheckerSpec, ComparisonSucceeds) {
+    EXPECT_EQ(typeCheck("1 == 2"), "Bool");
+    EXPECT_EQ(typeCheck("true == false"), "Bool");
+    EXPECT_EQ(typeCheck("3 != 4"), "Bool");
+    EXPECT_EQ(typeCheck("true != true"), "Bool");
+    EXPECT_EQ(typeCheck("5 < 6"), "Bool");
+    EXPECT_EQ(typeCheck("7 <= 8"), "Bool");
+    EXPECT_EQ(typeCheck("9 > 10"), "Bool");
+    EXPECT_EQ(typeCheck("11 >= 12"), "Bool");
+}
+
+TEST_F(TypeCheckerSpec, ComparisonFails) {
+    EXPECT_EQ(typeCheck("1 == true"), "(1,5)-(1,9) Type error: expected Int, but got Bool");
+    EXPECT_EQ(typeCheck("false != 2"), "(1,9)-(1,10) Type error: expected Bool, but got Int");
+    EXPECT_EQ(typeCheck("3 < true"), "(1,4)-(1,8) Type error: expected Int, but got Bool");
+    EXPECT_EQ(typeCheck("false <= 4"), "(1,0)-(1,5) Type error: expected Int, but got Bool");
+}
+
+// for logical operations
+
+TEST_F(TypeCheckerSpec, LogicalSucceeds) {
+    EXPECT_EQ(typeCheck("true && false"), "Bool");
+    EXPECT_EQ(typeCheck("false || true"), "Bool");
+    EXPECT_EQ(typeCheck("true && false || true"), "Bool");
+    EXPECT_EQ(typeCheck("true || false && true"), "Bool");
+    EXPECT_EQ(typeCheck("!true"), "Bool");
+}
+
+TEST_F(TypeCheckerSpec, LogicalFails) {
+    EXPECT_EQ(typeCheck("true && 1"), "(1,8)-(1,9) Type error: expected Bool, but got Int");
+    EXPECT_EQ(typeCheck("false || 2"), "(1,9)-(1,10) Type error: expected Bool, but got Int");
+    EXPECT_EQ(typeCheck("!1"), "(1,1)-(1,2) Type error: expected Bool, but got Int");
+}
+
+// for if expressions
+
+TEST_F(TypeCheckerSpec, IfSucceeds) {
+    EXPECT_EQ(typeCheck("if 1 < 2 then 3 + 4 else 5 * 6"), "Int");
+    EXPECT_EQ(typeCheck("if false then false else true"), "Bool");
+}
+
+TEST_F(TypeCheckerSpec, IfFails) {
+    EXPECT_EQ(typeCheck("if 1 then 2 else 3"),
+              "(1,3)-(1,4) Type error: expected Bool, but got Int");
+    EXPECT_EQ(typeCheck("if true then 1 else false"),
+              "(1,20)-(1,25) Type error: expected Int, but got Bool");
+}
+
+// for let expressions
+
+TEST_F(TypeCheckerSpec, LetSucceeds) {
+    EXPECT_EQ(typeCheck("let x = 1 in x + 2"), "Int");
+    EXPECT_EQ(typeCheck("let y = true in if y then false else true"), "Bool");
+    EXPECT_EQ(typeCheck("let x = 1 in let y = 2 in x + y"), "Int");
+}
+
+TEST_F(TypeCheckerSpec, LetFails) {
+    EXPECT_EQ(typeCheck("let x:int = true in x"),
+              "(1,12)-(1,16) Type error: expected Int, but got Bool");
+}
+
+TEST_F(TypeCheckerSpec, LetShadowsOuterBindings) {
+    EXPECT_EQ(typeCheck("let x = true in let x = 1 in x + 1"), "Int");
+
+    // Hundreds of binders in scope, each looked up once.
+    std::string input;
+    for (int i = 0; i < 500; ++i) {
+        input += "let x" + std::to_string(i) + " = " +
+                 (i == 0 ? std::string("0") : "x" + std::to_string(i - 1) + " + 1") + " in ";
+    }
+    EXPECT_EQ(typeCheck(input + "x499 == 499"), "Bool");
+}
+
+// for function expressions
+
+TEST_F(TypeCheckerSpec, FunctionSucceeds) {
+    EXPECT_EQ(typeCheck("(x: int) => { x + 1 }"), "(Int->Int)");
+    EXPECT_EQ(typeCheck("(x: int):int => { x + 1 }"), "(Int->Int)");
+    EXPECT_EQ(typeCheck("(x: int, y: bool) => { if y then x + 1 else x - 1 }"),
+              "(Int->(Bool->Int))");
+}
+
+TEST_F(TypeCheckerSpec, FunctionFails) {
+    EXPECT_EQ(typeCheck("(x: int):bool => { x + 1 }"),
+              "(1,19)-(1,24) Type error: expected Bool, but got Int");
+    EXPECT_EQ(typeCheck("(x) => { x + 1 }"), "(1,0)-(1,16) Insufficient type annotation");
+}
+
+// for function application
+
+TEST_F(TypeCheckerSpec, ApplicationSucceeds) {
+    EXPECT_EQ(typeCheck("let y = (x: int) => { x + 1 } in y 2"), "Int");
+}
+
+// for let rec expressions
+
+TEST_F(TypeCheckerSpec, LetRecWithClsAbs) {
+    const std::string input = R"lg(
+                let rec f = [g1:>!](x: <int@g1>):<int@g1> =>
+                              { `{@g1 ~{ x } + 1 } } in
+                `{@! (y:int@g2) => { ~{ f^g2 `{@g2 y } } } }
+                )lg";
+    EXPECT_EQ(typeCheck(input), "<(Int->Int)@!>");
+}
+
+TEST_F(TypeCheckerSpec, LetRecWithDifferentTypeAnnotation) {
+    const std::string input = R"lg(
+                let rec f:[g:>!](<int@g>-><int@g>) = [g1:>!](x: <int@g1>) =>
+                              { `{@g1 ~{ x } + 1 } } in
+                `{@! (y:int@g2) => { ~{ f^g2 `{@g2 y } } } }
+                )lg";
+    EXPECT_EQ(typeCheck(input), "<(Int->Int)@!>");
+}
+
+TEST_F(TypeCheckerSpec, LetRecFailsDueToInsufficientTypeAnnotation) {
+    const std::string input = R"lg(
+                let rec f = [g1:>!](x: <int@g1>) =>
+                              { `{@g1 ~{ x } + 1 } } in
+                `{@! (y:int@g2) => { ~{ f^g2 `{@g2 y } } } }
+                )lg";
+    EXPECT_EQ(typeCheck(input), "(2,35)-(3,52) Insufficient type annotation");
+}
+
+TEST_F(TypeCheckerSpec, LetRecMemo) {
+    const std::string input = R"lg(
+                let rec memo fib = (n: int): int => {
+                  if n <= 1 then n else fib (n - 1) + fib (n - 2)
+                } in
+                fib
+                )lg";
+    EXPECT_EQ(typeCheck(input), "(Int->Int)");
+}
+
+TEST_F(TypeCheckerSpec, LetRecMemoFailsForFunctionArguments) {
+    const std::string input = R"lg(
+                let rec memo f = (g: int -> int): int => { g 1 } in
+                f
+                )lg";
+    EXPECT_EQ(typeCheck(input), "(2,33)-(2,64) Unsupported format: Let rec memo can only be "
+                                "used with functions of ints, booleans and code");
+}
+
+// for arrays
+
+TEST_F(TypeCheckerSpec, ArraySucceeds) {
+    EXPECT_EQ(typeCheck("[| 1, 2, 3 |].(0) + Array.length [| |]"), "Int");
+    EXPECT_EQ(typeCheck("Array.fold ((acc: int, x: int): int => { acc + x }) 0 "
+                        "(Array.map ((x: int): int => { x * x }) "
+                        "(Array.init 10 ((i: int): int => { i })))"),
+              "Int");
+    EXPECT_EQ(typeCheck("(a: array<int>) => { Array.map ((x: int): int => { x + 1 }) a }"),
+              "(Array<Int>->Array<Int>)");
+}
+
+TEST_F(TypeCheckerSpec, ArrayFails) {
+    EXPECT_EQ(typeCheck("[| 1, true |]"), "(1,6)-(1,10) Type error: expected Int, but got Bool");
+    EXPECT_EQ(typeCheck("Array.map ((x: int): bool => { x > 0 }) [| 1 |]"),
+              "(1,11)-(1,38) Type error: expected (Int->Int), but got (Int->Bool)");
+    EXPECT_EQ(typeCheck("[| 1 |].(true)"), "(1,9)-(1,13) Type error: expected Int, but got Bool");
+}
+
+TEST_F(TypeCheckerSpec, LetRecMemoFailsForArrayArguments) {
+    EXPECT_EQ(typeCheck("let rec memo f = (a: array<int>): int => { Array.length a } in f"),
+              "(1,17)-(1,59) Unsupported format: Let rec memo can only be used with functions of "
+              "ints, booleans and code");
+}
+
+// for tuples
+
+TEST_F(TypeCheckerSpec, TupleSucceeds) {
+    EXPECT_EQ(typeCheck("(p: (int * bool)) => { (p.1, p.0 + 1) }"), "((Int*Bool)->(Bool*Int))");
+    EXPECT_EQ(typeCheck("(1, (true, 2)).1.1"), "Int");
+}
+
+TEST_F(TypeCheckerSpec, TupleFails) {
+    EXPECT_EQ(typeCheck("(1, 2).2"),
+              "(1,0)-(1,8) Unsupported format: Cannot take component 2 of (Int*Int)");
+    EXPECT_EQ(typeCheck("(1, true).0 + (1, true).1"),
+              "(1,14)-(1,25) Type error: expected Int, but got Bool");
+}
+
+// for quotation
+
+TEST_F(TypeCheckerSpec, QuoteSucceeds) {
+    EXPECT_EQ(typeCheck("`{@! 1 + 1 }"), "<Int@!>");
+    EXPECT_EQ(typeCheck("`{@! `{@! 1 + 1 }}"), "<<Int@!>@!>");
+}
+
+TEST_F(TypeCheckerSpec, QuoteFailsDueToUndefinedClassifier) {
+    EXPECT_EQ(typeCheck("`{@g 1 + 1 }"), "(1,0)-(1,12) Undefined classifier: g");
+}
+
+TEST_F(TypeCheckerSpec, QuoteFailsDueToIllegalUseOfVariables) {
+    const std::string input = R"lg(
+                let x:int = 1 in
+                `{@! x }
+                )lg";
+    EXPECT_EQ(typeCheck(input), "(3,21)-(3,22) Undefined variable: x");
+}
+
+// for splice
+
+TEST_F(TypeCheckerSpec, SpliceWithInitialClassifier) {
+    EXPECT_EQ(typeCheck("`{@! ~{ `{@! 1 + 1 } } }"), "<Int@!>");
+}
+
+TEST_F(TypeCheckerSpec, SpliceWithNonInitialClassifier) {
+    const std::string input = R"lg(
+                  let x:int@g = 1 in
+                  let double = (y:<int@g>) => {
+                    `{@g ~{y} * 2 }
+                  } in
+                  let z = `{@g x + ~{ double `{@g x } }} in
+                  1
+                )lg";
+    EXPECT_EQ(typeCheck(input), "Int");
+}
+
+TEST_F(TypeCheckerSpec, SpliceRunTimeEvaluation) {
+    const std::string input = R"lg(
+                  let x:int@g = 1 in
+                  let y = `{@g x + 1 } in
+                  ~0{ y }
+                )lg";
+    EXPECT_EQ(typeCheck(input), "Int");
+}
+
+TEST_F(TypeCheckerSpec, SpliceFailsDueToClassifierInconsistency) {
+    const std::string input = R"lg(
+                  let x:int@g = 1 in
+                  let y:<int@g> = `{@g x } in
+                  `{@! 1 + ~{ y } }
+                )lg";
+    EXPECT_EQ(typeCheck(input),
+              "(4,27)-(4,33) Type error: spliced classifier g is inconsistent classifier with !");
+}
+
+// for cross-stage persistence
+
+TEST_F(TypeCheckerSpec, LetCsSucceeds) {
+    EXPECT_EQ(typeCheck("let cs x:int = 1 in `{@! x + 1 }"), "<Int@!>");
+    EXPECT_EQ(typeCheck("let cs x:int = 1 in `{@! (y:int@g) => { x + y } }"), "<(Int->Int)@!>");
+}
+
+TEST_F(TypeCheckerSpec, LetCsFails) {
+    EXPECT_EQ(typeCheck("let cs x:int = true in x"),
+              "(1,15)-(1,19) Type error: expected Int, but got Bool");
+    // The variable does not persist into earlier stages
+    EXPECT_EQ(typeCheck("`{@! let cs x = 1 in ~{ if x == 1 then `{@! 1 } else `{@! 2 } } }"),
+              "(1,27)-(1,28) Undefined variable: x");
+}
+
+TEST_F(TypeCheckerSpec, LetCsPersistsIntoNestedQuotes) {
+    EXPECT_EQ(typeCheck("`{@! let cs x = 1 in ~{ `{@! x + 1 } } }"), "<Int@!>");
+}
+
+// for clsabs and clsapp
+
+TEST_F(TypeCheckerSpec, ClassifierAbstraction) {
+    EXPECT_EQ(typeCheck("[g1:>!](x:<int@g1>)=>{ `{@g1 ~{ x } + 1 } }"),
+              "[g1:>!]((<Int@g1>-><Int@g1>))");
+}
+
+TEST_F(TypeCheckerSpec, ClassifierAbstractionAsArgument) {
+    const std::string input = R"lg(
+                (f:[g1:>!](<int@g1>-><int@g1>))=>{
+                  let y:int@g2 = 10 in
+                  ~0{ f^g2 `{@g2 y } }
+                }
+                )lg";
+    EXPECT_EQ(typeCheck(input), "([g1:>!]((<Int@g1>-><Int@g1>))->Int)");
+}
+
+// for scope extrusion detection
+
+TEST_F(TypeCheckerSpec, ScopeExtrusionLet) {
+    EXPECT_EQ(typeCheck("let x:int@g = 1 in `{@g x }"),
+              "(1,19)-(1,27) Type error: classifier escape detected");
+}
+
+TEST_F(TypeCheckerSpec, ScopeExtrusionLetRecValuePart) {
+    EXPECT_EQ(typeCheck("let rec x@g = (y:int):<int@g> => { `{@g x } } in 1"),
+              "(1,14)-(1,45) Type error: classifier escape detected");
+}
+
+TEST_F(TypeCheckerSpec, ScopeExtrusionLetRecBodyPart) {
+    EXPECT_EQ(typeCheck("let rec x@g = (y:int):int => { y } in `{@g x }"),
+              "(1,38)-(1,46) Type error: classifier escape detected");
+}
+
+TEST_F(TypeCheckerSpec, ScopeExtrusionFunction) {
+    EXPECT_EQ(typeCheck("(x:int@g) => { `{@g x } }"),
+              "(1,0)-(1,25) Type error: classifier escape detected");
+}
+
+} // namespace
+} // namespace lamgamma
@@ -0,0 +1,22 @@
+#include "Var.h"
+
+namespace lamgamma {
+
+bool Var::operator<(Var other) const {
+    if (isRaw() != other.isRaw()) {
+        return isRaw();
+    }
+    if (name != other.name) {
+        return name < other.name;
+    }
+    return id < other.id;
+}
+
+std::string Var::toString() const {
+    if (isRaw()) {
+        return name.name();
+    }
+    return name.name() + "_" + std::to_string(id);
+}
+
+} // namespace lamgamma
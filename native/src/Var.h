@@ -0,0 +1,35 @@
+#ifndef LAMGAMMA_VAR_H_
+#define LAMGAMMA_VAR_H_
+
+#include <cstdint>
+#include <string>
+
+#include "Hash.h"
+#include "Symbol.h"
+
+namespace lamgamma {
+
+// Native counterpart of Var.res. A variable is Raw as written in the source,
+// or Colored with a unique id once the evaluator has renamed it.
+struct Var {
+    Symbol name;
+    uint32_t id = 0; // 0 for Raw
+
+    static Var raw(Symbol name) { return Var{name, 0}; }
+    static Var raw(std::string_view name) { return Var{Symbol::intern(name), 0}; }
+    static Var colored(Symbol name, uint32_t id) { return Var{name, id}; }
+
+    bool isRaw() const { return id == 0; }
+
+    bool operator==(Var other) const { return name == other.name && id == other.id; }
+    bool operator!=(Var other) const { return !(*this == other); }
+    bool operator<(Var other) const;
+
+    uint64_t hash() const { return hashMix(name.id(), id); }
+
+    std::string toString() const;
+};
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_VAR_H_
@@ -0,0 +1,731 @@
+#include "Vm.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "Hash.h"
+
+namespace lamgamma {
+
+namespace {
+
+// Arithmetic goes through uint32_t, where overflow wraps instead of being
+// undefined.
+int32_t wrap(uint32_t v) { return static_cast<int32_t>(v); }
+
+uint32_t u32(int32_t v) { return static_cast<uint32_t>(v); }
+
+constexpr size_t W = kBatchLanes;
+
+// Masks hold -1 in the lanes they select and 0 in the others.
+bool any(const int32_t *mask) {
+    int32_t bits = 0;
+    for (size_t l = 0; l < W; ++l) {
+        bits |= mask[l];
+    }
+    return bits != 0;
+}
+
+// dst[l] := value(l) in the lanes of mask; the others keep their values.
+// value is computed in every lane, so it must not fail in any.
+template <class F>
+void lanes(int32_t *dst, const int32_t *mask, F value) {
+    for (size_t l = 0; l < W; ++l) {
+        int32_t v = value(l);
+        dst[l] = (v & mask[l]) | (dst[l] & ~mask[l]);
+    }
+}
+
+// The lanes of mask whose slot is false go to target, the others to next.
+void branch(const int32_t *slot, const int32_t *mask, bool ifTrue, int32_t *target,
+            int32_t *next) {
+    for (size_t l = 0; l < W; ++l) {
+        int32_t taken = ((slot[l] != 0) == ifTrue) ? mask[l] : 0;
+        target[l] |= taken;
+        next[l] |= mask[l] & ~taken;
+    }
+}
+
+// Batches interpret a function when every jump in it goes forward, so that
+// lanes reach its instructions in order, and it has no code to generate.
+bool batchable(const Function &f) {
+    for (size_t pc = 0; pc < f.code.size(); ++pc) {
+        const Instr &i = f.code[pc];
+        if ((i.op == Op::Jump && static_cast<size_t>(i.a) <= pc) ||
+            ((i.op == Op::JumpIfFalse || i.op == Op::JumpIfTrue) &&
+             static_cast<size_t>(i.b) <= pc) ||
+            i.op >= Op::Fresh) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+std::string toString(const VmError &e) {
+    switch (e.kind) {
+    case VmError::Kind::ZeroDivision:
+        return "division by zero";
+    case VmError::Kind::StackOverflow:
+        return "stack overflow";
+    case VmError::Kind::UnsupportedCode:
+        return "cannot run the generated code";
+    case VmError::Kind::NotUnary:
+        return "not a function of one argument";
+    case VmError::Kind::IndexOutOfBounds:
+        return "index out of bounds";
+    case VmError::Kind::NotAnArray:
+        return "not an array";
+    case VmError::Kind::ArrayTooLong:
+        return "array too long";
+    }
+    return "error";
+}
+
+Vm::Vm(Program program, const VmOptions &options)
+    : program_(std::move(program)), options_(options), states_(program_.functions.size()),
+      stack_(std::max<size_t>(options.stackSlots, 1)), laneFrame_(stack_.data()) {
+    context_.stackEnd = stack_.data() + stack_.size();
+    context_.depth = 0;
+    context_.maxDepth = options_.maxDepth;
+    context_.directCalls = 0;
+    context_.vm = this;
+}
+
+Result<int32_t, VmError> Vm::run(const std::vector<int32_t> &args) {
+    std::copy(args.begin(), args.end(), stack_.begin());
+    ExitStatus status = call(program_.entry, stack_.data());
+    // Recursive calls in compiled code count themselves.
+    stats_.compiledCalls += context_.directCalls;
+    context_.directCalls = 0;
+    context_.depth = 0;
+    switch (status) {
+    case ExitStatus::Ok:
+        return stack_[0];
+    case ExitStatus::ZeroDivision:
+        return fail(VmError{VmError::Kind::ZeroDivision});
+    case ExitStatus::UnsupportedCode:
+        return fail(VmError{VmError::Kind::UnsupportedCode});
+    case ExitStatus::IndexOutOfBounds:
+        return fail(VmError{VmError::Kind::IndexOutOfBounds});
+    case ExitStatus::NotAnArray:
+        return fail(VmError{VmError::Kind::NotAnArray});
+    case ExitStatus::ArrayTooLong:
+        return fail(VmError{VmError::Kind::ArrayTooLong});
+    case ExitStatus::StackOverflow:
+        break;
+    }
+    return fail(VmError{VmError::Kind::StackOverflow});
+}
+
+Result<std::vector<int32_t>, VmError> Vm::runBatch(const std::vector<int32_t> &column) {
+    std::vector<int32_t> results(column.size());
+    auto done = runBatch(column.data(), column.size(), results.data());
+    if (!done) {
+        return fail(done.error());
+    }
+    return results;
+}
+
+Result<size_t, VmError> Vm::runBatch(const int32_t *column, size_t size, int32_t *results) {
+    auto function = batchFunction();
+    if (!function) {
+        return fail(function.error());
+    }
+    if (batchStack_.empty()) {
+        batchStack_.resize(std::max(options_.stackSlots, W));
+        batchMasks_.resize(std::max(options_.stackSlots, W));
+    }
+    int32_t *frame = batchStack_.data();
+    int32_t mask[W];
+    for (size_t start = 0; start < size; start += W) {
+        size_t count = std::min(W, size - start);
+        std::copy(column + start, column + start + count, frame);
+        std::fill(frame + count, frame + W, 0);
+        for (size_t l = 0; l < W; ++l) {
+            mask[l] = l < count ? -1 : 0;
+        }
+        ExitStatus status = callBatch(function.value(), frame, mask);
+        stats_.compiledCalls += context_.directCalls;
+        context_.directCalls = 0;
+        context_.depth = 0;
+        batchMasksTop_ = 0;
+        switch (status) {
+        case ExitStatus::Ok:
+            break;
+        case ExitStatus::ZeroDivision:
+            return fail(VmError{VmError::Kind::ZeroDivision});
+        case ExitStatus::UnsupportedCode:
+            return fail(VmError{VmError::Kind::UnsupportedCode});
+        case ExitStatus::StackOverflow:
+            return fail(VmError{VmError::Kind::StackOverflow});
+        case ExitStatus::IndexOutOfBounds:
+            return fail(VmError{VmError::Kind::IndexOutOfBounds});
+        case ExitStatus::NotAnArray:
+            return fail(VmError{VmError::Kind::NotAnArray});
+        case ExitStatus::ArrayTooLong:
+            return fail(VmError{VmError::Kind::ArrayTooLong});
+        }
+        std::copy(frame, frame + count, results + start);
+    }
+    return size;
+}
+
+Result<uint32_t, VmError> Vm::batchFunction() {
+    if (batchFunction_ >= 0) {
+        return static_cast<uint32_t>(batchFunction_);
+    }
+    const Function &entry = program_.functions[program_.entry];
+    if (entry.resultSize > 1) {
+        return fail(VmError{VmError::Kind::UnsupportedCode});
+    }
+    if (entry.arity == 1) {
+        batchFunction_ = static_cast<int32_t>(program_.entry);
+    } else if (entry.arity == 0 && entry.resultType == ValueType::Code) {
+        auto handle = run({});
+        if (!handle) {
+            return fail(handle.error());
+        }
+        batchFunction_ = generated(handle.value(), 1);
+        if (batchFunction_ < 0) {
+            return fail(VmError{VmError::Kind::UnsupportedCode});
+        }
+    } else {
+        return fail(VmError{VmError::Kind::NotUnary});
+    }
+    return static_cast<uint32_t>(batchFunction_);
+}
+
+// Whether batches interpret function. Functions they do not, and let rec
+// memo functions, whose cache is per call, run once per lane through call.
+bool Vm::batches(uint32_t function) {
+    FunctionState &state = states_[function];
+    if (state.batch == 0) {
+        const Function &f = program_.functions[function];
+        state.batch = !f.memo && batchable(f) ? 1 : -1;
+    }
+    return state.batch > 0;
+}
+
+// Runs function in the lanes of mask.
+ExitStatus Vm::callBatch(uint32_t function, int32_t *frame, const int32_t *mask) {
+    const Function &f = program_.functions[function];
+    if (context_.depth >= context_.maxDepth ||
+        static_cast<size_t>(frame - batchStack_.data()) + f.frameSize * W > batchStack_.size()) {
+        return ExitStatus::StackOverflow;
+    }
+
+    if (!batches(function)) {
+        uint32_t arity = f.arity;
+        uint32_t resultSize = f.resultSize;
+        size_t top = batchFrameTop_;
+        batchFrameTop_ = static_cast<size_t>(frame - batchStack_.data()) + f.frameSize * W;
+        ExitStatus status = ExitStatus::Ok;
+        for (size_t l = 0; l < W && status == ExitStatus::Ok; ++l) {
+            if (mask[l] == 0) {
+                continue;
+            }
+            for (uint32_t k = 0; k < arity; ++k) {
+                laneFrame_[k] = frame[k * W + l];
+            }
+            status = call(function, laneFrame_);
+            for (uint32_t k = 0; k < resultSize; ++k) {
+                frame[k * W + l] = laneFrame_[k];
+            }
+        }
+        batchFrameTop_ = top;
+        return status;
+    }
+
+    ++stats_.batchCalls;
+    ++context_.depth;
+    ExitStatus status = interpretBatch(f, frame, mask);
+    --context_.depth;
+    return status;
+}
+
+// Every lane has its own program counter, but as jumps only go forward,
+// the lanes can step through the instructions together: pending holds,
+// for each instruction, the mask of the lanes that have reached it. An
+// instruction runs once in all of its lanes and passes them on to the
+// instructions they go to next, where they join the lanes that came
+// another way. A Return retires its lanes.
+ExitStatus Vm::interpretBatch(const Function &f, int32_t *frame, const int32_t *mask) {
+    const Instr *code = f.code.data();
+    size_t size = f.code.size();
+    if (batchMasksTop_ + size * W > batchMasks_.size()) {
+        return ExitStatus::StackOverflow;
+    }
+    int32_t *pending = batchMasks_.data() + batchMasksTop_;
+    batchMasksTop_ += size * W;
+    std::fill(pending, pending + size * W, 0);
+    std::copy(mask, mask + W, pending);
+
+    auto slot = [frame](int32_t s) { return frame + static_cast<size_t>(s) * W; };
+    ExitStatus status = ExitStatus::Ok;
+    for (size_t pc = 0; pc < size && status == ExitStatus::Ok; ++pc) {
+        const int32_t *m = pending + pc * W;
+        if (!any(m)) {
+            continue;
+        }
+        const Instr &i = code[pc];
+        int32_t *next = pc + 1 < size ? pending + (pc + 1) * W : nullptr;
+        auto binary = [&](auto op) {
+            const int32_t *b = slot(i.b);
+            const int32_t *c = slot(i.c);
+            lanes(slot(i.a), m, [&](size_t l) { return op(b[l], c[l]); });
+        };
+        switch (i.op) {
+        case Op::LoadInt:
+            lanes(slot(i.a), m, [&](size_t) { return i.b; });
+            break;
+        case Op::Move: {
+            const int32_t *b = slot(i.b);
+            lanes(slot(i.a), m, [&](size_t l) { return b[l]; });
+            break;
+        }
+        case Op::Add:
+            binary([](int32_t x, int32_t y) { return wrap(u32(x) + u32(y)); });
+            break;
+        case Op::Sub:
+            binary([](int32_t x, int32_t y) { return wrap(u32(x) - u32(y)); });
+            break;
+        case Op::Mul:
+            binary([](int32_t x, int32_t y) { return wrap(u32(x) * u32(y)); });
+            break;
+        case Op::Div:
+        case Op::Mod: {
+            const int32_t *c = slot(i.c);
+            int32_t zero = 0;
+            for (size_t l = 0; l < W; ++l) {
+                zero |= c[l] == 0 ? m[l] : 0;
+            }
+            if (zero != 0) {
+                status = ExitStatus::ZeroDivision;
+                break;
+            }
+            // Lanes outside the mask may hold zero; they divide by one.
+            if (i.op == Op::Div) {
+                binary([](int32_t x, int32_t y) {
+                    y = y == 0 ? 1 : y;
+                    return y == -1 ? wrap(0u - u32(x)) : x / y;
+                });
+            } else {
+                binary([](int32_t x, int32_t y) {
+                    y = y == 0 ? 1 : y;
+                    return y == -1 ? 0 : x % y;
+                });
+            }
+            break;
+        }
+        case Op::Eq:
+            binary([](int32_t x, int32_t y) { return static_cast<int32_t>(x == y); });
+            break;
+        case Op::Ne:
+            binary([](int32_t x, int32_t y) { return static_cast<int32_t>(x != y); });
+            break;
+        case Op::Lt:
+            binary([](int32_t x, int32_t y) { return static_cast<int32_t>(x < y); });
+            break;
+        case Op::Le:
+            binary([](int32_t x, int32_t y) { return static_cast<int32_t>(x <= y); });
+            break;
+        case Op::Gt:
+            binary([](int32_t x, int32_t y) { return static_cast<int32_t>(x > y); });
+            break;
+        case Op::Ge:
+            binary([](int32_t x, int32_t y) { return static_cast<int32_t>(x >= y); });
+            break;
+        case Op::Not: {
+            const int32_t *b = slot(i.b);
+            lanes(slot(i.a), m, [&](size_t l) { return b[l] ^ 1; });
+            break;
+        }
+        case Op::Jump:
+            lanes(pending + static_cast<size_t>(i.a) * W, m, [](size_t) { return -1; });
+            continue;
+        case Op::JumpIfFalse:
+        case Op::JumpIfTrue:
+            branch(slot(i.a), m, i.op == Op::JumpIfTrue, pending + static_cast<size_t>(i.b) * W, next);
+            continue;
+        case Op::Call: {
+            int32_t *callee = slot(i.c);
+            status = callBatch(static_cast<uint32_t>(i.b), callee, m);
+            if (status == ExitStatus::Ok) {
+                lanes(slot(i.a), m, [&](size_t l) { return callee[l]; });
+            }
+            break;
+        }
+        case Op::Return: {
+            const int32_t *result = slot(i.a);
+            lanes(frame, m, [&](size_t l) { return result[l]; });
+            continue;
+        }
+        // Refused by batchable.
+        case Op::Fresh:
+        case Op::Quote:
+        case Op::Run:
+        case Op::Hole:
+        case Op::Free:
+        case Op::NewArray:
+        case Op::ArrayLength:
+        case Op::ArrayGet:
+        case Op::ArrayInit:
+        case Op::ArrayMap:
+        case Op::ArrayFold:
+            status = ExitStatus::UnsupportedCode;
+            break;
+        }
+        if (next != nullptr) {
+            lanes(next, m, [](size_t) { return -1; });
+        }
+    }
+    batchMasksTop_ -= size * W;
+    return status;
+}
+
+ExitStatus Vm::callHelper(JitContext *context, uint32_t function, int32_t *frame) {
+    return static_cast<Vm *>(context->vm)->call(function, frame);
+}
+
+size_t Vm::ArgsHash::operator()(const std::vector<int32_t> &args) const {
+    uint64_t h = 0;
+    for (int32_t arg : args) {
+        h = hashMix(h, static_cast<uint32_t>(arg));
+    }
+    return static_cast<size_t>(h);
+}
+
+ExitStatus Vm::call(uint32_t function, int32_t *frame) {
+    const Function &f = program_.functions[function];
+    if (context_.depth >= context_.maxDepth ||
+        static_cast<size_t>(frame - stack_.data()) + f.frameSize > stack_.size()) {
+        return ExitStatus::StackOverflow;
+    }
+
+    FunctionState &state = states_[function];
+    // f may move while the function runs, as generated code is added.
+    bool memo = f.memo;
+    uint32_t resultSize = f.resultSize;
+    std::vector<int32_t> args;
+    if (memo) {
+        args.assign(frame, frame + f.arity);
+        auto cached = state.memo.find(args);
+        if (cached != state.memo.end()) {
+            ++stats_.memoHits;
+            auto results = state.memoResults.begin() + static_cast<std::ptrdiff_t>(cached->second);
+            std::copy(results, results + resultSize, frame);
+            return ExitStatus::Ok;
+        }
+        ++stats_.memoMisses;
+    }
+
+    if (state.code == nullptr && !state.uncompilable && options_.jit &&
+        ++state.calls >= options_.hotThreshold) {
+        state.code = jitCompile(f, function, &Vm::callHelper);
+        state.uncompilable = state.code == nullptr;
+        if (state.code != nullptr) {
+            ++stats_.compiledFunctions;
+        }
+    }
+
+    ++context_.depth;
+    ExitStatus status;
+    if (state.code != nullptr) {
+        ++stats_.compiledCalls;
+        status = state.code->entry()(&context_, frame);
+    } else {
+        ++stats_.interpretedCalls;
+        status = interpret(f, frame);
+    }
+    --context_.depth;
+    if (memo && status == ExitStatus::Ok && options_.memoCapacity > 0) {
+        if (state.memo.size() >= options_.memoCapacity) {
+            state.memo.clear();
+            state.memoResults.clear();
+        }
+        state.memo.emplace(std::move(args), state.memoResults.size());
+        state.memoResults.insert(state.memoResults.end(), frame, frame + resultSize);
+    }
+    return status;
+}
+
+ExitStatus Vm::interpret(const Function &f, int32_t *frame) {
+    const Instr *code = f.code.data();
+    const Instr *pc = code;
+    for (;;) {
+        const Instr &i = *pc++;
+        auto u = [frame](int32_t slot) { return static_cast<uint32_t>(frame[slot]); };
+        switch (i.op) {
+        case Op::LoadInt:
+            frame[i.a] = i.b;
+            break;
+        case Op::Move:
+            frame[i.a] = frame[i.b];
+            break;
+        case Op::Add:
+            frame[i.a] = wrap(u(i.b) + u(i.c));
+            break;
+        case Op::Sub:
+            frame[i.a] = wrap(u(i.b) - u(i.c));
+            break;
+        case Op::Mul:
+            frame[i.a] = wrap(u(i.b) * u(i.c));
+            break;
+        // The minimum divided by -1 overflows; it wraps to itself.
+        case Op::Div:
+            if (frame[i.c] == 0) {
+                return ExitStatus::ZeroDivision;
+            }
+            frame[i.a] = frame[i.c] == -1 ? wrap(0u - u(i.b)) : frame[i.b] / frame[i.c];
+            break;
+        case Op::Mod:
+            if (frame[i.c] == 0) {
+                return ExitStatus::ZeroDivision;
+            }
+            frame[i.a] = frame[i.c] == -1 ? 0 : frame[i.b] % frame[i.c];
+            break;
+        case Op::Eq:
+            frame[i.a] = frame[i.b] == frame[i.c];
+            break;
+        case Op::Ne:
+            frame[i.a] = frame[i.b] != frame[i.c];
+            break;
+        case Op::Lt:
+            frame[i.a] = frame[i.b] < frame[i.c];
+            break;
+        case Op::Le:
+            frame[i.a] = frame[i.b] <= frame[i.c];
+            break;
+        case Op::Gt:
+            frame[i.a] = frame[i.b] > frame[i.c];
+            break;
+        case Op::Ge:
+            frame[i.a] = frame[i.b] >= frame[i.c];
+            break;
+        case Op::Not:
+            frame[i.a] = frame[i.b] ^ 1;
+            break;
+        case Op::Jump:
+            pc = code + i.a;
+            break;
+        case Op::JumpIfFalse:
+            if (frame[i.a] == 0) {
+                pc = code + i.b;
+            }
+            break;
+        case Op::JumpIfTrue:
+            if (frame[i.a] != 0) {
+                pc = code + i.b;
+            }
+            break;
+        case Op::Call: {
+            ExitStatus status = call(static_cast<uint32_t>(i.b), frame + i.c);
+            if (status != ExitStatus::Ok) {
+                return status;
+            }
+            frame[i.a] = frame[i.c];
+            break;
+        }
+        case Op::Return:
+            frame[0] = frame[i.a];
+            return ExitStatus::Ok;
+        case Op::Fresh:
+            frame[i.a] = ++names_;
+            break;
+        case Op::Quote: {
+            auto fragment = instantiate(program_.templates[i.b], frame + i.c, fragments_);
+            if (!fragment) {
+                return ExitStatus::UnsupportedCode;
+            }
+            frame[i.a] = addFragment(std::move(fragment.value()));
+            break;
+        }
+        case Op::Run: {
+            int32_t function = generated(frame[i.b], i.c);
+            if (function < 0) {
+                return ExitStatus::UnsupportedCode;
+            }
+            ExitStatus status = call(static_cast<uint32_t>(function), frame + i.b + 1);
+            if (status != ExitStatus::Ok) {
+                return status;
+            }
+            frame[i.a] = frame[i.b + 1];
+            break;
+        }
+        case Op::NewArray:
+            arrays_.emplace_back(frame + i.b, frame + i.b + i.c);
+            frame[i.a] = static_cast<int32_t>(arrays_.size() - 1);
+            break;
+        case Op::ArrayLength:
+            if (!isArray(frame[i.b])) {
+                return ExitStatus::NotAnArray;
+            }
+            frame[i.a] = static_cast<int32_t>(arrays_[frame[i.b]].size());
+            break;
+        case Op::ArrayGet:
+            if (!isArray(frame[i.b])) {
+                return ExitStatus::NotAnArray;
+            }
+            if (u(i.c) >= arrays_[frame[i.b]].size()) {
+                return ExitStatus::IndexOutOfBounds;
+            }
+            frame[i.a] = arrays_[frame[i.b]][u(i.c)];
+            break;
+        case Op::ArrayInit:
+        case Op::ArrayMap: {
+            std::vector<int32_t> values;
+            if (i.op == Op::ArrayInit) {
+                if (frame[i.b] < 0) {
+                    return ExitStatus::IndexOutOfBounds;
+                }
+                if (u(i.b) > options_.maxArrayLength) {
+                    return ExitStatus::ArrayTooLong;
+                }
+                values.resize(u(i.b));
+                std::iota(values.begin(), values.end(), 0);
+            } else if (isArray(frame[i.b])) {
+                values = arrays_[frame[i.b]];
+            } else {
+                return ExitStatus::NotAnArray;
+            }
+            ExitStatus status = mapArray(static_cast<uint32_t>(i.c), values, frame + i.b);
+            if (status != ExitStatus::Ok) {
+                return status;
+            }
+            arrays_.push_back(std::move(values));
+            frame[i.a] = static_cast<int32_t>(arrays_.size() - 1);
+            break;
+        }
+        // The function makes arrays of its own, which may move the elements.
+        case Op::ArrayFold: {
+            int32_t handle = frame[i.b + 1];
+            if (!isArray(handle)) {
+                return ExitStatus::NotAnArray;
+            }
+            int32_t acc = frame[i.b];
+            for (size_t k = 0; k < arrays_[handle].size(); ++k) {
+                frame[i.b] = acc;
+                frame[i.b + 1] = arrays_[handle][k];
+                ExitStatus status = call(static_cast<uint32_t>(i.c), frame + i.b);
+                if (status != ExitStatus::Ok) {
+                    return status;
+                }
+                acc = frame[i.b];
+            }
+            frame[i.a] = acc;
+            break;
+        }
+        case Op::Hole:
+        case Op::Free:
+            return ExitStatus::UnsupportedCode;
+        }
+    }
+}
+
+bool Vm::isArray(int32_t handle) const {
+    return handle >= 0 && static_cast<size_t>(handle) < arrays_.size();
+}
+
+// Replaces each of values by function applied to it. When batches run the
+// function, it goes over kBatchLanes values at a time, which makes the
+// loop over the elements a loop of SIMD instructions; otherwise each call
+// runs on frame.
+ExitStatus Vm::mapArray(uint32_t function, std::vector<int32_t> &values, int32_t *frame) {
+    if (!batches(function)) {
+        for (int32_t &value : values) {
+            frame[0] = value;
+            ExitStatus status = call(function, frame);
+            if (status != ExitStatus::Ok) {
+                return status;
+            }
+            value = frame[0];
+        }
+        return ExitStatus::Ok;
+    }
+
+    if (batchStack_.empty()) {
+        batchStack_.resize(std::max(options_.stackSlots, W));
+        batchMasks_.resize(std::max(options_.stackSlots, W));
+    }
+    if (batchFrameTop_ + W > batchStack_.size()) {
+        return ExitStatus::StackOverflow;
+    }
+    int32_t *batchFrame = batchStack_.data() + batchFrameTop_;
+    int32_t *lane = laneFrame_;
+    laneFrame_ = frame;
+    int32_t mask[W];
+    ExitStatus status = ExitStatus::Ok;
+    for (size_t start = 0; start < values.size() && status == ExitStatus::Ok; start += W) {
+        size_t count = std::min(W, values.size() - start);
+        std::copy(values.begin() + start, values.begin() + start + count, batchFrame);
+        std::fill(batchFrame + count, batchFrame + W, 0);
+        for (size_t l = 0; l < W; ++l) {
+            mask[l] = l < count ? -1 : 0;
+        }
+        status = callBatch(function, batchFrame, mask);
+        std::copy(batchFrame, batchFrame + count, values.begin() + start);
+    }
+    laneFrame_ = lane;
+    return status;
+}
+
+// The handle of fragment: that of an equal fragment made before, or a new
+// one. Memo keys rely on equal code having one handle.
+int32_t Vm::addFragment(Fragment fragment) {
+    uint64_t h = hashMix(fragment.arity, fragment.frameSize);
+    for (const Instr &instr : fragment.code) {
+        h = hashMix(h, static_cast<uint64_t>(instr.op));
+        h = hashMix(h, static_cast<uint32_t>(instr.a));
+        h = hashMix(h, static_cast<uint32_t>(instr.b));
+        h = hashMix(h, static_cast<uint32_t>(instr.c));
+    }
+    std::vector<int32_t> &handles = fragmentHandles_[h];
+    for (int32_t handle : handles) {
+        const Fragment &other = fragments_[handle];
+        if (other.arity == fragment.arity && other.frameSize == fragment.frameSize &&
+            std::equal(other.code.begin(), other.code.end(), fragment.code.begin(),
+                       fragment.code.end(), [](const Instr &x, const Instr &y) {
+                           return x.op == y.op && x.a == y.a && x.b == y.b && x.c == y.c;
+                       })) {
+            return handle;
+        }
+    }
+    fragments_.push_back(std::move(fragment));
+    fragmentFunctions_.push_back(-1);
+    handles.push_back(static_cast<int32_t>(fragments_.size() - 1));
+    return handles.back();
+}
+
+// The function running the fragment handle, made on its first run. -1 when
+// handle is not code, the code takes other than arity arguments, or it
+// still refers to variables of a quote.
+int32_t Vm::generated(int32_t handle, int32_t arity) {
+    if (handle < 0 || static_cast<size_t>(handle) >= fragments_.size()) {
+        return -1;
+    }
+    const Fragment &fragment = fragments_[handle];
+    if (fragment.arity != static_cast<uint32_t>(arity)) {
+        return -1;
+    }
+    if (fragmentFunctions_[handle] < 0) {
+        for (const Instr &instr : fragment.code) {
+            if (instr.op == Op::Free) {
+                return -1;
+            }
+        }
+        Function f;
+        f.name = "generated" + std::to_string(handle);
+        f.arity = fragment.arity;
+        f.frameSize = fragment.frameSize;
+        f.code = fragment.code;
+        fragmentFunctions_[handle] = static_cast<int32_t>(program_.functions.size());
+        program_.functions.push_back(std::move(f));
+        states_.emplace_back();
+    }
+    return fragmentFunctions_[handle];
+}
+
+} // namespace lamgamma
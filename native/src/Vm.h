@@ -0,0 +1,174 @@
+#ifndef LAMGAMMA_VM_H_
+#define LAMGAMMA_VM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Bytecode.h"
+#include "Jit.h"
+#include "Result.h"
+
+namespace lamgamma {
+
+// Runs bytecode programs. Every function starts out interpreted; once it
+// has been called hotThreshold times it is compiled to machine code
+// (Jit.h), which later calls use. The language has no loops, so calls are
+// the only counter. Functions the JIT cannot compile stay interpreted.
+//
+// Functions bound by let rec memo keep their results by arguments, at most
+// memoCapacity of them; a full cache is emptied before the next result is
+// added. Code arguments are keys by their handles, which compare code
+// structurally, as the playground does: generating code equal to a
+// fragment made before returns that fragment's handle.
+//
+// A batch (runBatch) applies a function of one argument to a column of
+// values, kBatchLanes at a time. Every slot of a batch frame holds one
+// value per lane, the lanes next to each other, so that each instruction
+// is a loop over the lanes that the compiler turns into SIMD arithmetic.
+// Lanes that take different branches of an if run under masks; see
+// Vm::interpretBatch.
+//
+// Code a program generates is kept for the life of the Vm. Running a
+// fragment for the first time turns it into a function of the program,
+// which is then counted and compiled like any other. So are the arrays a
+// program makes. Array.map and Array.init apply their function through
+// the batch interpreter, kBatchLanes elements at a time, when it can run
+// the function.
+constexpr size_t kBatchLanes = 64;
+
+struct VmOptions {
+    bool jit = true;
+    uint32_t hotThreshold = 2;
+    // Frame slots for the whole call stack.
+    size_t stackSlots = size_t{1} << 20;
+    // Nested calls before StackOverflow, which bounds the native stack the
+    // interpreter and compiled code use as well.
+    uint32_t maxDepth = 10000;
+    size_t memoCapacity = 4096;
+    // Elements Array.init makes at most before ArrayTooLong, so that one
+    // length cannot ask for unbounded memory.
+    size_t maxArrayLength = size_t{1} << 24;
+};
+
+struct VmError {
+    enum class Kind : uint8_t {
+        ZeroDivision,
+        StackOverflow,
+        UnsupportedCode,
+        NotUnary,
+        IndexOutOfBounds,
+        NotAnArray,
+        ArrayTooLong,
+    };
+
+    Kind kind;
+};
+
+std::string toString(const VmError &e);
+
+struct VmStats {
+    uint64_t interpretedCalls = 0;
+    uint64_t compiledCalls = 0;
+    uint32_t compiledFunctions = 0;
+    uint64_t memoHits = 0;
+    uint64_t memoMisses = 0;
+    // Calls the batch interpreter made, each over up to kBatchLanes values.
+    uint64_t batchCalls = 0;
+};
+
+class Vm {
+  public:
+    explicit Vm(Program program, const VmOptions &options = {});
+    Vm(const Vm &) = delete;
+    Vm &operator=(const Vm &) = delete;
+
+    // Applies the entry function to args, which holds its arity values.
+    Result<int32_t, VmError> run(const std::vector<int32_t> &args);
+
+    // Applies the batch function to each of the size values of column and
+    // leaves its results in results, in the same order. The batch function
+    // is the entry function when it takes one argument; when it takes none,
+    // the function of one argument whose code the entry function generates,
+    // which the first batch runs it for. A batch fails as a whole when the
+    // function fails on any of its values. Returns size.
+    Result<size_t, VmError> runBatch(const int32_t *column, size_t size, int32_t *results);
+    Result<std::vector<int32_t>, VmError> runBatch(const std::vector<int32_t> &column);
+
+    const Program &program() const { return program_; }
+    const VmStats &stats() const { return stats_; }
+    bool isCompiled(uint32_t function) const { return states_[function].code != nullptr; }
+    const std::vector<Fragment> &fragments() const { return fragments_; }
+    // The elements of the array handle, a result of a program.
+    const std::vector<int32_t> &array(int32_t handle) const { return arrays_.at(handle); }
+
+  private:
+    struct ArgsHash {
+        size_t operator()(const std::vector<int32_t> &args) const;
+    };
+
+    struct FunctionState {
+        uint32_t calls = 0;
+        std::unique_ptr<JitCode> code;
+        bool uncompilable = false;
+        // The results of a let rec memo function: by arguments, where in
+        // memoResults its resultSize slots start.
+        std::unordered_map<std::vector<int32_t>, size_t, ArgsHash> memo;
+        std::vector<int32_t> memoResults;
+        // 1 when batches interpret the function, -1 when they call it once
+        // per lane, 0 until its first batch call.
+        int8_t batch = 0;
+    };
+
+    static ExitStatus callHelper(JitContext *context, uint32_t function, int32_t *frame);
+
+    ExitStatus call(uint32_t function, int32_t *frame);
+    ExitStatus interpret(const Function &f, int32_t *frame);
+    int32_t addFragment(Fragment fragment);
+    int32_t generated(int32_t handle, int32_t arity);
+    bool isArray(int32_t handle) const;
+    ExitStatus mapArray(uint32_t function, std::vector<int32_t> &values, int32_t *frame);
+
+    Result<uint32_t, VmError> batchFunction();
+    bool batches(uint32_t function);
+    ExitStatus callBatch(uint32_t function, int32_t *frame, const int32_t *mask);
+    ExitStatus interpretBatch(const Function &f, int32_t *frame, const int32_t *mask);
+
+    // Generated functions are appended while others run: the interpreter
+    // holds on to the code of a function, which moves along with it, and
+    // states_ is a deque so that call's reference stays valid.
+    Program program_;
+    VmOptions options_;
+    std::deque<FunctionState> states_;
+    std::vector<int32_t> stack_;
+    std::vector<Fragment> fragments_;
+    // For each fragment, the function running it, or -1.
+    std::vector<int32_t> fragmentFunctions_;
+    // The handles of fragments by a hash of their code.
+    std::unordered_map<uint64_t, std::vector<int32_t>> fragmentHandles_;
+    int32_t names_ = 0;
+    std::vector<std::vector<int32_t>> arrays_;
+    int32_t batchFunction_ = -1;
+    // Batch frames, slot by slot with kBatchLanes values each, and the
+    // masks of the activations running on them. Allocated by the first
+    // batch.
+    std::vector<int32_t> batchStack_;
+    std::vector<int32_t> batchMasks_;
+    size_t batchMasksTop_ = 0;
+    // Batches nest when a function a batch runs once per lane maps an
+    // array: the nested batch's frames start at batchFrameTop_, and the
+    // frame of stack_ that lanes run on is laneFrame_.
+    size_t batchFrameTop_ = 0;
+    int32_t *laneFrame_;
+    // Also holds the call depth.
+    JitContext context_;
+    VmStats stats_;
+};
+
+} // namespace lamgamma
+
+#endif // LAMGAMMA_VM_H_
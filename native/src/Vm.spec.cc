@@ -0,0 +1,572 @@
+// Cases for the bytecode VM. Each program runs interpreted only and with
+// every function compiled on its first call, and both must agree.
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <tree_sitter/api.h>
+
+#include "Arena.h"
+#include "Bytecode.h"
+#include "Frontend.h"
+#include "RawExpr.h"
+#include "SyntaxNodeParser.h"
+#include "Vm.h"
+#include "tree-sitter-lamgamma_parser.h"
+
+namespace lamgamma {
+namespace {
+
+bool usesArrays(const Program &program) {
+    for (const Function &f : program.functions) {
+        for (const Instr &i : f.code) {
+            if (i.op >= Op::NewArray && i.op <= Op::ArrayFold) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+class VmSpec : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        parser_ = ts_parser_new();
+        ts_parser_set_language(parser_, tree_sitter_lamgamma_parser());
+    }
+
+    void TearDown() override {
+        for (TSTree *tree : trees_) {
+            ts_tree_delete(tree);
+        }
+        ts_parser_delete(parser_);
+    }
+
+    // Assume that parse always succeeds
+    const RawExpr *parse(const std::string &input) {
+        sources_.push_back(input);
+        const std::string &source = sources_.back();
+        TSTree *tree = ts_parser_parse_string(parser_, nullptr, source.data(), source.size());
+        trees_.push_back(tree);
+        SyntaxNodeParser syntaxNodeParser(arena_, source);
+        return stripTypeInfo(syntaxNodeParser.parseSourceFileNode(ts_tree_root_node(tree)).value(),
+                             arena_);
+    }
+
+    // Assume that compilation succeeds
+    Program compile(const std::string &input) {
+        auto program = compileBytecode(parse(input));
+        EXPECT_TRUE(program.isOk()) << (program.isOk() ? "" : program.error().message);
+        return std::move(program.value());
+    }
+
+    // Runs input both ways and returns the result, or -1 after a failure.
+    int32_t run(const std::string &input, std::vector<int32_t> args = {}) {
+        VmOptions interpreted;
+        interpreted.jit = false;
+        VmOptions compiled;
+        compiled.hotThreshold = 1;
+
+        Vm slow(compile(input), interpreted);
+        Vm fast(compile(input), compiled);
+        auto expected = slow.run(args);
+        auto actual = fast.run(args);
+        EXPECT_TRUE(expected.isOk()) << input;
+        EXPECT_TRUE(actual.isOk()) << input;
+        if (!expected || !actual) {
+            return -1;
+        }
+        EXPECT_EQ(actual.value(), expected.value()) << input;
+        EXPECT_EQ(slow.stats().compiledCalls, 0u);
+        // Code generation and arrays are always interpreted.
+        if (jitAvailable() && fast.program().templates.empty() && !usesArrays(fast.program())) {
+            EXPECT_EQ(fast.stats().interpretedCalls, 0u);
+        }
+        return actual.value();
+    }
+
+    // Streams the values through input with Frontend::stream in chunks of
+    // 100 and returns what it wrote, or an error message. With out naming
+    // the column file, the results are to be written over it.
+    template <class T>
+    std::variant<std::vector<T>, std::string> stream(const std::string &input,
+                                                     const std::vector<T> &values,
+                                                     std::string out = "") {
+        std::string in = ::testing::TempDir() + "lamgamma-column";
+        if (out.empty()) {
+            out = ::testing::TempDir() + "lamgamma-results";
+        }
+        std::ofstream(in, std::ios::binary)
+            .write(reinterpret_cast<const char *>(values.data()),
+                   static_cast<std::streamsize>(values.size() * sizeof(T)));
+        Frontend::StreamOptions options;
+        options.chunkValues = 100;
+        std::string error = Frontend::stream(
+            input, parser_, in.c_str(), out.c_str(),
+            sizeof(T) == 4 ? Frontend::ColumnWidth::Int32 : Frontend::ColumnWidth::Int64, options);
+        if (!error.empty()) {
+            return error;
+        }
+        std::ifstream results(out, std::ios::binary);
+        std::string bytes{std::istreambuf_iterator<char>(results), std::istreambuf_iterator<char>()};
+        std::vector<T> written(bytes.size() / sizeof(T));
+        std::copy(bytes.begin(), bytes.end(), reinterpret_cast<char *>(written.data()));
+        return written;
+    }
+
+    // Frontend::run's output, or its error message.
+    std::string runChecked(const std::string &input, const std::vector<int32_t> &args = {}) {
+        std::string output;
+        std::string error = Frontend::run(input, parser_, args, &output);
+        return error.empty() ? output : error;
+    }
+
+    // Frontend::evaluate's output, or nullopt when it declines the program.
+    std::optional<std::string> evaluate(const std::string &input) {
+        std::string output;
+        if (!Frontend::evaluate(input, parser_, &output)) {
+            return std::nullopt;
+        }
+        return output;
+    }
+
+  private:
+    TSParser *parser_ = nullptr;
+    Arena arena_;
+    std::vector<std::string> sources_;
+    std::vector<TSTree *> trees_;
+};
+
+const char *kFib = "let rec fib = (n:int):int => { if n <= 1 then 1 else fib(n - 1) + fib(n - 2) } "
+                   "in fib 20";
+
+TEST_F(VmSpec, RunsRecursivePrograms) {
+    EXPECT_EQ(run(kFib), 10946);
+    EXPECT_EQ(run("let rec gcd = (a, b) => { if b == 0 then a else gcd b (a mod b) } in "
+                  "gcd 1071 462"),
+              21);
+    EXPECT_EQ(run("let sq = (x) => { x * x } in "
+                  "let rec sum = (n) => { if n == 0 then 0 else sq n + sum (n - 1) } in sum 100"),
+              338350);
+}
+
+TEST_F(VmSpec, CompilesHotFunctions) {
+    Vm vm(compile(kFib));
+    ASSERT_EQ(vm.run({}).value(), 10946);
+    if (!jitAvailable()) {
+        GTEST_SKIP() << "no JIT for this host";
+    }
+    // main runs once; fib is hot after its second call.
+    EXPECT_FALSE(vm.isCompiled(0));
+    EXPECT_TRUE(vm.isCompiled(1));
+    EXPECT_EQ(vm.stats().compiledFunctions, 1u);
+    EXPECT_EQ(vm.stats().interpretedCalls, 2u);
+    EXPECT_EQ(vm.stats().compiledCalls, 21890u);
+}
+
+TEST_F(VmSpec, MemoizesResults) {
+    const char *fib = "let rec memo fib = (n) => { if n <= 1 then n else fib (n - 1) + fib (n - 2) } "
+                      "in fib 40";
+    EXPECT_EQ(run(fib), 102334155);
+
+    // Each result is computed once; fib (n - 2) then comes from the cache.
+    Vm vm(compile(fib));
+    ASSERT_EQ(vm.run({}).value(), 102334155);
+    EXPECT_EQ(vm.stats().memoMisses, 41u);
+    EXPECT_EQ(vm.stats().memoHits, 38u);
+
+    VmOptions uncached;
+    uncached.memoCapacity = 0;
+    Vm slow(compile("let rec memo fib = (n) => { if n <= 1 then n else fib (n - 1) + fib (n - 2) } "
+                    "in fib 20"),
+            uncached);
+    ASSERT_EQ(slow.run({}).value(), 6765);
+    EXPECT_EQ(slow.stats().memoMisses, 21891u);
+    EXPECT_EQ(slow.stats().memoHits, 0u);
+}
+
+TEST_F(VmSpec, KeysMemoizedCodeStructurally) {
+    // As in the playground, equal code from two quotes is one key.
+    Vm vm(compile("let rec memo twice = (c) => { `{ ~{ c } + ~{ c } } } in "
+                  "let a = twice `{ 1 } in ~0{ twice `{ 1 } }"));
+    ASSERT_EQ(vm.run({}).value(), 2);
+    EXPECT_EQ(vm.stats().memoMisses, 1u);
+    EXPECT_EQ(vm.stats().memoHits, 1u);
+}
+
+TEST_F(VmSpec, RunsGeneratedFunctions) {
+    // spower 5, as the playground prints it
+    const char *pow5 = "(x_1) => { (let genlet_2 = (x_1 * x_1) in (let genlet_3 = "
+                       "(genlet_2 * genlet_2) in (x_1 * genlet_3))) }";
+    EXPECT_EQ(run(pow5, {2}), 32);
+    EXPECT_EQ(run(pow5, {-3}), -243);
+    EXPECT_EQ(compile(pow5).functions[0].arity, 1u);
+}
+
+TEST_F(VmSpec, ComputesBooleans) {
+    Program program = compile("let rec even = (n) => { if n == 0 then true else !(even (n - 1)) } "
+                              "in even 7 || 1 > 2 && false");
+    EXPECT_EQ(program.functions[0].resultType, ValueType::Bool);
+    EXPECT_EQ(run("let rec even = (n) => { if n == 0 then true else !(even (n - 1)) } in "
+                  "even 7 || 1 > 2 && false"),
+              0);
+    EXPECT_EQ(run("(x, y) => { x != y && (x >= y || !(x <= 0)) }", {3, 2}), 1);
+    EXPECT_EQ(run("(x, y) => { x != y && (x >= y || !(x <= 0)) }", {-1, 2}), 0);
+}
+
+TEST_F(VmSpec, WrapsLikeThePlayground) {
+    constexpr int32_t min = std::numeric_limits<int32_t>::min();
+    constexpr int32_t max = std::numeric_limits<int32_t>::max();
+    EXPECT_EQ(run("(x) => { x * x }", {65536}), 0);
+    EXPECT_EQ(run("(x) => { x + 1 }", {max}), min);
+    EXPECT_EQ(run("(x) => { x - 1 }", {min}), max);
+    for (int32_t x : {min, -7, 0, 7, max}) {
+        for (int32_t y : {min, -3, -1, 1, 3, max}) {
+            run("(x, y) => { x / y }", {x, y});
+            run("(x, y) => { x mod y }", {x, y});
+            run("(x, y) => { x < y }", {x, y});
+        }
+    }
+    EXPECT_EQ(run("(x, y) => { x / y }", {min, -1}), min);
+    EXPECT_EQ(run("(x, y) => { x mod y }", {min, -1}), 0);
+    EXPECT_EQ(run("(x, y) => { x mod y }", {-7, 3}), -1);
+}
+
+TEST_F(VmSpec, ReportsRuntimeErrors) {
+    for (bool jit : {false, true}) {
+        VmOptions options;
+        options.jit = jit;
+        options.hotThreshold = 1;
+
+        Vm divide(compile("let rec f = (n) => { if n == 0 then 1 / n else f (n - 1) } in f 3"),
+                  options);
+        auto quotient = divide.run({});
+        ASSERT_FALSE(quotient.isOk());
+        EXPECT_EQ(quotient.error().kind, VmError::Kind::ZeroDivision);
+
+        Vm loop(compile("let rec loop = (n) => { loop (n + 1) } in loop 0"), options);
+        auto forever = loop.run({});
+        ASSERT_FALSE(forever.isOk());
+        EXPECT_EQ(forever.error().kind, VmError::Kind::StackOverflow);
+    }
+}
+
+TEST_F(VmSpec, RejectsProgramsOutsideTheFragment) {
+    for (const char *code : {"(f) => { f 1 }", "let f = (x) => { x } in f",
+                             "let rec f = (x, y) => { x } in f 1",
+                             "let y = 1 in let f = (x) => { x + y } in f 2", "`{ (f) => { f 1 } }",
+                             "(x) => { (y) => { x } }", "let rec x = 1 in x", "y"}) {
+        EXPECT_FALSE(compileBytecode(parse(code)).isOk()) << code;
+    }
+}
+
+// spower without genlet
+const char *kPower = "let rec pow1 = (n, xq) => { if n == 0 then `{ 1 } "
+                     "else `{ ~{ xq } * ~{ pow1 (n - 1) xq } } } in "
+                     "let c = `{ (x) => { ~{ pow1 13 `{ x } } } } in ~0{ c } 2";
+
+TEST_F(VmSpec, GeneratesCodeFromTemplates) {
+    EXPECT_EQ(run(kPower), 8192);
+    // One template per quote, compiled once however much code is generated.
+    EXPECT_EQ(compile(kPower).templates.size(), 4u);
+
+    VmOptions options;
+    options.jit = false;
+    Vm vm(compile(kPower), options);
+    ASSERT_TRUE(vm.run({}).isOk());
+    // 14 fragments from pow1, `{ x } and the function.
+    EXPECT_EQ(vm.fragments().size(), 16u);
+    for (const Instr &instr : vm.fragments().back().code) {
+        EXPECT_NE(instr.op, Op::Free);
+    }
+}
+
+TEST_F(VmSpec, KeepsTheVariablesOfQuotesApart) {
+    // Every level binds its own x; the code from the level above refers
+    // to that level's x.
+    EXPECT_EQ(run("let rec f = (n, outer) => { if n == 0 then outer else "
+                  "`{ let x = ~{ outer } + 1 in ~{ f (n - 1) `{ x * 10 } } + x } } in "
+                  "~0{ f 2 `{ 1 } }"),
+              233);
+}
+
+TEST_F(VmSpec, CompilesHotGeneratedCode) {
+    const char *sum = "let rec sum = (c, i, acc) => { if i == 0 then acc "
+                      "else sum c (i - 1) (acc + ~0{ c } i) } in sum (`{ (x) => { x * x } }) 10 0";
+    EXPECT_EQ(run(sum), 385);
+    if (!jitAvailable()) {
+        GTEST_SKIP() << "no JIT for this host";
+    }
+    Vm vm(compile(sum));
+    ASSERT_TRUE(vm.run({}).isOk());
+    // The generated function comes after the program's own.
+    EXPECT_EQ(vm.program().functions.size(), 3u);
+    EXPECT_TRUE(vm.isCompiled(2));
+}
+
+TEST_F(VmSpec, RefusesCodeItCannotRun) {
+    Vm vm(compile("let f = `{ (x) => { x } } in ~0{ `{ ~{ f } + 1 } }"));
+    auto result = vm.run({});
+    ASSERT_FALSE(result.isOk());
+    EXPECT_EQ(result.error().kind, VmError::Kind::UnsupportedCode);
+
+    for (const char *code : {"let n = 1 in `{ n }", "`{ `{ 1 } }", "`{ ~2{ `{ 1 } } }",
+                             "`{ let f = (x) => { x } in f 1 }", "~{ `{ 1 } }"}) {
+        EXPECT_FALSE(compileBytecode(parse(code)).isOk()) << code;
+    }
+}
+
+TEST_F(VmSpec, RunsBatchesLikeSingleCalls) {
+    std::vector<int32_t> column;
+    for (int32_t v = -100; v < 1000; ++v) {
+        column.push_back(v);
+    }
+    column.push_back(std::numeric_limits<int32_t>::min());
+    column.push_back(std::numeric_limits<int32_t>::max());
+
+    for (const char *code : {
+             "(x) => { if x mod 2 == 0 then x / 2 else 3 * x + 1 }",
+             "(x) => { let m = 0 - 1 in x * 65536 + x / m - x mod m }",
+             "(x) => { x > 3 && x < 10 || x == 0 - 7 }",
+             "(n) => { let rec fib = (n) => { if n <= 1 then 1 else fib (n - 1) + fib (n - 2) } "
+             "in fib (n mod 16) }",
+             "(n) => { let rec memo fib = (n) => { if n <= 1 then 1 else fib (n - 1) + fib (n - "
+             "2) } in fib (n mod 40) }",
+         }) {
+        Vm batch(compile(code));
+        auto results = batch.runBatch(column);
+        ASSERT_TRUE(results.isOk()) << code;
+        ASSERT_EQ(results.value().size(), column.size());
+        Vm single(compile(code));
+        for (size_t k = 0; k < column.size(); ++k) {
+            auto expected = single.run({column[k]});
+            ASSERT_TRUE(expected.isOk()) << code << " on " << column[k];
+            EXPECT_EQ(results.value()[k], expected.value()) << code << " on " << column[k];
+        }
+    }
+
+    // Lanes that stop early wait while the others recurse.
+    Vm vm(compile("(n) => { let rec sum = (n) => { if n <= 0 then 0 else n + sum (n - 1) } "
+                  "in sum n }"));
+    auto sums = vm.runBatch({3, 0, 100, -5});
+    ASSERT_TRUE(sums.isOk()) << toString(sums.error());
+    EXPECT_EQ(sums.value(), (std::vector<int32_t>{6, 0, 5050, 0}));
+    EXPECT_EQ(vm.stats().batchCalls, 102u);
+}
+
+TEST_F(VmSpec, RunsBatchesOfGeneratedCode) {
+    // A function of one argument, generated once for all the batches.
+    Vm vm(compile("let rec pow1 = (n, xq) => { if n == 0 then `{ 1 } "
+                  "else `{ ~{ xq } * ~{ pow1 (n - 1) xq } } } in "
+                  "`{ (x) => { ~{ pow1 13 `{ x } } } }"));
+    auto results = vm.runBatch({0, 1, 2, -3});
+    ASSERT_TRUE(results.isOk());
+    EXPECT_EQ(results.value(), (std::vector<int32_t>{0, 1, 8192, -1594323}));
+    EXPECT_EQ(vm.runBatch({2}).value(), std::vector<int32_t>{8192});
+    EXPECT_EQ(vm.program().functions.size(), 3u);
+}
+
+TEST_F(VmSpec, FailsBatchesAsAWhole) {
+    Vm divide(compile("(x) => { if x > 5 then 100 / x else 100 / (x - 3) }"));
+    auto results = divide.runBatch({7, 4, 3, 9});
+    ASSERT_FALSE(results.isOk());
+    EXPECT_EQ(results.error().kind, VmError::Kind::ZeroDivision);
+    // Lanes that do not divide by zero may hold zero.
+    EXPECT_EQ(divide.runBatch({0, 10, 20}).value(), (std::vector<int32_t>{-33, 10, 5}));
+
+    for (const char *code : {"1 + 2", "(x, y) => { x }"}) {
+        Vm vm(compile(code));
+        auto notUnary = vm.runBatch({1});
+        ASSERT_FALSE(notUnary.isOk()) << code;
+        EXPECT_EQ(notUnary.error().kind, VmError::Kind::NotUnary) << code;
+    }
+}
+
+TEST_F(VmSpec, StreamsColumnFiles) {
+    const char *collatz = "(x:int) => { if x mod 2 == 0 then x / 2 else 3 * x + 1 }";
+    std::vector<int32_t> values;
+    std::vector<int32_t> expected;
+    for (int32_t v = 0; v < 1001; ++v) {
+        values.push_back(v);
+        expected.push_back(v % 2 == 0 ? v / 2 : 3 * v + 1);
+    }
+    EXPECT_EQ(std::get<0>(stream(collatz, values)), expected);
+    EXPECT_EQ(std::get<0>(stream(collatz, std::vector<int64_t>{-3, 4})),
+              (std::vector<int64_t>{-8, 2}));
+    EXPECT_EQ(std::get<0>(stream(collatz, std::vector<int32_t>{})), std::vector<int32_t>{});
+
+    EXPECT_EQ(std::get<1>(stream(collatz, std::vector<int64_t>{1, int64_t{1} << 40})),
+              "value 1 does not fit in 32 bits");
+    EXPECT_EQ(std::get<1>(stream("(x:int) => { 1000 / (x - 150) }", values)),
+              "division by zero in values 100 to 199");
+    EXPECT_EQ(std::get<1>(stream("1 + 2", values)), "not a function of one argument");
+
+    // The input is left as it was.
+    std::string column = ::testing::TempDir() + "lamgamma-column";
+    EXPECT_EQ(std::get<1>(stream(collatz, values, column)),
+              "cannot write " + column + ": it is the input");
+    std::ifstream kept(column, std::ios::binary);
+    EXPECT_EQ(std::string(std::istreambuf_iterator<char>(kept), std::istreambuf_iterator<char>())
+                  .size(),
+              values.size() * sizeof(int32_t));
+}
+
+TEST_F(VmSpec, TypeChecksBeforeRunning) {
+    EXPECT_EQ(runChecked("1 + true"), "(1,4)-(1,8) Type error: expected Int, but got Bool");
+    EXPECT_EQ(runChecked("if 1 then 2 else 3"),
+              "(1,3)-(1,4) Type error: expected Bool, but got Int");
+    EXPECT_EQ(runChecked("`{@! (x:int) => { x + 1 } }", {41}), "42");
+    EXPECT_EQ(std::get<1>(stream("(x:int) => { x + true }", std::vector<int32_t>{1})),
+              "(1,17)-(1,21) Type error: expected Int, but got Bool");
+}
+
+TEST_F(VmSpec, RunsArrays) {
+    EXPECT_EQ(run("Array.fold ((acc, x) => { acc + x }) 0 "
+                  "(Array.map ((x) => { x * x }) (Array.init 100 ((i) => { i })))"),
+              328350);
+    EXPECT_EQ(run("[| 4, 5, 6 |].(1) + Array.length [| |]"), 5);
+    EXPECT_EQ(run("let square = (x) => { x * x } in let add = (x, y) => { x + y } in "
+                  "let a = Array.map square [| 1, 2, 3 |] in Array.fold add a.(2) a"),
+              23);
+    // Arrays in generated code, with holes among the elements.
+    EXPECT_EQ(run("let c = `{ [| 1, ~{ `{ 2 + 3 } } |] } in ~0{ c }.(1)"), 5);
+    EXPECT_EQ(evaluate("Array.map ((x:int) => { x + 1 }) [| 1, 2, 3 |]"), "[| 2, 3, 4 |]");
+    EXPECT_EQ(evaluate("Array.init 0 ((i:int) => { i })"), "[| |]");
+}
+
+TEST_F(VmSpec, MapsArraysInBatches) {
+    Vm vm(compile("Array.fold ((acc, x) => { acc + x }) 0 "
+                  "(Array.map ((x) => { if x mod 2 == 0 then x / 2 else 3 * x + 1 }) "
+                  "(Array.init 200 ((i) => { i })))"));
+    auto sum = vm.run({});
+    ASSERT_TRUE(sum.isOk());
+    int32_t expected = 0;
+    for (int32_t v = 0; v < 200; ++v) {
+        expected += v % 2 == 0 ? v / 2 : 3 * v + 1;
+    }
+    EXPECT_EQ(sum.value(), expected);
+    // Four batches each for init and map.
+    EXPECT_EQ(vm.stats().batchCalls, 8u);
+
+    // Memo functions run once per element, and map arrays of their own in
+    // nested batches.
+    const char *nested = "(n) => { let rec memo total = (n) => { Array.fold ((acc, x) => { acc + "
+                         "x }) 0 (Array.init n ((i) => { i * i })) } in total (n mod 100) }";
+    std::vector<int32_t> column;
+    for (int32_t v = 0; v < 300; ++v) {
+        column.push_back(v);
+    }
+    Vm batch(compile(nested));
+    auto totals = batch.runBatch(column);
+    ASSERT_TRUE(totals.isOk()) << toString(totals.error());
+    for (size_t k = 0; k < column.size(); ++k) {
+        int32_t n = column[k] % 100;
+        EXPECT_EQ(totals.value()[k], (n - 1) * n * (2 * n - 1) / 6) << n;
+    }
+}
+
+TEST_F(VmSpec, ReportsArrayErrors) {
+    for (const char *code : {"[| 1, 2 |].(2)", "[| 1, 2 |].(0 - 1)",
+                             "Array.init (0 - 1) ((i) => { i })"}) {
+        Vm vm(compile(code));
+        auto result = vm.run({});
+        ASSERT_FALSE(result.isOk()) << code;
+        EXPECT_EQ(result.error().kind, VmError::Kind::IndexOutOfBounds) << code;
+    }
+    Vm vm(compile("(a) => { Array.length a }"));
+    auto length = vm.run({7});
+    ASSERT_FALSE(length.isOk());
+    EXPECT_EQ(length.error().kind, VmError::Kind::NotAnArray);
+
+    // A length past the cap fails before any memory is asked for.
+    Vm huge(compile("Array.length (Array.init 2147483647 ((i) => { i }))"));
+    auto tooLong = huge.run({});
+    ASSERT_FALSE(tooLong.isOk());
+    EXPECT_EQ(tooLong.error().kind, VmError::Kind::ArrayTooLong);
+    VmOptions capped;
+    capped.maxArrayLength = 4;
+    const char *init = "(n) => { Array.length (Array.init n ((i) => { i })) }";
+    Vm small(compile(init), capped);
+    EXPECT_EQ(small.run({4}).value(), 4);
+    auto five = small.run({5});
+    ASSERT_FALSE(five.isOk());
+    EXPECT_EQ(five.error().kind, VmError::Kind::ArrayTooLong);
+
+    for (const char *code : {"Array.map ((x, y) => { x }) [| 1 |]",
+                             "let y = 1 in Array.map ((x) => { x + y }) [| 1 |]",
+                             "(f) => { Array.map f [| 1 |] }",
+                             "`{ Array.map ((x) => { x }) [| 1 |] }"}) {
+        EXPECT_FALSE(compileBytecode(parse(code)).isOk()) << code;
+    }
+}
+
+TEST_F(VmSpec, RunsTuples) {
+    EXPECT_EQ(run("let divmod = (a, b) => { (a / b, a mod b) } in let r = divmod 17 5 in "
+                  "r.0 * 10 + r.1"),
+              32);
+    EXPECT_EQ(run("let p = ((1, 2), 3) in p.0.1 + p.1 + (4, if p.1 > 2 then (5, 6) else (7, 8)).1.0"),
+              10);
+    EXPECT_EQ(run("let rec fibs = (n) => { if n == 0 then (0, 1) else "
+                  "let p = fibs (n - 1) in (p.1, p.0 + p.1) } in (fibs 30).0"),
+              832040);
+    // A generator returning its code together with its size.
+    EXPECT_EQ(run("let rec gen = (n) => { if n == 0 then (`{ 1 }, 0) else "
+                  "let r = gen (n - 1) in (`{ ~{ r.0 } * 2 }, r.1 + 1) } in "
+                  "let r = gen 5 in ~0{ r.0 } + r.1"),
+              37);
+    // The cache keeps both components.
+    EXPECT_EQ(run("let rec memo f = (n) => { if n < 2 then (n, 1) else "
+                  "let a = f (n - 1) in let b = f (n - 2) in (a.0 + b.0, a.1 + b.1 + 1) } in "
+                  "let r = f 40 in r.0 + r.1"),
+              433494436);
+    EXPECT_EQ(evaluate("(1, 2)"), std::nullopt);
+
+    for (const char *code : {"(p) => { p.0 }", "let f = (p) => { p } in f (1, 2)",
+                             "(1, 2) == (1, 2)", "`{ (1, 2) }", "`{ (1, 2).0 }"}) {
+        EXPECT_FALSE(compileBytecode(parse(code)).isOk()) << code;
+    }
+}
+
+TEST_F(VmSpec, RunsBatchesOfFunctionsReturningTuples) {
+    std::vector<int32_t> column;
+    for (int32_t v = -50; v < 200; ++v) {
+        column.push_back(v);
+    }
+    const char *code = "(n) => { let f = (x) => { (x + 1, x * 2) } in let r = f n in r.0 * r.1 }";
+    Vm batch(compile(code));
+    auto results = batch.runBatch(column);
+    ASSERT_TRUE(results.isOk());
+    for (size_t k = 0; k < column.size(); ++k) {
+        EXPECT_EQ(results.value()[k], (column[k] + 1) * column[k] * 2) << column[k];
+    }
+    EXPECT_FALSE(Vm(compile("(n) => { (n, n) }")).runBatch(column).isOk());
+}
+
+TEST_F(VmSpec, EvaluatesLikeThePlayground) {
+    EXPECT_EQ(evaluate(kFib), "10946");
+    EXPECT_EQ(evaluate("let rec even = (n:int):bool => { "
+                       "if n == 0 then true else !(even (n - 1)) } in even 7"),
+              "false");
+    EXPECT_EQ(evaluate("1 / 0"), "error");
+    EXPECT_EQ(evaluate("let x = in"), "error");
+    for (const char *code : {"(x) => { x }", "`{ 1 }", "let f = (x) => { x } in f"}) {
+        EXPECT_EQ(evaluate(code), std::nullopt) << code;
+    }
+    // Ill-typed programs are left to the interpreter, which runs them
+    // untyped.
+    for (const char *code : {"1 + true", "let a = [| 1, 2, 3 |] in Array.length 0",
+                             "let rec f = (n) => { n } in f 1"}) {
+        EXPECT_EQ(evaluate(code), std::nullopt) << code;
+    }
+}
+
+} // namespace
+} // namespace lamgamma
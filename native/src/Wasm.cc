@@ -0,0 +1,64 @@
+// Entry points of the WebAssembly build (emcmake cmake; see CMakeLists.txt),
+// which the playground loads as lamgamma-native.js. They mirror
+// Frontend.gen: each takes a NUL-terminated program and returns text that
+// stays valid until the next call. The engine parses with its own copy of
+// the grammar, so no tree-sitter parser crosses the boundary.
+#include <string>
+
+#include <emscripten/emscripten.h>
+#include <tree_sitter/api.h>
+
+#include "Frontend.h"
+#include "IncrementalTypeChecker.h"
+#include "tree-sitter-lamgamma_parser.h"
+
+namespace {
+
+TSParser *parser() {
+    static TSParser *parser = [] {
+        TSParser *p = ts_parser_new();
+        ts_parser_set_language(p, tree_sitter_lamgamma_parser());
+        return p;
+    }();
+    return parser;
+}
+
+std::string result;
+
+const char *answer(std::string text) {
+    result = std::move(text);
+    return result.c_str();
+}
+
+} // namespace
+
+extern "C" {
+
+EMSCRIPTEN_KEEPALIVE const char *lamgamma_typecheck(const char *input) {
+    return answer(lamgamma::Frontend::typeCheck(input, parser()));
+}
+
+// Like lamgamma_typecheck, for the document in the editor: each call takes
+// the whole document and rechecks only the part that changed since the
+// previous one.
+EMSCRIPTEN_KEEPALIVE const char *lamgamma_typecheck_document(const char *input) {
+    static lamgamma::IncrementalTypeChecker checker(parser());
+    checker.update(input);
+    return answer(checker.typeCheck());
+}
+
+EMSCRIPTEN_KEEPALIVE const char *lamgamma_strip_type_info(const char *input) {
+    return answer(lamgamma::Frontend::stripTypeInfo(input, parser()));
+}
+
+// Null for programs the bytecode VM does not run, ill-typed ones included;
+// the caller evaluates those with the interpreter.
+EMSCRIPTEN_KEEPALIVE const char *lamgamma_evaluate(const char *input) {
+    std::string output;
+    if (!lamgamma::Frontend::evaluate(input, parser(), &output)) {
+        return nullptr;
+    }
+    return answer(std::move(output));
+}
+
+} // extern "C"
@@ -0,0 +1,171 @@
+// Command-line driver for the native engine.
+//
+//   lamgamma typecheck FILE   print the type of the program in FILE
+//   lamgamma print FILE       print the program in FILE without types, laid
+//                             out in 80 columns
+//   lamgamma offshore FILE ARG...
+//                             compile the generated function in FILE to
+//                             native code with $CC (cc when unset) and
+//                             apply it to the int ARGs; only first-order
+//                             functions of int parameters, built from
+//                             literals, let, if and the operators, whose
+//                             result is an int or a boolean. run and the
+//                             playground never offshore.
+//   lamgamma run FILE [ARG...]
+//                             run the program in FILE on the bytecode VM,
+//                             applying a generated function to the int ARGs
+//   lamgamma stream FILE IN OUT [int32|int64]
+//                             apply the function in FILE, or the one whose
+//                             code it generates, to every value of the
+//                             binary column IN and write the results to
+//                             OUT (native-endian ints, int32 by default)
+//   lamgamma save FILE OUT    encode the program in FILE, as the playground
+//                             stores generated code, to OUT
+//   lamgamma load FILE [ARG...]
+//                             run the encoded program in FILE as run does
+//
+// FILE may be `-` for standard input, except for load, which maps it.
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <tree_sitter/api.h>
+
+#include "Frontend.h"
+#include "tree-sitter-lamgamma_parser.h"
+
+namespace {
+
+int usage() {
+    std::cerr << "usage: lamgamma typecheck FILE\n"
+                 "       lamgamma print FILE\n"
+                 "       lamgamma offshore FILE ARG...\n"
+                 "       lamgamma run FILE [ARG...]\n"
+                 "       lamgamma stream FILE IN OUT [int32|int64]\n"
+                 "       lamgamma save FILE OUT\n"
+                 "       lamgamma load FILE [ARG...]\n"
+                 "offshore compiles with $CC (cc when unset) and takes only first-order\n"
+                 "functions of int parameters built from literals, let, if and the\n"
+                 "operators, returning an int or a boolean; run never offshores.\n";
+    return 2;
+}
+
+bool readSource(const char *path, std::string *out) {
+    if (std::strcmp(path, "-") == 0) {
+        out->assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+        return true;
+    }
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    out->assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool parseInt(const char *text, int32_t *out) {
+    errno = 0;
+    char *end;
+    long value = std::strtol(text, &end, 10);
+    if (*text == '\0' || *end != '\0' || errno != 0 || value < INT32_MIN || value > INT32_MAX) {
+        return false;
+    }
+    *out = static_cast<int32_t>(value);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool stream = (argc == 5 || argc == 6) && std::strcmp(argv[1], "stream") == 0;
+    lamgamma::Frontend::ColumnWidth width = lamgamma::Frontend::ColumnWidth::Int32;
+    if (stream && argc == 6) {
+        if (std::strcmp(argv[5], "int64") == 0) {
+            width = lamgamma::Frontend::ColumnWidth::Int64;
+        } else if (std::strcmp(argv[5], "int32") != 0) {
+            return usage();
+        }
+    }
+    bool offshore = argc >= 3 && std::strcmp(argv[1], "offshore") == 0;
+    bool run = argc >= 3 && std::strcmp(argv[1], "run") == 0;
+    bool save = argc == 4 && std::strcmp(argv[1], "save") == 0;
+    bool load = argc >= 3 && std::strcmp(argv[1], "load") == 0;
+    if (argc != 3 && !offshore && !run && !stream && !save && !load) {
+        return usage();
+    }
+    std::vector<int32_t> args;
+    for (int i = 3; i < argc && !stream && !save; ++i) {
+        int32_t value;
+        if (!parseInt(argv[i], &value)) {
+            std::cerr << "lamgamma: not an int: " << argv[i] << "\n";
+            return 2;
+        }
+        args.push_back(value);
+    }
+    if (load) {
+        std::string output;
+        std::string error = lamgamma::Frontend::load(argv[2], args, &output);
+        if (!error.empty()) {
+            std::cerr << "lamgamma: " << error << "\n";
+            return 1;
+        }
+        std::cout << output << "\n";
+        return 0;
+    }
+    std::string source;
+    if (!readSource(argv[2], &source)) {
+        std::cerr << "lamgamma: cannot read " << argv[2] << "\n";
+        return 1;
+    }
+
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_lamgamma_parser());
+
+    int status = 0;
+    if (std::strcmp(argv[1], "typecheck") == 0) {
+        std::cout << lamgamma::Frontend::typeCheck(source, parser) << "\n";
+    } else if (std::strcmp(argv[1], "print") == 0) {
+        std::string error = lamgamma::Frontend::print(source, parser, STDOUT_FILENO);
+        if (error.empty()) {
+            std::cout << "\n";
+        } else {
+            std::cerr << "lamgamma: " << error << "\n";
+            status = 1;
+        }
+    } else if (stream) {
+        std::string error = lamgamma::Frontend::stream(source, parser, argv[3], argv[4], width);
+        if (!error.empty()) {
+            std::cerr << "lamgamma: " << error << "\n";
+            status = 1;
+        }
+    } else if (save) {
+        std::string error = lamgamma::Frontend::save(source, parser, argv[3]);
+        if (!error.empty()) {
+            std::cerr << "lamgamma: " << error << "\n";
+            status = 1;
+        }
+    } else if (offshore || run) {
+        std::string output;
+        std::string error = offshore ? lamgamma::Frontend::offshore(source, parser, args, &output)
+                                     : lamgamma::Frontend::run(source, parser, args, &output);
+        if (error.empty()) {
+            std::cout << output << "\n";
+        } else {
+            std::cerr << "lamgamma: " << error << "\n";
+            status = 1;
+        }
+    } else {
+        status = usage();
+    }
+
+    ts_parser_delete(parser);
+    return status;
+}
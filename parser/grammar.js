@@ -39,6 +39,9 @@ module.exports = grammar({
 
   word: $ => $.identifier,
 
+  // `(x)` and `(x, y)` are an expression in parentheses and a tuple, or
+  // the parameters of a lambda; nothing tells them apart before a `:` or
+  // `@`, or the `=>` after `)`, so both are parsed until then.
   conflicts: $ => [
     [$._simple_expression, $.param]
   ],
@@ -69,6 +72,14 @@ module.exports = grammar({
       // let
       $.let,
       $.letrec,
+      $.letcs,
+      // staging
+      $.genlet,
+      // arrays
+      $.array_length,
+      $.array_init,
+      $.array_map,
+      $.array_fold,
     ),
 
     _expression_with_clsapp: $ => choice(
@@ -83,6 +94,10 @@ module.exports = grammar({
       $.number,
       $.boolean,
       $.lambda,
+      $.array,
+      $.array_get,
+      $.tuple,
+      $.tuple_get,
       // staging
       $.quote,
       $.splice,
@@ -214,6 +229,57 @@ module.exports = grammar({
     not: $ => prec.right(PREC.unary,
       seq('!', $._expression)),
 
+    // arrays of ints
+    array: $ => seq('[|',
+      optional(seq(
+        field('element', $._expression),
+        repeat(seq(',', field('element', $._expression))))),
+      '|]'),
+
+    array_get: $ => prec.left(PREC.recordmember,
+      seq(
+        field('array', $._simple_expression),
+        '.(',
+        field('index', $._expression),
+        ')')),
+
+    array_length: $ => prec(PREC.application,
+      seq('Array.length', field('array', $._simple_expression))
+    ),
+
+    // Array.init n f: [| f 0, ..., f (n - 1) |]
+    array_init: $ => prec(PREC.application,
+      seq('Array.init',
+        field('size', $._simple_expression),
+        field('func', $._simple_expression))
+    ),
+
+    array_map: $ => prec(PREC.application,
+      seq('Array.map',
+        field('func', $._simple_expression),
+        field('array', $._simple_expression))
+    ),
+
+    // Array.fold f z a: f (... (f z a.(0)) ...) a.(n - 1)
+    array_fold: $ => prec(PREC.application,
+      seq('Array.fold',
+        field('func', $._simple_expression),
+        field('init', $._simple_expression),
+        field('array', $._simple_expression))
+    ),
+
+    // unboxed tuples of two or more elements, and their components from 0
+    tuple: $ => seq('(',
+      field('element', $._expression),
+      repeat1(seq(',', field('element', $._expression))),
+      ')'),
+
+    tuple_get: $ => prec.left(PREC.recordmember,
+      seq(
+        field('tuple', $._simple_expression),
+        '.',
+        field('index', $.number))),
+
     // staging
     quote: $ => prec(PREC.stage,
       seq('`{',
@@ -224,6 +290,10 @@ module.exports = grammar({
       seq('~', optional(field('shift', $.number)), '{', field('expr', $._expression), '}')
     ),
 
+    genlet: $ => prec(PREC.application,
+      seq('genlet', field('expr', $._simple_expression))
+    ),
+
     let: $ => prec.right(PREC.assign,
       seq('let',
         field('param', $.param),
@@ -233,8 +303,25 @@ module.exports = grammar({
         field('body', $._expression))
     ),
 
+    // `let rec memo` caches the results of the function by its arguments
     letrec: $ => prec.right(PREC.assign,
       seq('let', 'rec',
+        optional(field('memo', $.memo)),
+        field('param', $.param),
+        '=',
+        field('value', $._expression),
+        'in',
+        field('body', $._expression))
+    ),
+
+    memo: $ => 'memo',
+
+    // cross-stage persistent let: the variable can also be used in quotes.
+    // Like `rec`, `cs` is a keyword right after `let`, so `let cs = 1 in cs`
+    // does not parse; bind a variable named cs with `let cs cs = ...`.
+    // Anywhere else, cs is an ordinary identifier.
+    letcs: $ => prec.right(PREC.assign,
+      seq('let', 'cs',
         field('param', $.param),
         '=',
         field('value', $._expression),
@@ -258,6 +345,7 @@ module.exports = grammar({
     _type: $ => choice(
       $._simple_type,
       $.func_type,
+      $.tuple_type,
     ),
 
     _simple_type: $ => choice(
@@ -265,6 +353,7 @@ module.exports = grammar({
       $.bool_type,
       $.code_type,
       $.clsabs_type,
+      $.array_type,
       seq('(', $._type, ')')
     ),
 
@@ -272,6 +361,8 @@ module.exports = grammar({
 
     bool_type: $ => 'bool',
 
+    array_type: $ => seq('array', '<', field('element', $.int_type), '>'),
+
     func_type: $ => prec.right(PREC.typefunc,
       seq(
         field('param', $._simple_type),
@@ -280,6 +371,12 @@ module.exports = grammar({
       )
     ),
 
+    tuple_type: $ => prec.left(PREC.typeprod,
+      seq(
+        field('element', $._simple_type),
+        repeat1(seq('*', field('element', $._simple_type))))
+    ),
+
     code_type: $ => seq('<',
       field('type', $._type),
       '@',
@@ -5,15 +5,15 @@
 #endif
 
 #define LANGUAGE_VERSION 14
-#define STATE_COUNT 122
-#define LARGE_STATE_COUNT 2
-#define SYMBOL_COUNT 81
+#define STATE_COUNT 173
+#define LARGE_STATE_COUNT 37
+#define SYMBOL_COUNT 107
 #define ALIAS_COUNT 0
-#define TOKEN_COUNT 43
+#define TOKEN_COUNT 55
 #define EXTERNAL_TOKEN_COUNT 0
-#define FIELD_COUNT 20
+#define FIELD_COUNT 27
 #define MAX_ALIAS_SEQUENCE_LENGTH 9
-#define PRODUCTION_ID_COUNT 22
+#define PRODUCTION_ID_COUNT 34
 
 enum ts_symbol_identifiers {
   sym_identifier = 1,
@@ -46,56 +46,82 @@ enum ts_symbol_identifiers {
   anon_sym_GT_EQ = 28,
   anon_sym_AMP_AMP = 29,
   anon_sym_PIPE_PIPE = 30,
-  anon_sym_BQUOTE_LBRACE = 31,
-  anon_sym_TILDE = 32,
-  anon_sym_let = 33,
-  anon_sym_EQ = 34,
-  anon_sym_in = 35,
-  anon_sym_rec = 36,
-  anon_sym_LBRACK = 37,
-  anon_sym_RBRACK = 38,
-  anon_sym_CARET = 39,
-  sym_int_type = 40,
-  sym_bool_type = 41,
-  anon_sym_DASH_GT = 42,
-  sym_source_file = 43,
-  sym__expression = 44,
-  sym__expression_with_clsapp = 45,
-  sym__simple_expression = 46,
-  sym_lambda = 47,
-  sym_application = 48,
-  sym_param = 49,
-  sym_params = 50,
-  sym_clsparam = 51,
-  sym_classifier = 52,
-  sym_add = 53,
-  sym_sub = 54,
-  sym_mult = 55,
-  sym_div = 56,
-  sym_mod = 57,
-  sym_boolean = 58,
-  sym_ctrl_if = 59,
-  sym_eq = 60,
-  sym_ne = 61,
-  sym_lt = 62,
-  sym_le = 63,
-  sym_gt = 64,
-  sym_ge = 65,
-  sym_and = 66,
-  sym_or = 67,
-  sym_not = 68,
-  sym_quote = 69,
-  sym_splice = 70,
-  sym_let = 71,
-  sym_letrec = 72,
-  sym_clsabs = 73,
-  sym_clsapp = 74,
-  sym__type = 75,
-  sym__simple_type = 76,
-  sym_func_type = 77,
-  sym_code_type = 78,
-  sym_clsabs_type = 79,
-  aux_sym_params_repeat1 = 80,
+  anon_sym_LBRACK_PIPE = 31,
+  anon_sym_PIPE_RBRACK = 32,
+  anon_sym_DOT_LPAREN = 33,
+  anon_sym_Array_DOTlength = 34,
+  anon_sym_Array_DOTinit = 35,
+  anon_sym_Array_DOTmap = 36,
+  anon_sym_Array_DOTfold = 37,
+  anon_sym_DOT = 38,
+  anon_sym_BQUOTE_LBRACE = 39,
+  anon_sym_TILDE = 40,
+  anon_sym_genlet = 41,
+  anon_sym_let = 42,
+  anon_sym_EQ = 43,
+  anon_sym_in = 44,
+  anon_sym_rec = 45,
+  sym_memo = 46,
+  anon_sym_cs = 47,
+  anon_sym_LBRACK = 48,
+  anon_sym_RBRACK = 49,
+  anon_sym_CARET = 50,
+  sym_int_type = 51,
+  sym_bool_type = 52,
+  anon_sym_array = 53,
+  anon_sym_DASH_GT = 54,
+  sym_source_file = 55,
+  sym__expression = 56,
+  sym__expression_with_clsapp = 57,
+  sym__simple_expression = 58,
+  sym_lambda = 59,
+  sym_application = 60,
+  sym_param = 61,
+  sym_params = 62,
+  sym_clsparam = 63,
+  sym_classifier = 64,
+  sym_add = 65,
+  sym_sub = 66,
+  sym_mult = 67,
+  sym_div = 68,
+  sym_mod = 69,
+  sym_boolean = 70,
+  sym_ctrl_if = 71,
+  sym_eq = 72,
+  sym_ne = 73,
+  sym_lt = 74,
+  sym_le = 75,
+  sym_gt = 76,
+  sym_ge = 77,
+  sym_and = 78,
+  sym_or = 79,
+  sym_not = 80,
+  sym_array = 81,
+  sym_array_get = 82,
+  sym_array_length = 83,
+  sym_array_init = 84,
+  sym_array_map = 85,
+  sym_array_fold = 86,
+  sym_tuple = 87,
+  sym_tuple_get = 88,
+  sym_quote = 89,
+  sym_splice = 90,
+  sym_genlet = 91,
+  sym_let = 92,
+  sym_letrec = 93,
+  sym_letcs = 94,
+  sym_clsabs = 95,
+  sym_clsapp = 96,
+  sym__type = 97,
+  sym__simple_type = 98,
+  sym_array_type = 99,
+  sym_func_type = 100,
+  sym_tuple_type = 101,
+  sym_code_type = 102,
+  sym_clsabs_type = 103,
+  aux_sym_params_repeat1 = 104,
+  aux_sym_array_repeat1 = 105,
+  aux_sym_tuple_type_repeat1 = 106,
 };
 
 static const char * const ts_symbol_names[] = {
@@ -130,17 +156,29 @@ static const char * const ts_symbol_names[] = {
   [anon_sym_GT_EQ] = ">=",
   [anon_sym_AMP_AMP] = "&&",
   [anon_sym_PIPE_PIPE] = "||",
+  [anon_sym_LBRACK_PIPE] = "[|",
+  [anon_sym_PIPE_RBRACK] = "|]",
+  [anon_sym_DOT_LPAREN] = ".(",
+  [anon_sym_Array_DOTlength] = "Array.length",
+  [anon_sym_Array_DOTinit] = "Array.init",
+  [anon_sym_Array_DOTmap] = "Array.map",
+  [anon_sym_Array_DOTfold] = "Array.fold",
+  [anon_sym_DOT] = ".",
   [anon_sym_BQUOTE_LBRACE] = "`{",
   [anon_sym_TILDE] = "~",
+  [anon_sym_genlet] = "genlet",
   [anon_sym_let] = "let",
   [anon_sym_EQ] = "=",
   [anon_sym_in] = "in",
   [anon_sym_rec] = "rec",
+  [sym_memo] = "memo",
+  [anon_sym_cs] = "cs",
   [anon_sym_LBRACK] = "[",
   [anon_sym_RBRACK] = "]",
   [anon_sym_CARET] = "^",
   [sym_int_type] = "int_type",
   [sym_bool_type] = "bool_type",
+  [anon_sym_array] = "array",
   [anon_sym_DASH_GT] = "->",
   [sym_source_file] = "source_file",
   [sym__expression] = "_expression",
@@ -168,18 +206,32 @@ static const char * const ts_symbol_names[] = {
   [sym_and] = "and",
   [sym_or] = "or",
   [sym_not] = "not",
+  [sym_array] = "array",
+  [sym_array_get] = "array_get",
+  [sym_array_length] = "array_length",
+  [sym_array_init] = "array_init",
+  [sym_array_map] = "array_map",
+  [sym_array_fold] = "array_fold",
+  [sym_tuple] = "tuple",
+  [sym_tuple_get] = "tuple_get",
   [sym_quote] = "quote",
   [sym_splice] = "splice",
+  [sym_genlet] = "genlet",
   [sym_let] = "let",
   [sym_letrec] = "letrec",
+  [sym_letcs] = "letcs",
   [sym_clsabs] = "clsabs",
   [sym_clsapp] = "clsapp",
   [sym__type] = "_type",
   [sym__simple_type] = "_simple_type",
+  [sym_array_type] = "array_type",
   [sym_func_type] = "func_type",
+  [sym_tuple_type] = "tuple_type",
   [sym_code_type] = "code_type",
   [sym_clsabs_type] = "clsabs_type",
   [aux_sym_params_repeat1] = "params_repeat1",
+  [aux_sym_array_repeat1] = "array_repeat1",
+  [aux_sym_tuple_type_repeat1] = "tuple_type_repeat1",
 };
 
 static const TSSymbol ts_symbol_map[] = {
@@ -214,17 +266,29 @@ static const TSSymbol ts_symbol_map[] = {
   [anon_sym_GT_EQ] = anon_sym_GT_EQ,
   [anon_sym_AMP_AMP] = anon_sym_AMP_AMP,
   [anon_sym_PIPE_PIPE] = anon_sym_PIPE_PIPE,
+  [anon_sym_LBRACK_PIPE] = anon_sym_LBRACK_PIPE,
+  [anon_sym_PIPE_RBRACK] = anon_sym_PIPE_RBRACK,
+  [anon_sym_DOT_LPAREN] = anon_sym_DOT_LPAREN,
+  [anon_sym_Array_DOTlength] = anon_sym_Array_DOTlength,
+  [anon_sym_Array_DOTinit] = anon_sym_Array_DOTinit,
+  [anon_sym_Array_DOTmap] = anon_sym_Array_DOTmap,
+  [anon_sym_Array_DOTfold] = anon_sym_Array_DOTfold,
+  [anon_sym_DOT] = anon_sym_DOT,
   [anon_sym_BQUOTE_LBRACE] = anon_sym_BQUOTE_LBRACE,
   [anon_sym_TILDE] = anon_sym_TILDE,
+  [anon_sym_genlet] = anon_sym_genlet,
   [anon_sym_let] = anon_sym_let,
   [anon_sym_EQ] = anon_sym_EQ,
   [anon_sym_in] = anon_sym_in,
   [anon_sym_rec] = anon_sym_rec,
+  [sym_memo] = sym_memo,
+  [anon_sym_cs] = anon_sym_cs,
   [anon_sym_LBRACK] = anon_sym_LBRACK,
   [anon_sym_RBRACK] = anon_sym_RBRACK,
   [anon_sym_CARET] = anon_sym_CARET,
   [sym_int_type] = sym_int_type,
   [sym_bool_type] = sym_bool_type,
+  [anon_sym_array] = anon_sym_array,
   [anon_sym_DASH_GT] = anon_sym_DASH_GT,
   [sym_source_file] = sym_source_file,
   [sym__expression] = sym__expression,
@@ -252,18 +316,32 @@ static const TSSymbol ts_symbol_map[] = {
   [sym_and] = sym_and,
   [sym_or] = sym_or,
   [sym_not] = sym_not,
+  [sym_array] = sym_array,
+  [sym_array_get] = sym_array_get,
+  [sym_array_length] = sym_array_length,
+  [sym_array_init] = sym_array_init,
+  [sym_array_map] = sym_array_map,
+  [sym_array_fold] = sym_array_fold,
+  [sym_tuple] = sym_tuple,
+  [sym_tuple_get] = sym_tuple_get,
   [sym_quote] = sym_quote,
   [sym_splice] = sym_splice,
+  [sym_genlet] = sym_genlet,
   [sym_let] = sym_let,
   [sym_letrec] = sym_letrec,
+  [sym_letcs] = sym_letcs,
   [sym_clsabs] = sym_clsabs,
   [sym_clsapp] = sym_clsapp,
   [sym__type] = sym__type,
   [sym__simple_type] = sym__simple_type,
+  [sym_array_type] = sym_array_type,
   [sym_func_type] = sym_func_type,
+  [sym_tuple_type] = sym_tuple_type,
   [sym_code_type] = sym_code_type,
   [sym_clsabs_type] = sym_clsabs_type,
   [aux_sym_params_repeat1] = aux_sym_params_repeat1,
+  [aux_sym_array_repeat1] = aux_sym_array_repeat1,
+  [aux_sym_tuple_type_repeat1] = aux_sym_tuple_type_repeat1,
 };
 
 static const TSSymbolMetadata ts_symbol_metadata[] = {
@@ -391,6 +469,38 @@ static const TSSymbolMetadata ts_symbol_metadata[] = {
     .visible = true,
     .named = false,
   },
+  [anon_sym_LBRACK_PIPE] = {
+    .visible = true,
+    .named = false,
+  },
+  [anon_sym_PIPE_RBRACK] = {
+    .visible = true,
+    .named = false,
+  },
+  [anon_sym_DOT_LPAREN] = {
+    .visible = true,
+    .named = false,
+  },
+  [anon_sym_Array_DOTlength] = {
+    .visible = true,
+    .named = false,
+  },
+  [anon_sym_Array_DOTinit] = {
+    .visible = true,
+    .named = false,
+  },
+  [anon_sym_Array_DOTmap] = {
+    .visible = true,
+    .named = false,
+  },
+  [anon_sym_Array_DOTfold] = {
+    .visible = true,
+    .named = false,
+  },
+  [anon_sym_DOT] = {
+    .visible = true,
+    .named = false,
+  },
   [anon_sym_BQUOTE_LBRACE] = {
     .visible = true,
     .named = false,
@@ -399,6 +509,10 @@ static const TSSymbolMetadata ts_symbol_metadata[] = {
     .visible = true,
     .named = false,
   },
+  [anon_sym_genlet] = {
+    .visible = true,
+    .named = false,
+  },
   [anon_sym_let] = {
     .visible = true,
     .named = false,
@@ -415,6 +529,14 @@ static const TSSymbolMetadata ts_symbol_metadata[] = {
     .visible = true,
     .named = false,
   },
+  [sym_memo] = {
+    .visible = true,
+    .named = true,
+  },
+  [anon_sym_cs] = {
+    .visible = true,
+    .named = false,
+  },
   [anon_sym_LBRACK] = {
     .visible = true,
     .named = false,
@@ -435,6 +557,10 @@ static const TSSymbolMetadata ts_symbol_metadata[] = {
     .visible = true,
     .named = true,
   },
+  [anon_sym_array] = {
+    .visible = true,
+    .named = false,
+  },
   [anon_sym_DASH_GT] = {
     .visible = true,
     .named = false,
@@ -543,6 +669,38 @@ static const TSSymbolMetadata ts_symbol_metadata[] = {
     .visible = true,
     .named = true,
   },
+  [sym_array] = {
+    .visible = true,
+    .named = true,
+  },
+  [sym_array_get] = {
+    .visible = true,
+    .named = true,
+  },
+  [sym_array_length] = {
+    .visible = true,
+    .named = true,
+  },
+  [sym_array_init] = {
+    .visible = true,
+    .named = true,
+  },
+  [sym_array_map] = {
+    .visible = true,
+    .named = true,
+  },
+  [sym_array_fold] = {
+    .visible = true,
+    .named = true,
+  },
+  [sym_tuple] = {
+    .visible = true,
+    .named = true,
+  },
+  [sym_tuple_get] = {
+    .visible = true,
+    .named = true,
+  },
   [sym_quote] = {
     .visible = true,
     .named = true,
@@ -551,6 +709,10 @@ static const TSSymbolMetadata ts_symbol_metadata[] = {
     .visible = true,
     .named = true,
   },
+  [sym_genlet] = {
+    .visible = true,
+    .named = true,
+  },
   [sym_let] = {
     .visible = true,
     .named = true,
@@ -559,6 +721,10 @@ static const TSSymbolMetadata ts_symbol_metadata[] = {
     .visible = true,
     .named = true,
   },
+  [sym_letcs] = {
+    .visible = true,
+    .named = true,
+  },
   [sym_clsabs] = {
     .visible = true,
     .named = true,
@@ -575,10 +741,18 @@ static const TSSymbolMetadata ts_symbol_metadata[] = {
     .visible = false,
     .named = true,
   },
+  [sym_array_type] = {
+    .visible = true,
+    .named = true,
+  },
   [sym_func_type] = {
     .visible = true,
     .named = true,
   },
+  [sym_tuple_type] = {
+    .visible = true,
+    .named = true,
+  },
   [sym_code_type] = {
     .visible = true,
     .named = true,
@@ -591,50 +765,72 @@ static const TSSymbolMetadata ts_symbol_metadata[] = {
     .visible = false,
     .named = false,
   },
+  [aux_sym_array_repeat1] = {
+    .visible = false,
+    .named = false,
+  },
+  [aux_sym_tuple_type_repeat1] = {
+    .visible = false,
+    .named = false,
+  },
 };
 
 enum ts_field_identifiers {
   field_arg = 1,
-  field_base = 2,
-  field_body = 3,
-  field_classifier = 4,
-  field_cls = 5,
-  field_cond = 6,
-  field_else = 7,
-  field_expr = 8,
-  field_func = 9,
-  field_left = 10,
-  field_param = 11,
-  field_params = 12,
-  field_return = 13,
-  field_return_type = 14,
-  field_right = 15,
-  field_shift = 16,
-  field_then = 17,
-  field_type = 18,
-  field_value = 19,
-  field_var = 20,
+  field_array = 2,
+  field_base = 3,
+  field_body = 4,
+  field_classifier = 5,
+  field_cls = 6,
+  field_cond = 7,
+  field_element = 8,
+  field_else = 9,
+  field_expr = 10,
+  field_func = 11,
+  field_index = 12,
+  field_init = 13,
+  field_left = 14,
+  field_memo = 15,
+  field_param = 16,
+  field_params = 17,
+  field_return = 18,
+  field_return_type = 19,
+  field_right = 20,
+  field_shift = 21,
+  field_size = 22,
+  field_then = 23,
+  field_tuple = 24,
+  field_type = 25,
+  field_value = 26,
+  field_var = 27,
 };
 
 static const char * const ts_field_names[] = {
   [0] = NULL,
   [field_arg] = "arg",
+  [field_array] = "array",
   [field_base] = "base",
   [field_body] = "body",
   [field_classifier] = "classifier",
   [field_cls] = "cls",
   [field_cond] = "cond",
+  [field_element] = "element",
   [field_else] = "else",
   [field_expr] = "expr",
   [field_func] = "func",
+  [field_index] = "index",
+  [field_init] = "init",
   [field_left] = "left",
+  [field_memo] = "memo",
   [field_param] = "param",
   [field_params] = "params",
   [field_return] = "return",
   [field_return_type] = "return_type",
   [field_right] = "right",
   [field_shift] = "shift",
+  [field_size] = "size",
   [field_then] = "then",
+  [field_tuple] = "tuple",
   [field_type] = "type",
   [field_value] = "value",
   [field_var] = "var",
@@ -642,91 +838,139 @@ static const char * const ts_field_names[] = {
 
 static const TSFieldMapSlice ts_field_map_slices[PRODUCTION_ID_COUNT] = {
   [1] = {.index = 0, .length = 1},
-  [2] = {.index = 1, .length = 2},
-  [3] = {.index = 3, .length = 1},
-  [4] = {.index = 4, .length = 2},
-  [5] = {.index = 6, .length = 2},
-  [6] = {.index = 8, .length = 2},
-  [7] = {.index = 10, .length = 2},
-  [8] = {.index = 12, .length = 1},
-  [9] = {.index = 13, .length = 2},
-  [10] = {.index = 15, .length = 2},
-  [11] = {.index = 17, .length = 2},
-  [12] = {.index = 19, .length = 2},
-  [13] = {.index = 21, .length = 3},
-  [14] = {.index = 24, .length = 2},
-  [15] = {.index = 26, .length = 3},
-  [16] = {.index = 29, .length = 3},
-  [17] = {.index = 32, .length = 2},
-  [18] = {.index = 34, .length = 2},
-  [19] = {.index = 36, .length = 3},
-  [20] = {.index = 39, .length = 2},
-  [21] = {.index = 41, .length = 3},
+  [2] = {.index = 1, .length = 1},
+  [3] = {.index = 2, .length = 1},
+  [4] = {.index = 3, .length = 2},
+  [5] = {.index = 5, .length = 1},
+  [6] = {.index = 6, .length = 2},
+  [7] = {.index = 8, .length = 2},
+  [8] = {.index = 10, .length = 2},
+  [9] = {.index = 12, .length = 2},
+  [10] = {.index = 14, .length = 2},
+  [11] = {.index = 16, .length = 2},
+  [12] = {.index = 18, .length = 2},
+  [13] = {.index = 20, .length = 2},
+  [14] = {.index = 22, .length = 2},
+  [15] = {.index = 24, .length = 3},
+  [16] = {.index = 27, .length = 1},
+  [17] = {.index = 28, .length = 2},
+  [18] = {.index = 30, .length = 2},
+  [19] = {.index = 32, .length = 2},
+  [20] = {.index = 34, .length = 2},
+  [21] = {.index = 36, .length = 2},
+  [22] = {.index = 38, .length = 2},
+  [23] = {.index = 40, .length = 3},
+  [24] = {.index = 43, .length = 2},
+  [25] = {.index = 45, .length = 3},
+  [26] = {.index = 48, .length = 3},
+  [27] = {.index = 51, .length = 2},
+  [28] = {.index = 53, .length = 1},
+  [29] = {.index = 54, .length = 2},
+  [30] = {.index = 56, .length = 3},
+  [31] = {.index = 59, .length = 2},
+  [32] = {.index = 61, .length = 4},
+  [33] = {.index = 65, .length = 3},
 };
 
 static const TSFieldMapEntry ts_field_map_entries[] = {
   [0] =
     {field_var, 0},
   [1] =
+    {field_array, 1},
+  [2] =
+    {field_expr, 1},
+  [3] =
     {field_arg, 1},
     {field_func, 0},
-  [3] =
-    {field_expr, 1},
-  [4] =
+  [5] =
+    {field_element, 1},
+  [6] =
+    {field_func, 2},
+    {field_size, 1},
+  [8] =
+    {field_array, 2},
+    {field_func, 1},
+  [10] =
     {field_left, 0},
     {field_right, 2},
-  [6] =
+  [12] =
     {field_arg, 2},
     {field_func, 0},
-  [8] =
+  [14] =
+    {field_index, 2},
+    {field_tuple, 0},
+  [16] =
     {field_type, 2},
     {field_var, 0},
-  [10] =
+  [18] =
     {field_classifier, 2},
     {field_var, 0},
-  [12] =
+  [20] =
+    {field_element, 1},
+    {field_element, 2, .inherited = true},
+  [22] =
+    {field_element, 0, .inherited = true},
+    {field_element, 1, .inherited = true},
+  [24] =
+    {field_array, 3},
+    {field_func, 1},
+    {field_init, 2},
+  [27] =
     {field_expr, 2},
-  [13] =
+  [28] =
     {field_body, 3},
     {field_param, 1},
-  [15] =
+  [30] =
     {field_base, 2},
     {field_cls, 0},
-  [17] =
+  [32] =
+    {field_array, 0},
+    {field_index, 2},
+  [34] =
+    {field_element, 0},
+    {field_element, 1, .inherited = true},
+  [36] =
     {field_classifier, 2},
     {field_expr, 3},
-  [19] =
+  [38] =
     {field_expr, 3},
     {field_shift, 1},
-  [21] =
+  [40] =
     {field_classifier, 4},
     {field_type, 2},
     {field_var, 0},
-  [24] =
+  [43] =
     {field_param, 0},
     {field_return, 2},
-  [26] =
+  [45] =
     {field_cond, 1},
     {field_else, 5},
     {field_then, 3},
-  [29] =
+  [48] =
     {field_body, 5},
     {field_param, 1},
     {field_value, 3},
-  [32] =
+  [51] =
     {field_param, 1},
     {field_type, 3},
-  [34] =
+  [53] =
+    {field_element, 2},
+  [54] =
     {field_body, 5},
     {field_params, 1},
-  [36] =
+  [56] =
     {field_body, 6},
     {field_param, 2},
     {field_value, 4},
-  [39] =
+  [59] =
     {field_classifier, 3},
     {field_type, 1},
-  [41] =
+  [61] =
+    {field_body, 7},
+    {field_memo, 2},
+    {field_param, 3},
+    {field_value, 5},
+  [65] =
     {field_body, 7},
     {field_params, 1},
     {field_return_type, 4},
@@ -814,7 +1058,7 @@ static const TSStateId ts_primary_state_ids[STATE_COUNT] = {
   [70] = 70,
   [71] = 71,
   [72] = 72,
-  [73] = 48,
+  [73] = 73,
   [74] = 74,
   [75] = 75,
   [76] = 76,
@@ -840,7 +1084,7 @@ static const TSStateId ts_primary_state_ids[STATE_COUNT] = {
   [96] = 96,
   [97] = 97,
   [98] = 98,
-  [99] = 99,
+  [99] = 97,
   [100] = 100,
   [101] = 101,
   [102] = 102,
@@ -863,6 +1107,57 @@ static const TSStateId ts_primary_state_ids[STATE_COUNT] = {
   [119] = 119,
   [120] = 120,
   [121] = 121,
+  [122] = 122,
+  [123] = 123,
+  [124] = 124,
+  [125] = 125,
+  [126] = 126,
+  [127] = 127,
+  [128] = 128,
+  [129] = 129,
+  [130] = 130,
+  [131] = 131,
+  [132] = 132,
+  [133] = 133,
+  [134] = 134,
+  [135] = 135,
+  [136] = 136,
+  [137] = 137,
+  [138] = 138,
+  [139] = 139,
+  [140] = 140,
+  [141] = 141,
+  [142] = 142,
+  [143] = 143,
+  [144] = 144,
+  [145] = 145,
+  [146] = 146,
+  [147] = 147,
+  [148] = 148,
+  [149] = 149,
+  [150] = 150,
+  [151] = 151,
+  [152] = 152,
+  [153] = 153,
+  [154] = 154,
+  [155] = 155,
+  [156] = 156,
+  [157] = 157,
+  [158] = 158,
+  [159] = 159,
+  [160] = 160,
+  [161] = 161,
+  [162] = 162,
+  [163] = 163,
+  [164] = 164,
+  [165] = 165,
+  [166] = 166,
+  [167] = 167,
+  [168] = 168,
+  [169] = 169,
+  [170] = 170,
+  [171] = 171,
+  [172] = 172,
 };
 
 static bool ts_lex(TSLexer *lexer, TSStateId state) {
@@ -870,246 +1165,338 @@ static bool ts_lex(TSLexer *lexer, TSStateId state) {
   eof = lexer->eof(lexer);
   switch (state) {
     case 0:
-      if (eof) ADVANCE(12);
+      if (eof) ADVANCE(31);
       ADVANCE_MAP(
-        '!', 24,
+        '!', 43,
         '&', 2,
-        '(', 13,
-        ')', 14,
-        '*', 29,
-        '+', 26,
-        ',', 21,
-        '-', 28,
-        '/', 30,
-        ':', 16,
-        '<', 33,
-        '=', 43,
-        '>', 36,
-        '@', 20,
-        '[', 45,
-        ']', 46,
-        '^', 47,
-        '`', 9,
-        '{', 18,
+        '(', 32,
+        ')', 33,
+        '*', 48,
+        '+', 45,
+        ',', 40,
+        '-', 47,
+        '.', 66,
+        '/', 49,
+        ':', 35,
+        '<', 52,
+        '=', 70,
+        '>', 55,
+        '@', 39,
+        'A', 25,
+        '[', 72,
+        ']', 73,
+        '^', 74,
+        '`', 29,
+        '{', 37,
         '|', 10,
-        '}', 19,
-        '~', 41,
+        '}', 38,
+        '~', 68,
       );
       if (('\t' <= lookahead && lookahead <= '\r') ||
           lookahead == ' ') SKIP(0);
-      if (('0' <= lookahead && lookahead <= '9')) ADVANCE(25);
-      if (('_' <= lookahead && lookahead <= 'z')) ADVANCE(23);
+      if (('0' <= lookahead && lookahead <= '9')) ADVANCE(44);
+      if (('_' <= lookahead && lookahead <= 'z')) ADVANCE(42);
       END_STATE();
     case 1:
       ADVANCE_MAP(
-        '!', 24,
-        '(', 13,
-        ')', 14,
-        ',', 21,
-        ':', 8,
-        '=', 42,
-        '>', 35,
-        '@', 20,
-        '[', 45,
-        ']', 46,
-        '`', 9,
-        '~', 41,
+        '!', 43,
+        '(', 32,
+        ')', 33,
+        ',', 40,
+        ':', 9,
+        '=', 69,
+        '>', 54,
+        '@', 39,
+        'A', 25,
+        '[', 72,
+        ']', 73,
+        '`', 29,
+        '~', 68,
       );
       if (('\t' <= lookahead && lookahead <= '\r') ||
           lookahead == ' ') SKIP(1);
-      if (('0' <= lookahead && lookahead <= '9')) ADVANCE(25);
-      if (('_' <= lookahead && lookahead <= 'z')) ADVANCE(23);
+      if (('0' <= lookahead && lookahead <= '9')) ADVANCE(44);
+      if (('_' <= lookahead && lookahead <= 'z')) ADVANCE(42);
       END_STATE();
     case 2:
-      if (lookahead == '&') ADVANCE(38);
+      if (lookahead == '&') ADVANCE(57);
       END_STATE();
     case 3:
-      if (lookahead == ')') ADVANCE(14);
-      if (lookahead == ',') ADVANCE(21);
-      if (lookahead == '-') ADVANCE(7);
-      if (lookahead == '=') ADVANCE(44);
-      if (lookahead == '@') ADVANCE(20);
+      if (lookahead == ')') ADVANCE(33);
+      if (lookahead == '*') ADVANCE(48);
+      if (lookahead == ',') ADVANCE(40);
+      if (lookahead == '-') ADVANCE(8);
+      if (lookahead == '=') ADVANCE(71);
+      if (lookahead == '@') ADVANCE(39);
       if (('\t' <= lookahead && lookahead <= '\r') ||
           lookahead == ' ') SKIP(3);
       END_STATE();
     case 4:
-      if (lookahead == ')') ADVANCE(14);
-      if (lookahead == ',') ADVANCE(21);
-      if (lookahead == ':') ADVANCE(15);
-      if (lookahead == '=') ADVANCE(42);
-      if (lookahead == '@') ADVANCE(20);
+      if (lookahead == ')') ADVANCE(33);
+      if (lookahead == ',') ADVANCE(40);
+      if (lookahead == ':') ADVANCE(34);
+      if (lookahead == '=') ADVANCE(69);
+      if (lookahead == '@') ADVANCE(39);
       if (('\t' <= lookahead && lookahead <= '\r') ||
           lookahead == ' ') SKIP(4);
       END_STATE();
     case 5:
-      if (lookahead == '=') ADVANCE(31);
-      if (lookahead == '>') ADVANCE(17);
+      if (lookahead == '.') ADVANCE(15);
       END_STATE();
     case 6:
-      if (lookahead == '=') ADVANCE(32);
+      if (lookahead == '=') ADVANCE(50);
+      if (lookahead == '>') ADVANCE(36);
       END_STATE();
     case 7:
-      if (lookahead == '>') ADVANCE(48);
+      if (lookahead == '=') ADVANCE(51);
       END_STATE();
     case 8:
-      if (lookahead == '>') ADVANCE(22);
+      if (lookahead == '>') ADVANCE(75);
       END_STATE();
     case 9:
-      if (lookahead == '{') ADVANCE(40);
+      if (lookahead == '>') ADVANCE(41);
       END_STATE();
     case 10:
-      if (lookahead == '|') ADVANCE(39);
+      if (lookahead == ']') ADVANCE(60);
+      if (lookahead == '|') ADVANCE(58);
       END_STATE();
     case 11:
-      if (eof) ADVANCE(12);
+      if (lookahead == 'a') ADVANCE(28);
+      END_STATE();
+    case 12:
+      if (lookahead == 'a') ADVANCE(23);
+      END_STATE();
+    case 13:
+      if (lookahead == 'd') ADVANCE(65);
+      END_STATE();
+    case 14:
+      if (lookahead == 'e') ADVANCE(21);
+      END_STATE();
+    case 15:
+      if (lookahead == 'f') ADVANCE(22);
+      if (lookahead == 'i') ADVANCE(20);
+      if (lookahead == 'l') ADVANCE(14);
+      if (lookahead == 'm') ADVANCE(12);
+      END_STATE();
+    case 16:
+      if (lookahead == 'g') ADVANCE(27);
+      END_STATE();
+    case 17:
+      if (lookahead == 'h') ADVANCE(62);
+      END_STATE();
+    case 18:
+      if (lookahead == 'i') ADVANCE(26);
+      END_STATE();
+    case 19:
+      if (lookahead == 'l') ADVANCE(13);
+      END_STATE();
+    case 20:
+      if (lookahead == 'n') ADVANCE(18);
+      END_STATE();
+    case 21:
+      if (lookahead == 'n') ADVANCE(16);
+      END_STATE();
+    case 22:
+      if (lookahead == 'o') ADVANCE(19);
+      END_STATE();
+    case 23:
+      if (lookahead == 'p') ADVANCE(64);
+      END_STATE();
+    case 24:
+      if (lookahead == 'r') ADVANCE(11);
+      END_STATE();
+    case 25:
+      if (lookahead == 'r') ADVANCE(24);
+      END_STATE();
+    case 26:
+      if (lookahead == 't') ADVANCE(63);
+      END_STATE();
+    case 27:
+      if (lookahead == 't') ADVANCE(17);
+      END_STATE();
+    case 28:
+      if (lookahead == 'y') ADVANCE(5);
+      END_STATE();
+    case 29:
+      if (lookahead == '{') ADVANCE(67);
+      END_STATE();
+    case 30:
+      if (eof) ADVANCE(31);
       ADVANCE_MAP(
-        '!', 6,
+        '!', 7,
         '&', 2,
-        '(', 13,
-        ')', 14,
-        '*', 29,
-        '+', 26,
-        ',', 21,
-        '-', 27,
-        '/', 30,
-        ':', 15,
-        '<', 33,
-        '=', 5,
-        '>', 36,
-        '@', 20,
-        '[', 45,
-        '^', 47,
-        '`', 9,
+        '(', 32,
+        ')', 33,
+        '*', 48,
+        '+', 45,
+        ',', 40,
+        '-', 46,
+        '.', 66,
+        '/', 49,
+        ':', 34,
+        '<', 52,
+        '=', 6,
+        '>', 55,
+        '@', 39,
+        '[', 72,
+        '^', 74,
+        '`', 29,
         '|', 10,
-        '}', 19,
-        '~', 41,
+        '}', 38,
+        '~', 68,
       );
       if (('\t' <= lookahead && lookahead <= '\r') ||
-          lookahead == ' ') SKIP(11);
-      if (('0' <= lookahead && lookahead <= '9')) ADVANCE(25);
-      if (('_' <= lookahead && lookahead <= 'z')) ADVANCE(23);
+          lookahead == ' ') SKIP(30);
+      if (('0' <= lookahead && lookahead <= '9')) ADVANCE(44);
+      if (('_' <= lookahead && lookahead <= 'z')) ADVANCE(42);
       END_STATE();
-    case 12:
+    case 31:
       ACCEPT_TOKEN(ts_builtin_sym_end);
       END_STATE();
-    case 13:
+    case 32:
       ACCEPT_TOKEN(anon_sym_LPAREN);
       END_STATE();
-    case 14:
+    case 33:
       ACCEPT_TOKEN(anon_sym_RPAREN);
       END_STATE();
-    case 15:
+    case 34:
       ACCEPT_TOKEN(anon_sym_COLON);
       END_STATE();
-    case 16:
+    case 35:
       ACCEPT_TOKEN(anon_sym_COLON);
-      if (lookahead == '>') ADVANCE(22);
+      if (lookahead == '>') ADVANCE(41);
       END_STATE();
-    case 17:
+    case 36:
       ACCEPT_TOKEN(anon_sym_EQ_GT);
       END_STATE();
-    case 18:
+    case 37:
       ACCEPT_TOKEN(anon_sym_LBRACE);
       END_STATE();
-    case 19:
+    case 38:
       ACCEPT_TOKEN(anon_sym_RBRACE);
       END_STATE();
-    case 20:
+    case 39:
       ACCEPT_TOKEN(anon_sym_AT);
       END_STATE();
-    case 21:
+    case 40:
       ACCEPT_TOKEN(anon_sym_COMMA);
       END_STATE();
-    case 22:
+    case 41:
       ACCEPT_TOKEN(anon_sym_COLON_GT);
       END_STATE();
-    case 23:
+    case 42:
       ACCEPT_TOKEN(sym_identifier);
       if (('0' <= lookahead && lookahead <= '9') ||
           ('A' <= lookahead && lookahead <= 'Z') ||
           lookahead == '_' ||
-          ('a' <= lookahead && lookahead <= 'z')) ADVANCE(23);
+          ('a' <= lookahead && lookahead <= 'z')) ADVANCE(42);
       END_STATE();
-    case 24:
+    case 43:
       ACCEPT_TOKEN(anon_sym_BANG);
       END_STATE();
-    case 25:
+    case 44:
       ACCEPT_TOKEN(sym_number);
-      if (('0' <= lookahead && lookahead <= '9')) ADVANCE(25);
+      if (('0' <= lookahead && lookahead <= '9')) ADVANCE(44);
       END_STATE();
-    case 26:
+    case 45:
       ACCEPT_TOKEN(anon_sym_PLUS);
       END_STATE();
-    case 27:
+    case 46:
       ACCEPT_TOKEN(anon_sym_DASH);
       END_STATE();
-    case 28:
+    case 47:
       ACCEPT_TOKEN(anon_sym_DASH);
-      if (lookahead == '>') ADVANCE(48);
+      if (lookahead == '>') ADVANCE(75);
       END_STATE();
-    case 29:
+    case 48:
       ACCEPT_TOKEN(anon_sym_STAR);
       END_STATE();
-    case 30:
+    case 49:
       ACCEPT_TOKEN(anon_sym_SLASH);
       END_STATE();
-    case 31:
+    case 50:
       ACCEPT_TOKEN(anon_sym_EQ_EQ);
       END_STATE();
-    case 32:
+    case 51:
       ACCEPT_TOKEN(anon_sym_BANG_EQ);
       END_STATE();
-    case 33:
+    case 52:
       ACCEPT_TOKEN(anon_sym_LT);
-      if (lookahead == '=') ADVANCE(34);
+      if (lookahead == '=') ADVANCE(53);
       END_STATE();
-    case 34:
+    case 53:
       ACCEPT_TOKEN(anon_sym_LT_EQ);
       END_STATE();
-    case 35:
+    case 54:
       ACCEPT_TOKEN(anon_sym_GT);
       END_STATE();
-    case 36:
+    case 55:
       ACCEPT_TOKEN(anon_sym_GT);
-      if (lookahead == '=') ADVANCE(37);
+      if (lookahead == '=') ADVANCE(56);
       END_STATE();
-    case 37:
+    case 56:
       ACCEPT_TOKEN(anon_sym_GT_EQ);
       END_STATE();
-    case 38:
+    case 57:
       ACCEPT_TOKEN(anon_sym_AMP_AMP);
       END_STATE();
-    case 39:
+    case 58:
       ACCEPT_TOKEN(anon_sym_PIPE_PIPE);
       END_STATE();
-    case 40:
+    case 59:
+      ACCEPT_TOKEN(anon_sym_LBRACK_PIPE);
+      END_STATE();
+    case 60:
+      ACCEPT_TOKEN(anon_sym_PIPE_RBRACK);
+      END_STATE();
+    case 61:
+      ACCEPT_TOKEN(anon_sym_DOT_LPAREN);
+      END_STATE();
+    case 62:
+      ACCEPT_TOKEN(anon_sym_Array_DOTlength);
+      END_STATE();
+    case 63:
+      ACCEPT_TOKEN(anon_sym_Array_DOTinit);
+      END_STATE();
+    case 64:
+      ACCEPT_TOKEN(anon_sym_Array_DOTmap);
+      END_STATE();
+    case 65:
+      ACCEPT_TOKEN(anon_sym_Array_DOTfold);
+      END_STATE();
+    case 66:
+      ACCEPT_TOKEN(anon_sym_DOT);
+      if (lookahead == '(') ADVANCE(61);
+      END_STATE();
+    case 67:
       ACCEPT_TOKEN(anon_sym_BQUOTE_LBRACE);
       END_STATE();
-    case 41:
+    case 68:
       ACCEPT_TOKEN(anon_sym_TILDE);
       END_STATE();
-    case 42:
+    case 69:
       ACCEPT_TOKEN(anon_sym_EQ);
       END_STATE();
-    case 43:
+    case 70:
       ACCEPT_TOKEN(anon_sym_EQ);
-      if (lookahead == '=') ADVANCE(31);
-      if (lookahead == '>') ADVANCE(17);
+      if (lookahead == '=') ADVANCE(50);
+      if (lookahead == '>') ADVANCE(36);
       END_STATE();
-    case 44:
+    case 71:
       ACCEPT_TOKEN(anon_sym_EQ);
-      if (lookahead == '>') ADVANCE(17);
+      if (lookahead == '>') ADVANCE(36);
       END_STATE();
-    case 45:
+    case 72:
       ACCEPT_TOKEN(anon_sym_LBRACK);
+      if (lookahead == '|') ADVANCE(59);
       END_STATE();
-    case 46:
+    case 73:
       ACCEPT_TOKEN(anon_sym_RBRACK);
       END_STATE();
-    case 47:
+    case 74:
       ACCEPT_TOKEN(anon_sym_CARET);
       END_STATE();
-    case 48:
+    case 75:
       ACCEPT_TOKEN(anon_sym_DASH_GT);
       END_STATE();
     default:
@@ -1123,120 +1510,172 @@ static bool ts_lex_keywords(TSLexer *lexer, TSStateId state) {
   switch (state) {
     case 0:
       ADVANCE_MAP(
-        'b', 1,
-        'e', 2,
-        'f', 3,
-        'i', 4,
-        'l', 5,
-        'm', 6,
-        'r', 7,
-        't', 8,
+        'a', 1,
+        'b', 2,
+        'c', 3,
+        'e', 4,
+        'f', 5,
+        'g', 6,
+        'i', 7,
+        'l', 8,
+        'm', 9,
+        'r', 10,
+        't', 11,
       );
       if (('\t' <= lookahead && lookahead <= '\r') ||
           lookahead == ' ') SKIP(0);
       END_STATE();
     case 1:
-      if (lookahead == 'o') ADVANCE(9);
+      if (lookahead == 'r') ADVANCE(12);
       END_STATE();
     case 2:
-      if (lookahead == 'l') ADVANCE(10);
+      if (lookahead == 'o') ADVANCE(13);
       END_STATE();
     case 3:
-      if (lookahead == 'a') ADVANCE(11);
+      if (lookahead == 's') ADVANCE(14);
       END_STATE();
     case 4:
-      if (lookahead == 'f') ADVANCE(12);
-      if (lookahead == 'n') ADVANCE(13);
+      if (lookahead == 'l') ADVANCE(15);
       END_STATE();
     case 5:
-      if (lookahead == 'e') ADVANCE(14);
+      if (lookahead == 'a') ADVANCE(16);
       END_STATE();
     case 6:
-      if (lookahead == 'o') ADVANCE(15);
+      if (lookahead == 'e') ADVANCE(17);
       END_STATE();
     case 7:
-      if (lookahead == 'e') ADVANCE(16);
+      if (lookahead == 'f') ADVANCE(18);
+      if (lookahead == 'n') ADVANCE(19);
       END_STATE();
     case 8:
-      if (lookahead == 'h') ADVANCE(17);
-      if (lookahead == 'r') ADVANCE(18);
+      if (lookahead == 'e') ADVANCE(20);
       END_STATE();
     case 9:
-      if (lookahead == 'o') ADVANCE(19);
+      if (lookahead == 'e') ADVANCE(21);
+      if (lookahead == 'o') ADVANCE(22);
       END_STATE();
     case 10:
-      if (lookahead == 's') ADVANCE(20);
+      if (lookahead == 'e') ADVANCE(23);
       END_STATE();
     case 11:
-      if (lookahead == 'l') ADVANCE(21);
+      if (lookahead == 'h') ADVANCE(24);
+      if (lookahead == 'r') ADVANCE(25);
       END_STATE();
     case 12:
-      ACCEPT_TOKEN(anon_sym_if);
+      if (lookahead == 'r') ADVANCE(26);
       END_STATE();
     case 13:
-      ACCEPT_TOKEN(anon_sym_in);
-      if (lookahead == 't') ADVANCE(22);
+      if (lookahead == 'o') ADVANCE(27);
       END_STATE();
     case 14:
-      if (lookahead == 't') ADVANCE(23);
+      ACCEPT_TOKEN(anon_sym_cs);
       END_STATE();
     case 15:
-      if (lookahead == 'd') ADVANCE(24);
+      if (lookahead == 's') ADVANCE(28);
       END_STATE();
     case 16:
-      if (lookahead == 'c') ADVANCE(25);
+      if (lookahead == 'l') ADVANCE(29);
       END_STATE();
     case 17:
-      if (lookahead == 'e') ADVANCE(26);
+      if (lookahead == 'n') ADVANCE(30);
       END_STATE();
     case 18:
-      if (lookahead == 'u') ADVANCE(27);
+      ACCEPT_TOKEN(anon_sym_if);
       END_STATE();
     case 19:
-      if (lookahead == 'l') ADVANCE(28);
+      ACCEPT_TOKEN(anon_sym_in);
+      if (lookahead == 't') ADVANCE(31);
       END_STATE();
     case 20:
-      if (lookahead == 'e') ADVANCE(29);
+      if (lookahead == 't') ADVANCE(32);
       END_STATE();
     case 21:
-      if (lookahead == 's') ADVANCE(30);
+      if (lookahead == 'm') ADVANCE(33);
       END_STATE();
     case 22:
-      ACCEPT_TOKEN(sym_int_type);
+      if (lookahead == 'd') ADVANCE(34);
       END_STATE();
     case 23:
-      ACCEPT_TOKEN(anon_sym_let);
+      if (lookahead == 'c') ADVANCE(35);
       END_STATE();
     case 24:
-      ACCEPT_TOKEN(anon_sym_mod);
+      if (lookahead == 'e') ADVANCE(36);
       END_STATE();
     case 25:
-      ACCEPT_TOKEN(anon_sym_rec);
+      if (lookahead == 'u') ADVANCE(37);
       END_STATE();
     case 26:
-      if (lookahead == 'n') ADVANCE(31);
+      if (lookahead == 'a') ADVANCE(38);
       END_STATE();
     case 27:
-      if (lookahead == 'e') ADVANCE(32);
+      if (lookahead == 'l') ADVANCE(39);
       END_STATE();
     case 28:
-      ACCEPT_TOKEN(sym_bool_type);
+      if (lookahead == 'e') ADVANCE(40);
       END_STATE();
     case 29:
-      ACCEPT_TOKEN(anon_sym_else);
+      if (lookahead == 's') ADVANCE(41);
       END_STATE();
     case 30:
-      if (lookahead == 'e') ADVANCE(33);
+      if (lookahead == 'l') ADVANCE(42);
       END_STATE();
     case 31:
-      ACCEPT_TOKEN(anon_sym_then);
+      ACCEPT_TOKEN(sym_int_type);
       END_STATE();
     case 32:
-      ACCEPT_TOKEN(anon_sym_true);
+      ACCEPT_TOKEN(anon_sym_let);
       END_STATE();
     case 33:
+      if (lookahead == 'o') ADVANCE(43);
+      END_STATE();
+    case 34:
+      ACCEPT_TOKEN(anon_sym_mod);
+      END_STATE();
+    case 35:
+      ACCEPT_TOKEN(anon_sym_rec);
+      END_STATE();
+    case 36:
+      if (lookahead == 'n') ADVANCE(44);
+      END_STATE();
+    case 37:
+      if (lookahead == 'e') ADVANCE(45);
+      END_STATE();
+    case 38:
+      if (lookahead == 'y') ADVANCE(46);
+      END_STATE();
+    case 39:
+      ACCEPT_TOKEN(sym_bool_type);
+      END_STATE();
+    case 40:
+      ACCEPT_TOKEN(anon_sym_else);
+      END_STATE();
+    case 41:
+      if (lookahead == 'e') ADVANCE(47);
+      END_STATE();
+    case 42:
+      if (lookahead == 'e') ADVANCE(48);
+      END_STATE();
+    case 43:
+      ACCEPT_TOKEN(sym_memo);
+      END_STATE();
+    case 44:
+      ACCEPT_TOKEN(anon_sym_then);
+      END_STATE();
+    case 45:
+      ACCEPT_TOKEN(anon_sym_true);
+      END_STATE();
+    case 46:
+      ACCEPT_TOKEN(anon_sym_array);
+      END_STATE();
+    case 47:
       ACCEPT_TOKEN(anon_sym_false);
       END_STATE();
+    case 48:
+      if (lookahead == 't') ADVANCE(49);
+      END_STATE();
+    case 49:
+      ACCEPT_TOKEN(anon_sym_genlet);
+      END_STATE();
     default:
       return false;
   }
@@ -1273,79 +1712,79 @@ static const TSLexMode ts_lex_modes[STATE_COUNT] = {
   [27] = {.lex_state = 0},
   [28] = {.lex_state = 0},
   [29] = {.lex_state = 0},
-  [30] = {.lex_state = 11},
-  [31] = {.lex_state = 11},
-  [32] = {.lex_state = 11},
-  [33] = {.lex_state = 11},
-  [34] = {.lex_state = 11},
-  [35] = {.lex_state = 11},
-  [36] = {.lex_state = 11},
-  [37] = {.lex_state = 11},
-  [38] = {.lex_state = 11},
-  [39] = {.lex_state = 11},
-  [40] = {.lex_state = 11},
-  [41] = {.lex_state = 11},
-  [42] = {.lex_state = 11},
-  [43] = {.lex_state = 11},
-  [44] = {.lex_state = 11},
-  [45] = {.lex_state = 11},
-  [46] = {.lex_state = 11},
-  [47] = {.lex_state = 11},
-  [48] = {.lex_state = 11},
-  [49] = {.lex_state = 11},
-  [50] = {.lex_state = 11},
-  [51] = {.lex_state = 11},
-  [52] = {.lex_state = 11},
-  [53] = {.lex_state = 11},
-  [54] = {.lex_state = 11},
-  [55] = {.lex_state = 11},
-  [56] = {.lex_state = 11},
-  [57] = {.lex_state = 11},
-  [58] = {.lex_state = 11},
-  [59] = {.lex_state = 11},
-  [60] = {.lex_state = 11},
-  [61] = {.lex_state = 11},
-  [62] = {.lex_state = 11},
-  [63] = {.lex_state = 11},
-  [64] = {.lex_state = 11},
-  [65] = {.lex_state = 11},
-  [66] = {.lex_state = 11},
-  [67] = {.lex_state = 11},
-  [68] = {.lex_state = 11},
-  [69] = {.lex_state = 11},
-  [70] = {.lex_state = 11},
-  [71] = {.lex_state = 11},
-  [72] = {.lex_state = 11},
-  [73] = {.lex_state = 1},
-  [74] = {.lex_state = 0},
-  [75] = {.lex_state = 0},
-  [76] = {.lex_state = 0},
-  [77] = {.lex_state = 0},
-  [78] = {.lex_state = 0},
-  [79] = {.lex_state = 0},
-  [80] = {.lex_state = 0},
-  [81] = {.lex_state = 3},
-  [82] = {.lex_state = 3},
-  [83] = {.lex_state = 3},
-  [84] = {.lex_state = 3},
-  [85] = {.lex_state = 4},
-  [86] = {.lex_state = 3},
-  [87] = {.lex_state = 0},
-  [88] = {.lex_state = 1},
-  [89] = {.lex_state = 0},
-  [90] = {.lex_state = 0},
-  [91] = {.lex_state = 1},
-  [92] = {.lex_state = 0},
-  [93] = {.lex_state = 0},
-  [94] = {.lex_state = 0},
-  [95] = {.lex_state = 0},
-  [96] = {.lex_state = 0},
-  [97] = {.lex_state = 0},
-  [98] = {.lex_state = 0},
+  [30] = {.lex_state = 0},
+  [31] = {.lex_state = 0},
+  [32] = {.lex_state = 0},
+  [33] = {.lex_state = 0},
+  [34] = {.lex_state = 0},
+  [35] = {.lex_state = 0},
+  [36] = {.lex_state = 0},
+  [37] = {.lex_state = 30},
+  [38] = {.lex_state = 30},
+  [39] = {.lex_state = 30},
+  [40] = {.lex_state = 30},
+  [41] = {.lex_state = 30},
+  [42] = {.lex_state = 30},
+  [43] = {.lex_state = 30},
+  [44] = {.lex_state = 30},
+  [45] = {.lex_state = 30},
+  [46] = {.lex_state = 30},
+  [47] = {.lex_state = 30},
+  [48] = {.lex_state = 30},
+  [49] = {.lex_state = 30},
+  [50] = {.lex_state = 30},
+  [51] = {.lex_state = 30},
+  [52] = {.lex_state = 30},
+  [53] = {.lex_state = 30},
+  [54] = {.lex_state = 30},
+  [55] = {.lex_state = 30},
+  [56] = {.lex_state = 30},
+  [57] = {.lex_state = 30},
+  [58] = {.lex_state = 30},
+  [59] = {.lex_state = 30},
+  [60] = {.lex_state = 30},
+  [61] = {.lex_state = 30},
+  [62] = {.lex_state = 30},
+  [63] = {.lex_state = 30},
+  [64] = {.lex_state = 30},
+  [65] = {.lex_state = 30},
+  [66] = {.lex_state = 30},
+  [67] = {.lex_state = 30},
+  [68] = {.lex_state = 30},
+  [69] = {.lex_state = 30},
+  [70] = {.lex_state = 30},
+  [71] = {.lex_state = 30},
+  [72] = {.lex_state = 30},
+  [73] = {.lex_state = 30},
+  [74] = {.lex_state = 30},
+  [75] = {.lex_state = 30},
+  [76] = {.lex_state = 30},
+  [77] = {.lex_state = 30},
+  [78] = {.lex_state = 30},
+  [79] = {.lex_state = 30},
+  [80] = {.lex_state = 30},
+  [81] = {.lex_state = 30},
+  [82] = {.lex_state = 30},
+  [83] = {.lex_state = 30},
+  [84] = {.lex_state = 30},
+  [85] = {.lex_state = 30},
+  [86] = {.lex_state = 30},
+  [87] = {.lex_state = 30},
+  [88] = {.lex_state = 30},
+  [89] = {.lex_state = 30},
+  [90] = {.lex_state = 30},
+  [91] = {.lex_state = 30},
+  [92] = {.lex_state = 30},
+  [93] = {.lex_state = 30},
+  [94] = {.lex_state = 30},
+  [95] = {.lex_state = 30},
+  [96] = {.lex_state = 30},
+  [97] = {.lex_state = 30},
+  [98] = {.lex_state = 30},
   [99] = {.lex_state = 1},
   [100] = {.lex_state = 0},
   [101] = {.lex_state = 0},
-  [102] = {.lex_state = 11},
+  [102] = {.lex_state = 0},
   [103] = {.lex_state = 0},
   [104] = {.lex_state = 0},
   [105] = {.lex_state = 0},
@@ -1358,13 +1797,64 @@ static const TSLexMode ts_lex_modes[STATE_COUNT] = {
   [112] = {.lex_state = 0},
   [113] = {.lex_state = 0},
   [114] = {.lex_state = 0},
-  [115] = {.lex_state = 1},
+  [115] = {.lex_state = 0},
   [116] = {.lex_state = 0},
-  [117] = {.lex_state = 0},
-  [118] = {.lex_state = 11},
-  [119] = {.lex_state = 1},
-  [120] = {.lex_state = 1},
-  [121] = {.lex_state = 1},
+  [117] = {.lex_state = 3},
+  [118] = {.lex_state = 3},
+  [119] = {.lex_state = 3},
+  [120] = {.lex_state = 3},
+  [121] = {.lex_state = 3},
+  [122] = {.lex_state = 3},
+  [123] = {.lex_state = 3},
+  [124] = {.lex_state = 3},
+  [125] = {.lex_state = 4},
+  [126] = {.lex_state = 3},
+  [127] = {.lex_state = 0},
+  [128] = {.lex_state = 0},
+  [129] = {.lex_state = 0},
+  [130] = {.lex_state = 1},
+  [131] = {.lex_state = 0},
+  [132] = {.lex_state = 0},
+  [133] = {.lex_state = 0},
+  [134] = {.lex_state = 0},
+  [135] = {.lex_state = 0},
+  [136] = {.lex_state = 0},
+  [137] = {.lex_state = 0},
+  [138] = {.lex_state = 0},
+  [139] = {.lex_state = 0},
+  [140] = {.lex_state = 0},
+  [141] = {.lex_state = 1},
+  [142] = {.lex_state = 0},
+  [143] = {.lex_state = 0},
+  [144] = {.lex_state = 0},
+  [145] = {.lex_state = 1},
+  [146] = {.lex_state = 0},
+  [147] = {.lex_state = 0},
+  [148] = {.lex_state = 0},
+  [149] = {.lex_state = 30},
+  [150] = {.lex_state = 0},
+  [151] = {.lex_state = 0},
+  [152] = {.lex_state = 0},
+  [153] = {.lex_state = 0},
+  [154] = {.lex_state = 0},
+  [155] = {.lex_state = 1},
+  [156] = {.lex_state = 0},
+  [157] = {.lex_state = 1},
+  [158] = {.lex_state = 0},
+  [159] = {.lex_state = 1},
+  [160] = {.lex_state = 1},
+  [161] = {.lex_state = 0},
+  [162] = {.lex_state = 0},
+  [163] = {.lex_state = 1},
+  [164] = {.lex_state = 0},
+  [165] = {.lex_state = 0},
+  [166] = {.lex_state = 0},
+  [167] = {.lex_state = 0},
+  [168] = {.lex_state = 0},
+  [169] = {.lex_state = 30},
+  [170] = {.lex_state = 1},
+  [171] = {.lex_state = 0},
+  [172] = {.lex_state = 1},
 };
 
 static const uint16_t ts_parse_table[LARGE_STATE_COUNT][SYMBOL_COUNT] = {
@@ -1399,32 +1889,1840 @@ static const uint16_t ts_parse_table[LARGE_STATE_COUNT][SYMBOL_COUNT] = {
     [anon_sym_GT_EQ] = ACTIONS(1),
     [anon_sym_AMP_AMP] = ACTIONS(1),
     [anon_sym_PIPE_PIPE] = ACTIONS(1),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(1),
+    [anon_sym_PIPE_RBRACK] = ACTIONS(1),
+    [anon_sym_DOT_LPAREN] = ACTIONS(1),
+    [anon_sym_Array_DOTlength] = ACTIONS(1),
+    [anon_sym_Array_DOTinit] = ACTIONS(1),
+    [anon_sym_Array_DOTmap] = ACTIONS(1),
+    [anon_sym_Array_DOTfold] = ACTIONS(1),
+    [anon_sym_DOT] = ACTIONS(1),
     [anon_sym_BQUOTE_LBRACE] = ACTIONS(1),
     [anon_sym_TILDE] = ACTIONS(1),
+    [anon_sym_genlet] = ACTIONS(1),
     [anon_sym_let] = ACTIONS(1),
     [anon_sym_EQ] = ACTIONS(1),
     [anon_sym_in] = ACTIONS(1),
     [anon_sym_rec] = ACTIONS(1),
+    [sym_memo] = ACTIONS(1),
+    [anon_sym_cs] = ACTIONS(1),
     [anon_sym_LBRACK] = ACTIONS(1),
     [anon_sym_RBRACK] = ACTIONS(1),
     [anon_sym_CARET] = ACTIONS(1),
     [sym_int_type] = ACTIONS(1),
     [sym_bool_type] = ACTIONS(1),
+    [anon_sym_array] = ACTIONS(1),
     [anon_sym_DASH_GT] = ACTIONS(1),
   },
   [1] = {
-    [sym_source_file] = STATE(108),
-    [sym__expression] = STATE(53),
-    [sym__expression_with_clsapp] = STATE(51),
-    [sym__simple_expression] = STATE(51),
-    [sym_lambda] = STATE(51),
-    [sym_application] = STATE(53),
-    [sym_add] = STATE(53),
+    [sym_source_file] = STATE(152),
+    [sym__expression] = STATE(60),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(60),
+    [sym_add] = STATE(60),
+    [sym_sub] = STATE(60),
+    [sym_mult] = STATE(60),
+    [sym_div] = STATE(60),
+    [sym_mod] = STATE(60),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(60),
+    [sym_eq] = STATE(60),
+    [sym_ne] = STATE(60),
+    [sym_lt] = STATE(60),
+    [sym_le] = STATE(60),
+    [sym_gt] = STATE(60),
+    [sym_ge] = STATE(60),
+    [sym_and] = STATE(60),
+    [sym_or] = STATE(60),
+    [sym_not] = STATE(60),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(60),
+    [sym_array_init] = STATE(60),
+    [sym_array_map] = STATE(60),
+    [sym_array_fold] = STATE(60),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(60),
+    [sym_let] = STATE(60),
+    [sym_letrec] = STATE(60),
+    [sym_letcs] = STATE(60),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [2] = {
+    [sym__expression] = STATE(56),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(56),
+    [sym_param] = STATE(132),
+    [sym_params] = STATE(153),
+    [sym_add] = STATE(56),
+    [sym_sub] = STATE(56),
+    [sym_mult] = STATE(56),
+    [sym_div] = STATE(56),
+    [sym_mod] = STATE(56),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(56),
+    [sym_eq] = STATE(56),
+    [sym_ne] = STATE(56),
+    [sym_lt] = STATE(56),
+    [sym_le] = STATE(56),
+    [sym_gt] = STATE(56),
+    [sym_ge] = STATE(56),
+    [sym_and] = STATE(56),
+    [sym_or] = STATE(56),
+    [sym_not] = STATE(56),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(56),
+    [sym_array_init] = STATE(56),
+    [sym_array_map] = STATE(56),
+    [sym_array_fold] = STATE(56),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(56),
+    [sym_let] = STATE(56),
+    [sym_letrec] = STATE(56),
+    [sym_letcs] = STATE(56),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(35),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [3] = {
+    [sym__expression] = STATE(57),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(57),
+    [sym_add] = STATE(57),
+    [sym_sub] = STATE(57),
+    [sym_mult] = STATE(57),
+    [sym_div] = STATE(57),
+    [sym_mod] = STATE(57),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(57),
+    [sym_eq] = STATE(57),
+    [sym_ne] = STATE(57),
+    [sym_lt] = STATE(57),
+    [sym_le] = STATE(57),
+    [sym_gt] = STATE(57),
+    [sym_ge] = STATE(57),
+    [sym_and] = STATE(57),
+    [sym_or] = STATE(57),
+    [sym_not] = STATE(57),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(57),
+    [sym_array_init] = STATE(57),
+    [sym_array_map] = STATE(57),
+    [sym_array_fold] = STATE(57),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(57),
+    [sym_let] = STATE(57),
+    [sym_letrec] = STATE(57),
+    [sym_letcs] = STATE(57),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_PIPE_RBRACK] = ACTIONS(37),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [4] = {
+    [sym__expression] = STATE(64),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(64),
+    [sym_add] = STATE(64),
+    [sym_sub] = STATE(64),
+    [sym_mult] = STATE(64),
+    [sym_div] = STATE(64),
+    [sym_mod] = STATE(64),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(64),
+    [sym_eq] = STATE(64),
+    [sym_ne] = STATE(64),
+    [sym_lt] = STATE(64),
+    [sym_le] = STATE(64),
+    [sym_gt] = STATE(64),
+    [sym_ge] = STATE(64),
+    [sym_and] = STATE(64),
+    [sym_or] = STATE(64),
+    [sym_not] = STATE(64),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(64),
+    [sym_array_init] = STATE(64),
+    [sym_array_map] = STATE(64),
+    [sym_array_fold] = STATE(64),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(64),
+    [sym_let] = STATE(64),
+    [sym_letrec] = STATE(64),
+    [sym_letcs] = STATE(64),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_AT] = ACTIONS(39),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [5] = {
+    [sym__expression] = STATE(37),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(37),
+    [sym_add] = STATE(37),
+    [sym_sub] = STATE(37),
+    [sym_mult] = STATE(37),
+    [sym_div] = STATE(37),
+    [sym_mod] = STATE(37),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(37),
+    [sym_eq] = STATE(37),
+    [sym_ne] = STATE(37),
+    [sym_lt] = STATE(37),
+    [sym_le] = STATE(37),
+    [sym_gt] = STATE(37),
+    [sym_ge] = STATE(37),
+    [sym_and] = STATE(37),
+    [sym_or] = STATE(37),
+    [sym_not] = STATE(37),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(37),
+    [sym_array_init] = STATE(37),
+    [sym_array_map] = STATE(37),
+    [sym_array_fold] = STATE(37),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(37),
+    [sym_let] = STATE(37),
+    [sym_letrec] = STATE(37),
+    [sym_letcs] = STATE(37),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [6] = {
+    [sym__expression] = STATE(62),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(62),
+    [sym_add] = STATE(62),
+    [sym_sub] = STATE(62),
+    [sym_mult] = STATE(62),
+    [sym_div] = STATE(62),
+    [sym_mod] = STATE(62),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(62),
+    [sym_eq] = STATE(62),
+    [sym_ne] = STATE(62),
+    [sym_lt] = STATE(62),
+    [sym_le] = STATE(62),
+    [sym_gt] = STATE(62),
+    [sym_ge] = STATE(62),
+    [sym_and] = STATE(62),
+    [sym_or] = STATE(62),
+    [sym_not] = STATE(62),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(62),
+    [sym_array_init] = STATE(62),
+    [sym_array_map] = STATE(62),
+    [sym_array_fold] = STATE(62),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(62),
+    [sym_let] = STATE(62),
+    [sym_letrec] = STATE(62),
+    [sym_letcs] = STATE(62),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [7] = {
+    [sym__expression] = STATE(68),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(68),
+    [sym_add] = STATE(68),
+    [sym_sub] = STATE(68),
+    [sym_mult] = STATE(68),
+    [sym_div] = STATE(68),
+    [sym_mod] = STATE(68),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(68),
+    [sym_eq] = STATE(68),
+    [sym_ne] = STATE(68),
+    [sym_lt] = STATE(68),
+    [sym_le] = STATE(68),
+    [sym_gt] = STATE(68),
+    [sym_ge] = STATE(68),
+    [sym_and] = STATE(68),
+    [sym_or] = STATE(68),
+    [sym_not] = STATE(68),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(68),
+    [sym_array_init] = STATE(68),
+    [sym_array_map] = STATE(68),
+    [sym_array_fold] = STATE(68),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(68),
+    [sym_let] = STATE(68),
+    [sym_letrec] = STATE(68),
+    [sym_letcs] = STATE(68),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [8] = {
+    [sym__expression] = STATE(38),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(38),
+    [sym_add] = STATE(38),
+    [sym_sub] = STATE(38),
+    [sym_mult] = STATE(38),
+    [sym_div] = STATE(38),
+    [sym_mod] = STATE(38),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(38),
+    [sym_eq] = STATE(38),
+    [sym_ne] = STATE(38),
+    [sym_lt] = STATE(38),
+    [sym_le] = STATE(38),
+    [sym_gt] = STATE(38),
+    [sym_ge] = STATE(38),
+    [sym_and] = STATE(38),
+    [sym_or] = STATE(38),
+    [sym_not] = STATE(38),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(38),
+    [sym_array_init] = STATE(38),
+    [sym_array_map] = STATE(38),
+    [sym_array_fold] = STATE(38),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(38),
+    [sym_let] = STATE(38),
+    [sym_letrec] = STATE(38),
+    [sym_letcs] = STATE(38),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [9] = {
+    [sym__expression] = STATE(39),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(39),
+    [sym_add] = STATE(39),
+    [sym_sub] = STATE(39),
+    [sym_mult] = STATE(39),
+    [sym_div] = STATE(39),
+    [sym_mod] = STATE(39),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(39),
+    [sym_eq] = STATE(39),
+    [sym_ne] = STATE(39),
+    [sym_lt] = STATE(39),
+    [sym_le] = STATE(39),
+    [sym_gt] = STATE(39),
+    [sym_ge] = STATE(39),
+    [sym_and] = STATE(39),
+    [sym_or] = STATE(39),
+    [sym_not] = STATE(39),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(39),
+    [sym_array_init] = STATE(39),
+    [sym_array_map] = STATE(39),
+    [sym_array_fold] = STATE(39),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(39),
+    [sym_let] = STATE(39),
+    [sym_letrec] = STATE(39),
+    [sym_letcs] = STATE(39),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [10] = {
+    [sym__expression] = STATE(40),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(40),
+    [sym_add] = STATE(40),
+    [sym_sub] = STATE(40),
+    [sym_mult] = STATE(40),
+    [sym_div] = STATE(40),
+    [sym_mod] = STATE(40),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(40),
+    [sym_eq] = STATE(40),
+    [sym_ne] = STATE(40),
+    [sym_lt] = STATE(40),
+    [sym_le] = STATE(40),
+    [sym_gt] = STATE(40),
+    [sym_ge] = STATE(40),
+    [sym_and] = STATE(40),
+    [sym_or] = STATE(40),
+    [sym_not] = STATE(40),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(40),
+    [sym_array_init] = STATE(40),
+    [sym_array_map] = STATE(40),
+    [sym_array_fold] = STATE(40),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(40),
+    [sym_let] = STATE(40),
+    [sym_letrec] = STATE(40),
+    [sym_letcs] = STATE(40),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [11] = {
+    [sym__expression] = STATE(41),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(41),
+    [sym_add] = STATE(41),
+    [sym_sub] = STATE(41),
+    [sym_mult] = STATE(41),
+    [sym_div] = STATE(41),
+    [sym_mod] = STATE(41),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(41),
+    [sym_eq] = STATE(41),
+    [sym_ne] = STATE(41),
+    [sym_lt] = STATE(41),
+    [sym_le] = STATE(41),
+    [sym_gt] = STATE(41),
+    [sym_ge] = STATE(41),
+    [sym_and] = STATE(41),
+    [sym_or] = STATE(41),
+    [sym_not] = STATE(41),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(41),
+    [sym_array_init] = STATE(41),
+    [sym_array_map] = STATE(41),
+    [sym_array_fold] = STATE(41),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(41),
+    [sym_let] = STATE(41),
+    [sym_letrec] = STATE(41),
+    [sym_letcs] = STATE(41),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [12] = {
+    [sym__expression] = STATE(42),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(42),
+    [sym_add] = STATE(42),
+    [sym_sub] = STATE(42),
+    [sym_mult] = STATE(42),
+    [sym_div] = STATE(42),
+    [sym_mod] = STATE(42),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(42),
+    [sym_eq] = STATE(42),
+    [sym_ne] = STATE(42),
+    [sym_lt] = STATE(42),
+    [sym_le] = STATE(42),
+    [sym_gt] = STATE(42),
+    [sym_ge] = STATE(42),
+    [sym_and] = STATE(42),
+    [sym_or] = STATE(42),
+    [sym_not] = STATE(42),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(42),
+    [sym_array_init] = STATE(42),
+    [sym_array_map] = STATE(42),
+    [sym_array_fold] = STATE(42),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(42),
+    [sym_let] = STATE(42),
+    [sym_letrec] = STATE(42),
+    [sym_letcs] = STATE(42),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [13] = {
+    [sym__expression] = STATE(43),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(43),
+    [sym_add] = STATE(43),
+    [sym_sub] = STATE(43),
+    [sym_mult] = STATE(43),
+    [sym_div] = STATE(43),
+    [sym_mod] = STATE(43),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(43),
+    [sym_eq] = STATE(43),
+    [sym_ne] = STATE(43),
+    [sym_lt] = STATE(43),
+    [sym_le] = STATE(43),
+    [sym_gt] = STATE(43),
+    [sym_ge] = STATE(43),
+    [sym_and] = STATE(43),
+    [sym_or] = STATE(43),
+    [sym_not] = STATE(43),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(43),
+    [sym_array_init] = STATE(43),
+    [sym_array_map] = STATE(43),
+    [sym_array_fold] = STATE(43),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(43),
+    [sym_let] = STATE(43),
+    [sym_letrec] = STATE(43),
+    [sym_letcs] = STATE(43),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [14] = {
+    [sym__expression] = STATE(44),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(44),
+    [sym_add] = STATE(44),
+    [sym_sub] = STATE(44),
+    [sym_mult] = STATE(44),
+    [sym_div] = STATE(44),
+    [sym_mod] = STATE(44),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(44),
+    [sym_eq] = STATE(44),
+    [sym_ne] = STATE(44),
+    [sym_lt] = STATE(44),
+    [sym_le] = STATE(44),
+    [sym_gt] = STATE(44),
+    [sym_ge] = STATE(44),
+    [sym_and] = STATE(44),
+    [sym_or] = STATE(44),
+    [sym_not] = STATE(44),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(44),
+    [sym_array_init] = STATE(44),
+    [sym_array_map] = STATE(44),
+    [sym_array_fold] = STATE(44),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(44),
+    [sym_let] = STATE(44),
+    [sym_letrec] = STATE(44),
+    [sym_letcs] = STATE(44),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [15] = {
+    [sym__expression] = STATE(45),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(45),
+    [sym_add] = STATE(45),
+    [sym_sub] = STATE(45),
+    [sym_mult] = STATE(45),
+    [sym_div] = STATE(45),
+    [sym_mod] = STATE(45),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(45),
+    [sym_eq] = STATE(45),
+    [sym_ne] = STATE(45),
+    [sym_lt] = STATE(45),
+    [sym_le] = STATE(45),
+    [sym_gt] = STATE(45),
+    [sym_ge] = STATE(45),
+    [sym_and] = STATE(45),
+    [sym_or] = STATE(45),
+    [sym_not] = STATE(45),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(45),
+    [sym_array_init] = STATE(45),
+    [sym_array_map] = STATE(45),
+    [sym_array_fold] = STATE(45),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(45),
+    [sym_let] = STATE(45),
+    [sym_letrec] = STATE(45),
+    [sym_letcs] = STATE(45),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [16] = {
+    [sym__expression] = STATE(46),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(46),
+    [sym_add] = STATE(46),
+    [sym_sub] = STATE(46),
+    [sym_mult] = STATE(46),
+    [sym_div] = STATE(46),
+    [sym_mod] = STATE(46),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(46),
+    [sym_eq] = STATE(46),
+    [sym_ne] = STATE(46),
+    [sym_lt] = STATE(46),
+    [sym_le] = STATE(46),
+    [sym_gt] = STATE(46),
+    [sym_ge] = STATE(46),
+    [sym_and] = STATE(46),
+    [sym_or] = STATE(46),
+    [sym_not] = STATE(46),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(46),
+    [sym_array_init] = STATE(46),
+    [sym_array_map] = STATE(46),
+    [sym_array_fold] = STATE(46),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(46),
+    [sym_let] = STATE(46),
+    [sym_letrec] = STATE(46),
+    [sym_letcs] = STATE(46),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [17] = {
+    [sym__expression] = STATE(47),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(47),
+    [sym_add] = STATE(47),
+    [sym_sub] = STATE(47),
+    [sym_mult] = STATE(47),
+    [sym_div] = STATE(47),
+    [sym_mod] = STATE(47),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(47),
+    [sym_eq] = STATE(47),
+    [sym_ne] = STATE(47),
+    [sym_lt] = STATE(47),
+    [sym_le] = STATE(47),
+    [sym_gt] = STATE(47),
+    [sym_ge] = STATE(47),
+    [sym_and] = STATE(47),
+    [sym_or] = STATE(47),
+    [sym_not] = STATE(47),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(47),
+    [sym_array_init] = STATE(47),
+    [sym_array_map] = STATE(47),
+    [sym_array_fold] = STATE(47),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(47),
+    [sym_let] = STATE(47),
+    [sym_letrec] = STATE(47),
+    [sym_letcs] = STATE(47),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [18] = {
+    [sym__expression] = STATE(48),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(48),
+    [sym_add] = STATE(48),
+    [sym_sub] = STATE(48),
+    [sym_mult] = STATE(48),
+    [sym_div] = STATE(48),
+    [sym_mod] = STATE(48),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(48),
+    [sym_eq] = STATE(48),
+    [sym_ne] = STATE(48),
+    [sym_lt] = STATE(48),
+    [sym_le] = STATE(48),
+    [sym_gt] = STATE(48),
+    [sym_ge] = STATE(48),
+    [sym_and] = STATE(48),
+    [sym_or] = STATE(48),
+    [sym_not] = STATE(48),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(48),
+    [sym_array_init] = STATE(48),
+    [sym_array_map] = STATE(48),
+    [sym_array_fold] = STATE(48),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(48),
+    [sym_let] = STATE(48),
+    [sym_letrec] = STATE(48),
+    [sym_letcs] = STATE(48),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [19] = {
+    [sym__expression] = STATE(49),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(49),
+    [sym_add] = STATE(49),
+    [sym_sub] = STATE(49),
+    [sym_mult] = STATE(49),
+    [sym_div] = STATE(49),
+    [sym_mod] = STATE(49),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(49),
+    [sym_eq] = STATE(49),
+    [sym_ne] = STATE(49),
+    [sym_lt] = STATE(49),
+    [sym_le] = STATE(49),
+    [sym_gt] = STATE(49),
+    [sym_ge] = STATE(49),
+    [sym_and] = STATE(49),
+    [sym_or] = STATE(49),
+    [sym_not] = STATE(49),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(49),
+    [sym_array_init] = STATE(49),
+    [sym_array_map] = STATE(49),
+    [sym_array_fold] = STATE(49),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(49),
+    [sym_let] = STATE(49),
+    [sym_letrec] = STATE(49),
+    [sym_letcs] = STATE(49),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [20] = {
+    [sym__expression] = STATE(50),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(50),
+    [sym_add] = STATE(50),
+    [sym_sub] = STATE(50),
+    [sym_mult] = STATE(50),
+    [sym_div] = STATE(50),
+    [sym_mod] = STATE(50),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(50),
+    [sym_eq] = STATE(50),
+    [sym_ne] = STATE(50),
+    [sym_lt] = STATE(50),
+    [sym_le] = STATE(50),
+    [sym_gt] = STATE(50),
+    [sym_ge] = STATE(50),
+    [sym_and] = STATE(50),
+    [sym_or] = STATE(50),
+    [sym_not] = STATE(50),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(50),
+    [sym_array_init] = STATE(50),
+    [sym_array_map] = STATE(50),
+    [sym_array_fold] = STATE(50),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(50),
+    [sym_let] = STATE(50),
+    [sym_letrec] = STATE(50),
+    [sym_letcs] = STATE(50),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [21] = {
+    [sym__expression] = STATE(69),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(69),
+    [sym_add] = STATE(69),
+    [sym_sub] = STATE(69),
+    [sym_mult] = STATE(69),
+    [sym_div] = STATE(69),
+    [sym_mod] = STATE(69),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(69),
+    [sym_eq] = STATE(69),
+    [sym_ne] = STATE(69),
+    [sym_lt] = STATE(69),
+    [sym_le] = STATE(69),
+    [sym_gt] = STATE(69),
+    [sym_ge] = STATE(69),
+    [sym_and] = STATE(69),
+    [sym_or] = STATE(69),
+    [sym_not] = STATE(69),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(69),
+    [sym_array_init] = STATE(69),
+    [sym_array_map] = STATE(69),
+    [sym_array_fold] = STATE(69),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(69),
+    [sym_let] = STATE(69),
+    [sym_letrec] = STATE(69),
+    [sym_letcs] = STATE(69),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [22] = {
+    [sym__expression] = STATE(58),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(58),
+    [sym_add] = STATE(58),
+    [sym_sub] = STATE(58),
+    [sym_mult] = STATE(58),
+    [sym_div] = STATE(58),
+    [sym_mod] = STATE(58),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(58),
+    [sym_eq] = STATE(58),
+    [sym_ne] = STATE(58),
+    [sym_lt] = STATE(58),
+    [sym_le] = STATE(58),
+    [sym_gt] = STATE(58),
+    [sym_ge] = STATE(58),
+    [sym_and] = STATE(58),
+    [sym_or] = STATE(58),
+    [sym_not] = STATE(58),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(58),
+    [sym_array_init] = STATE(58),
+    [sym_array_map] = STATE(58),
+    [sym_array_fold] = STATE(58),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(58),
+    [sym_let] = STATE(58),
+    [sym_letrec] = STATE(58),
+    [sym_letcs] = STATE(58),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [23] = {
+    [sym__expression] = STATE(72),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(72),
+    [sym_add] = STATE(72),
+    [sym_sub] = STATE(72),
+    [sym_mult] = STATE(72),
+    [sym_div] = STATE(72),
+    [sym_mod] = STATE(72),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(72),
+    [sym_eq] = STATE(72),
+    [sym_ne] = STATE(72),
+    [sym_lt] = STATE(72),
+    [sym_le] = STATE(72),
+    [sym_gt] = STATE(72),
+    [sym_ge] = STATE(72),
+    [sym_and] = STATE(72),
+    [sym_or] = STATE(72),
+    [sym_not] = STATE(72),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(72),
+    [sym_array_init] = STATE(72),
+    [sym_array_map] = STATE(72),
+    [sym_array_fold] = STATE(72),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(72),
+    [sym_let] = STATE(72),
+    [sym_letrec] = STATE(72),
+    [sym_letcs] = STATE(72),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [24] = {
+    [sym__expression] = STATE(74),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(74),
+    [sym_add] = STATE(74),
+    [sym_sub] = STATE(74),
+    [sym_mult] = STATE(74),
+    [sym_div] = STATE(74),
+    [sym_mod] = STATE(74),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(74),
+    [sym_eq] = STATE(74),
+    [sym_ne] = STATE(74),
+    [sym_lt] = STATE(74),
+    [sym_le] = STATE(74),
+    [sym_gt] = STATE(74),
+    [sym_ge] = STATE(74),
+    [sym_and] = STATE(74),
+    [sym_or] = STATE(74),
+    [sym_not] = STATE(74),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(74),
+    [sym_array_init] = STATE(74),
+    [sym_array_map] = STATE(74),
+    [sym_array_fold] = STATE(74),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(74),
+    [sym_let] = STATE(74),
+    [sym_letrec] = STATE(74),
+    [sym_letcs] = STATE(74),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [25] = {
+    [sym__expression] = STATE(76),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(76),
+    [sym_add] = STATE(76),
+    [sym_sub] = STATE(76),
+    [sym_mult] = STATE(76),
+    [sym_div] = STATE(76),
+    [sym_mod] = STATE(76),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(76),
+    [sym_eq] = STATE(76),
+    [sym_ne] = STATE(76),
+    [sym_lt] = STATE(76),
+    [sym_le] = STATE(76),
+    [sym_gt] = STATE(76),
+    [sym_ge] = STATE(76),
+    [sym_and] = STATE(76),
+    [sym_or] = STATE(76),
+    [sym_not] = STATE(76),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(76),
+    [sym_array_init] = STATE(76),
+    [sym_array_map] = STATE(76),
+    [sym_array_fold] = STATE(76),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(76),
+    [sym_let] = STATE(76),
+    [sym_letrec] = STATE(76),
+    [sym_letcs] = STATE(76),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [26] = {
+    [sym__expression] = STATE(77),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(77),
+    [sym_add] = STATE(77),
+    [sym_sub] = STATE(77),
+    [sym_mult] = STATE(77),
+    [sym_div] = STATE(77),
+    [sym_mod] = STATE(77),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(77),
+    [sym_eq] = STATE(77),
+    [sym_ne] = STATE(77),
+    [sym_lt] = STATE(77),
+    [sym_le] = STATE(77),
+    [sym_gt] = STATE(77),
+    [sym_ge] = STATE(77),
+    [sym_and] = STATE(77),
+    [sym_or] = STATE(77),
+    [sym_not] = STATE(77),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(77),
+    [sym_array_init] = STATE(77),
+    [sym_array_map] = STATE(77),
+    [sym_array_fold] = STATE(77),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(77),
+    [sym_let] = STATE(77),
+    [sym_letrec] = STATE(77),
+    [sym_letcs] = STATE(77),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [27] = {
+    [sym__expression] = STATE(82),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(82),
+    [sym_add] = STATE(82),
+    [sym_sub] = STATE(82),
+    [sym_mult] = STATE(82),
+    [sym_div] = STATE(82),
+    [sym_mod] = STATE(82),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(82),
+    [sym_eq] = STATE(82),
+    [sym_ne] = STATE(82),
+    [sym_lt] = STATE(82),
+    [sym_le] = STATE(82),
+    [sym_gt] = STATE(82),
+    [sym_ge] = STATE(82),
+    [sym_and] = STATE(82),
+    [sym_or] = STATE(82),
+    [sym_not] = STATE(82),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(82),
+    [sym_array_init] = STATE(82),
+    [sym_array_map] = STATE(82),
+    [sym_array_fold] = STATE(82),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(82),
+    [sym_let] = STATE(82),
+    [sym_letrec] = STATE(82),
+    [sym_letcs] = STATE(82),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [28] = {
+    [sym__expression] = STATE(83),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(83),
+    [sym_add] = STATE(83),
+    [sym_sub] = STATE(83),
+    [sym_mult] = STATE(83),
+    [sym_div] = STATE(83),
+    [sym_mod] = STATE(83),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(83),
+    [sym_eq] = STATE(83),
+    [sym_ne] = STATE(83),
+    [sym_lt] = STATE(83),
+    [sym_le] = STATE(83),
+    [sym_gt] = STATE(83),
+    [sym_ge] = STATE(83),
+    [sym_and] = STATE(83),
+    [sym_or] = STATE(83),
+    [sym_not] = STATE(83),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(83),
+    [sym_array_init] = STATE(83),
+    [sym_array_map] = STATE(83),
+    [sym_array_fold] = STATE(83),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(83),
+    [sym_let] = STATE(83),
+    [sym_letrec] = STATE(83),
+    [sym_letcs] = STATE(83),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [29] = {
+    [sym__expression] = STATE(84),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(84),
+    [sym_add] = STATE(84),
+    [sym_sub] = STATE(84),
+    [sym_mult] = STATE(84),
+    [sym_div] = STATE(84),
+    [sym_mod] = STATE(84),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(84),
+    [sym_eq] = STATE(84),
+    [sym_ne] = STATE(84),
+    [sym_lt] = STATE(84),
+    [sym_le] = STATE(84),
+    [sym_gt] = STATE(84),
+    [sym_ge] = STATE(84),
+    [sym_and] = STATE(84),
+    [sym_or] = STATE(84),
+    [sym_not] = STATE(84),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(84),
+    [sym_array_init] = STATE(84),
+    [sym_array_map] = STATE(84),
+    [sym_array_fold] = STATE(84),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(84),
+    [sym_let] = STATE(84),
+    [sym_letrec] = STATE(84),
+    [sym_letcs] = STATE(84),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [30] = {
+    [sym__expression] = STATE(51),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(51),
+    [sym_add] = STATE(51),
+    [sym_sub] = STATE(51),
+    [sym_mult] = STATE(51),
+    [sym_div] = STATE(51),
+    [sym_mod] = STATE(51),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(51),
+    [sym_eq] = STATE(51),
+    [sym_ne] = STATE(51),
+    [sym_lt] = STATE(51),
+    [sym_le] = STATE(51),
+    [sym_gt] = STATE(51),
+    [sym_ge] = STATE(51),
+    [sym_and] = STATE(51),
+    [sym_or] = STATE(51),
+    [sym_not] = STATE(51),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(51),
+    [sym_array_init] = STATE(51),
+    [sym_array_map] = STATE(51),
+    [sym_array_fold] = STATE(51),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(51),
+    [sym_let] = STATE(51),
+    [sym_letrec] = STATE(51),
+    [sym_letcs] = STATE(51),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [31] = {
+    [sym__expression] = STATE(85),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(85),
+    [sym_add] = STATE(85),
+    [sym_sub] = STATE(85),
+    [sym_mult] = STATE(85),
+    [sym_div] = STATE(85),
+    [sym_mod] = STATE(85),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(85),
+    [sym_eq] = STATE(85),
+    [sym_ne] = STATE(85),
+    [sym_lt] = STATE(85),
+    [sym_le] = STATE(85),
+    [sym_gt] = STATE(85),
+    [sym_ge] = STATE(85),
+    [sym_and] = STATE(85),
+    [sym_or] = STATE(85),
+    [sym_not] = STATE(85),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(85),
+    [sym_array_init] = STATE(85),
+    [sym_array_map] = STATE(85),
+    [sym_array_fold] = STATE(85),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(85),
+    [sym_let] = STATE(85),
+    [sym_letrec] = STATE(85),
+    [sym_letcs] = STATE(85),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [32] = {
+    [sym__expression] = STATE(52),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(52),
+    [sym_add] = STATE(52),
+    [sym_sub] = STATE(52),
+    [sym_mult] = STATE(52),
+    [sym_div] = STATE(52),
+    [sym_mod] = STATE(52),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(52),
+    [sym_eq] = STATE(52),
+    [sym_ne] = STATE(52),
+    [sym_lt] = STATE(52),
+    [sym_le] = STATE(52),
+    [sym_gt] = STATE(52),
+    [sym_ge] = STATE(52),
+    [sym_and] = STATE(52),
+    [sym_or] = STATE(52),
+    [sym_not] = STATE(52),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(52),
+    [sym_array_init] = STATE(52),
+    [sym_array_map] = STATE(52),
+    [sym_array_fold] = STATE(52),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(52),
+    [sym_let] = STATE(52),
+    [sym_letrec] = STATE(52),
+    [sym_letcs] = STATE(52),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [33] = {
+    [sym__expression] = STATE(53),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(53),
+    [sym_add] = STATE(53),
     [sym_sub] = STATE(53),
     [sym_mult] = STATE(53),
     [sym_div] = STATE(53),
     [sym_mod] = STATE(53),
-    [sym_boolean] = STATE(51),
+    [sym_boolean] = STATE(61),
     [sym_ctrl_if] = STATE(53),
     [sym_eq] = STATE(53),
     [sym_ne] = STATE(53),
@@ -1435,1896 +3733,1877 @@ static const uint16_t ts_parse_table[LARGE_STATE_COUNT][SYMBOL_COUNT] = {
     [sym_and] = STATE(53),
     [sym_or] = STATE(53),
     [sym_not] = STATE(53),
-    [sym_quote] = STATE(51),
-    [sym_splice] = STATE(51),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(53),
+    [sym_array_init] = STATE(53),
+    [sym_array_map] = STATE(53),
+    [sym_array_fold] = STATE(53),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(53),
     [sym_let] = STATE(53),
     [sym_letrec] = STATE(53),
-    [sym_clsabs] = STATE(51),
-    [sym_clsapp] = STATE(51),
+    [sym_letcs] = STATE(53),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
     [sym_identifier] = ACTIONS(3),
     [anon_sym_LPAREN] = ACTIONS(5),
     [anon_sym_BANG] = ACTIONS(7),
-    [sym_number] = ACTIONS(9),
-    [anon_sym_true] = ACTIONS(11),
-    [anon_sym_false] = ACTIONS(11),
-    [anon_sym_if] = ACTIONS(13),
-    [anon_sym_BQUOTE_LBRACE] = ACTIONS(15),
-    [anon_sym_TILDE] = ACTIONS(17),
-    [anon_sym_let] = ACTIONS(19),
-    [anon_sym_LBRACK] = ACTIONS(21),
-  },
-};
-
-static const uint16_t ts_small_parse_table[] = {
-  [0] = 14,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(23), 1,
-      sym_identifier,
-    STATE(94), 1,
-      sym_param,
-    STATE(113), 1,
-      sym_params,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-      sym_clsapp,
-    STATE(56), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [69] = 13,
-    ACTIONS(3), 1,
-      sym_identifier,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(25), 1,
-      anon_sym_AT,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-      sym_clsapp,
-    STATE(66), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [135] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-      sym_clsapp,
-    STATE(57), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [198] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-      sym_clsapp,
-    STATE(50), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [261] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-      sym_clsapp,
-    STATE(37), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [324] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-      sym_clsapp,
-    STATE(30), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [387] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [34] = {
+    [sym__expression] = STATE(54),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(54),
+    [sym_add] = STATE(54),
+    [sym_sub] = STATE(54),
+    [sym_mult] = STATE(54),
+    [sym_div] = STATE(54),
+    [sym_mod] = STATE(54),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(54),
+    [sym_eq] = STATE(54),
+    [sym_ne] = STATE(54),
+    [sym_lt] = STATE(54),
+    [sym_le] = STATE(54),
+    [sym_gt] = STATE(54),
+    [sym_ge] = STATE(54),
+    [sym_and] = STATE(54),
+    [sym_or] = STATE(54),
+    [sym_not] = STATE(54),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(54),
+    [sym_array_init] = STATE(54),
+    [sym_array_map] = STATE(54),
+    [sym_array_fold] = STATE(54),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(54),
+    [sym_let] = STATE(54),
+    [sym_letrec] = STATE(54),
+    [sym_letcs] = STATE(54),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [35] = {
+    [sym__expression] = STATE(87),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(87),
+    [sym_add] = STATE(87),
+    [sym_sub] = STATE(87),
+    [sym_mult] = STATE(87),
+    [sym_div] = STATE(87),
+    [sym_mod] = STATE(87),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(87),
+    [sym_eq] = STATE(87),
+    [sym_ne] = STATE(87),
+    [sym_lt] = STATE(87),
+    [sym_le] = STATE(87),
+    [sym_gt] = STATE(87),
+    [sym_ge] = STATE(87),
+    [sym_and] = STATE(87),
+    [sym_or] = STATE(87),
+    [sym_not] = STATE(87),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(87),
+    [sym_array_init] = STATE(87),
+    [sym_array_map] = STATE(87),
+    [sym_array_fold] = STATE(87),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(87),
+    [sym_let] = STATE(87),
+    [sym_letrec] = STATE(87),
+    [sym_letcs] = STATE(87),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+  [36] = {
+    [sym__expression] = STATE(55),
+    [sym__expression_with_clsapp] = STATE(95),
+    [sym__simple_expression] = STATE(61),
+    [sym_lambda] = STATE(61),
+    [sym_application] = STATE(55),
+    [sym_add] = STATE(55),
+    [sym_sub] = STATE(55),
+    [sym_mult] = STATE(55),
+    [sym_div] = STATE(55),
+    [sym_mod] = STATE(55),
+    [sym_boolean] = STATE(61),
+    [sym_ctrl_if] = STATE(55),
+    [sym_eq] = STATE(55),
+    [sym_ne] = STATE(55),
+    [sym_lt] = STATE(55),
+    [sym_le] = STATE(55),
+    [sym_gt] = STATE(55),
+    [sym_ge] = STATE(55),
+    [sym_and] = STATE(55),
+    [sym_or] = STATE(55),
+    [sym_not] = STATE(55),
+    [sym_array] = STATE(61),
+    [sym_array_get] = STATE(61),
+    [sym_array_length] = STATE(55),
+    [sym_array_init] = STATE(55),
+    [sym_array_map] = STATE(55),
+    [sym_array_fold] = STATE(55),
+    [sym_tuple] = STATE(61),
+    [sym_tuple_get] = STATE(61),
+    [sym_quote] = STATE(61),
+    [sym_splice] = STATE(61),
+    [sym_genlet] = STATE(55),
+    [sym_let] = STATE(55),
+    [sym_letrec] = STATE(55),
+    [sym_letcs] = STATE(55),
+    [sym_clsabs] = STATE(61),
+    [sym_clsapp] = STATE(95),
+    [sym_identifier] = ACTIONS(3),
+    [anon_sym_LPAREN] = ACTIONS(5),
+    [anon_sym_BANG] = ACTIONS(7),
+    [sym_number] = ACTIONS(9),
+    [anon_sym_true] = ACTIONS(11),
+    [anon_sym_false] = ACTIONS(11),
+    [anon_sym_if] = ACTIONS(13),
+    [anon_sym_LBRACK_PIPE] = ACTIONS(15),
+    [anon_sym_Array_DOTlength] = ACTIONS(17),
+    [anon_sym_Array_DOTinit] = ACTIONS(19),
+    [anon_sym_Array_DOTmap] = ACTIONS(21),
+    [anon_sym_Array_DOTfold] = ACTIONS(23),
+    [anon_sym_BQUOTE_LBRACE] = ACTIONS(25),
+    [anon_sym_TILDE] = ACTIONS(27),
+    [anon_sym_genlet] = ACTIONS(29),
+    [anon_sym_let] = ACTIONS(31),
+    [anon_sym_LBRACK] = ACTIONS(33),
+  },
+};
+
+static const uint16_t ts_small_parse_table[] = {
+  [0] = 11,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-      sym_clsapp,
-    STATE(39), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [450] = 12,
-    ACTIONS(3), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(47), 6,
+      anon_sym_mod,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(40), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [513] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+    ACTIONS(41), 15,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_PLUS,
+      anon_sym_DASH,
+      anon_sym_STAR,
+      anon_sym_SLASH,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+  [63] = 14,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-      sym_clsapp,
-    STATE(41), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [576] = 12,
-    ACTIONS(3), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(57), 5,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(43), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [639] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+    ACTIONS(49), 13,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_PLUS,
+      anon_sym_DASH,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+  [132] = 14,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-      sym_clsapp,
-    STATE(45), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [702] = 12,
-    ACTIONS(3), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(61), 5,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(31), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [765] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+    ACTIONS(59), 13,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_PLUS,
+      anon_sym_DASH,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+  [201] = 11,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-      sym_clsapp,
-    STATE(32), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [828] = 12,
-    ACTIONS(3), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(65), 6,
+      anon_sym_mod,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(33), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [891] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+    ACTIONS(63), 15,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_PLUS,
+      anon_sym_DASH,
+      anon_sym_STAR,
+      anon_sym_SLASH,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+  [264] = 11,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-      sym_clsapp,
-    STATE(34), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [954] = 12,
-    ACTIONS(3), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(69), 6,
+      anon_sym_mod,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(35), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [1017] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+    ACTIONS(67), 15,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_PLUS,
+      anon_sym_DASH,
+      anon_sym_STAR,
+      anon_sym_SLASH,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+  [327] = 11,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(73), 6,
+      anon_sym_mod,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(36), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [1080] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+    ACTIONS(71), 15,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_PLUS,
+      anon_sym_DASH,
+      anon_sym_STAR,
+      anon_sym_SLASH,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+  [390] = 16,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(81), 5,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(62), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [1143] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+    ACTIONS(75), 11,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+  [463] = 16,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(85), 5,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(52), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [1206] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+    ACTIONS(83), 11,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+  [536] = 16,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(89), 5,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(58), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [1269] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+    ACTIONS(87), 11,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+  [609] = 16,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(93), 5,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(60), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [1332] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+    ACTIONS(91), 11,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+  [682] = 16,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(97), 5,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(65), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [1395] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+    ACTIONS(95), 11,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+  [755] = 16,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(101), 5,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(47), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [1458] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+    ACTIONS(99), 11,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+  [828] = 22,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
+    ACTIONS(107), 1,
+      anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
+      anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
+      anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
+      anon_sym_GT_EQ,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(105), 3,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_in,
+    ACTIONS(103), 7,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(42), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [1521] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+  [913] = 23,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
+    ACTIONS(107), 1,
+      anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
+      anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
+      anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
+      anon_sym_GT_EQ,
+    ACTIONS(123), 1,
+      anon_sym_AMP_AMP,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(121), 3,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_in,
+    ACTIONS(119), 6,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_PIPE_PIPE,
+      anon_sym_PIPE_RBRACK,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(44), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [1584] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+  [1000] = 24,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
+    ACTIONS(107), 1,
+      anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
+      anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
+      anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
+      anon_sym_GT_EQ,
+    ACTIONS(123), 1,
+      anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
+      anon_sym_PIPE_PIPE,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(127), 3,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_in,
+    ACTIONS(125), 5,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_PIPE_RBRACK,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(38), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [1647] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+  [1089] = 24,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
+    ACTIONS(107), 1,
+      anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
+      anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
+      anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
+      anon_sym_GT_EQ,
+    ACTIONS(123), 1,
+      anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
+      anon_sym_PIPE_PIPE,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(133), 3,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_in,
+    ACTIONS(131), 5,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_PIPE_RBRACK,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(46), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [1710] = 12,
-    ACTIONS(3), 1,
-      sym_identifier,
+  [1178] = 24,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
-    ACTIONS(7), 1,
-      anon_sym_BANG,
-    ACTIONS(9), 1,
-      sym_number,
-    ACTIONS(13), 1,
-      anon_sym_if,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(19), 1,
-      anon_sym_let,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
+    ACTIONS(107), 1,
+      anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
+      anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
+      anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
+      anon_sym_GT_EQ,
+    ACTIONS(123), 1,
+      anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
+      anon_sym_PIPE_PIPE,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(51), 8,
-      sym__expression_with_clsapp,
+    ACTIONS(137), 3,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_in,
+    ACTIONS(135), 5,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_PIPE_RBRACK,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-      sym_clsapp,
-    STATE(68), 19,
-      sym__expression,
-      sym_application,
-      sym_add,
-      sym_sub,
-      sym_mult,
-      sym_div,
-      sym_mod,
-      sym_ctrl_if,
-      sym_eq,
-      sym_ne,
-      sym_lt,
-      sym_le,
-      sym_gt,
-      sym_ge,
-      sym_and,
-      sym_or,
-      sym_not,
-      sym_let,
-      sym_letrec,
-  [1773] = 13,
+  [1267] = 24,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
+    ACTIONS(107), 1,
+      anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
+      anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
+      anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
+      anon_sym_GT_EQ,
+    ACTIONS(123), 1,
+      anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
+      anon_sym_PIPE_PIPE,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(39), 5,
+    ACTIONS(141), 3,
       anon_sym_then,
       anon_sym_else,
-      anon_sym_LT,
-      anon_sym_GT,
       anon_sym_in,
-    STATE(71), 6,
+    ACTIONS(139), 5,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_PIPE_RBRACK,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-    ACTIONS(27), 11,
-      ts_builtin_sym_end,
-      anon_sym_RPAREN,
-      anon_sym_RBRACE,
-      anon_sym_PLUS,
-      anon_sym_DASH,
-      anon_sym_EQ_EQ,
-      anon_sym_BANG_EQ,
-      anon_sym_LT_EQ,
-      anon_sym_GT_EQ,
-      anon_sym_AMP_AMP,
-      anon_sym_PIPE_PIPE,
-  [1833] = 15,
+  [1356] = 24,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
+    ACTIONS(79), 1,
       anon_sym_DASH,
+    ACTIONS(107), 1,
+      anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
+      anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
+      anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
+      anon_sym_GT_EQ,
+    ACTIONS(123), 1,
+      anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
+      anon_sym_PIPE_PIPE,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(47), 5,
+    ACTIONS(145), 3,
       anon_sym_then,
       anon_sym_else,
-      anon_sym_LT,
-      anon_sym_GT,
       anon_sym_in,
-    STATE(71), 6,
+    ACTIONS(143), 5,
+      ts_builtin_sym_end,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      anon_sym_PIPE_RBRACK,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-    ACTIONS(41), 9,
-      ts_builtin_sym_end,
-      anon_sym_RPAREN,
-      anon_sym_RBRACE,
-      anon_sym_EQ_EQ,
-      anon_sym_BANG_EQ,
-      anon_sym_LT_EQ,
-      anon_sym_GT_EQ,
-      anon_sym_AMP_AMP,
-      anon_sym_PIPE_PIPE,
-  [1897] = 15,
+  [1445] = 25,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
+    ACTIONS(79), 1,
       anon_sym_DASH,
+    ACTIONS(107), 1,
+      anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
+      anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
+      anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
+      anon_sym_GT_EQ,
+    ACTIONS(123), 1,
+      anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
+      anon_sym_PIPE_PIPE,
+    ACTIONS(147), 1,
+      anon_sym_RPAREN,
+    ACTIONS(149), 1,
+      anon_sym_COMMA,
+    STATE(137), 1,
+      aux_sym_array_repeat1,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(51), 5,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_LT,
-      anon_sym_GT,
-      anon_sym_in,
-    STATE(71), 6,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-    ACTIONS(49), 9,
-      ts_builtin_sym_end,
-      anon_sym_RPAREN,
-      anon_sym_RBRACE,
+  [1531] = 25,
+    ACTIONS(5), 1,
+      anon_sym_LPAREN,
+    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
+      anon_sym_BQUOTE_LBRACE,
+    ACTIONS(27), 1,
+      anon_sym_TILDE,
+    ACTIONS(33), 1,
+      anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
+    ACTIONS(107), 1,
       anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
       anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
       anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
       anon_sym_GT_EQ,
+    ACTIONS(123), 1,
       anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
       anon_sym_PIPE_PIPE,
-  [1961] = 15,
+    ACTIONS(149), 1,
+      anon_sym_COMMA,
+    ACTIONS(151), 1,
+      anon_sym_PIPE_RBRACK,
+    STATE(139), 1,
+      aux_sym_array_repeat1,
+    ACTIONS(11), 2,
+      anon_sym_true,
+      anon_sym_false,
+    STATE(91), 10,
+      sym__simple_expression,
+      sym_lambda,
+      sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
+      sym_quote,
+      sym_splice,
+      sym_clsabs,
+  [1617] = 23,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
+    ACTIONS(79), 1,
       anon_sym_DASH,
+    ACTIONS(107), 1,
+      anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
+      anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
+      anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
+      anon_sym_GT_EQ,
+    ACTIONS(123), 1,
+      anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
+      anon_sym_PIPE_PIPE,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(55), 5,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_LT,
-      anon_sym_GT,
-      anon_sym_in,
-    STATE(71), 6,
+    ACTIONS(153), 3,
+      anon_sym_RPAREN,
+      anon_sym_COMMA,
+      anon_sym_PIPE_RBRACK,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-    ACTIONS(53), 9,
+  [1699] = 2,
+    ACTIONS(157), 11,
+      sym_identifier,
+      anon_sym_mod,
+      anon_sym_true,
+      anon_sym_false,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_DOT,
+      anon_sym_in,
+      anon_sym_LBRACK,
+    ACTIONS(155), 22,
       ts_builtin_sym_end,
+      anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
+      anon_sym_PLUS,
+      anon_sym_DASH,
+      anon_sym_STAR,
+      anon_sym_SLASH,
       anon_sym_EQ_EQ,
       anon_sym_BANG_EQ,
       anon_sym_LT_EQ,
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
-  [2025] = 15,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+      anon_sym_CARET,
+  [1737] = 23,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
+    ACTIONS(79), 1,
       anon_sym_DASH,
+    ACTIONS(107), 1,
+      anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
+      anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
+      anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
+      anon_sym_GT_EQ,
+    ACTIONS(123), 1,
+      anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
+      anon_sym_PIPE_PIPE,
+    ACTIONS(159), 1,
+      ts_builtin_sym_end,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(59), 5,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_LT,
-      anon_sym_GT,
-      anon_sym_in,
-    STATE(71), 6,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-    ACTIONS(57), 9,
+  [1817] = 4,
+    ACTIONS(165), 1,
+      anon_sym_DOT_LPAREN,
+    ACTIONS(167), 1,
+      anon_sym_DOT,
+    ACTIONS(163), 10,
+      sym_identifier,
+      anon_sym_mod,
+      anon_sym_true,
+      anon_sym_false,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+      anon_sym_LBRACK,
+    ACTIONS(161), 21,
       ts_builtin_sym_end,
+      anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
+      anon_sym_PLUS,
+      anon_sym_DASH,
+      anon_sym_STAR,
+      anon_sym_SLASH,
       anon_sym_EQ_EQ,
       anon_sym_BANG_EQ,
       anon_sym_LT_EQ,
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
-  [2089] = 21,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+      anon_sym_CARET,
+  [1859] = 23,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
+    ACTIONS(79), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+    ACTIONS(107), 1,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
+    ACTIONS(109), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
+    ACTIONS(111), 1,
       anon_sym_LT,
-    ACTIONS(71), 1,
+    ACTIONS(113), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
+    ACTIONS(115), 1,
       anon_sym_GT,
-    ACTIONS(75), 1,
+    ACTIONS(117), 1,
       anon_sym_GT_EQ,
+    ACTIONS(123), 1,
+      anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
+      anon_sym_PIPE_PIPE,
+    ACTIONS(169), 1,
+      anon_sym_then,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(63), 3,
+    STATE(91), 10,
+      sym__simple_expression,
+      sym_lambda,
+      sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
+      sym_quote,
+      sym_splice,
+      sym_clsabs,
+  [1939] = 2,
+    ACTIONS(173), 11,
+      sym_identifier,
+      anon_sym_mod,
+      anon_sym_true,
+      anon_sym_false,
       anon_sym_then,
       anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_DOT,
       anon_sym_in,
-    ACTIONS(61), 5,
+      anon_sym_LBRACK,
+    ACTIONS(171), 22,
       ts_builtin_sym_end,
+      anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
+      anon_sym_PLUS,
+      anon_sym_DASH,
+      anon_sym_STAR,
+      anon_sym_SLASH,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
-    STATE(71), 6,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-  [2165] = 22,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+      anon_sym_CARET,
+  [1977] = 23,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
+    ACTIONS(79), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+    ACTIONS(107), 1,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
+    ACTIONS(109), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
+    ACTIONS(111), 1,
       anon_sym_LT,
-    ACTIONS(71), 1,
+    ACTIONS(113), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
+    ACTIONS(115), 1,
       anon_sym_GT,
-    ACTIONS(75), 1,
+    ACTIONS(117), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
+    ACTIONS(123), 1,
       anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
+      anon_sym_PIPE_PIPE,
+    ACTIONS(175), 1,
+      anon_sym_RBRACE,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(79), 3,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_in,
-    ACTIONS(77), 4,
-      ts_builtin_sym_end,
-      anon_sym_RPAREN,
-      anon_sym_RBRACE,
-      anon_sym_PIPE_PIPE,
-    STATE(71), 6,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-  [2243] = 13,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(29), 1,
+  [2057] = 2,
+    ACTIONS(179), 11,
       sym_identifier,
-    ACTIONS(31), 1,
+      anon_sym_mod,
+      anon_sym_true,
+      anon_sym_false,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_DOT,
+      anon_sym_in,
+      anon_sym_LBRACK,
+    ACTIONS(177), 22,
+      ts_builtin_sym_end,
+      anon_sym_LPAREN,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
       sym_number,
-    ACTIONS(33), 1,
+      anon_sym_PLUS,
+      anon_sym_DASH,
       anon_sym_STAR,
-    ACTIONS(35), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+      anon_sym_CARET,
+  [2095] = 2,
+    ACTIONS(183), 11,
+      sym_identifier,
       anon_sym_mod,
-    ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(85), 5,
       anon_sym_then,
       anon_sym_else,
       anon_sym_LT,
       anon_sym_GT,
+      anon_sym_DOT,
       anon_sym_in,
-    STATE(71), 6,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-    ACTIONS(83), 11,
+      anon_sym_LBRACK,
+    ACTIONS(181), 22,
       ts_builtin_sym_end,
+      anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
       anon_sym_PLUS,
       anon_sym_DASH,
+      anon_sym_STAR,
+      anon_sym_SLASH,
       anon_sym_EQ_EQ,
       anon_sym_BANG_EQ,
       anon_sym_LT_EQ,
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
-  [2303] = 10,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(29), 1,
+      anon_sym_CARET,
+  [2133] = 2,
+    ACTIONS(187), 11,
       sym_identifier,
-    ACTIONS(31), 1,
-      sym_number,
-    ACTIONS(11), 2,
+      anon_sym_mod,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(89), 6,
-      anon_sym_mod,
       anon_sym_then,
       anon_sym_else,
       anon_sym_LT,
       anon_sym_GT,
+      anon_sym_DOT,
       anon_sym_in,
-    STATE(71), 6,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-    ACTIONS(87), 13,
+      anon_sym_LBRACK,
+    ACTIONS(185), 22,
       ts_builtin_sym_end,
+      anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
       anon_sym_PLUS,
       anon_sym_DASH,
       anon_sym_STAR,
@@ -3335,84 +5614,146 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
-  [2357] = 10,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+      anon_sym_CARET,
+  [2171] = 23,
+    ACTIONS(5), 1,
+      anon_sym_LPAREN,
+    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
+      anon_sym_BQUOTE_LBRACE,
+    ACTIONS(27), 1,
+      anon_sym_TILDE,
+    ACTIONS(33), 1,
+      anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
+    ACTIONS(107), 1,
+      anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
+      anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
+      anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
+      anon_sym_GT_EQ,
+    ACTIONS(123), 1,
+      anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
+      anon_sym_PIPE_PIPE,
+    ACTIONS(189), 1,
+      anon_sym_RBRACE,
+    ACTIONS(11), 2,
+      anon_sym_true,
+      anon_sym_false,
+    STATE(91), 10,
+      sym__simple_expression,
+      sym_lambda,
+      sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
+      sym_quote,
+      sym_splice,
+      sym_clsabs,
+  [2251] = 23,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    ACTIONS(93), 6,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
       anon_sym_mod,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_LT,
-      anon_sym_GT,
-      anon_sym_in,
-    STATE(71), 6,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-    ACTIONS(91), 13,
-      ts_builtin_sym_end,
-      anon_sym_RPAREN,
-      anon_sym_RBRACE,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
+    ACTIONS(79), 1,
       anon_sym_DASH,
-      anon_sym_STAR,
-      anon_sym_SLASH,
+    ACTIONS(107), 1,
       anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
       anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
       anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
       anon_sym_GT_EQ,
+    ACTIONS(123), 1,
       anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
       anon_sym_PIPE_PIPE,
-  [2411] = 10,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(29), 1,
-      sym_identifier,
-    ACTIONS(31), 1,
-      sym_number,
+    ACTIONS(191), 1,
+      anon_sym_RPAREN,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(97), 6,
-      anon_sym_mod,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_LT,
-      anon_sym_GT,
-      anon_sym_in,
-    STATE(71), 6,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-    ACTIONS(95), 13,
+  [2331] = 2,
+    ACTIONS(195), 11,
+      sym_identifier,
+      anon_sym_mod,
+      anon_sym_true,
+      anon_sym_false,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_DOT,
+      anon_sym_in,
+      anon_sym_LBRACK,
+    ACTIONS(193), 22,
       ts_builtin_sym_end,
+      anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
       anon_sym_PLUS,
       anon_sym_DASH,
       anon_sym_STAR,
@@ -3423,40 +5764,32 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
-  [2465] = 10,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(29), 1,
+      anon_sym_CARET,
+  [2369] = 2,
+    ACTIONS(199), 11,
       sym_identifier,
-    ACTIONS(31), 1,
-      sym_number,
-    ACTIONS(11), 2,
+      anon_sym_mod,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(101), 6,
-      anon_sym_mod,
       anon_sym_then,
       anon_sym_else,
       anon_sym_LT,
       anon_sym_GT,
+      anon_sym_DOT,
       anon_sym_in,
-    STATE(71), 6,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-    ACTIONS(99), 13,
+      anon_sym_LBRACK,
+    ACTIONS(197), 22,
       ts_builtin_sym_end,
+      anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
       anon_sym_PLUS,
       anon_sym_DASH,
       anon_sym_STAR,
@@ -3467,328 +5800,388 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
-  [2519] = 23,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+      anon_sym_CARET,
+  [2407] = 23,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
+    ACTIONS(79), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+    ACTIONS(107), 1,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
+    ACTIONS(109), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
+    ACTIONS(111), 1,
       anon_sym_LT,
-    ACTIONS(71), 1,
+    ACTIONS(113), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
+    ACTIONS(115), 1,
       anon_sym_GT,
-    ACTIONS(75), 1,
+    ACTIONS(117), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
+    ACTIONS(123), 1,
       anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
+    ACTIONS(129), 1,
       anon_sym_PIPE_PIPE,
+    ACTIONS(201), 1,
+      anon_sym_else,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(103), 3,
-      ts_builtin_sym_end,
-      anon_sym_RPAREN,
-      anon_sym_RBRACE,
-    ACTIONS(105), 3,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_in,
-    STATE(71), 6,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-  [2599] = 15,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(29), 1,
+  [2487] = 2,
+    ACTIONS(205), 11,
       sym_identifier,
-    ACTIONS(31), 1,
-      sym_number,
-    ACTIONS(33), 1,
-      anon_sym_STAR,
-    ACTIONS(35), 1,
-      anon_sym_SLASH,
-    ACTIONS(37), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
-      anon_sym_PLUS,
-    ACTIONS(45), 1,
-      anon_sym_DASH,
-    ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(111), 5,
       anon_sym_then,
       anon_sym_else,
       anon_sym_LT,
       anon_sym_GT,
+      anon_sym_DOT,
       anon_sym_in,
-    STATE(71), 6,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-    ACTIONS(109), 9,
+      anon_sym_LBRACK,
+    ACTIONS(203), 22,
       ts_builtin_sym_end,
+      anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
+      anon_sym_PLUS,
+      anon_sym_DASH,
+      anon_sym_STAR,
+      anon_sym_SLASH,
       anon_sym_EQ_EQ,
       anon_sym_BANG_EQ,
       anon_sym_LT_EQ,
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
-  [2663] = 23,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+      anon_sym_CARET,
+  [2525] = 23,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
+    ACTIONS(79), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+    ACTIONS(107), 1,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
+    ACTIONS(109), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
+    ACTIONS(111), 1,
       anon_sym_LT,
-    ACTIONS(71), 1,
+    ACTIONS(113), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
+    ACTIONS(115), 1,
       anon_sym_GT,
-    ACTIONS(75), 1,
+    ACTIONS(117), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
+    ACTIONS(123), 1,
       anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
+    ACTIONS(129), 1,
       anon_sym_PIPE_PIPE,
+    ACTIONS(207), 1,
+      anon_sym_RBRACE,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(113), 3,
-      ts_builtin_sym_end,
-      anon_sym_RPAREN,
-      anon_sym_RBRACE,
-    ACTIONS(115), 3,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_in,
-    STATE(71), 6,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-  [2743] = 15,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(29), 1,
+  [2605] = 2,
+    ACTIONS(211), 11,
       sym_identifier,
-    ACTIONS(31), 1,
-      sym_number,
-    ACTIONS(33), 1,
-      anon_sym_STAR,
-    ACTIONS(35), 1,
-      anon_sym_SLASH,
-    ACTIONS(37), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
-      anon_sym_PLUS,
-    ACTIONS(45), 1,
-      anon_sym_DASH,
-    ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(119), 5,
       anon_sym_then,
       anon_sym_else,
       anon_sym_LT,
       anon_sym_GT,
+      anon_sym_DOT,
       anon_sym_in,
-    STATE(71), 6,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-    ACTIONS(117), 9,
+      anon_sym_LBRACK,
+    ACTIONS(209), 22,
       ts_builtin_sym_end,
+      anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
+      anon_sym_PLUS,
+      anon_sym_DASH,
+      anon_sym_STAR,
+      anon_sym_SLASH,
       anon_sym_EQ_EQ,
       anon_sym_BANG_EQ,
       anon_sym_LT_EQ,
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
-  [2807] = 23,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+      anon_sym_CARET,
+  [2643] = 23,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
+    ACTIONS(79), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+    ACTIONS(107), 1,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
+    ACTIONS(109), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
+    ACTIONS(111), 1,
       anon_sym_LT,
-    ACTIONS(71), 1,
+    ACTIONS(113), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
+    ACTIONS(115), 1,
       anon_sym_GT,
-    ACTIONS(75), 1,
+    ACTIONS(117), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
+    ACTIONS(123), 1,
       anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
+    ACTIONS(129), 1,
       anon_sym_PIPE_PIPE,
+    ACTIONS(213), 1,
+      anon_sym_RBRACE,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    ACTIONS(121), 3,
-      ts_builtin_sym_end,
-      anon_sym_RPAREN,
-      anon_sym_RBRACE,
-    ACTIONS(123), 3,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_in,
-    STATE(71), 6,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-  [2887] = 22,
+  [2723] = 23,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
+    ACTIONS(79), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+    ACTIONS(107), 1,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
+    ACTIONS(109), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
+    ACTIONS(111), 1,
       anon_sym_LT,
-    ACTIONS(71), 1,
+    ACTIONS(113), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
+    ACTIONS(115), 1,
       anon_sym_GT,
-    ACTIONS(75), 1,
+    ACTIONS(117), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
+    ACTIONS(123), 1,
       anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
+    ACTIONS(129), 1,
       anon_sym_PIPE_PIPE,
-    ACTIONS(125), 1,
-      anon_sym_RBRACE,
+    ACTIONS(215), 1,
+      anon_sym_in,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(71), 6,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-  [2960] = 2,
-    ACTIONS(129), 9,
+  [2803] = 4,
+    ACTIONS(165), 1,
+      anon_sym_DOT_LPAREN,
+    ACTIONS(167), 1,
+      anon_sym_DOT,
+    ACTIONS(219), 10,
+      sym_identifier,
+      anon_sym_mod,
+      anon_sym_true,
+      anon_sym_false,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+      anon_sym_LBRACK,
+    ACTIONS(217), 21,
+      ts_builtin_sym_end,
+      anon_sym_LPAREN,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
+      anon_sym_PLUS,
+      anon_sym_DASH,
+      anon_sym_STAR,
+      anon_sym_SLASH,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+      anon_sym_CARET,
+  [2845] = 2,
+    ACTIONS(223), 11,
+      sym_identifier,
+      anon_sym_mod,
+      anon_sym_true,
+      anon_sym_false,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_DOT,
+      anon_sym_in,
+      anon_sym_LBRACK,
+    ACTIONS(221), 22,
+      ts_builtin_sym_end,
+      anon_sym_LPAREN,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
+      anon_sym_PLUS,
+      anon_sym_DASH,
+      anon_sym_STAR,
+      anon_sym_SLASH,
+      anon_sym_EQ_EQ,
+      anon_sym_BANG_EQ,
+      anon_sym_LT_EQ,
+      anon_sym_GT_EQ,
+      anon_sym_AMP_AMP,
+      anon_sym_PIPE_PIPE,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+      anon_sym_CARET,
+  [2883] = 2,
+    ACTIONS(227), 11,
       sym_identifier,
       anon_sym_mod,
       anon_sym_true,
@@ -3797,12 +6190,15 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_else,
       anon_sym_LT,
       anon_sym_GT,
+      anon_sym_DOT,
       anon_sym_in,
-    ACTIONS(127), 19,
+      anon_sym_LBRACK,
+    ACTIONS(225), 22,
       ts_builtin_sym_end,
       anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
       sym_number,
       anon_sym_PLUS,
       anon_sym_DASH,
@@ -3814,12 +6210,14 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
       anon_sym_BQUOTE_LBRACE,
       anon_sym_TILDE,
-      anon_sym_LBRACK,
       anon_sym_CARET,
-  [2993] = 2,
-    ACTIONS(133), 9,
+  [2921] = 2,
+    ACTIONS(231), 11,
       sym_identifier,
       anon_sym_mod,
       anon_sym_true,
@@ -3828,12 +6226,15 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_else,
       anon_sym_LT,
       anon_sym_GT,
+      anon_sym_DOT,
       anon_sym_in,
-    ACTIONS(131), 19,
+      anon_sym_LBRACK,
+    ACTIONS(229), 22,
       ts_builtin_sym_end,
       anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
       sym_number,
       anon_sym_PLUS,
       anon_sym_DASH,
@@ -3845,197 +6246,242 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
       anon_sym_BQUOTE_LBRACE,
       anon_sym_TILDE,
-      anon_sym_LBRACK,
       anon_sym_CARET,
-  [3026] = 22,
+  [2959] = 23,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
+    ACTIONS(79), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+    ACTIONS(107), 1,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
+    ACTIONS(109), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
+    ACTIONS(111), 1,
       anon_sym_LT,
-    ACTIONS(71), 1,
+    ACTIONS(113), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
+    ACTIONS(115), 1,
       anon_sym_GT,
-    ACTIONS(75), 1,
+    ACTIONS(117), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
+    ACTIONS(123), 1,
       anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
+    ACTIONS(129), 1,
       anon_sym_PIPE_PIPE,
-    ACTIONS(135), 1,
-      anon_sym_RBRACE,
+    ACTIONS(233), 1,
+      anon_sym_in,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(71), 6,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-  [3099] = 3,
-    ACTIONS(141), 1,
-      anon_sym_CARET,
-    ACTIONS(139), 9,
-      sym_identifier,
-      anon_sym_mod,
-      anon_sym_true,
-      anon_sym_false,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_LT,
-      anon_sym_GT,
-      anon_sym_in,
-    ACTIONS(137), 18,
-      ts_builtin_sym_end,
+  [3039] = 23,
+    ACTIONS(5), 1,
       anon_sym_LPAREN,
-      anon_sym_RPAREN,
-      anon_sym_RBRACE,
+    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
+      anon_sym_BQUOTE_LBRACE,
+    ACTIONS(27), 1,
+      anon_sym_TILDE,
+    ACTIONS(33), 1,
+      anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
       sym_number,
-      anon_sym_PLUS,
-      anon_sym_DASH,
+    ACTIONS(51), 1,
       anon_sym_STAR,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
+    ACTIONS(107), 1,
       anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
       anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
       anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
       anon_sym_GT_EQ,
+    ACTIONS(123), 1,
       anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
       anon_sym_PIPE_PIPE,
-      anon_sym_BQUOTE_LBRACE,
-      anon_sym_TILDE,
-      anon_sym_LBRACK,
-  [3134] = 22,
+    ACTIONS(235), 1,
+      anon_sym_in,
+    ACTIONS(11), 2,
+      anon_sym_true,
+      anon_sym_false,
+    STATE(91), 10,
+      sym__simple_expression,
+      sym_lambda,
+      sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
+      sym_quote,
+      sym_splice,
+      sym_clsabs,
+  [3119] = 23,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
+    ACTIONS(79), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+    ACTIONS(107), 1,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
+    ACTIONS(109), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
+    ACTIONS(111), 1,
       anon_sym_LT,
-    ACTIONS(71), 1,
+    ACTIONS(113), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
+    ACTIONS(115), 1,
       anon_sym_GT,
-    ACTIONS(75), 1,
+    ACTIONS(117), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
+    ACTIONS(123), 1,
       anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
+    ACTIONS(129), 1,
       anon_sym_PIPE_PIPE,
-    ACTIONS(143), 1,
+    ACTIONS(237), 1,
       anon_sym_RBRACE,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(71), 6,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-  [3207] = 22,
+  [3199] = 23,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(43), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(45), 1,
       sym_number,
-    ACTIONS(33), 1,
+    ACTIONS(51), 1,
       anon_sym_STAR,
-    ACTIONS(35), 1,
+    ACTIONS(53), 1,
       anon_sym_SLASH,
-    ACTIONS(37), 1,
+    ACTIONS(55), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+    ACTIONS(77), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
+    ACTIONS(79), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+    ACTIONS(107), 1,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
+    ACTIONS(109), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
+    ACTIONS(111), 1,
       anon_sym_LT,
-    ACTIONS(71), 1,
+    ACTIONS(113), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
+    ACTIONS(115), 1,
       anon_sym_GT,
-    ACTIONS(75), 1,
+    ACTIONS(117), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
+    ACTIONS(123), 1,
       anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
+    ACTIONS(129), 1,
       anon_sym_PIPE_PIPE,
-    ACTIONS(145), 1,
-      ts_builtin_sym_end,
+    ACTIONS(239), 1,
+      anon_sym_in,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(71), 6,
+    STATE(91), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-  [3280] = 2,
-    ACTIONS(149), 9,
+  [3279] = 2,
+    ACTIONS(243), 11,
       sym_identifier,
       anon_sym_mod,
       anon_sym_true,
@@ -4044,12 +6490,15 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_else,
       anon_sym_LT,
       anon_sym_GT,
+      anon_sym_DOT,
       anon_sym_in,
-    ACTIONS(147), 19,
+      anon_sym_LBRACK,
+    ACTIONS(241), 22,
       ts_builtin_sym_end,
       anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
       sym_number,
       anon_sym_PLUS,
       anon_sym_DASH,
@@ -4061,12 +6510,71 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
       anon_sym_BQUOTE_LBRACE,
       anon_sym_TILDE,
-      anon_sym_LBRACK,
       anon_sym_CARET,
-  [3313] = 2,
-    ACTIONS(153), 9,
+  [3317] = 23,
+    ACTIONS(5), 1,
+      anon_sym_LPAREN,
+    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
+      anon_sym_BQUOTE_LBRACE,
+    ACTIONS(27), 1,
+      anon_sym_TILDE,
+    ACTIONS(33), 1,
+      anon_sym_LBRACK,
+    ACTIONS(43), 1,
+      sym_identifier,
+    ACTIONS(45), 1,
+      sym_number,
+    ACTIONS(51), 1,
+      anon_sym_STAR,
+    ACTIONS(53), 1,
+      anon_sym_SLASH,
+    ACTIONS(55), 1,
+      anon_sym_mod,
+    ACTIONS(77), 1,
+      anon_sym_PLUS,
+    ACTIONS(79), 1,
+      anon_sym_DASH,
+    ACTIONS(107), 1,
+      anon_sym_EQ_EQ,
+    ACTIONS(109), 1,
+      anon_sym_BANG_EQ,
+    ACTIONS(111), 1,
+      anon_sym_LT,
+    ACTIONS(113), 1,
+      anon_sym_LT_EQ,
+    ACTIONS(115), 1,
+      anon_sym_GT,
+    ACTIONS(117), 1,
+      anon_sym_GT_EQ,
+    ACTIONS(123), 1,
+      anon_sym_AMP_AMP,
+    ACTIONS(129), 1,
+      anon_sym_PIPE_PIPE,
+    ACTIONS(245), 1,
+      anon_sym_RBRACE,
+    ACTIONS(11), 2,
+      anon_sym_true,
+      anon_sym_false,
+    STATE(91), 10,
+      sym__simple_expression,
+      sym_lambda,
+      sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
+      sym_quote,
+      sym_splice,
+      sym_clsabs,
+  [3397] = 2,
+    ACTIONS(249), 11,
       sym_identifier,
       anon_sym_mod,
       anon_sym_true,
@@ -4075,12 +6583,15 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_else,
       anon_sym_LT,
       anon_sym_GT,
+      anon_sym_DOT,
       anon_sym_in,
-    ACTIONS(151), 19,
+      anon_sym_LBRACK,
+    ACTIONS(247), 22,
       ts_builtin_sym_end,
       anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
       sym_number,
       anon_sym_PLUS,
       anon_sym_DASH,
@@ -4092,165 +6603,129 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_DOT_LPAREN,
       anon_sym_BQUOTE_LBRACE,
       anon_sym_TILDE,
-      anon_sym_LBRACK,
       anon_sym_CARET,
-  [3346] = 22,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(29), 1,
+  [3435] = 4,
+    ACTIONS(165), 1,
+      anon_sym_DOT_LPAREN,
+    ACTIONS(167), 1,
+      anon_sym_DOT,
+    ACTIONS(253), 10,
       sym_identifier,
-    ACTIONS(31), 1,
-      sym_number,
-    ACTIONS(33), 1,
-      anon_sym_STAR,
-    ACTIONS(35), 1,
-      anon_sym_SLASH,
-    ACTIONS(37), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+      anon_sym_true,
+      anon_sym_false,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+      anon_sym_LBRACK,
+    ACTIONS(251), 20,
+      ts_builtin_sym_end,
+      anon_sym_LPAREN,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+      anon_sym_STAR,
+      anon_sym_SLASH,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
-      anon_sym_LT,
-    ACTIONS(71), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
-      anon_sym_GT,
-    ACTIONS(75), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
       anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
       anon_sym_PIPE_PIPE,
-    ACTIONS(155), 1,
-      anon_sym_RPAREN,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(71), 6,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-  [3419] = 22,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(29), 1,
+  [3476] = 4,
+    ACTIONS(165), 1,
+      anon_sym_DOT_LPAREN,
+    ACTIONS(167), 1,
+      anon_sym_DOT,
+    ACTIONS(257), 10,
       sym_identifier,
-    ACTIONS(31), 1,
-      sym_number,
-    ACTIONS(33), 1,
-      anon_sym_STAR,
-    ACTIONS(35), 1,
-      anon_sym_SLASH,
-    ACTIONS(37), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+      anon_sym_true,
+      anon_sym_false,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+      anon_sym_LBRACK,
+    ACTIONS(255), 20,
+      ts_builtin_sym_end,
+      anon_sym_LPAREN,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+      anon_sym_STAR,
+      anon_sym_SLASH,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
-      anon_sym_LT,
-    ACTIONS(71), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
-      anon_sym_GT,
-    ACTIONS(75), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
       anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
       anon_sym_PIPE_PIPE,
-    ACTIONS(157), 1,
-      anon_sym_else,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(71), 6,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-  [3492] = 22,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(29), 1,
+  [3517] = 4,
+    ACTIONS(165), 1,
+      anon_sym_DOT_LPAREN,
+    ACTIONS(167), 1,
+      anon_sym_DOT,
+    ACTIONS(261), 10,
       sym_identifier,
-    ACTIONS(31), 1,
-      sym_number,
-    ACTIONS(33), 1,
-      anon_sym_STAR,
-    ACTIONS(35), 1,
-      anon_sym_SLASH,
-    ACTIONS(37), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+      anon_sym_true,
+      anon_sym_false,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+      anon_sym_LBRACK,
+    ACTIONS(259), 20,
+      ts_builtin_sym_end,
+      anon_sym_LPAREN,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+      anon_sym_STAR,
+      anon_sym_SLASH,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
-      anon_sym_LT,
-    ACTIONS(71), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
-      anon_sym_GT,
-    ACTIONS(75), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
       anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
       anon_sym_PIPE_PIPE,
-    ACTIONS(159), 1,
-      anon_sym_RBRACE,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(71), 6,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-  [3565] = 2,
-    ACTIONS(163), 9,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+  [3558] = 4,
+    ACTIONS(165), 1,
+      anon_sym_DOT_LPAREN,
+    ACTIONS(167), 1,
+      anon_sym_DOT,
+    ACTIONS(265), 10,
       sym_identifier,
       anon_sym_mod,
       anon_sym_true,
@@ -4260,11 +6735,13 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_LT,
       anon_sym_GT,
       anon_sym_in,
-    ACTIONS(161), 19,
+      anon_sym_LBRACK,
+    ACTIONS(263), 20,
       ts_builtin_sym_end,
       anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
       sym_number,
       anon_sym_PLUS,
       anon_sym_DASH,
@@ -4276,63 +6753,53 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
       anon_sym_BQUOTE_LBRACE,
       anon_sym_TILDE,
+  [3599] = 4,
+    ACTIONS(165), 1,
+      anon_sym_DOT_LPAREN,
+    ACTIONS(167), 1,
+      anon_sym_DOT,
+    ACTIONS(269), 10,
+      sym_identifier,
+      anon_sym_mod,
+      anon_sym_true,
+      anon_sym_false,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
       anon_sym_LBRACK,
-      anon_sym_CARET,
-  [3598] = 22,
-    ACTIONS(5), 1,
+    ACTIONS(267), 20,
+      ts_builtin_sym_end,
       anon_sym_LPAREN,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(29), 1,
-      sym_identifier,
-    ACTIONS(31), 1,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
       sym_number,
-    ACTIONS(33), 1,
-      anon_sym_STAR,
-    ACTIONS(35), 1,
-      anon_sym_SLASH,
-    ACTIONS(37), 1,
-      anon_sym_mod,
-    ACTIONS(43), 1,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+      anon_sym_STAR,
+      anon_sym_SLASH,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
-      anon_sym_LT,
-    ACTIONS(71), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
-      anon_sym_GT,
-    ACTIONS(75), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
       anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
       anon_sym_PIPE_PIPE,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+  [3640] = 4,
     ACTIONS(165), 1,
-      anon_sym_in,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(71), 6,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-  [3671] = 2,
-    ACTIONS(169), 9,
+      anon_sym_DOT_LPAREN,
+    ACTIONS(167), 1,
+      anon_sym_DOT,
+    ACTIONS(273), 10,
       sym_identifier,
       anon_sym_mod,
       anon_sym_true,
@@ -4342,11 +6809,13 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_LT,
       anon_sym_GT,
       anon_sym_in,
-    ACTIONS(167), 19,
+      anon_sym_LBRACK,
+    ACTIONS(271), 20,
       ts_builtin_sym_end,
       anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
       sym_number,
       anon_sym_PLUS,
       anon_sym_DASH,
@@ -4358,63 +6827,47 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
       anon_sym_BQUOTE_LBRACE,
       anon_sym_TILDE,
-      anon_sym_LBRACK,
+  [3681] = 3,
+    ACTIONS(279), 1,
       anon_sym_CARET,
-  [3704] = 22,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(277), 10,
       sym_identifier,
-    ACTIONS(31), 1,
-      sym_number,
-    ACTIONS(33), 1,
-      anon_sym_STAR,
-    ACTIONS(35), 1,
-      anon_sym_SLASH,
-    ACTIONS(37), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+      anon_sym_true,
+      anon_sym_false,
+      anon_sym_then,
+      anon_sym_else,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_in,
+      anon_sym_LBRACK,
+    ACTIONS(275), 20,
+      ts_builtin_sym_end,
+      anon_sym_LPAREN,
+      anon_sym_RPAREN,
+      anon_sym_RBRACE,
+      anon_sym_COMMA,
+      sym_number,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+      anon_sym_STAR,
+      anon_sym_SLASH,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
-      anon_sym_LT,
-    ACTIONS(71), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
-      anon_sym_GT,
-    ACTIONS(75), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
       anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
       anon_sym_PIPE_PIPE,
-    ACTIONS(171), 1,
-      anon_sym_then,
-    ACTIONS(11), 2,
-      anon_sym_true,
-      anon_sym_false,
-    STATE(71), 6,
-      sym__simple_expression,
-      sym_lambda,
-      sym_boolean,
-      sym_quote,
-      sym_splice,
-      sym_clsabs,
-  [3777] = 2,
-    ACTIONS(175), 9,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+  [3719] = 2,
+    ACTIONS(283), 10,
       sym_identifier,
       anon_sym_mod,
       anon_sym_true,
@@ -4424,11 +6877,13 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_LT,
       anon_sym_GT,
       anon_sym_in,
-    ACTIONS(173), 19,
+      anon_sym_LBRACK,
+    ACTIONS(281), 21,
       ts_builtin_sym_end,
       anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
       sym_number,
       anon_sym_PLUS,
       anon_sym_DASH,
@@ -4440,12 +6895,13 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
       anon_sym_BQUOTE_LBRACE,
       anon_sym_TILDE,
-      anon_sym_LBRACK,
       anon_sym_CARET,
-  [3810] = 2,
-    ACTIONS(179), 9,
+  [3755] = 2,
+    ACTIONS(287), 10,
       sym_identifier,
       anon_sym_mod,
       anon_sym_true,
@@ -4455,11 +6911,13 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_LT,
       anon_sym_GT,
       anon_sym_in,
-    ACTIONS(177), 19,
+      anon_sym_LBRACK,
+    ACTIONS(285), 21,
       ts_builtin_sym_end,
       anon_sym_LPAREN,
       anon_sym_RPAREN,
       anon_sym_RBRACE,
+      anon_sym_COMMA,
       sym_number,
       anon_sym_PLUS,
       anon_sym_DASH,
@@ -4471,966 +6929,1227 @@ static const uint16_t ts_small_parse_table[] = {
       anon_sym_GT_EQ,
       anon_sym_AMP_AMP,
       anon_sym_PIPE_PIPE,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_PIPE_RBRACK,
       anon_sym_BQUOTE_LBRACE,
       anon_sym_TILDE,
-      anon_sym_LBRACK,
       anon_sym_CARET,
-  [3843] = 22,
-    ACTIONS(5), 1,
-      anon_sym_LPAREN,
-    ACTIONS(15), 1,
-      anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
-      anon_sym_TILDE,
-    ACTIONS(21), 1,
-      anon_sym_LBRACK,
-    ACTIONS(29), 1,
+  [3791] = 5,
+    ACTIONS(296), 1,
+      anon_sym_COLON,
+    ACTIONS(298), 1,
+      anon_sym_AT,
+    ACTIONS(293), 2,
+      anon_sym_RPAREN,
+      anon_sym_COMMA,
+    ACTIONS(289), 8,
       sym_identifier,
-    ACTIONS(31), 1,
-      sym_number,
-    ACTIONS(33), 1,
-      anon_sym_STAR,
-    ACTIONS(35), 1,
-      anon_sym_SLASH,
-    ACTIONS(37), 1,
       anon_sym_mod,
-    ACTIONS(43), 1,
+      anon_sym_true,
+      anon_sym_false,
+      anon_sym_LT,
+      anon_sym_GT,
+      anon_sym_DOT,
+      anon_sym_LBRACK,
+    ACTIONS(291), 17,
+      anon_sym_LPAREN,
+      sym_number,
       anon_sym_PLUS,
-    ACTIONS(45), 1,
       anon_sym_DASH,
-    ACTIONS(65), 1,
+      anon_sym_STAR,
+      anon_sym_SLASH,
       anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
       anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
-      anon_sym_LT,
-    ACTIONS(71), 1,
       anon_sym_LT_EQ,
-    ACTIONS(73), 1,
-      anon_sym_GT,
-    ACTIONS(75), 1,
       anon_sym_GT_EQ,
-    ACTIONS(81), 1,
       anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
       anon_sym_PIPE_PIPE,
-    ACTIONS(181), 1,
-      anon_sym_in,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_DOT_LPAREN,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+      anon_sym_CARET,
+  [3831] = 2,
+    ACTIONS(287), 7,
+      sym_identifier,
+      anon_sym_true,
+      anon_sym_false,
+      anon_sym_if,
+      anon_sym_genlet,
+      anon_sym_let,
+      anon_sym_LBRACK,
+    ACTIONS(285), 16,
+      anon_sym_LPAREN,
+      anon_sym_RPAREN,
+      anon_sym_COMMA,
+      anon_sym_COLON_GT,
+      anon_sym_BANG,
+      sym_number,
+      anon_sym_GT,
+      anon_sym_LBRACK_PIPE,
+      anon_sym_Array_DOTlength,
+      anon_sym_Array_DOTinit,
+      anon_sym_Array_DOTmap,
+      anon_sym_Array_DOTfold,
+      anon_sym_BQUOTE_LBRACE,
+      anon_sym_TILDE,
+      anon_sym_EQ,
+      anon_sym_RBRACK,
+  [3859] = 11,
+    ACTIONS(5), 1,
+      anon_sym_LPAREN,
+    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
+      anon_sym_BQUOTE_LBRACE,
+    ACTIONS(27), 1,
+      anon_sym_TILDE,
+    ACTIONS(33), 1,
+      anon_sym_LBRACK,
+    ACTIONS(165), 1,
+      anon_sym_DOT_LPAREN,
+    ACTIONS(167), 1,
+      anon_sym_DOT,
+    ACTIONS(300), 1,
+      sym_identifier,
+    ACTIONS(302), 1,
+      sym_number,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(71), 6,
+    STATE(92), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-  [3916] = 22,
+  [3903] = 11,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(165), 1,
+      anon_sym_DOT_LPAREN,
+    ACTIONS(167), 1,
+      anon_sym_DOT,
+    ACTIONS(304), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(306), 1,
       sym_number,
-    ACTIONS(33), 1,
-      anon_sym_STAR,
-    ACTIONS(35), 1,
-      anon_sym_SLASH,
-    ACTIONS(37), 1,
-      anon_sym_mod,
-    ACTIONS(43), 1,
-      anon_sym_PLUS,
-    ACTIONS(45), 1,
-      anon_sym_DASH,
-    ACTIONS(65), 1,
-      anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
-      anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
-      anon_sym_LT,
-    ACTIONS(71), 1,
-      anon_sym_LT_EQ,
-    ACTIONS(73), 1,
-      anon_sym_GT,
-    ACTIONS(75), 1,
-      anon_sym_GT_EQ,
-    ACTIONS(81), 1,
-      anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
-      anon_sym_PIPE_PIPE,
-    ACTIONS(183), 1,
-      anon_sym_RBRACE,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(71), 6,
+    STATE(93), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-  [3989] = 2,
-    ACTIONS(187), 9,
-      sym_identifier,
-      anon_sym_mod,
-      anon_sym_true,
-      anon_sym_false,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_LT,
-      anon_sym_GT,
-      anon_sym_in,
-    ACTIONS(185), 19,
-      ts_builtin_sym_end,
+  [3947] = 11,
+    ACTIONS(5), 1,
       anon_sym_LPAREN,
-      anon_sym_RPAREN,
-      anon_sym_RBRACE,
-      sym_number,
-      anon_sym_PLUS,
-      anon_sym_DASH,
-      anon_sym_STAR,
-      anon_sym_SLASH,
-      anon_sym_EQ_EQ,
-      anon_sym_BANG_EQ,
-      anon_sym_LT_EQ,
-      anon_sym_GT_EQ,
-      anon_sym_AMP_AMP,
-      anon_sym_PIPE_PIPE,
+    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-      anon_sym_CARET,
-  [4022] = 22,
+    ACTIONS(165), 1,
+      anon_sym_DOT_LPAREN,
+    ACTIONS(167), 1,
+      anon_sym_DOT,
+    ACTIONS(308), 1,
+      sym_identifier,
+    ACTIONS(310), 1,
+      sym_number,
+    ACTIONS(11), 2,
+      anon_sym_true,
+      anon_sym_false,
+    STATE(103), 10,
+      sym__simple_expression,
+      sym_lambda,
+      sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
+      sym_quote,
+      sym_splice,
+      sym_clsabs,
+  [3991] = 11,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(29), 1,
+    ACTIONS(165), 1,
+      anon_sym_DOT_LPAREN,
+    ACTIONS(167), 1,
+      anon_sym_DOT,
+    ACTIONS(312), 1,
       sym_identifier,
-    ACTIONS(31), 1,
+    ACTIONS(314), 1,
       sym_number,
+    ACTIONS(11), 2,
+      anon_sym_true,
+      anon_sym_false,
+    STATE(94), 10,
+      sym__simple_expression,
+      sym_lambda,
+      sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
+      sym_quote,
+      sym_splice,
+      sym_clsabs,
+  [4035] = 9,
+    ACTIONS(5), 1,
+      anon_sym_LPAREN,
+    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
+      anon_sym_BQUOTE_LBRACE,
+    ACTIONS(27), 1,
+      anon_sym_TILDE,
     ACTIONS(33), 1,
-      anon_sym_STAR,
-    ACTIONS(35), 1,
-      anon_sym_SLASH,
-    ACTIONS(37), 1,
-      anon_sym_mod,
-    ACTIONS(43), 1,
-      anon_sym_PLUS,
-    ACTIONS(45), 1,
-      anon_sym_DASH,
-    ACTIONS(65), 1,
-      anon_sym_EQ_EQ,
-    ACTIONS(67), 1,
-      anon_sym_BANG_EQ,
-    ACTIONS(69), 1,
-      anon_sym_LT,
-    ACTIONS(71), 1,
-      anon_sym_LT_EQ,
-    ACTIONS(73), 1,
-      anon_sym_GT,
-    ACTIONS(75), 1,
-      anon_sym_GT_EQ,
-    ACTIONS(81), 1,
-      anon_sym_AMP_AMP,
-    ACTIONS(107), 1,
-      anon_sym_PIPE_PIPE,
-    ACTIONS(189), 1,
-      anon_sym_RBRACE,
+      anon_sym_LBRACK,
+    ACTIONS(316), 1,
+      sym_identifier,
+    ACTIONS(318), 1,
+      sym_number,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(71), 6,
+    STATE(89), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-  [4095] = 2,
-    ACTIONS(193), 9,
-      sym_identifier,
-      anon_sym_mod,
-      anon_sym_true,
-      anon_sym_false,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_LT,
-      anon_sym_GT,
-      anon_sym_in,
-    ACTIONS(191), 19,
-      ts_builtin_sym_end,
+  [4073] = 9,
+    ACTIONS(5), 1,
       anon_sym_LPAREN,
-      anon_sym_RPAREN,
-      anon_sym_RBRACE,
-      sym_number,
-      anon_sym_PLUS,
-      anon_sym_DASH,
-      anon_sym_STAR,
-      anon_sym_SLASH,
-      anon_sym_EQ_EQ,
-      anon_sym_BANG_EQ,
-      anon_sym_LT_EQ,
-      anon_sym_GT_EQ,
-      anon_sym_AMP_AMP,
-      anon_sym_PIPE_PIPE,
+    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-      anon_sym_CARET,
-  [4128] = 2,
-    ACTIONS(197), 9,
+    ACTIONS(320), 1,
       sym_identifier,
-      anon_sym_mod,
+    ACTIONS(322), 1,
+      sym_number,
+    ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_LT,
-      anon_sym_GT,
-      anon_sym_in,
-    ACTIONS(195), 19,
-      ts_builtin_sym_end,
+    STATE(100), 10,
+      sym__simple_expression,
+      sym_lambda,
+      sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
+      sym_quote,
+      sym_splice,
+      sym_clsabs,
+  [4111] = 9,
+    ACTIONS(5), 1,
       anon_sym_LPAREN,
-      anon_sym_RPAREN,
-      anon_sym_RBRACE,
-      sym_number,
-      anon_sym_PLUS,
-      anon_sym_DASH,
-      anon_sym_STAR,
-      anon_sym_SLASH,
-      anon_sym_EQ_EQ,
-      anon_sym_BANG_EQ,
-      anon_sym_LT_EQ,
-      anon_sym_GT_EQ,
-      anon_sym_AMP_AMP,
-      anon_sym_PIPE_PIPE,
+    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-      anon_sym_CARET,
-  [4161] = 2,
-    ACTIONS(201), 9,
+    ACTIONS(324), 1,
       sym_identifier,
-      anon_sym_mod,
+    ACTIONS(326), 1,
+      sym_number,
+    ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-      anon_sym_then,
-      anon_sym_else,
-      anon_sym_LT,
-      anon_sym_GT,
-      anon_sym_in,
-    ACTIONS(199), 18,
-      ts_builtin_sym_end,
+    STATE(101), 10,
+      sym__simple_expression,
+      sym_lambda,
+      sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
+      sym_quote,
+      sym_splice,
+      sym_clsabs,
+  [4149] = 9,
+    ACTIONS(5), 1,
       anon_sym_LPAREN,
-      anon_sym_RPAREN,
-      anon_sym_RBRACE,
-      sym_number,
-      anon_sym_PLUS,
-      anon_sym_DASH,
-      anon_sym_STAR,
-      anon_sym_SLASH,
-      anon_sym_EQ_EQ,
-      anon_sym_BANG_EQ,
-      anon_sym_LT_EQ,
-      anon_sym_GT_EQ,
-      anon_sym_AMP_AMP,
-      anon_sym_PIPE_PIPE,
+    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-  [4193] = 6,
-    ACTIONS(207), 1,
-      anon_sym_RPAREN,
-    ACTIONS(210), 1,
-      anon_sym_COLON,
-    ACTIONS(212), 1,
-      anon_sym_AT,
-    ACTIONS(214), 1,
-      anon_sym_COMMA,
-    ACTIONS(203), 6,
+    ACTIONS(328), 1,
       sym_identifier,
-      anon_sym_mod,
+    ACTIONS(330), 1,
+      sym_number,
+    ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-      anon_sym_LT,
-      anon_sym_GT,
-    ACTIONS(205), 16,
+    STATE(102), 10,
+      sym__simple_expression,
+      sym_lambda,
+      sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
+      sym_quote,
+      sym_splice,
+      sym_clsabs,
+  [4187] = 9,
+    ACTIONS(5), 1,
       anon_sym_LPAREN,
-      sym_number,
-      anon_sym_PLUS,
-      anon_sym_DASH,
-      anon_sym_STAR,
-      anon_sym_SLASH,
-      anon_sym_EQ_EQ,
-      anon_sym_BANG_EQ,
-      anon_sym_LT_EQ,
-      anon_sym_GT_EQ,
-      anon_sym_AMP_AMP,
-      anon_sym_PIPE_PIPE,
+    ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-      anon_sym_CARET,
-  [4232] = 2,
-    ACTIONS(129), 5,
+    ACTIONS(332), 1,
       sym_identifier,
+    ACTIONS(334), 1,
+      sym_number,
+    ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-      anon_sym_if,
-      anon_sym_let,
-    ACTIONS(127), 12,
-      anon_sym_LPAREN,
-      anon_sym_RPAREN,
-      anon_sym_COMMA,
-      anon_sym_COLON_GT,
-      anon_sym_BANG,
-      sym_number,
-      anon_sym_GT,
-      anon_sym_BQUOTE_LBRACE,
-      anon_sym_TILDE,
-      anon_sym_EQ,
-      anon_sym_LBRACK,
-      anon_sym_RBRACK,
-  [4254] = 8,
+    STATE(90), 10,
+      sym__simple_expression,
+      sym_lambda,
+      sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
+      sym_quote,
+      sym_splice,
+      sym_clsabs,
+  [4225] = 9,
     ACTIONS(5), 1,
       anon_sym_LPAREN,
     ACTIONS(15), 1,
+      anon_sym_LBRACK_PIPE,
+    ACTIONS(25), 1,
       anon_sym_BQUOTE_LBRACE,
-    ACTIONS(17), 1,
+    ACTIONS(27), 1,
       anon_sym_TILDE,
-    ACTIONS(21), 1,
+    ACTIONS(33), 1,
       anon_sym_LBRACK,
-    ACTIONS(216), 1,
+    ACTIONS(336), 1,
       sym_identifier,
-    ACTIONS(218), 1,
+    ACTIONS(338), 1,
       sym_number,
     ACTIONS(11), 2,
       anon_sym_true,
       anon_sym_false,
-    STATE(61), 6,
+    STATE(78), 10,
       sym__simple_expression,
       sym_lambda,
       sym_boolean,
+      sym_array,
+      sym_array_get,
+      sym_tuple,
+      sym_tuple_get,
       sym_quote,
       sym_splice,
       sym_clsabs,
-  [4285] = 6,
-    ACTIONS(220), 1,
+  [4263] = 7,
+    ACTIONS(340), 1,
       anon_sym_LPAREN,
-    ACTIONS(222), 1,
+    ACTIONS(342), 1,
       anon_sym_LT,
-    ACTIONS(224), 1,
+    ACTIONS(344), 1,
       anon_sym_LBRACK,
-    ACTIONS(226), 2,
+    ACTIONS(348), 1,
+      anon_sym_array,
+    ACTIONS(346), 2,
       sym_int_type,
       sym_bool_type,
-    STATE(88), 2,
+    STATE(130), 3,
       sym__type,
       sym_func_type,
-    STATE(81), 3,
+      sym_tuple_type,
+    STATE(117), 4,
       sym__simple_type,
+      sym_array_type,
       sym_code_type,
       sym_clsabs_type,
-  [4308] = 6,
-    ACTIONS(220), 1,
+  [4291] = 7,
+    ACTIONS(340), 1,
       anon_sym_LPAREN,
-    ACTIONS(222), 1,
+    ACTIONS(342), 1,
       anon_sym_LT,
-    ACTIONS(224), 1,
+    ACTIONS(344), 1,
       anon_sym_LBRACK,
-    ACTIONS(226), 2,
+    ACTIONS(348), 1,
+      anon_sym_array,
+    ACTIONS(346), 2,
       sym_int_type,
       sym_bool_type,
-    STATE(118), 2,
+    STATE(165), 3,
       sym__type,
       sym_func_type,
-    STATE(81), 3,
+      sym_tuple_type,
+    STATE(117), 4,
       sym__simple_type,
+      sym_array_type,
       sym_code_type,
       sym_clsabs_type,
-  [4331] = 6,
-    ACTIONS(220), 1,
+  [4319] = 7,
+    ACTIONS(340), 1,
       anon_sym_LPAREN,
-    ACTIONS(222), 1,
+    ACTIONS(342), 1,
       anon_sym_LT,
-    ACTIONS(224), 1,
+    ACTIONS(344), 1,
       anon_sym_LBRACK,
-    ACTIONS(226), 2,
+    ACTIONS(348), 1,
+      anon_sym_array,
+    ACTIONS(346), 2,
       sym_int_type,
       sym_bool_type,
-    STATE(86), 2,
+    STATE(166), 3,
       sym__type,
       sym_func_type,
-    STATE(81), 3,
+      sym_tuple_type,
+    STATE(117), 4,
       sym__simple_type,
+      sym_array_type,
       sym_code_type,
       sym_clsabs_type,
-  [4354] = 6,
-    ACTIONS(220), 1,
+  [4347] = 7,
+    ACTIONS(340), 1,
       anon_sym_LPAREN,
-    ACTIONS(222), 1,
+    ACTIONS(342), 1,
       anon_sym_LT,
-    ACTIONS(224), 1,
+    ACTIONS(344), 1,
       anon_sym_LBRACK,
-    ACTIONS(226), 2,
+    ACTIONS(348), 1,
+      anon_sym_array,
+    ACTIONS(346), 2,
       sym_int_type,
       sym_bool_type,
-    STATE(111), 2,
+    STATE(169), 3,
       sym__type,
       sym_func_type,
-    STATE(81), 3,
+      sym_tuple_type,
+    STATE(117), 4,
       sym__simple_type,
+      sym_array_type,
       sym_code_type,
       sym_clsabs_type,
-  [4377] = 6,
-    ACTIONS(220), 1,
+  [4375] = 7,
+    ACTIONS(340), 1,
       anon_sym_LPAREN,
-    ACTIONS(222), 1,
+    ACTIONS(342), 1,
       anon_sym_LT,
-    ACTIONS(224), 1,
+    ACTIONS(344), 1,
       anon_sym_LBRACK,
-    ACTIONS(226), 2,
+    ACTIONS(348), 1,
+      anon_sym_array,
+    ACTIONS(346), 2,
       sym_int_type,
       sym_bool_type,
-    STATE(110), 2,
+    STATE(126), 3,
       sym__type,
       sym_func_type,
-    STATE(81), 3,
+      sym_tuple_type,
+    STATE(117), 4,
+      sym__simple_type,
+      sym_array_type,
+      sym_code_type,
+      sym_clsabs_type,
+  [4403] = 6,
+    ACTIONS(340), 1,
+      anon_sym_LPAREN,
+    ACTIONS(342), 1,
+      anon_sym_LT,
+    ACTIONS(344), 1,
+      anon_sym_LBRACK,
+    ACTIONS(348), 1,
+      anon_sym_array,
+    ACTIONS(350), 2,
+      sym_int_type,
+      sym_bool_type,
+    STATE(124), 4,
       sym__simple_type,
+      sym_array_type,
       sym_code_type,
       sym_clsabs_type,
-  [4400] = 5,
-    ACTIONS(220), 1,
+  [4426] = 6,
+    ACTIONS(340), 1,
       anon_sym_LPAREN,
-    ACTIONS(222), 1,
+    ACTIONS(342), 1,
       anon_sym_LT,
-    ACTIONS(224), 1,
+    ACTIONS(344), 1,
       anon_sym_LBRACK,
-    ACTIONS(228), 2,
+    ACTIONS(348), 1,
+      anon_sym_array,
+    ACTIONS(352), 2,
       sym_int_type,
       sym_bool_type,
-    STATE(84), 3,
+    STATE(121), 4,
       sym__simple_type,
+      sym_array_type,
       sym_code_type,
       sym_clsabs_type,
-  [4419] = 3,
-    ACTIONS(232), 1,
+  [4449] = 5,
+    ACTIONS(356), 1,
+      anon_sym_STAR,
+    ACTIONS(358), 1,
+      anon_sym_EQ,
+    ACTIONS(360), 1,
+      anon_sym_DASH_GT,
+    STATE(118), 1,
+      aux_sym_tuple_type_repeat1,
+    ACTIONS(354), 4,
+      anon_sym_RPAREN,
+      anon_sym_EQ_GT,
+      anon_sym_AT,
+      anon_sym_COMMA,
+  [4468] = 4,
+    ACTIONS(356), 1,
+      anon_sym_STAR,
+    ACTIONS(364), 1,
       anon_sym_EQ,
-    ACTIONS(234), 1,
+    STATE(120), 1,
+      aux_sym_tuple_type_repeat1,
+    ACTIONS(362), 4,
+      anon_sym_RPAREN,
+      anon_sym_EQ_GT,
+      anon_sym_AT,
+      anon_sym_COMMA,
+  [4484] = 2,
+    ACTIONS(368), 1,
+      anon_sym_EQ,
+    ACTIONS(366), 6,
+      anon_sym_RPAREN,
+      anon_sym_EQ_GT,
+      anon_sym_AT,
+      anon_sym_COMMA,
+      anon_sym_STAR,
       anon_sym_DASH_GT,
-    ACTIONS(230), 4,
+  [4496] = 4,
+    ACTIONS(372), 1,
+      anon_sym_STAR,
+    ACTIONS(375), 1,
+      anon_sym_EQ,
+    STATE(120), 1,
+      aux_sym_tuple_type_repeat1,
+    ACTIONS(370), 4,
       anon_sym_RPAREN,
       anon_sym_EQ_GT,
       anon_sym_AT,
       anon_sym_COMMA,
-  [4432] = 2,
-    ACTIONS(238), 1,
+  [4512] = 2,
+    ACTIONS(379), 1,
       anon_sym_EQ,
-    ACTIONS(236), 5,
+    ACTIONS(377), 6,
       anon_sym_RPAREN,
       anon_sym_EQ_GT,
       anon_sym_AT,
       anon_sym_COMMA,
+      anon_sym_STAR,
       anon_sym_DASH_GT,
-  [4443] = 2,
-    ACTIONS(242), 1,
+  [4524] = 2,
+    ACTIONS(383), 1,
       anon_sym_EQ,
-    ACTIONS(240), 5,
+    ACTIONS(381), 6,
       anon_sym_RPAREN,
       anon_sym_EQ_GT,
       anon_sym_AT,
       anon_sym_COMMA,
+      anon_sym_STAR,
       anon_sym_DASH_GT,
-  [4454] = 2,
-    ACTIONS(246), 1,
+  [4536] = 2,
+    ACTIONS(387), 1,
       anon_sym_EQ,
-    ACTIONS(244), 5,
+    ACTIONS(385), 6,
       anon_sym_RPAREN,
       anon_sym_EQ_GT,
       anon_sym_AT,
       anon_sym_COMMA,
+      anon_sym_STAR,
       anon_sym_DASH_GT,
-  [4465] = 3,
-    ACTIONS(210), 1,
+  [4548] = 2,
+    ACTIONS(391), 1,
+      anon_sym_EQ,
+    ACTIONS(389), 5,
+      anon_sym_RPAREN,
+      anon_sym_EQ_GT,
+      anon_sym_AT,
+      anon_sym_COMMA,
+      anon_sym_STAR,
+  [4559] = 3,
+    ACTIONS(296), 1,
       anon_sym_COLON,
-    ACTIONS(212), 1,
+    ACTIONS(298), 1,
       anon_sym_AT,
-    ACTIONS(214), 3,
+    ACTIONS(393), 3,
       anon_sym_RPAREN,
       anon_sym_COMMA,
       anon_sym_EQ,
-  [4477] = 2,
-    ACTIONS(250), 1,
+  [4571] = 2,
+    ACTIONS(397), 1,
       anon_sym_EQ,
-    ACTIONS(248), 4,
+    ACTIONS(395), 4,
       anon_sym_RPAREN,
       anon_sym_EQ_GT,
       anon_sym_AT,
       anon_sym_COMMA,
-  [4487] = 3,
-    STATE(116), 1,
+  [4581] = 4,
+    ACTIONS(399), 1,
+      sym_identifier,
+    ACTIONS(401), 1,
+      anon_sym_rec,
+    ACTIONS(403), 1,
+      anon_sym_cs,
+    STATE(155), 1,
+      sym_param,
+  [4594] = 3,
+    STATE(156), 1,
       sym_clsparam,
-    STATE(121), 1,
+    STATE(157), 1,
       sym_classifier,
-    ACTIONS(252), 2,
+    ACTIONS(405), 2,
       sym_identifier,
       anon_sym_BANG,
-  [4498] = 2,
-    ACTIONS(256), 1,
-      anon_sym_AT,
-    ACTIONS(254), 3,
-      anon_sym_RPAREN,
-      anon_sym_COMMA,
-      anon_sym_EQ,
-  [4507] = 3,
-    STATE(114), 1,
-      sym_clsparam,
-    STATE(121), 1,
+  [4605] = 3,
+    STATE(157), 1,
       sym_classifier,
-    ACTIONS(252), 2,
+    STATE(167), 1,
+      sym_clsparam,
+    ACTIONS(405), 2,
       sym_identifier,
       anon_sym_BANG,
-  [4518] = 3,
-    ACTIONS(258), 1,
+  [4616] = 2,
+    ACTIONS(409), 1,
+      anon_sym_AT,
+    ACTIONS(407), 3,
       anon_sym_RPAREN,
-    ACTIONS(260), 1,
       anon_sym_COMMA,
-    STATE(90), 1,
-      aux_sym_params_repeat1,
-  [4528] = 1,
-    ACTIONS(263), 3,
+      anon_sym_EQ,
+  [4625] = 3,
+    ACTIONS(413), 1,
+      anon_sym_COMMA,
+    STATE(131), 1,
+      aux_sym_array_repeat1,
+    ACTIONS(411), 2,
       anon_sym_RPAREN,
+      anon_sym_PIPE_RBRACK,
+  [4636] = 3,
+    ACTIONS(416), 1,
+      anon_sym_RPAREN,
+    ACTIONS(418), 1,
       anon_sym_COMMA,
-      anon_sym_EQ,
-  [4534] = 2,
-    STATE(99), 1,
+    STATE(138), 1,
+      aux_sym_params_repeat1,
+  [4646] = 2,
+    STATE(24), 1,
       sym_classifier,
-    ACTIONS(252), 2,
+    ACTIONS(405), 2,
       sym_identifier,
       anon_sym_BANG,
-  [4542] = 2,
-    STATE(20), 1,
+  [4654] = 3,
+    ACTIONS(399), 1,
+      sym_identifier,
+    ACTIONS(420), 1,
+      sym_memo,
+    STATE(159), 1,
+      sym_param,
+  [4664] = 2,
+    STATE(96), 1,
       sym_classifier,
-    ACTIONS(252), 2,
+    ACTIONS(422), 2,
       sym_identifier,
       anon_sym_BANG,
-  [4550] = 3,
-    ACTIONS(265), 1,
-      anon_sym_RPAREN,
-    ACTIONS(267), 1,
-      anon_sym_COMMA,
-    STATE(97), 1,
-      aux_sym_params_repeat1,
-  [4560] = 3,
-    ACTIONS(269), 1,
-      sym_identifier,
-    ACTIONS(271), 1,
-      anon_sym_rec,
-    STATE(115), 1,
-      sym_param,
-  [4570] = 2,
-    STATE(120), 1,
+  [4672] = 2,
+    STATE(141), 1,
       sym_classifier,
-    ACTIONS(252), 2,
+    ACTIONS(405), 2,
       sym_identifier,
       anon_sym_BANG,
-  [4578] = 3,
-    ACTIONS(267), 1,
+  [4680] = 3,
+    ACTIONS(149), 1,
       anon_sym_COMMA,
-    ACTIONS(273), 1,
+    ACTIONS(424), 1,
       anon_sym_RPAREN,
-    STATE(90), 1,
+    STATE(131), 1,
+      aux_sym_array_repeat1,
+  [4690] = 3,
+    ACTIONS(418), 1,
+      anon_sym_COMMA,
+    ACTIONS(426), 1,
+      anon_sym_RPAREN,
+    STATE(142), 1,
       aux_sym_params_repeat1,
-  [4588] = 2,
-    STATE(109), 1,
+  [4700] = 3,
+    ACTIONS(149), 1,
+      anon_sym_COMMA,
+    ACTIONS(428), 1,
+      anon_sym_PIPE_RBRACK,
+    STATE(131), 1,
+      aux_sym_array_repeat1,
+  [4710] = 2,
+    STATE(164), 1,
       sym_classifier,
-    ACTIONS(252), 2,
+    ACTIONS(405), 2,
       sym_identifier,
       anon_sym_BANG,
-  [4596] = 1,
-    ACTIONS(275), 3,
+  [4718] = 1,
+    ACTIONS(430), 3,
       anon_sym_RPAREN,
       anon_sym_COMMA,
       anon_sym_EQ,
-  [4602] = 2,
-    STATE(55), 1,
+  [4724] = 3,
+    ACTIONS(432), 1,
+      anon_sym_RPAREN,
+    ACTIONS(434), 1,
+      anon_sym_COMMA,
+    STATE(142), 1,
+      aux_sym_params_repeat1,
+  [4734] = 2,
+    STATE(145), 1,
       sym_classifier,
-    ACTIONS(277), 2,
+    ACTIONS(405), 2,
       sym_identifier,
       anon_sym_BANG,
-  [4610] = 2,
-    STATE(91), 1,
+  [4742] = 2,
+    STATE(172), 1,
       sym_classifier,
-    ACTIONS(252), 2,
+    ACTIONS(405), 2,
       sym_identifier,
       anon_sym_BANG,
-  [4618] = 2,
-    ACTIONS(279), 1,
-      anon_sym_COLON,
-    ACTIONS(281), 1,
-      anon_sym_EQ_GT,
-  [4625] = 2,
-    ACTIONS(283), 1,
+  [4750] = 1,
+    ACTIONS(437), 3,
+      anon_sym_RPAREN,
+      anon_sym_COMMA,
+      anon_sym_EQ,
+  [4756] = 2,
+    ACTIONS(439), 1,
+      anon_sym_LBRACE,
+    ACTIONS(441), 1,
+      sym_number,
+  [4763] = 2,
+    ACTIONS(443), 1,
       sym_identifier,
-    STATE(106), 1,
+    STATE(160), 1,
       sym_param,
-  [4632] = 2,
-    ACTIONS(283), 1,
+  [4770] = 2,
+    ACTIONS(443), 1,
       sym_identifier,
-    STATE(119), 1,
+    STATE(151), 1,
       sym_param,
-  [4639] = 2,
-    ACTIONS(285), 1,
-      anon_sym_LBRACE,
-    ACTIONS(287), 1,
-      sym_number,
-  [4646] = 1,
-    ACTIONS(258), 2,
+  [4777] = 2,
+    ACTIONS(445), 1,
+      anon_sym_COLON,
+    ACTIONS(447), 1,
+      anon_sym_EQ_GT,
+  [4784] = 2,
+    ACTIONS(443), 1,
+      sym_identifier,
+    STATE(163), 1,
+      sym_param,
+  [4791] = 1,
+    ACTIONS(432), 2,
       anon_sym_RPAREN,
       anon_sym_COMMA,
-  [4651] = 1,
-    ACTIONS(289), 1,
-      anon_sym_LBRACE,
-  [4655] = 1,
-    ACTIONS(291), 1,
+  [4796] = 1,
+    ACTIONS(449), 1,
       ts_builtin_sym_end,
-  [4659] = 1,
-    ACTIONS(293), 1,
-      anon_sym_RBRACK,
-  [4663] = 1,
-    ACTIONS(295), 1,
+  [4800] = 1,
+    ACTIONS(451), 1,
       anon_sym_RPAREN,
-  [4667] = 1,
-    ACTIONS(297), 1,
-      anon_sym_AT,
-  [4671] = 1,
-    ACTIONS(299), 1,
+  [4804] = 1,
+    ACTIONS(453), 1,
       anon_sym_LBRACE,
-  [4675] = 1,
-    ACTIONS(301), 1,
-      anon_sym_RPAREN,
-  [4679] = 1,
-    ACTIONS(303), 1,
-      anon_sym_RBRACK,
-  [4683] = 1,
-    ACTIONS(305), 1,
+  [4808] = 1,
+    ACTIONS(455), 1,
       anon_sym_EQ,
-  [4687] = 1,
-    ACTIONS(307), 1,
+  [4812] = 1,
+    ACTIONS(457), 1,
       anon_sym_RBRACK,
-  [4691] = 1,
-    ACTIONS(309), 1,
+  [4816] = 1,
+    ACTIONS(459), 1,
+      anon_sym_COLON_GT,
+  [4820] = 1,
+    ACTIONS(461), 1,
+      sym_number,
+  [4824] = 1,
+    ACTIONS(463), 1,
+      anon_sym_EQ,
+  [4828] = 1,
+    ACTIONS(465), 1,
+      anon_sym_EQ,
+  [4832] = 1,
+    ACTIONS(467), 1,
+      anon_sym_LT,
+  [4836] = 1,
+    ACTIONS(469), 1,
       anon_sym_LBRACE,
-  [4695] = 1,
-    ACTIONS(311), 1,
-      anon_sym_EQ_GT,
-  [4699] = 1,
-    ACTIONS(313), 1,
+  [4840] = 1,
+    ACTIONS(471), 1,
       anon_sym_EQ,
-  [4703] = 1,
-    ACTIONS(315), 1,
+  [4844] = 1,
+    ACTIONS(473), 1,
+      anon_sym_RBRACK,
+  [4848] = 1,
+    ACTIONS(475), 1,
+      anon_sym_RPAREN,
+  [4852] = 1,
+    ACTIONS(477), 1,
+      anon_sym_AT,
+  [4856] = 1,
+    ACTIONS(479), 1,
+      anon_sym_RBRACK,
+  [4860] = 1,
+    ACTIONS(481), 1,
+      sym_int_type,
+  [4864] = 1,
+    ACTIONS(483), 1,
+      anon_sym_EQ_GT,
+  [4868] = 1,
+    ACTIONS(485), 1,
+      anon_sym_GT,
+  [4872] = 1,
+    ACTIONS(487), 1,
+      anon_sym_LBRACE,
+  [4876] = 1,
+    ACTIONS(489), 1,
       anon_sym_GT,
-  [4707] = 1,
-    ACTIONS(317), 1,
-      anon_sym_COLON_GT,
 };
 
 static const uint32_t ts_small_parse_table_map[] = {
-  [SMALL_STATE(2)] = 0,
-  [SMALL_STATE(3)] = 69,
-  [SMALL_STATE(4)] = 135,
-  [SMALL_STATE(5)] = 198,
-  [SMALL_STATE(6)] = 261,
-  [SMALL_STATE(7)] = 324,
-  [SMALL_STATE(8)] = 387,
-  [SMALL_STATE(9)] = 450,
-  [SMALL_STATE(10)] = 513,
-  [SMALL_STATE(11)] = 576,
-  [SMALL_STATE(12)] = 639,
-  [SMALL_STATE(13)] = 702,
-  [SMALL_STATE(14)] = 765,
-  [SMALL_STATE(15)] = 828,
-  [SMALL_STATE(16)] = 891,
-  [SMALL_STATE(17)] = 954,
-  [SMALL_STATE(18)] = 1017,
-  [SMALL_STATE(19)] = 1080,
-  [SMALL_STATE(20)] = 1143,
-  [SMALL_STATE(21)] = 1206,
-  [SMALL_STATE(22)] = 1269,
-  [SMALL_STATE(23)] = 1332,
-  [SMALL_STATE(24)] = 1395,
-  [SMALL_STATE(25)] = 1458,
-  [SMALL_STATE(26)] = 1521,
-  [SMALL_STATE(27)] = 1584,
-  [SMALL_STATE(28)] = 1647,
-  [SMALL_STATE(29)] = 1710,
-  [SMALL_STATE(30)] = 1773,
-  [SMALL_STATE(31)] = 1833,
-  [SMALL_STATE(32)] = 1897,
-  [SMALL_STATE(33)] = 1961,
-  [SMALL_STATE(34)] = 2025,
-  [SMALL_STATE(35)] = 2089,
-  [SMALL_STATE(36)] = 2165,
-  [SMALL_STATE(37)] = 2243,
-  [SMALL_STATE(38)] = 2303,
-  [SMALL_STATE(39)] = 2357,
-  [SMALL_STATE(40)] = 2411,
-  [SMALL_STATE(41)] = 2465,
-  [SMALL_STATE(42)] = 2519,
-  [SMALL_STATE(43)] = 2599,
-  [SMALL_STATE(44)] = 2663,
-  [SMALL_STATE(45)] = 2743,
-  [SMALL_STATE(46)] = 2807,
-  [SMALL_STATE(47)] = 2887,
-  [SMALL_STATE(48)] = 2960,
-  [SMALL_STATE(49)] = 2993,
-  [SMALL_STATE(50)] = 3026,
-  [SMALL_STATE(51)] = 3099,
-  [SMALL_STATE(52)] = 3134,
-  [SMALL_STATE(53)] = 3207,
-  [SMALL_STATE(54)] = 3280,
-  [SMALL_STATE(55)] = 3313,
-  [SMALL_STATE(56)] = 3346,
-  [SMALL_STATE(57)] = 3419,
-  [SMALL_STATE(58)] = 3492,
-  [SMALL_STATE(59)] = 3565,
-  [SMALL_STATE(60)] = 3598,
-  [SMALL_STATE(61)] = 3671,
-  [SMALL_STATE(62)] = 3704,
-  [SMALL_STATE(63)] = 3777,
-  [SMALL_STATE(64)] = 3810,
-  [SMALL_STATE(65)] = 3843,
-  [SMALL_STATE(66)] = 3916,
-  [SMALL_STATE(67)] = 3989,
-  [SMALL_STATE(68)] = 4022,
-  [SMALL_STATE(69)] = 4095,
-  [SMALL_STATE(70)] = 4128,
-  [SMALL_STATE(71)] = 4161,
-  [SMALL_STATE(72)] = 4193,
-  [SMALL_STATE(73)] = 4232,
-  [SMALL_STATE(74)] = 4254,
-  [SMALL_STATE(75)] = 4285,
-  [SMALL_STATE(76)] = 4308,
-  [SMALL_STATE(77)] = 4331,
-  [SMALL_STATE(78)] = 4354,
-  [SMALL_STATE(79)] = 4377,
-  [SMALL_STATE(80)] = 4400,
-  [SMALL_STATE(81)] = 4419,
-  [SMALL_STATE(82)] = 4432,
-  [SMALL_STATE(83)] = 4443,
-  [SMALL_STATE(84)] = 4454,
-  [SMALL_STATE(85)] = 4465,
-  [SMALL_STATE(86)] = 4477,
-  [SMALL_STATE(87)] = 4487,
-  [SMALL_STATE(88)] = 4498,
-  [SMALL_STATE(89)] = 4507,
-  [SMALL_STATE(90)] = 4518,
-  [SMALL_STATE(91)] = 4528,
-  [SMALL_STATE(92)] = 4534,
-  [SMALL_STATE(93)] = 4542,
-  [SMALL_STATE(94)] = 4550,
-  [SMALL_STATE(95)] = 4560,
-  [SMALL_STATE(96)] = 4570,
-  [SMALL_STATE(97)] = 4578,
-  [SMALL_STATE(98)] = 4588,
-  [SMALL_STATE(99)] = 4596,
-  [SMALL_STATE(100)] = 4602,
-  [SMALL_STATE(101)] = 4610,
-  [SMALL_STATE(102)] = 4618,
-  [SMALL_STATE(103)] = 4625,
-  [SMALL_STATE(104)] = 4632,
-  [SMALL_STATE(105)] = 4639,
-  [SMALL_STATE(106)] = 4646,
-  [SMALL_STATE(107)] = 4651,
-  [SMALL_STATE(108)] = 4655,
-  [SMALL_STATE(109)] = 4659,
-  [SMALL_STATE(110)] = 4663,
-  [SMALL_STATE(111)] = 4667,
-  [SMALL_STATE(112)] = 4671,
-  [SMALL_STATE(113)] = 4675,
-  [SMALL_STATE(114)] = 4679,
-  [SMALL_STATE(115)] = 4683,
-  [SMALL_STATE(116)] = 4687,
-  [SMALL_STATE(117)] = 4691,
-  [SMALL_STATE(118)] = 4695,
-  [SMALL_STATE(119)] = 4699,
-  [SMALL_STATE(120)] = 4703,
-  [SMALL_STATE(121)] = 4707,
+  [SMALL_STATE(37)] = 0,
+  [SMALL_STATE(38)] = 63,
+  [SMALL_STATE(39)] = 132,
+  [SMALL_STATE(40)] = 201,
+  [SMALL_STATE(41)] = 264,
+  [SMALL_STATE(42)] = 327,
+  [SMALL_STATE(43)] = 390,
+  [SMALL_STATE(44)] = 463,
+  [SMALL_STATE(45)] = 536,
+  [SMALL_STATE(46)] = 609,
+  [SMALL_STATE(47)] = 682,
+  [SMALL_STATE(48)] = 755,
+  [SMALL_STATE(49)] = 828,
+  [SMALL_STATE(50)] = 913,
+  [SMALL_STATE(51)] = 1000,
+  [SMALL_STATE(52)] = 1089,
+  [SMALL_STATE(53)] = 1178,
+  [SMALL_STATE(54)] = 1267,
+  [SMALL_STATE(55)] = 1356,
+  [SMALL_STATE(56)] = 1445,
+  [SMALL_STATE(57)] = 1531,
+  [SMALL_STATE(58)] = 1617,
+  [SMALL_STATE(59)] = 1699,
+  [SMALL_STATE(60)] = 1737,
+  [SMALL_STATE(61)] = 1817,
+  [SMALL_STATE(62)] = 1859,
+  [SMALL_STATE(63)] = 1939,
+  [SMALL_STATE(64)] = 1977,
+  [SMALL_STATE(65)] = 2057,
+  [SMALL_STATE(66)] = 2095,
+  [SMALL_STATE(67)] = 2133,
+  [SMALL_STATE(68)] = 2171,
+  [SMALL_STATE(69)] = 2251,
+  [SMALL_STATE(70)] = 2331,
+  [SMALL_STATE(71)] = 2369,
+  [SMALL_STATE(72)] = 2407,
+  [SMALL_STATE(73)] = 2487,
+  [SMALL_STATE(74)] = 2525,
+  [SMALL_STATE(75)] = 2605,
+  [SMALL_STATE(76)] = 2643,
+  [SMALL_STATE(77)] = 2723,
+  [SMALL_STATE(78)] = 2803,
+  [SMALL_STATE(79)] = 2845,
+  [SMALL_STATE(80)] = 2883,
+  [SMALL_STATE(81)] = 2921,
+  [SMALL_STATE(82)] = 2959,
+  [SMALL_STATE(83)] = 3039,
+  [SMALL_STATE(84)] = 3119,
+  [SMALL_STATE(85)] = 3199,
+  [SMALL_STATE(86)] = 3279,
+  [SMALL_STATE(87)] = 3317,
+  [SMALL_STATE(88)] = 3397,
+  [SMALL_STATE(89)] = 3435,
+  [SMALL_STATE(90)] = 3476,
+  [SMALL_STATE(91)] = 3517,
+  [SMALL_STATE(92)] = 3558,
+  [SMALL_STATE(93)] = 3599,
+  [SMALL_STATE(94)] = 3640,
+  [SMALL_STATE(95)] = 3681,
+  [SMALL_STATE(96)] = 3719,
+  [SMALL_STATE(97)] = 3755,
+  [SMALL_STATE(98)] = 3791,
+  [SMALL_STATE(99)] = 3831,
+  [SMALL_STATE(100)] = 3859,
+  [SMALL_STATE(101)] = 3903,
+  [SMALL_STATE(102)] = 3947,
+  [SMALL_STATE(103)] = 3991,
+  [SMALL_STATE(104)] = 4035,
+  [SMALL_STATE(105)] = 4073,
+  [SMALL_STATE(106)] = 4111,
+  [SMALL_STATE(107)] = 4149,
+  [SMALL_STATE(108)] = 4187,
+  [SMALL_STATE(109)] = 4225,
+  [SMALL_STATE(110)] = 4263,
+  [SMALL_STATE(111)] = 4291,
+  [SMALL_STATE(112)] = 4319,
+  [SMALL_STATE(113)] = 4347,
+  [SMALL_STATE(114)] = 4375,
+  [SMALL_STATE(115)] = 4403,
+  [SMALL_STATE(116)] = 4426,
+  [SMALL_STATE(117)] = 4449,
+  [SMALL_STATE(118)] = 4468,
+  [SMALL_STATE(119)] = 4484,
+  [SMALL_STATE(120)] = 4496,
+  [SMALL_STATE(121)] = 4512,
+  [SMALL_STATE(122)] = 4524,
+  [SMALL_STATE(123)] = 4536,
+  [SMALL_STATE(124)] = 4548,
+  [SMALL_STATE(125)] = 4559,
+  [SMALL_STATE(126)] = 4571,
+  [SMALL_STATE(127)] = 4581,
+  [SMALL_STATE(128)] = 4594,
+  [SMALL_STATE(129)] = 4605,
+  [SMALL_STATE(130)] = 4616,
+  [SMALL_STATE(131)] = 4625,
+  [SMALL_STATE(132)] = 4636,
+  [SMALL_STATE(133)] = 4646,
+  [SMALL_STATE(134)] = 4654,
+  [SMALL_STATE(135)] = 4664,
+  [SMALL_STATE(136)] = 4672,
+  [SMALL_STATE(137)] = 4680,
+  [SMALL_STATE(138)] = 4690,
+  [SMALL_STATE(139)] = 4700,
+  [SMALL_STATE(140)] = 4710,
+  [SMALL_STATE(141)] = 4718,
+  [SMALL_STATE(142)] = 4724,
+  [SMALL_STATE(143)] = 4734,
+  [SMALL_STATE(144)] = 4742,
+  [SMALL_STATE(145)] = 4750,
+  [SMALL_STATE(146)] = 4756,
+  [SMALL_STATE(147)] = 4763,
+  [SMALL_STATE(148)] = 4770,
+  [SMALL_STATE(149)] = 4777,
+  [SMALL_STATE(150)] = 4784,
+  [SMALL_STATE(151)] = 4791,
+  [SMALL_STATE(152)] = 4796,
+  [SMALL_STATE(153)] = 4800,
+  [SMALL_STATE(154)] = 4804,
+  [SMALL_STATE(155)] = 4808,
+  [SMALL_STATE(156)] = 4812,
+  [SMALL_STATE(157)] = 4816,
+  [SMALL_STATE(158)] = 4820,
+  [SMALL_STATE(159)] = 4824,
+  [SMALL_STATE(160)] = 4828,
+  [SMALL_STATE(161)] = 4832,
+  [SMALL_STATE(162)] = 4836,
+  [SMALL_STATE(163)] = 4840,
+  [SMALL_STATE(164)] = 4844,
+  [SMALL_STATE(165)] = 4848,
+  [SMALL_STATE(166)] = 4852,
+  [SMALL_STATE(167)] = 4856,
+  [SMALL_STATE(168)] = 4860,
+  [SMALL_STATE(169)] = 4864,
+  [SMALL_STATE(170)] = 4868,
+  [SMALL_STATE(171)] = 4872,
+  [SMALL_STATE(172)] = 4876,
 };
 
 static const TSParseActionEntry ts_parse_actions[] = {
   [0] = {.entry = {.count = 0, .reusable = false}},
   [1] = {.entry = {.count = 1, .reusable = false}}, RECOVER(),
-  [3] = {.entry = {.count = 1, .reusable = false}}, SHIFT(51),
+  [3] = {.entry = {.count = 1, .reusable = false}}, SHIFT(61),
   [5] = {.entry = {.count = 1, .reusable = true}}, SHIFT(2),
-  [7] = {.entry = {.count = 1, .reusable = true}}, SHIFT(27),
-  [9] = {.entry = {.count = 1, .reusable = true}}, SHIFT(51),
+  [7] = {.entry = {.count = 1, .reusable = true}}, SHIFT(5),
+  [9] = {.entry = {.count = 1, .reusable = true}}, SHIFT(61),
   [11] = {.entry = {.count = 1, .reusable = false}}, SHIFT(59),
-  [13] = {.entry = {.count = 1, .reusable = false}}, SHIFT(19),
+  [13] = {.entry = {.count = 1, .reusable = false}}, SHIFT(6),
   [15] = {.entry = {.count = 1, .reusable = true}}, SHIFT(3),
-  [17] = {.entry = {.count = 1, .reusable = true}}, SHIFT(105),
-  [19] = {.entry = {.count = 1, .reusable = false}}, SHIFT(95),
-  [21] = {.entry = {.count = 1, .reusable = true}}, SHIFT(87),
-  [23] = {.entry = {.count = 1, .reusable = false}}, SHIFT(72),
-  [25] = {.entry = {.count = 1, .reusable = true}}, SHIFT(93),
-  [27] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_sub, 3, 0, 4),
-  [29] = {.entry = {.count = 1, .reusable = false}}, SHIFT(71),
-  [31] = {.entry = {.count = 1, .reusable = true}}, SHIFT(71),
-  [33] = {.entry = {.count = 1, .reusable = true}}, SHIFT(8),
-  [35] = {.entry = {.count = 1, .reusable = true}}, SHIFT(9),
-  [37] = {.entry = {.count = 1, .reusable = false}}, SHIFT(10),
-  [39] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_sub, 3, 0, 4),
-  [41] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_lt, 3, 0, 4),
-  [43] = {.entry = {.count = 1, .reusable = true}}, SHIFT(6),
-  [45] = {.entry = {.count = 1, .reusable = true}}, SHIFT(7),
-  [47] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_lt, 3, 0, 4),
-  [49] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_le, 3, 0, 4),
-  [51] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_le, 3, 0, 4),
-  [53] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_gt, 3, 0, 4),
-  [55] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_gt, 3, 0, 4),
-  [57] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_ge, 3, 0, 4),
-  [59] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_ge, 3, 0, 4),
-  [61] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_and, 3, 0, 4),
-  [63] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_and, 3, 0, 4),
-  [65] = {.entry = {.count = 1, .reusable = true}}, SHIFT(11),
-  [67] = {.entry = {.count = 1, .reusable = true}}, SHIFT(12),
-  [69] = {.entry = {.count = 1, .reusable = false}}, SHIFT(13),
-  [71] = {.entry = {.count = 1, .reusable = true}}, SHIFT(14),
-  [73] = {.entry = {.count = 1, .reusable = false}}, SHIFT(15),
-  [75] = {.entry = {.count = 1, .reusable = true}}, SHIFT(16),
-  [77] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_or, 3, 0, 4),
-  [79] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_or, 3, 0, 4),
-  [81] = {.entry = {.count = 1, .reusable = true}}, SHIFT(17),
-  [83] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_add, 3, 0, 4),
-  [85] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_add, 3, 0, 4),
-  [87] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_not, 2, 0, 0),
-  [89] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_not, 2, 0, 0),
-  [91] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_mult, 3, 0, 4),
-  [93] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_mult, 3, 0, 4),
-  [95] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_div, 3, 0, 4),
-  [97] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_div, 3, 0, 4),
-  [99] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_mod, 3, 0, 4),
-  [101] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_mod, 3, 0, 4),
-  [103] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_ctrl_if, 6, 0, 15),
-  [105] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_ctrl_if, 6, 0, 15),
-  [107] = {.entry = {.count = 1, .reusable = true}}, SHIFT(18),
-  [109] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_eq, 3, 0, 4),
-  [111] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_eq, 3, 0, 4),
-  [113] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_let, 6, 0, 16),
-  [115] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_let, 6, 0, 16),
-  [117] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_ne, 3, 0, 4),
-  [119] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_ne, 3, 0, 4),
-  [121] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_letrec, 7, 0, 19),
-  [123] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_letrec, 7, 0, 19),
-  [125] = {.entry = {.count = 1, .reusable = true}}, SHIFT(69),
-  [127] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_classifier, 1, 0, 0),
-  [129] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_classifier, 1, 0, 0),
-  [131] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_quote, 3, 0, 3),
-  [133] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_quote, 3, 0, 3),
-  [135] = {.entry = {.count = 1, .reusable = true}}, SHIFT(54),
-  [137] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym__expression, 1, 0, 0),
-  [139] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym__expression, 1, 0, 0),
-  [141] = {.entry = {.count = 1, .reusable = true}}, SHIFT(100),
-  [143] = {.entry = {.count = 1, .reusable = true}}, SHIFT(63),
-  [145] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_source_file, 1, 0, 0),
-  [147] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_splice, 4, 0, 8),
-  [149] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_splice, 4, 0, 8),
-  [151] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_clsapp, 3, 0, 5),
-  [153] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_clsapp, 3, 0, 5),
-  [155] = {.entry = {.count = 1, .reusable = true}}, SHIFT(67),
-  [157] = {.entry = {.count = 1, .reusable = false}}, SHIFT(25),
-  [159] = {.entry = {.count = 1, .reusable = true}}, SHIFT(64),
-  [161] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_boolean, 1, 0, 0),
-  [163] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_boolean, 1, 0, 0),
-  [165] = {.entry = {.count = 1, .reusable = false}}, SHIFT(26),
-  [167] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_clsabs, 4, 0, 9),
-  [169] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_clsabs, 4, 0, 9),
-  [171] = {.entry = {.count = 1, .reusable = false}}, SHIFT(4),
-  [173] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_quote, 5, 0, 11),
-  [175] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_quote, 5, 0, 11),
-  [177] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_splice, 5, 0, 12),
-  [179] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_splice, 5, 0, 12),
-  [181] = {.entry = {.count = 1, .reusable = false}}, SHIFT(28),
-  [183] = {.entry = {.count = 1, .reusable = true}}, SHIFT(49),
-  [185] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym__simple_expression, 3, 0, 0),
-  [187] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym__simple_expression, 3, 0, 0),
-  [189] = {.entry = {.count = 1, .reusable = true}}, SHIFT(70),
-  [191] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_lambda, 7, 0, 18),
-  [193] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_lambda, 7, 0, 18),
-  [195] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_lambda, 9, 0, 21),
-  [197] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_lambda, 9, 0, 21),
-  [199] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_application, 2, 0, 2),
-  [201] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_application, 2, 0, 2),
-  [203] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym__simple_expression, 1, 0, 0),
-  [205] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym__simple_expression, 1, 0, 0),
-  [207] = {.entry = {.count = 2, .reusable = true}}, REDUCE(sym__simple_expression, 1, 0, 0), REDUCE(sym_param, 1, 0, 1),
-  [210] = {.entry = {.count = 1, .reusable = true}}, SHIFT(75),
-  [212] = {.entry = {.count = 1, .reusable = true}}, SHIFT(101),
-  [214] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_param, 1, 0, 1),
-  [216] = {.entry = {.count = 1, .reusable = false}}, SHIFT(61),
-  [218] = {.entry = {.count = 1, .reusable = true}}, SHIFT(61),
-  [220] = {.entry = {.count = 1, .reusable = true}}, SHIFT(79),
-  [222] = {.entry = {.count = 1, .reusable = true}}, SHIFT(78),
-  [224] = {.entry = {.count = 1, .reusable = true}}, SHIFT(89),
-  [226] = {.entry = {.count = 1, .reusable = true}}, SHIFT(81),
-  [228] = {.entry = {.count = 1, .reusable = true}}, SHIFT(84),
-  [230] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym__type, 1, 0, 0),
-  [232] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym__type, 1, 0, 0),
-  [234] = {.entry = {.count = 1, .reusable = true}}, SHIFT(77),
-  [236] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym__simple_type, 3, 0, 0),
-  [238] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym__simple_type, 3, 0, 0),
-  [240] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_code_type, 5, 0, 20),
-  [242] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_code_type, 5, 0, 20),
-  [244] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_clsabs_type, 4, 0, 17),
-  [246] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_clsabs_type, 4, 0, 17),
-  [248] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_func_type, 3, 0, 14),
-  [250] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_func_type, 3, 0, 14),
-  [252] = {.entry = {.count = 1, .reusable = true}}, SHIFT(73),
-  [254] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_param, 3, 0, 6),
-  [256] = {.entry = {.count = 1, .reusable = true}}, SHIFT(92),
-  [258] = {.entry = {.count = 1, .reusable = true}}, REDUCE(aux_sym_params_repeat1, 2, 0, 0),
-  [260] = {.entry = {.count = 2, .reusable = true}}, REDUCE(aux_sym_params_repeat1, 2, 0, 0), SHIFT_REPEAT(103),
-  [263] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_param, 3, 0, 7),
-  [265] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_params, 1, 0, 0),
-  [267] = {.entry = {.count = 1, .reusable = true}}, SHIFT(103),
-  [269] = {.entry = {.count = 1, .reusable = false}}, SHIFT(85),
-  [271] = {.entry = {.count = 1, .reusable = false}}, SHIFT(104),
-  [273] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_params, 2, 0, 0),
-  [275] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_param, 5, 0, 13),
-  [277] = {.entry = {.count = 1, .reusable = true}}, SHIFT(48),
-  [279] = {.entry = {.count = 1, .reusable = true}}, SHIFT(76),
-  [281] = {.entry = {.count = 1, .reusable = true}}, SHIFT(107),
-  [283] = {.entry = {.count = 1, .reusable = true}}, SHIFT(85),
-  [285] = {.entry = {.count = 1, .reusable = true}}, SHIFT(5),
-  [287] = {.entry = {.count = 1, .reusable = true}}, SHIFT(117),
-  [289] = {.entry = {.count = 1, .reusable = true}}, SHIFT(24),
-  [291] = {.entry = {.count = 1, .reusable = true}},  ACCEPT_INPUT(),
-  [293] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_clsparam, 3, 0, 10),
-  [295] = {.entry = {.count = 1, .reusable = true}}, SHIFT(82),
-  [297] = {.entry = {.count = 1, .reusable = true}}, SHIFT(96),
-  [299] = {.entry = {.count = 1, .reusable = true}}, SHIFT(29),
-  [301] = {.entry = {.count = 1, .reusable = true}}, SHIFT(102),
-  [303] = {.entry = {.count = 1, .reusable = true}}, SHIFT(80),
-  [305] = {.entry = {.count = 1, .reusable = true}}, SHIFT(22),
-  [307] = {.entry = {.count = 1, .reusable = true}}, SHIFT(74),
-  [309] = {.entry = {.count = 1, .reusable = true}}, SHIFT(21),
-  [311] = {.entry = {.count = 1, .reusable = true}}, SHIFT(112),
-  [313] = {.entry = {.count = 1, .reusable = true}}, SHIFT(23),
-  [315] = {.entry = {.count = 1, .reusable = true}}, SHIFT(83),
-  [317] = {.entry = {.count = 1, .reusable = true}}, SHIFT(98),
+  [17] = {.entry = {.count = 1, .reusable = true}}, SHIFT(104),
+  [19] = {.entry = {.count = 1, .reusable = true}}, SHIFT(105),
+  [21] = {.entry = {.count = 1, .reusable = true}}, SHIFT(106),
+  [23] = {.entry = {.count = 1, .reusable = true}}, SHIFT(107),
+  [25] = {.entry = {.count = 1, .reusable = true}}, SHIFT(4),
+  [27] = {.entry = {.count = 1, .reusable = true}}, SHIFT(146),
+  [29] = {.entry = {.count = 1, .reusable = false}}, SHIFT(108),
+  [31] = {.entry = {.count = 1, .reusable = false}}, SHIFT(127),
+  [33] = {.entry = {.count = 1, .reusable = false}}, SHIFT(128),
+  [35] = {.entry = {.count = 1, .reusable = false}}, SHIFT(98),
+  [37] = {.entry = {.count = 1, .reusable = true}}, SHIFT(63),
+  [39] = {.entry = {.count = 1, .reusable = true}}, SHIFT(133),
+  [41] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_not, 2, 0, 0),
+  [43] = {.entry = {.count = 1, .reusable = false}}, SHIFT(91),
+  [45] = {.entry = {.count = 1, .reusable = true}}, SHIFT(91),
+  [47] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_not, 2, 0, 0),
+  [49] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_add, 3, 0, 8),
+  [51] = {.entry = {.count = 1, .reusable = true}}, SHIFT(10),
+  [53] = {.entry = {.count = 1, .reusable = true}}, SHIFT(11),
+  [55] = {.entry = {.count = 1, .reusable = false}}, SHIFT(12),
+  [57] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_add, 3, 0, 8),
+  [59] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_sub, 3, 0, 8),
+  [61] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_sub, 3, 0, 8),
+  [63] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_mult, 3, 0, 8),
+  [65] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_mult, 3, 0, 8),
+  [67] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_div, 3, 0, 8),
+  [69] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_div, 3, 0, 8),
+  [71] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_mod, 3, 0, 8),
+  [73] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_mod, 3, 0, 8),
+  [75] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_eq, 3, 0, 8),
+  [77] = {.entry = {.count = 1, .reusable = true}}, SHIFT(8),
+  [79] = {.entry = {.count = 1, .reusable = true}}, SHIFT(9),
+  [81] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_eq, 3, 0, 8),
+  [83] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_ne, 3, 0, 8),
+  [85] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_ne, 3, 0, 8),
+  [87] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_lt, 3, 0, 8),
+  [89] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_lt, 3, 0, 8),
+  [91] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_le, 3, 0, 8),
+  [93] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_le, 3, 0, 8),
+  [95] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_gt, 3, 0, 8),
+  [97] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_gt, 3, 0, 8),
+  [99] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_ge, 3, 0, 8),
+  [101] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_ge, 3, 0, 8),
+  [103] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_and, 3, 0, 8),
+  [105] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_and, 3, 0, 8),
+  [107] = {.entry = {.count = 1, .reusable = true}}, SHIFT(13),
+  [109] = {.entry = {.count = 1, .reusable = true}}, SHIFT(14),
+  [111] = {.entry = {.count = 1, .reusable = false}}, SHIFT(15),
+  [113] = {.entry = {.count = 1, .reusable = true}}, SHIFT(16),
+  [115] = {.entry = {.count = 1, .reusable = false}}, SHIFT(17),
+  [117] = {.entry = {.count = 1, .reusable = true}}, SHIFT(18),
+  [119] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_or, 3, 0, 8),
+  [121] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_or, 3, 0, 8),
+  [123] = {.entry = {.count = 1, .reusable = true}}, SHIFT(19),
+  [125] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_ctrl_if, 6, 0, 25),
+  [127] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_ctrl_if, 6, 0, 25),
+  [129] = {.entry = {.count = 1, .reusable = true}}, SHIFT(20),
+  [131] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_let, 6, 0, 26),
+  [133] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_let, 6, 0, 26),
+  [135] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_letrec, 7, 0, 30),
+  [137] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_letrec, 7, 0, 30),
+  [139] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_letcs, 7, 0, 30),
+  [141] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_letcs, 7, 0, 30),
+  [143] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_letrec, 8, 0, 32),
+  [145] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_letrec, 8, 0, 32),
+  [147] = {.entry = {.count = 1, .reusable = true}}, SHIFT(65),
+  [149] = {.entry = {.count = 1, .reusable = true}}, SHIFT(22),
+  [151] = {.entry = {.count = 1, .reusable = true}}, SHIFT(66),
+  [153] = {.entry = {.count = 1, .reusable = true}}, REDUCE(aux_sym_array_repeat1, 2, 0, 5),
+  [155] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_boolean, 1, 0, 0),
+  [157] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_boolean, 1, 0, 0),
+  [159] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_source_file, 1, 0, 0),
+  [161] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym__expression_with_clsapp, 1, 0, 0),
+  [163] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym__expression_with_clsapp, 1, 0, 0),
+  [165] = {.entry = {.count = 1, .reusable = true}}, SHIFT(21),
+  [167] = {.entry = {.count = 1, .reusable = false}}, SHIFT(158),
+  [169] = {.entry = {.count = 1, .reusable = false}}, SHIFT(23),
+  [171] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_array, 2, 0, 0),
+  [173] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_array, 2, 0, 0),
+  [175] = {.entry = {.count = 1, .reusable = true}}, SHIFT(67),
+  [177] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym__simple_expression, 3, 0, 0),
+  [179] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym__simple_expression, 3, 0, 0),
+  [181] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_array, 3, 0, 5),
+  [183] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_array, 3, 0, 5),
+  [185] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_quote, 3, 0, 3),
+  [187] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_quote, 3, 0, 3),
+  [189] = {.entry = {.count = 1, .reusable = true}}, SHIFT(75),
+  [191] = {.entry = {.count = 1, .reusable = true}}, SHIFT(79),
+  [193] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_tuple_get, 3, 0, 10),
+  [195] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_tuple_get, 3, 0, 10),
+  [197] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_tuple, 4, 0, 13),
+  [199] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_tuple, 4, 0, 13),
+  [201] = {.entry = {.count = 1, .reusable = false}}, SHIFT(30),
+  [203] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_array, 4, 0, 13),
+  [205] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_array, 4, 0, 13),
+  [207] = {.entry = {.count = 1, .reusable = true}}, SHIFT(80),
+  [209] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_splice, 4, 0, 16),
+  [211] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_splice, 4, 0, 16),
+  [213] = {.entry = {.count = 1, .reusable = true}}, SHIFT(81),
+  [215] = {.entry = {.count = 1, .reusable = false}}, SHIFT(32),
+  [217] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_clsabs, 4, 0, 17),
+  [219] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_clsabs, 4, 0, 17),
+  [221] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_array_get, 4, 0, 19),
+  [223] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_array_get, 4, 0, 19),
+  [225] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_quote, 5, 0, 21),
+  [227] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_quote, 5, 0, 21),
+  [229] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_splice, 5, 0, 22),
+  [231] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_splice, 5, 0, 22),
+  [233] = {.entry = {.count = 1, .reusable = false}}, SHIFT(33),
+  [235] = {.entry = {.count = 1, .reusable = false}}, SHIFT(34),
+  [237] = {.entry = {.count = 1, .reusable = true}}, SHIFT(86),
+  [239] = {.entry = {.count = 1, .reusable = false}}, SHIFT(36),
+  [241] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_lambda, 7, 0, 29),
+  [243] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_lambda, 7, 0, 29),
+  [245] = {.entry = {.count = 1, .reusable = true}}, SHIFT(88),
+  [247] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_lambda, 9, 0, 33),
+  [249] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_lambda, 9, 0, 33),
+  [251] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_array_length, 2, 0, 2),
+  [253] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_array_length, 2, 0, 2),
+  [255] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_genlet, 2, 0, 3),
+  [257] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_genlet, 2, 0, 3),
+  [259] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_application, 2, 0, 4),
+  [261] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_application, 2, 0, 4),
+  [263] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_array_init, 3, 0, 6),
+  [265] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_array_init, 3, 0, 6),
+  [267] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_array_map, 3, 0, 7),
+  [269] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_array_map, 3, 0, 7),
+  [271] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_array_fold, 4, 0, 15),
+  [273] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_array_fold, 4, 0, 15),
+  [275] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym__expression, 1, 0, 0),
+  [277] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym__expression, 1, 0, 0),
+  [279] = {.entry = {.count = 1, .reusable = true}}, SHIFT(135),
+  [281] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_clsapp, 3, 0, 9),
+  [283] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_clsapp, 3, 0, 9),
+  [285] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_classifier, 1, 0, 0),
+  [287] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_classifier, 1, 0, 0),
+  [289] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym__simple_expression, 1, 0, 0),
+  [291] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym__simple_expression, 1, 0, 0),
+  [293] = {.entry = {.count = 2, .reusable = true}}, REDUCE(sym__simple_expression, 1, 0, 0), REDUCE(sym_param, 1, 0, 1),
+  [296] = {.entry = {.count = 1, .reusable = true}}, SHIFT(110),
+  [298] = {.entry = {.count = 1, .reusable = true}}, SHIFT(136),
+  [300] = {.entry = {.count = 1, .reusable = false}}, SHIFT(92),
+  [302] = {.entry = {.count = 1, .reusable = true}}, SHIFT(92),
+  [304] = {.entry = {.count = 1, .reusable = false}}, SHIFT(93),
+  [306] = {.entry = {.count = 1, .reusable = true}}, SHIFT(93),
+  [308] = {.entry = {.count = 1, .reusable = false}}, SHIFT(103),
+  [310] = {.entry = {.count = 1, .reusable = true}}, SHIFT(103),
+  [312] = {.entry = {.count = 1, .reusable = false}}, SHIFT(94),
+  [314] = {.entry = {.count = 1, .reusable = true}}, SHIFT(94),
+  [316] = {.entry = {.count = 1, .reusable = false}}, SHIFT(89),
+  [318] = {.entry = {.count = 1, .reusable = true}}, SHIFT(89),
+  [320] = {.entry = {.count = 1, .reusable = false}}, SHIFT(100),
+  [322] = {.entry = {.count = 1, .reusable = true}}, SHIFT(100),
+  [324] = {.entry = {.count = 1, .reusable = false}}, SHIFT(101),
+  [326] = {.entry = {.count = 1, .reusable = true}}, SHIFT(101),
+  [328] = {.entry = {.count = 1, .reusable = false}}, SHIFT(102),
+  [330] = {.entry = {.count = 1, .reusable = true}}, SHIFT(102),
+  [332] = {.entry = {.count = 1, .reusable = false}}, SHIFT(90),
+  [334] = {.entry = {.count = 1, .reusable = true}}, SHIFT(90),
+  [336] = {.entry = {.count = 1, .reusable = false}}, SHIFT(78),
+  [338] = {.entry = {.count = 1, .reusable = true}}, SHIFT(78),
+  [340] = {.entry = {.count = 1, .reusable = true}}, SHIFT(111),
+  [342] = {.entry = {.count = 1, .reusable = true}}, SHIFT(112),
+  [344] = {.entry = {.count = 1, .reusable = true}}, SHIFT(129),
+  [346] = {.entry = {.count = 1, .reusable = true}}, SHIFT(117),
+  [348] = {.entry = {.count = 1, .reusable = true}}, SHIFT(161),
+  [350] = {.entry = {.count = 1, .reusable = true}}, SHIFT(124),
+  [352] = {.entry = {.count = 1, .reusable = true}}, SHIFT(121),
+  [354] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym__type, 1, 0, 0),
+  [356] = {.entry = {.count = 1, .reusable = true}}, SHIFT(115),
+  [358] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym__type, 1, 0, 0),
+  [360] = {.entry = {.count = 1, .reusable = true}}, SHIFT(114),
+  [362] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_tuple_type, 2, 0, 20),
+  [364] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_tuple_type, 2, 0, 20),
+  [366] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym__simple_type, 3, 0, 0),
+  [368] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym__simple_type, 3, 0, 0),
+  [370] = {.entry = {.count = 1, .reusable = true}}, REDUCE(aux_sym_tuple_type_repeat1, 2, 0, 14),
+  [372] = {.entry = {.count = 2, .reusable = true}}, REDUCE(aux_sym_tuple_type_repeat1, 2, 0, 14), SHIFT_REPEAT(115),
+  [375] = {.entry = {.count = 1, .reusable = false}}, REDUCE(aux_sym_tuple_type_repeat1, 2, 0, 14),
+  [377] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_clsabs_type, 4, 0, 27),
+  [379] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_clsabs_type, 4, 0, 27),
+  [381] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_array_type, 4, 0, 28),
+  [383] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_array_type, 4, 0, 28),
+  [385] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_code_type, 5, 0, 31),
+  [387] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_code_type, 5, 0, 31),
+  [389] = {.entry = {.count = 1, .reusable = true}}, REDUCE(aux_sym_tuple_type_repeat1, 2, 0, 5),
+  [391] = {.entry = {.count = 1, .reusable = false}}, REDUCE(aux_sym_tuple_type_repeat1, 2, 0, 5),
+  [393] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_param, 1, 0, 1),
+  [395] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_func_type, 3, 0, 24),
+  [397] = {.entry = {.count = 1, .reusable = false}}, REDUCE(sym_func_type, 3, 0, 24),
+  [399] = {.entry = {.count = 1, .reusable = false}}, SHIFT(125),
+  [401] = {.entry = {.count = 1, .reusable = false}}, SHIFT(134),
+  [403] = {.entry = {.count = 1, .reusable = false}}, SHIFT(147),
+  [405] = {.entry = {.count = 1, .reusable = true}}, SHIFT(99),
+  [407] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_param, 3, 0, 11),
+  [409] = {.entry = {.count = 1, .reusable = true}}, SHIFT(143),
+  [411] = {.entry = {.count = 1, .reusable = true}}, REDUCE(aux_sym_array_repeat1, 2, 0, 14),
+  [413] = {.entry = {.count = 2, .reusable = true}}, REDUCE(aux_sym_array_repeat1, 2, 0, 14), SHIFT_REPEAT(22),
+  [416] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_params, 1, 0, 0),
+  [418] = {.entry = {.count = 1, .reusable = true}}, SHIFT(148),
+  [420] = {.entry = {.count = 1, .reusable = false}}, SHIFT(150),
+  [422] = {.entry = {.count = 1, .reusable = true}}, SHIFT(97),
+  [424] = {.entry = {.count = 1, .reusable = true}}, SHIFT(71),
+  [426] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_params, 2, 0, 0),
+  [428] = {.entry = {.count = 1, .reusable = true}}, SHIFT(73),
+  [430] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_param, 3, 0, 12),
+  [432] = {.entry = {.count = 1, .reusable = true}}, REDUCE(aux_sym_params_repeat1, 2, 0, 0),
+  [434] = {.entry = {.count = 2, .reusable = true}}, REDUCE(aux_sym_params_repeat1, 2, 0, 0), SHIFT_REPEAT(148),
+  [437] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_param, 5, 0, 23),
+  [439] = {.entry = {.count = 1, .reusable = true}}, SHIFT(7),
+  [441] = {.entry = {.count = 1, .reusable = true}}, SHIFT(154),
+  [443] = {.entry = {.count = 1, .reusable = true}}, SHIFT(125),
+  [445] = {.entry = {.count = 1, .reusable = true}}, SHIFT(113),
+  [447] = {.entry = {.count = 1, .reusable = true}}, SHIFT(162),
+  [449] = {.entry = {.count = 1, .reusable = true}},  ACCEPT_INPUT(),
+  [451] = {.entry = {.count = 1, .reusable = true}}, SHIFT(149),
+  [453] = {.entry = {.count = 1, .reusable = true}}, SHIFT(25),
+  [455] = {.entry = {.count = 1, .reusable = true}}, SHIFT(26),
+  [457] = {.entry = {.count = 1, .reusable = true}}, SHIFT(109),
+  [459] = {.entry = {.count = 1, .reusable = true}}, SHIFT(140),
+  [461] = {.entry = {.count = 1, .reusable = true}}, SHIFT(70),
+  [463] = {.entry = {.count = 1, .reusable = true}}, SHIFT(27),
+  [465] = {.entry = {.count = 1, .reusable = true}}, SHIFT(28),
+  [467] = {.entry = {.count = 1, .reusable = true}}, SHIFT(168),
+  [469] = {.entry = {.count = 1, .reusable = true}}, SHIFT(29),
+  [471] = {.entry = {.count = 1, .reusable = true}}, SHIFT(31),
+  [473] = {.entry = {.count = 1, .reusable = true}}, REDUCE(sym_clsparam, 3, 0, 18),
+  [475] = {.entry = {.count = 1, .reusable = true}}, SHIFT(119),
+  [477] = {.entry = {.count = 1, .reusable = true}}, SHIFT(144),
+  [479] = {.entry = {.count = 1, .reusable = true}}, SHIFT(116),
+  [481] = {.entry = {.count = 1, .reusable = true}}, SHIFT(170),
+  [483] = {.entry = {.count = 1, .reusable = true}}, SHIFT(171),
+  [485] = {.entry = {.count = 1, .reusable = true}}, SHIFT(122),
+  [487] = {.entry = {.count = 1, .reusable = true}}, SHIFT(35),
+  [489] = {.entry = {.count = 1, .reusable = true}}, SHIFT(123),
 };
 
 #ifdef __cplusplus
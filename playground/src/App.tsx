@@ -1,14 +1,19 @@
 import { useEffect, useState } from 'react';
-import { Parser, Language } from 'web-tree-sitter';
+import { Parser } from 'web-tree-sitter';
 import { OnChange, useMonaco } from '@monaco-editor/react';
 
 import { EditorContainer } from './ui/EditorContainer';
-import { Grid, SelectChangeEvent } from '@mui/material';
+import { Alert, Grid, SelectChangeEvent } from '@mui/material';
 import { EvaluatorContainer } from './ui/EvaluatorContainer';
 import { Example, ExamplePrograms } from './examples';
+import { loadParser, StartupPhase } from './startup';
+import { loadNativeEngine, NativeEngine } from './nativeEngine';
 
 const App: React.FC = () => {
   const [treeSitterParser, setTreeSitterParser] = useState<Parser | null>(null);
+  const [startupPhases, setStartupPhases] = useState<StartupPhase[]>([]);
+  const [startupError, setStartupError] = useState<string | null>(null);
+  const [nativeEngine, setNativeEngine] = useState<NativeEngine | undefined>(undefined);
   const [code, setCode] = useState(ExamplePrograms.spower);
   const [example, setExample] = useState<Example>("spower");
 
@@ -29,16 +34,16 @@ const App: React.FC = () => {
 
   useEffect(() => {
     (async () => {
-      await Parser.init({
-        // eslint-disable-next-line @typescript-eslint/no-unused-vars
-        locateFile(scriptName: string, _scriptDirectory: string) {
-          return import.meta.env.BASE_URL + scriptName;
-        },
-      });
-      const parser = new Parser();
-      const Lang = await Language.load(import.meta.env.BASE_URL + 'tree-sitter-lamgamma_parser.wasm');
-      parser.setLanguage(Lang);
-      setTreeSitterParser(parser);
+      try {
+        const { parser, phases } = await loadParser(import.meta.env.BASE_URL, ExamplePrograms.spower);
+        setTreeSitterParser(parser);
+        setStartupPhases(phases);
+      } catch (e) {
+        setStartupError(`Cannot load the parser: ${e}`);
+        return;
+      }
+      // Optional, so it does not hold up the interpreter.
+      setNativeEngine(await loadNativeEngine(import.meta.env.BASE_URL));
     })();
   }, []);
 
@@ -79,7 +84,10 @@ const App: React.FC = () => {
           <EvaluatorContainer
             code={code}
             treeSitterParser={treeSitterParser}
-          /> : null
+            startupPhases={startupPhases}
+            nativeEngine={nativeEngine}
+          /> : startupError ?
+            <Alert severity="error">{startupError}</Alert> : null
       }
     </Grid>
   </Grid >;
@@ -0,0 +1,305 @@
+// Smart constructors for the code evaluateFuture assembles. When enabled,
+// each node is simplified as it is built: constants are folded, algebraic
+// identities applied and administrative redexes reduced. When disabled they
+// build the node verbatim.
+//
+// Simplification never changes what the code evaluates to, errors included:
+// divisions by a literal zero are left for run time to report ZeroDivision,
+// and identities that assume operand types are applied only to the
+// specialized operations of typed code. A subtree containing staging
+// constructs is never discarded, because its splices run when the enclosing
+// quote is evaluated, whichever branch the code later takes.
+
+let enabled = ref(false)
+
+@genType
+let setEnabled = (b: bool): unit => enabled := b
+
+open RawExpr
+
+let rec hasStaging = (e: t): bool =>
+  switch e {
+  | Var(_) | IntLit(_) | BoolLit(_) | CsValue(_) => false
+  | Quote(_) | Splice(_) => true
+  | Func({body}) => hasStaging(body)
+  | App({func: left, arg: right})
+  | BinOp({left, right})
+  | ShortCircuitOp({left, right})
+  | PrimOp({left, right})
+  | Let({expr: left, body: right})
+  | LetCs({expr: left, body: right})
+  | LetRec({expr: left, body: right}) =>
+    hasStaging(left) || hasStaging(right)
+  | UniOp({expr}) | PrimNot({expr}) | GenLet({expr}) => hasStaging(expr)
+  | ArrayOp({args}) | Tuple(args) => args->Belt.List.some(hasStaging)
+  | Proj({tuple}) => hasStaging(tuple)
+  | If({cond, thenBranch, elseBranch}) =>
+    hasStaging(cond) || hasStaging(thenBranch) || hasStaging(elseBranch)
+  }
+
+let rec occurs = (x: Var.t, e: t): bool =>
+  switch e {
+  | Var(v) => v == x
+  | IntLit(_) | BoolLit(_) | CsValue(_) => false
+  | Func({params, body}) => !(params->Belt.List.has(x, (a, b) => a == b)) && occurs(x, body)
+  | App({func: left, arg: right})
+  | BinOp({left, right})
+  | ShortCircuitOp({left, right})
+  | PrimOp({left, right}) =>
+    occurs(x, left) || occurs(x, right)
+  | Let({param, expr, body}) | LetCs({param, expr, body}) =>
+    occurs(x, expr) || (param != x && occurs(x, body))
+  | LetRec({param, expr, body}) => param != x && (occurs(x, expr) || occurs(x, body))
+  | UniOp({expr}) | PrimNot({expr}) | GenLet({expr}) | Quote({expr}) | Splice({expr}) =>
+    occurs(x, expr)
+  | ArrayOp({args}) | Tuple(args) => args->Belt.List.some(arg => occurs(x, arg))
+  | Proj({tuple}) => occurs(x, tuple)
+  | If({cond, thenBranch, elseBranch}) =>
+    occurs(x, cond) || occurs(x, thenBranch) || occurs(x, elseBranch)
+  }
+
+let foldInt = (op: Operator.PrimOp.t, l: int, r: int): option<t> => {
+  open Operator.PrimOp
+  switch op {
+  | IntAdd => Some(IntLit(l + r))
+  | IntSub => Some(IntLit(l - r))
+  | IntMul => Some(IntLit(l * r))
+  | IntDiv | IntMod if r == 0 => None
+  | IntDiv => Some(IntLit(l / r))
+  | IntMod => Some(IntLit(Int.mod(l, r)))
+  | IntEq => Some(BoolLit(l == r))
+  | IntNe => Some(BoolLit(l != r))
+  | IntLt => Some(BoolLit(l < r))
+  | IntLe => Some(BoolLit(l <= r))
+  | IntGt => Some(BoolLit(l > r))
+  | IntGe => Some(BoolLit(l >= r))
+  | BoolEq | BoolNe | BoolAnd | BoolOr => None
+  }
+}
+
+let foldBool = (op: Operator.PrimOp.t, l: bool, r: bool): option<t> => {
+  open Operator.PrimOp
+  switch op {
+  | BoolEq => Some(BoolLit(l == r))
+  | BoolNe => Some(BoolLit(l != r))
+  | BoolAnd => Some(BoolLit(l && r))
+  | BoolOr => Some(BoolLit(l || r))
+  | _ => None
+  }
+}
+
+// The operation a BinOp performs on operands of matching literal types.
+let primOfBinOp = (op: Operator.BinOp.t, left: t): option<Operator.PrimOp.t> =>
+  switch left {
+  | IntLit(_) => Expr.specializeBinOp(op, Some(Typ.Int))
+  | BoolLit(_) => Expr.specializeBinOp(op, Some(Typ.Bool))
+  | _ => None
+  }
+
+let fold = (op: Operator.PrimOp.t, left: t, right: t): option<t> =>
+  switch (left, right) {
+  | (IntLit(l), IntLit(r)) => foldInt(op, l, r)
+  | (BoolLit(l), BoolLit(r)) => foldBool(op, l, r)
+  | _ => None
+  }
+
+let binOp = (op: Operator.BinOp.t, left: t, right: t): t => {
+  let folded = if enabled.contents {
+    primOfBinOp(op, left)->Option.flatMap(prim => fold(prim, left, right))
+  } else {
+    None
+  }
+  folded->Option.getOr(BinOp({op, left, right}))
+}
+
+let shortCircuitOp = (op: Operator.ShortCircuitOp.t, left: t, right: t): t =>
+  switch (enabled.contents, op, left) {
+  | (true, Operator.ShortCircuitOp.And, BoolLit(false)) if !hasStaging(right) => left
+  | (true, Operator.ShortCircuitOp.Or, BoolLit(true)) if !hasStaging(right) => left
+  | (true, Operator.ShortCircuitOp.And, BoolLit(true))
+  | (true, Operator.ShortCircuitOp.Or, BoolLit(false)) =>
+    switch right {
+    | BoolLit(_) => right
+    | _ => ShortCircuitOp({op, left, right})
+    }
+  | _ => ShortCircuitOp({op, left, right})
+  }
+
+let uniOp = (op: Operator.UniOp.t, expr: t): t =>
+  switch (enabled.contents, op, expr) {
+  | (true, Operator.UniOp.Not, BoolLit(b)) => BoolLit(!b)
+  | _ => UniOp({op, expr})
+  }
+
+let primOp = (op: Operator.PrimOp.t, left: t, right: t): t =>
+  if !enabled.contents {
+    PrimOp({op, left, right})
+  } else {
+    switch fold(op, left, right) {
+    | Some(folded) => folded
+    | None => {
+        open Operator.PrimOp
+        switch (op, left, right) {
+        | (IntAdd, IntLit(0), e) | (IntAdd, e, IntLit(0)) | (IntSub, e, IntLit(0)) => e
+        | (IntMul, IntLit(1), e) | (IntMul, e, IntLit(1)) | (IntDiv, e, IntLit(1)) => e
+        | (IntMul, IntLit(0), Var(_)) | (IntMul, Var(_), IntLit(0)) => IntLit(0)
+        | (BoolAnd, BoolLit(true), e) | (BoolAnd, e, BoolLit(true)) => e
+        | (BoolOr, BoolLit(false), e) | (BoolOr, e, BoolLit(false)) => e
+        | (BoolAnd, BoolLit(false), e) | (BoolOr, BoolLit(true), e) if !hasStaging(e) => left
+        | (BoolEq, BoolLit(true), e) | (BoolEq, e, BoolLit(true)) => e
+        | (BoolNe, BoolLit(false), e) | (BoolNe, e, BoolLit(false)) => e
+        | _ => PrimOp({op, left, right})
+        }
+      }
+    }
+  }
+
+let primNot = (expr: t): t =>
+  switch (enabled.contents, expr) {
+  | (true, BoolLit(b)) => BoolLit(!b)
+  | (true, PrimNot({expr})) => expr
+  | _ => PrimNot({expr: expr})
+  }
+
+let if_ = (cond: t, thenBranch: t, elseBranch: t): t =>
+  switch (enabled.contents, cond) {
+  | (true, BoolLit(true)) if !hasStaging(elseBranch) => thenBranch
+  | (true, BoolLit(false)) if !hasStaging(thenBranch) => elseBranch
+  | (true, PrimNot({expr})) => If({cond: expr, thenBranch: elseBranch, elseBranch: thenBranch})
+  | _ => If({cond, thenBranch, elseBranch})
+  }
+
+// The elements of an array literal of int literals.
+let intElems = (e: t): option<array<int>> =>
+  switch e {
+  | ArrayOp({op: Operator.ArrayOp.Make, args}) =>
+    let elems = args->Belt.List.toArray->Array.filterMap(arg =>
+      switch arg {
+      | IntLit(i) => Some(i)
+      | _ => None
+      }
+    )
+    Array.length(elems) == Belt.List.length(args) ? Some(elems) : None
+  | _ => None
+  }
+
+// Out-of-bounds indices are left for run time to report.
+let arrayOp = (op: Operator.ArrayOp.t, args: list<t>): t => {
+  let folded = switch (enabled.contents, op, args) {
+  | (true, Operator.ArrayOp.Length, list{array}) =>
+    intElems(array)->Option.map(elems => IntLit(Array.length(elems)))
+  | (true, Operator.ArrayOp.Get, list{array, IntLit(i)}) =>
+    intElems(array)->Option.flatMap(elems => elems->Array.get(i))->Option.map(x => IntLit(x))
+  | _ => None
+  }
+  folded->Option.getOr(ArrayOp({op, args}))
+}
+
+// Projecting from a tuple literal gives the element when the others are
+// atoms, which cannot fail, so that dropping them changes nothing.
+let proj = (tuple: t, index: int): t => {
+  let isAtom = (e: t) =>
+    switch e {
+    | Var(_) | IntLit(_) | BoolLit(_) | CsValue(_) => true
+    | _ => false
+    }
+  switch (enabled.contents, tuple) {
+  | (true, Tuple(elements))
+    if elements
+    ->Belt.List.toArray
+    ->Array.everyWithIndex((element, i) => i == index || isAtom(element)) =>
+    elements->Belt.List.get(index)->Option.getOr(Proj({tuple, index}))
+  | _ => Proj({tuple, index})
+  }
+}
+
+// Substitutes the value v for x in e, rebuilding with the smart constructors
+// so that the substitution exposes further simplifications. None when that
+// would capture a variable or reach into staging constructs.
+let rec subst = (x: Var.t, v: t, e: t): option<t> => {
+  let captures = (binder: Var.t) =>
+    switch v {
+    | Var(w) => w == binder
+    | _ => false
+    }
+  let substUnder = (binders: list<Var.t>, body: t): option<t> =>
+    if binders->Belt.List.has(x, (a, b) => a == b) {
+      Some(body)
+    } else if binders->Belt.List.some(captures) && occurs(x, body) {
+      None
+    } else {
+      subst(x, v, body)
+    }
+  let both = (left, right, make) =>
+    subst(x, v, left)->Option.flatMap(left1 =>
+      subst(x, v, right)->Option.map(right1 => make(left1, right1))
+    )
+
+  switch e {
+  | Var(y) => Some(y == x ? v : e)
+  | IntLit(_) | BoolLit(_) | CsValue(_) => Some(e)
+  | Quote(_) | Splice(_) => None
+  | Func({params, body}) =>
+    substUnder(params, body)->Option.map(body1 => Func({params, body: body1}))
+  | App({func, arg}) => both(func, arg, app)
+  | BinOp({op, left, right}) => both(left, right, binOp(op, ...))
+  | ShortCircuitOp({op, left, right}) => both(left, right, shortCircuitOp(op, ...))
+  | PrimOp({op, left, right}) => both(left, right, primOp(op, ...))
+  | UniOp({op, expr}) => subst(x, v, expr)->Option.map(uniOp(op, ...))
+  | PrimNot({expr}) => subst(x, v, expr)->Option.map(primNot)
+  | GenLet({expr}) => subst(x, v, expr)->Option.map(expr1 => GenLet({expr: expr1}))
+  | ArrayOp({op, args}) =>
+    args
+    ->Belt.List.reduceReverse(Some(list{}), (acc, arg) =>
+      acc->Option.flatMap(args1 => subst(x, v, arg)->Option.map(arg1 => list{arg1, ...args1}))
+    )
+    ->Option.map(args1 => arrayOp(op, args1))
+  | Tuple(elements) =>
+    elements
+    ->Belt.List.reduceReverse(Some(list{}), (acc, element) =>
+      acc->Option.flatMap(elements1 =>
+        subst(x, v, element)->Option.map(element1 => list{element1, ...elements1})
+      )
+    )
+    ->Option.map(elements1 => Tuple(elements1))
+  | Proj({tuple, index}) => subst(x, v, tuple)->Option.map(tuple1 => proj(tuple1, index))
+  | If({cond, thenBranch, elseBranch}) =>
+    subst(x, v, cond)->Option.flatMap(cond1 =>
+      both(thenBranch, elseBranch, (then1, else1) => if_(cond1, then1, else1))
+    )
+  | Let({param, expr, body}) =>
+    subst(x, v, expr)->Option.flatMap(expr1 =>
+      substUnder(list{param}, body)->Option.map(body1 => let_(param, expr1, body1))
+    )
+  | LetCs({param, expr, body}) =>
+    subst(x, v, expr)->Option.flatMap(expr1 =>
+      substUnder(list{param}, body)->Option.map(body1 => LetCs({param, expr: expr1, body: body1}))
+    )
+  | LetRec({param, expr, body, memo}) =>
+    substUnder(list{param}, expr)->Option.flatMap(expr1 =>
+      substUnder(list{param}, body)->Option.map(body1 =>
+        LetRec({param, expr: expr1, body: body1, memo})
+      )
+    )
+  }
+}
+and let_ = (param: Var.t, expr: t, body: t): t => {
+  let reduced = if !enabled.contents {
+    None
+  } else {
+    switch (expr, body) {
+    | (_, Var(y)) if y == param => Some(expr)
+    | (IntLit(_) | BoolLit(_), _) => subst(param, expr, body)
+    | (Var(_), _) if occurs(param, body) => subst(param, expr, body)
+    | _ => None
+    }
+  }
+  reduced->Option.getOr(Let({param, expr, body}))
+}
+and app = (func: t, arg: t): t =>
+  switch (enabled.contents, func) {
+  | (true, Func({params: list{param}, body})) => let_(param, arg, body)
+  | (true, Func({params: list{param, ...rest}, body})) =>
+    let_(param, arg, Func({params: rest, body}))
+  | _ => App({func, arg})
+  }
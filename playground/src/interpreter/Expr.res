@@ -26,7 +26,8 @@ and raw_t =
   | Func({params: list<Param.t>, returnType: option<Typ.t>, body: t})
   | App({func: t, arg: t})
   | Let({param: Param.t, expr: t, body: t})
-  | LetRec({param: Param.t, expr: t, body: t})
+  // memo: results are cached by argument (let rec memo)
+  | LetRec({param: Param.t, expr: t, body: t, memo: bool})
   // // primitive operations
   | IntLit(int)
   | BoolLit(bool)
@@ -34,57 +35,133 @@ and raw_t =
   | ShortCircuitOp({op: Operator.ShortCircuitOp.t, left: t, right: t})
   | UniOp({op: Operator.UniOp.t, expr: t})
   | If({cond: t, thenBranch: t, elseBranch: t})
+  // arrays of ints; args in the order of Operator.ArrayOp
+  | ArrayOp({op: Operator.ArrayOp.t, args: list<t>})
+  // unboxed tuples of two or more elements, and their projections from 0
+  | Tuple(list<t>)
+  | Proj({tuple: t, index: int})
   // staging constructs
   | Quote({cls: option<Classifier.t>, expr: t})
   | Splice({shift: int, expr: t})
-// | LetCs({ param: Param.t, expr: t, body: t })
+  // binds the code of expr to a fresh variable at the nearest let-insertion
+  // point of the code being generated (see Interpreter.LetInsertion)
+  | GenLet({expr: t})
+  // a let whose variable persists into later stages
+  | LetCs({param: Param.t, expr: t, body: t})
 // | LetRecCs({ param: Param.t, expr: t, body: t })
 // | Serialize(t)
    | ClsAbs({ cls: Classifier.t, base: Classifier.t, body: t })
    | ClsApp({ func: t, arg: Classifier.t })
 
-@genType
-let rec stripTypeInfo = (expr: t): RawExpr.t => {
+// The specialization of op for operands of type operandType, if there is
+// one. Equality is specialized only for Int and Bool operands; on other types
+// it keeps failing at run time as before.
+let specializeBinOp = (op: Operator.BinOp.t, operandType: option<Typ.t>): option<
+  Operator.PrimOp.t,
+> => {
+  open Operator
+  switch (op, operandType) {
+  | (BinOp.Add, _) => Some(PrimOp.IntAdd)
+  | (BinOp.Sub, _) => Some(PrimOp.IntSub)
+  | (BinOp.Mul, _) => Some(PrimOp.IntMul)
+  | (BinOp.Div, _) => Some(PrimOp.IntDiv)
+  | (BinOp.Mod, _) => Some(PrimOp.IntMod)
+  | (BinOp.Lt, _) => Some(PrimOp.IntLt)
+  | (BinOp.Le, _) => Some(PrimOp.IntLe)
+  | (BinOp.Gt, _) => Some(PrimOp.IntGt)
+  | (BinOp.Ge, _) => Some(PrimOp.IntGe)
+  | (BinOp.Eq, Some(Typ.Int)) => Some(PrimOp.IntEq)
+  | (BinOp.Ne, Some(Typ.Int)) => Some(PrimOp.IntNe)
+  | (BinOp.Eq, Some(Typ.Bool)) => Some(PrimOp.BoolEq)
+  | (BinOp.Ne, Some(Typ.Bool)) => Some(PrimOp.BoolNe)
+  | (BinOp.Eq | BinOp.Ne, _) => None
+  }
+}
+
+// typeOf is None when erasing types without specializing.
+let rec lower = (expr: t, typeOf: option<t => option<Typ.t>>): RawExpr.t => {
   switch expr.raw {
   | IntLit(i) => RawExpr.IntLit(i)
   | BoolLit(b) => RawExpr.BoolLit(b)
   | BinOp({op, left, right}) =>
-    RawExpr.BinOp({op, left: stripTypeInfo(left), right: stripTypeInfo(right)})
+    let left1 = lower(left, typeOf)
+    let right1 = lower(right, typeOf)
+    switch typeOf->Option.flatMap(typeOf => specializeBinOp(op, typeOf(left))) {
+    | Some(prim) => RawExpr.PrimOp({op: prim, left: left1, right: right1})
+    | None => RawExpr.BinOp({op, left: left1, right: right1})
+    }
   | ShortCircuitOp({op, left, right}) =>
-    RawExpr.ShortCircuitOp({op, left: stripTypeInfo(left), right: stripTypeInfo(right)})
-  | UniOp({op, expr}) => RawExpr.UniOp({op, expr: stripTypeInfo(expr)})
+    let left1 = lower(left, typeOf)
+    let right1 = lower(right, typeOf)
+    switch (typeOf, op) {
+    | (Some(_), Operator.ShortCircuitOp.And) =>
+      RawExpr.PrimOp({op: Operator.PrimOp.BoolAnd, left: left1, right: right1})
+    | (Some(_), Operator.ShortCircuitOp.Or) =>
+      RawExpr.PrimOp({op: Operator.PrimOp.BoolOr, left: left1, right: right1})
+    | (None, _) => RawExpr.ShortCircuitOp({op, left: left1, right: right1})
+    }
+  | UniOp({op, expr}) =>
+    switch (typeOf, op) {
+    | (Some(_), Operator.UniOp.Not) => RawExpr.PrimNot({expr: lower(expr, typeOf)})
+    | (None, _) => RawExpr.UniOp({op, expr: lower(expr, typeOf)})
+    }
   | If({cond, thenBranch, elseBranch}) =>
     RawExpr.If({
-      cond: stripTypeInfo(cond),
-      thenBranch: stripTypeInfo(thenBranch),
-      elseBranch: stripTypeInfo(elseBranch),
+      cond: lower(cond, typeOf),
+      thenBranch: lower(thenBranch, typeOf),
+      elseBranch: lower(elseBranch, typeOf),
     })
+  | ArrayOp({op, args}) =>
+    RawExpr.ArrayOp({op, args: args->Belt.List.map(arg => lower(arg, typeOf))})
+  | Tuple(elements) => RawExpr.Tuple(elements->Belt.List.map(element => lower(element, typeOf)))
+  | Proj({tuple, index}) => RawExpr.Proj({tuple: lower(tuple, typeOf), index})
   | Var(v) => RawExpr.Var(v)
   | Let({param, expr, body}) =>
     RawExpr.Let({
       param: param.var,
-      expr: stripTypeInfo(expr),
-      body: stripTypeInfo(body),
+      expr: lower(expr, typeOf),
+      body: lower(body, typeOf),
     })
-  | LetRec({param, expr, body}) =>
+  | LetRec({param, expr, body, memo}) =>
     RawExpr.LetRec({
       param: param.var,
-      expr: stripTypeInfo(expr),
-      body: stripTypeInfo(body),
+      expr: lower(expr, typeOf),
+      body: lower(body, typeOf),
+      memo,
+    })
+  | LetCs({param, expr, body}) =>
+    RawExpr.LetCs({
+      param: param.var,
+      expr: lower(expr, typeOf),
+      body: lower(body, typeOf),
     })
   | Func({params, body, returnType: _}) =>
     RawExpr.Func({
       params: params->Belt.List.map(p => p.var),
-      body: stripTypeInfo(body),
+      body: lower(body, typeOf),
     })
   | App({func, arg}) =>
     RawExpr.App({
-      func: stripTypeInfo(func),
-      arg: stripTypeInfo(arg),
+      func: lower(func, typeOf),
+      arg: lower(arg, typeOf),
     })
-  | Quote({cls: _, expr}) => RawExpr.Quote({expr: stripTypeInfo(expr)})
-  | Splice({shift, expr}) => RawExpr.Splice({shift, expr: stripTypeInfo(expr)})
-  | ClsAbs({cls: _, base: _, body}) => stripTypeInfo(body)
-  | ClsApp({func, arg: _}) => stripTypeInfo(func)
+  | Quote({cls: _, expr}) => RawExpr.Quote({expr: lower(expr, typeOf)})
+  | Splice({shift, expr}) => RawExpr.Splice({shift, expr: lower(expr, typeOf)})
+  | GenLet({expr}) => RawExpr.GenLet({expr: lower(expr, typeOf)})
+  | ClsAbs({cls: _, base: _, body}) => lower(body, typeOf)
+  | ClsApp({func, arg: _}) => lower(func, typeOf)
   }
 }
+
+@genType
+let stripTypeInfo = (expr: t): RawExpr.t => lower(expr, None)
+
+/**
+ Erases types like stripTypeInfo, but replaces primitive operations by the
+ specializations in Operator.PrimOp, chosen using the types the checker
+ inferred (see TypeChecker.typeCheckKeepingTypes), so expr must have passed
+ the type checker. The evaluator dispatches on the operation alone instead
+ of on the operator and the kinds of its operands.
+ */
+@genType
+let toTypedRaw = (expr: t, typeOf: t => option<Typ.t>): RawExpr.t => lower(expr, Some(typeOf))
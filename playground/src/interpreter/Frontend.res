@@ -18,28 +18,93 @@ type evalError =
   | ParseError(SyntaxNodeParser.ParseError.t)
   | EvalError(Interpreter.evalError)
 
-@genType
-let evaluate = (_input: string, _treeSitterParser: 'a): string => {
-  let doit = (): result<Interpreter.RuntimeVal.t, evalError> => {
-    let syntaxNode: SyntaxNodeParser.syntaxNode = %raw(` _treeSitterParser.parse(_input).rootNode `)
-    let venv = Interpreter.Env.make()
-    let nenv = Interpreter.Env.make()
-
-    SyntaxNodeParser.parseSourceFileNode(syntaxNode)
-    ->Result.mapError(x => ParseError(x))
-    ->Result.map(Expr.stripTypeInfo)
-    ->Result.flatMap(expr =>
-      Interpreter.evaluateRuntime(expr, venv, nenv)->Result.mapError(x => EvalError(x))
-    )
+let parse = (_input: string, _treeSitterParser: 'a): result<
+  Expr.t,
+  SyntaxNodeParser.ParseError.t,
+> => {
+  let syntaxNode: SyntaxNodeParser.syntaxNode = %raw(` _treeSitterParser.parse(_input).rootNode `)
+
+  SyntaxNodeParser.parseSourceFileNode(syntaxNode)
+}
+
+type typing = result<(Typ.t, Expr.t => option<Typ.t>), TypeChecker.TypeError.t>
+
+// A program with the outcome of its type check; typing is None when the
+// checker raised.
+type checked = {
+  source: string,
+  expr: Expr.t,
+  typing: option<typing>,
+}
+
+// The last program checked, which is the one in the editor. Running it
+// reuses its typing instead of checking the program again.
+let lastChecked: ref<option<checked>> = ref(None)
+
+let check = (input: string, treeSitterParser: 'a): result<checked, SyntaxNodeParser.ParseError.t> =>
+  switch lastChecked.contents {
+  | Some(checked) if checked.source == input => Ok(checked)
+  | _ =>
+    parse(input, treeSitterParser)->Result.map(expr => {
+      let typing = switch TypeChecker.typeCheckKeepingTypes(expr, TypeChecker.GlobalEnv.make()) {
+      | typing => Some(typing)
+      | exception _ => None
+      }
+      let checked = {source: input, expr, typing}
+      lastChecked := Some(checked)
+      checked
+    })
   }
 
-  switch doit() {
-  | Ok(value) => value->Interpreter.RuntimeVal.toString
+// Well-typed programs run in typed mode, with primitive operations
+// specialized by the checker's types. Other programs only have their types
+// erased, as before, and ill-typed operations fail at run time.
+let lowerForEvaluation = ({expr, typing}: checked): RawExpr.t => {
+  switch typing {
+  | Some(Ok((_, typeOf))) => Expr.toTypedRaw(expr, typeOf)
+  | Some(Error(_)) | None => Expr.stripTypeInfo(expr)
+  }
+}
+
+// Results are laid out for the output pane; beyond the limit, printing is
+// cut short so a runaway specialization cannot stall the page.
+let outputOptions: Printer.options = {width: 80, limit: Some(1_000_000)}
+
+let evaluateValue = (_input: string, _treeSitterParser: 'a): result<
+  Interpreter.RuntimeVal.t,
+  evalError,
+> => {
+  let venv = Interpreter.Env.make()
+  let nenv = Interpreter.Env.make()
+
+  check(_input, _treeSitterParser)
+  ->Result.mapError(x => ParseError(x))
+  ->Result.map(lowerForEvaluation)
+  ->Result.map(Optimizer.optimize)
+  ->Result.flatMap(expr =>
+    Interpreter.evaluateRuntime(expr, venv, nenv)->Result.mapError(x => EvalError(x))
+  )
+}
+
+@genType
+let evaluate = (_input: string, _treeSitterParser: 'a): string => {
+  switch evaluateValue(_input, _treeSitterParser) {
+  | Ok(value) => value->Printer.valueToString(outputOptions)
   | Error(_) => "error"
   | exception _ => "error"
   }
 }
 
+// Like evaluate, but streams the printed result to out as it is produced.
+@genType
+let evaluateTo = (_input: string, _treeSitterParser: 'a, out: string => unit): unit => {
+  switch evaluateValue(_input, _treeSitterParser) {
+  | Ok(value) => value->Printer.printValue(out, outputOptions)
+  | Error(_) => out("error")
+  | exception _ => out("error")
+  }
+}
+
 module TypeError = {
   type t =
     | ParseError(SyntaxNodeParser.ParseError.t)
@@ -89,30 +154,31 @@ module TypeError = {
     }
 }
 
-let parse = (_input: string, _treeSitterParser: 'a): result<
-  Expr.t,
-  SyntaxNodeParser.ParseError.t,
-> => {
+@genType
+let typeCheck = (_input: string, _treeSitterParser: 'a): string => {
+  switch check(_input, _treeSitterParser) {
+  | Ok({typing: Some(Ok((typ, _)))}) => typ->Typ.toString
+  | Ok({typing: Some(Error(e))}) => TypeError.toString(TypeError.TypeError(e))
+  | Ok({typing: None}) => "error"
+  | Error(e) => TypeError.toString(TypeError.ParseError(e))
+  | exception e =>
+    Console.log(e)
+    "error"
+  }
+}
+
+let eraseTypes = (_input: string, _treeSitterParser: 'a): result<RawExpr.t, TypeError.t> => {
   let syntaxNode: SyntaxNodeParser.syntaxNode = %raw(` _treeSitterParser.parse(_input).rootNode `)
 
   SyntaxNodeParser.parseSourceFileNode(syntaxNode)
+  ->Result.mapError(x => TypeError.ParseError(x))
+  ->Result.map(Expr.stripTypeInfo)
 }
 
 @genType
-let typeCheck = (_input: string, _treeSitterParser: 'a): string => {
-  let doit = (): result<Typ.t, TypeError.t> => {
-    let syntaxNode: SyntaxNodeParser.syntaxNode = %raw(` _treeSitterParser.parse(_input).rootNode `)
-
-    SyntaxNodeParser.parseSourceFileNode(syntaxNode)
-    ->Result.mapError(x => TypeError.ParseError(x))
-    ->Result.flatMap(expr => {
-      let env = TypeChecker.GlobalEnv.make()
-      TypeChecker.typeCheck(expr, env)->Result.mapError(x => TypeError.TypeError(x))
-    })
-  }
-
-  switch doit() {
-  | Ok(value) => value->Typ.toString
+let stripTypeInfo = (_input: string, _treeSitterParser: 'a): string => {
+  switch eraseTypes(_input, _treeSitterParser) {
+  | Ok(expr) => RawExpr.toString(expr)
   | Error(e) => TypeError.toString(e)
   | exception e =>
     Console.log(e)
@@ -120,22 +186,14 @@ let typeCheck = (_input: string, _treeSitterParser: 'a): string => {
   }
 }
 
+// Like stripTypeInfo, but lays the program out and streams it to out.
 @genType
-let stripTypeInfo = (_input: string, _treeSitterParser: 'a): string => {
-  let doit = (): result<string, TypeError.t> => {
-    let syntaxNode: SyntaxNodeParser.syntaxNode = %raw(` _treeSitterParser.parse(_input).rootNode `)
-
-    SyntaxNodeParser.parseSourceFileNode(syntaxNode)
-    ->Result.mapError(x => TypeError.ParseError(x))
-    ->Result.map(Expr.stripTypeInfo)
-    ->Result.map(RawExpr.toString)
-  }
-
-  switch doit() {
-  | Ok(s) => s
-  | Error(e) => TypeError.toString(e)
+let stripTypeInfoTo = (_input: string, _treeSitterParser: 'a, out: string => unit): unit => {
+  switch eraseTypes(_input, _treeSitterParser) {
+  | Ok(expr) => expr->Printer.print(out, outputOptions)
+  | Error(e) => out(TypeError.toString(e))
   | exception e =>
     Console.log(e)
-    "error"
+    out("error")
   }
 }
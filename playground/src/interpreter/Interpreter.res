@@ -5,6 +5,16 @@ module Env = {
   let make = (): t<'a> => Belt.Map.make(~id=module(Var.Cmp))
 }
 
+@genType
+type evalError =
+  | TypeMismatch
+  | ZeroDivision
+  | UndefinedVariable
+  | UnsupportedForm
+  | MalformedSplice
+  // an array index outside the array, or a negative Array.init size
+  | IndexOutOfBounds
+
 module RuntimeVal = {
   @genType
   type rec t =
@@ -18,9 +28,62 @@ module RuntimeVal = {
         body: RawExpr.t,
       })
     | Code(RawExpr.t)
+    | ArrayVal(array<int>)
+    // unboxed tuples of two or more elements
+    | TupleVal(array<t>)
+    // A quote whose code has not been generated yet.
+    | Suspended(suspension)
+    // Generated code compiled to WebAssembly by ~0, applied to the
+    // arguments in args (the last first) so far. fallback is the closure
+    // the interpreter made of the same code, which takes over when an
+    // argument is not of the kind the compiled code expects.
+    | Native({func: WasmBackend.func, args: list<t>, fallback: t})
+    // A function bound by let rec memo to self, applied to the arguments in
+    // args (the last first) so far. Once it has all of them, the result
+    // comes from table when the call was made before (see Memo).
+    | Memoized({
+        self: Var.t,
+        venv: Env.t<t>,
+        nenv: Env.t<Var.t>,
+        params: list<Var.t>,
+        body: RawExpr.t,
+        table: Memo.t<t>,
+        args: list<t>,
+      })
+  // Generates the code on the first call and returns the same result on
+  // every later one.
+  and suspension = {mutable force: unit => result<RawExpr.t, evalError>}
+
+  // Defers generating the code of a quote until a splice, genlet or the
+  // printer needs it, so that code values built and then dropped cost
+  // nothing. generate runs at most once.
+  let suspend = (generate: unit => result<RawExpr.t, evalError>): t => {
+    let s = {force: generate}
+    s.force = () => {
+      let code = generate()
+      s.force = () => code
+      code
+    }
+    Suspended(s)
+  }
+
+  // The code of a code value, generated if need be; None for other values.
+  let code = (v: t): option<result<RawExpr.t, evalError>> =>
+    switch v {
+    | Code(expr) => Some(Ok(expr))
+    | Suspended(s) => Some(s.force())
+    | _ => None
+    }
+
+  // v with its code generated, if it is a suspended code value.
+  let force = (v: t): result<t, evalError> =>
+    switch v {
+    | Suspended(s) => s.force()->Result.map(expr => Code(expr))
+    | _ => Ok(v)
+    }
 
   @genType
-  let toString = (v: t): string =>
+  let rec toString = (v: t): string =>
     switch v {
     | IntVal(i) => Int.toString(i)
     | BoolVal(b) =>
@@ -29,9 +92,67 @@ module RuntimeVal = {
       } else {
         "false"
       }
-    | Closure(_) => "#<closure>"
-    | Code(expr) => `\`{ ${RawExpr.toString(expr)} }`
+    | Closure(_) | Native(_) | Memoized(_) => "#<closure>"
+    | ArrayVal([]) => "[| |]"
+    | ArrayVal(a) => `[| ${a->Array.map(Int.toString)->Array.join(", ")} |]`
+    | TupleVal(elements) => `(${elements->Array.map(toString)->Array.join(", ")})`
+    | Code(expr) => `\`{ ${RawExpr.toString(Sharing.letBind(expr))} }`
+    | Suspended(_) =>
+      switch force(v) {
+      | Ok(v1) => toString(v1)
+      | Error(_) => "#<code: error>"
+      }
+    }
+
+  // Carries a stage-0 value into generated code. Literals are lifted as
+  // literals; anything else travels as an opaque CsValue.
+  let rec persist = (var: Var.t, v: t): RawExpr.t =>
+    switch v {
+    | IntVal(i) => RawExpr.IntLit(i)
+    | BoolVal(b) => RawExpr.BoolLit(b)
+    | ArrayVal(a) =>
+      RawExpr.ArrayOp({
+        op: Operator.ArrayOp.Make,
+        args: a->Array.map(i => RawExpr.IntLit(i))->List.fromArray,
+      })
+    | TupleVal(elements) =>
+      RawExpr.Tuple(elements->Array.map(element => persist(var, element))->List.fromArray)
+    | _ => RawExpr.CsValue({var, value: (Obj.magic(v): RawExpr.Persistent.t)})
+    }
+
+  let fromPersistent = (value: RawExpr.Persistent.t): t => Obj.magic(value)
+
+  // The cache key of a call to values, or None when one of them is neither
+  // an int, a boolean nor code that generates without error; such calls
+  // are not cached.
+  let memoKey = (values: list<t>): option<Memo.key> => {
+    let parts = values->Belt.List.toArray->Array.map(v =>
+      switch v {
+      | IntVal(i) => Some(Memo.Int(i))
+      | BoolVal(b) => Some(Memo.Bool(b))
+      | _ =>
+        switch code(v) {
+        | Some(Ok(expr)) => Some(Memo.Code(expr))
+        | _ => None
+        }
+      }
+    )
+    if parts->Array.every(Option.isSome) {
+      Some(Memo.makeKey(parts->Array.map(Option.getUnsafe)))
+    } else {
+      None
     }
+  }
+}
+
+// The colored variables that let cs has bound at run time. A quote that
+// mentions one of them gets its value instead of the variable.
+module CrossStage = {
+  let bound: WeakSet.t<Var.t> = WeakSet.make()
+
+  let bind = (var: Var.t): unit => bound->WeakSet.add(var)->ignore
+
+  let isBound = (var: Var.t): bool => bound->WeakSet.has(var)
 }
 
 module FutureVal = {
@@ -49,12 +170,175 @@ module NameEnv = {
   type t = Env.t<Var.t>
 }
 
-type evalError =
-  | TypeMismatch
-  | ZeroDivision
-  | UndefinedVariable
-  | UnsupportedForm
-  | MalformedSplice
+// What evaluateFuture needs to know to return a quoted subtree as-is instead
+// of walking and rebuilding it: the subtree must contain no splice that fires
+// at the level it is evaluated at, and no variable that needs renaming.
+// Computed once per quote body and cached by node identity, so quotes that
+// are evaluated many times, as in recursive generators, are analysed once.
+module QuoteInfo = {
+  type t = {
+    // The highest level a splice in the subtree reaches, relative to the
+    // level of the subtree itself (each quote on the way lowers it by one);
+    // 0 when no splice reaches a future level.
+    maxSpliceLevel: int,
+    // No free variables, and no form evaluateFuture would reject.
+    closed: bool,
+  }
+
+  type vars = Belt.Set.t<Var.t, Var.Cmp.identity>
+
+  let cache: WeakMap.t<RawExpr.t, t> = WeakMap.make()
+
+  // The facts analyse gathers bottom-up.
+  type summary = {level: int, wellFormed: bool, free: vars}
+
+  let leaf = (free: vars): summary => {level: 0, wellFormed: true, free}
+
+  let merge = (a: summary, b: summary): summary => {
+    level: Math.Int.max(a.level, b.level),
+    wellFormed: a.wellFormed && b.wellFormed,
+    free: Belt.Set.union(a.free, b.free),
+  }
+
+  let bind = (s: summary, bound: list<Var.t>): summary => {
+    ...s,
+    free: bound->Belt.List.reduce(s.free, Belt.Set.remove),
+  }
+
+  // Analyses e and all of its subtrees, caching the result for each.
+  let rec analyse = (e: RawExpr.t): summary => {
+    open RawExpr
+
+    let summary = switch e {
+    | IntLit(_) | BoolLit(_) | CsValue(_) => leaf(Belt.Set.make(~id=module(Var.Cmp)))
+    | Var(v) => leaf(Belt.Set.make(~id=module(Var.Cmp))->Belt.Set.add(v))
+    | BinOp({left, right})
+    | ShortCircuitOp({left, right})
+    | PrimOp({left, right})
+    | App({func: left, arg: right}) =>
+      merge(analyse(left), analyse(right))
+    | UniOp({expr}) | PrimNot({expr}) | GenLet({expr}) => analyse(expr)
+    | ArrayOp({args}) | Tuple(args) =>
+      args->Belt.List.reduce(leaf(Belt.Set.make(~id=module(Var.Cmp))), (s, arg) =>
+        merge(s, analyse(arg))
+      )
+    | Proj({tuple}) => analyse(tuple)
+    | If({cond, thenBranch, elseBranch}) =>
+      merge(analyse(cond), merge(analyse(thenBranch), analyse(elseBranch)))
+    | Let({param, expr, body}) | LetCs({param, expr, body}) =>
+      merge(analyse(expr), analyse(body)->bind(list{param}))
+    | Func({params, body}) => analyse(body)->bind(params)
+    | LetRec({param, expr: Func({params, body: fbody}), body}) =>
+      merge(analyse(fbody)->bind(params), analyse(body))->bind(list{param})
+    // evaluateFuture rejects this form, so it has to be walked
+    | LetRec({expr, body}) => {...merge(analyse(expr), analyse(body)), wellFormed: false}
+    | Quote({expr}) =>
+      let s = analyse(expr)
+      {...s, level: Math.Int.max(0, s.level - 1)}
+    | Splice({shift, expr}) =>
+      let s = analyse(expr)
+      {...s, level: Math.Int.max(shift, s.level)}
+    }
+
+    cache
+    ->WeakMap.set(
+      e,
+      {
+        maxSpliceLevel: summary.level,
+        closed: summary.wellFormed && Belt.Set.isEmpty(summary.free),
+      },
+    )
+    ->ignore
+    summary
+  }
+
+  let prepare = (e: RawExpr.t): unit =>
+    if !(cache->WeakMap.has(e)) {
+      analyse(e)->ignore
+    }
+
+  // Whether evaluating e at level lv would give back e unchanged.
+  let isInert = (e: RawExpr.t, lv: int): bool =>
+    switch cache->WeakMap.get(e) {
+    | Some({maxSpliceLevel, closed}) => closed && maxSpliceLevel < lv
+    | None => false
+    }
+}
+
+// Let-insertion points for genlet. While code is generated, the body of
+// each quote and of each binder in it is a frame. genlet binds its code at
+// the outermost frame of the innermost quote that still has every variable
+// of the code in scope, and each frame wraps the code built for it in the
+// lets collected there. Bindings are hoisted out of conditionals too, as
+// with let-insertion in general.
+module LetInsertion = {
+  type frame = {
+    // a quote body; bindings never move past it
+    isQuote: bool,
+    // variables in scope from this frame on, including genlet's own
+    mutable bound: list<Var.t>,
+    // most recent first
+    mutable bindings: list<(Var.t, RawExpr.t)>,
+  }
+
+  let frames: ref<list<frame>> = ref(list{})
+
+  // Bindings inserted so far. Memoized calls compare it before and after,
+  // as code that refers to a binding only holds where the binding is.
+  let count = ref(0)
+
+  let within = (isQuote: bool, bound: list<Var.t>, build: unit => result<RawExpr.t, 'e>): result<
+    RawExpr.t,
+    'e,
+  > => {
+    let saved = frames.contents
+    let frame = {isQuote, bound, bindings: list{}}
+    frames := list{frame, ...saved}
+    let result = try build() catch {
+    | exn =>
+      frames := saved
+      raise(exn)
+    }
+    frames := saved
+
+    result->Result.map(body =>
+      frame.bindings->Belt.List.reduce(body, (body, (param, expr)) => RawExpr.Let({
+        param,
+        expr,
+        body,
+      }))
+    )
+  }
+
+  // The code standing for code from now on: a fresh variable bound to it,
+  // or code itself when it is trivial or no code is being generated.
+  let insert = (code: RawExpr.t): RawExpr.t =>
+    switch code {
+    | Var(_) | IntLit(_) | BoolLit(_) | CsValue(_) => code
+    | _ =>
+      let free = Optimizer.freeVars(code)
+      let rec target = frames =>
+        switch frames {
+        | list{} => None
+        | list{frame, ...rest} =>
+          if frame.isQuote || frame.bound->Belt.List.some(v => free->Belt.Set.has(v)) {
+            Some(frame)
+          } else {
+            target(rest)
+          }
+        }
+
+      switch target(frames.contents) {
+      | None => code
+      | Some(frame) =>
+        let v = Var.color(Var.Raw({name: "genlet"}))
+        count := count.contents + 1
+        frame.bindings = list{(v, code), ...frame.bindings}
+        frame.bound = list{v, ...frame.bound}
+        Var(v)
+      }
+    }
+}
 
 exception MalformedValue({msg: string})
 
@@ -72,8 +356,8 @@ let rec colorParams = (params: list<Var.t>, nenv: NameEnv.t): (list<Var.t>, Name
   }
 }
 
-@genType
-let rec evaluateRuntime = (e: RawExpr.t, venv: ValEnv.t, nenv: NameEnv.t): result<
+/* corresponds to eval(0, e, venv, nenv) */
+let rec evaluatePresent = (e: RawExpr.t, venv: ValEnv.t, nenv: NameEnv.t): result<
   RuntimeVal.t,
   evalError,
 > => {
@@ -84,8 +368,8 @@ let rec evaluateRuntime = (e: RawExpr.t, venv: ValEnv.t, nenv: NameEnv.t): resul
   | IntLit(i) => ok(IntVal(i))
   | BoolLit(b) => ok(BoolVal(b))
   | BinOp({op, left, right}) =>
-    evaluateRuntime(left, venv, nenv)->Result.flatMap(leftVal =>
-      evaluateRuntime(right, venv, nenv)->Result.flatMap(rightVal =>
+    evaluatePresent(left, venv, nenv)->Result.flatMap(leftVal =>
+      evaluatePresent(right, venv, nenv)->Result.flatMap(rightVal =>
         switch op {
         // Arithmetic
         | Operator.BinOp.Add =>
@@ -152,13 +436,13 @@ let rec evaluateRuntime = (e: RawExpr.t, venv: ValEnv.t, nenv: NameEnv.t): resul
       )
     )
   | ShortCircuitOp({op, left, right}) =>
-    evaluateRuntime(left, venv, nenv)->Result.flatMap(leftVal =>
+    evaluatePresent(left, venv, nenv)->Result.flatMap(leftVal =>
       switch (op, leftVal) {
       | (Operator.ShortCircuitOp.And, BoolVal(false)) => ok(BoolVal(false)) // short-circuit
       | (Operator.ShortCircuitOp.Or, BoolVal(true)) => ok(BoolVal(true)) // short-circuit
       | (Operator.ShortCircuitOp.And, BoolVal(true))
       | (Operator.ShortCircuitOp.Or, BoolVal(false)) =>
-        evaluateRuntime(right, venv, nenv)->Result.flatMap(rightVal =>
+        evaluatePresent(right, venv, nenv)->Result.flatMap(rightVal =>
           switch rightVal {
           | BoolVal(b) => ok(BoolVal(b))
           | _ => fail(TypeMismatch)
@@ -168,17 +452,86 @@ let rec evaluateRuntime = (e: RawExpr.t, venv: ValEnv.t, nenv: NameEnv.t): resul
       }
     )
   | UniOp({op, expr}) =>
-    evaluateRuntime(expr, venv, nenv)->Result.flatMap(exprVal =>
+    evaluatePresent(expr, venv, nenv)->Result.flatMap(exprVal =>
       switch (op, exprVal) {
       | (Operator.UniOp.Not, BoolVal(b)) => ok(BoolVal(!b))
       | _ => fail(TypeMismatch)
       }
     )
+  | PrimOp({op, left, right}) =>
+    evaluatePresent(left, venv, nenv)->Result.flatMap(leftVal => {
+      open Operator.PrimOp
+      switch (op, leftVal) {
+      | (BoolAnd, BoolVal(false)) | (BoolOr, BoolVal(true)) => ok(leftVal) // short-circuit
+      | (BoolAnd, BoolVal(true)) | (BoolOr, BoolVal(false)) => evaluatePresent(right, venv, nenv)
+      | (BoolAnd | BoolOr, _) => fail(TypeMismatch)
+      | _ =>
+        evaluatePresent(right, venv, nenv)->Result.flatMap(rightVal =>
+          switch (op, leftVal, rightVal) {
+          | (IntAdd, IntVal(l), IntVal(r)) => ok(IntVal(l + r))
+          | (IntSub, IntVal(l), IntVal(r)) => ok(IntVal(l - r))
+          | (IntMul, IntVal(l), IntVal(r)) => ok(IntVal(l * r))
+          | (IntDiv | IntMod, IntVal(_), IntVal(0)) => fail(ZeroDivision)
+          | (IntDiv, IntVal(l), IntVal(r)) => ok(IntVal(l / r))
+          | (IntMod, IntVal(l), IntVal(r)) => ok(IntVal(Int.mod(l, r)))
+          | (IntEq, IntVal(l), IntVal(r)) => ok(BoolVal(l == r))
+          | (IntNe, IntVal(l), IntVal(r)) => ok(BoolVal(l != r))
+          | (IntLt, IntVal(l), IntVal(r)) => ok(BoolVal(l < r))
+          | (IntLe, IntVal(l), IntVal(r)) => ok(BoolVal(l <= r))
+          | (IntGt, IntVal(l), IntVal(r)) => ok(BoolVal(l > r))
+          | (IntGe, IntVal(l), IntVal(r)) => ok(BoolVal(l >= r))
+          | (BoolEq, BoolVal(l), BoolVal(r)) => ok(BoolVal(l == r))
+          | (BoolNe, BoolVal(l), BoolVal(r)) => ok(BoolVal(l != r))
+          | _ => fail(TypeMismatch)
+          }
+        )
+      }
+    })
+  | PrimNot({expr}) =>
+    evaluatePresent(expr, venv, nenv)->Result.flatMap(exprVal =>
+      switch exprVal {
+      | BoolVal(b) => ok(BoolVal(!b))
+      | _ => fail(TypeMismatch)
+      }
+    )
   | If({cond, thenBranch, elseBranch}) =>
-    evaluateRuntime(cond, venv, nenv)->Result.flatMap(condVal =>
+    evaluatePresent(cond, venv, nenv)->Result.flatMap(condVal =>
       switch condVal {
-      | BoolVal(true) => evaluateRuntime(thenBranch, venv, nenv)
-      | BoolVal(false) => evaluateRuntime(elseBranch, venv, nenv)
+      | BoolVal(true) => evaluatePresent(thenBranch, venv, nenv)
+      | BoolVal(false) => evaluatePresent(elseBranch, venv, nenv)
+      | _ => fail(TypeMismatch)
+      }
+    )
+
+  | ArrayOp({op, args}) =>
+    args
+    ->Belt.List.toArray
+    ->Array.reduce(ok([]), (acc, arg) =>
+      acc->Result.flatMap(vals =>
+        evaluatePresent(arg, venv, nenv)->Result.map(v => {
+          vals->Array.push(v)
+          vals
+        })
+      )
+    )
+    ->Result.flatMap(vals => arrayOp(op, vals))
+
+  | Tuple(elements) =>
+    elements
+    ->Belt.List.toArray
+    ->Array.reduce(ok([]), (acc, element) =>
+      acc->Result.flatMap(vals =>
+        evaluatePresent(element, venv, nenv)->Result.map(v => {
+          vals->Array.push(v)
+          vals
+        })
+      )
+    )
+    ->Result.map(vals => TupleVal(vals))
+  | Proj({tuple, index}) =>
+    evaluatePresent(tuple, venv, nenv)->Result.flatMap(tupleVal =>
+      switch tupleVal {
+      | TupleVal(vals) => vals->Array.get(index)->Option.mapOr(fail(TypeMismatch), ok)
       | _ => fail(TypeMismatch)
       }
     )
@@ -192,98 +545,284 @@ let rec evaluateRuntime = (e: RawExpr.t, venv: ValEnv.t, nenv: NameEnv.t): resul
     ->Option.getOr(fail(UndefinedVariable))
 
   | Let({param, expr, body}) =>
-    evaluateRuntime(expr, venv, nenv)->Result.flatMap(exprVal => {
+    evaluatePresent(expr, venv, nenv)->Result.flatMap(exprVal => {
+      let param1 = Var.color(param)
+      let nenv1 = nenv->Belt.Map.set(param, param1)
+      let venv1 = Belt.Map.set(venv, param1, exprVal)
+      evaluatePresent(body, venv1, nenv1)
+    })
+
+  | LetCs({param, expr, body}) =>
+    evaluatePresent(expr, venv, nenv)->Result.flatMap(exprVal => {
       let param1 = Var.color(param)
+      CrossStage.bind(param1)
       let nenv1 = nenv->Belt.Map.set(param, param1)
       let venv1 = Belt.Map.set(venv, param1, exprVal)
-      evaluateRuntime(body, venv1, nenv1)
+      evaluatePresent(body, venv1, nenv1)
     })
 
+  | CsValue({value}) => ok(RuntimeVal.fromPersistent(value))
+
   | Func({params, body}) => ok(Closure({self: None, venv, nenv, params, body}))
 
   | App({func, arg}) =>
-    evaluateRuntime(func, venv, nenv)->Result.flatMap(funcVal =>
-      evaluateRuntime(arg, venv, nenv)->Result.flatMap(argVal =>
-        switch funcVal {
-        | Closure({self: None, venv: closVenv, nenv: closNenv, params: list{param}, body}) =>
-          let param1 = Var.color(param)
-          let closNenv1 = closNenv->Belt.Map.set(param, param1)
-          let closVenv1 = closVenv->Belt.Map.set(param1, argVal)
-          evaluateRuntime(body, closVenv1, closNenv1)
-
-        | Closure({
-            self: None,
-            venv: closVenv,
-            nenv: closNenv,
-            params: list{param, ...rest},
-            body,
-          }) =>
-          let param1 = Var.color(param)
-          let closNenv1 = closNenv->Belt.Map.set(param, param1)
-          let closVenv1 = closVenv->Belt.Map.set(param1, argVal)
-          ok(Closure({self: None, venv: closVenv1, nenv: closNenv1, params: rest, body}))
-
-        | Closure({self: Some(self), venv: closVenv, nenv: closNenv, params: list{param}, body}) =>
-          let param1 = Var.color(param)
-          let closNenv1 = closNenv->Belt.Map.set(param, param1)
-          let closVenv1 = closVenv->Belt.Map.set(param1, argVal)->Belt.Map.set(self, funcVal)
-          evaluateRuntime(body, closVenv1, closNenv1)
-
-        | Closure({
-            self: Some(self),
-            venv: closVenv,
-            nenv: closNenv,
-            params: list{param, ...rest},
-            body,
-          }) =>
-          let param1 = Var.color(param)
-          let closNenv1 = closNenv->Belt.Map.set(param, param1)
-          let closVenv1 = closVenv->Belt.Map.set(param1, argVal)->Belt.Map.set(self, funcVal)
-          ok(Closure({self: None, venv: closVenv1, nenv: closNenv1, params: rest, body}))
-
-        | Closure(_) =>
-          raise(MalformedValue({msg: "Closure with empty params should be impossible"}))
-
-        | _ => fail(TypeMismatch)
-        }
-      )
+    evaluatePresent(func, venv, nenv)->Result.flatMap(funcVal =>
+      evaluatePresent(arg, venv, nenv)->Result.flatMap(argVal => apply(funcVal, argVal))
     )
 
-  | LetRec({param, expr: Func({params: fparams, body: fbody}), body}) =>
+  | LetRec({param, expr: Func({params: fparams, body: fbody}), body, memo}) =>
     let param1 = Var.color(param)
     let nenv1 = nenv->Belt.Map.set(param, param1)
-    let recFunc = RuntimeVal.Closure({
-      self: Some(param1),
-      venv,
-      nenv: nenv1,
-      params: fparams,
-      body: fbody,
-    })
+    let recFunc = if memo {
+      RuntimeVal.Memoized({
+        self: param1,
+        venv,
+        nenv: nenv1,
+        params: fparams,
+        body: fbody,
+        table: Memo.make(),
+        args: list{},
+      })
+    } else {
+      RuntimeVal.Closure({
+        self: Some(param1),
+        venv,
+        nenv: nenv1,
+        params: fparams,
+        body: fbody,
+      })
+    }
 
     let venv1 = Belt.Map.set(venv, param1, recFunc)
-    evaluateRuntime(body, venv1, nenv1)
+    evaluatePresent(body, venv1, nenv1)
 
   | LetRec(_) => fail(UnsupportedForm)
 
-  | Quote({expr}) => evaluateFuture(1, expr, venv, nenv)->Belt.Result.map(v => {Code(v)})
+  | Quote({expr}) =>
+    ok(
+      RuntimeVal.suspend(() => {
+        QuoteInfo.prepare(expr)
+        LetInsertion.within(true, list{}, () => evaluateFuture(1, expr, venv, nenv))
+      }),
+    )
+
+  | GenLet({expr}) =>
+    evaluatePresent(expr, venv, nenv)->Result.flatMap(v =>
+      switch RuntimeVal.code(v) {
+      | Some(code) => code->Result.map(code => Code(LetInsertion.insert(code)))
+      | None => fail(TypeMismatch)
+      }
+    )
 
   | Splice({shift, expr}) =>
     if shift >= 1 {
       fail(MalformedSplice)
     } else {
-      evaluateRuntime(expr, venv, nenv)->Belt.Result.flatMap(v => {
-        switch v {
-        | Code(expr1) => evaluateRuntime(expr1, venv, nenv)
-        | _ => fail(TypeMismatch)
+      evaluatePresent(expr, venv, nenv)->Belt.Result.flatMap(v => {
+        switch RuntimeVal.code(v) {
+        | Some(code) =>
+          code->Result.flatMap(expr1 => {
+            let optimized = Optimizer.optimizeCode(expr1)
+            evaluatePresent(optimized, venv, nenv)->Result.map(v =>
+              switch WasmBackend.compile(optimized) {
+              | Some(func) => Native({func, args: list{}, fallback: v})
+              | None => v
+              }
+            )
+          })
+        | None => fail(TypeMismatch)
         }
       })
     }
   }
 }
+// Applies a function value to one more argument.
+and apply = (funcVal: RuntimeVal.t, argVal: RuntimeVal.t): result<RuntimeVal.t, evalError> => {
+  open RuntimeVal
+
+  switch funcVal {
+  | Closure({self: None, venv: closVenv, nenv: closNenv, params: list{param}, body}) =>
+    let param1 = Var.color(param)
+    let closNenv1 = closNenv->Belt.Map.set(param, param1)
+    let closVenv1 = closVenv->Belt.Map.set(param1, argVal)
+    evaluatePresent(body, closVenv1, closNenv1)
+
+  | Closure({
+      self: None,
+      venv: closVenv,
+      nenv: closNenv,
+      params: list{param, ...rest},
+      body,
+    }) =>
+    let param1 = Var.color(param)
+    let closNenv1 = closNenv->Belt.Map.set(param, param1)
+    let closVenv1 = closVenv->Belt.Map.set(param1, argVal)
+    ok(Closure({self: None, venv: closVenv1, nenv: closNenv1, params: rest, body}))
+
+  | Closure({self: Some(self), venv: closVenv, nenv: closNenv, params: list{param}, body}) =>
+    let param1 = Var.color(param)
+    let closNenv1 = closNenv->Belt.Map.set(param, param1)
+    let closVenv1 = closVenv->Belt.Map.set(param1, argVal)->Belt.Map.set(self, funcVal)
+    evaluatePresent(body, closVenv1, closNenv1)
+
+  | Closure({
+      self: Some(self),
+      venv: closVenv,
+      nenv: closNenv,
+      params: list{param, ...rest},
+      body,
+    }) =>
+    let param1 = Var.color(param)
+    let closNenv1 = closNenv->Belt.Map.set(param, param1)
+    let closVenv1 = closVenv->Belt.Map.set(param1, argVal)->Belt.Map.set(self, funcVal)
+    ok(Closure({self: None, venv: closVenv1, nenv: closNenv1, params: rest, body}))
+
+  | Closure(_) =>
+    raise(MalformedValue({msg: "Closure with empty params should be impossible"}))
+
+  | Memoized({self, venv: closVenv, nenv: closNenv, params, body, table, args}) =>
+    let args1 = list{argVal, ...args}
+    if Belt.List.length(args1) < Belt.List.length(params) {
+      ok(Memoized({self, venv: closVenv, nenv: closNenv, params, body, table, args: args1}))
+    } else {
+      let values = args1->Belt.List.reverse
+      let call = () => {
+        let base = Memoized({self, venv: closVenv, nenv: closNenv, params, body, table, args: list{}})
+        let (closVenv1, closNenv1) = Belt.List.reduce2(
+          params,
+          values,
+          (closVenv->Belt.Map.set(self, base), closNenv),
+          ((venv, nenv), param, v) => {
+            let param1 = Var.color(param)
+            (venv->Belt.Map.set(param1, v), nenv->Belt.Map.set(param, param1))
+          },
+        )
+        evaluatePresent(body, closVenv1, closNenv1)
+      }
+      switch memoKey(values) {
+      | Some(key) =>
+        switch table->Memo.find(key) {
+        | Some(v) => ok(v)
+        | None =>
+          let inserted = LetInsertion.count.contents
+          call()->Result.map(v => {
+            // A call that let-inserted may return code using the bindings
+            // it made, which another call site would not have in scope.
+            if LetInsertion.count.contents == inserted {
+              table->Memo.add(key, v)
+            }
+            v
+          })
+        }
+      | None => call()
+      }
+    }
+
+  | Native({func, args, fallback}) =>
+    let args1 = list{argVal, ...args}
+    if Belt.List.length(args1) < func.arity {
+      ok(Native({func, args: args1, fallback}))
+    } else {
+      let values = args1->Belt.List.reverse->Belt.List.toArray
+      let native = values->Array.mapWithIndex((v, i) =>
+        switch (func.params->Array.getUnsafe(i), v) {
+        | (WasmBackend.Int, IntVal(n)) => Some(n)
+        | (WasmBackend.Bool, BoolVal(b)) => Some(b ? 1 : 0)
+        | _ => None
+        }
+      )
+      if native->Array.every(Option.isSome) {
+        switch func.invoke(native->Array.map(Option.getUnsafe)) {
+        | Some(n) => ok(func.result == WasmBackend.Int ? IntVal(n) : BoolVal(n != 0))
+        | None => fail(ZeroDivision)
+        }
+      } else {
+        values->Array.reduce(ok(fallback), (f, v) => f->Result.flatMap(f => apply(f, v)))
+      }
+    }
+
+  | _ => fail(TypeMismatch)
+  }
+}
+// Applies an array operation to the values of its operands, in the order of
+// Operator.ArrayOp. The functions of Init, Map and Fold are called on the
+// elements in order, stopping at the first error.
+and arrayOp = (op: Operator.ArrayOp.t, operands: array<RuntimeVal.t>): result<
+  RuntimeVal.t,
+  evalError,
+> => {
+  open RuntimeVal
+
+  let int = (v: result<t, evalError>): result<int, evalError> =>
+    switch v {
+    | Ok(IntVal(i)) => ok(i)
+    | Ok(_) => fail(TypeMismatch)
+    | Error(err) => fail(err)
+    }
+  // The array of f(0), ..., f(n - 1).
+  let build = (n: int, f: int => result<int, evalError>): result<t, evalError> => {
+    let elems = []
+    let error = ref(None)
+    let i = ref(0)
+    while error.contents->Option.isNone && i.contents < n {
+      switch f(i.contents) {
+      | Ok(x) => elems->Array.push(x)
+      | Error(err) => error := Some(err)
+      }
+      i := i.contents + 1
+    }
+    switch error.contents {
+    | Some(err) => fail(err)
+    | None => ok(ArrayVal(elems))
+    }
+  }
+
+  switch (op, operands) {
+  | (Operator.ArrayOp.Make, _) =>
+    build(Array.length(operands), i => int(ok(operands->Array.getUnsafe(i))))
+  | (Operator.ArrayOp.Length, [ArrayVal(a)]) => ok(IntVal(Array.length(a)))
+  | (Operator.ArrayOp.Get, [ArrayVal(a), IntVal(i)]) =>
+    switch a->Array.get(i) {
+    | Some(x) => ok(IntVal(x))
+    | None => fail(IndexOutOfBounds)
+    }
+  | (Operator.ArrayOp.Init, [IntVal(n), f]) =>
+    if n < 0 {
+      fail(IndexOutOfBounds)
+    } else {
+      build(n, i => int(apply(f, IntVal(i))))
+    }
+  | (Operator.ArrayOp.Map, [f, ArrayVal(a)]) =>
+    build(Array.length(a), i => int(apply(f, IntVal(a->Array.getUnsafe(i)))))
+  | (Operator.ArrayOp.Fold, [f, IntVal(z), ArrayVal(a)]) =>
+    let acc = ref(ok(z))
+    let i = ref(0)
+    while Result.isOk(acc.contents) && i.contents < Array.length(a) {
+      let x = a->Array.getUnsafe(i.contents)
+      acc :=
+        acc.contents->Result.flatMap(z =>
+          apply(f, IntVal(z))->Result.flatMap(g => int(apply(g, IntVal(x))))
+        )
+      i := i.contents + 1
+    }
+    acc.contents->Result.map(z => IntVal(z))
+  | _ => fail(TypeMismatch)
+  }
+}
 /* corresponds to eval(lv, e, venv, nenv) where lv >= 1 */
 and evaluateFuture = (lv: int, e: RawExpr.t, venv: ValEnv.t, nenv: NameEnv.t): result<
   FutureVal.t,
   evalError,
+> =>
+  // Nothing to splice and nothing to rename: the result would be a copy of e.
+  if QuoteInfo.isInert(e, lv) {
+    ok(e)
+  } else {
+    evaluateFutureNode(lv, e, venv, nenv)
+  }
+and evaluateFutureNode = (lv: int, e: RawExpr.t, venv: ValEnv.t, nenv: NameEnv.t): result<
+  FutureVal.t,
+  evalError,
 > => {
   open RawExpr
 
@@ -292,70 +831,99 @@ and evaluateFuture = (lv: int, e: RawExpr.t, venv: ValEnv.t, nenv: NameEnv.t): r
   | BoolLit(b) => ok(BoolLit(b))
   | BinOp({op, left, right}) =>
     evaluateFuture(lv, left, venv, nenv)->Belt.Result.flatMap(lval =>
-      evaluateFuture(lv, right, venv, nenv)->Belt.Result.map(rval => RawExpr.BinOp({
-        op,
-        left: lval,
-        right: rval,
-      }))
+      evaluateFuture(lv, right, venv, nenv)->Belt.Result.map(rval =>
+        CodeBuilder.binOp(op, lval, rval)
+      )
     )
   | ShortCircuitOp({op, left, right}) =>
     evaluateFuture(lv, left, venv, nenv)->Belt.Result.flatMap(lval =>
-      evaluateFuture(lv, right, venv, nenv)->Belt.Result.map(rval => RawExpr.ShortCircuitOp({
-        op,
-        left: lval,
-        right: rval,
-      }))
+      evaluateFuture(lv, right, venv, nenv)->Belt.Result.map(rval =>
+        CodeBuilder.shortCircuitOp(op, lval, rval)
+      )
     )
   | UniOp({op, expr}) =>
-    evaluateFuture(lv, expr, venv, nenv)->Result.map(val => RawExpr.UniOp({op, expr: val}))
+    evaluateFuture(lv, expr, venv, nenv)->Result.map(val => CodeBuilder.uniOp(op, val))
+  | PrimOp({op, left, right}) =>
+    evaluateFuture(lv, left, venv, nenv)->Belt.Result.flatMap(lval =>
+      evaluateFuture(lv, right, venv, nenv)->Belt.Result.map(rval =>
+        CodeBuilder.primOp(op, lval, rval)
+      )
+    )
+  | PrimNot({expr}) =>
+    evaluateFuture(lv, expr, venv, nenv)->Result.map(CodeBuilder.primNot)
   | If({cond, thenBranch, elseBranch}) =>
     evaluateFuture(lv, cond, venv, nenv)->Belt.Result.flatMap(condVal =>
       evaluateFuture(lv, thenBranch, venv, nenv)->Belt.Result.flatMap(thenVal =>
         evaluateFuture(lv, elseBranch, venv, nenv)->Belt.Result.map(
-          elseVal => RawExpr.If({cond: condVal, thenBranch: thenVal, elseBranch: elseVal}),
+          elseVal => CodeBuilder.if_(condVal, thenVal, elseVal),
         )
       )
     )
 
   | Var(v) =>
-    Belt.Map.get(nenv, v)
-    ->Option.map(v => ok(RawExpr.Var(v)))
-    ->Option.getOr(fail(UndefinedVariable))
+    switch Belt.Map.get(nenv, v) {
+    | Some(v1) if CrossStage.isBound(v1) =>
+      venv
+      ->Belt.Map.get(v1)
+      ->Option.map(val => ok(RuntimeVal.persist(v1, val)))
+      ->Option.getOr(fail(UndefinedVariable))
+    | Some(v1) => ok(RawExpr.Var(v1))
+    | None => fail(UndefinedVariable)
+    }
 
   | Let({param, expr, body}) =>
     evaluateFuture(lv, expr, venv, nenv)->Belt.Result.flatMap(exprVal => {
       let param1 = Var.color(param)
       let nenv1 = nenv->Belt.Map.set(param, param1)
-      evaluateFuture(lv, body, venv, nenv1)->Belt.Result.map(bodyVal => {
-        RawExpr.Let({param: param1, expr: exprVal, body: bodyVal})
+      LetInsertion.within(false, list{param1}, () =>
+        evaluateFuture(lv, body, venv, nenv1)
+      )->Belt.Result.map(bodyVal => {
+        CodeBuilder.let_(param1, exprVal, bodyVal)
+      })
+    })
+
+  | LetCs({param, expr, body}) =>
+    evaluateFuture(lv, expr, venv, nenv)->Belt.Result.flatMap(exprVal => {
+      let param1 = Var.color(param)
+      let nenv1 = nenv->Belt.Map.set(param, param1)
+      LetInsertion.within(false, list{param1}, () =>
+        evaluateFuture(lv, body, venv, nenv1)
+      )->Belt.Result.map(bodyVal => {
+        LetCs({param: param1, expr: exprVal, body: bodyVal})
       })
     })
 
+  | CsValue(_) => ok(e)
+
   | Func({params, body}) =>
     let (params1, nenv1) = colorParams(params, nenv)
-    evaluateFuture(lv, body, venv, nenv1)->Belt.Result.map(bodyVal => {
+    LetInsertion.within(false, params1, () =>
+      evaluateFuture(lv, body, venv, nenv1)
+    )->Belt.Result.map(bodyVal => {
       Func({params: params1, body: bodyVal})
     })
 
   | App({func, arg}) =>
     evaluateFuture(lv, func, venv, nenv)->Result.flatMap(funcVal =>
-      evaluateFuture(lv, arg, venv, nenv)->Result.map(argVal => RawExpr.App({
-        func: funcVal,
-        arg: argVal,
-      }))
+      evaluateFuture(lv, arg, venv, nenv)->Result.map(argVal => CodeBuilder.app(funcVal, argVal))
     )
 
-  | LetRec({param, expr: Func({params: fparams, body: fbody}), body}) =>
+  | LetRec({param, expr: Func({params: fparams, body: fbody}), body, memo}) =>
     let param1 = Var.color(param)
     let nenv1 = nenv->Belt.Map.set(param, param1)
     let (fparams1, fnenv) = colorParams(fparams, nenv1)
 
-    evaluateFuture(lv, fbody, venv, fnenv)->Belt.Result.flatMap(fbodyVal => {
-      evaluateFuture(lv, body, venv, nenv1)->Belt.Result.map(bodyVal => {
+    LetInsertion.within(false, list{param1, ...fparams1}, () =>
+      evaluateFuture(lv, fbody, venv, fnenv)
+    )->Belt.Result.flatMap(fbodyVal => {
+      LetInsertion.within(false, list{param1}, () =>
+        evaluateFuture(lv, body, venv, nenv1)
+      )->Belt.Result.map(bodyVal => {
         RawExpr.LetRec({
           param: param1,
           expr: RawExpr.Func({params: fparams1, body: fbodyVal}),
           body: bodyVal,
+          memo,
         })
       })
     })
@@ -363,18 +931,52 @@ and evaluateFuture = (lv: int, e: RawExpr.t, venv: ValEnv.t, nenv: NameEnv.t): r
   | LetRec(_) => fail(UnsupportedForm)
 
   | Quote({expr}) =>
-    evaluateFuture(lv + 1, expr, venv, nenv)->Belt.Result.map(exprVal => {
+    LetInsertion.within(true, list{}, () =>
+      evaluateFuture(lv + 1, expr, venv, nenv)
+    )->Belt.Result.map(exprVal => {
       RawExpr.Quote({expr: exprVal})
     })
 
+  | GenLet({expr}) =>
+    evaluateFuture(lv, expr, venv, nenv)->Result.map(val => RawExpr.GenLet({expr: val}))
+
+  // Array operations are residualized like the other primitives, whichever
+  // stage their operands come from.
+  | ArrayOp({op, args}) =>
+    args
+    ->Belt.List.toArray
+    ->Array.reduce(ok([]), (acc, arg) =>
+      acc->Result.flatMap(vals =>
+        evaluateFuture(lv, arg, venv, nenv)->Result.map(v => {
+          vals->Array.push(v)
+          vals
+        })
+      )
+    )
+    ->Result.map(vals => CodeBuilder.arrayOp(op, vals->List.fromArray))
+  | Tuple(elements) =>
+    elements
+    ->Belt.List.toArray
+    ->Array.reduce(ok([]), (acc, element) =>
+      acc->Result.flatMap(vals =>
+        evaluateFuture(lv, element, venv, nenv)->Result.map(v => {
+          vals->Array.push(v)
+          vals
+        })
+      )
+    )
+    ->Result.map(vals => RawExpr.Tuple(vals->List.fromArray))
+  | Proj({tuple, index}) =>
+    evaluateFuture(lv, tuple, venv, nenv)->Result.map(tuple1 => CodeBuilder.proj(tuple1, index))
+
   | Splice({shift, expr}) =>
     if shift > lv {
       fail(MalformedSplice)
     } else if shift == lv {
-      evaluateRuntime(expr, venv, nenv)->Belt.Result.flatMap(val => {
-        switch val {
-        | Code(expr1) => ok(expr1)
-        | _ => fail(TypeMismatch)
+      evaluatePresent(expr, venv, nenv)->Belt.Result.flatMap(val => {
+        switch RuntimeVal.code(val) {
+        | Some(code) => code
+        | None => fail(TypeMismatch)
         }
       })
     } else {
@@ -384,3 +986,11 @@ and evaluateFuture = (lv: int, e: RawExpr.t, venv: ValEnv.t, nenv: NameEnv.t): r
     }
   }
 }
+
+// Evaluates e at stage 0. A code value it returns comes with its code
+// generated, so errors in generating it are reported here.
+@genType
+let evaluateRuntime = (e: RawExpr.t, venv: ValEnv.t, nenv: NameEnv.t): result<
+  RuntimeVal.t,
+  evalError,
+> => evaluatePresent(e, venv, nenv)->Result.flatMap(RuntimeVal.force)
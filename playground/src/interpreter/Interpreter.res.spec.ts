@@ -1,8 +1,11 @@
-import { expect, it, beforeAll, describe } from 'vitest';
+import { expect, it, beforeAll, beforeEach, afterEach, describe } from 'vitest';
 import { Parser, Language } from 'web-tree-sitter';
 import { parseSourceFileNode } from './SyntaxNodeParser.gen.ts';
-import { stripTypeInfo } from './Expr.gen.ts';
+import { stripTypeInfo, toTypedRaw } from './Expr.gen.ts';
 import { evaluateRuntime, Env_make } from './Interpreter.gen.ts';
+import { setCapacity, stats, resetStats } from './Memo.gen.ts';
+import { typeCheckKeepingTypes, GlobalEnv_make } from './TypeChecker.gen.ts';
+import { setEnabled as setCodeSimplification } from './CodeBuilder.gen.ts';
 import { t as Expr_t } from './Expr.gen.ts'
 
 let parser;
@@ -12,6 +15,12 @@ const parse = (input) => {
     return stripTypeInfo(parseSourceFileNode((parser.parse(input)).rootNode)._0 as Expr_t);
 }
 
+const parseTyped = (input) => {
+    // Assume that parse and type check always succeed
+    const expr = parseSourceFileNode((parser.parse(input)).rootNode)._0 as Expr_t;
+    return toTypedRaw(expr, typeCheckKeepingTypes(expr, GlobalEnv_make())._0[1]);
+}
+
 beforeAll(
     async () => {
         await Parser.init();
@@ -514,6 +523,68 @@ describe('Recursive Functions', () => {
     });
 });
 
+describe('Memoized Recursive Functions', () => {
+    beforeEach(() => resetStats());
+    afterEach(() => setCapacity(4096));
+
+    it('compute each result once', () => {
+        const code = `
+          let rec memo fib = (n) => {
+            if n <= 1 then n else fib (n - 1) + fib (n - 2)
+          } in
+          fib 30
+        `
+        expect(evaluateRuntime(parse(code), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 832040 }
+        });
+        expect(stats()).toEqual({ hits: 28, misses: 31 });
+    });
+
+    it('key code structurally', () => {
+        const code = `
+          let rec memo twice = (c) => { \`{ ~{ c } + ~{ c } } } in
+          let a = twice \`{ 1 } in
+          twice \`{ 1 }
+        `
+        expect(evaluateRuntime(parse(code), venv, nenv)).toMatchObject({ TAG: "Ok", _0: { TAG: "Code" } });
+        expect(stats()).toEqual({ hits: 1, misses: 1 });
+    });
+
+    it('do not cache calls with closures', () => {
+        const code = 'let rec memo app = (f, x) => { f x } in app ((y) => { y + 1 }) 2'
+        expect(evaluateRuntime(parse(code), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 3 }
+        });
+        expect(stats()).toEqual({ hits: 0, misses: 0 });
+    });
+
+    it('do not cache calls that let-insert', () => {
+        const code = `
+          let rec memo share = (c) => { genlet c } in
+          let a = \`{ ~{ share \`{ 1 + 2 } } } in
+          let b = \`{ ~{ share \`{ 1 + 2 } } } in
+          ~0{ \`{ ~{ a } * ~{ b } } }
+        `
+        expect(evaluateRuntime(parse(code), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 9 }
+        });
+        expect(stats()).toEqual({ hits: 0, misses: 2 });
+    });
+
+    it('forget results beyond the capacity', () => {
+        setCapacity(1);
+        const code = 'let rec memo id = (x) => { x } in id 1 + id 2 + id 1'
+        expect(evaluateRuntime(parse(code), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 4 }
+        });
+        expect(stats()).toEqual({ hits: 0, misses: 3 });
+    });
+});
+
 describe('Recursive Functions', () => {
     describe('successfully', () => {
         it('quote', () => {
@@ -623,4 +694,463 @@ describe('big program', () => {
             }
         });
     })
-})
\ No newline at end of file
+})
+
+describe('Typed execution', () => {
+    describe('lowering', () => {
+        it('specializes arithmetic and comparison', () => {
+            expect(parseTyped('1 + 2 < 4')).toEqual({
+                TAG: "PrimOp",
+                op: "IntLt",
+                left: {
+                    TAG: "PrimOp",
+                    op: "IntAdd",
+                    left: { TAG: "IntLit", _0: 1 },
+                    right: { TAG: "IntLit", _0: 2 }
+                },
+                right: { TAG: "IntLit", _0: 4 }
+            });
+        });
+
+        it('specializes equality by operand type', () => {
+            expect(parseTyped('1 == 2')).toMatchObject({ TAG: "PrimOp", op: "IntEq" });
+            expect(parseTyped('true != false')).toMatchObject({ TAG: "PrimOp", op: "BoolNe" });
+        });
+
+        it('keeps equality on functions checked', () => {
+            const code = `
+              let f = (x: int) => { x } in
+              f == f
+            `
+            expect(parseTyped(code)).toMatchObject({ body: { TAG: "BinOp", op: "Eq" } });
+            expect(evaluateRuntime(parseTyped(code), venv, nenv)).toEqual({
+                TAG: "Error",
+                _0: "TypeMismatch"
+            });
+        });
+    });
+
+    describe('agrees with untyped execution', () => {
+        const programs = [
+            '(1 + 2) * 3 - 8 / 3',
+            '17 mod 5',
+            '7 / 2',
+            '3 <= 3 && 4 > 5 || !(1 != 1)',
+            'true == false',
+            'if 1 >= 2 then 10 else 20',
+            'let x = 5 in let y = x * x in y - x',
+            'let add = (x: int, y: int) => { x + y } in add 1 2',
+            `let rec fib = (n: int): int => {
+               if n < 2 then n else fib (n - 1) + fib (n - 2)
+             } in
+             fib 15`,
+        ];
+        for (const code of programs) {
+            it(code, () => {
+                expect(evaluateRuntime(parseTyped(code), venv, nenv))
+                    .toEqual(evaluateRuntime(parse(code), venv, nenv));
+            });
+        }
+    });
+
+    it('short-circuits', () => {
+        expect(evaluateRuntime(parseTyped('false && 1 / 0 == 1'), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "BoolVal", _0: false }
+        });
+        expect(evaluateRuntime(parseTyped('true || 1 / 0 == 1'), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "BoolVal", _0: true }
+        });
+    });
+
+    it('fails on division by zero', () => {
+        expect(evaluateRuntime(parseTyped('1 / 0'), venv, nenv)).toEqual({
+            TAG: "Error",
+            _0: "ZeroDivision"
+        });
+        expect(evaluateRuntime(parseTyped('1 mod 0'), venv, nenv)).toEqual({
+            TAG: "Error",
+            _0: "ZeroDivision"
+        });
+    });
+
+    it('keeps specialized operations in generated code', () => {
+        const code = `
+          let rec f = [g1:>!](x: <int@g1>):<int@g1> =>
+                        { \`{@g1 ~{ x } + 1 } } in
+          let c = \`{@! (y:int@g2) => { ~{ f^g2 \`{@g2 y } } } } in
+          ~0{ c } 41
+        `
+        expect(evaluateRuntime(parseTyped(code), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 42 }
+        });
+    });
+});
+
+describe('Inert quoted subtrees', () => {
+    it('returns a closed quote body as-is', () => {
+        const expr = parse('`{ (x) => { x + 1 } }');
+        const result = evaluateRuntime(expr, venv, nenv);
+        expect(result).toMatchObject({ TAG: "Ok", _0: { TAG: "Code" } });
+        expect(result._0._0).toBe(expr.expr);
+    });
+
+    it('rebuilds only the path to a splice', () => {
+        const expr = parse('let y = `{ 1 } in `{ ((x) => { x * 2 }) ~{ y } }');
+        const result = evaluateRuntime(expr, venv, nenv);
+        expect(result._0._0).toMatchObject({ TAG: "App", arg: { TAG: "IntLit", _0: 1 } });
+        expect(result._0._0.func).toBe(expr.body.expr.func);
+    });
+
+    it('keeps rejecting malformed let rec in quotes', () => {
+        expect(evaluateRuntime(parse('`{ let rec x = 1 in x }'), venv, nenv)).toEqual({
+            TAG: "Error",
+            _0: "UnsupportedForm"
+        });
+    });
+
+    it('keeps rejecting splices past the current level', () => {
+        expect(evaluateRuntime(parse('`{ ~2{ `{ 1 } } }'), venv, nenv)).toEqual({
+            TAG: "Error",
+            _0: "MalformedSplice"
+        });
+    });
+});
+
+describe('Simplifying code builder', () => {
+    beforeEach(() => setCodeSimplification(true));
+    afterEach(() => setCodeSimplification(false));
+
+    const genpow = (n) => `
+      let rec pow1 = [g1:>!](n: int, xq: <int@g1>):<int@g1> => {
+        if n == 0 then
+          \`{@g1 1 }
+        else
+          \`{@g1 ~{ xq } * ~{ pow1^g1 (n - 1) xq } }
+      } in
+      \`{@! (x:int@g2) => { ~{ pow1^g2 ${n} \`{@g2 x } } } }
+    `;
+
+    it('removes identities from generated code', () => {
+        const result = evaluateRuntime(parseTyped(genpow(1)), venv, nenv);
+        expect(result._0._0).toMatchObject({ TAG: "Func", body: { TAG: "Var" } });
+    });
+
+    it('folds constants and reduces redexes in generated code', () => {
+        const code = `
+          let two = \`{ 2 } in
+          \`{ ((x) => { x * ~{ two } + 1 }) 3 }
+        `
+        expect(evaluateRuntime(parse(code), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "Code", _0: { TAG: "IntLit", _0: 7 } }
+        });
+    });
+
+    it('keeps divisions by zero', () => {
+        const code = `
+          let zero = \`{ 0 } in
+          let c = \`{ 1 / ~{ zero } } in
+          ~0{ c }
+        `
+        expect(evaluateRuntime(parse(code), venv, nenv)).toEqual({
+            TAG: "Error",
+            _0: "ZeroDivision"
+        });
+    });
+
+    it('keeps branches that contain splices', () => {
+        const code = `
+          let y = \`{ 2 } in
+          \`{ if true then 1 else ~0{ y } }
+        `
+        expect(evaluateRuntime(parse(code), venv, nenv)).toMatchObject({
+            TAG: "Ok",
+            _0: { TAG: "Code", _0: { TAG: "If" } }
+        });
+    });
+
+    it('does not change results', () => {
+        const programs = [genpow(0), genpow(3)].map(g => `let c = ${g} in ~0{ c } 2`);
+        for (const code of programs) {
+            setCodeSimplification(false);
+            const expected = evaluateRuntime(parseTyped(code), venv, nenv);
+            setCodeSimplification(true);
+            expect(evaluateRuntime(parseTyped(code), venv, nenv)).toEqual(expected);
+        }
+    });
+});
+
+describe('genlet', () => {
+    const spower = (n) => `
+      let rec pow1 = (n, xq) => {
+        if n == 0 then
+          \`{ 1 }
+        else if n mod 2 == 0 then
+          pow1 (n / 2) (genlet \`{ ~{ xq } * ~{ xq } })
+        else
+          \`{ ~{ xq } * ~{ pow1 (n - 1) xq } }
+      } in
+      \`{ (x) => { ~{ pow1 ${n} \`{ x } } } }
+    `;
+
+    const size = (e) => e === null || typeof e !== 'object'
+        ? 0
+        : Object.values(e).reduce((acc, v) => acc + size(v), 1);
+
+    it('binds shared code once inside the nearest binder', () => {
+        const result = evaluateRuntime(parse(spower(8)), venv, nenv);
+        expect(result).toMatchObject({
+            TAG: "Ok",
+            _0: {
+                TAG: "Code",
+                _0: {
+                    TAG: "Func",
+                    body: {
+                        TAG: "Let",
+                        body: { TAG: "Let", body: { TAG: "Let" } }
+                    }
+                }
+            }
+        });
+    });
+
+    it('keeps generated code linear in the exponent', () => {
+        const size64 = size(evaluateRuntime(parse(spower(64)), venv, nenv)._0._0);
+        const size128 = size(evaluateRuntime(parse(spower(128)), venv, nenv)._0._0);
+        expect(size128).toBeLessThan(size64 * 2);
+    });
+
+    it('generates code computing the same result', () => {
+        expect(evaluateRuntime(parse(`let c = ${spower(10)} in ~0{ c } 2`), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 1024 }
+        });
+    });
+
+    it('binds at the quote when the code has no local variables', () => {
+        const code = '`{ (x) => { x + ~{ genlet `{ 1 + 2 } } } }'
+        expect(evaluateRuntime(parse(code), venv, nenv)).toMatchObject({
+            TAG: "Ok",
+            _0: { TAG: "Code", _0: { TAG: "Let", body: { TAG: "Func" } } }
+        });
+    });
+
+    it('returns code as-is outside of code generation', () => {
+        expect(evaluateRuntime(parse('genlet `{ 1 + 2 }'), venv, nenv)).toMatchObject({
+            TAG: "Ok",
+            _0: { TAG: "Code", _0: { TAG: "BinOp" } }
+        });
+    });
+
+    it('fails for non-code', () => {
+        expect(evaluateRuntime(parse('genlet 1'), venv, nenv)).toEqual({
+            TAG: "Error",
+            _0: "TypeMismatch"
+        });
+    });
+});
+
+describe('let cs', () => {
+    it('lifts literals into quotes', () => {
+        expect(evaluateRuntime(parse('let cs x = 1 in `{ x + 3 }'), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: {
+                TAG: "Code",
+                _0: { TAG: "BinOp", op: "Add", left: { TAG: "IntLit", _0: 1 }, right: { TAG: "IntLit", _0: 3 } }
+            }
+        });
+    });
+
+    it('carries other values into generated code', () => {
+        const code = `
+          let cs inc = (x) => { x + 1 } in
+          let c = \`{ inc 41 } in
+          ~0{ c }
+        `
+        expect(evaluateRuntime(parse('let cs inc = (x) => { x + 1 } in `{ inc 41 }'), venv, nenv)).toMatchObject({
+            TAG: "Ok",
+            _0: { TAG: "Code", _0: { TAG: "App", func: { TAG: "CsValue" } } }
+        });
+        expect(evaluateRuntime(parse(code), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 42 }
+        });
+    });
+
+    it('does not lift variables bound inside the quote', () => {
+        expect(evaluateRuntime(parse('let cs x = 1 in `{ (x) => { x } }'), venv, nenv)).toMatchObject({
+            TAG: "Ok",
+            _0: { TAG: "Code", _0: { TAG: "Func", body: { TAG: "Var" } } }
+        });
+    });
+
+    it('behaves like let at run time', () => {
+        expect(evaluateRuntime(parse('let cs x = 2 in x * 3'), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 6 }
+        });
+    });
+});
+
+describe('Lazy quotes', () => {
+    it('do not generate code that is never used', () => {
+        expect(evaluateRuntime(parse('let c = `{ ~{ 1 + true } } in 5'), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 5 }
+        });
+    });
+
+    it('report errors in generating code that is used', () => {
+        expect(evaluateRuntime(parse('let c = `{ ~{ 1 + true } } in ~0{ c }'), venv, nenv)).toEqual({
+            TAG: "Error",
+            _0: "TypeMismatch"
+        });
+        expect(evaluateRuntime(parse('`{ ~{ 1 + true } }'), venv, nenv)).toEqual({
+            TAG: "Error",
+            _0: "TypeMismatch"
+        });
+    });
+
+    it('generate code at most once', () => {
+        const result = evaluateRuntime(parse('let c = `{ ~{ `{ 1 } } + 1 } in `{ ~{ c } * ~{ c } }'), venv, nenv);
+        expect(result._0._0).toMatchObject({ TAG: "BinOp", op: "Mul" });
+        expect(result._0._0.left).toBe(result._0._0.right);
+    });
+});
+
+describe('Arrays', () => {
+    const sumOfSquares = `
+      Array.fold ((z, x) => { z + x }) 0
+        (Array.map ((x) => { x * x }) (Array.init 4 ((i) => { i + 1 })))
+    `;
+
+    it('run bulk operations', () => {
+        expect(evaluateRuntime(parse(sumOfSquares), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 30 }
+        });
+    });
+
+    it('run typed like untyped', () => {
+        const typed = `
+          Array.fold ((z:int, x:int) => { z + x }) 0
+            (Array.map ((x:int) => { x * x }) (Array.init 4 ((i:int) => { i + 1 })))
+        `;
+        expect(evaluateRuntime(parseTyped(typed), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 30 }
+        });
+    });
+
+    it('index and measure literals', () => {
+        expect(evaluateRuntime(parse('[| 1, 2, 3 |].(2) + Array.length [| |]'), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 3 }
+        });
+    });
+
+    it('fail out of bounds', () => {
+        for (const code of ['[| 1 |].(1)', '[| 1 |].(0 - 1)', 'Array.init (0 - 1) ((i) => { i })']) {
+            expect(evaluateRuntime(parse(code), venv, nenv)).toEqual({
+                TAG: "Error",
+                _0: "IndexOutOfBounds"
+            });
+        }
+    });
+
+    it('fail for elements that are not ints', () => {
+        expect(evaluateRuntime(parse('Array.map ((x) => { x == 1 }) [| 1 |]'), venv, nenv)).toEqual({
+            TAG: "Error",
+            _0: "TypeMismatch"
+        });
+    });
+
+    it('are residualized in quotes', () => {
+        const code = 'let cs a = [| 1, 2 |] in `{ Array.map ((x) => { x + 1 }) a }';
+        expect(evaluateRuntime(parse(code), venv, nenv)).toMatchObject({
+            TAG: "Ok",
+            _0: {
+                TAG: "Code",
+                _0: { TAG: "ArrayOp", op: "Map", args: { tl: { hd: { TAG: "ArrayOp", op: "Make" } } } }
+            }
+        });
+    });
+
+    it('run in generated code', () => {
+        const code = `
+          let cs a = [| 1, 2 |] in
+          let c = \`{ Array.fold ((z, x) => { z + x }) 0 (Array.map ((x) => { x + 1 }) a) } in
+          ~0{ c }
+        `;
+        expect(evaluateRuntime(parse(code), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 5 }
+        });
+    });
+
+    it('fold on literals in generated code', () => {
+        setCodeSimplification(true);
+        try {
+            expect(evaluateRuntime(parse('`{ Array.length [| 1, 2, 3 |] + [| 4, 5 |].(1) }'), venv, nenv)).toEqual({
+                TAG: "Ok",
+                _0: { TAG: "Code", _0: { TAG: "IntLit", _0: 8 } }
+            });
+        } finally {
+            setCodeSimplification(false);
+        }
+    });
+});
+
+describe('Tuples', () => {
+    it('project their components', () => {
+        expect(evaluateRuntime(parse('let p = (1 + 2, true) in if p.1 then p.0 else 0'), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 3 }
+        });
+    });
+
+    it('are returned from functions', () => {
+        const code = 'let divmod = (a, b) => { (a / b, a mod b) } in divmod 7 2';
+        expect(evaluateRuntime(parse(code), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "TupleVal", _0: [{ TAG: "IntVal", _0: 3 }, { TAG: "IntVal", _0: 1 }] }
+        });
+    });
+
+    it('carry code and its size out of a generator', () => {
+        const code = `
+          let rec gen = (n) => {
+            if n == 0 then (\`{ 1 }, 0)
+            else let r = gen (n - 1) in (\`{ ~{ r.0 } * 2 }, r.1 + 1)
+          } in
+          let r = gen 3 in
+          ~0{ r.0 } + r.1
+        `;
+        expect(evaluateRuntime(parse(code), venv, nenv)).toEqual({
+            TAG: "Ok",
+            _0: { TAG: "IntVal", _0: 11 }
+        });
+    });
+
+    it('fail to project from other values', () => {
+        expect(evaluateRuntime(parse('let p = 1 in p.0'), venv, nenv)).toEqual({
+            TAG: "Error",
+            _0: "TypeMismatch"
+        });
+    });
+
+    it('fold projections of literals in generated code', () => {
+        setCodeSimplification(true);
+        try {
+            expect(evaluateRuntime(parse('`{ (1, x).1 }'), venv, nenv)).toMatchObject({
+                TAG: "Ok",
+                _0: { TAG: "Code", _0: { TAG: "Var" } }
+            });
+        } finally {
+            setCodeSimplification(false);
+        }
+    });
+});
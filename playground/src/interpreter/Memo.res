@@ -0,0 +1,90 @@
+// The result caches of functions bound by let rec memo. Every closure made
+// by evaluating such a let rec owns a table from the values of its
+// arguments to its result. Only ints, booleans and code are keys; code is
+// compared structurally (Sharing.hash and Sharing.equal), so a generator
+// asked again for code it has seen returns what it generated the first time.
+// Calls that let-insert with genlet are not cached (see Interpreter).
+//
+// A table holding capacity entries is emptied before the next one is added,
+// which bounds the memory of a function called with ever new arguments.
+
+let capacity = ref(4096)
+
+@genType
+let setCapacity = (n: int): unit => capacity := n
+
+type part = Int(int) | Bool(bool) | Code(RawExpr.t)
+
+type key = {hash: int, parts: array<part>}
+
+let hashPart = (p: part): int =>
+  switch p {
+  | Int(i) => Sharing.mix(1, i)
+  | Bool(b) => b ? 2 : 3
+  | Code(e) => Sharing.mix(4, Sharing.hash(e))
+  }
+
+let makeKey = (parts: array<part>): key => {
+  hash: parts->Array.reduce(0, (h, p) => Sharing.mix(h, hashPart(p))),
+  parts,
+}
+
+let equalPart = (a: part, b: part): bool =>
+  switch (a, b) {
+  | (Int(x), Int(y)) => x == y
+  | (Bool(x), Bool(y)) => x == y
+  | (Code(x), Code(y)) => Sharing.equal(x, y)
+  | _ => false
+  }
+
+let equalKey = (a: key, b: key): bool =>
+  a.hash == b.hash &&
+  Array.length(a.parts) == Array.length(b.parts) &&
+  a.parts->Array.everyWithIndex((p, i) => equalPart(p, b.parts->Array.getUnsafe(i)))
+
+// Keys are bucketed by hash; a bucket rarely holds more than one.
+type t<'v> = {buckets: Map.t<int, array<(key, 'v)>>, mutable size: int}
+
+let make = (): t<'v> => {buckets: Map.make(), size: 0}
+
+// Lookups over all tables since the last reset.
+let hits = ref(0)
+let misses = ref(0)
+
+@genType
+type stats = {hits: int, misses: int}
+
+@genType
+let stats = (): stats => {hits: hits.contents, misses: misses.contents}
+
+@genType
+let resetStats = (): unit => {
+  hits := 0
+  misses := 0
+}
+
+let find = (table: t<'v>, key: key): option<'v> => {
+  let found =
+    table.buckets
+    ->Map.get(key.hash)
+    ->Option.flatMap(bucket => bucket->Array.find(((k, _)) => equalKey(k, key)))
+    ->Option.map(((_, v)) => v)
+  switch found {
+  | Some(_) => hits := hits.contents + 1
+  | None => misses := misses.contents + 1
+  }
+  found
+}
+
+let add = (table: t<'v>, key: key, value: 'v): unit =>
+  if capacity.contents > 0 {
+    if table.size >= capacity.contents {
+      table.buckets->Map.clear
+      table.size = 0
+    }
+    switch table.buckets->Map.get(key.hash) {
+    | Some(bucket) => bucket->Array.push((key, value))
+    | None => table.buckets->Map.set(key.hash, [(key, value)])
+    }
+    table.size = table.size + 1
+  }
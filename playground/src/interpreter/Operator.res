@@ -54,4 +54,73 @@ module UniOp = {
     | Not => "!"
     }
   }
-}
\ No newline at end of file
+}
+
+// Primitive operations specialized to the operand types inferred by the type
+// checker (see Expr.toTypedRaw). Each names one case of the evaluator, so it
+// need not work out which from the operands.
+module PrimOp = {
+  type t =
+    // Arithmetic
+    | IntAdd
+    | IntSub
+    | IntMul
+    | IntDiv
+    | IntMod
+    // Comparison
+    | IntEq
+    | IntNe
+    | IntLt
+    | IntLe
+    | IntGt
+    | IntGe
+    | BoolEq
+    | BoolNe
+    // Logical (short-circuit)
+    | BoolAnd
+    | BoolOr
+
+  let toString = (op: t): string => {
+    switch op {
+    | IntAdd => "+"
+    | IntSub => "-"
+    | IntMul => "*"
+    | IntDiv => "/"
+    | IntMod => "%"
+    | IntEq | BoolEq => "=="
+    | IntNe | BoolNe => "!="
+    | IntLt => "<"
+    | IntLe => "<="
+    | IntGt => ">"
+    | IntGe => ">="
+    | BoolAnd => "&&"
+    | BoolOr  => "||"
+    }
+  }
+}
+
+// Operations on arrays of ints. Their operands are listed in the order the
+// syntax gives them: Get takes the array and then the index, Init the size
+// and then the function, Map the function and then the array, and Fold the
+// function, the initial accumulator and then the array. Make takes the
+// elements.
+module ArrayOp = {
+  type t =
+    | Make
+    | Length
+    | Get
+    | Init
+    | Map
+    | Fold
+
+  let toString = (op: t): string => {
+    switch op {
+    | Make => "[| |]"
+    | Length => "Array.length"
+    | Get => ".()"
+    | Init => "Array.init"
+    | Map => "Array.map"
+    | Fold => "Array.fold"
+    }
+  }
+}
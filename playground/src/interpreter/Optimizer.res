@@ -0,0 +1,331 @@
+// Whole-program optimizer over RawExpr.t, run on source programs before
+// evaluation and on code values when they are run with a level-0 splice.
+//
+// Passes rewrite only code that runs at level 0. Quoted code is walked only
+// to reach the splices that return to level 0, since rewriting it would
+// change the code values a program builds. Binders shadow at every level: a
+// future-stage binder renames its variable for the splices beneath it too.
+// Every rewrite preserves what the program evaluates to, errors included.
+
+open RawExpr
+
+type vars = Belt.Set.t<Var.t, Var.Cmp.identity>
+
+let noVars: vars = Belt.Set.make(~id=module(Var.Cmp))
+
+let rec freeVars = (e: t): vars =>
+  switch e {
+  | Var(v) => noVars->Belt.Set.add(v)
+  | IntLit(_) | BoolLit(_) | CsValue(_) => noVars
+  | Func({params, body}) => freeVars(body)->Belt.Set.removeMany(params->Belt.List.toArray)
+  | App({func: left, arg: right})
+  | BinOp({left, right})
+  | ShortCircuitOp({left, right})
+  | PrimOp({left, right}) =>
+    Belt.Set.union(freeVars(left), freeVars(right))
+  | Let({param, expr, body}) | LetCs({param, expr, body}) =>
+    Belt.Set.union(freeVars(expr), freeVars(body)->Belt.Set.remove(param))
+  | LetRec({param, expr, body}) =>
+    Belt.Set.union(freeVars(expr), freeVars(body))->Belt.Set.remove(param)
+  | UniOp({expr}) | PrimNot({expr}) | GenLet({expr}) | Quote({expr}) | Splice({expr}) =>
+    freeVars(expr)
+  | ArrayOp({args}) | Tuple(args) =>
+    args->Belt.List.reduce(noVars, (acc, arg) => Belt.Set.union(acc, freeVars(arg)))
+  | Proj({tuple}) => freeVars(tuple)
+  | If({cond, thenBranch, elseBranch}) =>
+    Belt.Set.union(freeVars(cond), Belt.Set.union(freeVars(thenBranch), freeVars(elseBranch)))
+  }
+
+let rec size = (e: t): int =>
+  switch e {
+  | Var(_) | IntLit(_) | BoolLit(_) | CsValue(_) => 1
+  | Func({body}) => 1 + size(body)
+  | App({func: left, arg: right})
+  | BinOp({left, right})
+  | ShortCircuitOp({left, right})
+  | PrimOp({left, right})
+  | Let({expr: left, body: right})
+  | LetCs({expr: left, body: right})
+  | LetRec({expr: left, body: right}) =>
+    1 + size(left) + size(right)
+  | UniOp({expr}) | PrimNot({expr}) | GenLet({expr}) | Quote({expr}) | Splice({expr}) =>
+    1 + size(expr)
+  | ArrayOp({args}) | Tuple(args) => args->Belt.List.reduce(1, (acc, arg) => acc + size(arg))
+  | Proj({tuple}) => 1 + size(tuple)
+  | If({cond, thenBranch, elseBranch}) => 1 + size(cond) + size(thenBranch) + size(elseBranch)
+  }
+
+// Rebuilds e with f applied to each child. f receives the level the child is
+// evaluated at and the variables the node binds around it. A splice that
+// would fail with MalformedSplice is left alone.
+let mapChildren = (e: t, lv: int, f: (int, list<Var.t>, t) => t): t => {
+  let sub = child => f(lv, list{}, child)
+
+  switch e {
+  | Var(_) | IntLit(_) | BoolLit(_) | CsValue(_) => e
+  | Func({params, body}) => Func({params, body: f(lv, params, body)})
+  | App({func, arg}) => App({func: sub(func), arg: sub(arg)})
+  | Let({param, expr, body}) => Let({param, expr: sub(expr), body: f(lv, list{param}, body)})
+  | LetCs({param, expr, body}) => LetCs({param, expr: sub(expr), body: f(lv, list{param}, body)})
+  | LetRec({param, expr, body, memo}) =>
+    LetRec({param, expr: f(lv, list{param}, expr), body: f(lv, list{param}, body), memo})
+  | BinOp({op, left, right}) => BinOp({op, left: sub(left), right: sub(right)})
+  | ShortCircuitOp({op, left, right}) => ShortCircuitOp({op, left: sub(left), right: sub(right)})
+  | PrimOp({op, left, right}) => PrimOp({op, left: sub(left), right: sub(right)})
+  | UniOp({op, expr}) => UniOp({op, expr: sub(expr)})
+  | PrimNot({expr}) => PrimNot({expr: sub(expr)})
+  | GenLet({expr}) => GenLet({expr: sub(expr)})
+  | ArrayOp({op, args}) => ArrayOp({op, args: args->Belt.List.map(sub)})
+  | Tuple(elements) => Tuple(elements->Belt.List.map(sub))
+  | Proj({tuple, index}) => Proj({tuple: sub(tuple), index})
+  | If({cond, thenBranch, elseBranch}) =>
+    If({cond: sub(cond), thenBranch: sub(thenBranch), elseBranch: sub(elseBranch)})
+  | Quote({expr}) => Quote({expr: f(lv + 1, list{}, expr)})
+  | Splice({shift, expr}) =>
+    if shift == lv {
+      Splice({shift, expr: f(0, list{}, expr)})
+    } else if shift < lv {
+      Splice({shift, expr: sub(expr)})
+    } else {
+      e
+    }
+  }
+}
+
+let unbind = (env: Belt.Map.t<Var.t, 'a, Var.Cmp.identity>, bound: list<Var.t>) =>
+  env->Belt.Map.removeMany(bound->Belt.List.toArray)
+
+// Replaces variables bound to literals by the literals and folds the
+// operations that become constant.
+let constantPropagation = (e: t, count: ref<int>): t => {
+  let rewrite = x => {
+    count := count.contents + 1
+    x
+  }
+  let fold = (e: t): t =>
+    switch e {
+    | BinOp({op, left, right}) =>
+      CodeBuilder.primOfBinOp(op, left)
+      ->Option.flatMap(prim => CodeBuilder.fold(prim, left, right))
+      ->Option.mapOr(e, rewrite)
+    | PrimOp({op, left, right}) => CodeBuilder.fold(op, left, right)->Option.mapOr(e, rewrite)
+    | UniOp({op: Operator.UniOp.Not, expr: BoolLit(b)}) | PrimNot({expr: BoolLit(b)}) =>
+      rewrite(BoolLit(!b))
+    | _ => e
+    }
+
+  let rec propagate = (env, lv, e) =>
+    switch e {
+    | Var(v) if lv == 0 => env->Belt.Map.get(v)->Option.mapOr(e, rewrite)
+    | Let({param, expr, body}) if lv == 0 =>
+      let expr1 = propagate(env, lv, expr)
+      let env1 = switch expr1 {
+      | IntLit(_) | BoolLit(_) => env->Belt.Map.set(param, expr1)
+      | _ => env->Belt.Map.remove(param)
+      }
+      Let({param, expr: expr1, body: propagate(env1, lv, body)})
+    | _ =>
+      let e1 = mapChildren(e, lv, (lv1, bound, child) =>
+        propagate(env->unbind(bound), lv1, child)
+      )
+      lv == 0 ? fold(e1) : e1
+    }
+
+  propagate(Belt.Map.make(~id=module(Var.Cmp)), 0, e)
+}
+
+// Functions up to this size are copied into the calls of their let-bound
+// name.
+let inlineSizeLimit = 24
+
+// Replaces let-bound names of small functions in call position by the
+// functions themselves, for knownCall to reduce. A name is not replaced
+// under a binder that would capture a free variable of its function.
+let inlining = (e: t, count: ref<int>): t => {
+  let shadow = (env, bound: list<Var.t>) =>
+    env
+    ->unbind(bound)
+    ->Belt.Map.keep((_, (_, free)) => !(bound->Belt.List.some(v => free->Belt.Set.has(v))))
+
+  let rec walk = (env, lv, e) =>
+    switch e {
+    | App({func: Var(v), arg}) if lv == 0 && env->Belt.Map.has(v) =>
+      count := count.contents + 1
+      let (func, _) = env->Belt.Map.getExn(v)
+      App({func, arg: walk(env, lv, arg)})
+    | Let({param, expr: Func(_) as func, body})
+      if lv == 0 && size(func) <= inlineSizeLimit && !CodeBuilder.hasStaging(func) =>
+      let func1 = walk(env, lv, func)
+      let env1 = env->shadow(list{param})->Belt.Map.set(param, (func1, freeVars(func1)))
+      Let({param, expr: func1, body: walk(env1, lv, body)})
+    | _ => mapChildren(e, lv, (lv1, bound, child) => walk(env->shadow(bound), lv1, child))
+    }
+
+  walk(Belt.Map.make(~id=module(Var.Cmp)), 0, e)
+}
+
+// Turns applications of function literals into lets, floating lets out of
+// the function position to reach them.
+let knownCall = (e: t, count: ref<int>): t => {
+  let rec reduce = (func: t, arg: t): option<t> =>
+    switch func {
+    | Func({params: list{param}, body}) => Some(Let({param, expr: arg, body}))
+    | Func({params: list{param, ...rest}, body}) =>
+      Some(Let({param, expr: arg, body: Func({params: rest, body})}))
+    | Let({param, expr, body}) if !(freeVars(arg)->Belt.Set.has(param)) =>
+      reduce(body, arg)->Option.map(body1 => Let({param, expr, body: body1}))
+    | _ => None
+    }
+
+  let rec walk = (lv, e) =>
+    switch mapChildren(e, lv, (lv1, _, child) => walk(lv1, child)) {
+    | App({func, arg}) as e1 if lv == 0 =>
+      switch reduce(func, arg) {
+      | Some(e2) =>
+        count := count.contents + 1
+        e2
+      | None => e1
+      }
+    | e1 => e1
+    }
+
+  walk(0, e)
+}
+
+// Removes lets whose variable is unused when evaluating the bound expression
+// cannot fail or have effects.
+let deadLet = (e: t, count: ref<int>): t => {
+  let rec walk = (lv, e) =>
+    switch mapChildren(e, lv, (lv1, _, child) => walk(lv1, child)) {
+    | Let({param, expr: IntLit(_) | BoolLit(_) | Func(_), body})
+    | LetRec({param, expr: Func(_), body})
+      if lv == 0 && !CodeBuilder.occurs(param, body) =>
+      count := count.contents + 1
+      body
+    | e1 => e1
+    }
+
+  walk(0, e)
+}
+
+// Selects the branch of conditionals and short-circuit operators whose
+// condition is a literal.
+let ifFolding = (e: t, count: ref<int>): t => {
+  let rewrite = x => {
+    count := count.contents + 1
+    x
+  }
+  let rec walk = (lv, e) => {
+    let e1 = mapChildren(e, lv, (lv1, _, child) => walk(lv1, child))
+    if lv != 0 {
+      e1
+    } else {
+      switch e1 {
+      | If({cond: BoolLit(b), thenBranch, elseBranch}) => rewrite(b ? thenBranch : elseBranch)
+      | If({
+          cond: UniOp({op: Operator.UniOp.Not, expr: cond}) | PrimNot({expr: cond}),
+          thenBranch,
+          elseBranch,
+        }) =>
+        rewrite(If({cond, thenBranch: elseBranch, elseBranch: thenBranch}))
+      | ShortCircuitOp({op: Operator.ShortCircuitOp.And, left: BoolLit(false) as left})
+      | ShortCircuitOp({op: Operator.ShortCircuitOp.Or, left: BoolLit(true) as left})
+      | PrimOp({op: Operator.PrimOp.BoolAnd, left: BoolLit(false) as left})
+      | PrimOp({op: Operator.PrimOp.BoolOr, left: BoolLit(true) as left}) =>
+        rewrite(left)
+      | ShortCircuitOp({
+          op: Operator.ShortCircuitOp.And,
+          left: BoolLit(true),
+          right: BoolLit(_) as right,
+        })
+      | ShortCircuitOp({
+          op: Operator.ShortCircuitOp.Or,
+          left: BoolLit(false),
+          right: BoolLit(_) as right,
+        })
+      | PrimOp({op: Operator.PrimOp.BoolAnd, left: BoolLit(true), right})
+      | PrimOp({op: Operator.PrimOp.BoolOr, left: BoolLit(false), right}) =>
+        rewrite(right)
+      | _ => e1
+      }
+    }
+  }
+
+  walk(0, e)
+}
+
+type pass = {
+  name: string,
+  run: (t, ref<int>) => t,
+  mutable enabled: bool,
+  mutable rewrites: int,
+}
+
+let pipeline: array<pass> = [
+  {name: "inlining", run: inlining, enabled: true, rewrites: 0},
+  {name: "knownCall", run: knownCall, enabled: true, rewrites: 0},
+  {name: "constantPropagation", run: constantPropagation, enabled: true, rewrites: 0},
+  {name: "ifFolding", run: ifFolding, enabled: true, rewrites: 0},
+  {name: "deadLet", run: deadLet, enabled: true, rewrites: 0},
+]
+
+// Rounds of the whole pipeline run on one program at most; each round
+// exposes work for the next, e.g. inlining feeds knownCall.
+let maxRounds = 4
+
+@genType
+let optimize = (e: t): t => {
+  let rec loop = (e, round) =>
+    if round >= maxRounds {
+      e
+    } else {
+      let before = pipeline->Array.reduce(0, (acc, pass) => acc + pass.rewrites)
+      let e1 = pipeline->Array.reduce(e, (e, pass) =>
+        if pass.enabled {
+          let count = ref(0)
+          let e1 = pass.run(e, count)
+          pass.rewrites = pass.rewrites + count.contents
+          e1
+        } else {
+          e
+        }
+      )
+      let after = pipeline->Array.reduce(0, (acc, pass) => acc + pass.rewrites)
+      after == before ? e1 : loop(e1, round + 1)
+    }
+
+  loop(e, 0)
+}
+
+// Code values run repeatedly, e.g. by a splice in a loop, are optimized
+// once. Dropped whenever the pipeline is reconfigured. Shared fragments are
+// bound first, so that neither the passes nor the run repeat them.
+let codeCache: ref<WeakMap.t<t, t>> = ref(WeakMap.make())
+
+let optimizeCode = (e: t): t =>
+  switch codeCache.contents->WeakMap.get(e) {
+  | Some(e1) => e1
+  | None =>
+    let e1 = optimize(Sharing.letBind(e))
+    codeCache.contents->WeakMap.set(e, e1)->ignore
+    e1
+  }
+
+// Returns false when there is no pass of that name.
+@genType
+let setPassEnabled = (name: string, enabled: bool): bool =>
+  switch pipeline->Array.find(pass => pass.name == name) {
+  | Some(pass) =>
+    pass.enabled = enabled
+    codeCache := WeakMap.make()
+    true
+  | None => false
+  }
+
+// The number of rewrites each pass has made since the last reset.
+@genType
+let statistics = (): array<(string, int)> =>
+  pipeline->Array.map(pass => (pass.name, pass.rewrites))
+
+@genType
+let resetStatistics = (): unit => pipeline->Array.forEach(pass => pass.rewrites = 0)
@@ -0,0 +1,111 @@
+import { expect, it, beforeAll, beforeEach, describe } from 'vitest';
+import { Parser, Language } from 'web-tree-sitter';
+import { parseSourceFileNode } from './SyntaxNodeParser.gen.ts';
+import { stripTypeInfo } from './Expr.gen.ts';
+import { evaluateRuntime, Env_make } from './Interpreter.gen.ts';
+import { optimize, setPassEnabled, statistics, resetStatistics } from './Optimizer.gen.ts';
+import { t as Expr_t } from './Expr.gen.ts'
+
+let parser;
+
+const parse = (input) => {
+    // Assume that parse always succeeds
+    return stripTypeInfo(parseSourceFileNode((parser.parse(input)).rootNode)._0 as Expr_t);
+}
+
+beforeAll(
+    async () => {
+        await Parser.init();
+        const parser1 = new Parser();
+        const lamgamma = await Language.load('public/tree-sitter-lamgamma_parser.wasm');
+        parser1.setLanguage(lamgamma);
+        parser = parser1;
+    }
+)
+
+beforeEach(() => {
+    resetStatistics();
+})
+
+const venv = Env_make();
+const nenv = Env_make();
+
+const run = (expr) => evaluateRuntime(expr, venv, nenv);
+
+describe('optimize', () => {
+    it('propagates constants and removes dead lets', () => {
+        expect(optimize(parse('let x = 2 in x * 3 + 1'))).toEqual({ TAG: "IntLit", _0: 7 });
+    });
+
+    it('inlines small functions and reduces known calls', () => {
+        expect(optimize(parse('let inc = (x) => { x + 1 } in inc 41'))).toEqual({ TAG: "IntLit", _0: 42 });
+        expect(optimize(parse('((x, y) => { x - y }) 5 3'))).toEqual({ TAG: "IntLit", _0: 2 });
+    });
+
+    it('folds conditionals on constants', () => {
+        expect(optimize(parse('if 1 < 2 then 10 else 1 / 0'))).toEqual({ TAG: "IntLit", _0: 10 });
+        expect(optimize(parse('false && 1 / 0 == 1'))).toEqual({ TAG: "BoolLit", _0: false });
+    });
+
+    it('keeps errors', () => {
+        const programs = ['let x = 1 / 0 in 5', 'let x = 1 in x + true', '1 mod 0', 'true && 1'];
+        for (const code of programs) {
+            expect(run(optimize(parse(code)))).toEqual(run(parse(code)));
+        }
+    });
+
+    it('does not inline under a binder capturing a free variable', () => {
+        const code = `
+          let y = 1 in
+          let f = (x) => { x + y } in
+          let y = 2 in
+          f 0
+        `
+        expect(run(optimize(parse(code)))).toEqual({ TAG: "Ok", _0: { TAG: "IntVal", _0: 1 } });
+    });
+
+    it('leaves quoted code alone', () => {
+        expect(optimize(parse('let x = 1 in `{ 1 + 1 }'))).toEqual(parse('`{ 1 + 1 }'));
+    });
+
+    it('optimizes splices that run at the current stage', () => {
+        const code = 'let x = 1 in `{ ~{ if x == 1 then `{ 2 } else `{ 3 } } }'
+        expect(optimize(parse(code))).toEqual(parse('`{ ~{ `{ 2 } } }'));
+    });
+
+    it('counts rewrites per pass', () => {
+        optimize(parse('let inc = (x) => { x + 1 } in inc 41'));
+        const stats = Object.fromEntries(statistics());
+        expect(stats.inlining).toBe(1);
+        expect(stats.knownCall).toBe(1);
+        expect(stats.constantPropagation).toBeGreaterThan(0);
+        expect(stats.deadLet).toBe(2);
+        expect(stats.ifFolding).toBe(0);
+    });
+
+    it('skips disabled passes', () => {
+        expect(setPassEnabled('constantPropagation', false)).toBe(true);
+        expect(optimize(parse('let x = 2 in x'))).toMatchObject({ TAG: "Let" });
+        expect(setPassEnabled('constantPropagation', true)).toBe(true);
+        expect(setPassEnabled('noSuchPass', false)).toBe(false);
+    });
+});
+
+describe('optimized execution', () => {
+    it('agrees with unoptimized execution', () => {
+        const genpow = `
+          let rec pow1 = (n, xq) => {
+            if n == 0 then
+              \`{ 1 }
+            else
+              \`{ ~{ xq } * ~{ pow1 (n-1) xq } }
+          } in
+          let pow = (n) => {
+            \`{ (x) => { ~{ pow1 n \`{ x } } } }
+          } in
+          let pow4 = ~0{ pow 4 } in
+          pow4 2
+        `
+        expect(run(optimize(parse(genpow)))).toEqual(run(parse(genpow)));
+    });
+});
@@ -0,0 +1,202 @@
+// Lays generated code out within a line width and streams it to a sink
+// piece by piece, so a large specialization is never held as one string. A
+// subtree that fits in the rest of the line is written as RawExpr.toString
+// writes it; one that does not is broken into lines, its children indented.
+// Deciding whether a subtree fits looks at no more than a line's worth of
+// it, so printing takes time linear in the size of the code for a given
+// width.
+
+@genType
+type options = {
+  width: int,
+  // Characters to write before giving up with truncationMarker.
+  limit: option<int>,
+}
+
+let defaultOptions = {width: 80, limit: None}
+
+let truncationMarker = " …"
+
+type state = {
+  out: string => unit,
+  width: int,
+  limit: int,
+  mutable column: int,
+  mutable written: int,
+}
+
+exception Truncated
+exception TooWide
+
+let emit = (st: state, s: string): unit => {
+  let n = String.length(s)
+  if st.written + n > st.limit {
+    st.out(s->String.slice(~start=0, ~end=st.limit - st.written))
+    st.out(truncationMarker)
+    raise(Truncated)
+  }
+  st.out(s)
+  st.written = st.written + n
+  st.column = st.column + n
+}
+
+let newline = (st: state, indent: int): unit => {
+  emit(st, "\n" ++ String.repeat(" ", indent))
+  st.column = indent
+}
+
+let fits = (e: RawExpr.t, room: int): bool => {
+  let used = ref(0)
+  switch RawExpr.write(e, s => {
+    used := used.contents + String.length(s)
+    if used.contents > room {
+      raise(TooWide)
+    }
+  }) {
+  | () => true
+  | exception TooWide => false
+  }
+}
+
+let rec layout = (st: state, e: RawExpr.t, indent: int): unit =>
+  if fits(e, st.width - st.column) {
+    RawExpr.write(e, emit(st, ...))
+  } else {
+    let infix = (left, op, right) => {
+      emit(st, "(")
+      layout(st, left, indent + 1)
+      emit(st, ` ${op}`)
+      newline(st, indent + 1)
+      layout(st, right, indent + 1)
+      emit(st, ")")
+    }
+    let let_ = (keyword, param, expr, body) => {
+      emit(st, `${keyword}${Var.toString(param)} = `)
+      layout(st, expr, indent + 2)
+      emit(st, " in")
+      newline(st, indent + 1)
+      layout(st, body, indent + 1)
+      emit(st, ")")
+    }
+    let block = (opening, expr) => {
+      emit(st, opening)
+      newline(st, indent + 2)
+      layout(st, expr, indent + 2)
+      newline(st, indent)
+      emit(st, "}")
+    }
+    let prefix = (opening, expr) => {
+      emit(st, opening)
+      layout(st, expr, indent + 2)
+      emit(st, ")")
+    }
+
+    switch e {
+    | Var(_) | IntLit(_) | BoolLit(_) | CsValue(_) => RawExpr.write(e, emit(st, ...))
+    | Func({params, body}) =>
+      let params = params->Belt.List.map(Var.toString)->Belt.List.toArray->Array.join(", ")
+      block(`(${params}) => {`, body)
+    | App({func, arg}) =>
+      emit(st, "( ")
+      layout(st, func, indent + 2)
+      newline(st, indent + 2)
+      layout(st, arg, indent + 2)
+      emit(st, " )")
+    | Let({param, expr, body}) => let_("(let ", param, expr, body)
+    | LetRec({param, expr, body, memo}) => let_(memo ? "(let rec memo " : "(let rec ", param, expr, body)
+    | LetCs({param, expr, body}) => let_("(let cs ", param, expr, body)
+    | BinOp({op, left, right}) => infix(left, Operator.BinOp.toString(op), right)
+    | ShortCircuitOp({op, left, right}) =>
+      infix(left, Operator.ShortCircuitOp.toString(op), right)
+    | PrimOp({op, left, right}) => infix(left, Operator.PrimOp.toString(op), right)
+    | UniOp({op, expr}) => prefix(`(${Operator.UniOp.toString(op)} `, expr)
+    | PrimNot({expr}) => prefix(`(${Operator.UniOp.toString(Operator.UniOp.Not)} `, expr)
+    | GenLet({expr}) => prefix("(genlet ", expr)
+    | ArrayOp({op: Operator.ArrayOp.Make, args}) =>
+      emit(st, "[|")
+      args->Belt.List.forEachWithIndex((i, arg) => {
+        if i > 0 {
+          emit(st, ",")
+        }
+        newline(st, indent + 2)
+        layout(st, arg, indent + 2)
+      })
+      newline(st, indent)
+      emit(st, "|]")
+    | ArrayOp({op: Operator.ArrayOp.Get, args: list{array, index}}) =>
+      emit(st, "(")
+      layout(st, array, indent + 1)
+      emit(st, ".(")
+      layout(st, index, indent + 3)
+      emit(st, "))")
+    | ArrayOp({op, args}) =>
+      emit(st, `(${Operator.ArrayOp.toString(op)}`)
+      args->Belt.List.forEach(arg => {
+        newline(st, indent + 2)
+        layout(st, arg, indent + 2)
+      })
+      emit(st, ")")
+    | Tuple(elements) =>
+      emit(st, "(")
+      elements->Belt.List.forEachWithIndex((i, element) => {
+        if i > 0 {
+          emit(st, ",")
+          newline(st, indent + 1)
+        }
+        layout(st, element, indent + 1)
+      })
+      emit(st, ")")
+    | Proj({tuple, index}) =>
+      emit(st, "(")
+      layout(st, tuple, indent + 1)
+      emit(st, `.${Int.toString(index)})`)
+    | If({cond, thenBranch, elseBranch}) =>
+      emit(st, "(if ")
+      layout(st, cond, indent + 4)
+      newline(st, indent + 1)
+      emit(st, "then ")
+      layout(st, thenBranch, indent + 6)
+      newline(st, indent + 1)
+      emit(st, "else ")
+      layout(st, elseBranch, indent + 6)
+      emit(st, ")")
+    | Quote({expr}) => block("`{", expr)
+    | Splice({shift, expr}) => block(`~${shift->Int.toString}{`, expr)
+    }
+  }
+
+let withState = (out: string => unit, options: options, f: state => unit): unit => {
+  let st = {
+    out,
+    width: options.width,
+    limit: options.limit->Option.getOr(Int.Constants.maxValue),
+    column: 0,
+    written: 0,
+  }
+  try {
+    f(st)
+  } catch {
+  | Truncated => ()
+  }
+}
+
+// Writes e to out. The pieces carry no meaning of their own; out may
+// forward them anywhere or collect them.
+@genType
+let print = (e: RawExpr.t, out: string => unit, options: options): unit =>
+  withState(out, options, st => layout(st, e, 0))
+
+@genType
+let printValue = (v: Interpreter.RuntimeVal.t, out: string => unit, options: options): unit =>
+  switch Interpreter.RuntimeVal.code(v) {
+  | Some(Ok(expr)) => print(Quote({expr: Sharing.letBind(expr)}), out, options)
+  | Some(Error(_)) => withState(out, options, st => emit(st, "error"))
+  | None => withState(out, options, st => emit(st, Interpreter.RuntimeVal.toString(v)))
+  }
+
+@genType
+let valueToString = (v: Interpreter.RuntimeVal.t, options: options): string => {
+  let pieces = []
+  printValue(v, piece => pieces->Array.push(piece), options)
+  pieces->Array.join("")
+}
@@ -0,0 +1,80 @@
+import { expect, it, beforeAll, describe } from 'vitest';
+import { Parser, Language } from 'web-tree-sitter';
+import { parseSourceFileNode } from './SyntaxNodeParser.gen.ts';
+import { stripTypeInfo } from './Expr.gen.ts';
+import { evaluateRuntime, Env_make, RuntimeVal_toString } from './Interpreter.gen.ts';
+import { print, valueToString } from './Printer.gen.ts';
+import { t as Expr_t } from './Expr.gen.ts'
+
+let parser;
+
+const parse = (input) => {
+    // Assume that parse always succeeds
+    return stripTypeInfo(parseSourceFileNode((parser.parse(input)).rootNode)._0 as Expr_t);
+}
+
+beforeAll(
+    async () => {
+        await Parser.init();
+        const parser1 = new Parser();
+        const lamgamma = await Language.load('public/tree-sitter-lamgamma_parser.wasm');
+        parser1.setLanguage(lamgamma);
+        parser = parser1;
+    }
+)
+
+const venv = Env_make();
+const nenv = Env_make();
+
+// Assume that evaluation succeeds
+const run = (input) => evaluateRuntime(parse(input), venv, nenv)._0;
+
+const genpow = (n) => `
+  let rec pow1 = (n, xq) => {
+    if n == 0 then
+      \`{ 1 }
+    else
+      \`{ ~{ xq } * ~{ pow1 (n-1) xq } }
+  } in
+  \`{ (x) => { if x == 0 then 0 else ~{ pow1 ${n} \`{ x } } } }
+`
+
+describe('valueToString', () => {
+    it('prints code that fits on a line like toString', () => {
+        const value = run(genpow(3));
+        expect(valueToString(value, { width: 1000 })).toBe(RuntimeVal_toString(value));
+    });
+
+    it('prints other values like toString', () => {
+        expect(valueToString(run('1 + 2'), { width: 80 })).toBe('3');
+        expect(valueToString(run('(x) => { x }'), { width: 80 })).toBe('#<closure>');
+    });
+
+    it('breaks code into indented lines within the width', () => {
+        const printed = valueToString(run(genpow(12)), { width: 40 });
+        const lines = printed.split('\n');
+        expect(lines.length).toBeGreaterThan(1);
+        for (const line of lines) {
+            expect(line.length).toBeLessThanOrEqual(40);
+        }
+        expect(lines[0]).toBe('`{');
+        expect(lines[1]).toMatch(/^ {2}\(x_\d+\) => \{$/);
+        expect(printed.replace(/\s+/g, '')).toBe(RuntimeVal_toString(run(genpow(12))).replace(/\s+/g, ''));
+    });
+
+    it('truncates output beyond the limit', () => {
+        const printed = valueToString(run(genpow(50)), { width: 80, limit: 100 });
+        expect(printed.endsWith(' …')).toBe(true);
+        expect(printed.length).toBe(102);
+    });
+});
+
+describe('print', () => {
+    it('streams the output in pieces', () => {
+        const pieces: string[] = [];
+        const code = run(genpow(20))._0;
+        print(code, (piece) => { pieces.push(piece) }, { width: 80 });
+        expect(pieces.length).toBeGreaterThan(20);
+        expect(Math.max(...pieces.map((p) => p.length))).toBeLessThan(80);
+    });
+});
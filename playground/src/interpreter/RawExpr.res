@@ -1,3 +1,9 @@
+// A stage-0 value carried by generated code (see Interpreter.RuntimeVal.persist).
+module Persistent = {
+  @genType
+  type t
+}
+
 @genType
 type rec t =
   // basic syntax
@@ -5,7 +11,7 @@ type rec t =
   | Func({params: list<Var.t>, body: t})
   | App({func: t, arg: t})
   | Let({param: Var.t, expr: t, body: t})
-  | LetRec({param: Var.t, expr: t, body: t})
+  | LetRec({param: Var.t, expr: t, body: t, memo: bool})
   // // primitive operations
   | IntLit(int)
   | BoolLit(bool)
@@ -13,45 +19,137 @@ type rec t =
   | ShortCircuitOp({op: Operator.ShortCircuitOp.t, left: t, right: t})
   | UniOp({op: Operator.UniOp.t, expr: t})
   | If({cond: t, thenBranch: t, elseBranch: t})
+  // arrays of ints; args in the order of Operator.ArrayOp
+  | ArrayOp({op: Operator.ArrayOp.t, args: list<t>})
+  // unboxed tuples of two or more elements, and their projections from 0
+  | Tuple(list<t>)
+  | Proj({tuple: t, index: int})
+  // primitive operations specialized by type (see Expr.toTypedRaw)
+  | PrimOp({op: Operator.PrimOp.t, left: t, right: t})
+  | PrimNot({expr: t})
   // staging constructs
   | Quote({expr: t})
   | Splice({shift: int, expr: t})
-// | LetCs({ var: Var.t, expr: t, body: t})
+  | GenLet({expr: t})
+  // cross-stage persistence
+  | LetCs({param: Var.t, expr: t, body: t})
+  | CsValue({var: Var.t, value: Persistent.t})
 // | LetRecCs({ var: Var.t, expr: t, body: t})
 // | Serialize(t)
 
-let rec toString = (expr: t): string => {
+// Writes the text of expr piece by piece, so that callers can stream it or
+// stop early instead of building it by concatenation.
+let rec write = (expr: t, out: string => unit): unit => {
   switch expr {
-  | Var(v) => Var.toString(v)
+  | Var(v) => out(Var.toString(v))
   | Func({params, body}) =>
-    let paramsStr = {
-      switch params->Belt.List.map(Var.toString) {
-      | list{} => ""
-      | list{head, ...tail} => tail->Belt.List.reduce(head, (acc, x) => acc ++ ", " ++ x)
+    out("(")
+    params->Belt.List.forEachWithIndex((i, param) => {
+      if i > 0 {
+        out(", ")
       }
-    }
-    let bodyStr = toString(body)
-    `(${paramsStr}) => { ${bodyStr} }`
-  | App({func, arg}) => `( ${toString(func)} ${toString(arg)} )`
-  | Let({param, expr, body}) =>
-    `(let ${Var.toString(param)} = ${toString(expr)} in ${toString(body)})`
-  | LetRec({param, expr, body}) =>
-    `(let rec ${Var.toString(param)} = ${toString(expr)} in ${toString(body)})`
-  | IntLit(i) => i->Int.toString
-  | BoolLit(b) =>
-    if b {
-      "true"
-    } else {
-      "false"
-    }
-  | BinOp({op, left, right}) =>
-    `(${toString(left)} ${Operator.BinOp.toString(op)} ${toString(right)})`
+      out(Var.toString(param))
+    })
+    out(") => { ")
+    write(body, out)
+    out(" }")
+  | App({func, arg}) =>
+    out("( ")
+    write(func, out)
+    out(" ")
+    write(arg, out)
+    out(" )")
+  | Let({param, expr, body}) => writeLet("(let ", param, expr, body, out)
+  | LetRec({param, expr, body, memo}) =>
+    writeLet(memo ? "(let rec memo " : "(let rec ", param, expr, body, out)
+  | LetCs({param, expr, body}) => writeLet("(let cs ", param, expr, body, out)
+  | IntLit(i) => out(i->Int.toString)
+  | BoolLit(b) => out(b ? "true" : "false")
+  | BinOp({op, left, right}) => writeInfix(left, Operator.BinOp.toString(op), right, out)
   | ShortCircuitOp({op, left, right}) =>
-    `(${toString(left)} ${Operator.ShortCircuitOp.toString(op)} ${toString(right)})`
-  | UniOp({op, expr}) => `(${Operator.UniOp.toString(op)} ${toString(expr)})`
+    writeInfix(left, Operator.ShortCircuitOp.toString(op), right, out)
+  | PrimOp({op, left, right}) => writeInfix(left, Operator.PrimOp.toString(op), right, out)
+  | UniOp({op, expr}) =>
+    out(`(${Operator.UniOp.toString(op)} `)
+    write(expr, out)
+    out(")")
+  | PrimNot({expr}) =>
+    out(`(${Operator.UniOp.toString(Operator.UniOp.Not)} `)
+    write(expr, out)
+    out(")")
   | If({cond, thenBranch, elseBranch}) =>
-    `(if ${toString(cond)} then ${toString(thenBranch)} else ${toString(elseBranch)})`
-  | Quote({expr}) => `\`{ ${toString(expr)} }`
-  | Splice({shift, expr}) => `~${shift->Int.toString}{ ${toString(expr)} }`
+    out("(if ")
+    write(cond, out)
+    out(" then ")
+    write(thenBranch, out)
+    out(" else ")
+    write(elseBranch, out)
+    out(")")
+  | Quote({expr}) =>
+    out("`{ ")
+    write(expr, out)
+    out(" }")
+  | Splice({shift, expr}) =>
+    out(`~${shift->Int.toString}{ `)
+    write(expr, out)
+    out(" }")
+  | GenLet({expr}) =>
+    out("(genlet ")
+    write(expr, out)
+    out(")")
+  | ArrayOp({op: Operator.ArrayOp.Make, args}) =>
+    out("[|")
+    args->Belt.List.forEachWithIndex((i, arg) => {
+      out(i > 0 ? ", " : " ")
+      write(arg, out)
+    })
+    out(" |]")
+  | ArrayOp({op: Operator.ArrayOp.Get, args: list{array, index}}) =>
+    out("(")
+    write(array, out)
+    out(".(")
+    write(index, out)
+    out("))")
+  | ArrayOp({op, args}) =>
+    out(`(${Operator.ArrayOp.toString(op)}`)
+    args->Belt.List.forEach(arg => {
+      out(" ")
+      write(arg, out)
+    })
+    out(")")
+  | Tuple(elements) =>
+    out("(")
+    elements->Belt.List.forEachWithIndex((i, element) => {
+      if i > 0 {
+        out(", ")
+      }
+      write(element, out)
+    })
+    out(")")
+  | Proj({tuple, index}) =>
+    out("(")
+    write(tuple, out)
+    out(`.${index->Int.toString})`)
+  | CsValue({var}) => out(`%${Var.toString(var)}`)
   }
 }
+and writeLet = (keyword: string, param: Var.t, expr: t, body: t, out: string => unit): unit => {
+  out(`${keyword}${Var.toString(param)} = `)
+  write(expr, out)
+  out(" in ")
+  write(body, out)
+  out(")")
+}
+and writeInfix = (left: t, op: string, right: t, out: string => unit): unit => {
+  out("(")
+  write(left, out)
+  out(` ${op} `)
+  write(right, out)
+  out(")")
+}
+
+let toString = (expr: t): string => {
+  let pieces = []
+  write(expr, piece => pieces->Array.push(piece))
+  pieces->Array.join("")
+}
@@ -0,0 +1,475 @@
+// A compact binary encoding of code values, so that generated code can be
+// stored and loaded again without printing and reparsing it.
+//
+// An encoding is the magic bytes "LG", a format version, the table of
+// variable names and then the expression in prefix order. Each node is a
+// one-byte tag followed by its operands. Numbers (literals, shifts, counts,
+// name indices and variable ids) are LEB128 varints, literals zigzag-encoded
+// first so that small negative numbers stay short. A variable refers to its
+// name by index, so every name is stored once however often it occurs.
+//
+//   tag  node             operands
+//   0    Var              var
+//   1    Func             count, var...,  body
+//   2    App              func, arg
+//   3    Let              var, expr, body
+//   4    LetRec           var, expr, body
+//   5    IntLit           zigzag value
+//   6/7  BoolLit          (false/true)
+//   8    BinOp            operator, left, right
+//   9    ShortCircuitOp   operator, left, right
+//   10   UniOp            operator, expr
+//   11   If               cond, then, else
+//   12   PrimOp           operator, left, right
+//   13   PrimNot          expr
+//   14   Quote            expr
+//   15   Splice           shift, expr
+//   16   GenLet           expr
+//   17   LetCs            var, expr, body
+//   18   (shared)         node
+//   19   (reference)      index
+//   20   LetRec (memo)    var, expr, body
+//   21   ArrayOp          operator, count, arg...
+//   22   Tuple            count, element...
+//   23   Proj             index, tuple
+//
+// A var is its name index times two, plus one when it is colored, in which
+// case the id follows. CsValue has no encoding: the value it carries only
+// exists in the process that generated the code.
+//
+// Code values are DAGs (see Sharing). A node with more than one parent is
+// written once, prefixed by tag 18, which numbers it in order of appearance;
+// every later occurrence is tag 19 and that number. Decoding restores the
+// sharing. Version 2 added tags 18 and 19, and version 3 tags 20 to 23;
+// earlier versions are still read.
+//
+// The reader decodes straight from the bytes it is given, which may be a
+// view into a larger buffer such as a loaded file. Only the names are copied
+// out, once each. The native engine reads the same format from a mapped file
+// (native/src/Serialize.h, `lamgamma load`).
+
+// Uint8Array, which genType cannot name by itself.
+@genType.import(("../shims/Uint8Array.shim.ts", "t"))
+type bytes
+
+external toBytes: Uint8Array.t => bytes = "%identity"
+external fromBytes: bytes => Uint8Array.t = "%identity"
+
+@genType
+type error =
+  | Unserializable
+  | BadHeader
+  | Truncated
+  | BadNumber
+  | BadTag(int)
+  | BadName(int)
+  | BadReference(int)
+  | TrailingBytes
+
+exception Malformed(error)
+
+let version = 3
+
+@get_index external getByte: (Uint8Array.t, int) => int = ""
+@set_index external setByte: (Uint8Array.t, int, int) => unit = ""
+@send external copyFrom: (Uint8Array.t, Uint8Array.t, int) => unit = "set"
+@send external subarray: (Uint8Array.t, int, int) => Uint8Array.t = "subarray"
+
+type textEncoder
+type textDecoder
+@new external makeTextEncoder: unit => textEncoder = "TextEncoder"
+@new external makeTextDecoder: unit => textDecoder = "TextDecoder"
+@send external encodeText: (textEncoder, string) => Uint8Array.t = "encode"
+@send external decodeText: (textDecoder, Uint8Array.t) => string = "decode"
+
+// Operators are encoded by their position in these tables.
+let binOps: array<Operator.BinOp.t> = [Add, Sub, Mul, Div, Mod, Eq, Ne, Lt, Le, Gt, Ge]
+let shortCircuitOps: array<Operator.ShortCircuitOp.t> = [And, Or]
+let uniOps: array<Operator.UniOp.t> = [Not]
+let primOps: array<Operator.PrimOp.t> = [
+  IntAdd,
+  IntSub,
+  IntMul,
+  IntDiv,
+  IntMod,
+  IntEq,
+  IntNe,
+  IntLt,
+  IntLe,
+  IntGt,
+  IntGe,
+  BoolEq,
+  BoolNe,
+  BoolAnd,
+  BoolOr,
+]
+let arrayOps: array<Operator.ArrayOp.t> = [Make, Length, Get, Init, Map, Fold]
+
+let zigzag = (n: int): int => Int.Bitwise.lxor(Int.Bitwise.lsl(n, 1), Int.Bitwise.asr(n, 31))
+let unzigzag = (n: int): int =>
+  Int.Bitwise.lxor(Int.Bitwise.lsr(n, 1), -Int.Bitwise.land(n, 1))
+
+module Writer = {
+  type t = {mutable buf: Uint8Array.t, mutable len: int}
+
+  let make = (): t => {buf: Uint8Array.fromLength(256), len: 0}
+
+  let reserve = (w: t, n: int): unit => {
+    let capacity = TypedArray.length(w.buf)
+    if w.len + n > capacity {
+      let buf1 = Uint8Array.fromLength(Math.Int.max(capacity * 2, w.len + n))
+      buf1->copyFrom(w.buf->subarray(0, w.len), 0)
+      w.buf = buf1
+    }
+  }
+
+  let byte = (w: t, b: int): unit => {
+    w->reserve(1)
+    w.buf->setByte(w.len, b)
+    w.len = w.len + 1
+  }
+
+  // n is read as an unsigned 32-bit number.
+  let rec uint = (w: t, n: int): unit =>
+    if Int.Bitwise.lsr(n, 7) == 0 {
+      w->byte(n)
+    } else {
+      w->byte(Int.Bitwise.lor(Int.Bitwise.land(n, 0x7f), 0x80))
+      w->uint(Int.Bitwise.lsr(n, 7))
+    }
+
+  let append = (w: t, bytes: Uint8Array.t): unit => {
+    let n = TypedArray.length(bytes)
+    w->reserve(n)
+    w.buf->copyFrom(bytes, w.len)
+    w.len = w.len + n
+  }
+
+  let contents = (w: t): Uint8Array.t => w.buf->subarray(0, w.len)
+}
+
+module Reader = {
+  type t = {bytes: Uint8Array.t, mutable pos: int, limit: int}
+
+  let make = (bytes: Uint8Array.t): t => {bytes, pos: 0, limit: TypedArray.length(bytes)}
+
+  let byte = (r: t): int =>
+    if r.pos >= r.limit {
+      raise(Malformed(Truncated))
+    } else {
+      let b = r.bytes->getByte(r.pos)
+      r.pos = r.pos + 1
+      b
+    }
+
+  let uint = (r: t): int => {
+    let rec go = (acc, shift) => {
+      let b = r->byte
+      let acc1 = Int.Bitwise.lor(acc, Int.Bitwise.lsl(Int.Bitwise.land(b, 0x7f), shift))
+      if Int.Bitwise.land(b, 0x80) == 0 {
+        acc1
+      } else if shift >= 28 {
+        raise(Malformed(BadNumber))
+      } else {
+        go(acc1, shift + 7)
+      }
+    }
+    go(0, 0)
+  }
+
+  // A number of items to follow, each taking at least a byte.
+  let count = (r: t): int => {
+    let n = r->uint
+    if n < 0 || n > r.limit - r.pos {
+      raise(Malformed(Truncated))
+    }
+    n
+  }
+
+  let string = (r: t, decoder: textDecoder): string => {
+    let n = r->count
+    let s = decoder->decodeText(r.bytes->subarray(r.pos, r.pos + n))
+    r.pos = r.pos + n
+    s
+  }
+}
+
+@genType
+let encode = (code: RawExpr.t): result<bytes, error> => {
+  let body = Writer.make()
+  let names: Map.t<string, int> = Map.make()
+  let nameTable = []
+
+  let nameIndex = (name: string): int =>
+    switch names->Map.get(name) {
+    | Some(i) => i
+    | None =>
+      let i = nameTable->Array.length
+      names->Map.set(name, i)
+      nameTable->Array.push(name)
+      i
+    }
+
+  let var = (v: Var.t): unit =>
+    switch v {
+    | Raw({name}) => body->Writer.uint(nameIndex(name) * 2)
+    | Colored({name, id}) =>
+      body->Writer.uint(nameIndex(name) * 2 + 1)
+      body->Writer.uint(id)
+    }
+
+  // Unannotated, so that it stays polymorphic over the operator tables.
+  let op = (ops, o) => body->Writer.uint(ops->Array.indexOf(o))
+
+  let counts = Sharing.parents(code)
+  let shared: Map.t<RawExpr.t, int> = Map.make()
+
+  let rec node = (e: RawExpr.t): unit =>
+    if Sharing.isTrivial(e) || counts->Map.get(e)->Option.getOr(0) < 2 {
+      fields(e)
+    } else {
+      switch shared->Map.get(e) {
+      | Some(i) =>
+        body->Writer.byte(19)
+        body->Writer.uint(i)
+      | None =>
+        shared->Map.set(e, shared->Map.size)
+        body->Writer.byte(18)
+        fields(e)
+      }
+    }
+  and fields = (e: RawExpr.t): unit =>
+    switch e {
+    | Var(v) =>
+      body->Writer.byte(0)
+      var(v)
+    | Func({params, body: fbody}) =>
+      body->Writer.byte(1)
+      body->Writer.uint(params->Belt.List.length)
+      params->Belt.List.forEach(var)
+      node(fbody)
+    | App({func, arg}) =>
+      body->Writer.byte(2)
+      node(func)
+      node(arg)
+    | Let({param, expr, body: lbody}) =>
+      body->Writer.byte(3)
+      var(param)
+      node(expr)
+      node(lbody)
+    | LetRec({param, expr, body: lbody, memo}) =>
+      body->Writer.byte(memo ? 20 : 4)
+      var(param)
+      node(expr)
+      node(lbody)
+    | IntLit(i) =>
+      body->Writer.byte(5)
+      body->Writer.uint(zigzag(i))
+    | BoolLit(b) => body->Writer.byte(b ? 7 : 6)
+    | BinOp({op: o, left, right}) =>
+      body->Writer.byte(8)
+      op(binOps, o)
+      node(left)
+      node(right)
+    | ShortCircuitOp({op: o, left, right}) =>
+      body->Writer.byte(9)
+      op(shortCircuitOps, o)
+      node(left)
+      node(right)
+    | UniOp({op: o, expr}) =>
+      body->Writer.byte(10)
+      op(uniOps, o)
+      node(expr)
+    | If({cond, thenBranch, elseBranch}) =>
+      body->Writer.byte(11)
+      node(cond)
+      node(thenBranch)
+      node(elseBranch)
+    | PrimOp({op: o, left, right}) =>
+      body->Writer.byte(12)
+      op(primOps, o)
+      node(left)
+      node(right)
+    | PrimNot({expr}) =>
+      body->Writer.byte(13)
+      node(expr)
+    | Quote({expr}) =>
+      body->Writer.byte(14)
+      node(expr)
+    | Splice({shift, expr}) =>
+      body->Writer.byte(15)
+      body->Writer.uint(shift)
+      node(expr)
+    | GenLet({expr}) =>
+      body->Writer.byte(16)
+      node(expr)
+    | LetCs({param, expr, body: lbody}) =>
+      body->Writer.byte(17)
+      var(param)
+      node(expr)
+      node(lbody)
+    | ArrayOp({op: o, args}) =>
+      body->Writer.byte(21)
+      op(arrayOps, o)
+      body->Writer.uint(args->Belt.List.length)
+      args->Belt.List.forEach(node)
+    | Tuple(elements) =>
+      body->Writer.byte(22)
+      body->Writer.uint(elements->Belt.List.length)
+      elements->Belt.List.forEach(node)
+    | Proj({tuple, index}) =>
+      body->Writer.byte(23)
+      body->Writer.uint(index)
+      node(tuple)
+    | CsValue(_) => raise(Malformed(Unserializable))
+    }
+
+  switch node(code) {
+  | () =>
+    let out = Writer.make()
+    let encoder = makeTextEncoder()
+    out->Writer.byte(0x4c) // 'L'
+    out->Writer.byte(0x47) // 'G'
+    out->Writer.byte(version)
+    out->Writer.uint(nameTable->Array.length)
+    nameTable->Array.forEach(name => {
+      let utf8 = encoder->encodeText(name)
+      out->Writer.uint(TypedArray.length(utf8))
+      out->Writer.append(utf8)
+    })
+    out->Writer.append(body->Writer.contents)
+    Ok(out->Writer.contents->toBytes)
+  | exception Malformed(err) => Error(err)
+  }
+}
+
+@genType
+let decode = (bytes: bytes): result<RawExpr.t, error> => {
+  let r = Reader.make(bytes->fromBytes)
+
+  let decodeAll = () => {
+    let b0 = r->Reader.byte
+    let b1 = r->Reader.byte
+    let v = r->Reader.byte
+    if b0 != 0x4c || b1 != 0x47 || v < 1 || v > version {
+      raise(Malformed(BadHeader))
+    }
+    let decoder = makeTextDecoder()
+    let names = Array.fromInitializer(~length=r->Reader.count, _ => r->Reader.string(decoder))
+
+    let var = (): Var.t => {
+      let k = r->Reader.uint
+      let index = Int.Bitwise.lsr(k, 1)
+      let name = switch names->Array.get(index) {
+      | Some(name) => name
+      | None => raise(Malformed(BadName(index)))
+      }
+      if Int.Bitwise.land(k, 1) == 0 {
+        Raw({name: name})
+      } else {
+        Colored({name, id: r->Reader.uint})
+      }
+    }
+
+    let op = ops => {
+      let i = r->Reader.uint
+      switch ops->Array.get(i) {
+      | Some(o) => o
+      | None => raise(Malformed(BadTag(i)))
+      }
+    }
+
+    let shared: array<option<RawExpr.t>> = []
+
+    // Operands are read in separate lets: the order in which record fields
+    // are evaluated is unspecified.
+    let rec node = (): RawExpr.t =>
+      switch r->Reader.byte {
+      | 0 => Var(var())
+      | 1 =>
+        let params = Array.fromInitializer(~length=r->Reader.count, _ => var())
+        let body = node()
+        Func({params: params->List.fromArray, body})
+      | 2 =>
+        let func = node()
+        let arg = node()
+        App({func, arg})
+      | (3 | 4 | 17 | 20) as tag =>
+        let param = var()
+        let expr = node()
+        let body = node()
+        switch tag {
+        | 3 => Let({param, expr, body})
+        | 4 | 20 => LetRec({param, expr, body, memo: tag == 20})
+        | _ => LetCs({param, expr, body})
+        }
+      | 5 => IntLit(unzigzag(r->Reader.uint))
+      | 6 => BoolLit(false)
+      | 7 => BoolLit(true)
+      | 8 =>
+        let op = op(binOps)
+        let left = node()
+        let right = node()
+        BinOp({op, left, right})
+      | 9 =>
+        let op = op(shortCircuitOps)
+        let left = node()
+        let right = node()
+        ShortCircuitOp({op, left, right})
+      | 10 =>
+        let op = op(uniOps)
+        UniOp({op, expr: node()})
+      | 11 =>
+        let cond = node()
+        let thenBranch = node()
+        let elseBranch = node()
+        If({cond, thenBranch, elseBranch})
+      | 12 =>
+        let op = op(primOps)
+        let left = node()
+        let right = node()
+        PrimOp({op, left, right})
+      | 13 => PrimNot({expr: node()})
+      | 14 => Quote({expr: node()})
+      | 15 =>
+        let shift = r->Reader.uint
+        Splice({shift, expr: node()})
+      | 16 => GenLet({expr: node()})
+      | 21 =>
+        let op = op(arrayOps)
+        let args = Array.fromInitializer(~length=r->Reader.count, _ => node())
+        ArrayOp({op, args: args->List.fromArray})
+      | 22 =>
+        let elements = Array.fromInitializer(~length=r->Reader.count, _ => node())
+        Tuple(elements->List.fromArray)
+      | 23 =>
+        let index = r->Reader.uint
+        Proj({tuple: node(), index})
+      | 18 =>
+        let i = shared->Array.length
+        shared->Array.push(None)
+        let e = node()
+        shared->Array.setUnsafe(i, Some(e))
+        e
+      // A node cannot refer to itself or to one that comes later.
+      | 19 =>
+        let i = r->Reader.uint
+        switch shared->Array.get(i) {
+        | Some(Some(e)) => e
+        | _ => raise(Malformed(BadReference(i)))
+        }
+      | tag => raise(Malformed(BadTag(tag)))
+      }
+
+    let e = node()
+    if r.pos != r.limit {
+      raise(Malformed(TrailingBytes))
+    }
+    e
+  }
+
+  switch decodeAll() {
+  | e => Ok(e)
+  | exception Malformed(err) => Error(err)
+  }
+}
@@ -0,0 +1,98 @@
+import { expect, it, beforeAll, describe } from 'vitest';
+import { Parser, Language } from 'web-tree-sitter';
+import { parseSourceFileNode } from './SyntaxNodeParser.gen.ts';
+import { stripTypeInfo } from './Expr.gen.ts';
+import { evaluateRuntime, Env_make, RuntimeVal_toString } from './Interpreter.gen.ts';
+import { encode, decode } from './Serialize.gen.ts';
+import { t as Expr_t } from './Expr.gen.ts'
+
+let parser;
+
+const parse = (input) => {
+    // Assume that parse always succeeds
+    return stripTypeInfo(parseSourceFileNode((parser.parse(input)).rootNode)._0 as Expr_t);
+}
+
+beforeAll(
+    async () => {
+        await Parser.init();
+        const parser1 = new Parser();
+        const lamgamma = await Language.load('public/tree-sitter-lamgamma_parser.wasm');
+        parser1.setLanguage(lamgamma);
+        parser = parser1;
+    }
+)
+
+const venv = Env_make();
+const nenv = Env_make();
+
+// Assume that evaluation succeeds with a code value
+const generate = (input) => evaluateRuntime(parse(input), venv, nenv)._0._0;
+
+const roundTrip = (expr) => decode(encode(expr)._0);
+
+const genpow = (n) => `
+  let rec pow1 = (n, xq) => {
+    if n == 0 then
+      \`{ 1 }
+    else
+      \`{ ~{ xq } * ~{ pow1 (n-1) xq } }
+  } in
+  \`{ (x) => { ~{ pow1 ${n} \`{ x } } } }
+`
+
+describe('encode and decode', () => {
+    it('round-trip every kind of node', () => {
+        const programs = [
+            '(x, y) => { if x < y && !false then x - 7 else y mod 2 }',
+            'let rec f = (n) => { f (n - 1) } in f 2147483647',
+            'let x = true || false in `{ ~{ `{ 1 } } + ~1{ y } }',
+            'let cs z = 1 in genlet `{ z }',
+            'Array.fold f 0 (Array.map g (Array.init (Array.length [| |]) ((i) => { [| 1, i |].(i) })))',
+            'let p = (1, (true, x)) in p.1.0 || (p, 2).0.0 == 1',
+        ];
+        for (const code of programs) {
+            const expr = parse(code);
+            expect(roundTrip(expr)).toEqual({ TAG: "Ok", _0: expr });
+        }
+    });
+
+    it('round-trips negative literals', () => {
+        for (const i of [-1, -64, -2147483648]) {
+            expect(roundTrip({ TAG: "IntLit", _0: i })).toEqual({ TAG: "Ok", _0: { TAG: "IntLit", _0: i } });
+        }
+    });
+
+    it('round-trips generated code with colored variables', () => {
+        const code = generate(genpow(5));
+        expect(roundTrip(code)).toEqual({ TAG: "Ok", _0: code });
+    });
+
+    it('is smaller than the printed code', () => {
+        const code = generate(genpow(32));
+        const printed = RuntimeVal_toString({ TAG: "Code", _0: code });
+        expect(encode(code)._0.length).toBeLessThan(printed.length / 2);
+    });
+
+    it('reads from a view into a larger buffer', () => {
+        const code = generate(genpow(3));
+        const bytes = encode(code)._0;
+        const buffer = new Uint8Array(bytes.length + 8);
+        buffer.set(bytes, 5);
+        expect(decode(buffer.subarray(5, 5 + bytes.length))).toEqual({ TAG: "Ok", _0: code });
+    });
+
+    it('cannot encode persisted values', () => {
+        const code = generate('let cs f = (x) => { x } in `{ f 1 }');
+        expect(encode(code)).toEqual({ TAG: "Error", _0: "Unserializable" });
+    });
+
+    it('rejects malformed input', () => {
+        const bytes = encode(parse('let x = 1 in x + 2'))._0;
+        expect(decode(bytes.subarray(0, bytes.length - 1))).toEqual({ TAG: "Error", _0: "Truncated" });
+        expect(decode(new Uint8Array([0x4c, 0x47, 0x09, 0x00, 0x05, 0x00]))).toEqual({ TAG: "Error", _0: "BadHeader" });
+        expect(decode(new Uint8Array([0x4c, 0x47, 0x01, 0x00, 0x63]))).toEqual({ TAG: "Error", _0: { TAG: "BadTag", _0: 0x63 } });
+        expect(decode(new Uint8Array([0x4c, 0x47, 0x01, 0x00, 0x00, 0x00]))).toEqual({ TAG: "Error", _0: { TAG: "BadName", _0: 0 } });
+        expect(decode(new Uint8Array([0x4c, 0x47, 0x01, 0x00, 0x06, 0x06]))).toEqual({ TAG: "Error", _0: "TrailingBytes" });
+    });
+});
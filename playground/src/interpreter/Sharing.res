@@ -0,0 +1,425 @@
+// Code values are DAGs: splicing one code value into several holes puts the
+// same node in each of them. A plain recursive walk visits a shared node once
+// per path to it, which is exponential in the depth of recursive generators;
+// the functions here visit it once.
+//
+// letBind turns a DAG into an expression in which each shared fragment
+// occurs once, bound to a fresh variable, so that printing and running it
+// take time linear in the size of the DAG. Only fragments whose evaluation
+// can neither fail nor diverge are bound: evaluating them ahead of their
+// uses must not change what the code evaluates to, errors included (as in
+// CodeBuilder). Other shared fragments are copied as before.
+
+open RawExpr
+
+type vars = Belt.Set.t<Var.t, Var.Cmp.identity>
+
+let noVars: vars = Belt.Set.make(~id=module(Var.Cmp))
+
+let forEachChild = (e: t, f: t => unit): unit =>
+  switch e {
+  | Var(_) | IntLit(_) | BoolLit(_) | CsValue(_) => ()
+  | Func({body: expr})
+  | UniOp({expr})
+  | PrimNot({expr})
+  | Quote({expr})
+  | Splice({expr})
+  | GenLet({expr}) =>
+    f(expr)
+  | App({func: left, arg: right})
+  | BinOp({left, right})
+  | ShortCircuitOp({left, right})
+  | PrimOp({left, right})
+  | Let({expr: left, body: right})
+  | LetRec({expr: left, body: right})
+  | LetCs({expr: left, body: right}) =>
+    f(left)
+    f(right)
+  | If({cond, thenBranch, elseBranch}) =>
+    f(cond)
+    f(thenBranch)
+    f(elseBranch)
+  | ArrayOp({args}) | Tuple(args) => args->Belt.List.forEach(f)
+  | Proj({tuple}) => f(tuple)
+  }
+
+// The number of edges into each node reachable from root. A node is shared
+// when it has more than one.
+let parents = (root: t): Map.t<t, int> => {
+  let counts = Map.make()
+  let rec visit = e =>
+    switch counts->Map.get(e) {
+    | Some(n) => counts->Map.set(e, n + 1)
+    | None =>
+      counts->Map.set(e, 1)
+      forEachChild(e, visit)
+    }
+  visit(root)
+  counts
+}
+
+// How often each node reachable from root occurs in the tree root unfolds
+// to, counting up to 2: a node under a shared parent occurs more than once
+// even when it has a single parent.
+let occurrences = (root: t): Map.t<t, int> => {
+  // Postorder; reversed, every node comes before its children.
+  let order = []
+  let visited = Set.make()
+  let rec visit = e =>
+    if !(visited->Set.has(e)) {
+      visited->Set.add(e)
+      forEachChild(e, visit)
+      order->Array.push(e)
+    }
+  visit(root)
+
+  let counts = Map.make()
+  counts->Map.set(root, 1)
+  for i in Array.length(order) - 1 downto 0 {
+    let e = order->Array.getUnsafe(i)
+    let n = counts->Map.get(e)->Option.getOr(0)
+    forEachChild(e, child =>
+      counts->Map.set(child, Math.Int.min(2, counts->Map.get(child)->Option.getOr(0) + n))
+    )
+  }
+  counts
+}
+
+let isTrivial = (e: t): bool =>
+  switch e {
+  | Var(_) | IntLit(_) | BoolLit(_) | CsValue(_) => true
+  | _ => false
+  }
+
+// Facts about a node that do not depend on where it occurs, cached by node
+// identity like QuoteInfo.
+type facts = {
+  free: vars,
+  staged: bool,
+  // Evaluating the node at the current stage cannot fail or diverge. Never
+  // true of a staged node.
+  total: bool,
+}
+
+let factsCache: WeakMap.t<t, facts> = WeakMap.make()
+
+let leaf = (free: vars): facts => {free, staged: false, total: true}
+
+// The facts of a node that may fail, from those of its operands.
+let partial = (operands: array<facts>): facts => {
+  free: operands->Array.reduce(noVars, (free, f) => Belt.Set.union(free, f.free)),
+  staged: operands->Array.some(f => f.staged),
+  total: false,
+}
+
+let rec facts = (e: t): facts =>
+  switch factsCache->WeakMap.get(e) {
+  | Some(f) => f
+  | None =>
+    let f = computeFacts(e)
+    factsCache->WeakMap.set(e, f)->ignore
+    f
+  }
+and computeFacts = (e: t): facts =>
+  switch e {
+  | Var(v) => leaf(noVars->Belt.Set.add(v))
+  | IntLit(_) | BoolLit(_) | CsValue(_) => leaf(noVars)
+  | Func({params, body}) =>
+    let b = facts(body)
+    {
+      free: b.free->Belt.Set.removeMany(params->Belt.List.toArray),
+      staged: b.staged,
+      total: !b.staged,
+    }
+  | PrimOp({op, left, right}) =>
+    let safeDivisor = switch (op, right) {
+    | (Operator.PrimOp.IntDiv | Operator.PrimOp.IntMod, IntLit(n)) => n != 0
+    | (Operator.PrimOp.IntDiv | Operator.PrimOp.IntMod, _) => false
+    | _ => true
+    }
+    let operands = [facts(left), facts(right)]
+    {...partial(operands), total: safeDivisor && operands->Array.every(f => f.total)}
+  | PrimNot({expr}) => facts(expr)
+  | If({cond, thenBranch, elseBranch}) =>
+    let operands = [facts(cond), facts(thenBranch), facts(elseBranch)]
+    {...partial(operands), total: operands->Array.every(f => f.total)}
+  | Tuple(elements) =>
+    let operands = elements->Belt.List.toArray->Array.map(facts)
+    {...partial(operands), total: operands->Array.every(f => f.total)}
+  | Let({param, expr, body}) | LetCs({param, expr, body}) =>
+    let x = facts(expr)
+    let b = facts(body)
+    {
+      free: Belt.Set.union(x.free, b.free->Belt.Set.remove(param)),
+      staged: x.staged || b.staged,
+      total: x.total && b.total,
+    }
+  | LetRec({param, expr, body}) =>
+    let f = partial([facts(expr), facts(body)])
+    {...f, free: f.free->Belt.Set.remove(param)}
+  // Operations on untyped operands can fail with a type mismatch, and
+  // applications can fail or diverge.
+  | App({func: left, arg: right})
+  | BinOp({left, right})
+  | ShortCircuitOp({left, right}) =>
+    partial([facts(left), facts(right)])
+  | UniOp({expr}) => partial([facts(expr)])
+  // Elements can have the wrong type, indices be out of bounds, and the
+  // functions of bulk operations fail or diverge.
+  | ArrayOp({args}) => partial(args->Belt.List.toArray->Array.map(facts))
+  | Proj({tuple}) => partial([facts(tuple)])
+  | Quote({expr}) | Splice({expr}) | GenLet({expr}) => {...partial([facts(expr)]), staged: true}
+  }
+
+// Where letBind puts bindings, as in Interpreter.LetInsertion: the body of
+// each binder, and each quote or splice body, which bindings never leave.
+type frame = {
+  isRegion: bool,
+  bound: list<Var.t>,
+  // most recent first
+  mutable bindings: list<(Var.t, t)>,
+  // the shared nodes bound here, forgotten when the frame is left
+  mutable memoized: list<t>,
+}
+
+let rec target = (frames: list<frame>, free: vars): frame =>
+  switch frames {
+  | list{frame, ...rest}
+    if !frame.isRegion && !(frame.bound->Belt.List.some(v => free->Belt.Set.has(v))) =>
+    target(rest, free)
+  | list{frame, ..._} => frame
+  | list{} => raise(Invalid_argument("Sharing.target: no enclosing region"))
+  }
+
+// Binds each shared total fragment of e once, at the innermost binder of
+// one of its free variables, or at the start of its quote. Returns e itself
+// when there is nothing to bind.
+@genType
+let letBind = (e: t): t => {
+  let counts = occurrences(e)
+  let isShared = e =>
+    !isTrivial(e) && counts->Map.get(e)->Option.getOr(0) > 1 && facts(e).total
+
+  if !(counts->Map.keys->Iterator.toArray->Array.some(isShared)) {
+    e
+  } else {
+    let memo: ref<Map.t<t, Var.t>> = ref(Map.make())
+    let frames: ref<list<frame>> = ref(list{})
+
+    let within = (isRegion: bool, bound: list<Var.t>, build: unit => t): t => {
+      let saved = frames.contents
+      let savedMemo = memo.contents
+      if isRegion {
+        memo := Map.make()
+      }
+      let frame = {isRegion, bound, bindings: list{}, memoized: list{}}
+      frames := list{frame, ...saved}
+      let body = build()
+      frames := saved
+      frame.memoized->Belt.List.forEach(e => memo.contents->Map.delete(e)->ignore)
+      memo := savedMemo
+      frame.bindings->Belt.List.reduce(body, (body, (param, expr)) => Let({param, expr, body}))
+    }
+
+    let rec rebuild = (e: t): t =>
+      if !isShared(e) {
+        rebuildChildren(e)
+      } else {
+        switch memo.contents->Map.get(e) {
+        | Some(v) => Var(v)
+        | None =>
+          let e1 = rebuildChildren(e)
+          let v = Var.color(Var.Raw({name: "shared"}))
+          let frame = target(frames.contents, facts(e).free)
+          frame.bindings = list{(v, e1), ...frame.bindings}
+          frame.memoized = list{e, ...frame.memoized}
+          memo.contents->Map.set(e, v)
+          Var(v)
+        }
+      }
+    // Operands are rebuilt in separate lets, in evaluation order: the order
+    // in which record fields are evaluated is unspecified.
+    and rebuildChildren = (e: t): t =>
+      switch e {
+      | Var(_) | IntLit(_) | BoolLit(_) | CsValue(_) => e
+      | Func({params, body}) => Func({params, body: within(false, params, () => rebuild(body))})
+      | App({func, arg}) =>
+        let func = rebuild(func)
+        let arg = rebuild(arg)
+        App({func, arg})
+      | Let({param, expr, body}) =>
+        let expr = rebuild(expr)
+        let body = within(false, list{param}, () => rebuild(body))
+        Let({param, expr, body})
+      | LetCs({param, expr, body}) =>
+        let expr = rebuild(expr)
+        let body = within(false, list{param}, () => rebuild(body))
+        LetCs({param, expr, body})
+      // The function stays in place, with bindings inside its body: the
+      // interpreter only accepts a let rec of a function.
+      | LetRec({param, expr: Func({params, body: fbody}), body, memo}) =>
+        let fbody = within(false, list{param, ...params}, () => rebuild(fbody))
+        let body = within(false, list{param}, () => rebuild(body))
+        LetRec({param, expr: Func({params, body: fbody}), body, memo})
+      | LetRec({param, expr, body, memo}) =>
+        let expr = within(false, list{param}, () => rebuild(expr))
+        let body = within(false, list{param}, () => rebuild(body))
+        LetRec({param, expr, body, memo})
+      | BinOp({op, left, right}) =>
+        let left = rebuild(left)
+        let right = rebuild(right)
+        BinOp({op, left, right})
+      | ShortCircuitOp({op, left, right}) =>
+        let left = rebuild(left)
+        let right = rebuild(right)
+        ShortCircuitOp({op, left, right})
+      | PrimOp({op, left, right}) =>
+        let left = rebuild(left)
+        let right = rebuild(right)
+        PrimOp({op, left, right})
+      | UniOp({op, expr}) => UniOp({op, expr: rebuild(expr)})
+      | PrimNot({expr}) => PrimNot({expr: rebuild(expr)})
+      | If({cond, thenBranch, elseBranch}) =>
+        let cond = rebuild(cond)
+        let thenBranch = rebuild(thenBranch)
+        let elseBranch = rebuild(elseBranch)
+        If({cond, thenBranch, elseBranch})
+      | Quote({expr}) => Quote({expr: within(true, list{}, () => rebuild(expr))})
+      | Splice({shift, expr}) => Splice({shift, expr: within(true, list{}, () => rebuild(expr))})
+      | GenLet({expr}) => GenLet({expr: rebuild(expr)})
+      | ArrayOp({op, args}) =>
+        // Belt.List.map applies its function from the head.
+        ArrayOp({op, args: args->Belt.List.map(rebuild)})
+      | Tuple(elements) => Tuple(elements->Belt.List.map(rebuild))
+      | Proj({tuple, index}) => Proj({tuple: rebuild(tuple), index})
+      }
+
+    within(true, list{}, () => rebuild(e))
+  }
+}
+
+// A structural hash, cached by node identity so that each shared node is
+// hashed once. Equal expressions hash equally.
+let hashCache: WeakMap.t<t, int> = WeakMap.make()
+
+let mix = (h: int, x: int): int => Int.Bitwise.lxor(h * 0x01000193, x)
+
+let hashString = (s: string): int => {
+  // 0x811c9dc5, which is out of the range of int as a literal
+  let h = ref(-2128831035)
+  for i in 0 to String.length(s) - 1 {
+    h := mix(h.contents, s->String.charCodeAt(i)->Float.toInt)
+  }
+  h.contents
+}
+
+let hashVar = (v: Var.t): int =>
+  switch v {
+  | Raw({name}) => hashString(name)
+  | Colored({name, id}) => mix(hashString(name), id)
+  }
+
+@genType
+let rec hash = (e: t): int =>
+  switch hashCache->WeakMap.get(e) {
+  | Some(h) => h
+  | None =>
+    let h = switch e {
+    | Var(v) => mix(1, hashVar(v))
+    | Func({params, body}) =>
+      params->Belt.List.reduce(mix(2, hash(body)), (h, v) => mix(h, hashVar(v)))
+    | App({func, arg}) => mix(mix(3, hash(func)), hash(arg))
+    | Let({param, expr, body}) => mix(mix(mix(4, hashVar(param)), hash(expr)), hash(body))
+    | LetRec({param, expr, body, memo}) =>
+      mix(mix(mix(memo ? 20 : 5, hashVar(param)), hash(expr)), hash(body))
+    | LetCs({param, expr, body}) => mix(mix(mix(6, hashVar(param)), hash(expr)), hash(body))
+    | IntLit(i) => mix(7, i)
+    | BoolLit(b) => b ? 8 : 9
+    | BinOp({op, left, right}) =>
+      mix(mix(mix(10, hashString(Operator.BinOp.toString(op))), hash(left)), hash(right))
+    | ShortCircuitOp({op, left, right}) =>
+      mix(mix(mix(11, hashString(Operator.ShortCircuitOp.toString(op))), hash(left)), hash(right))
+    | PrimOp({op, left, right}) =>
+      mix(mix(mix(12, hashString(Operator.PrimOp.toString(op))), hash(left)), hash(right))
+    | UniOp({op, expr}) => mix(mix(13, hashString(Operator.UniOp.toString(op))), hash(expr))
+    | PrimNot({expr}) => mix(14, hash(expr))
+    | If({cond, thenBranch, elseBranch}) =>
+      mix(mix(mix(15, hash(cond)), hash(thenBranch)), hash(elseBranch))
+    | Quote({expr}) => mix(16, hash(expr))
+    | Splice({shift, expr}) => mix(mix(17, shift), hash(expr))
+    | GenLet({expr}) => mix(18, hash(expr))
+    | CsValue({var}) => mix(19, hashVar(var))
+    | ArrayOp({op, args}) =>
+      args->Belt.List.reduce(mix(21, hashString(Operator.ArrayOp.toString(op))), (h, arg) =>
+        mix(h, hash(arg))
+      )
+    | Tuple(elements) => elements->Belt.List.reduce(22, (h, element) => mix(h, hash(element)))
+    | Proj({tuple, index}) => mix(mix(23, index), hash(tuple))
+    }
+    hashCache->WeakMap.set(e, h)->ignore
+    h
+  }
+
+// Structural equality. Identical nodes are equal without a look inside, and
+// each pair of nodes found equal is remembered, so two DAGs are compared in
+// time linear in their sizes rather than in the sizes of their unfoldings.
+// CsValues are equal when they carry the same value.
+@genType
+let equal = (a: t, b: t): bool => {
+  let known: Map.t<t, Set.t<t>> = Map.make()
+
+  let rec eq = (a: t, b: t): bool =>
+    if a === b || known->Map.get(a)->Option.mapOr(false, s => s->Set.has(b)) {
+      true
+    } else if hash(a) != hash(b) || !sameNode(a, b) {
+      false
+    } else {
+      switch known->Map.get(a) {
+      | Some(s) => s->Set.add(b)
+      | None => known->Map.set(a, Set.fromArray([b]))
+      }
+      true
+    }
+  and sameNode = (a: t, b: t): bool =>
+    switch (a, b) {
+    | (Var(x), Var(y)) => x == y
+    | (Func({params: p1, body: b1}), Func({params: p2, body: b2})) => p1 == p2 && eq(b1, b2)
+    | (App({func: f1, arg: a1}), App({func: f2, arg: a2})) => eq(f1, f2) && eq(a1, a2)
+    | (Let({param: p1, expr: e1, body: b1}), Let({param: p2, expr: e2, body: b2}))
+    | (LetCs({param: p1, expr: e1, body: b1}), LetCs({param: p2, expr: e2, body: b2})) =>
+      p1 == p2 && eq(e1, e2) && eq(b1, b2)
+    | (
+        LetRec({param: p1, expr: e1, body: b1, memo: m1}),
+        LetRec({param: p2, expr: e2, body: b2, memo: m2}),
+      ) =>
+      p1 == p2 && m1 == m2 && eq(e1, e2) && eq(b1, b2)
+    | (IntLit(x), IntLit(y)) => x == y
+    | (BoolLit(x), BoolLit(y)) => x == y
+    | (BinOp({op: o1, left: l1, right: r1}), BinOp({op: o2, left: l2, right: r2})) =>
+      o1 == o2 && eq(l1, l2) && eq(r1, r2)
+    | (
+        ShortCircuitOp({op: o1, left: l1, right: r1}),
+        ShortCircuitOp({op: o2, left: l2, right: r2}),
+      ) =>
+      o1 == o2 && eq(l1, l2) && eq(r1, r2)
+    | (PrimOp({op: o1, left: l1, right: r1}), PrimOp({op: o2, left: l2, right: r2})) =>
+      o1 == o2 && eq(l1, l2) && eq(r1, r2)
+    | (UniOp({op: o1, expr: e1}), UniOp({op: o2, expr: e2})) => o1 == o2 && eq(e1, e2)
+    | (PrimNot({expr: e1}), PrimNot({expr: e2}))
+    | (Quote({expr: e1}), Quote({expr: e2}))
+    | (GenLet({expr: e1}), GenLet({expr: e2})) =>
+      eq(e1, e2)
+    | (Splice({shift: s1, expr: e1}), Splice({shift: s2, expr: e2})) => s1 == s2 && eq(e1, e2)
+    | (If({cond: c1, thenBranch: t1, elseBranch: f1}), If({cond: c2, thenBranch: t2, elseBranch: f2})) =>
+      eq(c1, c2) && eq(t1, t2) && eq(f1, f2)
+    | (CsValue({var: x, value: v1}), CsValue({var: y, value: v2})) => x == y && v1 === v2
+    | (ArrayOp({op: o1, args: a1}), ArrayOp({op: o2, args: a2})) =>
+      o1 == o2 && Belt.List.length(a1) == Belt.List.length(a2) && Belt.List.every2(a1, a2, eq)
+    | (Tuple(e1), Tuple(e2)) =>
+      Belt.List.length(e1) == Belt.List.length(e2) && Belt.List.every2(e1, e2, eq)
+    | (Proj({tuple: t1, index: i1}), Proj({tuple: t2, index: i2})) => i1 == i2 && eq(t1, t2)
+    | _ => false
+    }
+
+  eq(a, b)
+}
@@ -0,0 +1,101 @@
+import { expect, it, beforeAll, describe } from 'vitest';
+import { Parser, Language } from 'web-tree-sitter';
+import { parseSourceFileNode } from './SyntaxNodeParser.gen.ts';
+import { stripTypeInfo } from './Expr.gen.ts';
+import { evaluateRuntime, Env_make, RuntimeVal_toString } from './Interpreter.gen.ts';
+import { letBind, hash, equal } from './Sharing.gen.ts';
+import { encode, decode } from './Serialize.gen.ts';
+import { t as Expr_t } from './Expr.gen.ts'
+
+let parser;
+
+const parse = (input) => {
+    // Assume that parse always succeeds
+    return stripTypeInfo(parseSourceFileNode((parser.parse(input)).rootNode)._0 as Expr_t);
+}
+
+beforeAll(
+    async () => {
+        await Parser.init();
+        const parser1 = new Parser();
+        const lamgamma = await Language.load('public/tree-sitter-lamgamma_parser.wasm');
+        parser1.setLanguage(lamgamma);
+        parser = parser1;
+    }
+)
+
+const venv = Env_make();
+const nenv = Env_make();
+
+// 1 * 1, squared depth times, with both operands of each product the same
+// node: 2^depth leaves in the unfolding, depth + 1 nodes in the DAG.
+const squares = (depth) => {
+    let e = { TAG: "PrimOp", op: "IntMul", left: { TAG: "IntLit", _0: 1 }, right: { TAG: "IntLit", _0: 1 } };
+    for (let i = 0; i < depth; i++) {
+        e = { TAG: "PrimOp", op: "IntMul", left: e, right: e };
+    }
+    return e;
+}
+
+describe('letBind', () => {
+    it('binds code spliced twice once', () => {
+        const code = `
+          let c = \`{ (y) => { y + 1 } } in
+          \`{ ~{ c } 1 + ~{ c } 2 }
+        `
+        const printed = RuntimeVal_toString(evaluateRuntime(parse(code), venv, nenv)._0);
+        expect(printed).toMatch(/^`\{ \(let shared_\d+ = \(y\) => \{ \(y \+ 1\) \} in/);
+        expect(printed.split('(y) =>').length).toBe(2);
+    });
+
+    it('leaves unshared code as it is', () => {
+        const expr = parse('(x) => { x * 2 }');
+        expect(letBind(expr)).toBe(expr);
+    });
+
+    it('does not bind code that may fail ahead of its uses', () => {
+        const division = { TAG: "PrimOp", op: "IntDiv", left: { TAG: "IntLit", _0: 1 }, right: { TAG: "IntLit", _0: 0 } };
+        const expr = { TAG: "If", cond: { TAG: "BoolLit", _0: false }, thenBranch: division, elseBranch: division };
+        expect(letBind(expr)).toBe(expr);
+    });
+
+    it('runs and prints a deep DAG in linear time', () => {
+        const dag = squares(40);
+        expect(evaluateRuntime(letBind(dag), venv, nenv)).toEqual({ TAG: "Ok", _0: { TAG: "IntVal", _0: 1 } });
+        expect(RuntimeVal_toString({ TAG: "Code", _0: dag }).length).toBeLessThan(100 * 40);
+    });
+
+    it('runs shared code spliced at stage 0', () => {
+        const code = { TAG: "Code", _0: squares(40) };
+        const splice = { TAG: "Splice", shift: 0, expr: { TAG: "CsValue", var: { TAG: "Raw", name: "c" }, value: code } };
+        expect(evaluateRuntime(splice, venv, nenv)).toEqual({ TAG: "Ok", _0: { TAG: "IntVal", _0: 1 } });
+    });
+});
+
+describe('hash and equal', () => {
+    it('compare separately built DAGs without unfolding them', () => {
+        expect(hash(squares(40))).toBe(hash(squares(40)));
+        expect(equal(squares(40), squares(40))).toBe(true);
+        expect(equal(squares(40), squares(41))).toBe(false);
+    });
+
+    it('tell apart variables and operators', () => {
+        expect(equal(parse('(x) => { x + 1 }'), parse('(x) => { x + 1 }'))).toBe(true);
+        expect(equal(parse('(x) => { x + 1 }'), parse('(y) => { y + 1 }'))).toBe(false);
+        expect(equal(parse('1 + 2'), parse('1 - 2'))).toBe(false);
+    });
+});
+
+describe('serialization', () => {
+    it('writes a shared node once and restores the sharing', () => {
+        const bytes = encode(squares(40))._0;
+        expect(bytes.length).toBeLessThan(300);
+        const decoded = decode(bytes)._0;
+        expect(decoded.left).toBe(decoded.right);
+        expect(equal(decoded, squares(40))).toBe(true);
+    });
+
+    it('rejects a reference to a node not yet read', () => {
+        expect(decode(new Uint8Array([0x4c, 0x47, 0x02, 0x00, 0x13, 0x00]))).toEqual({ TAG: "Error", _0: { TAG: "BadReference", _0: 0 } });
+    });
+});
@@ -107,6 +107,15 @@ let rec parseTypeNode = (node: syntaxNode): result<Typ.t, ParseError.t> => {
   switch node.type_ {
   | "int_type" => ok(Typ.Int)
   | "bool_type" => ok(Typ.Bool)
+  | "array_type" => ok(Typ.IntArray)
+  | "tuple_type" =>
+    node.childrenForFieldName("element")
+    ->Array.filter(child => child.isNamed)
+    ->Array.map(parseTypeNode)
+    ->Array.reduceRight(ok(list{}), (acc, element) =>
+      element->Result.flatMap(e => acc->Result.map(elements => list{e, ...elements}))
+    )
+    ->Result.map(elements => Typ.Tuple(elements))
   | "func_type" =>
     let paramType =
       node
@@ -406,7 +415,7 @@ let rec parseExprNode = (node: syntaxNode): result<Expr.t, ParseError.t> => {
       )
     )
 
-  | "letrec" =>
+  | "letrec" | "letcs" =>
     let param =
       node
       ->getNamedChildForFieldNameUnsafe("param")
@@ -428,11 +437,16 @@ let rec parseExprNode = (node: syntaxNode): result<Expr.t, ParseError.t> => {
           b => {
             {
               Expr.metaData: extractMetadata(node),
-              raw: Expr.LetRec({
-                param: p,
-                expr: v,
-                body: b,
-              }),
+              raw: switch node.type_ {
+              | "letrec" =>
+                Expr.LetRec({
+                  param: p,
+                  expr: v,
+                  body: b,
+                  memo: node->getNamedChildForFieldName("memo")->Option.isSome,
+                })
+              | _ => Expr.LetCs({param: p, expr: v, body: b})
+              },
             }
           },
         )
@@ -532,6 +546,85 @@ let rec parseExprNode = (node: syntaxNode): result<Expr.t, ParseError.t> => {
       }
     })
 
+  | "genlet" =>
+    let expr =
+      node
+      ->getNamedChildForFieldNameUnsafe("expr")
+      ->parseExprNode
+
+    expr->Result.map(e => {
+      {
+        Expr.metaData: extractMetadata(node),
+        raw: Expr.GenLet({expr: e}),
+      }
+    })
+
+  | "array"
+  | "array_length"
+  | "array_get"
+  | "array_init"
+  | "array_map"
+  | "array_fold" =>
+    let (op, fields) = {
+      open Operator.ArrayOp
+      switch node.type_ {
+      | "array" => (Make, [])
+      | "array_length" => (Length, ["array"])
+      | "array_get" => (Get, ["array", "index"])
+      | "array_init" => (Init, ["size", "func"])
+      | "array_map" => (Map, ["func", "array"])
+      | _ => (Fold, ["func", "init", "array"])
+      }
+    }
+
+    let children = switch op {
+    | Operator.ArrayOp.Make =>
+      node.childrenForFieldName("element")->Array.filter(child => child.isNamed)
+    | _ => fields->Array.map(field => node->getNamedChildForFieldNameUnsafe(field))
+    }
+
+    children
+    ->Array.map(parseExprNode)
+    ->Array.reduceRight(ok(list{}), (acc, arg) =>
+      arg->Result.flatMap(a => acc->Result.map(args => list{a, ...args}))
+    )
+    ->Result.map(args => {
+      Expr.metaData: extractMetadata(node),
+      raw: Expr.ArrayOp({op, args}),
+    })
+
+  | "tuple" =>
+    node.childrenForFieldName("element")
+    ->Array.filter(child => child.isNamed)
+    ->Array.map(parseExprNode)
+    ->Array.reduceRight(ok(list{}), (acc, element) =>
+      element->Result.flatMap(e => acc->Result.map(elements => list{e, ...elements}))
+    )
+    ->Result.map(elements => {
+      Expr.metaData: extractMetadata(node),
+      raw: Expr.Tuple(elements),
+    })
+
+  | "tuple_get" =>
+    let index =
+      node
+      ->getNamedChildForFieldNameUnsafe("index")
+      ->(n => Nullable.getUnsafe(n.text))
+      ->Int.fromString
+      ->Option.getExn(~message="Failed to parse int from string")
+
+    let tuple =
+      node
+      ->getNamedChildForFieldNameUnsafe("tuple")
+      ->parseExprNode
+
+    tuple->Result.map(t => {
+      {
+        Expr.metaData: extractMetadata(node),
+        raw: Expr.Proj({tuple: t, index}),
+      }
+    })
+
   | "clsabs" =>
     let param = node->getNamedChildForFieldNameUnsafe("param")
 
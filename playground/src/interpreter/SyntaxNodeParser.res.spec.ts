@@ -1111,6 +1111,73 @@ describe('parseSourceFileNode', () => {
     })
   });
 
+  // (x, y) is a tuple of variables until a => shows it is a parameter list
+  // (the [_simple_expression, param] conflict in grammar.js)
+  describe('for tuples and parameter lists', () => {
+    it('parse (x, y)', () => {
+      const input = '(x, y)';
+      const expectedOutput = {
+        TAG: "Ok",
+        _0: {
+          metaData: { start: { row: 0, col: 0 }, end: { row: 0, col: 6 } },
+          raw: {
+            TAG: "Tuple",
+            _0: {
+              hd: {
+                metaData: { start: { row: 0, col: 1 }, end: { row: 0, col: 2 } },
+                raw: { TAG: "Var", _0: { TAG: "Raw", name: 'x' } }
+              },
+              tl: {
+                hd: {
+                  metaData: { start: { row: 0, col: 4 }, end: { row: 0, col: 5 } },
+                  raw: { TAG: "Var", _0: { TAG: "Raw", name: 'y' } }
+                },
+                tl: 0
+              }
+            }
+          }
+        }
+      };
+      expect(parseSourceFileNode((parser.parse(input)).rootNode))
+        .toEqual(expectedOutput);
+    });
+
+    it('parse (x, y) => { x }', () => {
+      const input = '(x, y) => { x }';
+      const expectedOutput = {
+        TAG: "Ok",
+        _0: {
+          metaData: { start: { row: 0, col: 0 }, end: { row: 0, col: 15 } },
+          raw: {
+            TAG: "Func",
+            params: {
+              hd: {
+                var: { TAG: "Raw", name: 'x' },
+                typ: undefined,
+                cls: { TAG: "Generated", _0: 1 }
+              },
+              tl: {
+                hd: {
+                  var: { TAG: "Raw", name: 'y' },
+                  typ: undefined,
+                  cls: { TAG: "Generated", _0: 2 }
+                },
+                tl: 0
+              }
+            },
+            returnType: undefined,
+            body: {
+              metaData: { start: { row: 0, col: 12 }, end: { row: 0, col: 13 } },
+              raw: { TAG: "Var", _0: { TAG: "Raw", name: 'x' } }
+            }
+          }
+        }
+      };
+      expect(parseSourceFileNode((parser.parse(input)).rootNode))
+        .toEqual(expectedOutput);
+    });
+  });
+
   describe('for applications', () => {
     it('parse x y z', () => {
       const input = 'x y z';
@@ -1193,6 +1260,92 @@ describe('parseSourceFileNode', () => {
 
   });
 
+  describe('for let cs expressions', () => {
+    it('parse let cs x = 1 in x', () => {
+      const input = 'let cs x = 1 in x';
+      expect(parseSourceFileNode((parser.parse(input)).rootNode))
+        .toMatchInlineSnapshot(`
+                  {
+                    "TAG": "Ok",
+                    "_0": {
+                      "metaData": {
+                        "end": {
+                          "col": 17,
+                          "row": 0,
+                        },
+                        "start": {
+                          "col": 0,
+                          "row": 0,
+                        },
+                      },
+                      "raw": {
+                        "TAG": "LetCs",
+                        "body": {
+                          "metaData": {
+                            "end": {
+                              "col": 17,
+                              "row": 0,
+                            },
+                            "start": {
+                              "col": 16,
+                              "row": 0,
+                            },
+                          },
+                          "raw": {
+                            "TAG": "Var",
+                            "_0": {
+                              "TAG": "Raw",
+                              "name": "x",
+                            },
+                          },
+                        },
+                        "expr": {
+                          "metaData": {
+                            "end": {
+                              "col": 12,
+                              "row": 0,
+                            },
+                            "start": {
+                              "col": 11,
+                              "row": 0,
+                            },
+                          },
+                          "raw": {
+                            "TAG": "IntLit",
+                            "_0": 1,
+                          },
+                        },
+                        "param": {
+                          "cls": {
+                            "TAG": "Generated",
+                            "_0": 1,
+                          },
+                          "typ": undefined,
+                          "var": {
+                            "TAG": "Raw",
+                            "name": "x",
+                          },
+                        },
+                      },
+                    },
+                  }
+                `);
+    });
+
+    it('parse cs as a variable outside let', () => {
+      const input = 'cs';
+      const expectedOutput = {
+        TAG: "Ok",
+        _0: {
+          metaData: { start: { row: 0, col: 0 }, end: { row: 0, col: 2 } },
+          raw: { TAG: "Var", _0: { TAG: "Raw", name: 'cs' } }
+        }
+      };
+      expect(parseSourceFileNode((parser.parse(input)).rootNode))
+        .toEqual(expectedOutput);
+    });
+  });
+
   describe('for quotations', () => {
     it('parse quotation', () => {
       const input = '`{ x + 1 }';
@@ -2,6 +2,9 @@
 type rec t =
   | Int
   | Bool
+  | IntArray
+  // unboxed tuples of two or more elements
+  | Tuple(list<t>)
   // | CodeType(Classifier.t, t)
   | Func(t, t)
   | Code({cls: Classifier.t, typ: t})
@@ -11,6 +14,9 @@ let rec toString = (typ: t): string => {
   switch typ {
   | Int => "Int"
   | Bool => "Bool"
+  | IntArray => "Array<Int>"
+  | Tuple(elements) =>
+    "(" ++ elements->Belt.List.map(toString)->Belt.List.toArray->Array.join("*") ++ ")"
   | Func(paramType, returnType) => "(" ++ toString(paramType) ++ "->" ++ toString(returnType) ++ ")"
   | Code({cls, typ}) => `<${typ->toString}@${cls->Classifier.toString}>`
   | ClsAbs({cls, base, body}) =>
@@ -22,6 +28,11 @@ let rec freeClassifiers = (typ: t): Belt.Set.t<Classifier.t, Classifier.Cmp.iden
   switch typ {
   | Int => Belt.Set.make(~id=module(Classifier.Cmp))
   | Bool => Belt.Set.make(~id=module(Classifier.Cmp))
+  | IntArray => Belt.Set.make(~id=module(Classifier.Cmp))
+  | Tuple(elements) =>
+    elements->Belt.List.reduce(Belt.Set.make(~id=module(Classifier.Cmp)), (acc, element) =>
+      acc->Belt.Set.union(freeClassifiers(element))
+    )
   | Func(paramType, returnType) =>
     freeClassifiers(paramType)->Belt.Set.union(freeClassifiers(returnType))
   | Code({cls, typ}) => freeClassifiers(typ)->Belt.Set.add(cls)
@@ -42,6 +53,10 @@ let eq = (a: t, b: t): bool => {
     switch (a, b) {
     | (Int, Int) => true
     | (Bool, Bool) => true
+    | (IntArray, IntArray) => true
+    | (Tuple(aElements), Tuple(bElements)) =>
+      Belt.List.length(aElements) == Belt.List.length(bElements) &&
+        Belt.List.every2(aElements, bElements, (a, b) => aux(a, b, ~bm1, ~bm2))
     | (Func(aParam, aReturn), Func(bParam, bReturn)) =>
       aux(aParam, bParam, ~bm1, ~bm2) && aux(aReturn, bReturn, ~bm1, ~bm2)
     | (Code({cls: aCls, typ: aTyp}), Code({cls: bCls, typ: bTyp})) =>
@@ -16,7 +16,11 @@ let ok = (x: 'a) => Belt.Result.Ok(x)
 let fail = (x: TypeError.t) => Belt.Result.Error(x)
 
 module LocalEnv = {
-  type t = Belt.Map.t<Var.t, Typ.t, Var.Cmp.identity>
+  // A variable bound by let cs is visible from the stage it was bound at on,
+  // counting the bottom of the stack as stage 1; other bindings have stage 0
+  // and are visible wherever their local environment is.
+  type binding = {typ: Typ.t, stage: int}
+  type t = Belt.Map.t<Var.t, binding, Var.Cmp.identity>
 
   let make = (): t => Belt.Map.make(~id=module(Var.Cmp))
 }
@@ -85,7 +89,7 @@ module GlobalEnv = {
     switch env.stack {
     | list{current, ...rest} => {
         let {lenv, subcls} = env.clsmap->Belt.Map.getExn(current)
-        let lenv1 = lenv->Belt.Map.set(param, typ)
+        let lenv1 = lenv->Belt.Map.set(param, {LocalEnv.typ: typ, stage: 0})
         let subcls1 = list{cls, ...subcls}
         let stack1 = list{cls, ...rest}
         let clsmap1 = env.clsmap->Belt.Map.set(cls, {lenv: lenv1, subcls: subcls1})
@@ -95,6 +99,18 @@ module GlobalEnv = {
     }
   }
 
+  // Like extendVar, but the variable is also visible at every later stage,
+  // under any classifier. It is never visible at earlier stages.
+  let extendPersistentVar = (env: t, param: Var.t, typ: Typ.t, cls: Classifier.t): t => {
+    let env1 = env->extendVar(param, typ, cls)
+    let stage = env.stack->Belt.List.length
+    let clsmap1 = env1.clsmap->Belt.Map.map(entry => {
+      ...entry,
+      lenv: entry.lenv->Belt.Map.set(param, {LocalEnv.typ: typ, stage}),
+    })
+    {...env1, clsmap: clsmap1}
+  }
+
   let extendPolyCls = (env: t, cls: Classifier.t, base: Classifier.t): t => {
     let {lenv, subcls} = env.clsmap->Belt.Map.getExn(base)
     let subcls1 = list{cls, ...subcls}
@@ -129,16 +145,36 @@ let extractFuncType = (
   aux(Belt.List.reverse(params), returnType, metaData)
 }
 
-@genType
-let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t> => {
+// The types of the operands of an array operation with arity operands, and
+// the type of its result.
+let arraySignature = (op: Operator.ArrayOp.t, arity: int): (array<Typ.t>, Typ.t) => {
+  open Typ
+  switch op {
+  | Make => (Array.make(~length=arity, Int), IntArray)
+  | Length => ([IntArray], Int)
+  | Get => ([IntArray, Int], Int)
+  | Init => ([Int, Func(Int, Int)], IntArray)
+  | Map => ([Func(Int, Int), IntArray], IntArray)
+  | Fold => ([Func(Int, Func(Int, Int)), Int, IntArray], Int)
+  }
+}
+
+/**
+ record is called with every node that checks successfully and its type.
+ */
+let rec typeCheckWith = (
+  expr: Expr.t,
+  env: GlobalEnv.t,
+  record: (Expr.t, Typ.t) => unit,
+): result<Typ.t, TypeError.t> => {
   open Expr
 
-  switch expr.raw {
+  let result = switch expr.raw {
   | IntLit(_) => ok(Typ.Int)
   | BoolLit(_) => ok(Typ.Bool)
   | BinOp({op, left, right}) =>
-    typeCheck(left, env)->Result.flatMap(leftType => {
-      typeCheck(right, env)->Result.flatMap(rightType => {
+    typeCheckWith(left, env, record)->Result.flatMap(leftType => {
+      typeCheckWith(right, env, record)->Result.flatMap(rightType => {
         open Operator.BinOp
         switch op {
         // Arithmetic operations require both operands to be integers and return an integer.
@@ -172,8 +208,8 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
       })
     })
   | ShortCircuitOp({op, left, right}) =>
-    typeCheck(left, env)->Result.flatMap(leftType => {
-      typeCheck(right, env)->Result.flatMap(rightType => {
+    typeCheckWith(left, env, record)->Result.flatMap(leftType => {
+      typeCheckWith(right, env, record)->Result.flatMap(rightType => {
         open Operator.ShortCircuitOp
         switch op {
         | And | Or =>
@@ -188,7 +224,7 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
       })
     })
   | UniOp({op, expr}) =>
-    typeCheck(expr, env)->Result.flatMap(exprType => {
+    typeCheckWith(expr, env, record)->Result.flatMap(exprType => {
       open Operator.UniOp
       switch op {
       | Not =>
@@ -200,12 +236,12 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
       }
     })
   | If({cond, thenBranch, elseBranch}) =>
-    typeCheck(cond, env)->Result.flatMap(condType => {
+    typeCheckWith(cond, env, record)->Result.flatMap(condType => {
       if !(condType->Typ.eq(Typ.Bool)) {
         fail(TypeMismatch({metaData: cond.metaData, expected: Typ.Bool, actual: condType}))
       } else {
-        typeCheck(thenBranch, env)->Result.flatMap(thenType => {
-          typeCheck(elseBranch, env)->Result.flatMap(
+        typeCheckWith(thenBranch, env, record)->Result.flatMap(thenType => {
+          typeCheckWith(elseBranch, env, record)->Result.flatMap(
             elseType => {
               if !(thenType->Typ.eq(elseType)) {
                 fail(
@@ -224,15 +260,61 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
       }
     })
 
+  | ArrayOp({op, args}) =>
+    let (paramTypes, resultType) = arraySignature(op, Belt.List.length(args))
+    args
+    ->Belt.List.toArray
+    ->Array.reduceWithIndex(ok(), (acc, arg, i) =>
+      acc->Result.flatMap(() =>
+        typeCheckWith(arg, env, record)->Result.flatMap(argType => {
+          let expected = paramTypes->Array.getUnsafe(i)
+          if !(argType->Typ.eq(expected)) {
+            fail(TypeMismatch({metaData: arg.metaData, expected, actual: argType}))
+          } else {
+            ok()
+          }
+        })
+      )
+    )
+    ->Result.map(() => resultType)
+
+  | Tuple(elements) =>
+    elements
+    ->Belt.List.reduce(ok(list{}), (acc, element) =>
+      acc->Result.flatMap(types =>
+        typeCheckWith(element, env, record)->Result.map(typ => list{typ, ...types})
+      )
+    )
+    ->Result.map(types => Typ.Tuple(Belt.List.reverse(types)))
+
+  | Proj({tuple, index}) =>
+    typeCheckWith(tuple, env, record)->Result.flatMap(tupleType =>
+      switch tupleType {
+      | Typ.Tuple(types) if index < Belt.List.length(types) =>
+        ok(types->Belt.List.getExn(index))
+      | _ =>
+        fail(
+          UnsupportedFormat({
+            metaData: expr.metaData,
+            message: `Cannot take component ${Int.toString(index)} of ${Typ.toString(tupleType)}`,
+          }),
+        )
+      }
+    )
+
   | Var(v) =>
     let lenv = env->GlobalEnv.currentLocalEnv
     switch Belt.Map.get(lenv, v) {
-    | Some(typ) => ok(typ)
-    | None => fail(UndefinedVariable({metaData: expr.metaData, var: v}))
+    | Some({LocalEnv.typ: typ, stage}) if stage <= env.stack->Belt.List.length => ok(typ)
+    | _ => fail(UndefinedVariable({metaData: expr.metaData, var: v}))
     }
 
-  | Let({param, expr, body}) =>
-    typeCheck(expr, env)
+  | (Let({param, expr, body}) | LetCs({param, expr, body})) as raw =>
+    let extend = switch raw {
+    | LetCs(_) => GlobalEnv.extendPersistentVar
+    | _ => GlobalEnv.extendVar
+    }
+    typeCheckWith(expr, env, record)
     ->Result.flatMap(exprType => {
       switch param.typ {
       | Some(t) =>
@@ -245,8 +327,8 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
       }
     })
     ->Result.flatMap(exprType => {
-      let env1 = env->GlobalEnv.extendVar(param.var, exprType, param.cls)
-      typeCheck(body, env1)
+      let env1 = env->extend(param.var, exprType, param.cls)
+      typeCheckWith(body, env1, record)
     })
     ->Result.flatMap(bodyType => {
       if Typ.freeClassifiers(bodyType)->Belt.Set.has(param.cls) {
@@ -256,7 +338,21 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
       }
     })
 
-  | LetRec({param, expr, body}) =>
+  | LetRec({param, expr, body, memo}) =>
+    // The arguments of a let rec memo function key its cache, which only
+    // ints, booleans and code can.
+    let rec memoizable = (expr: Expr.t): bool =>
+      switch expr.raw {
+      | ClsAbs({body}) => memoizable(body)
+      | Func({params}) =>
+        params->Belt.List.every(p =>
+          switch p.typ {
+          | Some(Int | Bool | Code(_)) => true
+          | _ => false
+          }
+        )
+      | _ => true
+      }
     let rec guessFuncType = (expr: Expr.t): result<Typ.t, TypeError.t> => {
       switch expr.raw {
       | ClsAbs({cls, base, body}) =>
@@ -290,16 +386,28 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
           ok(funcType)
         }
       })
+      ->Belt.Result.flatMap(funcType => {
+        if memo && !memoizable(expr) {
+          fail(
+            UnsupportedFormat({
+              metaData: expr.metaData,
+              message: "Let rec memo can only be used with functions of ints, booleans and code",
+            }),
+          )
+        } else {
+          ok(funcType)
+        }
+      })
 
     paramTypeR->Belt.Result.flatMap(paramType => {
       let env1 = env->GlobalEnv.extendVar(param.var, paramType, param.cls)
 
-      typeCheck(expr, env1)
+      typeCheckWith(expr, env1, record)
       ->Belt.Result.flatMap(exprType => {
         if !(exprType->Typ.eq(paramType)) {
           fail(TypeMismatch({metaData: expr.metaData, expected: paramType, actual: exprType}))
         } else {
-          typeCheck(body, env1)
+          typeCheckWith(body, env1, record)
         }
       })
       ->Belt.Result.flatMap(typ => {
@@ -330,7 +438,7 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
       }
 
     extendEnv(params, env)->Result.flatMap(env1 => {
-      typeCheck(body, env1)->Result.flatMap(bodyType => {
+      typeCheckWith(body, env1, record)->Result.flatMap(bodyType => {
         switch returnType {
         | Some(typ) =>
           if !(typ->Typ.eq(bodyType)) {
@@ -344,8 +452,8 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
     })
 
   | App({func, arg}) =>
-    typeCheck(func, env)->Belt.Result.flatMap(funcType => {
-      typeCheck(arg, env)->Belt.Result.flatMap(argType => {
+    typeCheckWith(func, env, record)->Belt.Result.flatMap(funcType => {
+      typeCheckWith(arg, env, record)->Belt.Result.flatMap(argType => {
         switch funcType {
         | Func(paramType, returnType) =>
           if !(paramType->Typ.eq(argType)) {
@@ -368,7 +476,7 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
       | None => fail(UndefinedClassifier({metaData: expr.metaData, cls}))
       }
       ->Belt.Result.flatMap(env1 => {
-        typeCheck(quoted, env1)
+        typeCheckWith(quoted, env1, record)
       })
       ->Belt.Result.map(typ => {
         Typ.Code({cls, typ})
@@ -381,7 +489,7 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
     switch env->GlobalEnv.popStage(shift) {
     | None => fail(MalformedSplice({metaData: expr.metaData, shift}))
     | Some(env1) =>
-      typeCheck(spliced, env1)->Result.flatMap(typSpliced => {
+      typeCheckWith(spliced, env1, record)->Result.flatMap(typSpliced => {
         switch typSpliced {
         | Code({cls, typ: typExpr}) =>
           let isClsConsistent = env->GlobalEnv.isConsistent(env->GlobalEnv.currentCls, cls)
@@ -403,14 +511,29 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
         }
       })
     }
+  // genlet only moves the code it is given, so it has the type of that code
+  | GenLet({expr: bound}) =>
+    typeCheckWith(bound, env, record)->Result.flatMap(typBound => {
+      switch typBound {
+      | Code(_) => ok(typBound)
+      | _ =>
+        fail(
+          TypeMismatch({
+            metaData: bound.metaData,
+            expected: Typ.Code({cls: Classifier.Initial, typ: Typ.Int}),
+            actual: typBound,
+          }),
+        )
+      }
+    })
   | ClsAbs({cls, base, body}) =>
     let env1 = env->GlobalEnv.extendPolyCls(cls, base)
-    typeCheck(body, env1)->Result.map(bodyType => {
+    typeCheckWith(body, env1, record)->Result.map(bodyType => {
       Typ.ClsAbs({cls, base, body: bodyType})
     })
 
   | ClsApp({func, arg: argCls}) =>
-    typeCheck(func, env)->Result.flatMap(funcType => {
+    typeCheckWith(func, env, record)->Result.flatMap(funcType => {
       switch funcType {
       | ClsAbs({cls: funcCls, base, body}) =>
         if !(env->GlobalEnv.isConsistent(argCls, base)) {
@@ -426,6 +549,8 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
             switch typ {
             | Int => Int
             | Bool => Bool
+            | IntArray => IntArray
+            | Tuple(types) => Tuple(types->Belt.List.map(substitute))
             | Func(paramType, returnType) => Func(substitute(paramType), substitute(returnType))
             | Code({cls, typ}) =>
               if cls->Classifier.eq(funcCls) {
@@ -464,4 +589,30 @@ let rec typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t>
       }
     })
   }
+
+  switch result {
+  | Ok(typ) => record(expr, typ)
+  | Error(_) => ()
+  }
+  result
+}
+
+@genType
+let typeCheck = (expr: Expr.t, env: GlobalEnv.t): result<Typ.t, TypeError.t> =>
+  typeCheckWith(expr, env, (_, _) => ())
+
+/**
+ Like typeCheck, but also returns the type inferred for each node of expr,
+ so that Expr.toTypedRaw can specialize operations by their operand types.
+ */
+@genType
+let typeCheckKeepingTypes = (expr: Expr.t, env: GlobalEnv.t): result<
+  (Typ.t, Expr.t => option<Typ.t>),
+  TypeError.t,
+> => {
+  let types = WeakMap.make()
+  typeCheckWith(expr, env, (e, typ) => types->WeakMap.set(e, typ)->ignore)->Result.map(typ => (
+    typ,
+    e => types->WeakMap.get(e),
+  ))
 }
@@ -564,6 +564,32 @@ describe('Typechecker', () => {
             });
         });
 
+        describe('with memo', () => {
+            it('infer a function of ints', () => {
+                const input = `
+                let rec memo fib = (n: int): int => {
+                  if n <= 1 then n else fib (n - 1) + fib (n - 2)
+                } in
+                fib
+                `
+                expect(typeCheck(parse(input), env)).toEqual({
+                    TAG: "Ok",
+                    _0: "(Int->Int)"
+                });
+            });
+
+            it('fails for a function argument', () => {
+                const input = `
+                let rec memo f = (g: int -> int): int => { g 1 } in
+                f
+                `
+                expect(typeCheck(parse(input), env)).toMatchObject({
+                    TAG: "Error",
+                    _0: { TAG: "UnsupportedFormat" }
+                });
+            });
+        });
+
     });
 
     describe('for quottation', () => {
@@ -916,4 +942,130 @@ describe('Typechecker', () => {
         })
     });
 
+    describe('for let cs', () => {
+        it('makes the variable usable in later stages', () => {
+            expect(typeCheck(parse('let cs x:int = 1 in `{@! x + 1 }'), env)).toEqual({
+                TAG: "Ok",
+                _0: {
+                    TAG: "Code",
+                    cls: "Initial",
+                    typ: "Int"
+                }
+            });
+        });
+
+        it('fails for a mismatching annotation', () => {
+            expect(typeCheck(parse('let cs x:int = true in x'), env)).toEqual({
+                TAG: "Error",
+                _0: {
+                    TAG: "TypeMismatch",
+                    metaData: { start: { row: 0, col: 15 }, end: { row: 0, col: 19 } },
+                    expected: "Int",
+                    actual: "Bool"
+                }
+            });
+        });
+
+        it('fails for a use at an earlier stage', () => {
+            const input = '`{@! let cs x = 1 in ~{ if x == 1 then `{@! 1 } else `{@! 2 } } }'
+            expect(typeCheck(parse(input), env)).toEqual({
+                TAG: "Error",
+                _0: {
+                    TAG: "UndefinedVariable",
+                    metaData: { start: { row: 0, col: 26 }, end: { row: 0, col: 27 } },
+                    var: { TAG: "Raw", name: "x" }
+                }
+            });
+        });
+    });
+
+    describe('for genlet', () => {
+        it('infer the type of the bound code', () => {
+            const input = "`{@! ~{ genlet `{@! 1 + 1 } } * 2 }"
+            expect(typeCheck(parse(input), env)).toEqual({
+                TAG: "Ok",
+                _0: {
+                    TAG: "Code",
+                    cls: "Initial",
+                    typ: "Int"
+                }
+            });
+        });
+
+        it('fails for non-code', () => {
+            expect(typeCheck(parse('genlet 1'), env)).toEqual({
+                TAG: "Error",
+                _0: {
+                    TAG: "TypeMismatch",
+                    metaData: { start: { row: 0, col: 7 }, end: { row: 0, col: 8 } },
+                    expected: { TAG: "Code", cls: "Initial", typ: "Int" },
+                    actual: "Int"
+                }
+            });
+        });
+    });
+
+
+    describe('for arrays', () => {
+        it('types bulk operations', () => {
+            const input = 'Array.fold ((z:int, x:int) => { z + x }) 0 (Array.map ((x:int) => { x * 2 }) [| 1, 2 |])'
+            expect(typeCheck(parse(input), env)).toEqual({ TAG: "Ok", _0: "Int" });
+        });
+
+        it('types annotated arrays and indexing', () => {
+            expect(typeCheck(parse('(a:array<int>) => { Array.init (Array.length a) ((i:int) => { a.(i) }) }'), env)).toEqual({
+                TAG: "Ok",
+                _0: { TAG: "Func", _0: "IntArray", _1: "IntArray" }
+            });
+        });
+
+        it('fails for elements that are not ints', () => {
+            expect(typeCheck(parse('[| 1, true |]'), env)).toEqual({
+                TAG: "Error",
+                _0: {
+                    TAG: "TypeMismatch",
+                    metaData: { start: { row: 0, col: 6 }, end: { row: 0, col: 10 } },
+                    expected: "Int",
+                    actual: "Bool"
+                }
+            });
+        });
+
+        it('fails for a function of the wrong type', () => {
+            expect(typeCheck(parse('Array.map ((x:int) => { x == 0 }) [| 1 |]'), env)).toEqual({
+                TAG: "Error",
+                _0: {
+                    TAG: "TypeMismatch",
+                    metaData: { start: { row: 0, col: 11 }, end: { row: 0, col: 32 } },
+                    expected: { TAG: "Func", _0: "Int", _1: "Int" },
+                    actual: { TAG: "Func", _0: "Int", _1: "Bool" }
+                }
+            });
+        });
+    });
+
+    describe('for tuples', () => {
+        it('types tuples and projections', () => {
+            expect(typeCheck(parse('(p:(int * bool)) => { (p.1, p.0 + 1) }'), env)).toEqual({
+                TAG: "Ok",
+                _0: {
+                    TAG: "Func",
+                    _0: { TAG: "Tuple", _0: { hd: "Int", tl: { hd: "Bool", tl: 0 } } },
+                    _1: { TAG: "Tuple", _0: { hd: "Bool", tl: { hd: "Int", tl: 0 } } }
+                }
+            });
+        });
+
+        it('fails for a component out of range', () => {
+            expect(typeCheck(parse('(1, 2).2'), env)).toEqual({
+                TAG: "Error",
+                _0: {
+                    TAG: "UnsupportedFormat",
+                    metaData: { start: { row: 0, col: 0 }, end: { row: 0, col: 8 } },
+                    message: "Cannot take component 2 of (Int*Int)"
+                }
+            });
+        });
+    });
+
 });
@@ -0,0 +1,526 @@
+// Compiles generated functions to WebAssembly, so that code run with ~0
+// runs at the speed of the browser's own compiler instead of through
+// evaluatePresent.
+//
+// The fragment is the first-order one of the native engine's bytecode:
+// functions over ints and booleans built from literals, variables, let,
+// if, the arithmetic, comparison and logical operators, and functions bound
+// by let and let rec that are applied to all of their arguments and mention
+// no local variable of an enclosing function. Both kinds of value are i32
+// in WebAssembly, booleans being 0 and 1; which is which is inferred from
+// how each variable is used, as the code carries no types. Anything else is
+// left to the interpreter.
+
+let enabled = ref(true)
+
+@genType
+let setEnabled = (b: bool): unit => enabled := b
+
+@genType
+type kind = Int | Bool
+
+// A compiled function. invoke takes arity arguments, each of the kind in
+// params, and returns None when the code divided by zero.
+@genType
+type func = {
+  arity: int,
+  params: array<kind>,
+  result: kind,
+  invoke: array<int> => option<int>,
+}
+
+exception Unsupported(string)
+
+// Kinds being inferred: a variable is Unknown until some use decides it.
+type rec ty = {mutable state: state}
+and state = Known(kind) | Unknown | Same(ty)
+
+let fresh = (): ty => {state: Unknown}
+let known = (k: kind): ty => {state: Known(k)}
+
+let rec repr = (t: ty): ty =>
+  switch t.state {
+  | Same(t1) => repr(t1)
+  | _ => t
+  }
+
+let unify = (a: ty, b: ty): unit => {
+  let a = repr(a)
+  let b = repr(b)
+  if a !== b {
+    switch (a.state, b.state) {
+    | (Unknown, _) => a.state = Same(b)
+    | (_, Unknown) => b.state = Same(a)
+    | (Known(x), Known(y)) if x == y => ()
+    | _ => raise(Unsupported("ill-typed code"))
+    }
+  }
+}
+
+// A kind nothing decided cannot matter to the code; the caller still
+// checks that arguments have it.
+let resolve = (t: ty): kind =>
+  switch repr(t).state {
+  | Known(k) => k
+  | _ => Int
+  }
+
+module Op = {
+  let unreachable = 0x00
+  let if_ = 0x04
+  let else_ = 0x05
+  let end_ = 0x0b
+  let call = 0x10
+  let localGet = 0x20
+  let localSet = 0x21
+  let localTee = 0x22
+  let i32Const = 0x41
+  let i32Eqz = 0x45
+  let i32Eq = 0x46
+  let i32Ne = 0x47
+  let i32LtS = 0x48
+  let i32GtS = 0x4a
+  let i32LeS = 0x4c
+  let i32GeS = 0x4e
+  let i32Add = 0x6a
+  let i32Sub = 0x6b
+  let i32Mul = 0x6c
+  let i32DivS = 0x6d
+  let i32RemS = 0x6f
+  // block types
+  let void = 0x40
+  let i32 = 0x7f
+}
+
+module Writer = Serialize.Writer
+
+// n as a signed LEB128 number, as i32.const takes it.
+let rec sint = (w: Writer.t, n: int): unit => {
+  let low = Int.Bitwise.land(n, 0x7f)
+  let rest = Int.Bitwise.asr(n, 7)
+  let last =
+    (rest == 0 && Int.Bitwise.land(low, 0x40) == 0) ||
+      (rest == -1 && Int.Bitwise.land(low, 0x40) != 0)
+  if last {
+    w->Writer.byte(low)
+  } else {
+    w->Writer.byte(Int.Bitwise.lor(low, 0x80))
+    w->sint(rest)
+  }
+}
+
+type binding =
+  | Local({var: Var.t, index: int, ty: ty})
+  | Function({var: Var.t, index: int, params: array<ty>, result: ty})
+
+// A function of the module being built.
+type funcBuilder = {
+  nparams: int,
+  mutable nlocals: int,
+  body: Writer.t,
+}
+
+type context = {
+  funcs: array<funcBuilder>,
+  self: funcBuilder,
+  mutable scope: list<binding>,
+}
+
+let lookup = (ctx: context, v: Var.t): binding =>
+  switch ctx.scope->Belt.List.getBy(b =>
+    switch b {
+    | Local({var}) | Function({var}) => var == v
+    }
+  ) {
+  | Some(b) => b
+  | None => raise(Unsupported(`free variable ${Var.toString(v)}`))
+  }
+
+let newLocal = (ctx: context): int => {
+  let index = ctx.self.nparams + ctx.self.nlocals
+  ctx.self.nlocals = ctx.self.nlocals + 1
+  index
+}
+
+let emit = (ctx: context, b: int): unit => ctx.self.body->Writer.byte(b)
+let emitIndex = (ctx: context, op: int, index: int): unit => {
+  ctx->emit(op)
+  ctx.self.body->Writer.uint(index)
+}
+
+// Emits e, leaving its value on the stack, and returns its kind.
+let rec compile = (ctx: context, e: RawExpr.t): ty => {
+  open RawExpr
+
+  switch e {
+  | IntLit(i) =>
+    ctx->emit(Op.i32Const)
+    ctx.self.body->sint(i)
+    known(Int)
+  | BoolLit(b) =>
+    ctx->emit(Op.i32Const)
+    ctx.self.body->sint(b ? 1 : 0)
+    known(Bool)
+  | Var(v) =>
+    switch ctx->lookup(v) {
+    | Local({index, ty}) =>
+      ctx->emitIndex(Op.localGet, index)
+      ty
+    | Function(_) => raise(Unsupported("function used as a value"))
+    }
+  | Let({param, expr: Func({params: fparams, body: fbody}), body}) =>
+    ctx->define(param, fparams, fbody, false, body)
+  // Its cache lives in the interpreter.
+  | LetRec({memo: true}) => raise(Unsupported("let rec memo"))
+  | LetRec({param, expr: Func({params: fparams, body: fbody}), body}) =>
+    ctx->define(param, fparams, fbody, true, body)
+  | Let({param, expr, body}) =>
+    let ty = ctx->compile(expr)
+    let index = ctx->newLocal
+    ctx->emitIndex(Op.localSet, index)
+    let saved = ctx.scope
+    ctx.scope = list{Local({var: param, index, ty}), ...saved}
+    let result = ctx->compile(body)
+    ctx.scope = saved
+    result
+  | BinOp({op, left, right}) =>
+    open Operator.BinOp
+    switch op {
+    | Add => ctx->arithmetic(Op.i32Add, left, right)
+    | Sub => ctx->arithmetic(Op.i32Sub, left, right)
+    | Mul => ctx->arithmetic(Op.i32Mul, left, right)
+    | Div => ctx->division(true, left, right)
+    | Mod => ctx->division(false, left, right)
+    | Eq => ctx->equality(Op.i32Eq, left, right)
+    | Ne => ctx->equality(Op.i32Ne, left, right)
+    | Lt => ctx->comparison(Op.i32LtS, left, right)
+    | Le => ctx->comparison(Op.i32LeS, left, right)
+    | Gt => ctx->comparison(Op.i32GtS, left, right)
+    | Ge => ctx->comparison(Op.i32GeS, left, right)
+    }
+  | PrimOp({op, left, right}) =>
+    open Operator.PrimOp
+    switch op {
+    | IntAdd => ctx->arithmetic(Op.i32Add, left, right)
+    | IntSub => ctx->arithmetic(Op.i32Sub, left, right)
+    | IntMul => ctx->arithmetic(Op.i32Mul, left, right)
+    | IntDiv => ctx->division(true, left, right)
+    | IntMod => ctx->division(false, left, right)
+    | IntEq => ctx->comparison(Op.i32Eq, left, right)
+    | IntNe => ctx->comparison(Op.i32Ne, left, right)
+    | IntLt => ctx->comparison(Op.i32LtS, left, right)
+    | IntLe => ctx->comparison(Op.i32LeS, left, right)
+    | IntGt => ctx->comparison(Op.i32GtS, left, right)
+    | IntGe => ctx->comparison(Op.i32GeS, left, right)
+    | BoolEq =>
+      ctx->expect(left, Bool)
+      ctx->expect(right, Bool)
+      ctx->emit(Op.i32Eq)
+      known(Bool)
+    | BoolNe =>
+      ctx->expect(left, Bool)
+      ctx->expect(right, Bool)
+      ctx->emit(Op.i32Ne)
+      known(Bool)
+    | BoolAnd => ctx->shortCircuit(true, left, right)
+    | BoolOr => ctx->shortCircuit(false, left, right)
+    }
+  | ShortCircuitOp({op, left, right}) =>
+    ctx->shortCircuit(op == Operator.ShortCircuitOp.And, left, right)
+  | UniOp({expr}) | PrimNot({expr}) =>
+    ctx->expect(expr, Bool)
+    ctx->emit(Op.i32Eqz)
+    known(Bool)
+  | If({cond, thenBranch, elseBranch}) =>
+    ctx->expect(cond, Bool)
+    ctx->emit(Op.if_)
+    ctx->emit(Op.i32)
+    let thenTy = ctx->compile(thenBranch)
+    ctx->emit(Op.else_)
+    let elseTy = ctx->compile(elseBranch)
+    ctx->emit(Op.end_)
+    unify(thenTy, elseTy)
+    thenTy
+  | App(_) => ctx->call(e)
+  | Func(_) => raise(Unsupported("function value"))
+  | LetRec(_) => raise(Unsupported("let rec of a value that is not a function"))
+  | LetCs(_) | CsValue(_) => raise(Unsupported("cross-stage persistence"))
+  | Quote(_) | Splice(_) | GenLet(_) => raise(Unsupported("staging construct"))
+  | ArrayOp(_) => raise(Unsupported("array"))
+  | Tuple(_) | Proj(_) => raise(Unsupported("tuple"))
+  }
+}
+and expect = (ctx: context, e: RawExpr.t, k: kind): unit => unify(ctx->compile(e), known(k))
+and arithmetic = (ctx: context, op: int, left: RawExpr.t, right: RawExpr.t): ty => {
+  ctx->expect(left, Int)
+  ctx->expect(right, Int)
+  ctx->emit(op)
+  known(Int)
+}
+and comparison = (ctx: context, op: int, left: RawExpr.t, right: RawExpr.t): ty => {
+  ctx->expect(left, Int)
+  ctx->expect(right, Int)
+  ctx->emit(op)
+  known(Bool)
+}
+and equality = (ctx: context, op: int, left: RawExpr.t, right: RawExpr.t): ty => {
+  let leftTy = ctx->compile(left)
+  let rightTy = ctx->compile(right)
+  unify(leftTy, rightTy)
+  ctx->emit(op)
+  known(Bool)
+}
+// i32.div_s traps where the interpreter wraps, on the minimum divided by
+// -1, so that case negates instead. A zero divisor traps, which invoke
+// reports.
+and division = (ctx: context, isDiv: bool, left: RawExpr.t, right: RawExpr.t): ty => {
+  ctx->expect(left, Int)
+  let l = ctx->newLocal
+  ctx->emitIndex(Op.localSet, l)
+  ctx->expect(right, Int)
+  let r = ctx->newLocal
+  ctx->emitIndex(Op.localTee, r)
+  ctx->emit(Op.i32Eqz)
+  ctx->emit(Op.if_)
+  ctx->emit(Op.void)
+  ctx->emit(Op.unreachable)
+  ctx->emit(Op.end_)
+  if isDiv {
+    ctx->emitIndex(Op.localGet, r)
+    ctx->emit(Op.i32Const)
+    ctx.self.body->sint(-1)
+    ctx->emit(Op.i32Eq)
+    ctx->emit(Op.if_)
+    ctx->emit(Op.i32)
+    ctx->emit(Op.i32Const)
+    ctx.self.body->sint(0)
+    ctx->emitIndex(Op.localGet, l)
+    ctx->emit(Op.i32Sub)
+    ctx->emit(Op.else_)
+    ctx->emitIndex(Op.localGet, l)
+    ctx->emitIndex(Op.localGet, r)
+    ctx->emit(Op.i32DivS)
+    ctx->emit(Op.end_)
+  } else {
+    // rem_s of the minimum by -1 is 0, as in JavaScript
+    ctx->emitIndex(Op.localGet, l)
+    ctx->emitIndex(Op.localGet, r)
+    ctx->emit(Op.i32RemS)
+  }
+  known(Int)
+}
+and shortCircuit = (ctx: context, isAnd: bool, left: RawExpr.t, right: RawExpr.t): ty => {
+  ctx->expect(left, Bool)
+  ctx->emit(Op.if_)
+  ctx->emit(Op.i32)
+  if isAnd {
+    ctx->expect(right, Bool)
+    ctx->emit(Op.else_)
+    ctx->emit(Op.i32Const)
+    ctx.self.body->sint(0)
+  } else {
+    ctx->emit(Op.i32Const)
+    ctx.self.body->sint(1)
+    ctx->emit(Op.else_)
+    ctx->expect(right, Bool)
+  }
+  ctx->emit(Op.end_)
+  known(Bool)
+}
+// A saturated application of a function bound by let or let rec.
+and call = (ctx: context, e: RawExpr.t): ty => {
+  let rec spine = (e: RawExpr.t, args) =>
+    switch e {
+    | App({func, arg}) => spine(func, list{arg, ...args})
+    | _ => (e, args)
+    }
+  let (head, args) = spine(e, list{})
+  switch head {
+  | Var(v) =>
+    switch ctx->lookup(v) {
+    | Function({index, params, result}) =>
+      if Belt.List.length(args) != Array.length(params) {
+        raise(Unsupported(`partial application of ${Var.toString(v)}`))
+      }
+      args->Belt.List.forEachWithIndex((i, arg) =>
+        unify(ctx->compile(arg), params->Array.getUnsafe(i))
+      )
+      ctx->emitIndex(Op.call, index)
+      result
+    | Local(_) => raise(Unsupported("application of a parameter"))
+    }
+  | _ => raise(Unsupported("application of a computed function"))
+  }
+}
+// Adds a function of the module for params and fbody and compiles body
+// with param bound to it. The function sees the functions in scope, and
+// itself when rec, but no local variable.
+and define = (
+  ctx: context,
+  param: Var.t,
+  params: list<Var.t>,
+  fbody: RawExpr.t,
+  isRec: bool,
+  body: RawExpr.t,
+): ty => {
+  let fn = ctx->newFunction(params, fbody, param, isRec)
+  let saved = ctx.scope
+  ctx.scope = list{fn, ...saved}
+  let result = ctx->compile(body)
+  ctx.scope = saved
+  result
+}
+and newFunction = (
+  ctx: context,
+  params: list<Var.t>,
+  fbody: RawExpr.t,
+  name: Var.t,
+  isRec: bool,
+): binding => {
+  let index = ctx.funcs->Array.length
+  let builder = {nparams: Belt.List.length(params), nlocals: 0, body: Writer.make()}
+  ctx.funcs->Array.push(builder)
+  let paramTys = params->Belt.List.toArray->Array.map(_ => fresh())
+  let resultTy = fresh()
+  let fn = Function({var: name, index, params: paramTys, result: resultTy})
+
+  let functions = ctx.scope->Belt.List.keep(b =>
+    switch b {
+    | Function(_) => true
+    | Local(_) => false
+    }
+  )
+  let locals =
+    params->Belt.List.mapWithIndex((i, var) => Local({
+      var,
+      index: i,
+      ty: paramTys->Array.getUnsafe(i),
+    }))
+  let scope = Belt.List.concat(locals, isRec ? list{fn, ...functions} : functions)
+  let inner = {funcs: ctx.funcs, self: builder, scope}
+  unify(inner->compile(fbody), resultTy)
+  inner->emit(Op.end_)
+  fn
+}
+
+let section = (w: Writer.t, id: int, contents: Writer.t): unit => {
+  let bytes = contents->Writer.contents
+  w->Writer.byte(id)
+  w->Writer.uint(TypedArray.length(bytes))
+  w->Writer.append(bytes)
+}
+
+// The module for funcs, exporting the first as "main".
+let assemble = (funcs: array<funcBuilder>): Uint8Array.t => {
+  let w = Writer.make()
+  [0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00]->Array.forEach(b => w->Writer.byte(b))
+
+  let types = Writer.make()
+  types->Writer.uint(Array.length(funcs))
+  funcs->Array.forEach(f => {
+    types->Writer.byte(0x60)
+    types->Writer.uint(f.nparams)
+    for _i in 1 to f.nparams {
+      types->Writer.byte(Op.i32)
+    }
+    types->Writer.uint(1)
+    types->Writer.byte(Op.i32)
+  })
+  w->section(1, types)
+
+  let functions = Writer.make()
+  functions->Writer.uint(Array.length(funcs))
+  funcs->Array.forEachWithIndex((_, i) => functions->Writer.uint(i))
+  w->section(3, functions)
+
+  let exports = Writer.make()
+  exports->Writer.uint(1)
+  // "main"
+  [0x04, 0x6d, 0x61, 0x69, 0x6e]->Array.forEach(b => exports->Writer.byte(b))
+  exports->Writer.byte(0x00)
+  exports->Writer.uint(0)
+  w->section(7, exports)
+
+  let code = Writer.make()
+  code->Writer.uint(Array.length(funcs))
+  funcs->Array.forEach(f => {
+    let entry = Writer.make()
+    if f.nlocals > 0 {
+      entry->Writer.uint(1)
+      entry->Writer.uint(f.nlocals)
+      entry->Writer.byte(Op.i32)
+    } else {
+      entry->Writer.uint(0)
+    }
+    entry->Writer.append(f.body->Writer.contents)
+    code->Writer.uint(TypedArray.length(entry->Writer.contents))
+    code->Writer.append(entry->Writer.contents)
+  })
+  w->section(10, code)
+
+  w->Writer.contents
+}
+
+type wasmModule
+type wasmInstance
+type exported
+
+@new @scope("WebAssembly") external makeModule: Uint8Array.t => wasmModule = "Module"
+@new @scope("WebAssembly") external instantiate: wasmModule => wasmInstance = "Instance"
+@get external exports: wasmInstance => {"main": exported} = "exports"
+@send external apply: (exported, Nullable.t<unit>, array<int>) => int = "apply"
+
+// Traps other than a zero divisor cannot happen in the code compile emits.
+let isTrap: Exn.t => bool = %raw(`e => e instanceof WebAssembly.RuntimeError`)
+
+// The module for a function of the fragment; None for anything else.
+let build = (code: RawExpr.t): option<func> =>
+  switch code {
+  | Func({params, body}) =>
+    let main = {nparams: Belt.List.length(params), nlocals: 0, body: Writer.make()}
+    let ctx = {funcs: [main], self: main, scope: list{}}
+    let paramTys = params->Belt.List.toArray->Array.map(_ => fresh())
+    ctx.scope = params->Belt.List.mapWithIndex((i, var) => Local({
+      var,
+      index: i,
+      ty: paramTys->Array.getUnsafe(i),
+    }))
+    try {
+      let resultTy = ctx->compile(body)
+      ctx->emit(Op.end_)
+      // Browsers may refuse to compile large modules synchronously; those
+      // stay interpreted too.
+      let instance = makeModule(assemble(ctx.funcs))->instantiate->exports
+      Some({
+        arity: Array.length(paramTys),
+        params: paramTys->Array.map(resolve),
+        result: resolve(resultTy),
+        invoke: args =>
+          try Some(instance["main"]->apply(Nullable.null, args)) catch {
+          | Exn.Error(e) if isTrap(e) => None
+          },
+      })
+    } catch {
+    | Unsupported(_) => None
+    | Exn.Error(_) => None
+    }
+  | _ => None
+  }
+
+// Compiled functions by the code they were compiled from, so that code run
+// again is not compiled again.
+let cache: WeakMap.t<RawExpr.t, option<func>> = WeakMap.make()
+
+@genType
+let compile = (code: RawExpr.t): option<func> =>
+  if !enabled.contents {
+    None
+  } else {
+    switch cache->WeakMap.get(code) {
+    | Some(f) => f
+    | None =>
+      let f = build(code)
+      cache->WeakMap.set(code, f)->ignore
+      f
+    }
+  }
@@ -0,0 +1,130 @@
+import { expect, it, beforeAll, afterEach, describe } from 'vitest';
+import { Parser, Language } from 'web-tree-sitter';
+import { parseSourceFileNode } from './SyntaxNodeParser.gen.ts';
+import { stripTypeInfo } from './Expr.gen.ts';
+import { evaluateRuntime, Env_make } from './Interpreter.gen.ts';
+import { compile, setEnabled } from './WasmBackend.gen.ts';
+import { t as Expr_t } from './Expr.gen.ts'
+
+let parser;
+
+const parse = (input) => {
+    // Assume that parse always succeeds
+    return stripTypeInfo(parseSourceFileNode((parser.parse(input)).rootNode)._0 as Expr_t);
+}
+
+beforeAll(
+    async () => {
+        await Parser.init();
+        const parser1 = new Parser();
+        const lamgamma = await Language.load('public/tree-sitter-lamgamma_parser.wasm');
+        parser1.setLanguage(lamgamma);
+        parser = parser1;
+    }
+)
+
+afterEach(() => setEnabled(true));
+
+const venv = Env_make();
+const nenv = Env_make();
+
+const run = (input) => evaluateRuntime(parse(input), venv, nenv);
+
+// Runs the program with and without compilation; both must agree.
+const runBoth = (input) => {
+    setEnabled(false);
+    const expected = run(input);
+    setEnabled(true);
+    const actual = run(input);
+    expect(actual).toEqual(expected);
+    return actual;
+}
+
+const spower = (n) => `
+  let rec pow1 = (n, xq) => {
+    if n == 0 then
+      \`{ 1 }
+    else if n mod 2 == 0 then
+      pow1 (n / 2) (genlet \`{ ~{ xq } * ~{ xq } })
+    else
+      \`{ ~{ xq } * ~{ pow1 (n - 1) xq } }
+  } in
+  \`{ (x) => { ~{ pow1 ${n} \`{ x } } } }
+`
+
+describe('compile', () => {
+    it('compiles first-order functions', () => {
+        const f = compile(parse('(x, y) => { if x < y && !(x == 0) then x - y else y mod 7 }'));
+        expect(f).toMatchObject({ arity: 2, params: ["Int", "Int"], result: "Int" });
+        expect(f.invoke([1, 5])).toBe(-4);
+        expect(f.invoke([0, 5])).toBe(5);
+        expect(f.invoke([9, -10])).toBe(-3);
+    });
+
+    it('infers which values are booleans', () => {
+        const f = compile(parse('(b, x) => { if b then x > 0 else b }'));
+        expect(f).toMatchObject({ params: ["Bool", "Int"], result: "Bool" });
+        expect(f.invoke([1, 3])).toBe(1);
+        expect(f.invoke([0, 3])).toBe(0);
+    });
+
+    it('compiles local recursive functions', () => {
+        const f = compile(parse(`
+          (n) => {
+            let rec fib = (n) => { if n <= 1 then 1 else fib (n - 1) + fib (n - 2) } in
+            fib n
+          }
+        `));
+        expect(f.invoke([20])).toBe(10946);
+    });
+
+    it('wraps like the interpreter', () => {
+        const div = compile(parse('(x, y) => { x / y }'));
+        const mod = compile(parse('(x, y) => { x mod y }'));
+        const mul = compile(parse('(x) => { x * x + 1 }'));
+        expect(div.invoke([-2147483648, -1])).toBe(-2147483648);
+        expect(mod.invoke([-2147483648, -1])).toBe(0);
+        expect(mod.invoke([-7, 3])).toBe(-1);
+        expect(mul.invoke([65536])).toBe(1);
+        expect(div.invoke([1, 0])).toBeUndefined();
+    });
+
+    it('leaves code outside the fragment alone', () => {
+        for (const code of ['(f) => { f 1 }', '(x) => { (y) => { x } }', '(x) => { y }',
+                            '(x) => { x + true }', '1 + 2', '(x) => { `{ x } }',
+                            '(x) => { let rec f = (y, z) => { y } in f x }']) {
+            expect(compile(parse(code))).toBeUndefined();
+        }
+    });
+
+    it('compiles nothing when disabled', () => {
+        setEnabled(false);
+        expect(compile(parse('(x) => { x + 1 }'))).toBeUndefined();
+    });
+});
+
+describe('running generated code', () => {
+    it('applies compiled code as a closure', () => {
+        const result = runBoth(`let c = ${spower(13)} in ~0{ c } 2`);
+        expect(result).toEqual({ TAG: "Ok", _0: { TAG: "IntVal", _0: 8192 } });
+        expect(run(`let c = ${spower(13)} in ~0{ c }`)).toMatchObject({
+            TAG: "Ok",
+            _0: { TAG: "Native" }
+        });
+    });
+
+    it('applies compiled code one argument at a time', () => {
+        const code = 'let c = `{ (x, y) => { x * 10 + y } } in let f = ~0{ c } in let g = f 4 in g 2';
+        expect(runBoth(code)).toEqual({ TAG: "Ok", _0: { TAG: "IntVal", _0: 42 } });
+    });
+
+    it('reports division by zero', () => {
+        const code = 'let c = `{ (x) => { 1 / x } } in ~0{ c } 0';
+        expect(runBoth(code)).toEqual({ TAG: "Error", _0: "ZeroDivision" });
+    });
+
+    it('falls back to the interpreter for arguments of another kind', () => {
+        const code = 'let c = `{ (x) => { x } } in ~0{ c } true';
+        expect(runBoth(code)).toEqual({ TAG: "Ok", _0: { TAG: "BoolVal", _0: true } });
+    });
+});
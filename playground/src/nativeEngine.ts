@@ -0,0 +1,51 @@
+// The native engine (native/) built to WebAssembly, as lamgamma-native.js
+// and lamgamma-native.wasm in public/; see native/CMakeLists.txt. It has the
+// entry points of Frontend.gen, except that it parses with its own copy of
+// the grammar and so takes the source alone.
+//
+// checkDocument is typeCheck for the program in the editor. The engine
+// keeps the previous version and rechecks only what an edit changed, so
+// type feedback while typing does not grow with the size of the program.
+//
+// The engine evaluates on its bytecode VM, which runs first-order programs
+// over ints and booleans. For other programs evaluate returns undefined and
+// the caller falls back to the interpreter.
+
+export interface NativeEngine {
+    evaluate(input: string): string | undefined,
+    typeCheck(input: string): string,
+    checkDocument(input: string): string,
+    stripTypeInfo(input: string): string,
+}
+
+interface EmscriptenModule {
+    cwrap(name: string, returnType: string | null, argTypes: string[]): (...args: unknown[]) => unknown,
+    UTF8ToString(pointer: number): string,
+}
+
+type CreateModule = (options: { locateFile(path: string): string }) => Promise<EmscriptenModule>;
+
+// Undefined when the engine has not been built into public/ or cannot be
+// instantiated; the playground then only offers the interpreter.
+export const loadNativeEngine = async (base: string): Promise<NativeEngine | undefined> => {
+    try {
+        const { default: create } = await import(/* @vite-ignore */ base + 'lamgamma-native.js') as { default: CreateModule };
+        const module = await create({ locateFile: (path) => base + path });
+        const typeCheck = module.cwrap('lamgamma_typecheck', 'string', ['string']);
+        const checkDocument = module.cwrap('lamgamma_typecheck_document', 'string', ['string']);
+        const stripTypeInfo = module.cwrap('lamgamma_strip_type_info', 'string', ['string']);
+        // A pointer, so that null can be told apart from an empty string.
+        const evaluate = module.cwrap('lamgamma_evaluate', 'number', ['string']);
+        return {
+            evaluate: (input) => {
+                const result = evaluate(input) as number;
+                return result === 0 ? undefined : module.UTF8ToString(result);
+            },
+            typeCheck: (input) => typeCheck(input) as string,
+            checkDocument: (input) => checkDocument(input) as string,
+            stripTypeInfo: (input) => stripTypeInfo(input) as string,
+        };
+    } catch {
+        return undefined;
+    }
+}
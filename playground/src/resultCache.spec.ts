@@ -0,0 +1,146 @@
+import { expect, it, describe, vi } from 'vitest';
+import type { Parser } from 'web-tree-sitter';
+import { ResultCache, evaluateCached, hashSource } from './resultCache';
+
+// Each program evaluates to its source repeated as many times as its first
+// character's code; the evaluator and checker are stubs.
+const frontend = vi.hoisted(() => ({
+    evaluateTo: vi.fn((code: string, _parser: unknown, write: (piece: string) => void) => {
+        for (let i = 0; i < code.charCodeAt(0); i++) write(code);
+    }),
+}));
+vi.mock('./interpreter/Frontend.gen', () => ({
+    evaluateTo: frontend.evaluateTo,
+    typeCheck: () => 'Int',
+    stripTypeInfoTo: (code: string, _parser: unknown, write: (piece: string) => void) => write(code),
+}));
+
+class MemoryStorage implements Storage {
+    private items = new Map<string, string>();
+    get length() { return this.items.size; }
+    clear() { this.items.clear(); }
+    getItem(key: string) { return this.items.get(key) ?? null; }
+    key(index: number) { return [...this.items.keys()][index] ?? null; }
+    removeItem(key: string) { this.items.delete(key); }
+    setItem(key: string, value: string) { this.items.set(key, value); }
+}
+
+describe('hashSource', () => {
+    it('depends on the whole source', () => {
+        expect(hashSource('1 + 2')).toBe(hashSource('1 + 2'));
+        expect(hashSource('1 + 2')).not.toBe(hashSource('1 + 3'));
+        expect(hashSource('')).not.toBe(hashSource(' '));
+    });
+});
+
+describe('ResultCache', () => {
+    it('evicts the least recently used entry', () => {
+        const cache = new ResultCache<number>(2);
+        cache.set('a', 1);
+        cache.set('b', 2);
+        expect(cache.get('a')).toBe(1);
+        cache.set('c', 3);
+        expect(cache.get('b')).toBeUndefined();
+        expect(cache.get('a')).toBe(1);
+        expect(cache.get('c')).toBe(3);
+        expect(cache.size).toBe(2);
+    });
+
+    it('replaces the entry for a source set twice', () => {
+        const cache = new ResultCache<number>(2);
+        cache.set('a', 1);
+        cache.set('a', 2);
+        expect(cache.get('a')).toBe(2);
+        expect(cache.size).toBe(1);
+    });
+
+    it('survives a reload through storage', () => {
+        const storage = new MemoryStorage();
+        const cache = new ResultCache<string>(4, storage);
+        cache.set('let x = 1 in x', 'int');
+        cache.set('true', 'bool');
+        const reloaded = new ResultCache<string>(4, storage);
+        expect(reloaded.get('let x = 1 in x')).toBe('int');
+        expect(reloaded.get('true')).toBe('bool');
+    });
+
+    it('keeps oversized entries in memory only', () => {
+        const storage = new MemoryStorage();
+        const cache = new ResultCache<string>(4, storage, 'results', 100);
+        cache.set('small', 'ok');
+        cache.set('large', 'x'.repeat(200));
+        expect(cache.get('large')).toBe('x'.repeat(200));
+        const reloaded = new ResultCache<string>(4, storage, 'results', 100);
+        expect(reloaded.get('small')).toBe('ok');
+        expect(reloaded.get('large')).toBeUndefined();
+    });
+
+    it('writes a burst of sets to storage once', () => {
+        vi.useFakeTimers();
+        try {
+            const storage = new MemoryStorage();
+            const setItem = vi.spyOn(storage, 'setItem');
+            const cache = new ResultCache<number>(4, storage, 'results', 100, 500);
+            cache.set('a', 1);
+            cache.set('b', 2);
+            cache.set('a', 3);
+            expect(setItem).not.toHaveBeenCalled();
+            vi.advanceTimersByTime(500);
+            expect(setItem).toHaveBeenCalledTimes(1);
+            const reloaded = new ResultCache<number>(4, storage, 'results', 100);
+            expect(reloaded.get('a')).toBe(3);
+            expect(reloaded.get('b')).toBe(2);
+        } finally {
+            vi.useRealTimers();
+        }
+    });
+
+    it('writes a pending save on flush', () => {
+        vi.useFakeTimers();
+        try {
+            const storage = new MemoryStorage();
+            const cache = new ResultCache<string>(4, storage, 'results', 100, 500);
+            cache.set('true', 'bool');
+            cache.flush();
+            expect(new ResultCache<string>(4, storage, 'results').get('true')).toBe('bool');
+            expect(vi.getTimerCount()).toBe(0);
+        } finally {
+            vi.useRealTimers();
+        }
+    });
+
+    it('drops a corrupt stored cache', () => {
+        const storage = new MemoryStorage();
+        storage.setItem('results', '{not json');
+        const cache = new ResultCache<string>(4, storage, 'results');
+        expect(cache.size).toBe(0);
+        expect(storage.getItem('results')).toBeNull();
+    });
+});
+
+describe('evaluateCached', () => {
+    const parser = {} as Parser;
+    const run = (code: string): string[] => {
+        const pieces: string[] = [];
+        evaluateCached(code, parser, (piece) => pieces.push(piece));
+        return pieces;
+    };
+
+    it('answers a small result from the cache', () => {
+        frontend.evaluateTo.mockClear();
+        const code = '\x03 small';
+        expect(run(code).join('')).toBe(code.repeat(3));
+        expect(run(code)).toEqual([code.repeat(3)]);
+        expect(frontend.evaluateTo).toHaveBeenCalledTimes(1);
+    });
+
+    it('streams a result over the limit without keeping it', () => {
+        frontend.evaluateTo.mockClear();
+        const code = '\u2000' + 'x'.repeat(99);
+        const pieces = run(code);
+        expect(pieces.length).toBe(0x2000);
+        expect(pieces.every((piece) => piece === code)).toBe(true);
+        expect(run(code).length).toBe(0x2000);
+        expect(frontend.evaluateTo).toHaveBeenCalledTimes(2);
+    });
+});
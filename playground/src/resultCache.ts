@@ -0,0 +1,223 @@
+import { Parser } from 'web-tree-sitter';
+
+import { evaluateTo, typeCheck, stripTypeInfoTo } from './interpreter/Frontend.gen';
+
+// Memoizes the Frontend results for a program, keyed by a hash of its
+// source, so that switching back to an example or undoing an edit shows the
+// earlier results at once. Entries are evicted least recently used first and
+// may be mirrored to a Storage so they survive a reload.
+
+// 53-bit string hash (cyrb53); the source is kept alongside to rule out
+// collisions.
+export const hashSource = (source: string): string => {
+    let h1 = 0xdeadbeef, h2 = 0x41c6ce57;
+    for (let i = 0; i < source.length; i++) {
+        const c = source.charCodeAt(i);
+        h1 = Math.imul(h1 ^ c, 2654435761);
+        h2 = Math.imul(h2 ^ c, 1597334677);
+    }
+    h1 = Math.imul(h1 ^ (h1 >>> 16), 2246822507) ^ Math.imul(h2 ^ (h2 >>> 13), 3266489909);
+    h2 = Math.imul(h2 ^ (h2 >>> 16), 2246822507) ^ Math.imul(h1 ^ (h1 >>> 13), 3266489909);
+    return (4294967296 * (2097151 & h2) + (h1 >>> 0)).toString(36);
+}
+
+interface Entry<V> {
+    source: string,
+    value: V,
+    // The entry as stored, serialized once when it is set; undefined for
+    // an entry too large to store.
+    json?: string,
+}
+
+export class ResultCache<V> {
+    private entries = new Map<string, Entry<V>>();
+    private saveTimer?: ReturnType<typeof setTimeout>;
+
+    // Entries larger than maxStoredLength characters, as JSON, are kept in
+    // memory only, so one huge result cannot crowd out the rest of storage.
+    // Writes to storage wait saveDelayMs, so that a burst of sets (typing,
+    // streamed evaluation) costs one write; 0 writes at once.
+    constructor(
+        private capacity: number,
+        private storage?: Storage,
+        private storageKey = 'lamgamma-results',
+        private maxStoredLength = 64 * 1024,
+        private saveDelayMs = 0,
+    ) {
+        this.load();
+    }
+
+    get size(): number {
+        return this.entries.size;
+    }
+
+    get(source: string): V | undefined {
+        const key = hashSource(source);
+        const entry = this.entries.get(key);
+        if (entry === undefined || entry.source !== source) return undefined;
+        // Reinserting moves the entry to the most recent end.
+        this.entries.delete(key);
+        this.entries.set(key, entry);
+        return entry.value;
+    }
+
+    set(source: string, value: V): void {
+        const key = hashSource(source);
+        this.entries.delete(key);
+        this.entries.set(key, { source, value, json: this.serialize(source, value) });
+        while (this.entries.size > this.capacity) {
+            this.entries.delete(this.entries.keys().next().value!);
+        }
+        this.scheduleSave();
+    }
+
+    clear(): void {
+        this.cancelSave();
+        this.entries.clear();
+        this.storage?.removeItem(this.storageKey);
+    }
+
+    // Writes a pending save now, e.g. when the page is hidden.
+    flush(): void {
+        this.cancelSave();
+        if (!this.storage) return;
+        const stored: string[] = [];
+        for (const [key, entry] of this.entries) {
+            if (entry.json !== undefined) stored.push(`[${JSON.stringify(key)},${entry.json}]`);
+        }
+        try {
+            this.storage.setItem(this.storageKey, '[' + stored.join(',') + ']');
+        } catch {
+            // Over quota: keep going with the in-memory cache.
+        }
+    }
+
+    private serialize(source: string, value: V): string | undefined {
+        if (!this.storage) return undefined;
+        const json = JSON.stringify({ source, value });
+        return json.length <= this.maxStoredLength ? json : undefined;
+    }
+
+    private load(): void {
+        if (!this.storage) return;
+        try {
+            const stored = JSON.parse(this.storage.getItem(this.storageKey) ?? '[]') as [string, Entry<V>][];
+            for (const [key, { source, value }] of stored.slice(-this.capacity)) {
+                this.entries.set(key, { source, value, json: this.serialize(source, value) });
+            }
+        } catch {
+            // A corrupt or foreign item is dropped with the cache.
+            this.storage.removeItem(this.storageKey);
+        }
+    }
+
+    private scheduleSave(): void {
+        if (!this.storage) return;
+        if (this.saveDelayMs <= 0) {
+            this.flush();
+        } else if (this.saveTimer === undefined) {
+            this.saveTimer = setTimeout(() => this.flush(), this.saveDelayMs);
+        }
+    }
+
+    private cancelSave(): void {
+        if (this.saveTimer !== undefined) {
+            clearTimeout(this.saveTimer);
+            this.saveTimer = undefined;
+        }
+    }
+}
+
+export interface FrontendResults {
+    typeCheck: string,
+    // Absent until shown, and for outputs longer than maxCachedLength.
+    untyped?: string,
+    evaluation?: string,
+}
+
+// Longer outputs are streamed to the page without being kept: they would be
+// dropped from storage anyway, and holding them would double the memory a
+// runaway specialization takes.
+const maxCachedLength = 64 * 1024;
+
+const browserStorage = (): Storage | undefined => {
+    try {
+        return typeof localStorage === 'undefined' ? undefined : localStorage;
+    } catch {
+        return undefined;
+    }
+}
+
+// Results are stored per build, so that a playground whose Frontend output
+// has changed never shows those of an older one; the older builds' items
+// are removed.
+const storagePrefix = 'lamgamma-results-';
+const storageKey = storagePrefix + __BUILD_ID__;
+
+const dropOtherBuilds = (storage: Storage | undefined): Storage | undefined => {
+    if (!storage) return storage;
+    for (let i = storage.length - 1; i >= 0; i--) {
+        const key = storage.key(i);
+        if (key !== null && key.startsWith(storagePrefix) && key !== storageKey) storage.removeItem(key);
+    }
+    return storage;
+}
+
+const frontendCache = new ResultCache<FrontendResults>(
+    64, dropOtherBuilds(browserStorage()), storageKey, maxCachedLength, 1000);
+
+if (typeof window !== 'undefined') {
+    window.addEventListener('pagehide', () => frontendCache.flush());
+}
+
+type Write = (piece: string) => void;
+
+// Runs produce, passing every piece straight on to write, and returns what
+// it wrote when that is at most maxCachedLength characters.
+const tee = (produce: (write: Write) => void, write: Write): string | undefined => {
+    let pieces: string[] | undefined = [];
+    let length = 0;
+    produce((piece) => {
+        write(piece);
+        if (pieces === undefined) return;
+        length += piece.length;
+        if (length > maxCachedLength) pieces = undefined;
+        else pieces.push(piece);
+    });
+    return pieces?.join('');
+}
+
+const results = (code: string, parser: Parser): FrontendResults => {
+    const cached = frontendCache.get(code);
+    if (cached) return cached;
+    const fresh = { typeCheck: typeCheck(code, parser) };
+    frontendCache.set(code, fresh);
+    return fresh;
+}
+
+// The type check result.
+export const checkCached = (code: string, parser: Parser): string =>
+    results(code, parser).typeCheck;
+
+// Streams the program without types to write.
+export const stripTypeInfoCached = (code: string, parser: Parser, write: Write): void => {
+    const cached = results(code, parser);
+    if (cached.untyped !== undefined) {
+        write(cached.untyped);
+        return;
+    }
+    const untyped = tee((w) => stripTypeInfoTo(code, parser, w), write);
+    if (untyped !== undefined) frontendCache.set(code, { ...cached, untyped });
+}
+
+// Streams the evaluation result to write, from the cache when the program
+// has been run before.
+export const evaluateCached = (code: string, parser: Parser, write: Write): void => {
+    const cached = results(code, parser);
+    if (cached.evaluation !== undefined) {
+        write(cached.evaluation);
+        return;
+    }
+    const evaluation = tee((w) => evaluateTo(code, parser, w), write);
+    if (evaluation !== undefined) frontendCache.set(code, { ...cached, evaluation });
+}
@@ -0,0 +1 @@
+export type t = Uint8Array
@@ -0,0 +1,161 @@
+import { Parser, Language } from 'web-tree-sitter';
+
+import { checkCached, stripTypeInfoCached } from './resultCache';
+
+// Loads the tree-sitter runtime and the lamgamma grammar as fast as the
+// browser allows, and records how long each phase took.
+//
+// The runtime is compiled with WebAssembly.instantiateStreaming, which
+// compiles while the bytes arrive and lets the browser reuse its cached
+// machine code on later visits. Browsers no longer store compiled
+// WebAssembly.Module objects in IndexedDB, so the grammar is cached there
+// as bytes instead: a repeat visit loads it without touching the network,
+// and a background fetch refreshes the cache for the visit after. The cache
+// is keyed by the build, so a new deployment never starts with the grammar
+// of the previous one.
+
+export interface StartupPhase {
+    name: string,
+    ms: number,
+    detail?: string,
+}
+
+export interface Startup {
+    parser: Parser,
+    phases: StartupPhase[],
+}
+
+const databaseName = 'lamgamma-playground';
+const storeName = 'wasm';
+
+const request = <T>(req: IDBRequest<T>): Promise<T> =>
+    new Promise((resolve, reject) => {
+        req.onsuccess = () => resolve(req.result);
+        req.onerror = () => reject(req.error);
+    });
+
+const openDatabase = (): Promise<IDBDatabase> => {
+    const req = indexedDB.open(databaseName, 1);
+    req.onupgradeneeded = () => req.result.createObjectStore(storeName);
+    return request(req);
+}
+
+const readCached = async (key: string): Promise<Uint8Array<ArrayBuffer> | undefined> => {
+    const db = await openDatabase();
+    try {
+        return await request(db.transaction(storeName).objectStore(storeName).get(key));
+    } finally {
+        db.close();
+    }
+}
+
+// Replaces the whole store, so the grammars of earlier builds do not pile up.
+const writeCached = async (key: string, bytes: Uint8Array<ArrayBuffer>): Promise<void> => {
+    const db = await openDatabase();
+    try {
+        const store = db.transaction(storeName, 'readwrite').objectStore(storeName);
+        store.clear();
+        await request(store.put(bytes, key));
+    } finally {
+        db.close();
+    }
+}
+
+const fetchBytes = async (url: string): Promise<Uint8Array<ArrayBuffer>> => {
+    const response = await fetch(url);
+    if (!response.ok) throw new Error(`cannot fetch ${url}: ${response.status}`);
+    return new Uint8Array(await response.arrayBuffer());
+}
+
+// Streaming compilation needs the server to send application/wasm; without
+// it, or where the browser lacks it, the runtime is compiled from the
+// downloaded bytes instead.
+const instantiateRuntime = async (
+    url: string,
+    imports: WebAssembly.Imports,
+): Promise<{ instance: WebAssembly.Instance, module: WebAssembly.Module, compile: string }> => {
+    const response = fetch(url);
+    try {
+        return { ...await WebAssembly.instantiateStreaming(response, imports), compile: 'streaming compile' };
+    } catch {
+        const bytes = await fetchBytes(url);
+        return { ...await WebAssembly.instantiate(bytes, imports), compile: 'compile' };
+    }
+}
+
+const sameBytes = (a: Uint8Array<ArrayBuffer>, b: Uint8Array<ArrayBuffer>): boolean =>
+    a.length === b.length && a.every((x, i) => x === b[i]);
+
+// The grammar bytes, from the cache when possible. Failing storage (private
+// browsing, quota) only costs the cache.
+const loadGrammar = async (url: string): Promise<{ bytes: Uint8Array<ArrayBuffer>, source: string }> => {
+    const key = `${url}#${__BUILD_ID__}`;
+    const cached = await readCached(key).catch(() => undefined);
+    if (cached) {
+        fetchBytes(url)
+            .then((fresh) => sameBytes(fresh, cached) ? undefined : writeCached(key, fresh))
+            .catch(() => undefined);
+        return { bytes: cached, source: 'cache' };
+    }
+    const bytes = await fetchBytes(url);
+    await writeCached(key, bytes).catch(() => undefined);
+    return { bytes, source: 'network' };
+}
+
+export const loadParser = async (base: string, warmUpProgram: string): Promise<Startup> => {
+    const phases: StartupPhase[] = [];
+    const start = performance.now();
+    let last = start;
+    const phase = (name: string, detail?: string) => {
+        const now = performance.now();
+        phases.push({ name, ms: now - last, detail });
+        last = now;
+    };
+
+    // Both downloads start before either is needed.
+    const grammar = loadGrammar(base + 'tree-sitter-lamgamma_parser.wasm');
+
+    // Parser.init waits for receive forever, so a runtime that cannot be
+    // compiled at all rejects through runtimeFailed instead.
+    let compile = '';
+    let failed: (reason: unknown) => void = () => undefined;
+    const runtimeFailed = new Promise<never>((_resolve, reject) => { failed = reject; });
+    await Promise.race([
+        Parser.init({
+            // eslint-disable-next-line @typescript-eslint/no-unused-vars
+            locateFile(scriptName: string, _scriptDirectory: string) {
+                return base + scriptName;
+            },
+            instantiateWasm(
+                imports: WebAssembly.Imports,
+                receive: (instance: WebAssembly.Instance, module: WebAssembly.Module) => void,
+            ) {
+                instantiateRuntime(base + 'tree-sitter.wasm', imports)
+                    .then((runtime) => {
+                        compile = runtime.compile;
+                        receive(runtime.instance, runtime.module);
+                    }, failed);
+                return {};
+            },
+        }),
+        runtimeFailed,
+    ]);
+    phase('runtime', compile);
+
+    const { bytes, source } = await grammar;
+    phase('grammar fetch', source);
+
+    const parser = new Parser();
+    parser.setLanguage(await Language.load(bytes));
+    phase('grammar compile');
+
+    // The first parse and type check pay for warming up the interpreter;
+    // doing them here means the editor's first check does not, and leaves
+    // the default program's results in the cache.
+    checkCached(warmUpProgram, parser);
+    stripTypeInfoCached(warmUpProgram, parser, () => undefined);
+    phase('first type check');
+
+    phases.push({ name: 'total', ms: performance.now() - start });
+    return { parser, phases };
+}
@@ -1,30 +1,58 @@
-import { AppBar, Box, Button, Container, Toolbar } from "@mui/material"
+import { AppBar, Box, Button, Container, FormControlLabel, Switch, Toolbar } from "@mui/material"
 import React, { useState } from "react"
 import { Parser } from "web-tree-sitter";
 
-import { evaluate, typeCheck, stripTypeInfo } from '../interpreter/Frontend.gen';
+import { checkCached, evaluateCached, stripTypeInfoCached } from '../resultCache';
+import type { NativeEngine } from '../nativeEngine';
+import { OutputView, type Producer } from "./OutputView";
+import { StartupPanel } from "./StartupPanel";
+import type { StartupPhase } from "../startup";
 
 interface Props {
     code: string,
-    treeSitterParser: Parser
+    treeSitterParser: Parser,
+    startupPhases: StartupPhase[],
+    nativeEngine?: NativeEngine
 }
 
-export const EvaluatorContainer: React.FC<Props> = ({ code, treeSitterParser }) => {
+export const EvaluatorContainer: React.FC<Props> = ({ code, treeSitterParser, startupPhases, nativeEngine }) => {
 
-    const [untypedCode, setUntypedCode] = useState<string | null>(null);
+    const [untypedCode, setUntypedCode] = useState<Producer | null>(null);
     const [typeCheckResult, setTypeCheckResult] = useState<string | null>(null);
-    const [evalResult, setEvalResult] = useState<string | null>(null);
+    const [evalResult, setEvalResult] = useState<Producer | null>(null);
+    const [useNative, setUseNative] = useState(false);
+    const native = useNative ? nativeEngine : undefined;
 
+    // Outputs are printed straight into their views instead of being held
+    // in state as strings. Programs seen before are answered from the cache.
+    // The native engine is not cached; programs it cannot evaluate go to
+    // the interpreter.
     const launchEval = () => {
-        const result = evaluate(code, treeSitterParser);
-        setEvalResult(result);
+        setEvalResult(() => (write: (piece: string) => void) => {
+            const result = native?.evaluate(code);
+            if (result === undefined) {
+                evaluateCached(code, treeSitterParser, write);
+            } else {
+                write(result);
+            }
+        });
     }
 
+    // code is the editor's document, which the native engine checks
+    // incrementally, so type feedback uses it whenever it is loaded; the
+    // switch only picks the evaluator. The interpreter's checker, which
+    // checks the whole program every time, is the fallback.
     React.useEffect(() => {
-        const result = typeCheck(code, treeSitterParser);
-        setTypeCheckResult(result);
-        setUntypedCode(stripTypeInfo(code, treeSitterParser))
-    }, [code, treeSitterParser])
+        if (nativeEngine) {
+            const untyped = nativeEngine.stripTypeInfo(code);
+            setTypeCheckResult(nativeEngine.checkDocument(code));
+            setUntypedCode(() => (write: (piece: string) => void) => write(untyped));
+        } else {
+            setTypeCheckResult(checkCached(code, treeSitterParser));
+            setUntypedCode(() => (write: (piece: string) => void) =>
+                stripTypeInfoCached(code, treeSitterParser, write));
+        }
+    }, [code, treeSitterParser, nativeEngine])
 
     return <Box sx={{
         height: "100%"
@@ -38,10 +66,12 @@ export const EvaluatorContainer: React.FC<Props> = ({ code, treeSitterParser })
             <code>{typeCheckResult}</code>
 
             <h1>Program without Types</h1>
-            <code>{ untypedCode }</code>
+            <OutputView produce={untypedCode} />
 
             <h1>Eval Result</h1>
-            <code>{evalResult}</code>
+            <OutputView produce={evalResult} />
+
+            <StartupPanel phases={startupPhases} />
         </Container>
         <AppBar position="sticky" sx={{ top: 'auto', bottom: 0 }}>
             <Toolbar>
@@ -50,6 +80,13 @@ export const EvaluatorContainer: React.FC<Props> = ({ code, treeSitterParser })
                     Run
                 </Button>
                 <Box sx={{ flexGrow: 1 }} />
+                <FormControlLabel
+                    label="Native engine"
+                    disabled={!nativeEngine}
+                    control={<Switch
+                        color="default"
+                        checked={useNative && nativeEngine !== undefined}
+                        onChange={(event) => setUseNative(event.target.checked)} />} />
             </Toolbar>
         </AppBar>
     </Box>
@@ -0,0 +1,89 @@
+import { Editor, Monaco } from "@monaco-editor/react";
+import type { editor } from "monaco-editor";
+import React, { useEffect, useRef, useState } from "react";
+
+import { quoteFoldingRanges } from "./quoteFolding";
+
+// Writes the text to show, piece by piece (see Frontend.evaluateTo).
+export type Producer = (write: (piece: string) => void) => void;
+
+interface Props {
+    produce: Producer | null,
+    height?: string,
+}
+
+// Pieces are appended to the model in batches of about this many characters.
+const batchSize = 64 * 1024;
+
+const language = "lamgamma-code";
+
+let languageRegistered = false;
+
+const registerLanguage = (monaco: Monaco) => {
+    if (languageRegistered) return;
+    languageRegistered = true;
+    monaco.languages.register({ id: language });
+    monaco.languages.registerFoldingRangeProvider(language, {
+        provideFoldingRanges: (model) => quoteFoldingRanges(model.getLinesContent()),
+    });
+}
+
+// A read-only Monaco editor for printed code. Monaco renders only the lines
+// in view, so large outputs stay responsive, and quotes can be folded.
+export const OutputView: React.FC<Props> = ({ produce, height = "30vh" }) => {
+    const editorRef = useRef<editor.IStandaloneCodeEditor | null>(null);
+    const [mounted, setMounted] = useState(false);
+
+    useEffect(() => {
+        const model = editorRef.current?.getModel();
+        if (!model) return;
+
+        model.setValue("");
+        if (!produce) return;
+
+        let pending: string[] = [];
+        let pendingSize = 0;
+        const flush = () => {
+            if (pending.length === 0) return;
+            const line = model.getLineCount();
+            const column = model.getLineMaxColumn(line);
+            model.applyEdits([{
+                range: { startLineNumber: line, startColumn: column, endLineNumber: line, endColumn: column },
+                text: pending.join(""),
+            }]);
+            pending = [];
+            pendingSize = 0;
+        };
+
+        produce((piece) => {
+            pending.push(piece);
+            pendingSize += piece.length;
+            if (pendingSize >= batchSize) flush();
+        });
+        flush();
+    }, [produce, mounted]);
+
+    return <Editor
+        height={height}
+        width="100%"
+        defaultLanguage={language}
+        theme="vs-dark"
+        beforeMount={registerLanguage}
+        onMount={(editor) => {
+            editorRef.current = editor;
+            setMounted(true);
+        }}
+        options={{
+            readOnly: true,
+            domReadOnly: true,
+            fontSize: 14,
+            fontFamily: "Monaspace Neon",
+            minimap: { enabled: false },
+            folding: true,
+            showFoldingControls: "always",
+            scrollBeyondLastLine: false,
+            wordWrap: "off",
+            automaticLayout: true,
+        }}
+    />
+}
@@ -0,0 +1,25 @@
+import React from "react";
+
+import type { StartupPhase } from "../startup";
+
+interface Props {
+    phases: StartupPhase[],
+}
+
+// Timings of the startup phases, for checking that caching works.
+export const StartupPanel: React.FC<Props> = ({ phases }) => {
+    return <details>
+        <summary>Startup</summary>
+        <table>
+            <tbody>
+                {phases.map(({ name, ms, detail }) =>
+                    <tr key={name}>
+                        <td>{name}</td>
+                        <td style={{ textAlign: "right" }}>{ms.toFixed(1)} ms</td>
+                        <td>{detail}</td>
+                    </tr>
+                )}
+            </tbody>
+        </table>
+    </details>
+}
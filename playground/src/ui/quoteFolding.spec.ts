@@ -0,0 +1,24 @@
+import { expect, it, describe } from 'vitest';
+import { quoteFoldingRanges } from './quoteFolding';
+
+describe('quoteFoldingRanges', () => {
+    it('folds quotes and splices but not functions', () => {
+        const lines = [
+            '`{',
+            '  (x_1) => {',
+            '    (x_1 * ~1{',
+            '      ( f x_1 )',
+            '    })',
+            '  }',
+            '}',
+        ];
+        expect(quoteFoldingRanges(lines)).toEqual([
+            { start: 1, end: 6 },
+            { start: 3, end: 4 },
+        ]);
+    });
+
+    it('ignores code on a single line', () => {
+        expect(quoteFoldingRanges(['`{ (x_1) => { x_1 } }'])).toEqual([]);
+    });
+});
@@ -0,0 +1,33 @@
+// Folding ranges for the quotes and splices in code laid out by
+// Printer.res. The printer opens a broken block at the end of a line and
+// closes it with a `}` at the start of a later one, so blocks can be
+// matched line by line without parsing.
+
+export interface LineRange {
+    // 1-based, inclusive: the opening line and the last line to hide
+    start: number,
+    end: number,
+}
+
+const opensQuote = /(?:`|~\d+)\{$/;
+
+export const quoteFoldingRanges = (lines: readonly string[]): LineRange[] => {
+    const open: { line: number, quote: boolean }[] = [];
+    const ranges: LineRange[] = [];
+
+    lines.forEach((text, i) => {
+        const line = i + 1;
+        if (text.trimStart().startsWith('}')) {
+            const block = open.pop();
+            if (block?.quote && line - 1 > block.line) {
+                ranges.push({ start: block.line, end: line - 1 });
+            }
+        }
+        const trimmed = text.trimEnd();
+        if (trimmed.endsWith('{')) {
+            open.push({ line, quote: opensQuote.test(trimmed) });
+        }
+    });
+
+    return ranges.sort((a, b) => a.start - b.start);
+}
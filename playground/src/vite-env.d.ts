@@ -1 +1,4 @@
 /// <reference types="vite/client" />
+
+// Set in vite.config.ts.
+declare const __BUILD_ID__: string
@@ -6,5 +6,10 @@ export default defineConfig({
   plugins: [react({
     include: ["**/*.res.mjs"],
   })],
-  base: "/~murase/lamgamma-playground/"
+  base: "/~murase/lamgamma-playground/",
+  define: {
+    // Distinguishes builds, so that caches of the grammar and of results
+    // made by one build are not read by the next.
+    __BUILD_ID__: JSON.stringify(Date.now().toString(36)),
+  },
 })